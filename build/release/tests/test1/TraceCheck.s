@@ -0,0 +1,385 @@
+	.file	"TraceCheck.cpp"
+	.text
+	.section	.text.unlikely,"ax",@progbits
+.LCOLDB0:
+	.text
+.LHOTB0:
+	.p2align 4
+	.globl	baseline_sum
+	.type	baseline_sum, @function
+baseline_sum:
+.LFB4617:
+	.cfi_startproc
+	pushq	%rbp
+	.cfi_def_cfa_offset 16
+	.cfi_offset 6, -16
+	movq	%rdi, %rbp
+	pushq	%rbx
+	.cfi_def_cfa_offset 24
+	.cfi_offset 3, -24
+	movq	%rsi, %rbx
+	subq	$8, %rsp
+	.cfi_def_cfa_offset 32
+	movl	16(%rsi), %edx
+	testl	%edx, %edx
+	je	.L2
+	movq	8(%rsi), %rax
+	movq	%rbx, %rdi
+	xorl	%esi, %esi
+	call	*32(%rax)
+.L2:
+	movq	8(%rbp), %rax
+	movq	%rbp, %rdi
+	movl	$2, %ecx
+	movq	%rbx, %rsi
+	movl	$1, %edx
+	call	*24(%rax)
+	movl	%eax, %ebp
+	movl	16(%rbx), %eax
+	testl	%eax, %eax
+	jne	.L10
+	addq	$8, %rsp
+	.cfi_remember_state
+	.cfi_def_cfa_offset 24
+	movl	%ebp, %eax
+	popq	%rbx
+	.cfi_def_cfa_offset 16
+	popq	%rbp
+	.cfi_def_cfa_offset 8
+	ret
+	.p2align 4,,10
+	.p2align 3
+.L10:
+	.cfi_restore_state
+	movq	8(%rbx), %rax
+	movq	%rbx, %rdi
+	call	*24(%rax)
+	testl	%eax, %eax
+	jne	.L7
+	addq	$8, %rsp
+	.cfi_def_cfa_offset 24
+	movl	%ebp, %eax
+	popq	%rbx
+	.cfi_def_cfa_offset 16
+	popq	%rbp
+	.cfi_def_cfa_offset 8
+	ret
+	.cfi_endproc
+	.section	.text.unlikely
+	.cfi_startproc
+	.type	baseline_sum.cold, @function
+baseline_sum.cold:
+.LFSB4617:
+.L7:
+	.cfi_def_cfa_offset 32
+	.cfi_offset 3, -24
+	.cfi_offset 6, -16
+	movl	$4, %edi
+	call	__cxa_allocate_exception@PLT
+	movq	%rbx, %rdi
+	movq	%rax, %rbp
+	movq	8(%rbx), %rax
+	call	*24(%rax)
+	xorl	%edx, %edx
+	leaq	_ZTIi(%rip), %rsi
+	movq	%rbp, %rdi
+	movl	%eax, 0(%rbp)
+	call	__cxa_throw@PLT
+	.cfi_endproc
+.LFE4617:
+	.text
+	.size	baseline_sum, .-baseline_sum
+	.section	.text.unlikely
+	.size	baseline_sum.cold, .-baseline_sum.cold
+.LCOLDE0:
+	.text
+.LHOTE0:
+	.section	.text.unlikely
+.LCOLDB1:
+	.text
+.LHOTB1:
+	.p2align 4
+	.globl	generated_sum
+	.type	generated_sum, @function
+generated_sum:
+.LFB4618:
+	.cfi_startproc
+	pushq	%rbp
+	.cfi_def_cfa_offset 16
+	.cfi_offset 6, -16
+	movq	%rdi, %rbp
+	pushq	%rbx
+	.cfi_def_cfa_offset 24
+	.cfi_offset 3, -24
+	movq	%rsi, %rbx
+	subq	$8, %rsp
+	.cfi_def_cfa_offset 32
+	movl	16(%rsi), %edx
+	testl	%edx, %edx
+	je	.L12
+	movq	8(%rsi), %rax
+	movq	%rbx, %rdi
+	xorl	%esi, %esi
+	call	*32(%rax)
+.L12:
+	movq	8(%rbp), %rax
+	movq	%rbp, %rdi
+	movl	$2, %ecx
+	movq	%rbx, %rsi
+	movl	$1, %edx
+	call	*24(%rax)
+	movl	%eax, %ebp
+	movl	16(%rbx), %eax
+	testl	%eax, %eax
+	jne	.L19
+	addq	$8, %rsp
+	.cfi_remember_state
+	.cfi_def_cfa_offset 24
+	movl	%ebp, %eax
+	popq	%rbx
+	.cfi_def_cfa_offset 16
+	popq	%rbp
+	.cfi_def_cfa_offset 8
+	ret
+	.p2align 4,,10
+	.p2align 3
+.L19:
+	.cfi_restore_state
+	movq	8(%rbx), %rax
+	movq	%rbx, %rdi
+	call	*24(%rax)
+	testl	%eax, %eax
+	jne	.L17
+	addq	$8, %rsp
+	.cfi_def_cfa_offset 24
+	movl	%ebp, %eax
+	popq	%rbx
+	.cfi_def_cfa_offset 16
+	popq	%rbp
+	.cfi_def_cfa_offset 8
+	ret
+	.cfi_endproc
+	.section	.text.unlikely
+	.cfi_startproc
+	.type	generated_sum.cold, @function
+generated_sum.cold:
+.LFSB4618:
+.L17:
+	.cfi_def_cfa_offset 32
+	.cfi_offset 3, -24
+	.cfi_offset 6, -16
+	movl	$4, %edi
+	call	__cxa_allocate_exception@PLT
+	movq	%rbx, %rdi
+	movq	%rax, %rbp
+	movq	8(%rbx), %rax
+	call	*24(%rax)
+	xorl	%edx, %edx
+	leaq	_ZTIi(%rip), %rsi
+	movq	%rbp, %rdi
+	movl	%eax, 0(%rbp)
+	call	__cxa_throw@PLT
+	.cfi_endproc
+.LFE4618:
+	.text
+	.size	generated_sum, .-generated_sum
+	.section	.text.unlikely
+	.size	generated_sum.cold, .-generated_sum.cold
+.LCOLDE1:
+	.text
+.LHOTE1:
+	.section	.text.unlikely
+.LCOLDB2:
+	.text
+.LHOTB2:
+	.p2align 4
+	.globl	baseline_getValue
+	.type	baseline_getValue, @function
+baseline_getValue:
+.LFB4619:
+	.cfi_startproc
+	.cfi_personality 0x9b,DW.ref.__gxx_personality_v0
+	.cfi_lsda 0x1b,.LLSDA4619
+	subq	$8, %rsp
+	.cfi_def_cfa_offset 16
+	leaq	-8(%rdi), %rax
+	testq	%rdi, %rdi
+	cmovne	%rax, %rdi
+.LEHB0:
+	call	_ZNK11CounterImpl8getValueEv@PLT
+.LEHE0:
+.L20:
+	addq	$8, %rsp
+	.cfi_remember_state
+	.cfi_def_cfa_offset 8
+	ret
+.L24:
+	.cfi_restore_state
+	movq	%rax, %rdi
+	jmp	.L22
+	.globl	__gxx_personality_v0
+	.section	.gcc_except_table,"a",@progbits
+	.align 4
+.LLSDA4619:
+	.byte	0xff
+	.byte	0x9b
+	.uleb128 .LLSDATT4619-.LLSDATTD4619
+.LLSDATTD4619:
+	.byte	0x1
+	.uleb128 .LLSDACSE4619-.LLSDACSB4619
+.LLSDACSB4619:
+	.uleb128 .LEHB0-.LFB4619
+	.uleb128 .LEHE0-.LEHB0
+	.uleb128 .L24-.LFB4619
+	.uleb128 0x1
+.LLSDACSE4619:
+	.byte	0x1
+	.byte	0
+	.align 4
+	.long	0
+
+.LLSDATT4619:
+	.text
+	.cfi_endproc
+	.section	.text.unlikely
+	.cfi_startproc
+	.cfi_personality 0x9b,DW.ref.__gxx_personality_v0
+	.cfi_lsda 0x1b,.LLSDAC4619
+	.type	baseline_getValue.cold, @function
+baseline_getValue.cold:
+.LFSB4619:
+.L22:
+	.cfi_def_cfa_offset 16
+	call	__cxa_begin_catch@PLT
+	call	__cxa_end_catch@PLT
+	xorl	%eax, %eax
+	jmp	.L20
+	.cfi_endproc
+.LFE4619:
+	.section	.gcc_except_table
+	.align 4
+.LLSDAC4619:
+	.byte	0xff
+	.byte	0x9b
+	.uleb128 .LLSDATTC4619-.LLSDATTDC4619
+.LLSDATTDC4619:
+	.byte	0x1
+	.uleb128 .LLSDACSEC4619-.LLSDACSBC4619
+.LLSDACSBC4619:
+.LLSDACSEC4619:
+	.byte	0x1
+	.byte	0
+	.align 4
+	.long	0
+
+.LLSDATTC4619:
+	.section	.text.unlikely
+	.text
+	.size	baseline_getValue, .-baseline_getValue
+	.section	.text.unlikely
+	.size	baseline_getValue.cold, .-baseline_getValue.cold
+.LCOLDE2:
+	.text
+.LHOTE2:
+	.section	.text.unlikely
+.LCOLDB3:
+	.text
+.LHOTB3:
+	.p2align 4
+	.globl	generated_getValue
+	.type	generated_getValue, @function
+generated_getValue:
+.LFB4620:
+	.cfi_startproc
+	.cfi_personality 0x9b,DW.ref.__gxx_personality_v0
+	.cfi_lsda 0x1b,.LLSDA4620
+	subq	$8, %rsp
+	.cfi_def_cfa_offset 16
+	leaq	-8(%rdi), %rax
+	testq	%rdi, %rdi
+	cmovne	%rax, %rdi
+.LEHB1:
+	call	_ZNK11CounterImpl8getValueEv@PLT
+.LEHE1:
+.L28:
+	addq	$8, %rsp
+	.cfi_remember_state
+	.cfi_def_cfa_offset 8
+	ret
+.L32:
+	.cfi_restore_state
+	movq	%rax, %rdi
+	jmp	.L30
+	.section	.gcc_except_table
+	.align 4
+.LLSDA4620:
+	.byte	0xff
+	.byte	0x9b
+	.uleb128 .LLSDATT4620-.LLSDATTD4620
+.LLSDATTD4620:
+	.byte	0x1
+	.uleb128 .LLSDACSE4620-.LLSDACSB4620
+.LLSDACSB4620:
+	.uleb128 .LEHB1-.LFB4620
+	.uleb128 .LEHE1-.LEHB1
+	.uleb128 .L32-.LFB4620
+	.uleb128 0x1
+.LLSDACSE4620:
+	.byte	0x1
+	.byte	0
+	.align 4
+	.long	0
+
+.LLSDATT4620:
+	.text
+	.cfi_endproc
+	.section	.text.unlikely
+	.cfi_startproc
+	.cfi_personality 0x9b,DW.ref.__gxx_personality_v0
+	.cfi_lsda 0x1b,.LLSDAC4620
+	.type	generated_getValue.cold, @function
+generated_getValue.cold:
+.LFSB4620:
+.L30:
+	.cfi_def_cfa_offset 16
+	call	__cxa_begin_catch@PLT
+	call	__cxa_end_catch@PLT
+	xorl	%eax, %eax
+	jmp	.L28
+	.cfi_endproc
+.LFE4620:
+	.section	.gcc_except_table
+	.align 4
+.LLSDAC4620:
+	.byte	0xff
+	.byte	0x9b
+	.uleb128 .LLSDATTC4620-.LLSDATTDC4620
+.LLSDATTDC4620:
+	.byte	0x1
+	.uleb128 .LLSDACSEC4620-.LLSDACSBC4620
+.LLSDACSBC4620:
+.LLSDACSEC4620:
+	.byte	0x1
+	.byte	0
+	.align 4
+	.long	0
+
+.LLSDATTC4620:
+	.section	.text.unlikely
+	.text
+	.size	generated_getValue, .-generated_getValue
+	.section	.text.unlikely
+	.size	generated_getValue.cold, .-generated_getValue.cold
+.LCOLDE3:
+	.text
+.LHOTE3:
+	.hidden	DW.ref.__gxx_personality_v0
+	.weak	DW.ref.__gxx_personality_v0
+	.section	.data.rel.local.DW.ref.__gxx_personality_v0,"awG",@progbits,DW.ref.__gxx_personality_v0,comdat
+	.align 8
+	.type	DW.ref.__gxx_personality_v0, @object
+	.size	DW.ref.__gxx_personality_v0, 8
+DW.ref.__gxx_personality_v0:
+	.quad	__gxx_personality_v0
+	.ident	"GCC: (Debian 12.2.0-14+deb12u1) 12.2.0"
+	.section	.note.GNU-stack,"",@progbits
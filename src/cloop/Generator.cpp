@@ -21,7 +21,9 @@
 
 #include "Generator.h"
 #include "Expr.h"
+#include <algorithm>
 #include <deque>
+#include <map>
 #include <set>
 #include <stdexcept>
 #include <string>
@@ -29,6 +31,7 @@
 #include <inttypes.h>
 
 using std::deque;
+using std::map;
 using std::runtime_error;
 using std::set;
 using std::string;
@@ -95,6 +98,14 @@ string CBasedGenerator::convertType(const TypeRef& typeRef)
 			ret += "char*";
 			break;
 
+		case Token::TYPE_STRVIEW:
+			ret += cPlusPlus ? "StrView" : "struct cloopStrView";
+			break;
+
+		case Token::TYPE_BYTES:
+			ret += cPlusPlus ? "Bytes" : "struct cloopBytes";
+			break;
+
 		case Token::TYPE_UCHAR:
 			ret += "unsigned char";
 			break;
@@ -126,529 +137,5329 @@ string CBasedGenerator::convertType(const TypeRef& typeRef)
 	return ret;
 }
 
-
-//--------------------------------------
-
-
-CppGenerator::CppGenerator(const string& filename, const string& prefix, Parser* parser,
-		const string& headerGuard, const string& nameSpace)
-	: CBasedGenerator(filename, prefix, true),
-	  parser(parser),
-	  headerGuard(headerGuard),
-	  nameSpace(nameSpace)
+// SystemTap SDT probe, laid out as sys/sdt.h does without requiring it: a nop at the probe site
+// and a .note.stapsdt entry describing its arguments, so perf, bpftrace and stap can attach to
+// it in a running process. Other platforms get no probes.
+void CBasedGenerator::generateProbeMacro()
 {
+	fprintf(out, "#ifndef CLOOP_PROBE\n");
+	fprintf(out, "#if defined(__GNUC__) && defined(__ELF__) && defined(__x86_64__)\n");
+	fprintf(out, "#define CLOOP_PROBE(provider, name, interfaceIndex, slot, self) \\\n");
+	fprintf(out, "\t__asm__ __volatile__ ( \\\n");
+	fprintf(out, "\t\t\"990: nop\\n\" \\\n");
+	fprintf(out, "\t\t\".pushsection .note.stapsdt, \\\"\\\", \\\"note\\\"\\n\" \\\n");
+	fprintf(out, "\t\t\".balign 4\\n\" \\\n");
+	fprintf(out, "\t\t\".4byte 992f-991f, 994f-993f, 3\\n\" \\\n");
+	fprintf(out, "\t\t\"991: .asciz \\\"stapsdt\\\"\\n\" \\\n");
+	fprintf(out, "\t\t\"992: .balign 4\\n\" \\\n");
+	fprintf(out, "\t\t\"993: .8byte 990b\\n\" \\\n");
+	fprintf(out, "\t\t\".8byte _.stapsdt.base\\n\" \\\n");
+	fprintf(out, "\t\t\".8byte 0\\n\" \\\n");
+	fprintf(out, "\t\t\".asciz \\\"\" #provider \"\\\"\\n\" \\\n");
+	fprintf(out, "\t\t\".asciz \\\"\" #name \"\\\"\\n\" \\\n");
+	fprintf(out, "\t\t\".asciz \\\"4@%%0 4@%%1 8@%%2\\\"\\n\" \\\n");
+	fprintf(out, "\t\t\"994: .balign 4\\n\" \\\n");
+	fprintf(out, "\t\t\".popsection\\n\" \\\n");
+	fprintf(out, "\t\t\".ifndef _.stapsdt.base\\n\" \\\n");
+	fprintf(out, "\t\t\".pushsection .stapsdt.base, \\\"aG\\\", \\\"progbits\\\", .stapsdt.base, comdat\\n\" \\\n");
+	fprintf(out, "\t\t\".weak _.stapsdt.base\\n\" \\\n");
+	fprintf(out, "\t\t\".hidden _.stapsdt.base\\n\" \\\n");
+	fprintf(out, "\t\t\"_.stapsdt.base: .space 1\\n\" \\\n");
+	fprintf(out, "\t\t\".size _.stapsdt.base, 1\\n\" \\\n");
+	fprintf(out, "\t\t\".popsection\\n\" \\\n");
+	fprintf(out, "\t\t\".endif\\n\" \\\n");
+	fprintf(out, "\t\t: : \"nor\" ((unsigned) (interfaceIndex)), \"nor\" ((unsigned) (slot)), \\\n");
+	fprintf(out, "\t\t\t\"nor\" ((const void*) (self)))\n");
+	fprintf(out, "#else\n");
+	fprintf(out, "#define CLOOP_PROBE(provider, name, interfaceIndex, slot, self)\n");
+	fprintf(out, "#endif\n");
+	fprintf(out, "#endif\n");
+	fprintf(out, "\n");
 }
 
-void CppGenerator::generate()
+// Structs with a body, laid out alike in C and C++: packed ones have no padding and aligned ones
+// are placed at multiples of their alignment.
+void CBasedGenerator::generateStructs(Parser* parser)
 {
-	fprintf(out, "// %s\n\n", AUTOGEN_MSG);
+	const char* indent = cPlusPlus ? "\t" : "";
+	bool hasStructs = false;
+	bool hasAlignment = false;
 
-	fprintf(out, "#ifndef %s\n", headerGuard.c_str());
-	fprintf(out, "#define %s\n\n", headerGuard.c_str());
-	///fprintf(out, "#include <stdint.h>\n\n");
+	for (vector<Struct*>::iterator i = parser->structs.begin(); i != parser->structs.end(); ++i)
+	{
+		if ((*i)->defined)
+		{
+			hasStructs = true;
 
-	fprintf(out, "#ifndef CLOOP_CARG\n");
-	fprintf(out, "#define CLOOP_CARG\n");
-	fprintf(out, "#endif\n\n\n");
+			if ((*i)->alignment)
+				hasAlignment = true;
+		}
+	}
 
-	fprintf(out, "namespace %s\n", nameSpace.c_str());
-	fprintf(out, "{\n");
-	fprintf(out, "\tclass DoNotInherit\n");
-	fprintf(out, "\t{\n");
-	fprintf(out, "\t};\n");
-	fprintf(out, "\n");
-	fprintf(out, "\ttemplate <typename T>\n");
-	fprintf(out, "\tclass Inherit : public T\n");
-	fprintf(out, "\t{\n");
-	fprintf(out, "\tpublic:\n");
-	fprintf(out, "\t\tInherit(DoNotInherit = DoNotInherit())\n");
-	fprintf(out, "\t\t\t: T(DoNotInherit())\n");
-	fprintf(out, "\t\t{\n");
-	fprintf(out, "\t\t}\n");
-	fprintf(out, "\t};\n");
-	fprintf(out, "\n");
+	if (!hasStructs)
+		return;
 
-	fprintf(out, "\t// Forward interfaces declarations\n\n");
+	if (hasAlignment)
+	{
+		fprintf(out, "#ifndef CLOOP_ALIGN\n");
+		fprintf(out, "#if defined(_MSC_VER)\n");
+		fprintf(out, "#define CLOOP_ALIGN(n) __declspec(align(n))\n");
+		fprintf(out, "#else\n");
+		fprintf(out, "#define CLOOP_ALIGN(n) __attribute__((aligned(n)))\n");
+		fprintf(out, "#endif\n");
+		fprintf(out, "#endif\n");
+		fprintf(out, "\n");
+	}
 
-	for (vector<Interface*>::iterator i = parser->interfaces.begin();
-		 i != parser->interfaces.end();
-		 ++i)
+	for (vector<Struct*>::iterator i = parser->structs.begin(); i != parser->structs.end(); ++i)
 	{
-		Interface* interface = *i;
+		Struct* ztruct = *i;
 
-		fprintf(out, "\tclass %s%s;\n", prefix.c_str(), interface->name.c_str());
-	}
+		if (!ztruct->defined)
+			continue;
 
-	fprintf(out, "\n");
-	fprintf(out, "\t// Interfaces declarations\n\n");
+		if (ztruct->packed)
+			fprintf(out, "#pragma pack(push, 1)\n");
 
-	for (vector<Interface*>::iterator i = parser->interfaces.begin();
-		 i != parser->interfaces.end();
-		 ++i)
-	{
-		Interface* interface = *i;
+		fprintf(out, "%sstruct ", indent);
 
-		deque<Method*> methods;
+		if (ztruct->alignment)
+			fprintf(out, "CLOOP_ALIGN(%u) ", ztruct->alignment);
 
-		for (Interface* p = interface; p; p = p->super)
-			methods.insert(methods.begin(), p->methods.begin(), p->methods.end());
+		fprintf(out, "%s\n", ztruct->name.c_str());
+		fprintf(out, "%s{\n", indent);
 
-		if (!interface->super)
-			fprintf(out, "\tclass %s%s\n", prefix.c_str(), interface->name.c_str());
-		else
+		for (vector<Field*>::iterator j = ztruct->fields.begin(); j != ztruct->fields.end(); ++j)
 		{
-			fprintf(out, "\tclass %s%s : public %s%s\n",
-				prefix.c_str(), interface->name.c_str(),
-				prefix.c_str(), interface->super->name.c_str());
+			Field* field = *j;
+			fprintf(out, "%s\t%s %s;\n", indent, convertType(field->typeRef).c_str(), field->name.c_str());
 		}
 
-		fprintf(out, "\t{\n");
-		fprintf(out, "\tpublic:\n");
+		fprintf(out, "%s};\n", indent);
 
-		if (!interface->super)
-		{
-			fprintf(out, "\t\tstruct VTable\n");
-			fprintf(out, "\t\t{\n");
-			fprintf(out, "\t\t\tvoid* cloopDummy[%d];\n", DUMMY_VTABLE);
-			fprintf(out, "\t\t\tuintptr_t version;\n");
-		}
-		else
-		{
-			fprintf(out, "\t\tstruct VTable : public %s%s::VTable\n",
-				prefix.c_str(), interface->super->name.c_str());
-			fprintf(out, "\t\t{\n");
-		}
+		if (ztruct->packed)
+			fprintf(out, "#pragma pack(pop)\n");
 
-		for (vector<Method*>::iterator j = interface->methods.begin();
-			 j != interface->methods.end();
-			 ++j)
-		{
-			Method* method = *j;
+		fprintf(out, "\n");
+	}
 
-			fprintf(out, "\t\t\t%s (CLOOP_CARG *%s)(%s%s%s* self",
-				convertType(method->returnTypeRef).c_str(),
-				method->name.c_str(),
-				(method->isConst ? "const " : ""),
-				prefix.c_str(),
-				interface->name.c_str());
+	if (!cPlusPlus)
+		fprintf(out, "\n");
+}
 
-			for (vector<Parameter*>::iterator k = method->parameters.begin();
-				 k != method->parameters.end();
-				 ++k)
-			{
-				Parameter* parameter = *k;
 
-				fprintf(out, ", %s %s",
-					convertType(parameter->typeRef).c_str(), parameter->name.c_str());
-			}
+//--------------------------------------
 
-			fprintf(out, ") throw();\n");
-		}
 
-		fprintf(out, "\t\t};\n");
-		fprintf(out, "\n");
+CppGenerator::CppGenerator(const string& filename, const string& prefix, Parser* parser,
+		const string& headerGuard, const string& nameSpace, const string& probesProvider)
+	: CBasedGenerator(filename, prefix, true),
+	  parser(parser),
+	  headerGuard(headerGuard),
+	  nameSpace(nameSpace),
+	  probesProvider(probesProvider)
+{
+}
 
-		if (!interface->super)
-		{
-			fprintf(out, "\t\tvoid* cloopDummy[%d];\n", DUMMY_INSTANCE);
-			fprintf(out, "\t\tVTable* cloopVTable;\n");
-			fprintf(out, "\n");
-		}
+// How the recording proxies keep an argument. Pointers other than strings and interfaces have
+// no known size, so methods taking them are not recorded.
+enum RecordKind
+{
+	RECORD_SCALAR,
+	RECORD_STRING,
+	RECORD_INTERFACE,
+	RECORD_NONE
+};
+
+// Awaiter of an [async] method, named after its completion interface.
+static string awaiterName(const string& prefix, Method* method)
+{
+	string completion = method->parameters.back()->typeRef.token.text;
 
-		fprintf(out, "\tprotected:\n");
-		fprintf(out, "\t\t%s%s(DoNotInherit)\n", prefix.c_str(), interface->name.c_str());
+	return prefix + completion.substr(0, completion.rfind("Completion")) + "Awaiter";
+}
 
-		if (interface->super)
-		{
-			fprintf(out, "\t\t\t: %s%s(DoNotInherit())\n",
-				prefix.c_str(), interface->super->name.c_str());
-		}
+// Whether the completion of an [async] method takes the status of the call.
+static bool completesWithStatus(Parser* parser, Method* method)
+{
+	Interface* completion = static_cast<Interface*>(
+		parser->typesByName[method->parameters.back()->typeRef.token.text]);
+	Method* complete = completion->methods.front();
 
-		fprintf(out, "\t\t{\n");
-		fprintf(out, "\t\t}\n");
-		fprintf(out, "\n");
-		fprintf(out, "\t\t~%s%s()\n", prefix.c_str(), interface->name.c_str());
-		fprintf(out, "\t\t{\n");
-		fprintf(out, "\t\t}\n");
-		fprintf(out, "\n");
+	return !complete->parameters.empty() && parser->exceptionInterface &&
+		complete->parameters.front()->typeRef.token.text == parser->exceptionInterface->name;
+}
 
-		fprintf(out, "\tpublic:\n");
-		fprintf(out, "\t\tstatic const unsigned VERSION = %u;\n", interface->version);
+static unsigned indexOfInterface(Parser* parser, const TypeRef& typeRef)
+{
+	BaseType* type = parser->typesByName[typeRef.token.text];
 
-		if (!interface->constants.empty())
-			fprintf(out, "\n");
+	return find(parser->interfaces.begin(), parser->interfaces.end(), type) -
+		parser->interfaces.begin();
+}
 
-		for (vector<Constant*>::iterator j = interface->constants.begin();
-			 j != interface->constants.end();
-			 ++j)
-		{
-			Constant* constant = *j;
+// Objects of the interface carry an error flag, which RPC copies along with their handles.
+static bool hasErrorFlag(Parser* parser, const TypeRef& typeRef)
+{
+	return static_cast<Interface*>(parser->typesByName[typeRef.token.text])->errorFlag;
+}
 
-			fprintf(out, "\t\tstatic const %s %s = %s;\n",
-				convertType(constant->typeRef).c_str(),
-				constant->name.c_str(),
-				constant->expr->generate(LANGUAGE_CPP, prefix).c_str());
-		}
+// Structs and length-carrying views passed by value, zeroed by value initialization.
+static bool isAggregate(const TypeRef& typeRef)
+{
+	return !typeRef.isPointer &&
+		(typeRef.token.type == Token::TYPE_STRVIEW || typeRef.token.type == Token::TYPE_BYTES ||
+		 (typeRef.token.type == Token::TYPE_IDENTIFIER && typeRef.type == BaseType::TYPE_STRUCT));
+}
 
-		for (vector<Method*>::iterator j = interface->methods.begin();
-			 j != interface->methods.end();
-			 ++j)
-		{
-			Method* method = *j;
+// Structs and views don't fit in a command cell.
+static bool hasAggregate(Method* method)
+{
+	if (isAggregate(method->returnTypeRef))
+		return true;
 
-			fprintf(out, "\n\t\t");
+	for (vector<Parameter*>::iterator i = method->parameters.begin(); i != method->parameters.end(); ++i)
+	{
+		if (isAggregate((*i)->typeRef))
+			return true;
+	}
 
-			string statusName;
+	return false;
+}
 
-			if (!method->parameters.empty() &&
-				parser->exceptionInterface &&
-				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name)
-			{
-				statusName = method->parameters.front()->name;
-				fprintf(out, "template <typename StatusType> ");
-			}
+// Command cells holding addresses, converted through uintptr_t by the C executor.
+static bool isAddressCell(const TypeRef& typeRef)
+{
+	return typeRef.isPointer || typeRef.token.type == Token::TYPE_STRING ||
+		(typeRef.token.type == Token::TYPE_IDENTIFIER && typeRef.type == BaseType::TYPE_INTERFACE);
+}
 
-			fprintf(out, "%s %s(",
-				convertType(method->returnTypeRef).c_str(), method->name.c_str());
+// The C executor stops at the first failing command, which C sees only in an error flag.
+static bool hasCExecutor(Parser* parser)
+{
+	if (parser->exceptionInterface && !parser->exceptionInterface->errorFlag)
+		return false;
 
-			for (vector<Parameter*>::iterator k = method->parameters.begin();
-				 k != method->parameters.end();
-				 ++k)
-			{
-				Parameter* parameter = *k;
+	for (vector<Interface*>::iterator i = parser->interfaces.begin(); i != parser->interfaces.end(); ++i)
+	{
+		if ((*i)->recorder)
+			return true;
+	}
 
-				if (k != method->parameters.begin())
-					fprintf(out, ", ");
+	return false;
+}
 
-				if (k == method->parameters.begin() && !statusName.empty())
-					fprintf(out, "StatusType* %s", parameter->name.c_str());
-				else
-				{
-					fprintf(out, "%s %s",
-						convertType(parameter->typeRef).c_str(), parameter->name.c_str());
-				}
-			}
+static bool hasArrays(const Method* method)
+{
+	for (vector<Parameter*>::const_iterator i = method->parameters.begin(); i != method->parameters.end(); ++i)
+	{
+		if ((*i)->typeRef.isArray)
+			return true;
+	}
 
-			fprintf(out, ")%s\n", (method->isConst ? " const" : ""));
-			fprintf(out, "\t\t{\n");
+	return false;
+}
 
-			if (method->version - (interface->super ? interface->super->version : 0) != 1)
-			{
-				fprintf(out, "\t\t\tif (cloopVTable->version < %d)\n", method->version);
-				fprintf(out, "\t\t\t{\n");
+// Count of a parameter passed as a span in C++: its count parameter for arrays, and the count of
+// the batch for the arrays of batch methods. Empty for other parameters.
+static string spanCount(const Method* method, const Parameter* parameter)
+{
+	if (parameter->typeRef.isArray)
+		return parameter->countName;
 
-				if (!statusName.empty())
-				{
-					fprintf(out,
-						"\t\t\t\tStatusType::setVersionError(%s, \"%s%s\", cloopVTable->version, %d);\n",
-						statusName.c_str(),
-						prefix.c_str(),
-						interface->name.c_str(),
-						method->version);
+	return method->scalarMethod && parameter->typeRef.isPointer ? "count" : "";
+}
 
-					fprintf(out, "\t\t\t\tStatusType::checkException(%s);\n", statusName.c_str());
-				}
+// First span counted by a count parameter, which gets its size.
+static const Parameter* firstSpan(const Method* method, const Parameter* count)
+{
+	for (vector<Parameter*>::const_iterator i = method->parameters.begin(); i != method->parameters.end(); ++i)
+	{
+		if (spanCount(method, *i) == count->name)
+			return *i;
+	}
 
-				fprintf(out, "\t\t\t\treturn");
+	return NULL;
+}
 
-				if (method->returnTypeRef.token.type != Token::TYPE_VOID ||
-					method->returnTypeRef.isPointer)
-				{
-					fprintf(out, " %s",
-						(method->notImplementedExpr ?
-							method->notImplementedExpr->generate(LANGUAGE_CPP, prefix).c_str() :
-							"0"));
-				}
+static const Parameter* findParameter(const Method* method, const string& name)
+{
+	for (vector<Parameter*>::const_iterator i = method->parameters.begin(); i != method->parameters.end(); ++i)
+	{
+		if ((*i)->name == name)
+			return *i;
+	}
 
-				fprintf(out, ";\n");
-				fprintf(out, "\t\t\t}\n");
-			}
+	return NULL;
+}
 
-			if (!statusName.empty())
-			{
-				fprintf(out, "\t\t\t");
+// Interfaces owned in C++ by Ref, whose references may be moved into [transfer] parameters.
+static bool isRefCounted(Parser* parser, const TypeRef& typeRef)
+{
+	if (typeRef.token.type != Token::TYPE_IDENTIFIER || typeRef.type != BaseType::TYPE_INTERFACE ||
+		typeRef.isPointer)
+	{
+		return false;
+	}
 
-				fprintf(out, "StatusType::clearException(%s)", statusName.c_str());
+	map<string, BaseType*>::iterator it = parser->typesByName.find(typeRef.token.text);
 
-				fprintf(out, ";\n");
-			}
+	return it != parser->typesByName.end() && static_cast<Interface*>(it->second)->refCounted;
+}
 
-			fprintf(out, "\t\t\t");
+// First array whose elements are counted by a parameter, or NULL when it's not a count.
+static Parameter* countedArray(const Method* method, const Parameter* count)
+{
+	for (vector<Parameter*>::const_iterator i = method->parameters.begin(); i != method->parameters.end(); ++i)
+	{
+		if ((*i)->typeRef.isArray && (*i)->countName == count->name)
+			return *i;
+	}
 
-			if (method->returnTypeRef.token.type != Token::TYPE_VOID ||
-				method->returnTypeRef.isPointer)
-			{
-				fprintf(out, "%s ret = ", convertType(method->returnTypeRef).c_str());
-			}
+	return NULL;
+}
 
-			fprintf(out, "static_cast<VTable*>(this->cloopVTable)->%s(this",
-				method->name.c_str());
+// How RPC stubs carry an argument or a result.
+enum RpcKind
+{
+	RPC_SCALAR,
+	RPC_STRING,
+	RPC_INTERFACE,
+	RPC_VIEW,	// strview and bytes: length and data
+	RPC_VALUE,	// struct by value: its bytes
+	RPC_ARRAY	// counted or batch array, or pointer to a struct: length and elements
+};
+
+static RpcKind rpcKind(const TypeRef& typeRef)
+{
+	if (typeRef.isPointer)
+		return RPC_ARRAY;
 
-			for (vector<Parameter*>::iterator k = method->parameters.begin();
-				 k != method->parameters.end();
-				 ++k)
-			{
-				Parameter* parameter = *k;
-				fprintf(out, ", %s", parameter->name.c_str());
-			}
+	switch (typeRef.token.type)
+	{
+		case Token::TYPE_STRING:
+			return RPC_STRING;
 
-			fprintf(out, ")");
-			fprintf(out, ";\n");
+		case Token::TYPE_STRVIEW:
+		case Token::TYPE_BYTES:
+			return RPC_VIEW;
 
-			if (!method->parameters.empty() &&
-				parser->exceptionInterface &&
-				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name)
-			{
-				fprintf(out, "\t\t\tStatusType::checkException(%s);\n",
-					method->parameters.front()->name.c_str());
-			}
+		case Token::TYPE_IDENTIFIER:
+			return typeRef.type == BaseType::TYPE_INTERFACE ? RPC_INTERFACE : RPC_VALUE;
 
-			if (method->returnTypeRef.token.type != Token::TYPE_VOID ||
-				method->returnTypeRef.isPointer)
-			{
-				fprintf(out, "\t\t\treturn ret;\n");
-			}
+		default:
+			return RPC_SCALAR;
+	}
+}
 
-			fprintf(out, "\t\t}\n");
-		}
+// Number of elements of a pointer carried by RPC. Pointers to a struct carry one.
+static string rpcCount(const Method* method, const Parameter* parameter)
+{
+	if (parameter->typeRef.isArray)
+		return parameter->countName;
 
-		fprintf(out, "\t};\n\n");
+	return method->scalarMethod ? "count" : "1";
+}
+
+// Methods ending the life of the object: dispose, and release of refcounted interfaces when it
+// returns 0.
+static bool isDisposal(const Interface* interface, const Method* method)
+{
+	if (!method->parameters.empty() || method->returnTypeRef.isPointer)
+		return false;
+
+	if (method->name == "dispose")
+		return method->returnTypeRef.token.type == Token::TYPE_VOID;
+
+	return interface->refCounted && method->name == "release" &&
+		method->returnTypeRef.token.type == Token::TYPE_INT;
+}
+
+// Whether an actor may post an argument and return before the call runs. Posted arguments are
+// copied, or handed over when the caller's reference is transferred.
+static bool isPostable(const Parameter* parameter)
+{
+	switch (rpcKind(parameter->typeRef))
+	{
+		case RPC_SCALAR:
+		case RPC_STRING:
+		case RPC_VALUE:
+			return true;
+
+		case RPC_INTERFACE:
+			return parameter->transfer;
+
+		default:
+			return false;
 	}
+}
 
-	fprintf(out, "\t// Interfaces implementations\n");
+static RecordKind recordKind(const TypeRef& typeRef)
+{
+	if (typeRef.isPointer)
+		return RECORD_NONE;
+
+	switch (typeRef.token.type)
+	{
+		case Token::TYPE_STRING:
+			return RECORD_STRING;
+
+		// Views are only valid during the call.
+		case Token::TYPE_STRVIEW:
+		case Token::TYPE_BYTES:
+			return RECORD_NONE;
+
+		case Token::TYPE_IDENTIFIER:
+			return typeRef.type == BaseType::TYPE_INTERFACE ? RECORD_INTERFACE : RECORD_NONE;
+
+		default:
+			return RECORD_SCALAR;
+	}
+}
+
+void CppGenerator::generate()
+{
+	fprintf(out, "// %s\n\n", AUTOGEN_MSG);
+
+	fprintf(out, "#ifndef %s\n", headerGuard.c_str());
+	fprintf(out, "#define %s\n\n", headerGuard.c_str());
+	///fprintf(out, "#include <stdint.h>\n\n");
+
+	fprintf(out, "#ifndef CLOOP_CARG\n");
+	fprintf(out, "#define CLOOP_CARG\n");
+	fprintf(out, "#endif\n\n");
+
+	// Without exceptions the dispatchers call the implementation directly and errors are
+	// reported only through the status object.
+	fprintf(out, "#ifndef CLOOP_NO_EXCEPTIONS\n");
+	fprintf(out, "#if !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)\n");
+	fprintf(out, "#define CLOOP_NO_EXCEPTIONS\n");
+	fprintf(out, "#endif\n");
+	fprintf(out, "#endif\n\n");
+
+	if (!probesProvider.empty())
+		generateProbeMacro();
+
+	bool hasRefCounted = false;
+	bool hasRpc = false;
+	bool hasActor = false;
+	bool hasShared = false;
+	bool hasRecorder = false;
 
 	for (vector<Interface*>::iterator i = parser->interfaces.begin();
 		 i != parser->interfaces.end();
 		 ++i)
 	{
-		Interface* interface = *i;
+		if ((*i)->refCounted)
+			hasRefCounted = true;
 
-		deque<Method*> methods;
+		if ((*i)->rpc)
+			hasRpc = true;
 
-		for (Interface* p = interface; p; p = p->super)
-			methods.insert(methods.begin(), p->methods.begin(), p->methods.end());
+		if ((*i)->actor)
+			hasActor = true;
+
+		if ((*i)->shared)
+			hasShared = true;
+
+		if ((*i)->recorder)
+			hasRecorder = true;
+	}
+
+	fprintf(out, "#include <stddef.h>\n");
+	fprintf(out, "#include <stdint.h>\n");
+	fprintf(out, "#include <stdio.h>\n");
+	fprintf(out, "#include <new>\n");
+
+	fprintf(out, "\n");
+	fprintf(out, "#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)\n");
+	fprintf(out, "#include <atomic>\n");
+
+	if (parser->trace)
+		fprintf(out, "#include <chrono>\n");
+
+	if (parser->replay || hasRpc)
+		fprintf(out, "#include <string.h>\n");
+
+	if (parser->replay || hasActor || hasShared)
+		fprintf(out, "#include <mutex>\n");
+
+	fprintf(out, "#include <string>\n");
 
+	if (parser->replay || hasRpc)
+		fprintf(out, "#include <unordered_map>\n");
+
+	if (parser->replay || hasRpc || hasShared)
+		fprintf(out, "#include <vector>\n");
+
+	fprintf(out, "#endif\n");
+	fprintf(out, "\n");
+
+	if (hasActor)
+	{
+		fprintf(out, "#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)\n");
+		fprintf(out, "#include <condition_variable>\n");
+		fprintf(out, "#include <thread>\n");
+		fprintf(out, "#endif\n");
 		fprintf(out, "\n");
-		fprintf(out, "\ttemplate <typename Name, typename StatusType, typename Base>\n");
-		fprintf(out, "\tclass %s%sBaseImpl : public Base\n",
-			prefix.c_str(), interface->name.c_str());
+	}
+
+	if (hasRpc)
+	{
+		fprintf(out, "#if __cplusplus >= 201103L && defined(__linux__)\n");
+		fprintf(out, "#include <errno.h>\n");
+		fprintf(out, "#include <fcntl.h>\n");
+		fprintf(out, "#include <linux/futex.h>\n");
+		fprintf(out, "#include <signal.h>\n");
+		fprintf(out, "#include <sys/mman.h>\n");
+		fprintf(out, "#include <sys/syscall.h>\n");
+		fprintf(out, "#include <sys/wait.h>\n");
+		fprintf(out, "#include <time.h>\n");
+		fprintf(out, "#include <unistd.h>\n");
+		fprintf(out, "#endif\n");
+		fprintf(out, "\n");
+	}
+
+	fprintf(out, "#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)\n");
+	fprintf(out, "#include <coroutine>\n");
+	fprintf(out, "#include <exception>\n");
+	fprintf(out, "#define CLOOP_COROUTINES\n");
+	fprintf(out, "#endif\n");
+	fprintf(out, "\n");
+	fprintf(out, "#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)\n");
+	fprintf(out, "#include <string_view>\n");
+	fprintf(out, "#define CLOOP_STRING_VIEW\n");
+	fprintf(out, "#endif\n");
+	fprintf(out, "\n");
+	fprintf(out, "#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)\n");
+	fprintf(out, "#include <span>\n");
+	fprintf(out, "#include <stdlib.h>\n");
+	fprintf(out, "#define CLOOP_SPAN\n");
+	fprintf(out, "#endif\n");
+
+	fprintf(out, "\n\n");
+
+	fprintf(out, "namespace %s\n", nameSpace.c_str());
+	fprintf(out, "{\n");
+	fprintf(out, "\tclass DoNotInherit\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\ttemplate <typename T>\n");
+	fprintf(out, "\tclass Inherit : public T\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tInherit(DoNotInherit = DoNotInherit())\n");
+	fprintf(out, "\t\t\t: T(DoNotInherit())\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+
+	// Results of the try_ methods. The error is taken from the status and never thrown.
+	fprintf(out, "\ttemplate <typename E>\n");
+	fprintf(out, "\tclass Unexpected\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\texplicit Unexpected(const E& error)\n");
+	fprintf(out, "\t\t\t: error(error)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tE error;\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\ttemplate <typename T, typename E>\n");
+	fprintf(out, "\tclass Expected\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tExpected(const T& value)\n");
+	fprintf(out, "\t\t\t: valid(true),\n");
+	fprintf(out, "\t\t\t  val(value),\n");
+	fprintf(out, "\t\t\t  err()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tExpected(const Unexpected<E>& unexpected)\n");
+	fprintf(out, "\t\t\t: valid(false),\n");
+	fprintf(out, "\t\t\t  val(),\n");
+	fprintf(out, "\t\t\t  err(unexpected.error)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tbool hasValue() const\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn valid;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tconst T& value() const\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn val;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tT valueOr(const T& defaultValue) const\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn valid ? val : defaultValue;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tconst E& error() const\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn err;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tbool valid;\n");
+	fprintf(out, "\t\tT val;\n");
+	fprintf(out, "\t\tE err;\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\ttemplate <typename E>\n");
+	fprintf(out, "\tclass Expected<void, E>\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tExpected()\n");
+	fprintf(out, "\t\t\t: valid(true),\n");
+	fprintf(out, "\t\t\t  err()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tExpected(const Unexpected<E>& unexpected)\n");
+	fprintf(out, "\t\t\t: valid(false),\n");
+	fprintf(out, "\t\t\t  err(unexpected.error)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tbool hasValue() const\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn valid;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tconst E& error() const\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn err;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tbool valid;\n");
+	fprintf(out, "\t\tE err;\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+
+	// Hooks called around the wrappers (when given as their first template argument) and the
+	// dispatchers (as selected by TraceTraits<Name>), receiving the interface index and the
+	// vtable slot of the method. failed is called before exit when the call reports an error.
+	// The default policy is empty and compiles to nothing.
+	fprintf(out, "\tstruct NoTracePolicy\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tstatic void enter(unsigned /*interfaceIndex*/, unsigned /*slot*/)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstatic void failed(unsigned /*interfaceIndex*/, unsigned /*slot*/)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstatic void exit(unsigned /*interfaceIndex*/, unsigned /*slot*/)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\ttemplate <typename Name>\n");
+	fprintf(out, "\tstruct TraceTraits\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\ttypedef NoTracePolicy Policy;\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\ttemplate <typename TracePolicy>\n");
+	fprintf(out, "\tclass TraceScope\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tTraceScope(unsigned interfaceIndex, unsigned slot)\n");
+	fprintf(out, "\t\t\t: interfaceIndex(interfaceIndex),\n");
+	fprintf(out, "\t\t\t  slot(slot)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tTracePolicy::enter(interfaceIndex, slot);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t~TraceScope()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tTracePolicy::exit(interfaceIndex, slot);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tvoid failed()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tTracePolicy::failed(interfaceIndex, slot);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tunsigned interfaceIndex;\n");
+	fprintf(out, "\t\tunsigned slot;\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+
+	if (parser->trace)
+	{
+		// Trace policy writing a TraceRecord per call to a ring of the calling thread, without
+		// locks. The ring is zero initialized and keeps the last SIZE records; dump writes them,
+		// oldest first, in the format read by cloop-trace. They are generated for the whole IDL
+		// with [trace];.
+		fprintf(out, "#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)\n");
+		fprintf(out, "\tstruct TraceRecord\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\tuint64_t timestamp;\n");
+		fprintf(out, "\t\tuint64_t duration;\n");
+		fprintf(out, "\t\tuint16_t interfaceIndex;\n");
+		fprintf(out, "\t\tuint16_t slot;\n");
+		fprintf(out, "\t\tuint16_t depth;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t// 1 when the call failed, with an error in its status or an exception. Wrappers\n");
+		fprintf(out, "\t\t// only see the error flag of the status, so its code is not recorded.\n");
+		fprintf(out, "\t\tuint16_t failed;\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tclass TraceRing\n");
 		fprintf(out, "\t{\n");
 		fprintf(out, "\tpublic:\n");
-		fprintf(out, "\t\ttypedef %s%s Declaration;\n", prefix.c_str(), interface->name.c_str());
+		fprintf(out, "\t\tstatic const unsigned SIZE = 4096;\n");
+		fprintf(out, "\t\tstatic const unsigned MAX_DEPTH = 64;\n");
 		fprintf(out, "\n");
-		fprintf(out, "\t\t%s%sBaseImpl(DoNotInherit = DoNotInherit())\n",
-			prefix.c_str(), interface->name.c_str());
+		fprintf(out, "\t\tstatic TraceRing& current()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tstatic thread_local TraceRing ring;\n");
+		fprintf(out, "\t\t\treturn ring;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic uint64_t now()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn std::chrono::duration_cast<std::chrono::nanoseconds>(\n");
+		fprintf(out, "\t\t\t\tstd::chrono::steady_clock::now().time_since_epoch()).count();\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tvoid enter()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (depth < MAX_DEPTH)\n");
+		fprintf(out, "\t\t\t{\n");
+		fprintf(out, "\t\t\t\tstarts[depth] = now();\n");
+		fprintf(out, "\t\t\t\tfailures[depth] = 0;\n");
+		fprintf(out, "\t\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\t++depth;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tvoid fail()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (depth - 1 < MAX_DEPTH)\n");
+		fprintf(out, "\t\t\t\tfailures[depth - 1] = 1;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tvoid exit(unsigned interfaceIndex, unsigned slot)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (--depth >= MAX_DEPTH)\n");
+		fprintf(out, "\t\t\t\treturn;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tTraceRecord& record = records[count++ %% SIZE];\n");
+		fprintf(out, "\t\t\trecord.timestamp = starts[depth];\n");
+		fprintf(out, "\t\t\trecord.duration = now() - starts[depth];\n");
+		fprintf(out, "\t\t\trecord.interfaceIndex = (uint16_t) interfaceIndex;\n");
+		fprintf(out, "\t\t\trecord.slot = (uint16_t) slot;\n");
+		fprintf(out, "\t\t\trecord.depth = (uint16_t) depth;\n");
+		fprintf(out, "\t\t\trecord.failed = failures[depth];\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t// Number of records written, including the ones overwritten.\n");
+		fprintf(out, "\t\tuint64_t size() const\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn count;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tconst TraceRecord& operator [](uint64_t n) const\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn records[n %% SIZE];\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t// Writes the ring of this thread only. The rings are not locked, so each thread\n");
+		fprintf(out, "\t\t// dumps its own, to a file of its own, and cloop-trace decodes them together.\n");
+		fprintf(out, "\t\tbool dump(const char* filename) const\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tFILE* file = fopen(filename, \"wb\");\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tif (!file)\n");
+		fprintf(out, "\t\t\t\treturn false;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tuint64_t first = count > SIZE ? count - SIZE : 0;\n");
+		fprintf(out, "\t\t\tuint32_t header[4] = {0x504F4F4Cu, 1, (uint32_t) sizeof(TraceRecord), "
+			"(uint32_t) (count - first)};\n");
+		fprintf(out, "\t\t\tbool ok = fwrite(header, sizeof(header), 1, file) == 1;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tfor (uint64_t n = first; ok && n < count; ++n)\n");
+		fprintf(out, "\t\t\t\tok = fwrite(&(*this)[n], sizeof(TraceRecord), 1, file) == 1;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\treturn fclose(file) == 0 && ok;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tprivate:\n");
+		fprintf(out, "\t\tTraceRecord records[SIZE];\n");
+		fprintf(out, "\t\tuint64_t count;\n");
+		fprintf(out, "\t\tuint64_t starts[MAX_DEPTH];\n");
+		fprintf(out, "\t\tuint16_t failures[MAX_DEPTH];\n");
+		fprintf(out, "\t\tunsigned depth;\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tstruct RingTracePolicy\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\tstatic void enter(unsigned /*interfaceIndex*/, unsigned /*slot*/)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tTraceRing::current().enter();\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic void failed(unsigned /*interfaceIndex*/, unsigned /*slot*/)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tTraceRing::current().fail();\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic void exit(unsigned interfaceIndex, unsigned slot)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tTraceRing::current().exit(interfaceIndex, slot);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "#endif\n");
+		fprintf(out, "\n");
+	}
+
+
+	if (!probesProvider.empty())
+	{
+		// Fires the enter and exit probes of the dispatchers.
+		fprintf(out, "\tclass ProbeScope\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\tProbeScope(unsigned interfaceIndex, unsigned slot, const void* self)\n");
+		fprintf(out, "\t\t\t: interfaceIndex(interfaceIndex),\n");
+		fprintf(out, "\t\t\t  slot(slot),\n");
+		fprintf(out, "\t\t\t  self(self)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tCLOOP_PROBE(%s, enter, interfaceIndex, slot, self);\n", probesProvider.c_str());
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t~ProbeScope()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tCLOOP_PROBE(%s, exit, interfaceIndex, slot, self);\n", probesProvider.c_str());
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tprivate:\n");
+		fprintf(out, "\t\tunsigned interfaceIndex;\n");
+		fprintf(out, "\t\tunsigned slot;\n");
+		fprintf(out, "\t\tconst void* self;\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+	}
+
+	if (hasRecorder || hasRpc || parser->replay)
+	{
+		// Command buffers, filled by the Recorder classes and replayed by executeCommands. A command
+		// is a sequence of 64-bit cells: a header with the command size in cells, the interface index
+		// and the vtable slot, the object, the arguments except the status and, when the method
+		// returns a value, a cell where executeCommands stores the result. Scalars are stored by
+		// value; strings, arrays, other pointers and interfaces only by address, without copying
+		// the data or adding references, so these and the called objects must stay valid until the
+		// buffer is executed. RPC and the recording proxies write their commands in the same format.
+		fprintf(out, "\ttemplate <typename T>\n");
+		fprintf(out, "\tstruct CommandCell\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\tstatic uint64_t encode(T value)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn (uint64_t) value;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic T decode(uint64_t cell)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn (T) cell;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\ttemplate <typename T>\n");
+		fprintf(out, "\tstruct CommandCell<T*>\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\tstatic uint64_t encode(T* value)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn (uint64_t) (uintptr_t) value;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic T* decode(uint64_t cell)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn (T*) (uintptr_t) cell;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tclass CommandBuffer\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\tCommandBuffer()\n");
+		fprintf(out, "\t\t\t: cells(0),\n");
+		fprintf(out, "\t\t\t  count(0),\n");
+		fprintf(out, "\t\t\t  capacity(0)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t~CommandBuffer()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tdelete[] cells;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tprivate:\n");
+		fprintf(out, "\t\tCommandBuffer(const CommandBuffer&);\n");
+		fprintf(out, "\t\tCommandBuffer& operator =(const CommandBuffer&);\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\tstatic uint64_t header(unsigned size, unsigned interfaceIndex, unsigned slot)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn ((uint64_t) size << 32) | ((uint64_t) interfaceIndex << 16) | slot;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tuint64_t* append(unsigned size)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (count + size > capacity)\n");
+		fprintf(out, "\t\t\t{\n");
+		fprintf(out, "\t\t\t\tunsigned newCapacity = capacity ? capacity * 2 : 64;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\t\twhile (newCapacity < count + size)\n");
+		fprintf(out, "\t\t\t\t\tnewCapacity *= 2;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\t\tuint64_t* newCells = new uint64_t[newCapacity];\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\t\tfor (unsigned i = 0; i < count; ++i)\n");
+		fprintf(out, "\t\t\t\t\tnewCells[i] = cells[i];\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\t\tdelete[] cells;\n");
+		fprintf(out, "\t\t\t\tcells = newCells;\n");
+		fprintf(out, "\t\t\t\tcapacity = newCapacity;\n");
+		fprintf(out, "\t\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tuint64_t* command = cells + count;\n");
+		fprintf(out, "\t\t\tcount += size;\n");
+		fprintf(out, "\t\t\treturn command;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tvoid clear()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tcount = 0;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tuint64_t* data() const\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn cells;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tunsigned size() const\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn count;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tprivate:\n");
+		fprintf(out, "\t\tuint64_t* cells;\n");
+		fprintf(out, "\t\tunsigned count;\n");
+		fprintf(out, "\t\tunsigned capacity;\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+	}
+
+	// Memory of the Impl classes, used by their operator new and by the operator delete called
+	// when an implementation deletes itself. Policies may use pools or arenas as long as
+	// deallocate accepts blocks from any thread the objects are disposed in. The nothrow
+	// allocate returns null instead of failing, and deallocate gets a size of 0 when it's not
+	// known, for the blocks of a constructor throwing after a nothrow new. The forms taking an
+	// alignment are used for over-aligned implementations, and only needed by these.
+	fprintf(out, "\tstruct DefaultAllocator\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tstatic void* allocate(size_t size)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn ::operator new(size);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstatic void* allocate(size_t size, const std::nothrow_t&)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn ::operator new(size, std::nothrow);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstatic void deallocate(void* ptr, size_t /*size*/)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\t::operator delete(ptr);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "#ifdef __cpp_aligned_new\n");
+	fprintf(out, "\t\tstatic void* allocate(size_t size, std::align_val_t alignment)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn ::operator new(size, alignment);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstatic void* allocate(size_t size, std::align_val_t alignment, const std::nothrow_t&)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn ::operator new(size, alignment, std::nothrow);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstatic void deallocate(void* ptr, size_t /*size*/, std::align_val_t alignment)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\t::operator delete(ptr, alignment);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "#endif\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+
+	if (hasRefCounted)
+	{
+		// Memory orderings of the generated addRef/release implementations. The default one is
+		// required when references are shared between threads; an implementation confined to a
+		// thread may specialize RefCountTraits with RelaxedRefCount. Before C++11, there is no
+		// atomic counter and the implementations define addRef and release themselves.
+		fprintf(out, "#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)\n");
+		fprintf(out, "\tstruct AcquireReleaseRefCount\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\tstatic const std::memory_order INCREMENT = std::memory_order_relaxed;\n");
+		fprintf(out, "\t\tstatic const std::memory_order DECREMENT = std::memory_order_acq_rel;\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tstruct RelaxedRefCount\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\tstatic const std::memory_order INCREMENT = std::memory_order_relaxed;\n");
+		fprintf(out, "\t\tstatic const std::memory_order DECREMENT = std::memory_order_relaxed;\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\ttemplate <typename Name>\n");
+		fprintf(out, "\tstruct RefCountTraits\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\ttypedef AcquireReleaseRefCount Order;\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+
+		// Owner of a reference to a refcounted interface. Constructing from a raw pointer adopts
+		// the reference, copies call addRef and moves transfer the reference without touching
+		// the counter.
+		fprintf(out, "\ttemplate <typename T>\n");
+		fprintf(out, "\tclass Ref\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\tRef()\n");
+		fprintf(out, "\t\t\t: ptr(0)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\texplicit Ref(T* ptr)\n");
+		fprintf(out, "\t\t\t: ptr(ptr)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tRef(const Ref& other)\n");
+		fprintf(out, "\t\t\t: ptr(other.ptr)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (ptr)\n");
+		fprintf(out, "\t\t\t\tptr->addRef();\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tRef(Ref&& other) noexcept\n");
+		fprintf(out, "\t\t\t: ptr(other.ptr)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tother.ptr = 0;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t~Ref()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (ptr)\n");
+		fprintf(out, "\t\t\t\tptr->release();\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tRef& operator =(const Ref& other)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (other.ptr)\n");
+		fprintf(out, "\t\t\t\tother.ptr->addRef();\n");
+		fprintf(out, "\t\t\treset(other.ptr);\n");
+		fprintf(out, "\t\t\treturn *this;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tRef& operator =(Ref&& other) noexcept\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (this != &other)\n");
+		fprintf(out, "\t\t\t\treset(other.detach());\n");
+		fprintf(out, "\t\t\treturn *this;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tT* operator ->() const\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn ptr;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tT* get() const\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn ptr;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t// Gives up the reference without releasing it.\n");
+		fprintf(out, "\t\tT* detach()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tT* ret = ptr;\n");
+		fprintf(out, "\t\t\tptr = 0;\n");
+		fprintf(out, "\t\t\treturn ret;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tvoid reset(T* newPtr = 0)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tT* oldPtr = ptr;\n");
+		fprintf(out, "\t\t\tptr = newPtr;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tif (oldPtr)\n");
+		fprintf(out, "\t\t\t\toldPtr->release();\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tprivate:\n");
+		fprintf(out, "\t\tT* ptr;\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "#endif\n");
+		fprintf(out, "\n");
+	}
+
+	if (parser->exceptionInterface)
+	{
+		// Defined after the interfaces, as it needs the exception interface.
+		fprintf(out, "\ttemplate <typename StatusType>\n");
+		fprintf(out, "\tstruct StatusTraits;\n");
+		fprintf(out, "\n");
+	}
+
+	fprintf(out, "\t// Length-carrying views, laid out as cloopStrView and cloopBytes of the C API, so text and data\n");
+	fprintf(out, "\t// are passed without scanning for a terminator.\n");
+	fprintf(out, "\tstruct StrView\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tStrView()\n");
+	fprintf(out, "\t\t\t: data(0),\n");
+	fprintf(out, "\t\t\t  length(0)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+		fprintf(out, "\t\tStrView(const char* data, size_t length)\n");
+	fprintf(out, "\t\t\t: data(data),\n");
+	fprintf(out, "\t\t\t  length(length)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)\n");
+	fprintf(out, "\t\tStrView(const std::string& str)\n");
+	fprintf(out, "\t\t\t: data(str.data()),\n");
+	fprintf(out, "\t\t\t  length(str.length())\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "#endif\n");
+	fprintf(out, "\n");
+	fprintf(out, "#ifdef CLOOP_STRING_VIEW\n");
+	fprintf(out, "\t\tStrView(std::string_view view)\n");
+	fprintf(out, "\t\t\t: data(view.data()),\n");
+	fprintf(out, "\t\t\t  length(view.length())\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\toperator std::string_view() const\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn std::string_view(data, (size_t) length);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "#endif\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tconst char* data;\n");
+	fprintf(out, "\t\tuint64_t length;\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tstruct Bytes\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tBytes()\n");
+	fprintf(out, "\t\t\t: data(0),\n");
+	fprintf(out, "\t\t\t  length(0)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tBytes(const void* data, size_t length)\n");
+	fprintf(out, "\t\t\t: data(static_cast<const unsigned char*>(data)),\n");
+	fprintf(out, "\t\t\t  length(length)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "#ifdef CLOOP_SPAN\n");
+	fprintf(out, "\t\tBytes(std::span<const unsigned char> span)\n");
+	fprintf(out, "\t\t\t: data(span.data()),\n");
+	fprintf(out, "\t\t\t  length(span.size())\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\toperator std::span<const unsigned char>() const\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn std::span<const unsigned char>(data, (size_t) length);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "#endif\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tconst unsigned char* data;\n");
+	fprintf(out, "\t\tuint64_t length;\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// Forward interfaces declarations\n\n");
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		Interface* interface = *i;
+
+		fprintf(out, "\tclass %s%s;\n", prefix.c_str(), interface->name.c_str());
+	}
+
+	fprintf(out, "\n");
+
+	generateStructs(parser);
+
+	// The awaiters of [async] methods are returned by the wrappers, before they are defined.
+	bool hasAsync = false;
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		for (vector<Method*>::iterator j = (*i)->methods.begin(); j != (*i)->methods.end(); ++j)
+		{
+			if (!(*j)->syncMethod)
+				continue;
+
+			if (!hasAsync)
+				fprintf(out, "#ifdef CLOOP_COROUTINES\n");
+
+			hasAsync = true;
+			fprintf(out, "\ttemplate <typename StatusType> class %s;\n", awaiterName(prefix, *j).c_str());
+		}
+	}
+
+	if (hasAsync)
+	{
+		fprintf(out, "#endif\n");
+		fprintf(out, "\n");
+	}
+	fprintf(out, "\t// Interfaces declarations\n\n");
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		Interface* interface = *i;
+
+		deque<Method*> methods;
+
+		for (Interface* p = interface; p; p = p->super)
+			methods.insert(methods.begin(), p->methods.begin(), p->methods.end());
+
+		if (!interface->super)
+			fprintf(out, "\tclass %s%s\n", prefix.c_str(), interface->name.c_str());
+		else
+		{
+			fprintf(out, "\tclass %s%s : public %s%s\n",
+				prefix.c_str(), interface->name.c_str(),
+				prefix.c_str(), interface->super->name.c_str());
+		}
+
+		fprintf(out, "\t{\n");
+		fprintf(out, "\tpublic:\n");
+
+		if (!interface->super)
+		{
+			fprintf(out, "\t\tstruct VTable\n");
+			fprintf(out, "\t\t{\n");
+
+			if (!interface->compact)
+				fprintf(out, "\t\t\tvoid* cloopDummy[%d];\n", DUMMY_VTABLE);
+
+			fprintf(out, "\t\t\tuintptr_t version;\n");
+		}
+		else
+		{
+			fprintf(out, "\t\tstruct VTable : public %s%s::VTable\n",
+				prefix.c_str(), interface->super->name.c_str());
+			fprintf(out, "\t\t{\n");
+		}
+
+		for (vector<Method*>::iterator j = interface->methods.begin();
+			 j != interface->methods.end();
+			 ++j)
+		{
+			Method* method = *j;
+
+			fprintf(out, "\t\t\t%s (CLOOP_CARG *%s)(%s%s%s* self",
+				convertType(method->returnTypeRef).c_str(),
+				method->name.c_str(),
+				(method->isConst ? "const " : ""),
+				prefix.c_str(),
+				interface->name.c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				fprintf(out, ", %s %s",
+					convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+			}
+
+			fprintf(out, ") throw();\n");
+		}
+
+		fprintf(out, "\t\t};\n");
+		fprintf(out, "\n");
+
+		if (!interface->super)
+		{
+			if (!interface->compact)
+				fprintf(out, "\t\tvoid* cloopDummy[%d];\n", DUMMY_INSTANCE);
+
+			fprintf(out, "\t\tVTable* cloopVTable;\n");
+			fprintf(out, "\n");
+		}
+
+		bool introducesErrorFlag = interface->errorFlag &&
+			!(interface->super && interface->super->errorFlag);
+
+		if (introducesErrorFlag)
+		{
+			fprintf(out, "\t\tint cloopErrorFlag;\n");
+			fprintf(out, "\n");
+		}
+
+		fprintf(out, "\tprotected:\n");
+		fprintf(out, "\t\t%s%s(DoNotInherit)\n", prefix.c_str(), interface->name.c_str());
+
+		if (interface->super)
+		{
+			fprintf(out, "\t\t\t: %s%s(DoNotInherit())%s\n",
+				prefix.c_str(), interface->super->name.c_str(),
+				(introducesErrorFlag ? "," : ""));
+		}
+
+		if (introducesErrorFlag)
+			fprintf(out, "\t\t\t%s cloopErrorFlag(0)\n", (interface->super ? " " : ":"));
+
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t~%s%s()\n", prefix.c_str(), interface->name.c_str());
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\tstatic const unsigned VERSION = %u;\n", interface->version);
+
+		if (interface->hasIid)
+			fprintf(out, "\t\tstatic const unsigned IID = 0x%08Xu;\n", interface->iid);
+
+		if (!interface->constants.empty())
+			fprintf(out, "\n");
+
+		for (vector<Constant*>::iterator j = interface->constants.begin();
+			 j != interface->constants.end();
+			 ++j)
+		{
+			Constant* constant = *j;
+
+			fprintf(out, "\t\tstatic const %s %s = %s;\n",
+				convertType(constant->typeRef).c_str(),
+				constant->name.c_str(),
+				constant->expr->generate(LANGUAGE_CPP, prefix).c_str());
+		}
+
+		unsigned interfaceIndex = i - parser->interfaces.begin();
+		unsigned slot = methods.size() - interface->methods.size();
+
+		for (vector<Method*>::iterator j = interface->methods.begin();
+			 j != interface->methods.end();
+			 ++j, ++slot)
+		{
+			Method* method = *j;
+
+			string statusName;
+
+			if (!method->parameters.empty() &&
+				parser->exceptionInterface &&
+				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name)
+			{
+				statusName = method->parameters.front()->name;
+			}
+
+			string signature = convertType(method->returnTypeRef) + " " + method->name + "(";
+			string arguments;
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				if (k != method->parameters.begin())
+				{
+					signature += ", ";
+					arguments += ", ";
+				}
+
+				if (k == method->parameters.begin() && !statusName.empty())
+					signature += "StatusType* " + parameter->name;
+				else
+					signature += convertType(parameter->typeRef) + " " + parameter->name;
+
+				arguments += parameter->name;
+			}
+
+			signature += string(")") + (method->isConst ? " const" : "");
+
+			// The untraced wrapper keeps its signature and forwards with NoTracePolicy.
+			fprintf(out, "\n");
+			fprintf(out, "\t\t%s%s\n",
+				(statusName.empty() ? "" : "template <typename StatusType> "), signature.c_str());
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\t%s%s<NoTracePolicy%s>(%s);\n",
+				(method->returnTypeRef.token.type != Token::TYPE_VOID ||
+					method->returnTypeRef.isPointer ? "return " : ""),
+				method->name.c_str(),
+				(statusName.empty() ? "" : ", StatusType"),
+				arguments.c_str());
+			fprintf(out, "\t\t}\n");
+
+			fprintf(out, "\n");
+			fprintf(out, "\t\ttemplate <typename TracePolicy%s> %s\n",
+				(statusName.empty() ? "" : ", typename StatusType"), signature.c_str());
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\tTraceScope<TracePolicy> cloopTrace(%u, %u);\n", interfaceIndex, slot);
+			fprintf(out, "\n");
+
+			if (method->version - (interface->super ? interface->super->version : 0) != 1)
+			{
+				fprintf(out, "\t\t\tif (cloopVTable->version < %d)\n", method->version);
+				fprintf(out, "\t\t\t{\n");
+
+				if (!statusName.empty())
+				{
+					fprintf(out,
+						"\t\t\t\tStatusType::setVersionError(%s, \"%s%s\", cloopVTable->version, %d);\n",
+						statusName.c_str(),
+						prefix.c_str(),
+						interface->name.c_str(),
+						method->version);
+
+					fprintf(out, "\t\t\t\tStatusType::checkException(%s);\n", statusName.c_str());
+				}
+
+				fprintf(out, "\t\t\t\treturn");
+
+				if (method->returnTypeRef.token.type != Token::TYPE_VOID ||
+					method->returnTypeRef.isPointer)
+				{
+					fprintf(out, " %s",
+						(method->notImplementedExpr ?
+							method->notImplementedExpr->generate(LANGUAGE_CPP, prefix).c_str() :
+						 isAggregate(method->returnTypeRef) ?
+							(convertType(method->returnTypeRef) + "()").c_str() :
+							"0"));
+				}
+
+				fprintf(out, ";\n");
+				fprintf(out, "\t\t\t}\n");
+			}
+
+			if (!statusName.empty() && !method->noThrow)
+			{
+				fprintf(out, "\t\t\t");
+
+				if (parser->exceptionInterface->errorFlag)
+					fprintf(out, "if (%s->cloopErrorFlag)\n\t\t\t\t", statusName.c_str());
+
+				fprintf(out, "StatusTraits<StatusType>::clearException(%s)", statusName.c_str());
+
+				fprintf(out, ";\n");
+			}
+
+			fprintf(out, "\t\t\t");
+
+			if (method->returnTypeRef.token.type != Token::TYPE_VOID ||
+				method->returnTypeRef.isPointer)
+			{
+				fprintf(out, "%s ret = ", convertType(method->returnTypeRef).c_str());
+			}
+
+			fprintf(out, "static_cast<VTable*>(this->cloopVTable)->%s(this",
+				method->name.c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+				fprintf(out, ", %s", parameter->name.c_str());
+			}
+
+			fprintf(out, ")");
+			fprintf(out, ";\n");
+
+			if (!statusName.empty() && !method->noThrow)
+			{
+				// Errors are only known to the trace policy when the status has an error flag.
+				if (parser->exceptionInterface->errorFlag)
+				{
+					fprintf(out, "\t\t\tif (%s->cloopErrorFlag)\n", statusName.c_str());
+					fprintf(out, "\t\t\t{\n");
+					fprintf(out, "\t\t\t\tcloopTrace.failed();\n");
+					fprintf(out, "\t\t\t\tStatusTraits<StatusType>::checkException(%s);\n",
+						statusName.c_str());
+					fprintf(out, "\t\t\t}\n");
+				}
+				else
+				{
+					fprintf(out, "\t\t\tStatusTraits<StatusType>::checkException(%s);\n",
+						statusName.c_str());
+				}
+			}
+
+			if (method->returnTypeRef.token.type != Token::TYPE_VOID ||
+				method->returnTypeRef.isPointer)
+			{
+				fprintf(out, "\t\t\treturn ret;\n");
+			}
+
+			fprintf(out, "\t\t}\n");
+
+			// Awaitable overload of an [async] method, without the completion.
+			if (method->syncMethod)
+			{
+				string awaiter = awaiterName(prefix, method);
+				string awaiterArguments;
+
+				if (method->parameters.size() > 1)
+					awaiterArguments = ", " + arguments.substr(0, arguments.rfind(", "));
+
+				fprintf(out, "\n");
+				fprintf(out, "#ifdef CLOOP_COROUTINES\n");
+				fprintf(out, "\t\ttemplate <typename StatusType%s> %s<StatusType> %s(",
+					(statusName.empty() ? " = void" : ""), awaiter.c_str(), method->name.c_str());
+
+				for (vector<Parameter*>::iterator k = method->parameters.begin();
+					 k != method->parameters.end() - 1;
+					 ++k)
+				{
+					Parameter* parameter = *k;
+
+					if (k != method->parameters.begin())
+						fprintf(out, ", ");
+
+					if (k == method->parameters.begin() && !statusName.empty())
+						fprintf(out, "StatusType* %s", parameter->name.c_str());
+					else
+					{
+						fprintf(out, "%s %s",
+							convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+					}
+				}
+
+				fprintf(out, ")%s\n", (method->isConst ? " const" : ""));
+				fprintf(out, "\t\t{\n");
+				fprintf(out, "\t\t\treturn %s<StatusType>(this%s);\n",
+					awaiter.c_str(), awaiterArguments.c_str());
+				fprintf(out, "\t\t}\n");
+				fprintf(out, "#endif\n");
+			}
+
+			// Span overload of a method with arrays or of a batch method, each count taken from
+			// its first array. The other arrays with the same count must have its size, or the
+			// call aborts instead of overrunning them.
+			if (hasArrays(method) || method->scalarMethod)
+			{
+				string spanArguments;
+				string sizeChecks;
+
+				for (vector<Parameter*>::iterator k = method->parameters.begin();
+					 k != method->parameters.end();
+					 ++k)
+				{
+					Parameter* parameter = *k;
+					string count = spanCount(method, parameter);
+
+					if (count.empty())
+						continue;
+
+					const Parameter* first = firstSpan(method, findParameter(method, count));
+
+					if (first != parameter)
+					{
+						sizeChecks += (sizeChecks.empty() ? "" : " ||\n\t\t\t\t") + parameter->name +
+							".size() != " + first->name + ".size()";
+					}
+				}
+
+				fprintf(out, "\n");
+				fprintf(out, "#ifdef CLOOP_SPAN\n");
+				fprintf(out, "\t\t%s%s %s(",
+					(statusName.empty() ? "" : "template <typename StatusType> "),
+					convertType(method->returnTypeRef).c_str(), method->name.c_str());
+
+				for (vector<Parameter*>::iterator k = method->parameters.begin();
+					 k != method->parameters.end();
+					 ++k)
+				{
+					Parameter* parameter = *k;
+					const Parameter* array = firstSpan(method, parameter);
+
+					if (k != method->parameters.begin())
+						spanArguments += ", ";
+
+					if (array)
+					{
+						spanArguments += "(" + convertType(parameter->typeRef) + ") " + array->name + ".size()";
+						continue;
+					}
+
+					if (k != method->parameters.begin())
+						fprintf(out, ", ");
+
+					if (k == method->parameters.begin() && !statusName.empty())
+						fprintf(out, "StatusType* %s", parameter->name.c_str());
+					else if (!spanCount(method, parameter).empty())
+					{
+						TypeRef elementRef = parameter->typeRef;
+						elementRef.isPointer = false;
+
+						fprintf(out, "std::span<%s> %s",
+							convertType(elementRef).c_str(), parameter->name.c_str());
+					}
+					else
+					{
+						fprintf(out, "%s %s",
+							convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+					}
+
+					spanArguments += parameter->name +
+						(spanCount(method, parameter).empty() ? "" : ".data()");
+				}
+
+				fprintf(out, ")%s\n", (method->isConst ? " const" : ""));
+				fprintf(out, "\t\t{\n");
+
+				if (!sizeChecks.empty())
+				{
+					fprintf(out, "\t\t\tif (%s)\n", sizeChecks.c_str());
+					fprintf(out, "\t\t\t\tabort();\n");
+					fprintf(out, "\n");
+				}
+
+				fprintf(out, "\t\t\t%s%s(%s);\n",
+					(method->returnTypeRef.token.type != Token::TYPE_VOID ||
+						method->returnTypeRef.isPointer ? "return " : ""),
+					method->name.c_str(), spanArguments.c_str());
+				fprintf(out, "\t\t}\n");
+				fprintf(out, "#endif\n");
+			}
+
+			// Owning overload of a method taking references, moved into its [transfer] parameters.
+			bool transfers = false;
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				if ((*k)->transfer && isRefCounted(parser, (*k)->typeRef))
+					transfers = true;
+			}
+
+			if (transfers)
+			{
+				string refArguments;
+
+				fprintf(out, "\n");
+				fprintf(out, "#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)\n");
+				fprintf(out, "\t\t%s%s %s(",
+					(statusName.empty() ? "" : "template <typename StatusType> "),
+					convertType(method->returnTypeRef).c_str(), method->name.c_str());
+
+				for (vector<Parameter*>::iterator k = method->parameters.begin();
+					 k != method->parameters.end();
+					 ++k)
+				{
+					Parameter* parameter = *k;
+
+					if (k != method->parameters.begin())
+					{
+						fprintf(out, ", ");
+						refArguments += ", ";
+					}
+
+					if (k == method->parameters.begin() && !statusName.empty())
+					{
+						fprintf(out, "StatusType* %s", parameter->name.c_str());
+						refArguments += parameter->name;
+					}
+					else if (parameter->transfer && isRefCounted(parser, parameter->typeRef))
+					{
+						fprintf(out, "Ref<%s%s>&& %s",
+							prefix.c_str(), parameter->typeRef.token.text.c_str(), parameter->name.c_str());
+						refArguments += parameter->name + ".detach()";
+					}
+					else
+					{
+						fprintf(out, "%s %s",
+							convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+						refArguments += parameter->name;
+					}
+				}
+
+				fprintf(out, ")%s\n", (method->isConst ? " const" : ""));
+				fprintf(out, "\t\t{\n");
+				fprintf(out, "\t\t\t%s%s(%s);\n",
+					(method->returnTypeRef.token.type != Token::TYPE_VOID ||
+						method->returnTypeRef.isPointer ? "return " : ""),
+					method->name.c_str(), refArguments.c_str());
+				fprintf(out, "\t\t}\n");
+				fprintf(out, "#endif\n");
+			}
+
+			if (statusName.empty() || method->noThrow)
+				continue;
+
+			// try_ variant: reports the error in the result instead of calling checkException.
+
+			bool isVoid = method->returnTypeRef.token.type == Token::TYPE_VOID &&
+				!method->returnTypeRef.isPointer;
+			string expectedType = string("Expected<") +
+				(isVoid ? "void" : convertType(method->returnTypeRef)) +
+				", typename StatusType::Error>";
+
+			fprintf(out, "\n");
+			fprintf(out, "\t\ttemplate <typename StatusType> %s try_%s(",
+				expectedType.c_str(), method->name.c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				if (k != method->parameters.begin())
+					fprintf(out, ", ");
+
+				if (k == method->parameters.begin())
+					fprintf(out, "StatusType* %s", parameter->name.c_str());
+				else
+				{
+					fprintf(out, "%s %s",
+						convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+				}
+			}
+
+			fprintf(out, ")%s\n", (method->isConst ? " const" : ""));
+			fprintf(out, "\t\t{\n");
+
+			if (method->version - (interface->super ? interface->super->version : 0) != 1)
+			{
+				fprintf(out, "\t\t\tif (cloopVTable->version < %d)\n", method->version);
+				fprintf(out, "\t\t\t{\n");
+				fprintf(out,
+					"\t\t\t\tStatusType::setVersionError(%s, \"%s%s\", cloopVTable->version, %d);\n",
+					statusName.c_str(),
+					prefix.c_str(),
+					interface->name.c_str(),
+					method->version);
+				fprintf(out, "\t\t\t\treturn Unexpected<typename StatusType::Error>(StatusType::getError(%s));\n",
+					statusName.c_str());
+				fprintf(out, "\t\t\t}\n");
+			}
+
+			fprintf(out, "\t\t\t");
+
+			if (parser->exceptionInterface->errorFlag)
+				fprintf(out, "if (%s->cloopErrorFlag)\n\t\t\t\t", statusName.c_str());
+
+			fprintf(out, "StatusTraits<StatusType>::clearException(%s);\n", statusName.c_str());
+			fprintf(out, "\t\t\t");
+
+			if (!isVoid)
+				fprintf(out, "%s ret = ", convertType(method->returnTypeRef).c_str());
+
+			fprintf(out, "static_cast<VTable*>(this->cloopVTable)->%s(this",
+				method->name.c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+				fprintf(out, ", %s", parameter->name.c_str());
+			}
+
+			fprintf(out, ");\n");
+			fprintf(out, "\t\t\tif (StatusType::hasError(%s))\n", statusName.c_str());
+			fprintf(out, "\t\t\t\treturn Unexpected<typename StatusType::Error>(StatusType::getError(%s));\n",
+				statusName.c_str());
+			fprintf(out, "\t\t\treturn %s;\n", (isVoid ? (expectedType + "()").c_str() : "ret"));
+			fprintf(out, "\t\t}\n");
+		}
+
+		fprintf(out, "\t};\n\n");
+	}
+
+	if (parser->exceptionInterface)
+	{
+		string exceptionName = prefix + parser->exceptionInterface->name;
+
+		// The classic protocol clears and checks the status around every call. A status type
+		// may instead specialize StatusTraits deriving from LightStatusTraits: the clear and
+		// check are then done only when StatusType::isDirty reports a pending state. In both,
+		// the dispatchers construct a StatusType over the received status, which may come from
+		// any language, so a light StatusType should be a view forwarding to it, cheap to
+		// construct, with isDirty reading its error word.
+		fprintf(out, "\t// Status protocols\n\n");
+		fprintf(out, "\ttemplate <typename StatusType>\n");
+		fprintf(out, "\tclass StatusHolder\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\texplicit StatusHolder(%s* status)\n", exceptionName.c_str());
+		fprintf(out, "\t\t\t: status(status)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tStatusType* get()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn &status;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tprivate:\n");
+		fprintf(out, "\t\tStatusType status;\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\ttemplate <typename StatusType>\n");
+		fprintf(out, "\tstruct StatusTraits\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\ttypedef StatusHolder<StatusType> Holder;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic void clearException(StatusType* status)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tStatusType::clearException(status);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic void checkException(StatusType* status)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tStatusType::checkException(status);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\ttemplate <typename StatusType>\n");
+		fprintf(out, "\tstruct LightStatusTraits\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\ttypedef StatusHolder<StatusType> Holder;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic void clearException(StatusType* status)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (StatusType::isDirty(status))\n");
+		fprintf(out, "\t\t\t\tStatusType::clearException(status);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic void checkException(StatusType* status)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (StatusType::isDirty(status))\n");
+		fprintf(out, "\t\t\t\tStatusType::checkException(status);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+	}
+
+	if (hasRecorder)
+		generateRecorders();
+
+	if (parser->reflection || hasRpc)
+	{
+		// Reflection<Interface> describes the vtable of an interface in constant expressions. The
+		// Dummy parameter keeps the tables in templates, so they may be defined in the header. They
+		// are generated for the whole IDL with [reflection]; and for RPC, which imports by INDEX.
+		fprintf(out, "\t// Reflection (C++11)\n");
+		fprintf(out, "\n");
+		fprintf(out, "#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)\n");
+		fprintf(out, "\tstruct ParameterInfo\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\tconst char* name;\n");
+		fprintf(out, "\t\tconst char* type;\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tstruct MethodInfo\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\tconst char* name;\n");
+		fprintf(out, "\t\tunsigned slot;\n");
+		fprintf(out, "\t\tunsigned version;\n");
+		fprintf(out, "\t\tconst char* returnType;\n");
+		fprintf(out, "\t\tconst ParameterInfo* parameters;\n");
+		fprintf(out, "\t\tunsigned parameterCount;\n");
+		fprintf(out, "\t\tbool isConst;\n");
+		fprintf(out, "\t\tbool mayThrow;\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\ttemplate <typename Interface, typename Dummy = void>\n");
+		fprintf(out, "\tstruct Reflection;\n");
+
+		for (vector<Interface*>::iterator i = parser->interfaces.begin();
+			 i != parser->interfaces.end();
+			 ++i)
+		{
+			Interface* interface = *i;
+			string name = prefix + interface->name;
+			string self = "Reflection<" + name + ", Dummy>";
+
+			deque<Method*> methods;
+
+			for (Interface* p = interface; p; p = p->super)
+				methods.insert(methods.begin(), p->methods.begin(), p->methods.end());
+
+			fprintf(out, "\n");
+			fprintf(out, "\ttemplate <typename Dummy>\n");
+			fprintf(out, "\tstruct %s\n", self.c_str());
+			fprintf(out, "\t{\n");
+			fprintf(out, "\t\tstatic constexpr const char* NAME = \"%s\";\n", name.c_str());
+			fprintf(out, "\t\tstatic constexpr unsigned INDEX = %u;\n",
+				(unsigned) (i - parser->interfaces.begin()));
+			fprintf(out, "\t\tstatic constexpr unsigned VERSION = %u;\n", interface->version);
+			fprintf(out, "\t\tstatic constexpr unsigned METHOD_COUNT = %u;\n", (unsigned) methods.size());
+
+			for (vector<Method*>::iterator j = interface->methods.begin();
+				 j != interface->methods.end();
+				 ++j)
+			{
+				Method* method = *j;
+
+				if (method->parameters.empty())
+					continue;
+
+				fprintf(out, "\n");
+				fprintf(out, "\t\tstatic constexpr ParameterInfo cloop%sParameters[] =\n",
+					method->name.c_str());
+				fprintf(out, "\t\t{\n");
+
+				for (vector<Parameter*>::iterator k = method->parameters.begin();
+					 k != method->parameters.end();
+					 ++k)
+				{
+					Parameter* parameter = *k;
+
+					fprintf(out, "\t\t\t{\"%s\", \"%s\"}%s\n",
+						parameter->name.c_str(),
+						convertType(parameter->typeRef).c_str(),
+						(k + 1 != method->parameters.end() ? "," : ""));
+				}
+
+				fprintf(out, "\t\t};\n");
+			}
+
+			fprintf(out, "\n");
+			fprintf(out, "\t\tstatic constexpr MethodInfo METHODS[] =\n");
+			fprintf(out, "\t\t{\n");
+
+			for (unsigned slot = 0; slot < methods.size(); ++slot)
+			{
+				Method* method = methods[slot];
+
+				// The parameters table is in the interface declaring the method.
+				Interface* p = interface;
+
+				while (std::find(p->methods.begin(), p->methods.end(), method) == p->methods.end())
+					p = p->super;
+
+				bool mayThrow = !method->parameters.empty() &&
+					parser->exceptionInterface &&
+					method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name &&
+					!method->noThrow;
+				string parameters = method->parameters.empty() ? "nullptr" :
+					(p == interface ? string("cloop") : "Reflection<" + prefix + p->name + ", Dummy>::cloop") +
+						method->name + "Parameters";
+
+				fprintf(out, "\t\t\t{\"%s\", %u, %u, \"%s\", %s, %u, %s, %s}%s\n",
+					method->name.c_str(),
+					slot,
+					method->version,
+					convertType(method->returnTypeRef).c_str(),
+					parameters.c_str(),
+					(unsigned) method->parameters.size(),
+					(method->isConst ? "true" : "false"),
+					(mayThrow ? "true" : "false"),
+					(slot + 1 != methods.size() ? "," : ""));
+			}
+
+			fprintf(out, "\t\t};\n");
+			fprintf(out, "\t};\n");
+			fprintf(out, "\n");
+			fprintf(out, "\ttemplate <typename Dummy>\n");
+			fprintf(out, "\tconstexpr const char* %s::NAME;\n", self.c_str());
+
+			for (vector<Method*>::iterator j = interface->methods.begin();
+				 j != interface->methods.end();
+				 ++j)
+			{
+				Method* method = *j;
+
+				if (method->parameters.empty())
+					continue;
+
+				fprintf(out, "\n");
+				fprintf(out, "\ttemplate <typename Dummy>\n");
+				fprintf(out, "\tconstexpr ParameterInfo %s::cloop%sParameters[];\n",
+					self.c_str(), method->name.c_str());
+			}
+
+			fprintf(out, "\n");
+			fprintf(out, "\ttemplate <typename Dummy>\n");
+			fprintf(out, "\tconstexpr MethodInfo %s::METHODS[];\n", self.c_str());
+		}
+
+		fprintf(out, "#endif\n");
+		fprintf(out, "\n");
+	}
+
+	fprintf(out, "\t// Interfaces implementations\n");
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		Interface* interface = *i;
+
+		deque<Method*> methods;
+
+		for (Interface* p = interface; p; p = p->super)
+			methods.insert(methods.begin(), p->methods.begin(), p->methods.end());
+
+		fprintf(out, "\n");
+		fprintf(out, "\ttemplate <typename Name, typename StatusType, typename Base>\n");
+		fprintf(out, "\tclass %s%sBaseImpl : public Base\n",
+			prefix.c_str(), interface->name.c_str());
+		fprintf(out, "\t{\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\ttypedef %s%s Declaration;\n", prefix.c_str(), interface->name.c_str());
+		fprintf(out, "\n");
+		fprintf(out, "\t\t%s%sBaseImpl(DoNotInherit = DoNotInherit())\n",
+			prefix.c_str(), interface->name.c_str());
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tstatic struct VTableImpl : Base::VTable\n");
+		fprintf(out, "\t\t\t{\n");
+		fprintf(out, "\t\t\t\tVTableImpl()\n");
+		fprintf(out, "\t\t\t\t{\n");
+		fprintf(out, "\t\t\t\t\tthis->version = Base::VERSION;\n");
+
+		for (deque<Method*>::iterator j = methods.begin(); j != methods.end(); ++j)
+		{
+			Method* method = *j;
+
+			fprintf(out, "\t\t\t\t\tthis->%s = &%s%sBaseImpl::cloop%sDispatcher;\n",
+				method->name.c_str(), prefix.c_str(), interface->name.c_str(), method->name.c_str());
+		}
+
+		fprintf(out, "\t\t\t\t}\n");
+		fprintf(out, "\t\t\t} vTable;\n");
+		fprintf(out, "\n");
+
+		fprintf(out, "\t\t\tthis->cloopVTable = &vTable;\n");
+		fprintf(out, "\t\t}\n");
+
+		// We generate all bases dispatchers so indirect overrides work. At the same time, we
+		// inherit from all bases impls, so pure virtual methods are introduced and required to
+		// be overriden in the user's implementation.
+		// The dispatchers reach Name through this class, as Name may implement other interfaces
+		// sharing the same bases (see MultiImpl).
+
+		for (Interface* p = interface; p; p = p->super)
+		{
+			unsigned interfaceIndex =
+				find(parser->interfaces.begin(), parser->interfaces.end(), p) - parser->interfaces.begin();
+			unsigned slot = 0;
+
+			for (Interface* q = p->super; q; q = q->super)
+				slot += q->methods.size();
+
+			for (vector<Method*>::iterator j = p->methods.begin(); j != p->methods.end(); ++j, ++slot)
+			{
+				Method* method = *j;
+
+				fprintf(out, "\n");
+				fprintf(out, "\t\tstatic %s CLOOP_CARG cloop%sDispatcher(%s%s%s* self",
+					convertType(method->returnTypeRef).c_str(),
+					method->name.c_str(),
+					(method->isConst ? "const " : ""),
+					prefix.c_str(),
+					p->name.c_str());
+
+				for (vector<Parameter*>::iterator k = method->parameters.begin();
+					 k != method->parameters.end();
+					 ++k)
+				{
+					Parameter* parameter = *k;
+
+					fprintf(out, ", %s %s",
+						convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+				}
+
+				Parameter* exceptionParameter =
+					(!method->parameters.empty() &&
+					 parser->exceptionInterface &&
+					 method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name
+					) ? method->parameters.front() : NULL;
+
+				fprintf(out, ") throw()\n");
+				fprintf(out, "\t\t{\n");
+				fprintf(out, "\t\t\tTraceScope<typename TraceTraits<Name>::Policy> cloopTrace(%u, %u);\n",
+					interfaceIndex, slot);
+
+				if (!probesProvider.empty())
+					fprintf(out, "\t\t\tProbeScope cloopProbe(%u, %u, self);\n", interfaceIndex, slot);
+				fprintf(out, "\n");
+
+				if (exceptionParameter)
+				{
+					fprintf(out, "\t\t\ttypename StatusTraits<StatusType>::Holder %s2(%s);\n",
+						exceptionParameter->name.c_str(),
+						exceptionParameter->name.c_str());
+					fprintf(out, "\n");
+				}
+
+				if (!method->noThrow)
+				{
+					fprintf(out, "#ifndef CLOOP_NO_EXCEPTIONS\n");
+					fprintf(out, "\t\t\ttry\n");
+					fprintf(out, "\t\t\t{\n");
+					fprintf(out, "#endif\n");
+				}
+
+				fprintf(out, "\t\t\t%s", (method->noThrow ? "" : "\t"));
+
+				if (method->returnTypeRef.token.type != Token::TYPE_VOID ||
+					method->returnTypeRef.isPointer)
+				{
+					fprintf(out, "return ");
+				}
+
+				fprintf(out, "static_cast<%sName*>(static_cast<%s%s%sBaseImpl*>(self))->Name::%s(",
+					(method->isConst ? "const " : ""),
+					(method->isConst ? "const " : ""),
+					prefix.c_str(),
+					interface->name.c_str(),
+					method->name.c_str());
+
+				for (vector<Parameter*>::iterator k = method->parameters.begin();
+					 k != method->parameters.end();
+					 ++k)
+				{
+					Parameter* parameter = *k;
+
+					if (k != method->parameters.begin())
+						fprintf(out, ", ");
+
+					if (parameter == exceptionParameter)
+						fprintf(out, "%s2.get()", parameter->name.c_str());
+					else
+						fprintf(out, "%s", parameter->name.c_str());
+				}
+
+				fprintf(out, ");\n");
+
+				if (method->noThrow)
+				{
+					fprintf(out, "\t\t}\n");
+					continue;
+				}
+
+				fprintf(out, "#ifndef CLOOP_NO_EXCEPTIONS\n");
+				fprintf(out, "\t\t\t}\n");
+				fprintf(out, "\t\t\tcatch (...)\n");
+				fprintf(out, "\t\t\t{\n");
+				fprintf(out, "\t\t\t\tcloopTrace.failed();\n");
+				fprintf(out, "\t\t\t\tStatusType::catchException(%s);\n",
+					(exceptionParameter ? (exceptionParameter->name + "2.get()").c_str() : "0"));
+
+				if (method->returnTypeRef.token.type != Token::TYPE_VOID ||
+					method->returnTypeRef.isPointer)
+				{
+					const char* ret = "\t\t\t\treturn";
+					if (method->onErrorFunction.length())
+					{
+						fprintf(out, "%s %s();\n",
+							ret, method->onErrorFunction.c_str());
+					}
+					else
+					{
+						fprintf(out, (isAggregate(method->returnTypeRef) ? "%s %s();\n" : "%s static_cast<%s>(0);\n"),
+							ret, convertType(method->returnTypeRef).c_str());
+					}
+				}
+
+				fprintf(out, "\t\t\t}\n");
+				fprintf(out, "#endif\n");
+
+				fprintf(out, "\t\t}\n");
+			}
+		}
+
+		fprintf(out, "\t};\n\n");
+
+		if (!interface->super)
+		{
+			fprintf(out, "\ttemplate <typename Name, typename StatusType, typename Base = Inherit<%s%s>, "
+				"typename Allocator = DefaultAllocator>\n",
+				prefix.c_str(), interface->name.c_str());
+		}
+		else
+		{
+			string base;
+			unsigned baseCount = 0;
+
+			for (Interface* p = interface->super; p; p = p->super)
+			{
+				base += prefix + p->name + "Impl<Name, StatusType, Inherit<";
+				++baseCount;
+			}
+
+			base += prefix.c_str() + interface->name;
+
+			while (baseCount-- > 0)
+				base += "> > ";
+
+			fprintf(out, "\ttemplate <typename Name, typename StatusType, typename Base = %s, "
+				"typename Allocator = DefaultAllocator>\n", base.c_str());
+		}
+
+		fprintf(out, "\tclass %s%sImpl : public %s%sBaseImpl<Name, StatusType, Base>\n",
+			prefix.c_str(), interface->name.c_str(), prefix.c_str(), interface->name.c_str());
+		fprintf(out, "\t{\n");
+		fprintf(out, "\tprotected:\n");
+		fprintf(out, "\t\t%s%sImpl(DoNotInherit = DoNotInherit())\n",
+			prefix.c_str(), interface->name.c_str());
+
+		bool introducesRefCount = interface->refCounted &&
+			!(interface->super && interface->super->refCounted);
+
+		if (introducesRefCount)
+		{
+			fprintf(out, "#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)\n");
+			fprintf(out, "\t\t\t: cloopRefCount(1)\n");
+			fprintf(out, "#endif\n");
+		}
+
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\tvirtual ~%s%sImpl()\n", prefix.c_str(), interface->name.c_str());
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		// Class-scope allocation functions hide the global ones, so all the forms are declared,
+		// each going to Allocator. The nothrow deletes are only called when a constructor throws
+		// after a nothrow new, with the size of the object unknown.
+		fprintf(out, "\t\tstatic void* operator new(size_t size)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn Allocator::allocate(size);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic void operator delete(void* ptr, size_t size)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tAllocator::deallocate(ptr, size);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic void* operator new(size_t size, const std::nothrow_t& nothrow) throw()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn Allocator::allocate(size, nothrow);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic void operator delete(void* ptr, const std::nothrow_t&) throw()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tAllocator::deallocate(ptr, 0);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic void* operator new(size_t, void* place)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn place;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic void operator delete(void*, void*)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "#ifdef __cpp_aligned_new\n");
+		fprintf(out, "\t\tstatic void* operator new(size_t size, std::align_val_t alignment)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn Allocator::allocate(size, alignment);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic void operator delete(void* ptr, size_t size, std::align_val_t alignment)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tAllocator::deallocate(ptr, size, alignment);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn Allocator::allocate(size, alignment, nothrow);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tAllocator::deallocate(ptr, 0, alignment);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "#endif\n");
+		fprintf(out, "\n");
+
+		for (vector<Method*>::iterator j = interface->methods.begin();
+			 j != interface->methods.end();
+			 ++j)
+		{
+			Method* method = *j;
+
+			Parameter* exceptionParameter =
+				(!method->parameters.empty() &&
+				 parser->exceptionInterface &&
+				 method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name
+				) ? method->parameters.front() : NULL;
+			bool defaultRefCount = introducesRefCount && method->parameters.empty() &&
+				(method->name == "addRef" || method->name == "release");
+
+			if (defaultRefCount)
+				fprintf(out, "#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)\n");
+
+			fprintf(out, "\t\tvirtual %s %s(",
+				convertType(method->returnTypeRef).c_str(), method->name.c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				if (k != method->parameters.begin())
+					fprintf(out, ", ");
+
+				if (parameter == exceptionParameter)
+					fprintf(out, "StatusType* %s", parameter->name.c_str());
+				else
+				{
+					fprintf(out, "%s %s",
+						convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+				}
+			}
+
+			// Default reference counting, with the memory orderings chosen by RefCountTraits.
+			if (defaultRefCount)
+			{
+				fprintf(out, ")%s\n", (method->isConst ? " const" : ""));
+				fprintf(out, "\t\t{\n");
+
+				if (method->name == "addRef")
+				{
+					fprintf(out, "\t\t\tcloopRefCount.fetch_add(1, RefCountTraits<Name>::Order::INCREMENT);\n");
+				}
+				else
+				{
+					fprintf(out, "\t\t\tint count = cloopRefCount.fetch_sub(1, RefCountTraits<Name>::Order::DECREMENT) - 1;\n");
+					fprintf(out, "\n");
+					fprintf(out, "\t\t\tif (count == 0)\n");
+					fprintf(out, "\t\t\t\tdelete this;\n");
+					fprintf(out, "\n");
+					fprintf(out, "\t\t\treturn count;\n");
+				}
+
+				fprintf(out, "\t\t}\n");
+				fprintf(out, "#else\n");
+				fprintf(out, "\t\tvirtual %s %s()%s = 0;\n",
+					convertType(method->returnTypeRef).c_str(), method->name.c_str(),
+					(method->isConst ? " const" : ""));
+				fprintf(out, "#endif\n");
+				continue;
+			}
+
+			// Default async implementation, completing before returning.
+			if (method->syncMethod)
+			{
+				Method* syncMethod = method->syncMethod;
+				bool hasResult = syncMethod->returnTypeRef.token.type != Token::TYPE_VOID ||
+					syncMethod->returnTypeRef.isPointer;
+
+				fprintf(out, ")%s\n", (method->isConst ? " const" : ""));
+				fprintf(out, "\t\t{\n");
+				fprintf(out, "\t\t\t");
+
+				if (hasResult)
+					fprintf(out, "%s result = ", convertType(syncMethod->returnTypeRef).c_str());
+
+				fprintf(out, "%s(", syncMethod->name.c_str());
+
+				for (vector<Parameter*>::iterator k = syncMethod->parameters.begin();
+					 k != syncMethod->parameters.end();
+					 ++k)
+				{
+					if (k != syncMethod->parameters.begin())
+						fprintf(out, ", ");
+
+					fprintf(out, "%s", (*k)->name.c_str());
+				}
+
+				fprintf(out, ");\n");
+
+				if (exceptionParameter && !method->noThrow)
+				{
+					fprintf(out, "#ifdef CLOOP_NO_EXCEPTIONS\n");
+					fprintf(out, "\t\t\tif (StatusType::hasError(%s))\n", exceptionParameter->name.c_str());
+					fprintf(out, "\t\t\t\treturn;\n");
+					fprintf(out, "#endif\n");
+				}
+
+				string arguments;
+
+				if (completesWithStatus(parser, method))
+					arguments = method->parameters.front()->name + (hasResult ? ", " : "");
+
+				if (hasResult)
+					arguments += "result";
+
+				fprintf(out, "\t\t\t%s->complete(%s);\n", method->parameters.back()->name.c_str(),
+					arguments.c_str());
+				fprintf(out, "\t\t}\n");
+				continue;
+			}
+
+			if (!method->scalarMethod)
+			{
+				fprintf(out, ")%s = 0;\n", (method->isConst ? " const" : ""));
+				continue;
+			}
+
+			// Default batch implementation, to be overridden by vectorized ones.
+
+			Method* scalarMethod = method->scalarMethod;
+			bool hasResults = scalarMethod->returnTypeRef.token.type != Token::TYPE_VOID ||
+				scalarMethod->returnTypeRef.isPointer;
+
+			fprintf(out, ")%s\n", (method->isConst ? " const" : ""));
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\tfor (unsigned cloopIndex = 0; cloopIndex < count; ++cloopIndex)\n");
+			fprintf(out, "\t\t\t{\n");
+			fprintf(out, "\t\t\t\t%s%s(", (hasResults ? "results[cloopIndex] = " : ""),
+				scalarMethod->name.c_str());
+
+			for (vector<Parameter*>::iterator k = scalarMethod->parameters.begin();
+				 k != scalarMethod->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				if (k != scalarMethod->parameters.begin())
+					fprintf(out, ", ");
+
+				if (exceptionParameter && k == scalarMethod->parameters.begin())
+					fprintf(out, "%s", parameter->name.c_str());
+				else
+					fprintf(out, "%s[cloopIndex]", parameter->name.c_str());
+			}
+
+			fprintf(out, ");\n");
+
+			if (exceptionParameter && !method->noThrow)
+			{
+				fprintf(out, "#ifdef CLOOP_NO_EXCEPTIONS\n");
+				fprintf(out, "\t\t\t\tif (StatusType::hasError(%s))\n", exceptionParameter->name.c_str());
+				fprintf(out, "\t\t\t\t\treturn;\n");
+				fprintf(out, "#endif\n");
+			}
+
+			fprintf(out, "\t\t\t}\n");
+			fprintf(out, "\t\t}\n");
+		}
+
+		if (introducesRefCount)
+		{
+			fprintf(out, "\n");
+			fprintf(out, "#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)\n");
+			fprintf(out, "\tprivate:\n");
+			fprintf(out, "\t\tstd::atomic<int> cloopRefCount;\n");
+			fprintf(out, "#endif\n");
+		}
+
+		fprintf(out, "\t};\n");
+	}
+
+	// Objects implementing several interfaces answer queryInterface, declared in the IDL as
+	// 'Interface queryInterface(uint id)', from the iids of the implemented interfaces.
+	Method* queryMethod = NULL;
+	bool hasIid = false;
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		Interface* interface = *i;
+
+		if (interface->hasIid)
+			hasIid = true;
+
+		for (vector<Method*>::iterator j = interface->methods.begin();
+			 j != interface->methods.end();
+			 ++j)
+		{
+			Method* method = *j;
+
+			if (method->name == "queryInterface" &&
+				method->parameters.size() == 1 &&
+				method->parameters.front()->typeRef.token.type == Token::TYPE_UINT &&
+				!method->parameters.front()->typeRef.isPointer &&
+				method->returnTypeRef.token.type == Token::TYPE_IDENTIFIER &&
+				method->returnTypeRef.type == BaseType::TYPE_INTERFACE &&
+				!method->returnTypeRef.isPointer)
+			{
+				queryMethod = method;
+			}
+		}
+	}
+
+	if (hasIid && queryMethod)
+	{
+		string resultType = convertType(queryMethod->returnTypeRef);
+
+		fprintf(out, "\n");
+		fprintf(out, "\t// Multiple interfaces implementations (C++14)\n");
+		fprintf(out, "\n");
+		fprintf(out, "#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)\n");
+
+		// Perfect hash of a set of iids, searched at compile time: the slot of an iid is given by
+		// the high bits of its product with factor, and indexes maps each slot to the position
+		// of its iid or to COUNT for unused slots.
+		fprintf(out, "\ttemplate <unsigned COUNT>\n");
+		fprintf(out, "\tstruct InterfaceHash\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\tuint32_t factor;\n");
+		fprintf(out, "\t\tuint32_t bits;\n");
+		fprintf(out, "\t\tunsigned char indexes[256];\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic constexpr uint32_t slot(uint32_t iid, uint32_t factor, uint32_t bits)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn (uint32_t) (iid * factor) >> (32 - bits);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic constexpr InterfaceHash build(const uint32_t (&iids)[COUNT])\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tInterfaceHash hash = {0, 0, {}};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tfor (uint32_t bits = 1; bits <= 8; ++bits)\n");
+		fprintf(out, "\t\t\t{\n");
+		fprintf(out, "\t\t\t\tif ((1u << bits) < COUNT * 2)\n");
+		fprintf(out, "\t\t\t\t\tcontinue;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\t\tfor (uint32_t attempt = 0; attempt < 1024; ++attempt)\n");
+		fprintf(out, "\t\t\t\t{\n");
+		fprintf(out, "\t\t\t\t\tuint32_t factor = 0x9E3779B1u + attempt * 2;\n");
+		fprintf(out, "\t\t\t\t\tbool perfect = true;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\t\t\tfor (uint32_t i = 0; i < (1u << bits); ++i)\n");
+		fprintf(out, "\t\t\t\t\t\thash.indexes[i] = COUNT;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\t\t\tfor (unsigned i = 0; perfect && i < COUNT; ++i)\n");
+		fprintf(out, "\t\t\t\t\t{\n");
+		fprintf(out, "\t\t\t\t\t\tuint32_t n = slot(iids[i], factor, bits);\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\t\t\t\tif (hash.indexes[n] == COUNT)\n");
+		fprintf(out, "\t\t\t\t\t\t\thash.indexes[n] = i;\n");
+		fprintf(out, "\t\t\t\t\t\telse\n");
+		fprintf(out, "\t\t\t\t\t\t\tperfect = false;\n");
+		fprintf(out, "\t\t\t\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\t\t\tif (perfect)\n");
+		fprintf(out, "\t\t\t\t\t{\n");
+		fprintf(out, "\t\t\t\t\t\thash.factor = factor;\n");
+		fprintf(out, "\t\t\t\t\t\thash.bits = bits;\n");
+		fprintf(out, "\t\t\t\t\t\treturn hash;\n");
+		fprintf(out, "\t\t\t\t\t}\n");
+		fprintf(out, "\t\t\t\t}\n");
+		fprintf(out, "\t\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\treturn hash;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\ttemplate <typename Owner, typename... Interfaces>\n");
+		fprintf(out, "\tclass InterfaceTable\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\tstatic %s query(Owner* owner, uint32_t iid)\n", resultType.c_str());
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tunsigned index = HASH.indexes[InterfaceHash<COUNT>::slot(iid, HASH.factor, HASH.bits)];\n");
+		fprintf(out, "\t\t\treturn index < COUNT && IIDS[index] == iid ? CASTS[index](owner) : 0;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tprivate:\n");
+		fprintf(out, "\t\ttemplate <typename Interface>\n");
+		fprintf(out, "\t\tstatic %s cast(Owner* owner)\n", resultType.c_str());
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn static_cast<Interface*>(owner);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic constexpr unsigned COUNT = sizeof...(Interfaces);\n");
+		fprintf(out, "\t\tstatic_assert(COUNT < 128, \"Too many interfaces.\");\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic constexpr uint32_t IIDS[COUNT] = {Interfaces::IID...};\n");
+		fprintf(out, "\t\tstatic constexpr InterfaceHash<COUNT> HASH = InterfaceHash<COUNT>::build(IIDS);\n");
+		fprintf(out, "\t\tstatic_assert(HASH.bits != 0, \"no perfect hash found (duplicate iids?)\");\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tstatic %s (* const CASTS[COUNT])(Owner*);\n", resultType.c_str());
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\ttemplate <typename Owner, typename... Interfaces>\n");
+		fprintf(out, "\tconstexpr uint32_t InterfaceTable<Owner, Interfaces...>::IIDS[];\n");
+		fprintf(out, "\n");
+		fprintf(out, "\ttemplate <typename Owner, typename... Interfaces>\n");
+		fprintf(out, "\tconstexpr InterfaceHash<InterfaceTable<Owner, Interfaces...>::COUNT> "
+			"InterfaceTable<Owner, Interfaces...>::HASH;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\ttemplate <typename Owner, typename... Interfaces>\n");
+		fprintf(out, "\t%s (* const InterfaceTable<Owner, Interfaces...>::CASTS[])(Owner*) =\n",
+			resultType.c_str());
+		fprintf(out, "\t\t{&InterfaceTable::template cast<Interfaces>...};\n");
+		fprintf(out, "\n");
+
+		// Name implements each interface in its own subobject, for example:
+		// class Impl : public MultiImpl<IFooImpl<Impl, StatusType>, IBarImpl<Impl, StatusType> >.
+		// Methods of bases shared by the interfaces are implemented once in Name. The memory
+		// comes from the allocator of the first Impl.
+		fprintf(out, "\ttemplate <typename First, typename... Impls>\n");
+		fprintf(out, "\tclass MultiImpl : public First, public Impls...\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\tvirtual %s %s(%s %s)%s\n",
+			resultType.c_str(),
+			queryMethod->name.c_str(),
+			convertType(queryMethod->parameters.front()->typeRef).c_str(),
+			queryMethod->parameters.front()->name.c_str(),
+			(queryMethod->isConst ? " const" : ""));
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn InterfaceTable<MultiImpl, typename First::Declaration, "
+			"typename Impls::Declaration...>::query(%s, %s);\n",
+			(queryMethod->isConst ? "const_cast<MultiImpl*>(this)" : "this"),
+			queryMethod->parameters.front()->name.c_str());
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tusing First::operator new;\n");
+		fprintf(out, "\t\tusing First::operator delete;\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "#endif\n");
+	}
+
+	// Strings in the commands of the recording proxies and of RPC, written as their length (~0
+	// for null) followed by their characters.
+	if (parser->replay || hasRpc)
+	{
+		fprintf(out, "\n");
+		fprintf(out, "\t// Command strings (C++11)\n");
+		fprintf(out, "\n");
+		fprintf(out, "#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)\n");
+		fprintf(out, "\tinline void appendCommandString(std::vector<uint64_t>& command, const char* str)\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\tif (!str)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tcommand.push_back(~(uint64_t) 0);\n");
+		fprintf(out, "\t\t\treturn;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tsize_t length = strlen(str);\n");
+		fprintf(out, "\t\tsize_t position = command.size() + 1;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tcommand.push_back(length);\n");
+		fprintf(out, "\t\tcommand.resize(position + length / sizeof(uint64_t) + 1);\n");
+		fprintf(out, "\t\tmemcpy(&command[position], str, length);\n");
+		fprintf(out, "\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t// Reads the string at cell, which ends in the zeros filling its last cell.\n");
+		fprintf(out, "\tinline const char* readCommandString(const uint64_t* command, unsigned& cell)\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\tuint64_t length = command[cell++];\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tif (length == ~(uint64_t) 0)\n");
+		fprintf(out, "\t\t\treturn nullptr;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tconst char* str = (const char*) (command + cell);\n");
+		fprintf(out, "\t\tcell += (unsigned) (length / sizeof(uint64_t) + 1);\n");
+		fprintf(out, "\t\treturn str;\n");
+		fprintf(out, "\t}\n");
+		fprintf(out, "#endif\n");
+	}
+
+	if (parser->replay)
+	{
+		// Recording proxies forward the calls to their target and write them to a CallLog, as
+		// commands in the format of CommandBuffer. Objects are written as identities, numbered by
+		// the log as they are seen, and strings as command strings. Only the outermost call of each
+		// thread is written, as calls made while it runs are made again when it's replayed. They are
+		// generated for the whole IDL with [replay];.
+		fprintf(out, "\n");
+		fprintf(out, "\t// Recording proxies (C++11)\n");
+		fprintf(out, "\n");
+		fprintf(out, "#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)\n");
+		fprintf(out, "\tclass CallLog\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\tuint64_t identify(const void* object)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (!object)\n");
+		fprintf(out, "\t\t\t\treturn 0;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tstd::lock_guard<std::mutex> guard(mutex);\n");
+		fprintf(out, "\t\t\tuint64_t& identity = identities[object];\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tif (!identity)\n");
+		fprintf(out, "\t\t\t\tidentity = identities.size();\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\treturn identity;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tvoid write(const std::vector<uint64_t>& command)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tstd::lock_guard<std::mutex> guard(mutex);\n");
+		fprintf(out, "\t\t\tuint64_t* cells = buffer.append((unsigned) command.size());\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tfor (size_t i = 0; i < command.size(); ++i)\n");
+		fprintf(out, "\t\t\t\tcells[i] = command[i];\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t// Number of calls written, which replayCalls returns when it replays all of them.\n");
+		fprintf(out, "\t\tunsigned calls() const\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tunsigned n = 0;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tfor (unsigned position = 0; position < buffer.size(); ++n)\n");
+		fprintf(out, "\t\t\t\tposition += (unsigned) (buffer.data()[position] >> 32);\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\treturn n;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tconst CommandBuffer& commands() const\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn buffer;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tbool save(const char* filename) const\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tFILE* file = fopen(filename, \"wb\");\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tif (!file)\n");
+		fprintf(out, "\t\t\t\treturn false;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tbool ok = fwrite(buffer.data(), sizeof(uint64_t), buffer.size(), file) == buffer.size();\n");
+		fprintf(out, "\t\t\treturn fclose(file) == 0 && ok;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tbool load(const char* filename)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tFILE* file = fopen(filename, \"rb\");\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tif (!file)\n");
+		fprintf(out, "\t\t\t\treturn false;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tuint64_t cell;\n");
+		fprintf(out, "\t\t\tbuffer.clear();\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\twhile (fread(&cell, sizeof(cell), 1, file) == 1)\n");
+		fprintf(out, "\t\t\t\t*buffer.append(1) = cell;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\treturn fclose(file) == 0;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tprivate:\n");
+		fprintf(out, "\t\tstd::mutex mutex;\n");
+		fprintf(out, "\t\tCommandBuffer buffer;\n");
+		fprintf(out, "\t\tstd::unordered_map<const void*, uint64_t> identities;\n");
+		fprintf(out, "\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tclass CallRecording\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\tCallRecording(CallLog* log, unsigned interfaceIndex, unsigned slot, const void* object)\n");
+		fprintf(out, "\t\t\t: log(depth()++ == 0 ? log : nullptr)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (this->log)\n");
+		fprintf(out, "\t\t\t{\n");
+		fprintf(out, "\t\t\t\tcommand.push_back(CommandBuffer::header(0, interfaceIndex, slot));\n");
+		fprintf(out, "\t\t\t\tcommand.push_back(log->identify(object));\n");
+		fprintf(out, "\t\t\t}\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t~CallRecording()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\t--depth();\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tif (log)\n");
+		fprintf(out, "\t\t\t{\n");
+		fprintf(out, "\t\t\t\tcommand[0] |= (uint64_t) command.size() << 32;\n");
+		fprintf(out, "\t\t\t\tlog->write(command);\n");
+		fprintf(out, "\t\t\t}\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tprivate:\n");
+		fprintf(out, "\t\tCallRecording(const CallRecording&);\n");
+		fprintf(out, "\t\tCallRecording& operator =(const CallRecording&);\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\tvoid append(uint64_t cell)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (log)\n");
+		fprintf(out, "\t\t\t\tcommand.push_back(cell);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tvoid appendObject(const void* object)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (log)\n");
+		fprintf(out, "\t\t\t\tcommand.push_back(log->identify(object));\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tvoid appendString(const char* str)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tif (log)\n");
+		fprintf(out, "\t\t\t\tappendCommandString(command, str);\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tprivate:\n");
+		fprintf(out, "\t\tstatic unsigned& depth()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tstatic thread_local unsigned depth;\n");
+		fprintf(out, "\t\t\treturn depth;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\tprivate:\n");
+		fprintf(out, "\t\tCallLog* log;\n");
+		fprintf(out, "\t\tstd::vector<uint64_t> command;\n");
+		fprintf(out, "\t};\n");
+
+		for (vector<Interface*>::iterator i = parser->interfaces.begin();
+			 i != parser->interfaces.end();
+			 ++i)
+		{
+			Interface* interface = *i;
+			string name = prefix + interface->name;
+			string proxy = name + "RecordingProxy";
+
+			deque<Method*> methods;
+			deque<Interface*> owners;
+
+			for (Interface* p = interface; p; p = p->super)
+			{
+				methods.insert(methods.begin(), p->methods.begin(), p->methods.end());
+				owners.insert(owners.begin(), p->methods.size(), p);
+			}
+
+			fprintf(out, "\n");
+			fprintf(out, "\ttemplate <typename StatusType>\n");
+			fprintf(out, "\tclass %s : public %sImpl<%s<StatusType>, StatusType>\n",
+				proxy.c_str(), name.c_str(), proxy.c_str());
+			fprintf(out, "\t{\n");
+			fprintf(out, "\tpublic:\n");
+			fprintf(out, "\t\t%s(%s* target, CallLog* log)\n", proxy.c_str(), name.c_str());
+			fprintf(out, "\t\t\t: target(target),\n");
+			fprintf(out, "\t\t\t  log(log)\n");
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t}\n");
+
+			for (unsigned slot = 0; slot < methods.size(); ++slot)
+			{
+				Method* method = methods[slot];
+				unsigned interfaceIndex = find(parser->interfaces.begin(), parser->interfaces.end(),
+					owners[slot]) - parser->interfaces.begin();
+				bool hasStatus = !method->parameters.empty() &&
+					parser->exceptionInterface &&
+					method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name;
+				bool isVoid = method->returnTypeRef.token.type == Token::TYPE_VOID &&
+					!method->returnTypeRef.isPointer;
+				bool recorded = true;
+
+				for (vector<Parameter*>::iterator k = method->parameters.begin() + (hasStatus ? 1 : 0);
+					 k != method->parameters.end();
+					 ++k)
+				{
+					if (recordKind((*k)->typeRef) == RECORD_NONE)
+						recorded = false;
+				}
+
+				fprintf(out, "\n");
+				fprintf(out, "\t\tvirtual %s %s(", convertType(method->returnTypeRef).c_str(),
+					method->name.c_str());
+
+				for (vector<Parameter*>::iterator k = method->parameters.begin();
+					 k != method->parameters.end();
+					 ++k)
+				{
+					Parameter* parameter = *k;
+
+					if (k != method->parameters.begin())
+						fprintf(out, ", ");
+
+					if (k == method->parameters.begin() && hasStatus)
+						fprintf(out, "StatusType* %s", parameter->name.c_str());
+					else
+					{
+						fprintf(out, "%s %s",
+							convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+					}
+				}
+
+				fprintf(out, ")%s\n", (method->isConst ? " const" : ""));
+				fprintf(out, "\t\t{\n");
+
+				// Calls with arguments not recorded, as pointers, views and structs, are written
+				// without them, and replayCalls stops at their commands.
+				if (!recorded)
+					fprintf(out, "\t\t\t// Arguments not recorded: the replay stops here.\n");
+
+				fprintf(out, "\t\t\tCallRecording recording(log, %u, %u, target);\n",
+					interfaceIndex, slot);
+
+				if (recorded)
+				{
+					for (vector<Parameter*>::iterator k = method->parameters.begin() + (hasStatus ? 1 : 0);
+						 k != method->parameters.end();
+						 ++k)
+					{
+						Parameter* parameter = *k;
+
+						switch (recordKind(parameter->typeRef))
+						{
+							case RECORD_STRING:
+								fprintf(out, "\t\t\trecording.appendString(%s);\n", parameter->name.c_str());
+								break;
+
+							case RECORD_INTERFACE:
+								fprintf(out, "\t\t\trecording.appendObject(%s);\n", parameter->name.c_str());
+								break;
+
+							default:
+								fprintf(out, "\t\t\trecording.append(CommandCell<%s>::encode(%s));\n",
+									convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+								break;
+						}
+					}
+				}
+
+				fprintf(out, "\n");
+
+				fprintf(out, "\t\t\t%starget->%s(", (isVoid ? "" : (convertType(method->returnTypeRef) + " ret = ").c_str()),
+					method->name.c_str());
+
+				for (vector<Parameter*>::iterator k = method->parameters.begin();
+					 k != method->parameters.end();
+					 ++k)
+				{
+					if (k != method->parameters.begin())
+						fprintf(out, ", ");
+
+					fprintf(out, "%s", (*k)->name.c_str());
+				}
+
+				fprintf(out, ");\n");
+
+				// The replay maps the identity of a returned object to the object it gets.
+				if (recorded && recordKind(method->returnTypeRef) == RECORD_INTERFACE)
+					fprintf(out, "\t\t\trecording.appendObject(ret);\n");
+
+				if (!isVoid)
+					fprintf(out, "\t\t\treturn ret;\n");
+
+				fprintf(out, "\t\t}\n");
+			}
+
+			fprintf(out, "\n");
+			fprintf(out, "\tprivate:\n");
+			fprintf(out, "\t\t%s* target;\n", name.c_str());
+			fprintf(out, "\t\tCallLog* log;\n");
+			fprintf(out, "\t};\n");
+		}
+
+		// Replays the commands written by the recording proxies, calling the objects found by their
+		// identities in objects, which is extended with the returned objects. Returns the number of
+		// commands replayed, stopping at the first one not known, as the calls with arguments not
+		// recorded, or made to an object not in objects. Callers compare it with CallLog::calls.
+		fprintf(out, "\n");
+		fprintf(out, "\ttemplate <typename StatusType>\n");
+		fprintf(out, "\tunsigned replayCalls(StatusType* status, const CommandBuffer& commands, "
+			"std::vector<void*>& objects)\n");
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\tunsigned replayed = 0;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\tfor (unsigned position = 0; position < commands.size(); ++replayed)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tconst uint64_t* command = commands.data() + position;\n");
+		fprintf(out, "\t\t\tunsigned size = (unsigned) (command[0] >> 32);\n");
+		fprintf(out, "\t\t\tunsigned cell = 1;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tauto nextObject = [&]() -> void* {\n");
+		fprintf(out, "\t\t\t\tuint64_t identity = command[cell++];\n");
+		fprintf(out, "\t\t\t\treturn identity < objects.size() ? objects[identity] : nullptr;\n");
+		fprintf(out, "\t\t\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tauto bind = [&](void* returned) {\n");
+		fprintf(out, "\t\t\t\tuint64_t identity = cell < size ? command[cell] : 0;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\t\tif (identity >= objects.size())\n");
+		fprintf(out, "\t\t\t\t\tobjects.resize(identity + 1);\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\t\tif (identity)\n");
+		fprintf(out, "\t\t\t\t\tobjects[identity] = returned;\n");
+		fprintf(out, "\t\t\t};\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tvoid* self = nextObject();\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tif (!self)\n");
+		fprintf(out, "\t\t\t\treturn replayed;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\t// Not used when no method returns objects.\n");
+		fprintf(out, "\t\t\t(void) bind;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tswitch ((unsigned) (command[0] & 0xFFFFFFFF))\n");
+		fprintf(out, "\t\t\t{\n");
+
+		for (vector<Interface*>::iterator i = parser->interfaces.begin();
+			 i != parser->interfaces.end();
+			 ++i)
+		{
+			Interface* interface = *i;
+			unsigned interfaceIndex = i - parser->interfaces.begin();
+			unsigned slot = 0;
+
+			for (Interface* p = interface->super; p; p = p->super)
+				slot += p->methods.size();
+
+			for (vector<Method*>::iterator j = interface->methods.begin();
+				 j != interface->methods.end();
+				 ++j, ++slot)
+			{
+				Method* method = *j;
+
+				bool hasStatus = !method->parameters.empty() &&
+					parser->exceptionInterface &&
+					method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name;
+				bool recorded = true;
+
+				for (vector<Parameter*>::iterator k = method->parameters.begin() + (hasStatus ? 1 : 0);
+					 k != method->parameters.end();
+					 ++k)
+				{
+					if (recordKind((*k)->typeRef) == RECORD_NONE)
+						recorded = false;
+				}
+
+				if (!recorded)
+					continue;
+
+				bool returnsObject = recordKind(method->returnTypeRef) == RECORD_INTERFACE;
+
+				fprintf(out, "\t\t\t\tcase (%uu << 16) | %uu:\t// %s%s::%s\n",
+					interfaceIndex, slot, prefix.c_str(), interface->name.c_str(), method->name.c_str());
+				fprintf(out, "\t\t\t\t{\n");
+
+				// Arguments are read in order before the call.
+				for (vector<Parameter*>::iterator k = method->parameters.begin() + (hasStatus ? 1 : 0);
+					 k != method->parameters.end();
+					 ++k)
+				{
+					Parameter* parameter = *k;
+
+					switch (recordKind(parameter->typeRef))
+					{
+						case RECORD_STRING:
+							fprintf(out, "\t\t\t\t\t%s %s = readCommandString(command, cell);\n",
+								convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+							break;
+
+						case RECORD_INTERFACE:
+							fprintf(out, "\t\t\t\t\t%s %s = static_cast<%s>(nextObject());\n",
+								convertType(parameter->typeRef).c_str(), parameter->name.c_str(),
+								convertType(parameter->typeRef).c_str());
+							break;
+
+						default:
+							fprintf(out, "\t\t\t\t\t%s %s = CommandCell<%s>::decode(command[cell++]);\n",
+								convertType(parameter->typeRef).c_str(), parameter->name.c_str(),
+								convertType(parameter->typeRef).c_str());
+							break;
+					}
+				}
+
+				fprintf(out, "\t\t\t\t\t%sstatic_cast<%s%s%s*>(self)->%s(",
+					(returnsObject ? "bind(" : ""),
+					(method->isConst ? "const " : ""),
+					prefix.c_str(), interface->name.c_str(), method->name.c_str());
+
+				for (vector<Parameter*>::iterator k = method->parameters.begin();
+					 k != method->parameters.end();
+					 ++k)
+				{
+					if (k != method->parameters.begin())
+						fprintf(out, ", ");
+
+					fprintf(out, "%s", (k == method->parameters.begin() && hasStatus ?
+						"status" : (*k)->name.c_str()));
+				}
+
+				fprintf(out, ")%s;\n", (returnsObject ? ")" : ""));
+				fprintf(out, "\t\t\t\t\tbreak;\n");
+				fprintf(out, "\t\t\t\t}\n");
+				fprintf(out, "\n");
+			}
+		}
+
+		fprintf(out, "\t\t\t\tdefault:\n");
+		fprintf(out, "\t\t\t\t\treturn replayed;\n");
+		fprintf(out, "\t\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tposition += size;\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\treturn replayed;\n");
+		fprintf(out, "\t}\n");
+		fprintf(out, "#endif\n");
+	}
+
+	if (hasRpc)
+		generateRpc();
+
+	if (hasActor)
+		generateActors();
+
+	if (hasShared)
+		generateEpoch();
+
+	// Awaiters start an [async] method when the coroutine is suspended and resume it from
+	// the completion, which may run before the call returns or later, in another thread. A
+	// call completed before returning doesn't suspend the coroutine. Errors are reported by
+	// the call itself and checked by its wrapper, or by the status given to the completion,
+	// which await_resume throws when the status type does. failed() tells both apart from
+	// successful calls for status types that don't throw.
+	if (hasAsync)
+	{
+		fprintf(out, "\n");
+		fprintf(out, "\t// Awaitable async calls (C++20)\n");
+		fprintf(out, "\n");
+		fprintf(out, "#ifdef CLOOP_COROUTINES\n");
+	}
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		Interface* interface = *i;
+		string name = prefix + interface->name;
+
+		for (vector<Method*>::iterator j = interface->methods.begin();
+			 j != interface->methods.end();
+			 ++j)
+		{
+			Method* method = *j;
+
+			if (!method->syncMethod)
+				continue;
+
+			Method* syncMethod = method->syncMethod;
+			string awaiter = awaiterName(prefix, method);
+			string completion = prefix + method->parameters.back()->typeRef.token.text;
+			bool hasStatus = !method->parameters.empty() &&
+				parser->exceptionInterface &&
+				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name;
+			bool hasResult = syncMethod->returnTypeRef.token.type != Token::TYPE_VOID ||
+				syncMethod->returnTypeRef.isPointer;
+			bool checked = hasStatus && !method->noThrow;
+			bool completionStatus = completesWithStatus(parser, method);
+			string resultType = convertType(syncMethod->returnTypeRef);
+			string constness = method->isConst ? "const " : "";
+
+			fprintf(out, "\n");
+			fprintf(out, "\ttemplate <typename StatusType>\n");
+			fprintf(out, "\tclass %s : public %s\n", awaiter.c_str(), completion.c_str());
+			fprintf(out, "\t{\n");
+			fprintf(out, "\tpublic:\n");
+			fprintf(out, "\t\t%s(%s%s* object", awaiter.c_str(), constness.c_str(), name.c_str());
+
+			for (vector<Parameter*>::iterator k = syncMethod->parameters.begin();
+				 k != syncMethod->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				if (k == syncMethod->parameters.begin() && hasStatus)
+					fprintf(out, ", StatusType* %s", parameter->name.c_str());
+				else
+				{
+					fprintf(out, ", %s %s",
+						convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+				}
+			}
+
+			fprintf(out, ")\n");
+			fprintf(out, "\t\t\t: %s(DoNotInherit()),\n", completion.c_str());
+			fprintf(out, "\t\t\t  object(object),\n");
+
+			for (vector<Parameter*>::iterator k = syncMethod->parameters.begin();
+				 k != syncMethod->parameters.end();
+				 ++k)
+			{
+				fprintf(out, "\t\t\t  %s(%s),\n", (*k)->name.c_str(), (*k)->name.c_str());
+			}
+
+			fprintf(out, "\t\t\t  state(STARTING),\n");
+			fprintf(out, "\t\t\t  failure(false)%s\n", (hasResult ? "," : ""));
+
+			if (hasResult)
+				fprintf(out, "\t\t\t  result()\n");
+
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\tstatic struct VTableImpl : VTable\n");
+			fprintf(out, "\t\t\t{\n");
+			fprintf(out, "\t\t\t\tVTableImpl()\n");
+			fprintf(out, "\t\t\t\t{\n");
+			fprintf(out, "\t\t\t\t\tthis->version = %s::VERSION;\n", completion.c_str());
+			fprintf(out, "\t\t\t\t\tthis->complete = &%s::cloopcompleteDispatcher;\n", awaiter.c_str());
+			fprintf(out, "\t\t\t\t}\n");
+			fprintf(out, "\t\t\t} vTable;\n");
+			fprintf(out, "\n");
+			fprintf(out, "\t\t\tthis->cloopVTable = &vTable;\n");
+			fprintf(out, "\t\t}\n");
+			fprintf(out, "\n");
+			fprintf(out, "\t\t%s(const %s&) = delete;\n", awaiter.c_str(), awaiter.c_str());
+			fprintf(out, "\t\t%s& operator =(const %s&) = delete;\n", awaiter.c_str(), awaiter.c_str());
+			fprintf(out, "\n");
+			fprintf(out, "\t\tbool await_ready() const\n");
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\treturn false;\n");
+			fprintf(out, "\t\t}\n");
+			fprintf(out, "\n");
+			fprintf(out, "\t\tbool await_suspend(std::coroutine_handle<> handle)\n");
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\tthis->handle = handle;\n");
+			fprintf(out, "\t\t\tobject->%s(", method->name.c_str());
+
+			for (vector<Parameter*>::iterator k = syncMethod->parameters.begin();
+				 k != syncMethod->parameters.end();
+				 ++k)
+			{
+				fprintf(out, "%s, ", (*k)->name.c_str());
+			}
+
+			fprintf(out, "this);\n");
+
+			// Failed calls don't complete, so the coroutine is resumed with the error unless the
+			// status type has thrown it.
+			if (checked)
+			{
+				fprintf(out, "\t\t\tif (StatusType::hasError(%s))\n",
+					syncMethod->parameters.front()->name.c_str());
+				fprintf(out, "\t\t\t{\n");
+				fprintf(out, "\t\t\t\tfailure = true;\n");
+				fprintf(out, "\t\t\t\treturn false;\n");
+				fprintf(out, "\t\t\t}\n");
+			}
+
+			fprintf(out, "\n");
+			fprintf(out, "\t\t\treturn state.exchange(SUSPENDED) != COMPLETED;\n");
+			fprintf(out, "\t\t}\n");
+			fprintf(out, "\n");
+			fprintf(out, "\t\t%s await_resume()\n", resultType.c_str());
+			fprintf(out, "\t\t{\n");
+
+			if (checked && completionStatus)
+			{
+				fprintf(out, "#ifndef CLOOP_NO_EXCEPTIONS\n");
+				fprintf(out, "\t\t\tif (exception)\n");
+				fprintf(out, "\t\t\t\tstd::rethrow_exception(exception);\n");
+				fprintf(out, "#endif\n");
+
+				if (hasResult)
+					fprintf(out, "\n");
+			}
+
+			if (hasResult)
+				fprintf(out, "\t\t\treturn result;\n");
+
+			fprintf(out, "\t\t}\n");
+			fprintf(out, "\n");
+			fprintf(out, "\t\tbool failed() const\n");
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\treturn failure;\n");
+			fprintf(out, "\t\t}\n");
+			fprintf(out, "\n");
+			fprintf(out, "\tprivate:\n");
+			fprintf(out, "\t\tstatic void CLOOP_CARG cloopcompleteDispatcher(%s* self%s%s) throw()\n",
+				completion.c_str(),
+				(completionStatus ?
+					(", " + prefix + parser->exceptionInterface->name + "* status").c_str() : ""),
+				(hasResult ? (", " + resultType + " result").c_str() : ""));
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\t%s* awaiter = static_cast<%s*>(self);\n", awaiter.c_str(), awaiter.c_str());
+
+			// The error is read through the status type, and thrown by it into an exception
+			// kept for await_resume.
+			if (checked && completionStatus)
+			{
+				fprintf(out, "\n");
+				fprintf(out, "\t\t\ttypename StatusTraits<StatusType>::Holder status2(status);\n");
+				fprintf(out, "\n");
+				fprintf(out, "\t\t\tif (StatusType::hasError(status2.get()))\n");
+				fprintf(out, "\t\t\t{\n");
+				fprintf(out, "\t\t\t\tawaiter->failure = true;\n");
+				fprintf(out, "#ifndef CLOOP_NO_EXCEPTIONS\n");
+				fprintf(out, "\t\t\t\ttry\n");
+				fprintf(out, "\t\t\t\t{\n");
+				fprintf(out, "\t\t\t\t\tStatusType::checkException(status2.get());\n");
+				fprintf(out, "\t\t\t\t}\n");
+				fprintf(out, "\t\t\t\tcatch (...)\n");
+				fprintf(out, "\t\t\t\t{\n");
+				fprintf(out, "\t\t\t\t\tawaiter->exception = std::current_exception();\n");
+				fprintf(out, "\t\t\t\t}\n");
+				fprintf(out, "#endif\n");
+				fprintf(out, "\t\t\t}\n");
+				fprintf(out, "\n");
+			}
+
+			if (hasResult)
+				fprintf(out, "\t\t\tawaiter->result = result;\n");
+
+			fprintf(out, "\n");
+			fprintf(out, "\t\t\tif (awaiter->state.exchange(COMPLETED) == SUSPENDED)\n");
+			fprintf(out, "\t\t\t\tawaiter->handle.resume();\n");
+			fprintf(out, "\t\t}\n");
+			fprintf(out, "\n");
+			fprintf(out, "\tprivate:\n");
+			fprintf(out, "\t\tenum State\n");
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\tSTARTING,\n");
+			fprintf(out, "\t\t\tSUSPENDED,\n");
+			fprintf(out, "\t\t\tCOMPLETED\n");
+			fprintf(out, "\t\t};\n");
+			fprintf(out, "\n");
+			fprintf(out, "\t\t%s%s* object;\n", constness.c_str(), name.c_str());
+
+			for (vector<Parameter*>::iterator k = syncMethod->parameters.begin();
+				 k != syncMethod->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				if (k == syncMethod->parameters.begin() && hasStatus)
+					fprintf(out, "\t\tStatusType* %s;\n", parameter->name.c_str());
+				else
+				{
+					fprintf(out, "\t\t%s %s;\n",
+						convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+				}
+			}
+
+			fprintf(out, "\t\tstd::coroutine_handle<> handle;\n");
+			fprintf(out, "\t\tstd::atomic<int> state;\n");
+			fprintf(out, "\t\tbool failure;\n");
+
+			if (checked && completionStatus)
+			{
+				fprintf(out, "#ifndef CLOOP_NO_EXCEPTIONS\n");
+				fprintf(out, "\t\tstd::exception_ptr exception;\n");
+				fprintf(out, "#endif\n");
+			}
+
+			if (hasResult)
+				fprintf(out, "\t\t%s result;\n", resultType.c_str());
+
+			fprintf(out, "\t};\n");
+		}
+	}
+
+	if (hasAsync)
+		fprintf(out, "#endif\n");
+
+	fprintf(out, "};\n\n");
+	fprintf(out, "\n");
+
+	fprintf(out, "#endif\t// %s\n", headerGuard.c_str());
+}
+
+// Recorders of the [recorder] interfaces append their calls to a CommandBuffer, and
+// executeCommands makes them through the vtables. The results are read after the execution.
+void CppGenerator::generateRecorders()
+{
+	// Result of a recorded call, valid after the buffer is executed.
+	fprintf(out, "\ttemplate <typename T>\n");
+	fprintf(out, "\tclass CommandResult\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tCommandResult(const CommandBuffer* buffer, unsigned cell)\n");
+	fprintf(out, "\t\t\t: buffer(buffer),\n");
+	fprintf(out, "\t\t\t  cell(cell)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tT get() const\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn CommandCell<T>::decode(buffer->data()[cell]);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tconst CommandBuffer* buffer;\n");
+	fprintf(out, "\t\tunsigned cell;\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+
+	fprintf(out, "\t// Interfaces recorders\n\n");
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		Interface* interface = *i;
+		unsigned interfaceIndex = i - parser->interfaces.begin();
+		unsigned slot = 0;
+
+		if (!interface->recorder)
+			continue;
+
+		for (Interface* p = interface->super; p; p = p->super)
+			slot += p->methods.size();
+
+		if (!interface->super)
+			fprintf(out, "\tclass %s%sRecorder\n", prefix.c_str(), interface->name.c_str());
+		else
+		{
+			fprintf(out, "\tclass %s%sRecorder : public %s%sRecorder\n",
+				prefix.c_str(), interface->name.c_str(),
+				prefix.c_str(), interface->super->name.c_str());
+		}
+
+		fprintf(out, "\t{\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\tstatic const unsigned INTERFACE_INDEX = %u;\n", interfaceIndex);
+		fprintf(out, "\n");
+		fprintf(out, "\t\t%s%sRecorder(CommandBuffer* buffer, %s%s* object)\n",
+			prefix.c_str(), interface->name.c_str(), prefix.c_str(), interface->name.c_str());
+
+		if (interface->super)
+		{
+			fprintf(out, "\t\t\t: %s%sRecorder(buffer, object)\n",
+				prefix.c_str(), interface->super->name.c_str());
+		}
+		else
+		{
+			fprintf(out, "\t\t\t: buffer(buffer),\n");
+			fprintf(out, "\t\t\t  object(object)\n");
+		}
+
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t}\n");
+
+		for (vector<Method*>::iterator j = interface->methods.begin();
+			 j != interface->methods.end();
+			 ++j, ++slot)
+		{
+			Method* method = *j;
+
+			if (hasAggregate(method))
+				continue;
+
+			bool hasStatus = !method->parameters.empty() &&
+				parser->exceptionInterface &&
+				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name;
+			bool hasResult = method->returnTypeRef.token.type != Token::TYPE_VOID ||
+				method->returnTypeRef.isPointer;
+			unsigned size = 2 + method->parameters.size() - (hasStatus ? 1 : 0) + (hasResult ? 1 : 0);
+
+			fprintf(out, "\n");
+
+			if (hasResult)
+			{
+				fprintf(out, "\t\tCommandResult<%s> %s(",
+					convertType(method->returnTypeRef).c_str(), method->name.c_str());
+			}
+			else
+				fprintf(out, "\t\tvoid %s(", method->name.c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin() + (hasStatus ? 1 : 0);
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				if (k != method->parameters.begin() + (hasStatus ? 1 : 0))
+					fprintf(out, ", ");
+
+				fprintf(out, "%s %s",
+					convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+			}
+
+			fprintf(out, ")\n");
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\tuint64_t* command = buffer->append(%u);\n", size);
+			fprintf(out, "\t\t\tcommand[0] = CommandBuffer::header(%u, %u, %u);\n",
+				size, interfaceIndex, slot);
+			fprintf(out, "\t\t\tcommand[1] = CommandCell<void*>::encode(object);\n");
+
+			unsigned cell = 2;
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin() + (hasStatus ? 1 : 0);
+				 k != method->parameters.end();
+				 ++k, ++cell)
+			{
+				Parameter* parameter = *k;
+
+				fprintf(out, "\t\t\tcommand[%u] = CommandCell<%s>::encode(%s);\n",
+					cell, convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+			}
+
+			if (hasResult)
+			{
+				fprintf(out, "\t\t\tcommand[%u] = 0;\n", cell);
+				fprintf(out, "\t\t\treturn CommandResult<%s>(buffer, buffer->size() - 1);\n",
+					convertType(method->returnTypeRef).c_str());
+			}
+
+			fprintf(out, "\t\t}\n");
+		}
+
+		if (!interface->super)
+		{
+			fprintf(out, "\n");
+			fprintf(out, "\tprotected:\n");
+			fprintf(out, "\t\tCommandBuffer* buffer;\n");
+			fprintf(out, "\t\tvoid* object;\n");
+		}
+
+		fprintf(out, "\t};\n\n");
+	}
+
+	// Makes the calls through the vtables, passing the given status, which must be clean, to the
+	// methods that take one. Stops at the first command that fails, is not known or is not
+	// implemented by the object, returning the number of commands successfully executed.
+	fprintf(out, "\ttemplate <typename StatusType>\n");
+	fprintf(out, "\tunsigned executeCommands(StatusType* status, uint64_t* cells, unsigned size)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tunsigned executed = 0;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tfor (unsigned position = 0; position < size; ++executed)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tuint64_t* command = cells + position;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tswitch ((unsigned) (command[0] & 0xFFFFFFFF))\n");
+	fprintf(out, "\t\t\t{\n");
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		Interface* interface = *i;
+		unsigned interfaceIndex = i - parser->interfaces.begin();
+		unsigned slot = 0;
+
+		if (!interface->recorder)
+			continue;
+
+		for (Interface* p = interface->super; p; p = p->super)
+			slot += p->methods.size();
+
+		for (vector<Method*>::iterator j = interface->methods.begin();
+			 j != interface->methods.end();
+			 ++j, ++slot)
+		{
+			Method* method = *j;
+
+			if (hasAggregate(method))
+				continue;
+
+			bool hasStatus = !method->parameters.empty() &&
+				parser->exceptionInterface &&
+				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name;
+			bool hasResult = method->returnTypeRef.token.type != Token::TYPE_VOID ||
+				method->returnTypeRef.isPointer;
+			string type = prefix + interface->name;
+			unsigned cell = 2;
+
+			fprintf(out, "\t\t\t\tcase (%uu << 16) | %uu:\t// %s::%s\n",
+				interfaceIndex, slot, type.c_str(), method->name.c_str());
+			fprintf(out, "\t\t\t\t{\n");
+			fprintf(out, "\t\t\t\t\t%s* object = CommandCell<%s*>::decode(command[1]);\n",
+				type.c_str(), type.c_str());
+			fprintf(out, "\n");
+
+			if (method->version - (interface->super ? interface->super->version : 0) != 1)
+			{
+				fprintf(out, "\t\t\t\t\tif (object->cloopVTable->version < %d)\n", method->version);
+				fprintf(out, "\t\t\t\t\t\treturn executed;\n");
+				fprintf(out, "\n");
+			}
+
+			fprintf(out, "\t\t\t\t\t");
+
+			if (hasResult)
+			{
+				fprintf(out, "command[%u] = CommandCell<%s>::encode(",
+					(unsigned) (2 + method->parameters.size() - (hasStatus ? 1 : 0)),
+					convertType(method->returnTypeRef).c_str());
+			}
+
+			fprintf(out, "static_cast<%s::VTable*>(object->cloopVTable)->%s(object",
+				type.c_str(), method->name.c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				if (k == method->parameters.begin() && hasStatus)
+					fprintf(out, ", status");
+				else
+				{
+					fprintf(out, ", CommandCell<%s>::decode(command[%u])",
+						convertType(parameter->typeRef).c_str(), cell++);
+				}
+			}
+
+			fprintf(out, ")%s;\n", (hasResult ? ")" : ""));
+
+			if (hasStatus && !method->noThrow)
+			{
+				fprintf(out, "\n");
+				fprintf(out, "\t\t\t\t\tif (StatusType::hasError(status))\n");
+				fprintf(out, "\t\t\t\t\t\treturn executed;\n");
+			}
+
+			fprintf(out, "\t\t\t\t\tbreak;\n");
+			fprintf(out, "\t\t\t\t}\n");
+			fprintf(out, "\n");
+		}
+	}
+
+	fprintf(out, "\t\t\t\tdefault:\n");
+	fprintf(out, "\t\t\t\t\treturn executed;\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tposition += (unsigned) (command[0] >> 32);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\treturn executed;\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+}
+
+// Actor proxies have the vtable layout of the interface and run the calls on the thread
+// owning an ActorMailbox. Void methods without a status can't report anything to the caller
+// and are posted when their arguments can be copied or handed over; the others wait for
+// their result, so borrowed interfaces, views and arrays stay valid while they're used.
+// Methods of interfaces with an error flag wait too, and copy the flag of the target.
+// Proxies are created with new: disposing of the target, or releasing its last reference,
+// deletes the proxy too.
+void CppGenerator::generateActors()
+{
+	fprintf(out, "\n");
+	fprintf(out, "\t// Actor proxies (C++11)\n");
+	fprintf(out, "\n");
+	fprintf(out, "#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)\n");
+	fprintf(out, "\tstruct ActorMessage\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tstd::atomic<ActorMessage*> next;\n");
+	fprintf(out, "\t\tvoid (*execute)(ActorMessage* message);\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// Call made by a thread waiting for its result.\n");
+	fprintf(out, "\ttemplate <typename Function, typename Result>\n");
+	fprintf(out, "\tclass ActorCall : public ActorMessage\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tActorCall(Function& function)\n");
+	fprintf(out, "\t\t\t: function(function),\n");
+	fprintf(out, "\t\t\t  done(false)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tthis->execute = &ActorCall::run;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tResult wait()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tstd::unique_lock<std::mutex> lock(mutex);\n");
+	fprintf(out, "\t\t\tcompletion.wait(lock, [this] { return done; });\n");
+	fprintf(out, "\t\t\treturn result;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tstatic void run(ActorMessage* message)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tActorCall* call = static_cast<ActorCall*>(message);\n");
+	fprintf(out, "\t\t\tcall->result = call->function();\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tstd::lock_guard<std::mutex> lock(call->mutex);\n");
+	fprintf(out, "\t\t\tcall->done = true;\n");
+	fprintf(out, "\t\t\tcall->completion.notify_one();\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tFunction& function;\n");
+	fprintf(out, "\t\tResult result;\n");
+	fprintf(out, "\t\tbool done;\n");
+	fprintf(out, "\t\tstd::mutex mutex;\n");
+	fprintf(out, "\t\tstd::condition_variable completion;\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\ttemplate <typename Function>\n");
+	fprintf(out, "\tclass ActorCall<Function, void> : public ActorMessage\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tActorCall(Function& function)\n");
+	fprintf(out, "\t\t\t: function(function),\n");
+	fprintf(out, "\t\t\t  done(false)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tthis->execute = &ActorCall::run;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tvoid wait()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tstd::unique_lock<std::mutex> lock(mutex);\n");
+	fprintf(out, "\t\t\tcompletion.wait(lock, [this] { return done; });\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tstatic void run(ActorMessage* message)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tActorCall* call = static_cast<ActorCall*>(message);\n");
+	fprintf(out, "\t\t\tcall->function();\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tstd::lock_guard<std::mutex> lock(call->mutex);\n");
+	fprintf(out, "\t\t\tcall->done = true;\n");
+	fprintf(out, "\t\t\tcall->completion.notify_one();\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tFunction& function;\n");
+	fprintf(out, "\t\tbool done;\n");
+	fprintf(out, "\t\tstd::mutex mutex;\n");
+	fprintf(out, "\t\tstd::condition_variable completion;\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// Call posted without waiting, deleted after it runs.\n");
+	fprintf(out, "\ttemplate <typename Function>\n");
+	fprintf(out, "\tclass ActorPost : public ActorMessage\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tActorPost(const Function& function)\n");
+	fprintf(out, "\t\t\t: function(function)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tthis->execute = &ActorPost::run;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tstatic void run(ActorMessage* message)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tActorPost* post = static_cast<ActorPost*>(message);\n");
+	fprintf(out, "\t\t\tpost->function();\n");
+	fprintf(out, "\t\t\tdelete post;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tFunction function;\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// Calls queued by any thread, in a lock-free MPSC queue, and run by the thread owning the\n");
+	fprintf(out, "\t// objects. The owner only takes the mutex to sleep when the queue is empty.\n");
+	fprintf(out, "\tclass ActorMailbox\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tActorMailbox()\n");
+	fprintf(out, "\t\t\t: head(&stub),\n");
+	fprintf(out, "\t\t\t  tail(&stub),\n");
+	fprintf(out, "\t\t\t  pending(0),\n");
+	fprintf(out, "\t\t\t  stopped(false)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tstub.next.store(nullptr);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tActorMailbox(const ActorMailbox&);\n");
+	fprintf(out, "\t\tActorMailbox& operator =(const ActorMailbox&);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\t// Runs the calls until stop is called.\n");
+	fprintf(out, "\t\tvoid run()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tOwner owner(this);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\twhile (!stopped)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\t{\n");
+	fprintf(out, "\t\t\t\t\tstd::unique_lock<std::mutex> lock(mutex);\n");
+	fprintf(out, "\t\t\t\t\twakeup.wait(lock, [this] { return pending.load() != 0; });\n");
+	fprintf(out, "\t\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\trunPending();\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Runs the calls queued so far, for owners with their own loop.\n");
+	fprintf(out, "\t\tunsigned drain()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tOwner owner(this);\n");
+	fprintf(out, "\t\t\treturn runPending();\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tvoid stop()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tpost([this] { stopped = true; });\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Runs directly when called by the owner, as from the objects themselves.\n");
+	fprintf(out, "\t\ttemplate <typename Function>\n");
+	fprintf(out, "\t\tauto call(Function function) -> decltype(function())\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tif (current() == this)\n");
+	fprintf(out, "\t\t\t\treturn function();\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tActorCall<Function, decltype(function())> message(function);\n");
+	fprintf(out, "\t\t\tpush(&message);\n");
+	fprintf(out, "\t\t\treturn message.wait();\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\ttemplate <typename Function>\n");
+	fprintf(out, "\t\tvoid post(const Function& function)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tpush(new ActorPost<Function>(function));\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tclass Owner\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\tpublic:\n");
+	fprintf(out, "\t\t\tOwner(ActorMailbox* mailbox)\n");
+	fprintf(out, "\t\t\t\t: previous(current())\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tcurrent() = mailbox;\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t~Owner()\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tcurrent() = previous;\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tprivate:\n");
+	fprintf(out, "\t\t\tActorMailbox* previous;\n");
+	fprintf(out, "\t\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstatic ActorMailbox*& current()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tstatic thread_local ActorMailbox* mailbox;\n");
+	fprintf(out, "\t\t\treturn mailbox;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tvoid push(ActorMessage* message)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tmessage->next.store(nullptr, std::memory_order_relaxed);\n");
+	fprintf(out, "\t\t\thead.exchange(message)->next.store(message, std::memory_order_release);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (pending.fetch_add(1) == 0)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tstd::lock_guard<std::mutex> lock(mutex);\n");
+	fprintf(out, "\t\t\t\twakeup.notify_one();\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Returns null when empty or when a push is not yet linked.\n");
+	fprintf(out, "\t\tActorMessage* pop()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tActorMessage* first = tail;\n");
+	fprintf(out, "\t\t\tActorMessage* next = first->next.load(std::memory_order_acquire);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (first == &stub)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tif (!next)\n");
+	fprintf(out, "\t\t\t\t\treturn nullptr;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\ttail = first = next;\n");
+	fprintf(out, "\t\t\t\tnext = next->next.load(std::memory_order_acquire);\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (!next)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tif (first != head.load())\n");
+	fprintf(out, "\t\t\t\t\treturn nullptr;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\tstub.next.store(nullptr, std::memory_order_relaxed);\n");
+	fprintf(out, "\t\t\t\thead.exchange(&stub)->next.store(&stub, std::memory_order_release);\n");
+	fprintf(out, "\t\t\t\tnext = first->next.load(std::memory_order_acquire);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\tif (!next)\n");
+	fprintf(out, "\t\t\t\t\treturn nullptr;\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\ttail = next;\n");
+	fprintf(out, "\t\t\treturn first;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tunsigned runPending()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tunsigned count = pending.load();\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tfor (unsigned i = 0; i < count; )\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tif (ActorMessage* message = pop())\n");
+	fprintf(out, "\t\t\t\t{\n");
+	fprintf(out, "\t\t\t\t\tpending.fetch_sub(1);\n");
+	fprintf(out, "\t\t\t\t\tmessage->execute(message);\n");
+	fprintf(out, "\t\t\t\t\t++i;\n");
+	fprintf(out, "\t\t\t\t}\n");
+	fprintf(out, "\t\t\t\telse\n");
+	fprintf(out, "\t\t\t\t\tstd::this_thread::yield();\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\treturn count;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tstd::atomic<ActorMessage*> head;\n");
+	fprintf(out, "\t\tActorMessage* tail;\n");
+	fprintf(out, "\t\tActorMessage stub;\n");
+	fprintf(out, "\t\tstd::atomic<unsigned> pending;\n");
+	fprintf(out, "\t\tbool stopped;\n");
+	fprintf(out, "\t\tstd::mutex mutex;\n");
+	fprintf(out, "\t\tstd::condition_variable wakeup;\n");
+	fprintf(out, "\t};\n");
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		Interface* interface = *i;
+
+		if (!interface->actor)
+			continue;
+
+		string name = prefix + interface->name;
+		string proxy = name + "ActorProxy";
+
+		deque<Method*> methods;
+		deque<Interface*> owners;
+
+		for (Interface* p = interface; p; p = p->super)
+		{
+			methods.insert(methods.begin(), p->methods.begin(), p->methods.end());
+			owners.insert(owners.begin(), p->methods.size(), p);
+		}
+
+		fprintf(out, "\n");
+		fprintf(out, "\tclass %s : public %s\n", proxy.c_str(), name.c_str());
+		fprintf(out, "\t{\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\t%s(%s* target, ActorMailbox* mailbox)\n", proxy.c_str(), name.c_str());
+		fprintf(out, "\t\t\t: %s(DoNotInherit()),\n", name.c_str());
+		fprintf(out, "\t\t\t  target(target),\n");
+		fprintf(out, "\t\t\t  mailbox(mailbox)\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\tstatic struct VTableImpl : VTable\n");
+		fprintf(out, "\t\t\t{\n");
+		fprintf(out, "\t\t\t\tVTableImpl()\n");
+		fprintf(out, "\t\t\t\t{\n");
+		fprintf(out, "\t\t\t\t\tthis->version = %s::VERSION;\n", name.c_str());
+
+		for (deque<Method*>::iterator j = methods.begin(); j != methods.end(); ++j)
+		{
+			fprintf(out, "\t\t\t\t\tthis->%s = &%s::cloop%sProxy;\n",
+				(*j)->name.c_str(), proxy.c_str(), (*j)->name.c_str());
+		}
+
+		fprintf(out, "\t\t\t\t}\n");
+		fprintf(out, "\t\t\t} vTable;\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t\tthis->cloopVTable = &vTable;\n");
+
+		if (interface->errorFlag)
+			fprintf(out, "\t\t\tthis->cloopErrorFlag = target->cloopErrorFlag;\n");
+
+		fprintf(out, "\t\t}\n");
+
+		for (unsigned slot = 0; slot < methods.size(); ++slot)
+		{
+			Method* method = methods[slot];
+			Interface* owner = owners[slot];
+			string ownerName = prefix + owner->name;
+			bool hasStatus = !method->parameters.empty() &&
+				parser->exceptionInterface &&
+				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name;
+			bool isVoid = method->returnTypeRef.token.type == Token::TYPE_VOID &&
+				!method->returnTypeRef.isPointer;
+			bool disposal = isDisposal(owner, method);
+			bool mirrored = owner->errorFlag && !disposal;
+			bool posted = isVoid && !hasStatus && !mirrored;
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				if (!isPostable(*k))
+					posted = false;
+			}
+
+			fprintf(out, "\n");
+			fprintf(out, "\t\tstatic %s CLOOP_CARG cloop%sProxy(%s%s* self",
+				convertType(method->returnTypeRef).c_str(), method->name.c_str(),
+				(method->isConst ? "const " : ""), ownerName.c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				fprintf(out, ", %s %s", convertType((*k)->typeRef).c_str(), (*k)->name.c_str());
+			}
+
+			fprintf(out, ") throw()\n");
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\t%s* target = static_cast<const %s*>(self)->target;\n",
+				ownerName.c_str(), proxy.c_str());
+
+			string arguments;
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				arguments += ", ";
+
+				// Posted strings are copied, keeping null apart from empty.
+				if (posted && rpcKind(parameter->typeRef) == RPC_STRING)
+				{
+					fprintf(out, "\t\t\tbool %sNull = !%s;\n",
+						parameter->name.c_str(), parameter->name.c_str());
+					fprintf(out, "\t\t\tstd::string %sCopy(%sNull ? \"\" : %s);\n",
+						parameter->name.c_str(), parameter->name.c_str(), parameter->name.c_str());
+
+					arguments += "(" + parameter->name + "Null ? nullptr : " + parameter->name +
+						"Copy.c_str())";
+				}
+				else
+					arguments += parameter->name;
+			}
+
+			fprintf(out, "\n");
+
+			if (posted)
+				fprintf(out, "\t\t\tstatic_cast<const %s*>(self)->mailbox->post([=] {\n", proxy.c_str());
+			else if (mirrored || disposal)
+			{
+				fprintf(out, "\t\t\t%sstatic_cast<const %s*>(self)->mailbox->call([&] {\n",
+					(isVoid ? "" : (convertType(method->returnTypeRef) + " ret = ").c_str()), proxy.c_str());
+			}
+			else
+			{
+				fprintf(out, "\t\t\t%sstatic_cast<const %s*>(self)->mailbox->call([&] {\n",
+					(isVoid ? "" : "return "), proxy.c_str());
+			}
+
+			fprintf(out, "\t\t\t\t%sstatic_cast<%s::VTable*>(target->cloopVTable)->%s(target%s);\n",
+				(isVoid ? "" : "return "), ownerName.c_str(), method->name.c_str(), arguments.c_str());
+			fprintf(out, "\t\t\t});\n");
+
+			// The caller may check the flag right after the call, so it's copied from the target.
+			if (mirrored)
+			{
+				fprintf(out, "\t\t\tconst_cast<%s*>(self)->cloopErrorFlag = target->cloopErrorFlag;\n",
+					ownerName.c_str());
+			}
+
+			// Posted disposals captured what they use, so the proxy can go before they run.
+			if (disposal)
+			{
+				fprintf(out, "\t\t\t%sdelete static_cast<const %s*>(self);\n",
+					(isVoid ? "" : "if (ret == 0)\n\t\t\t\t"), proxy.c_str());
+			}
+
+			if ((mirrored || disposal) && !isVoid)
+				fprintf(out, "\t\t\treturn ret;\n");
+
+			fprintf(out, "\t\t}\n");
+		}
+
+		fprintf(out, "\n");
+		fprintf(out, "\tprivate:\n");
+		fprintf(out, "\t\t%s* target;\n", name.c_str());
+		fprintf(out, "\t\tActorMailbox* mailbox;\n");
+		fprintf(out, "\t};\n");
+	}
+
+	fprintf(out, "#endif\n");
+}
+
+// Epoch-based disposal lets readers use shared objects without reference counting them,
+// deferring the disposal of the objects replaced meanwhile.
+void CppGenerator::generateEpoch()
+{
+	fprintf(out, "\n");
+	fprintf(out, "\t// Epoch-based disposal (C++11)\n");
+	fprintf(out, "\n");
+	fprintf(out, "#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)\n");
+	fprintf(out, "\t// Reader sections of the process and the objects retired meanwhile. Readers only store the\n");
+	fprintf(out, "\t// epoch they entered in a slot of their own; a retired object is disposed once every reader\n");
+	fprintf(out, "\t// that could still reach it has left its section.\n");
+	fprintf(out, "\tclass EpochReclamation\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\t// Entered by readers, with nesting, before loading shared objects.\n");
+	fprintf(out, "\t\tstatic void enter()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tReader* reader = current();\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (reader->depth++ == 0)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\treader->epoch.store(global().epoch.load(std::memory_order_acquire), std::memory_order_relaxed);\n");
+	fprintf(out, "\t\t\t\tstd::atomic_thread_fence(std::memory_order_seq_cst);\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstatic void leave()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tReader* reader = current();\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (--reader->depth == 0)\n");
+	fprintf(out, "\t\t\t\treader->epoch.store(0, std::memory_order_release);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Disposes an object no longer reachable by new readers after the current ones left.\n");
+	fprintf(out, "\t\ttemplate <typename T>\n");
+	fprintf(out, "\t\tstatic void retire(T* object)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tGlobal& state = global();\n");
+	fprintf(out, "\t\t\tstd::vector<Retired> disposable;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tstd::atomic_thread_fence(std::memory_order_seq_cst);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tstd::lock_guard<std::mutex> lock(state.mutex);\n");
+	fprintf(out, "\t\t\t\tRetired retired = {object, &disposeObject<T>, state.epoch.load(std::memory_order_relaxed)};\n");
+	fprintf(out, "\t\t\t\tstate.retired.push_back(retired);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\tif (state.retired.size() >= state.collectAt)\n");
+	fprintf(out, "\t\t\t\t\ttake(state, disposable);\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tdispose(disposable);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Disposes the retired objects no reader can reach, returning how many are left.\n");
+	fprintf(out, "\t\tstatic unsigned collect()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tGlobal& state = global();\n");
+	fprintf(out, "\t\t\tstd::vector<Retired> disposable;\n");
+	fprintf(out, "\t\t\tunsigned left;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tstd::lock_guard<std::mutex> lock(state.mutex);\n");
+	fprintf(out, "\t\t\t\tleft = take(state, disposable);\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tdispose(disposable);\n");
+	fprintf(out, "\t\t\treturn left;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tstatic const unsigned RETIRE_BATCH = 64;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstruct Reader\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tstd::atomic<uint64_t> epoch;	// entered, 0 outside of sections\n");
+	fprintf(out, "\t\t\tstd::atomic<bool> used;\n");
+	fprintf(out, "\t\t\tReader* next;\n");
+	fprintf(out, "\t\t\tunsigned depth;\n");
+	fprintf(out, "\t\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstruct Retired\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tvoid* object;\n");
+	fprintf(out, "\t\t\tvoid (*dispose)(void* object);\n");
+	fprintf(out, "\t\t\tuint64_t epoch;\n");
+	fprintf(out, "\t\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstruct Global\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tGlobal()\n");
+	fprintf(out, "\t\t\t\t: epoch(1),\n");
+	fprintf(out, "\t\t\t\t  readers(nullptr),\n");
+	fprintf(out, "\t\t\t\t  collectAt(RETIRE_BATCH)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tstd::atomic<uint64_t> epoch;\n");
+	fprintf(out, "\t\t\tstd::atomic<Reader*> readers;	// never removed, reused by new threads\n");
+	fprintf(out, "\t\t\tstd::mutex mutex;\n");
+	fprintf(out, "\t\t\tstd::vector<Retired> retired;\n");
+	fprintf(out, "\t\t\tsize_t collectAt;\n");
+	fprintf(out, "\t\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tclass Thread\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\tpublic:\n");
+	fprintf(out, "\t\t\tThread()\n");
+	fprintf(out, "\t\t\t\t: reader(acquire())\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t~Thread()\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\treader->used.store(false, std::memory_order_release);\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tReader* reader;\n");
+	fprintf(out, "\t\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstatic Global& global()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tstatic Global state;\n");
+	fprintf(out, "\t\t\treturn state;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstatic Reader* current()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tstatic thread_local Thread thread;\n");
+	fprintf(out, "\t\t\treturn thread.reader;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstatic Reader* acquire()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tGlobal& state = global();\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tfor (Reader* reader = state.readers.load(std::memory_order_acquire); reader; reader = reader->next)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tbool used = false;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\tif (!reader->used.load(std::memory_order_relaxed) &&\n");
+	fprintf(out, "\t\t\t\t\treader->used.compare_exchange_strong(used, true, std::memory_order_acquire))\n");
+	fprintf(out, "\t\t\t\t{\n");
+	fprintf(out, "\t\t\t\t\treturn reader;\n");
+	fprintf(out, "\t\t\t\t}\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tReader* reader = new Reader;\n");
+	fprintf(out, "\t\t\treader->epoch.store(0, std::memory_order_relaxed);\n");
+	fprintf(out, "\t\t\treader->used.store(true, std::memory_order_relaxed);\n");
+	fprintf(out, "\t\t\treader->depth = 0;\n");
+	fprintf(out, "\t\t\treader->next = state.readers.load(std::memory_order_relaxed);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\twhile (!state.readers.compare_exchange_weak(reader->next, reader, std::memory_order_release))\n");
+	fprintf(out, "\t\t\t\t;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\treturn reader;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Moves out the objects retired before the oldest epoch of the active readers and\n");
+	fprintf(out, "\t\t// advances the epoch when all of them entered the current one.\n");
+	fprintf(out, "\t\tstatic unsigned take(Global& state, std::vector<Retired>& disposable)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tstd::atomic_thread_fence(std::memory_order_seq_cst);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tuint64_t epoch = state.epoch.load(std::memory_order_relaxed);\n");
+	fprintf(out, "\t\t\tuint64_t oldest = epoch;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tfor (Reader* reader = state.readers.load(std::memory_order_acquire); reader; reader = reader->next)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tuint64_t readerEpoch = reader->epoch.load(std::memory_order_relaxed);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\tif (readerEpoch != 0 && readerEpoch < oldest)\n");
+	fprintf(out, "\t\t\t\t\toldest = readerEpoch;\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (oldest == epoch)\n");
+	fprintf(out, "\t\t\t\tstate.epoch.store(epoch + 1, std::memory_order_release);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tsize_t left = 0;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tfor (size_t i = 0; i < state.retired.size(); ++i)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tif (state.retired[i].epoch < oldest)\n");
+	fprintf(out, "\t\t\t\t\tdisposable.push_back(state.retired[i]);\n");
+	fprintf(out, "\t\t\t\telse\n");
+	fprintf(out, "\t\t\t\t\tstate.retired[left++] = state.retired[i];\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tstate.retired.resize(left);\n");
+	fprintf(out, "\t\t\tstate.collectAt = left * 2 > RETIRE_BATCH ? left * 2 : RETIRE_BATCH;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\treturn (unsigned) left;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Called without the lock, as disposing may retire other objects.\n");
+	fprintf(out, "\t\tstatic void dispose(const std::vector<Retired>& disposable)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tfor (size_t i = 0; i < disposable.size(); ++i)\n");
+	fprintf(out, "\t\t\t\tdisposable[i].dispose(disposable[i].object);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\ttemplate <typename T>\n");
+	fprintf(out, "\t\tstatic void disposeObject(void* object)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tstatic_cast<T*>(object)->dispose();\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// Reader section of a scope.\n");
+	fprintf(out, "\tclass EpochGuard\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tEpochGuard()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tEpochReclamation::enter();\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t~EpochGuard()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tEpochReclamation::leave();\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tEpochGuard(const EpochGuard&) = delete;\n");
+	fprintf(out, "\t\tEpochGuard& operator =(const EpochGuard&) = delete;\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "#endif\n");
+}
+
+// RPC stubs carry the calls over a SharedChannel to the process of the object they stand for,
+// where rpcDispatch makes them through its vtable. Arguments are written as in the recording
+// proxies, with objects as handles of the endpoint and data passed by reference as its length
+// and its bytes. Arrays are copied to the callee unless out and back to the caller unless in.
+// Error flags go along with the handles of their objects and the replies of their methods.
+void CppGenerator::generateRpc()
+{
+	fprintf(out, "\n");
+	fprintf(out, "\t// Shared-memory RPC (C++11, Linux)\n");
+	fprintf(out, "\n");
+	fprintf(out, "#if __cplusplus >= 201103L && defined(__linux__)\n");
+	fprintf(out, "\t// Single-producer single-consumer ring of commands. Commands larger than the ring are passed\n");
+	fprintf(out, "\t// in pieces as the reader consumes them. Readers and writers spin briefly and then sleep on a\n");
+	fprintf(out, "\t// futex of the position they wait for, waking up every WAIT_NS to check that the process at\n");
+	fprintf(out, "\t// the other side is alive. They return false once it has exited.\n");
+	fprintf(out, "\tclass SharedRing\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tstatic const uint32_t CAPACITY = 16384;\n");
+	fprintf(out, "\t\tstatic const long WAIT_NS = 100000000;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tbool write(const uint64_t* command, uint32_t size, const std::atomic<int32_t>& peer)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tuint32_t position = tail.load(std::memory_order_relaxed);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tfor (uint32_t written = 0; written < size;)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tuint32_t consumed;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\twhile (position - (consumed = head.load()) == CAPACITY)\n");
+	fprintf(out, "\t\t\t\t{\n");
+	fprintf(out, "\t\t\t\t\tif (!wait(head, consumed, peer))\n");
+	fprintf(out, "\t\t\t\t\t\treturn false;\n");
+	fprintf(out, "\t\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\tuint32_t count = CAPACITY - (position - consumed);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\tif (count > size - written)\n");
+	fprintf(out, "\t\t\t\t\tcount = size - written;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\tfor (uint32_t i = 0; i < count; ++i)\n");
+	fprintf(out, "\t\t\t\t\tcells[(position + i) & (CAPACITY - 1)] = command[written + i];\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\tposition += count;\n");
+	fprintf(out, "\t\t\t\twritten += count;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\ttail.store(position);\n");
+	fprintf(out, "\t\t\t\twake(tail);\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\treturn true;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tbool read(std::vector<uint64_t>& command, const std::atomic<int32_t>& peer)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tuint32_t position = head.load(std::memory_order_relaxed);\n");
+	fprintf(out, "\t\t\tuint32_t produced;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\twhile ((produced = tail.load()) == position)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tif (!wait(tail, produced, peer))\n");
+	fprintf(out, "\t\t\t\t\treturn false;\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tuint32_t size = (uint32_t) (cells[position & (CAPACITY - 1)] >> 32);\n");
+	fprintf(out, "\t\t\tcommand.resize(size);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tfor (uint32_t read = 0; read < size;)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\twhile ((produced = tail.load()) == position)\n");
+	fprintf(out, "\t\t\t\t{\n");
+	fprintf(out, "\t\t\t\t\tif (!wait(tail, produced, peer))\n");
+	fprintf(out, "\t\t\t\t\t\treturn false;\n");
+	fprintf(out, "\t\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\tuint32_t count = produced - position;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\tif (count > size - read)\n");
+	fprintf(out, "\t\t\t\t\tcount = size - read;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\tfor (uint32_t i = 0; i < count; ++i)\n");
+	fprintf(out, "\t\t\t\t\tcommand[read + i] = cells[(position + i) & (CAPACITY - 1)];\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\tposition += count;\n");
+	fprintf(out, "\t\t\t\tread += count;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\thead.store(position);\n");
+	fprintf(out, "\t\t\t\twake(head);\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\treturn true;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tbool wait(std::atomic<uint32_t>& word, uint32_t value, const std::atomic<int32_t>& peer)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tfor (unsigned spin = 0; spin < 1000; ++spin)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tif (word.load() != value)\n");
+	fprintf(out, "\t\t\t\t\treturn true;\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\twaiters.fetch_add(1);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (word.load() == value)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tstruct timespec timeout = {0, WAIT_NS};\n");
+	fprintf(out, "\t\t\t\tsyscall(SYS_futex, &word, FUTEX_WAIT, value, &timeout, nullptr, 0);\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\twaiters.fetch_sub(1);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\treturn word.load() != value || isAlive(peer.load());\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Processes that haven't opened the channel yet count as alive. Children are checked\n");
+	fprintf(out, "\t\t// without reaping them, as they stay zombies until then.\n");
+	fprintf(out, "\t\tstatic bool isAlive(int32_t pid)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tif (pid == 0)\n");
+	fprintf(out, "\t\t\t\treturn true;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tsiginfo_t info;\n");
+	fprintf(out, "\t\t\tinfo.si_pid = 0;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (waitid(P_PID, (id_t) pid, &info, WEXITED | WNOHANG | WNOWAIT) == 0)\n");
+	fprintf(out, "\t\t\t\treturn info.si_pid == 0;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\treturn kill(pid, 0) == 0 || errno != ESRCH;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tvoid wake(std::atomic<uint32_t>& word)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tif (waiters.load() != 0)\n");
+	fprintf(out, "\t\t\t\tsyscall(SYS_futex, &word, FUTEX_WAKE, 1, nullptr, nullptr, 0);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tstd::atomic<uint32_t> head;\n");
+	fprintf(out, "\t\tstd::atomic<uint32_t> tail;\n");
+	fprintf(out, "\t\tstd::atomic<uint32_t> waiters;\n");
+	fprintf(out, "\t\tuint64_t cells[CAPACITY];\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// Pair of rings in a POSIX shared memory object, created by one process and opened by the other.\n");
+	fprintf(out, "\tstruct SharedChannel\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tSharedRing rings[2];\n");
+	fprintf(out, "\t\tstd::atomic<int32_t> pids[2];\t// of the server and the client, 0 until they open it\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstatic SharedChannel* map(const char* name, bool create)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tint fd = shm_open(name, O_RDWR | (create ? O_CREAT | O_TRUNC : 0), 0600);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (fd < 0)\n");
+	fprintf(out, "\t\t\t\treturn nullptr;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tvoid* memory = MAP_FAILED;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (!create || ftruncate(fd, sizeof(SharedChannel)) == 0)\n");
+	fprintf(out, "\t\t\t\tmemory = mmap(nullptr, sizeof(SharedChannel), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t::close(fd);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\treturn memory == MAP_FAILED ? nullptr : static_cast<SharedChannel*>(memory);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstatic void unmap(SharedChannel* channel)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tmunmap(channel, sizeof(SharedChannel));\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tstatic void remove(const char* name)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tshm_unlink(name);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// Data of a known length, written as its length (~0 for null) followed by its bytes.\n");
+	fprintf(out, "\tinline void appendCommandData(std::vector<uint64_t>& command, const void* data, uint64_t length)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tif (!data)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tcommand.push_back(~(uint64_t) 0);\n");
+	fprintf(out, "\t\t\treturn;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tsize_t position = command.size() + 1;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tcommand.push_back(length);\n");
+	fprintf(out, "\t\tcommand.resize(position + (size_t) ((length + sizeof(uint64_t) - 1) / sizeof(uint64_t)));\n");
+	fprintf(out, "\t\tmemcpy(command.data() + position, data, (size_t) length);\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// Returns the data at cell, left in the command, or null.\n");
+	fprintf(out, "\tinline const void* readCommandData(const uint64_t* command, unsigned& cell, uint64_t& length)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tlength = command[cell++];\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tif (length == ~(uint64_t) 0)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tlength = 0;\n");
+	fprintf(out, "\t\t\treturn nullptr;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tconst void* data = command + cell;\n");
+	fprintf(out, "\t\tcell += (unsigned) ((length + sizeof(uint64_t) - 1) / sizeof(uint64_t));\n");
+	fprintf(out, "\t\treturn data;\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\ttemplate <typename View>\n");
+	fprintf(out, "\tinline View readCommandView(const uint64_t* command, unsigned& cell)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tuint64_t length;\n");
+	fprintf(out, "\t\tconst void* data = readCommandData(command, cell, length);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\treturn View(static_cast<const char*>(data), (size_t) length);\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// Structs are written as their bytes.\n");
+	fprintf(out, "\ttemplate <typename T>\n");
+	fprintf(out, "\tinline void appendCommandValue(std::vector<uint64_t>& command, const T& value)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tsize_t position = command.size();\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tcommand.resize(position + (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t));\n");
+	fprintf(out, "\t\tmemcpy(command.data() + position, &value, sizeof(T));\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\ttemplate <typename T>\n");
+	fprintf(out, "\tinline T readCommandValue(const uint64_t* command, unsigned& cell)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tT value;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tmemcpy(&value, command + cell, sizeof(T));\n");
+	fprintf(out, "\t\tcell += (unsigned) ((sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t));\n");
+	fprintf(out, "\t\treturn value;\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// Copies the elements of an array received into a buffer the callee may write. Arrays the\n");
+	fprintf(out, "\t// callee only writes are received as their length, without data.\n");
+	fprintf(out, "\ttemplate <typename T>\n");
+	fprintf(out, "\tinline T* readCommandBuffer(const uint64_t* command, unsigned& cell, bool sent, std::vector<T>& buffer)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tuint64_t length = command[cell++];\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tif (length == ~(uint64_t) 0)\n");
+	fprintf(out, "\t\t\treturn nullptr;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// An element more, so that empty arrays aren't null.\n");
+	fprintf(out, "\t\tbuffer.resize((size_t) (length / sizeof(T)) + 1);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tif (sent)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tmemcpy(buffer.data(), command + cell, (size_t) length);\n");
+	fprintf(out, "\t\t\tcell += (unsigned) ((length + sizeof(uint64_t) - 1) / sizeof(uint64_t));\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\treturn buffer.data();\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\ttemplate <typename T>\n");
+	fprintf(out, "\tinline void appendCommandBuffer(std::vector<uint64_t>& command, const T* data, const std::vector<T>& buffer)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tappendCommandData(command, data, data ? (buffer.size() - 1) * sizeof(T) : 0);\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tclass RpcEndpoint;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tinline void* rpcCreateStub(RpcEndpoint* endpoint, unsigned interfaceIndex);\n");
+	fprintf(out, "\tinline void rpcDestroyStub(void* stub, unsigned interfaceIndex);\n");
+	fprintf(out, "\tinline void rpcDispatch(RpcEndpoint* endpoint, const uint64_t* request, std::vector<uint64_t>& response);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// One side of a channel, used by a single thread. Objects passed to the other side are\n");
+	fprintf(out, "\t// exported with even handles, and handles received are imported as RPC stubs, which have the\n");
+	fprintf(out, "\t// vtable layout of the interface and send the calls back with odd handles. While waiting for\n");
+	fprintf(out, "\t// a response, the endpoint serves the calls made to its own objects, as to a status.\n");
+	fprintf(out, "\t// Disposing a stub disposes the remote object, and frees the stubs of the object on one side\n");
+	fprintf(out, "\t// and forgets its export on the other. Once the other process exits, calls return with empty\n");
+	fprintf(out, "\t// responses, as after it closes the channel.\n");
+	fprintf(out, "\tclass RpcEndpoint\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\t// Handle of the first object exported by the other side. The next ones follow two apart.\n");
+	fprintf(out, "\t\tstatic const uint64_t ROOT = 2;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tRpcEndpoint(SharedChannel* channel, bool server)\n");
+	fprintf(out, "\t\t\t: incoming(&channel->rings[server ? 0 : 1]),\n");
+	fprintf(out, "\t\t\t  outgoing(&channel->rings[server ? 1 : 0]),\n");
+	fprintf(out, "\t\t\t  peer(&channel->pids[server ? 1 : 0]),\n");
+	fprintf(out, "\t\t\t  exports(1),\n");
+	fprintf(out, "\t\t\t  closed(false)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tchannel->pids[server ? 0 : 1].store((int32_t) getpid());\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t~RpcEndpoint()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tfor (auto& i : imports)\n");
+	fprintf(out, "\t\t\t\trpcDestroyStub(i.second, (unsigned) (i.first & 0xFFFF));\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tRpcEndpoint(const RpcEndpoint&);\n");
+	fprintf(out, "\t\tRpcEndpoint& operator =(const RpcEndpoint&);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tuint64_t exportObject(const void* object)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tif (!object)\n");
+	fprintf(out, "\t\t\t\treturn 0;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tauto imported = importHandles.find(object);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (imported != importHandles.end())\n");
+	fprintf(out, "\t\t\t\treturn (imported->second << 1) | 1;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tuint64_t& handle = exportHandles[object];\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (!handle)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\thandle = exports.size();\n");
+	fprintf(out, "\t\t\t\texports.push_back(const_cast<void*>(object));\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\treturn handle << 1;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tvoid* importObject(uint64_t handle, unsigned interfaceIndex)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tif (handle & 1)\n");
+	fprintf(out, "\t\t\t\treturn (handle >> 1) < exports.size() ? exports[handle >> 1] : nullptr;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (!handle)\n");
+	fprintf(out, "\t\t\t\treturn nullptr;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tvoid*& stub = imports[((handle >> 1) << 16) | interfaceIndex];\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (!stub)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tstub = rpcCreateStub(this, interfaceIndex);\n");
+	fprintf(out, "\t\t\t\timportHandles[stub] = handle >> 1;\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\treturn stub;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Forgets an object disposed by a call of the other side. Its handle isn't reused.\n");
+	fprintf(out, "\t\tvoid dropExport(const void* object)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tauto exported = exportHandles.find(object);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (exported != exportHandles.end())\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\texports[exported->second] = nullptr;\n");
+	fprintf(out, "\t\t\t\texportHandles.erase(exported);\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Frees the stubs of a remote object disposed through one of them.\n");
+	fprintf(out, "\t\tvoid dropImport(const void* stub)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tauto imported = importHandles.find(stub);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (imported == importHandles.end())\n");
+	fprintf(out, "\t\t\t\treturn;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tuint64_t handle = imported->second;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tfor (auto i = imports.begin(); i != imports.end();)\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tif ((i->first >> 16) != handle)\n");
+	fprintf(out, "\t\t\t\t{\n");
+	fprintf(out, "\t\t\t\t\t++i;\n");
+	fprintf(out, "\t\t\t\t\tcontinue;\n");
+	fprintf(out, "\t\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\t\timportHandles.erase(i->second);\n");
+	fprintf(out, "\t\t\t\trpcDestroyStub(i->second, (unsigned) (i->first & 0xFFFF));\n");
+	fprintf(out, "\t\t\t\ti = imports.erase(i);\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\ttemplate <typename Interface>\n");
+	fprintf(out, "\t\tInterface* import(uint64_t handle)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn static_cast<Interface*>(importObject(handle, Reflection<Interface>::INDEX));\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Sends a call and waits for its response, serving the calls received meanwhile.\n");
+	fprintf(out, "\t\tvoid call(std::vector<uint64_t>& request, std::vector<uint64_t>& response);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Serves calls until the other side closes the channel or exits.\n");
+	fprintf(out, "\t\tvoid serve();\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tvoid close()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tuint64_t command = CommandBuffer::header(1, CONTROL, CLOSE);\n");
+	fprintf(out, "\t\t\toutgoing->write(&command, 1, *peer);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Strings and views returned by calls are kept until the next one, writable for the\n");
+	fprintf(out, "\t\t// methods returning non-const strings.\n");
+	fprintf(out, "\t\tchar* keep(const void* data, uint64_t length)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tif (!data)\n");
+	fprintf(out, "\t\t\t\treturn nullptr;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\treturned.assign(static_cast<const char*>(data), (size_t) length);\n");
+	fprintf(out, "\t\t\treturn &returned[0];\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tstatic const unsigned CONTROL = 0xFFFF;\n");
+	fprintf(out, "\t\tstatic const unsigned RESPONSE = 0;\n");
+	fprintf(out, "\t\tstatic const unsigned CLOSE = 1;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tvoid dispatch(const std::vector<uint64_t>& request);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tSharedRing* incoming;\n");
+	fprintf(out, "\t\tSharedRing* outgoing;\n");
+	fprintf(out, "\t\tconst std::atomic<int32_t>* peer;\n");
+	fprintf(out, "\t\tstd::vector<void*> exports;\n");
+	fprintf(out, "\t\tstd::unordered_map<const void*, uint64_t> exportHandles;\n");
+	fprintf(out, "\t\tstd::unordered_map<uint64_t, void*> imports;\n");
+	fprintf(out, "\t\tstd::unordered_map<const void*, uint64_t> importHandles;\n");
+	fprintf(out, "\t\tstd::string returned;\n");
+	fprintf(out, "\t\tbool closed;\n");
+	fprintf(out, "\t};\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// Request of a stub, and then its response, read in the order the dispatcher wrote it.\n");
+	fprintf(out, "\tclass RpcCall\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tRpcCall(RpcEndpoint* endpoint, unsigned interfaceIndex, unsigned slot, const void* self)\n");
+	fprintf(out, "\t\t\t: endpoint(endpoint),\n");
+	fprintf(out, "\t\t\t  cell(1)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\trequest.push_back(CommandBuffer::header(0, interfaceIndex, slot));\n");
+	fprintf(out, "\t\t\trequest.push_back(endpoint->exportObject(self));\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tRpcCall(const RpcCall&);\n");
+	fprintf(out, "\t\tRpcCall& operator =(const RpcCall&);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tpublic:\n");
+	fprintf(out, "\t\tvoid append(uint64_t cell)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\trequest.push_back(cell);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tvoid appendObject(const void* object)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\trequest.push_back(endpoint->exportObject(object));\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tvoid appendString(const char* str)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tappendCommandString(request, str);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tvoid appendData(const void* data, uint64_t length)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tappendCommandData(request, data, length);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Array only written by the callee.\n");
+	fprintf(out, "\t\tvoid appendLength(const void* data, uint64_t length)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\trequest.push_back(data ? length : ~(uint64_t) 0);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\ttemplate <typename T>\n");
+	fprintf(out, "\t\tvoid appendValue(const T& value)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tappendCommandValue(request, value);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tvoid invoke()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tendpoint->call(request, response);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tuint64_t result()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn cell < response.size() ? response[cell++] : 0;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tchar* resultString()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tif (cell >= response.size())\n");
+	fprintf(out, "\t\t\t\treturn nullptr;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tconst char* str = readCommandString(response.data(), cell);\n");
+	fprintf(out, "\t\t\treturn endpoint->keep(str, str ? strlen(str) : 0);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\ttemplate <typename View>\n");
+	fprintf(out, "\t\tView resultView()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tuint64_t length = 0;\n");
+	fprintf(out, "\t\t\tconst void* data = cell < response.size() ? readCommandData(response.data(), cell, length) : nullptr;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\treturn View(endpoint->keep(data, length), (size_t) length);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\ttemplate <typename T>\n");
+	fprintf(out, "\t\tT resultValue()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn cell < response.size() ? readCommandValue<T>(response.data(), cell) : T();\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tvoid* resultObject(unsigned interfaceIndex)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn endpoint->importObject(result(), interfaceIndex);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Copies the elements written by the callee to the array of the caller.\n");
+	fprintf(out, "\t\tvoid resultData(void* data)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tuint64_t length = 0;\n");
+	fprintf(out, "\t\t\tconst void* returned = cell < response.size() ? readCommandData(response.data(), cell, length) : nullptr;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (data && returned)\n");
+	fprintf(out, "\t\t\t\tmemcpy(data, returned, (size_t) length);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tprivate:\n");
+	fprintf(out, "\t\tRpcEndpoint* endpoint;\n");
+	fprintf(out, "\t\tstd::vector<uint64_t> request;\n");
+	fprintf(out, "\t\tstd::vector<uint64_t> response;\n");
+	fprintf(out, "\t\tunsigned cell;\n");
+	fprintf(out, "\t};\n");
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		Interface* interface = *i;
+
+		if (!interface->rpc)
+			continue;
+
+		string name = prefix + interface->name;
+		string stub = name + "RpcStub";
+
+		deque<Method*> methods;
+		deque<Interface*> owners;
+
+		for (Interface* p = interface; p; p = p->super)
+		{
+			methods.insert(methods.begin(), p->methods.begin(), p->methods.end());
+			owners.insert(owners.begin(), p->methods.size(), p);
+		}
+
+		fprintf(out, "\n");
+		fprintf(out, "\tclass %s : public %s\n", stub.c_str(), name.c_str());
+		fprintf(out, "\t{\n");
+		fprintf(out, "\tpublic:\n");
+		fprintf(out, "\t\t%s(RpcEndpoint* endpoint)\n", stub.c_str());
+		fprintf(out, "\t\t\t: %s(DoNotInherit()),\n", name.c_str());
+		fprintf(out, "\t\t\t  endpoint(endpoint)\n");
 		fprintf(out, "\t\t{\n");
-		fprintf(out, "\t\t\tstatic struct VTableImpl : Base::VTable\n");
+		fprintf(out, "\t\t\tstatic struct VTableImpl : VTable\n");
 		fprintf(out, "\t\t\t{\n");
 		fprintf(out, "\t\t\t\tVTableImpl()\n");
 		fprintf(out, "\t\t\t\t{\n");
-		fprintf(out, "\t\t\t\t\tthis->version = Base::VERSION;\n");
+		fprintf(out, "\t\t\t\t\tthis->version = %s::VERSION;\n", name.c_str());
 
 		for (deque<Method*>::iterator j = methods.begin(); j != methods.end(); ++j)
 		{
-			Method* method = *j;
-
-			fprintf(out, "\t\t\t\t\tthis->%s = &Name::cloop%sDispatcher;\n",
-				method->name.c_str(), method->name.c_str());
+			fprintf(out, "\t\t\t\t\tthis->%s = &%s::cloop%sStub;\n",
+				(*j)->name.c_str(), stub.c_str(), (*j)->name.c_str());
 		}
 
 		fprintf(out, "\t\t\t\t}\n");
 		fprintf(out, "\t\t\t} vTable;\n");
 		fprintf(out, "\n");
-
 		fprintf(out, "\t\t\tthis->cloopVTable = &vTable;\n");
 		fprintf(out, "\t\t}\n");
 
-		// We generate all bases dispatchers so indirect overrides work. At the same time, we
-		// inherit from all bases impls, so pure virtual methods are introduced and required to
-		// be overriden in the user's implementation.
-
-		for (Interface* p = interface; p; p = p->super)
+		for (unsigned slot = 0; slot < methods.size(); ++slot)
 		{
-			for (vector<Method*>::iterator j = p->methods.begin(); j != p->methods.end(); ++j)
+			Method* method = methods[slot];
+			Interface* owner = owners[slot];
+			unsigned interfaceIndex = find(parser->interfaces.begin(), parser->interfaces.end(),
+				owner) - parser->interfaces.begin();
+			string returnType = convertType(method->returnTypeRef);
+			bool isVoid = method->returnTypeRef.token.type == Token::TYPE_VOID &&
+				!method->returnTypeRef.isPointer;
+			bool mirrored = owner->errorFlag;
+			bool disposal = isDisposal(owner, method);
+			bool hasOutput = false;
+
+			fprintf(out, "\n");
+			fprintf(out, "\t\tstatic %s CLOOP_CARG cloop%sStub(%s%s%s* self",
+				returnType.c_str(), method->name.c_str(),
+				(method->isConst ? "const " : ""), prefix.c_str(), owner->name.c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
 			{
-				Method* method = *j;
+				fprintf(out, ", %s %s", convertType((*k)->typeRef).c_str(), (*k)->name.c_str());
+			}
 
-				fprintf(out, "\n");
-				fprintf(out, "\t\tstatic %s CLOOP_CARG cloop%sDispatcher(%s%s%s* self",
-					convertType(method->returnTypeRef).c_str(),
-					method->name.c_str(),
-					(method->isConst ? "const " : ""),
-					prefix.c_str(),
-					p->name.c_str());
+			fprintf(out, ") throw()\n");
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\tRpcCall call(static_cast<%s%s*>(self)->endpoint, %u, %u, self);\n",
+				(method->isConst ? "const " : ""), stub.c_str(), interfaceIndex, slot);
 
-				for (vector<Parameter*>::iterator k = method->parameters.begin();
-					 k != method->parameters.end();
-					 ++k)
-				{
-					Parameter* parameter = *k;
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+				const char* argument = parameter->name.c_str();
 
-					fprintf(out, ", %s %s",
-						convertType(parameter->typeRef).c_str(), parameter->name.c_str());
-				}
+				switch (rpcKind(parameter->typeRef))
+				{
+					case RPC_STRING:
+						fprintf(out, "\t\t\tcall.appendString(%s);\n", argument);
+						break;
 
-				Parameter* exceptionParameter =
-					(!method->parameters.empty() &&
-					 parser->exceptionInterface &&
-					 method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name
-					) ? method->parameters.front() : NULL;
+					case RPC_INTERFACE:
+						fprintf(out, "\t\t\tcall.appendObject(%s);\n", argument);
 
-				fprintf(out, ") throw()\n");
-				fprintf(out, "\t\t{\n");
+						if (hasErrorFlag(parser, parameter->typeRef))
+						{
+							fprintf(out, "\t\t\tcall.append(CommandCell<int>::encode(%s ? %s->cloopErrorFlag : 0));\n",
+								argument, argument);
+						}
 
-				if (exceptionParameter)
-				{
-					fprintf(out, "\t\t\tStatusType %s2(%s);\n",
-						exceptionParameter->name.c_str(),
-						exceptionParameter->name.c_str());
-					fprintf(out, "\n");
-				}
+						break;
 
-				fprintf(out, "\t\t\ttry\n");
-				fprintf(out, "\t\t\t{\n");
+					case RPC_VIEW:
+						fprintf(out, "\t\t\tcall.appendData(%s.data, %s.length);\n", argument, argument);
+						break;
 
-				fprintf(out, "\t\t\t\t");
+					case RPC_VALUE:
+						fprintf(out, "\t\t\tcall.appendValue(%s);\n", argument);
+						break;
 
-				if (method->returnTypeRef.token.type != Token::TYPE_VOID ||
-					method->returnTypeRef.isPointer)
-				{
-					fprintf(out, "return ");
-				}
+					case RPC_ARRAY:
+					{
+						TypeRef elementTypeRef = parameter->typeRef;
+						elementTypeRef.isConst = elementTypeRef.isPointer = elementTypeRef.isArray = false;
 
-				fprintf(out, "static_cast<%sName*>(self)->Name::%s(",
-					(method->isConst ? "const " : ""),
-					method->name.c_str());
+						fprintf(out, "\t\t\tcall.%s(%s, %s * sizeof(%s));\n",
+							(parameter->direction == Parameter::DIRECTION_OUT ? "appendLength" : "appendData"),
+							argument, rpcCount(method, parameter).c_str(), convertType(elementTypeRef).c_str());
 
-				for (vector<Parameter*>::iterator k = method->parameters.begin();
-					 k != method->parameters.end();
-					 ++k)
-				{
-					Parameter* parameter = *k;
+						if (parameter->direction != Parameter::DIRECTION_IN)
+							hasOutput = true;
 
-					if (k != method->parameters.begin())
-						fprintf(out, ", ");
+						break;
+					}
 
-					if (parameter == exceptionParameter)
-						fprintf(out, "&%s2", parameter->name.c_str());
-					else
-						fprintf(out, "%s", parameter->name.c_str());
+					default:
+						fprintf(out, "\t\t\tcall.append(CommandCell<%s>::encode(%s));\n",
+							convertType(parameter->typeRef).c_str(), argument);
+						break;
 				}
+			}
 
-				fprintf(out, ");\n");
+			fprintf(out, "\n");
+			fprintf(out, "\t\t\tcall.invoke();\n");
 
-				fprintf(out, "\t\t\t}\n");
-				fprintf(out, "\t\t\tcatch (...)\n");
-				fprintf(out, "\t\t\t{\n");
-				fprintf(out, "\t\t\t\tStatusType::catchException(%s);\n",
-					(exceptionParameter ? ("&" + exceptionParameter->name + "2").c_str() : "0"));
+			if (!isVoid)
+			{
+				string result;
 
-				if (method->returnTypeRef.token.type != Token::TYPE_VOID ||
-					method->returnTypeRef.isPointer)
+				switch (rpcKind(method->returnTypeRef))
 				{
-					const char* ret = "\t\t\t\treturn";
-					if (method->onErrorFunction.length())
-					{
-						fprintf(out, "%s %s();\n",
-							ret, method->onErrorFunction.c_str());
-					}
-					else
+					case RPC_STRING:
+						result = "call.resultString()";
+						break;
+
+					case RPC_INTERFACE:
 					{
-						fprintf(out, "%s static_cast<%s>(0);\n",
-							ret, convertType(method->returnTypeRef).c_str());
+						char index[16];
+						sprintf(index, "%u", indexOfInterface(parser, method->returnTypeRef));
+						result = "static_cast<" + returnType + ">(call.resultObject(" + index + "))";
+						break;
 					}
+
+					case RPC_VIEW:
+						result = "call.resultView<" + returnType + ">()";
+						break;
+
+					case RPC_VALUE:
+						result = "call.resultValue<" + returnType + ">()";
+						break;
+
+					default:
+						result = "CommandCell<" + returnType + ">::decode(call.result())";
+						break;
 				}
 
-				fprintf(out, "\t\t\t}\n");
+				if (hasOutput || mirrored || disposal)
+					fprintf(out, "\t\t\t%s ret = %s;\n", returnType.c_str(), result.c_str());
+				else
+					fprintf(out, "\t\t\treturn %s;\n", result.c_str());
+			}
 
-				fprintf(out, "\t\t}\n");
+			if (mirrored)
+			{
+				fprintf(out, "\t\t\tconst_cast<%s%s*>(self)->cloopErrorFlag = CommandCell<int>::decode(call.result());\n",
+					prefix.c_str(), owner->name.c_str());
 			}
-		}
 
-		fprintf(out, "\t};\n\n");
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
 
-		if (!interface->super)
-		{
-			fprintf(out, "\ttemplate <typename Name, typename StatusType, typename Base = Inherit<%s%s> >\n",
-				prefix.c_str(), interface->name.c_str());
-		}
-		else
-		{
-			string base;
-			unsigned baseCount = 0;
+				if (rpcKind(parameter->typeRef) == RPC_ARRAY && parameter->direction != Parameter::DIRECTION_IN)
+					fprintf(out, "\t\t\tcall.resultData(%s);\n", parameter->name.c_str());
+			}
 
-			for (Interface* p = interface->super; p; p = p->super)
+			// The stub is deleted with the others of the object.
+			if (disposal)
 			{
-				base += prefix + p->name + "Impl<Name, StatusType, Inherit<";
-				++baseCount;
-			}
+				if (!isVoid)
+					fprintf(out, "\t\t\tif (ret == 0)\n\t");
 
-			base += prefix.c_str() + interface->name;
+				fprintf(out, "\t\t\tstatic_cast<%s*>(self)->endpoint->dropImport(self);\n", stub.c_str());
+			}
 
-			while (baseCount-- > 0)
-				base += "> > ";
+			if (!isVoid && (hasOutput || mirrored || disposal))
+				fprintf(out, "\t\t\treturn ret;\n");
 
-			fprintf(out, "\ttemplate <typename Name, typename StatusType, typename Base = %s>\n", base.c_str());
+			fprintf(out, "\t\t}\n");
 		}
 
-		fprintf(out, "\tclass %s%sImpl : public %s%sBaseImpl<Name, StatusType, Base>\n",
-			prefix.c_str(), interface->name.c_str(), prefix.c_str(), interface->name.c_str());
-		fprintf(out, "\t{\n");
-		fprintf(out, "\tprotected:\n");
-		fprintf(out, "\t\t%s%sImpl(DoNotInherit = DoNotInherit())\n",
-			prefix.c_str(), interface->name.c_str());
-		fprintf(out, "\t\t{\n");
-		fprintf(out, "\t\t}\n");
 		fprintf(out, "\n");
-		fprintf(out, "\tpublic:\n");
-		fprintf(out, "\t\tvirtual ~%s%sImpl()\n", prefix.c_str(), interface->name.c_str());
-		fprintf(out, "\t\t{\n");
-		fprintf(out, "\t\t}\n");
+		fprintf(out, "\tprivate:\n");
+		fprintf(out, "\t\tRpcEndpoint* endpoint;\n");
+		fprintf(out, "\t};\n");
+	}
+
+	fprintf(out, "\n");
+	fprintf(out, "\tinline void* rpcCreateStub(RpcEndpoint* endpoint, unsigned interfaceIndex)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tswitch (interfaceIndex)\n");
+	fprintf(out, "\t\t{\n");
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		string name = prefix + (*i)->name;
+
+		if (!(*i)->rpc)
+			continue;
+
+		fprintf(out, "\t\t\tcase %u:\n", (unsigned) (i - parser->interfaces.begin()));
+		fprintf(out, "\t\t\t\treturn static_cast<%s*>(new %sRpcStub(endpoint));\n",
+			name.c_str(), name.c_str());
+		fprintf(out, "\n");
+	}
+
+	fprintf(out, "\t\t\tdefault:\n");
+	fprintf(out, "\t\t\t\treturn nullptr;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tinline void rpcDestroyStub(void* stub, unsigned interfaceIndex)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tswitch (interfaceIndex)\n");
+	fprintf(out, "\t\t{\n");
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		string name = prefix + (*i)->name;
+
+		if (!(*i)->rpc)
+			continue;
+
+		fprintf(out, "\t\t\tcase %u:\n", (unsigned) (i - parser->interfaces.begin()));
+		fprintf(out, "\t\t\t\tdelete static_cast<%sRpcStub*>(static_cast<%s*>(stub));\n",
+			name.c_str(), name.c_str());
+		fprintf(out, "\t\t\t\tbreak;\n");
 		fprintf(out, "\n");
+	}
+
+	fprintf(out, "\t\t\tdefault:\n");
+	fprintf(out, "\t\t\t\tbreak;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\t}\n");
+
+	// The server side of the stubs: calls the method of the object through its vtable and
+	// appends the result to the response, followed by the error flag of the object, when it has
+	// one, and the arrays the method has written.
+	fprintf(out, "\n");
+	fprintf(out, "\tinline void rpcDispatch(RpcEndpoint* endpoint, const uint64_t* request, "
+		"std::vector<uint64_t>& response)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tunsigned cell = 2;\n");
+	fprintf(out, "\t\tvoid* self = endpoint->importObject(request[1], 0);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t// Disposed objects get empty responses.\n");
+	fprintf(out, "\t\tif (!self)\n");
+	fprintf(out, "\t\t\treturn;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tswitch ((unsigned) (request[0] & 0xFFFFFFFF))\n");
+	fprintf(out, "\t\t{\n");
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		Interface* interface = *i;
+		string name = prefix + interface->name;
+		unsigned interfaceIndex = i - parser->interfaces.begin();
+		unsigned slot = 0;
+
+		if (!interface->rpc)
+			continue;
+
+		for (Interface* p = interface->super; p; p = p->super)
+			slot += p->methods.size();
 
 		for (vector<Method*>::iterator j = interface->methods.begin();
 			 j != interface->methods.end();
-			 ++j)
+			 ++j, ++slot)
 		{
 			Method* method = *j;
+			string returnType = convertType(method->returnTypeRef);
+			bool isVoid = method->returnTypeRef.token.type == Token::TYPE_VOID &&
+				!method->returnTypeRef.isPointer;
 
-			Parameter* exceptionParameter =
-				(!method->parameters.empty() &&
-				 parser->exceptionInterface &&
-				 method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name
-				) ? method->parameters.front() : NULL;
-
-			fprintf(out, "\t\tvirtual %s %s(",
-				convertType(method->returnTypeRef).c_str(), method->name.c_str());
+			fprintf(out, "\t\t\tcase (%uu << 16) | %uu:\t// %s::%s\n",
+				interfaceIndex, slot, name.c_str(), method->name.c_str());
+			fprintf(out, "\t\t\t{\n");
+			fprintf(out, "\t\t\t\t%s%s* object = static_cast<%s%s*>(self);\n",
+				(method->isConst ? "const " : ""), name.c_str(),
+				(method->isConst ? "const " : ""), name.c_str());
 
 			for (vector<Parameter*>::iterator k = method->parameters.begin();
 				 k != method->parameters.end();
 				 ++k)
 			{
 				Parameter* parameter = *k;
+				string type = convertType(parameter->typeRef);
+				const char* argument = parameter->name.c_str();
 
-				if (k != method->parameters.begin())
-					fprintf(out, ", ");
+				switch (rpcKind(parameter->typeRef))
+				{
+					case RPC_STRING:
+						fprintf(out, "\t\t\t\t%s %s = readCommandString(request, cell);\n",
+							type.c_str(), argument);
+						break;
+
+					case RPC_INTERFACE:
+						fprintf(out, "\t\t\t\t%s %s = static_cast<%s>(endpoint->importObject(request[cell++], %u));\n",
+							type.c_str(), argument, type.c_str(),
+							indexOfInterface(parser, parameter->typeRef));
+
+						if (hasErrorFlag(parser, parameter->typeRef))
+						{
+							fprintf(out, "\n");
+							fprintf(out, "\t\t\t\tif (%s)\n", argument);
+							fprintf(out, "\t\t\t\t\tconst_cast<%s%s*>(%s)->cloopErrorFlag = "
+								"CommandCell<int>::decode(request[cell]);\n",
+								prefix.c_str(), parameter->typeRef.token.text.c_str(), argument);
+							fprintf(out, "\n");
+							fprintf(out, "\t\t\t\t++cell;\n");
+						}
+
+						break;
+
+					case RPC_VIEW:
+					case RPC_VALUE:
+					{
+						TypeRef valueTypeRef = parameter->typeRef;
+						valueTypeRef.isConst = false;
+
+						fprintf(out, "\t\t\t\t%s %s = readCommand%s<%s>(request, cell);\n",
+							type.c_str(), argument,
+							(rpcKind(parameter->typeRef) == RPC_VIEW ? "View" : "Value"),
+							convertType(valueTypeRef).c_str());
+						break;
+					}
 
-				if (parameter == exceptionParameter)
-					fprintf(out, "StatusType* %s", parameter->name.c_str());
-				else
+					case RPC_ARRAY:
+					{
+						TypeRef elementTypeRef = parameter->typeRef;
+						elementTypeRef.isConst = elementTypeRef.isPointer = elementTypeRef.isArray = false;
+
+						fprintf(out, "\t\t\t\tstd::vector<%s> cloop%sBuffer;\n",
+							convertType(elementTypeRef).c_str(), argument);
+						fprintf(out, "\t\t\t\t%s %s = readCommandBuffer(request, cell, %s, cloop%sBuffer);\n",
+							type.c_str(), argument,
+							(parameter->direction == Parameter::DIRECTION_OUT ? "false" : "true"), argument);
+						break;
+					}
+
+					default:
+						fprintf(out, "\t\t\t\t%s %s = CommandCell<%s>::decode(request[cell++]);\n",
+							type.c_str(), argument, type.c_str());
+						break;
+				}
+			}
+
+			fprintf(out, "\t\t\t\t%sstatic_cast<%s::VTable*>(object->cloopVTable)->%s(object",
+				(isVoid ? "" : (returnType + " ret = ").c_str()),
+				name.c_str(), method->name.c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				fprintf(out, ", %s", (*k)->name.c_str());
+			}
+
+			fprintf(out, ");\n");
+
+			if (!isVoid)
+			{
+				switch (rpcKind(method->returnTypeRef))
 				{
-					fprintf(out, "%s %s",
-						convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+					case RPC_STRING:
+						fprintf(out, "\t\t\t\tappendCommandString(response, ret);\n");
+						break;
+
+					case RPC_INTERFACE:
+						fprintf(out, "\t\t\t\tresponse.push_back(endpoint->exportObject(ret));\n");
+						break;
+
+					case RPC_VIEW:
+						fprintf(out, "\t\t\t\tappendCommandData(response, ret.data, ret.length);\n");
+						break;
+
+					case RPC_VALUE:
+						fprintf(out, "\t\t\t\tappendCommandValue(response, ret);\n");
+						break;
+
+					default:
+						fprintf(out, "\t\t\t\tresponse.push_back(CommandCell<%s>::encode(ret));\n",
+							returnType.c_str());
+						break;
 				}
 			}
 
-			fprintf(out, ")%s = 0;\n", (method->isConst ? " const" : ""));
-		}
+			if (interface->errorFlag)
+				fprintf(out, "\t\t\t\tresponse.push_back(CommandCell<int>::encode(object->cloopErrorFlag));\n");
 
-		fprintf(out, "\t};\n");
+			// The object is only used as a key once disposed.
+			if (isDisposal(interface, method))
+			{
+				if (!isVoid)
+					fprintf(out, "\t\t\t\tif (ret == 0)\n\t");
+
+				fprintf(out, "\t\t\t\tendpoint->dropExport(object);\n");
+			}
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				if (rpcKind(parameter->typeRef) == RPC_ARRAY && parameter->direction != Parameter::DIRECTION_IN)
+				{
+					fprintf(out, "\t\t\t\tappendCommandBuffer(response, %s, cloop%sBuffer);\n",
+						parameter->name.c_str(), parameter->name.c_str());
+				}
+			}
+
+			fprintf(out, "\t\t\t\tbreak;\n");
+			fprintf(out, "\t\t\t}\n");
+			fprintf(out, "\n");
+		}
 	}
 
-	fprintf(out, "};\n\n");
+	fprintf(out, "\t\t\tdefault:\n");
+	fprintf(out, "\t\t\t\tbreak;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tinline void RpcEndpoint::call(std::vector<uint64_t>& request, std::vector<uint64_t>& response)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tresponse.clear();\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tif (closed)\n");
+	fprintf(out, "\t\t\treturn;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\trequest[0] |= (uint64_t) request.size() << 32;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tif (!outgoing->write(request.data(), (uint32_t) request.size(), *peer))\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tclosed = true;\n");
+	fprintf(out, "\t\t\treturn;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\twhile (true)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tif (!incoming->read(response, *peer))\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tresponse.clear();\n");
+	fprintf(out, "\t\t\t\tclosed = true;\n");
+	fprintf(out, "\t\t\t\treturn;\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t\tif (((response[0] >> 16) & 0xFFFF) != CONTROL)\n");
+	fprintf(out, "\t\t\t\tdispatch(response);\n");
+	fprintf(out, "\t\t\telse\n");
+	fprintf(out, "\t\t\t{\n");
+	fprintf(out, "\t\t\t\tclosed = (response[0] & 0xFFFF) == CLOSE;\n");
+	fprintf(out, "\t\t\t\treturn;\n");
+	fprintf(out, "\t\t\t}\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\t}\n");
 	fprintf(out, "\n");
-
-	fprintf(out, "#endif\t// %s\n", headerGuard.c_str());
+	fprintf(out, "\tinline void RpcEndpoint::serve()\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tstd::vector<uint64_t> request;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\twhile (!closed)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tif (!incoming->read(request, *peer))\n");
+	fprintf(out, "\t\t\t\tclosed = true;\n");
+	fprintf(out, "\t\t\telse if (((request[0] >> 16) & 0xFFFF) != CONTROL)\n");
+	fprintf(out, "\t\t\t\tdispatch(request);\n");
+	fprintf(out, "\t\t\telse\n");
+	fprintf(out, "\t\t\t\tclosed = (request[0] & 0xFFFF) == CLOSE;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tinline void RpcEndpoint::dispatch(const std::vector<uint64_t>& request)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tstd::vector<uint64_t> response(1);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\trpcDispatch(this, request.data(), response);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tresponse[0] = CommandBuffer::header((unsigned) response.size(), CONTROL, RESPONSE);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tif (!outgoing->write(response.data(), (uint32_t) response.size(), *peer))\n");
+	fprintf(out, "\t\t\tclosed = true;\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "#endif\n");
 }
 
 
@@ -677,6 +5488,67 @@ void CHeaderGenerator::generate()
 	fprintf(out, "#else\n");
 	fprintf(out, "#define CLOOP_EXTERN_C\n");
 	fprintf(out, "#endif\n");
+	fprintf(out, "#endif\n\n");
+
+	// Reflection tables, describing the vtable of each interface.
+	if (parser->reflection)
+	{
+		fprintf(out, "#ifndef CLOOP_REFLECTION_TYPES\n");
+		fprintf(out, "#define CLOOP_REFLECTION_TYPES\n");
+		fprintf(out, "\n");
+		fprintf(out, "struct cloopParameterInfo\n");
+		fprintf(out, "{\n");
+		fprintf(out, "\tconst char* name;\n");
+		fprintf(out, "\tconst char* type;\n");
+		fprintf(out, "};\n");
+		fprintf(out, "\n");
+		fprintf(out, "struct cloopMethodInfo\n");
+		fprintf(out, "{\n");
+		fprintf(out, "\tconst char* name;\n");
+		fprintf(out, "\tunsigned slot;\n");
+		fprintf(out, "\tunsigned version;\n");
+		fprintf(out, "\tconst char* returnType;\n");
+		fprintf(out, "\tconst struct cloopParameterInfo* parameters;\n");
+		fprintf(out, "\tunsigned parameterCount;\n");
+		fprintf(out, "\tint isConst;\n");
+		fprintf(out, "\tint mayThrow;\n");
+		fprintf(out, "};\n");
+		fprintf(out, "\n");
+		fprintf(out, "#endif\n\n");
+	}
+
+	// Hooks of the tap proxies, called around every method of a tapped object with the interface
+	// index and the slot of the method. A nonzero result of pre skips the call, which then
+	// returns zero; when the method takes the exception interface, fail is then called with it
+	// to report the injected error.
+	fprintf(out, "#ifndef CLOOP_TAP_TYPES\n");
+	fprintf(out, "#define CLOOP_TAP_TYPES\n");
+	fprintf(out, "\n");
+	fprintf(out, "struct cloopTapHooks\n");
+	fprintf(out, "{\n");
+	fprintf(out, "\tint (*pre)(void* context, const void* self, unsigned interfaceIndex, unsigned slot);\n");
+	fprintf(out, "\tvoid (*post)(void* context, const void* self, unsigned interfaceIndex, unsigned slot);\n");
+	fprintf(out, "\tvoid (*fail)(void* context, void* status, unsigned interfaceIndex, unsigned slot);\n");
+	fprintf(out, "\tvoid* context;\n");
+	fprintf(out, "};\n");
+	fprintf(out, "\n");
+	fprintf(out, "#endif\n\n");
+
+	// Length-carrying views of text and data, passed by value.
+	fprintf(out, "#ifndef CLOOP_VIEW_TYPES\n");
+	fprintf(out, "#define CLOOP_VIEW_TYPES\n");
+	fprintf(out, "struct cloopStrView\n");
+	fprintf(out, "{\n");
+	fprintf(out, "\tconst char* data;\n");
+	fprintf(out, "\tuint64_t length;\n");
+	fprintf(out, "};\n");
+	fprintf(out, "\n");
+	fprintf(out, "struct cloopBytes\n");
+	fprintf(out, "{\n");
+	fprintf(out, "\tconst unsigned char* data;\n");
+	fprintf(out, "\tuint64_t length;\n");
+	fprintf(out, "};\n");
+	fprintf(out, "\n");
 	fprintf(out, "#endif\n\n\n");
 
 	for (vector<Interface*>::iterator i = parser->interfaces.begin();
@@ -690,6 +5562,8 @@ void CHeaderGenerator::generate()
 
 	fprintf(out, "\n\n");
 
+	generateStructs(parser);
+
 	for (vector<Interface*>::iterator i = parser->interfaces.begin();
 		 i != parser->interfaces.end();
 		 ++i)
@@ -701,9 +5575,17 @@ void CHeaderGenerator::generate()
 		for (Interface* p = interface; p; p = p->super)
 			methods.insert(methods.begin(), p->methods.begin(), p->methods.end());
 
-		fprintf(out, "#define %s%s_VERSION %d\n\n",
+		fprintf(out, "#define %s%s_VERSION %d\n",
 			prefix.c_str(), interface->name.c_str(), (int) methods.size());
 
+		if (interface->hasIid)
+		{
+			fprintf(out, "#define %s%s_IID 0x%08Xu\n",
+				prefix.c_str(), interface->name.c_str(), interface->iid);
+		}
+
+		fprintf(out, "\n");
+
 		for (vector<Constant*>::iterator j = interface->constants.begin();
 			 j != interface->constants.end();
 			 ++j)
@@ -725,7 +5607,10 @@ void CHeaderGenerator::generate()
 
 		fprintf(out, "struct %s%sVTable\n", prefix.c_str(), interface->name.c_str());
 		fprintf(out, "{\n");
-		fprintf(out, "\tvoid* cloopDummy[%d];\n", DUMMY_VTABLE);
+
+		if (!interface->compact)
+			fprintf(out, "\tvoid* cloopDummy[%d];\n", DUMMY_VTABLE);
+
 		fprintf(out, "\tuintptr_t version;\n");
 
 		for (deque<Method*>::iterator j = methods.begin(); j != methods.end(); ++j)
@@ -756,8 +5641,15 @@ void CHeaderGenerator::generate()
 
 		fprintf(out, "struct %s%s\n", prefix.c_str(), interface->name.c_str());
 		fprintf(out, "{\n");
-		fprintf(out, "\tvoid* cloopDummy[%d];\n", DUMMY_INSTANCE);
+
+		if (!interface->compact)
+			fprintf(out, "\tvoid* cloopDummy[%d];\n", DUMMY_INSTANCE);
+
 		fprintf(out, "\tstruct %s%sVTable* vtable;\n", prefix.c_str(), interface->name.c_str());
+
+		if (interface->errorFlag)
+			fprintf(out, "\tint cloopErrorFlag;\n");
+
 		fprintf(out, "};\n\n");
 
 		for (deque<Method*>::iterator j = methods.begin(); j != methods.end(); ++j)
@@ -787,6 +5679,145 @@ void CHeaderGenerator::generate()
 		}
 
 		fprintf(out, "\n");
+
+		// Proxy replacing the vtable of an object, owned by the caller while installed. The
+		// object must be tapped through its most derived interface, as the slots of derived
+		// interfaces are not copied.
+		fprintf(out, "struct %s%sTap\n", prefix.c_str(), interface->name.c_str());
+		fprintf(out, "{\n");
+		fprintf(out, "\tstruct %s%sVTable vtable;\n", prefix.c_str(), interface->name.c_str());
+		fprintf(out, "\tstruct %s%sVTable* original;\n", prefix.c_str(), interface->name.c_str());
+		fprintf(out, "\tstruct cloopTapHooks hooks;\n");
+		fprintf(out, "};\n\n");
+
+		fprintf(out, "CLOOP_EXTERN_C void %s%sTap_install(struct %s%sTap* tap, struct %s%s* self, "
+			"const struct cloopTapHooks* hooks);\n",
+			prefix.c_str(), interface->name.c_str(),
+			prefix.c_str(), interface->name.c_str(),
+			prefix.c_str(), interface->name.c_str());
+		fprintf(out, "CLOOP_EXTERN_C void %s%sTap_remove(struct %s%sTap* tap, struct %s%s* self);\n",
+			prefix.c_str(), interface->name.c_str(),
+			prefix.c_str(), interface->name.c_str(),
+			prefix.c_str(), interface->name.c_str());
+		fprintf(out, "\n");
+
+		if (!parser->reflection)
+			continue;
+
+		for (vector<Method*>::iterator j = interface->methods.begin();
+			 j != interface->methods.end();
+			 ++j)
+		{
+			Method* method = *j;
+
+			if (method->parameters.empty())
+				continue;
+
+			fprintf(out, "static const struct cloopParameterInfo %s%s_cloop%sParameters[] =\n",
+				prefix.c_str(), interface->name.c_str(), method->name.c_str());
+			fprintf(out, "{\n");
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				fprintf(out, "\t{\"%s\", \"%s\"}%s\n",
+					parameter->name.c_str(),
+					convertType(parameter->typeRef).c_str(),
+					(k + 1 != method->parameters.end() ? "," : ""));
+			}
+
+			fprintf(out, "};\n\n");
+		}
+
+		fprintf(out, "#define %s%s_METHOD_COUNT %u\n\n",
+			prefix.c_str(), interface->name.c_str(), (unsigned) methods.size());
+
+		fprintf(out, "static const struct cloopMethodInfo %s%s_cloopMethods[] =\n",
+			prefix.c_str(), interface->name.c_str());
+		fprintf(out, "{\n");
+
+		for (unsigned slot = 0; slot < methods.size(); ++slot)
+		{
+			Method* method = methods[slot];
+
+			// The parameters table is in the interface declaring the method.
+			Interface* p = interface;
+
+			while (std::find(p->methods.begin(), p->methods.end(), method) == p->methods.end())
+				p = p->super;
+
+			bool mayThrow = !method->parameters.empty() &&
+				parser->exceptionInterface &&
+				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name &&
+				!method->noThrow;
+			string parameters = method->parameters.empty() ? "0" :
+				prefix + p->name + "_cloop" + method->name + "Parameters";
+
+			fprintf(out, "\t{\"%s\", %u, %u, \"%s\", %s, %u, %d, %d}%s\n",
+				method->name.c_str(),
+				slot,
+				method->version,
+				convertType(method->returnTypeRef).c_str(),
+				parameters.c_str(),
+				(unsigned) method->parameters.size(),
+				(int) method->isConst,
+				(int) mayThrow,
+				(slot + 1 != methods.size() ? "," : ""));
+		}
+
+		fprintf(out, "};\n\n");
+	}
+
+	// Header cells of the commands executed by <prefix>Commands_execute, as recorded by the C++
+	// recorders: each is followed by the object, the arguments except the status and, when the
+	// method returns a value, a cell where the result is stored.
+	if (hasCExecutor(parser))
+	{
+		for (vector<Interface*>::iterator i = parser->interfaces.begin();
+			 i != parser->interfaces.end();
+			 ++i)
+		{
+			Interface* interface = *i;
+			unsigned interfaceIndex = i - parser->interfaces.begin();
+			unsigned slot = 0;
+
+			if (!interface->recorder)
+				continue;
+
+			for (Interface* p = interface->super; p; p = p->super)
+				slot += p->methods.size();
+
+			for (vector<Method*>::iterator j = interface->methods.begin();
+				 j != interface->methods.end();
+				 ++j, ++slot)
+			{
+				Method* method = *j;
+
+				if (hasAggregate(method))
+					continue;
+
+				bool hasStatus = !method->parameters.empty() &&
+					parser->exceptionInterface &&
+					method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name;
+				bool hasResult = method->returnTypeRef.token.type != Token::TYPE_VOID ||
+					method->returnTypeRef.isPointer;
+				unsigned size = 2 + method->parameters.size() - (hasStatus ? 1 : 0) + (hasResult ? 1 : 0);
+
+				fprintf(out, "#define %s%s_%s_COMMAND (((uint64_t) %u << 32) | (%uu << 16) | %uu)\n",
+					prefix.c_str(), interface->name.c_str(), method->name.c_str(),
+					size, interfaceIndex, slot);
+			}
+		}
+
+		fprintf(out, "\n");
+		fprintf(out, "CLOOP_EXTERN_C unsigned %sCommands_execute(%s status, uint64_t* cells, unsigned size);\n",
+			prefix.c_str(),
+			(parser->exceptionInterface ?
+				"struct " + prefix + parser->exceptionInterface->name + "*" : string("void*")).c_str());
+		fprintf(out, "\n");
 	}
 
 	fprintf(out, "\n");
@@ -794,83 +5825,349 @@ void CHeaderGenerator::generate()
 }
 
 
-//--------------------------------------
+//--------------------------------------
+
+
+CImplGenerator::CImplGenerator(const string& filename, const string& prefix, Parser* parser,
+		const string& includeFilename, const string& probesProvider)
+	: CBasedGenerator(filename, prefix, false),
+	  parser(parser),
+	  includeFilename(includeFilename),
+	  probesProvider(probesProvider)
+{
+}
+
+void CImplGenerator::generate()
+{
+	fprintf(out, "/* %s */\n\n", AUTOGEN_MSG);
+
+	fprintf(out, "#include \"%s\"\n\n\n", includeFilename.c_str());
+
+	if (!probesProvider.empty())
+	{
+		generateProbeMacro();
+		fprintf(out, "\n");
+	}
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		Interface* interface = *i;
+
+		deque<Method*> methods;
+		deque<Interface*> owners;
+
+		for (Interface* p = interface; p; p = p->super)
+		{
+			methods.insert(methods.begin(), p->methods.begin(), p->methods.end());
+			owners.insert(owners.begin(), p->methods.size(), p);
+		}
+
+		for (deque<Method*>::iterator j = methods.begin(); j != methods.end(); ++j)
+		{
+			Method* method = *j;
+			bool isVoid = method->returnTypeRef.token.type == Token::TYPE_VOID &&
+				!method->returnTypeRef.isPointer;
+
+			// Probes are identified by the interface declaring the method, as in the C++ dispatchers.
+			unsigned slot = j - methods.begin();
+			unsigned interfaceIndex = find(parser->interfaces.begin(), parser->interfaces.end(),
+				owners[slot]) - parser->interfaces.begin();
+
+			fprintf(out, "CLOOP_EXTERN_C %s %s%s_%s(%sstruct %s%s* self",
+				convertType(method->returnTypeRef).c_str(),
+				prefix.c_str(),
+				interface->name.c_str(),
+				method->name.c_str(),
+				(method->isConst ? "const " : ""),
+				prefix.c_str(),
+				interface->name.c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				fprintf(out, ", %s %s",
+					convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+			}
+
+			fprintf(out, ")\n");
+			fprintf(out, "{\n");
+
+			if (!probesProvider.empty())
+			{
+				if (!isVoid)
+					fprintf(out, "\t%s ret;\n\n", convertType(method->returnTypeRef).c_str());
+
+				fprintf(out, "\tCLOOP_PROBE(%s, enter, %u, %u, self);\n",
+					probesProvider.c_str(), interfaceIndex, slot);
+			}
+
+			fprintf(out, "\t");
+
+			//// TODO: checkVersion
+
+			if (!isVoid)
+				fprintf(out, "%s", (probesProvider.empty() ? "return " : "ret = "));
+
+			fprintf(out, "self->vtable->%s(self", method->name.c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+				fprintf(out, ", %s", parameter->name.c_str());
+			}
+
+			fprintf(out, ");\n");
+
+			if (!probesProvider.empty())
+			{
+				fprintf(out, "\tCLOOP_PROBE(%s, exit, %u, %u, self);\n",
+					probesProvider.c_str(), interfaceIndex, slot);
+
+				if (!isVoid)
+					fprintf(out, "\treturn ret;\n");
+			}
+
+			fprintf(out, "}\n\n");
+		}
+
+		// Tap proxy: each slot calls the hooks around the original vtable.
+
+		string tap = prefix + interface->name + "Tap";
+
+		for (deque<Method*>::iterator j = methods.begin(); j != methods.end(); ++j)
+		{
+			Method* method = *j;
+			bool isVoid = method->returnTypeRef.token.type == Token::TYPE_VOID &&
+				!method->returnTypeRef.isPointer;
+			unsigned slot = j - methods.begin();
+			unsigned interfaceIndex = find(parser->interfaces.begin(), parser->interfaces.end(),
+				owners[slot]) - parser->interfaces.begin();
+
+			fprintf(out, "static %s %s_%s(%sstruct %s%s* self",
+				convertType(method->returnTypeRef).c_str(),
+				tap.c_str(),
+				method->name.c_str(),
+				(method->isConst ? "const " : ""),
+				prefix.c_str(),
+				interface->name.c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				fprintf(out, ", %s %s",
+					convertType(parameter->typeRef).c_str(), parameter->name.c_str());
+			}
+
+			fprintf(out, ")\n");
+			fprintf(out, "{\n");
+			fprintf(out, "\tconst struct %s* tap = (const struct %s*) self->vtable;\n",
+				tap.c_str(), tap.c_str());
+
+			if (!isVoid)
+			{
+				fprintf(out, "\t%s ret = %s;\n", convertType(method->returnTypeRef).c_str(),
+					(isAggregate(method->returnTypeRef) ? "{0}" : "0"));
+			}
+
+			fprintf(out, "\n");
+			fprintf(out, "\tif (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, %u, %u))\n",
+				interfaceIndex, slot);
+			fprintf(out, "\t\t%stap->original->%s(self", (isVoid ? "" : "ret = "), method->name.c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+				fprintf(out, ", %s", parameter->name.c_str());
+			}
+
+			fprintf(out, ");\n");
+
+			if (!method->parameters.empty() && parser->exceptionInterface &&
+				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name)
+			{
+				fprintf(out, "\telse if (tap->hooks.fail)\n");
+				fprintf(out, "\t\ttap->hooks.fail(tap->hooks.context, %s, %u, %u);\n",
+					method->parameters.front()->name.c_str(), interfaceIndex, slot);
+			}
+
+			fprintf(out, "\n");
+			fprintf(out, "\tif (tap->hooks.post)\n");
+			fprintf(out, "\t\ttap->hooks.post(tap->hooks.context, self, %u, %u);\n",
+				interfaceIndex, slot);
+
+			if (!isVoid)
+				fprintf(out, "\n\treturn ret;\n");
+
+			fprintf(out, "}\n\n");
+		}
+
+		fprintf(out, "CLOOP_EXTERN_C void %s_install(struct %s* tap, struct %s%s* self, "
+			"const struct cloopTapHooks* hooks)\n",
+			tap.c_str(), tap.c_str(), prefix.c_str(), interface->name.c_str());
+		fprintf(out, "{\n");
+
+		// Only the header is copied, as the original vtable may be from an older version.
+		if (!interface->compact)
+			fprintf(out, "\ttap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];\n");
+
+		// Objects of a newer version have slots the tap doesn't forward.
+		fprintf(out, "\ttap->vtable.version = self->vtable->version < %s%s_VERSION ? "
+			"self->vtable->version : %s%s_VERSION;\n",
+			prefix.c_str(), interface->name.c_str(), prefix.c_str(), interface->name.c_str());
+
+		for (deque<Method*>::iterator j = methods.begin(); j != methods.end(); ++j)
+		{
+			Method* method = *j;
+
+			fprintf(out, "\ttap->vtable.%s = %s_%s;\n",
+				method->name.c_str(), tap.c_str(), method->name.c_str());
+		}
+
+		fprintf(out, "\ttap->original = self->vtable;\n");
+		fprintf(out, "\ttap->hooks = *hooks;\n");
+		fprintf(out, "\tself->vtable = &tap->vtable;\n");
+		fprintf(out, "}\n\n");
 
+		fprintf(out, "CLOOP_EXTERN_C void %s_remove(struct %s* tap, struct %s%s* self)\n",
+			tap.c_str(), tap.c_str(), prefix.c_str(), interface->name.c_str());
+		fprintf(out, "{\n");
+		fprintf(out, "\tself->vtable = tap->original;\n");
+		fprintf(out, "}\n\n");
+	}
 
-CImplGenerator::CImplGenerator(const string& filename, const string& prefix, Parser* parser,
-		const string& includeFilename)
-	: CBasedGenerator(filename, prefix, false),
-	  parser(parser),
-	  includeFilename(includeFilename)
-{
+	if (hasCExecutor(parser))
+		generateExecutor();
 }
 
-void CImplGenerator::generate()
+// Executes the commands recorded by the C++ recorders through the vtables, in one call from
+// the languages where each call to native code is expensive. Stops at the first command that
+// fails, is not known or is not implemented by the object, returning the number of commands
+// successfully executed.
+void CImplGenerator::generateExecutor()
 {
-	fprintf(out, "/* %s */\n\n", AUTOGEN_MSG);
-
-	fprintf(out, "#include \"%s\"\n\n\n", includeFilename.c_str());
+	fprintf(out, "CLOOP_EXTERN_C unsigned %sCommands_execute(%s status, uint64_t* cells, unsigned size)\n",
+		prefix.c_str(),
+		(parser->exceptionInterface ?
+			"struct " + prefix + parser->exceptionInterface->name + "*" : string("void*")).c_str());
+	fprintf(out, "{\n");
+	fprintf(out, "\tunsigned executed = 0;\n");
+	fprintf(out, "\tunsigned position = 0;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tfor (; position < size; ++executed)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tuint64_t* command = cells + position;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tswitch ((unsigned) (command[0] & 0xFFFFFFFF))\n");
+	fprintf(out, "\t\t{\n");
 
 	for (vector<Interface*>::iterator i = parser->interfaces.begin();
 		 i != parser->interfaces.end();
 		 ++i)
 	{
 		Interface* interface = *i;
+		unsigned interfaceIndex = i - parser->interfaces.begin();
+		unsigned slot = 0;
 
-		deque<Method*> methods;
+		if (!interface->recorder)
+			continue;
 
-		for (Interface* p = interface; p; p = p->super)
-			methods.insert(methods.begin(), p->methods.begin(), p->methods.end());
+		for (Interface* p = interface->super; p; p = p->super)
+			slot += p->methods.size();
 
-		for (deque<Method*>::iterator j = methods.begin(); j != methods.end(); ++j)
+		for (vector<Method*>::iterator j = interface->methods.begin();
+			 j != interface->methods.end();
+			 ++j, ++slot)
 		{
 			Method* method = *j;
 
-			fprintf(out, "CLOOP_EXTERN_C %s %s%s_%s(%sstruct %s%s* self",
-				convertType(method->returnTypeRef).c_str(),
-				prefix.c_str(),
-				interface->name.c_str(),
-				method->name.c_str(),
-				(method->isConst ? "const " : ""),
-				prefix.c_str(),
-				interface->name.c_str());
+			if (hasAggregate(method))
+				continue;
 
-			for (vector<Parameter*>::iterator k = method->parameters.begin();
-				 k != method->parameters.end();
-				 ++k)
-			{
-				Parameter* parameter = *k;
+			bool hasStatus = !method->parameters.empty() &&
+				parser->exceptionInterface &&
+				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name;
+			bool hasResult = method->returnTypeRef.token.type != Token::TYPE_VOID ||
+				method->returnTypeRef.isPointer;
+			string type = "struct " + prefix + interface->name + "*";
+			unsigned cell = 2;
 
-				fprintf(out, ", %s %s",
-					convertType(parameter->typeRef).c_str(), parameter->name.c_str());
-			}
+			fprintf(out, "\t\t\tcase (%uu << 16) | %uu:\t/* %s%s_%s */\n",
+				interfaceIndex, slot, prefix.c_str(), interface->name.c_str(), method->name.c_str());
+			fprintf(out, "\t\t\t{\n");
+			fprintf(out, "\t\t\t\t%s object = (%s) (uintptr_t) command[1];\n", type.c_str(), type.c_str());
+			fprintf(out, "\n");
 
-			fprintf(out, ")\n");
-			fprintf(out, "{\n");
-			fprintf(out, "\t");
+			if (method->version - (interface->super ? interface->super->version : 0) != 1)
+			{
+				fprintf(out, "\t\t\t\tif (object->vtable->version < %d)\n", method->version);
+				fprintf(out, "\t\t\t\t\treturn executed;\n");
+				fprintf(out, "\n");
+			}
 
-			//// TODO: checkVersion
+			fprintf(out, "\t\t\t\t");
 
-			if (method->returnTypeRef.token.type != Token::TYPE_VOID ||
-				method->returnTypeRef.isPointer)
+			if (hasResult)
 			{
-				fprintf(out, "return ");
+				fprintf(out, "command[%u] = (uint64_t) %s",
+					(unsigned) (2 + method->parameters.size() - (hasStatus ? 1 : 0)),
+					(isAddressCell(method->returnTypeRef) ? "(uintptr_t) " : ""));
 			}
 
-			fprintf(out, "self->vtable->%s(self", method->name.c_str());
+			fprintf(out, "object->vtable->%s(object", method->name.c_str());
 
 			for (vector<Parameter*>::iterator k = method->parameters.begin();
 				 k != method->parameters.end();
 				 ++k)
 			{
 				Parameter* parameter = *k;
-				fprintf(out, ", %s", parameter->name.c_str());
+
+				if (k == method->parameters.begin() && hasStatus)
+					fprintf(out, ", status");
+				else
+				{
+					fprintf(out, ", (%s) %scommand[%u]",
+						convertType(parameter->typeRef).c_str(),
+						(isAddressCell(parameter->typeRef) ? "(uintptr_t) " : ""),
+						cell++);
+				}
 			}
 
 			fprintf(out, ");\n");
-			fprintf(out, "}\n\n");
+
+			if (hasStatus && !method->noThrow)
+			{
+				fprintf(out, "\n");
+				fprintf(out, "\t\t\t\tif (status->cloopErrorFlag)\n");
+				fprintf(out, "\t\t\t\t\treturn executed;\n");
+			}
+
+			fprintf(out, "\t\t\t\tbreak;\n");
+			fprintf(out, "\t\t\t}\n");
+			fprintf(out, "\n");
 		}
 	}
+
+	fprintf(out, "\t\t\tdefault:\n");
+	fprintf(out, "\t\t\t\treturn executed;\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tposition += (unsigned) (command[0] >> 32);\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\treturn executed;\n");
+	fprintf(out, "}\n");
 }
 
 
@@ -911,6 +6208,16 @@ void PascalGenerator::generate()
 	fprintf(out, "\tQWord = UInt64;\n");
 	fprintf(out, "{$ENDIF}\n\n");
 
+	// Length-carrying views, laid out as cloopStrView and cloopBytes of the C API.
+	fprintf(out, "\tCloopStrView = record\n");
+	fprintf(out, "\t\tdata: PAnsiChar;\n");
+	fprintf(out, "\t\tlength: QWord;\n");
+	fprintf(out, "\tend;\n\n");
+	fprintf(out, "\tCloopBytes = record\n");
+	fprintf(out, "\t\tdata: PByte;\n");
+	fprintf(out, "\t\tlength: QWord;\n");
+	fprintf(out, "\tend;\n\n");
+
 	for (vector<Interface*>::iterator i = parser->interfaces.begin();
 		 i != parser->interfaces.end();
 		 ++i)
@@ -925,6 +6232,12 @@ void PascalGenerator::generate()
 
 	// Pass at every type to fill pointerTypes. We need it in advance.
 
+	for (vector<Struct*>::iterator i = parser->structs.begin(); i != parser->structs.end(); ++i)
+	{
+		for (vector<Field*>::iterator j = (*i)->fields.begin(); j != (*i)->fields.end(); ++j)
+			convertType((*j)->typeRef);
+	}
+
 	for (vector<Interface*>::iterator i = parser->interfaces.begin();
 		 i != parser->interfaces.end();
 		 ++i)
@@ -958,6 +6271,8 @@ void PascalGenerator::generate()
 	if (!pointerTypes.empty())
 		fprintf(out, "\n");
 
+	generateRecords();
+
 	for (vector<Interface*>::iterator i = parser->interfaces.begin();
 		 i != parser->interfaces.end();
 		 ++i)
@@ -976,20 +6291,20 @@ void PascalGenerator::generate()
 			fprintf(out, "\t%s_%sPtr = %s(this: %s",
 				escapeName(interface->name, true).c_str(), escapeName(method->name).c_str(),
 				(isProcedure ? "procedure" : "function"),
-				escapeName(interface->name, true).c_str());
+				(interface->compact ? "Pointer" : escapeName(interface->name, true).c_str()));
 
 			for (vector<Parameter*>::iterator k = method->parameters.begin();
 				 k != method->parameters.end();
 				 ++k)
 			{
 				Parameter* parameter = *k;
-				fprintf(out, "; %s", convertParameter(*parameter).c_str());
+				fprintf(out, "; %s", convertAbiParameter(*parameter).c_str());
 			}
 
 			fprintf(out, ")");
 
 			if (!isProcedure)
-				fprintf(out, ": %s", convertType(method->returnTypeRef).c_str());
+				fprintf(out, ": %s", convertAbiType(method->returnTypeRef).c_str());
 
 			fprintf(out, "; cdecl;\n");
 		}
@@ -1035,6 +6350,9 @@ void PascalGenerator::generate()
 		if (!interface->super)
 			fprintf(out, "\t\tvTable: %sVTable;\n\n", escapeName(interface->name).c_str());
 
+		if (interface->errorFlag && !(interface->super && interface->super->errorFlag))
+			fprintf(out, "\t\tcloopErrorFlag: Integer;\n\n");
+
 		unsigned version = 0;
 
 		for (Interface* p = interface; p; p = p->super)
@@ -1042,6 +6360,9 @@ void PascalGenerator::generate()
 
 		fprintf(out, "\t\tconst VERSION = %d;\n", version);
 
+		if (interface->hasIid)
+			fprintf(out, "\t\tconst IID = Cardinal($%08X);\n", interface->iid);
+
 		for (vector<Constant*>::iterator j = interface->constants.begin();
 			 j != interface->constants.end();
 			 ++j)
@@ -1086,7 +6407,25 @@ void PascalGenerator::generate()
 			if (!isProcedure)
 				fprintf(out, ": %s", convertType(method->returnTypeRef).c_str());
 
-			fprintf(out, ";\n");
+			fprintf(out, ";");
+
+			if (method->scalarMethod)
+			{
+				fprintf(out, " overload;\n");
+				fprintf(out, "\t\tprocedure %s(%s); overload;",
+					escapeName(method->name).c_str(), convertArrayParameters(*method).c_str());
+			}
+			else if (hasArrays(method))
+			{
+				fprintf(out, " overload;\n");
+				fprintf(out, "\t\t%s %s(%s)%s; overload;",
+					(isProcedure ? "procedure" : "function"),
+					escapeName(method->name).c_str(),
+					convertArrayParameters(*method).c_str(),
+					(isProcedure ? "" : (": " + convertType(method->returnTypeRef)).c_str()));
+			}
+
+			fprintf(out, "\n");
 		}
 
 		fprintf(out, "\tend;\n\n");
@@ -1104,12 +6443,251 @@ void PascalGenerator::generate()
 		{
 			Method* method = *j;
 
-			bool isProcedure = method->returnTypeRef.token.type == Token::TYPE_VOID &&
-				 !method->returnTypeRef.isPointer;
+			bool isProcedure = method->returnTypeRef.token.type == Token::TYPE_VOID &&
+				 !method->returnTypeRef.isPointer;
+
+			fprintf(out, "\t\t%s %s(",
+				(isProcedure ? "procedure" : "function"),
+				escapeName(method->name).c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				if (k != method->parameters.begin())
+					fprintf(out, "; ");
+
+				fprintf(out, "%s", convertParameter(*parameter).c_str());
+			}
+
+			fprintf(out, ")");
+
+			if (!isProcedure)
+				fprintf(out, ": %s", convertType(method->returnTypeRef).c_str());
+
+			fprintf(out, "; virtual;%s\n", (method->scalarMethod ? "" : " abstract;"));
+		}
+
+		fprintf(out, "\tend;\n\n");
+	}
+
+	insertFile(functionsFile);
+
+	fprintf(out, "implementation\n\n");
+
+	bool hasCompact = false;
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		if ((*i)->compact)
+			hasCompact = true;
+	}
+
+	// Compact objects are passed by the address of the vTable field, skipping the Pascal VMT,
+	// and compact vtables by the address of their first field.
+	if (hasCompact)
+	{
+		fprintf(out, "function cloopCompactObject(ptr: Pointer): Pointer;\n");
+		fprintf(out, "begin\n");
+		fprintf(out, "\tif (ptr = nil) then\n");
+		fprintf(out, "\t\tResult := nil\n");
+		fprintf(out, "\telse\n");
+		fprintf(out, "\t\tResult := Pointer(NativeInt(ptr) - SizeOf(Pointer));\n");
+		fprintf(out, "end;\n\n");
+
+		fprintf(out, "function cloopCompactPointer(obj: Pointer): Pointer;\n");
+		fprintf(out, "begin\n");
+		fprintf(out, "\tif (obj = nil) then\n");
+		fprintf(out, "\t\tResult := nil\n");
+		fprintf(out, "\telse\n");
+		fprintf(out, "\t\tResult := Pointer(NativeInt(obj) + SizeOf(Pointer));\n");
+		fprintf(out, "end;\n\n");
+	}
+
+	for (vector<Interface*>::iterator i = parser->interfaces.begin();
+		 i != parser->interfaces.end();
+		 ++i)
+	{
+		Interface* interface = *i;
+
+		for (vector<Method*>::iterator j = interface->methods.begin();
+			 j != interface->methods.end();
+			 ++j)
+		{
+			Method* method = *j;
+
+			bool isProcedure = method->returnTypeRef.token.type == Token::TYPE_VOID &&
+				 !method->returnTypeRef.isPointer;
+
+			fprintf(out, "%s %s.%s(",
+				(isProcedure ? "procedure" : "function"),
+				escapeName(interface->name, true).c_str(),
+				escapeName(method->name).c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				if (k != method->parameters.begin())
+					fprintf(out, "; ");
+
+				fprintf(out, "%s", convertParameter(*parameter).c_str());
+			}
+
+			fprintf(out, ")");
+
+			if (!isProcedure)
+				fprintf(out, ": %s", convertType(method->returnTypeRef).c_str());
+
+			fprintf(out, ";\n");
+			fprintf(out, "begin\n");
+			fprintf(out, "\t");
+
+			//// TODO: checkVersion
+
+			string call;
+
+			if (interface->compact)
+			{
+				call = escapeName(interface->name) + "VTable(cloopCompactObject(Pointer(vTable)))." +
+					escapeName(method->name) + "(cloopCompactPointer(Pointer(Self))";
+			}
+			else
+				call = escapeName(interface->name) + "VTable(vTable)." + escapeName(method->name) + "(Self";
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+				call += ", " + convertToAbi(parameter->typeRef, escapeName(parameter->name));
+			}
+
+			call += ")";
+
+			if (!isProcedure)
+				fprintf(out, "Result := %s;\n", convertFromAbi(method->returnTypeRef, call).c_str());
+			else
+				fprintf(out, "%s;\n", call.c_str());
+
+			if (!method->parameters.empty() &&
+				parser->exceptionInterface &&
+				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name &&
+				!exceptionClass.empty() &&
+				!method->noThrow)
+			{
+				if (parser->exceptionInterface->errorFlag)
+				{
+					fprintf(out, "\tif (%s.cloopErrorFlag <> 0) then\n\t",
+						escapeName(method->parameters.front()->name).c_str());
+				}
+
+				fprintf(out, "\t%s.checkException(%s);\n", exceptionClass.c_str(),
+					escapeName(method->parameters.front()->name).c_str());
+			}
+
+			fprintf(out, "end;\n\n");
+
+			if (!method->scalarMethod && hasArrays(method))
+			{
+				// Open array overload, with each count taken from the length of its first array.
+				// Arrays sharing a count must have the same length, or a range error is raised.
+
+				fprintf(out, "%s %s.%s(%s)%s;\n",
+					(isProcedure ? "procedure" : "function"),
+					escapeName(interface->name, true).c_str(),
+					escapeName(method->name).c_str(),
+					convertArrayParameters(*method).c_str(),
+					(isProcedure ? "" : (": " + convertType(method->returnTypeRef)).c_str()));
+				fprintf(out, "begin\n");
+
+				for (vector<Parameter*>::iterator k = method->parameters.begin();
+					 k != method->parameters.end();
+					 ++k)
+				{
+					Parameter* parameter = *k;
+
+					if (!parameter->typeRef.isArray)
+						continue;
+
+					Parameter* count = NULL;
+
+					for (vector<Parameter*>::iterator l = method->parameters.begin(); l != method->parameters.end(); ++l)
+					{
+						if ((*l)->name == parameter->countName)
+							count = *l;
+					}
+
+					Parameter* array = countedArray(method, count);
+
+					if (array != parameter)
+					{
+						fprintf(out, "\tif (Length(%s) <> Length(%s)) then\n",
+							escapeName(parameter->name).c_str(), escapeName(array->name).c_str());
+						fprintf(out, "\t\tRunError(201);\n");
+					}
+				}
+
+				fprintf(out, "\t%s%s(", (isProcedure ? "" : "Result := "), escapeName(method->name).c_str());
+
+				for (vector<Parameter*>::iterator k = method->parameters.begin();
+					 k != method->parameters.end();
+					 ++k)
+				{
+					Parameter* parameter = *k;
+					Parameter* array = countedArray(method, parameter);
+
+					if (k != method->parameters.begin())
+						fprintf(out, ", ");
+
+					if (array)
+						fprintf(out, "Length(%s)", escapeName(array->name).c_str());
+					else if (parameter->typeRef.isArray)
+						fprintf(out, "@%s", escapeName(parameter->name).c_str());
+					else
+						fprintf(out, "%s", escapeName(parameter->name).c_str());
+				}
+
+				fprintf(out, ");\n");
+				fprintf(out, "end;\n\n");
+			}
+
+			if (!method->scalarMethod)
+				continue;
+
+			// Open array overload of the batch method, with the count taken from the arrays, which
+			// must have the same length.
+
+			string countArray = method->parameters[method->parameters.size() - 2]->name;
+
+			fprintf(out, "procedure %s.%s(%s);\n",
+				escapeName(interface->name, true).c_str(),
+				escapeName(method->name).c_str(),
+				convertArrayParameters(*method).c_str());
+			fprintf(out, "begin\n");
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				if (parameter->typeRef.isPointer && parameter->name != countArray)
+				{
+					fprintf(out, "\tif (Length(%s) <> Length(%s)) then\n",
+						escapeName(parameter->name).c_str(), escapeName(countArray).c_str());
+					fprintf(out, "\t\tRunError(201);\n");
+				}
+			}
 
-			fprintf(out, "\t\t%s %s(",
-				(isProcedure ? "procedure" : "function"),
-				escapeName(method->name).c_str());
+			fprintf(out, "\tif (Length(%s) > 0) then\n", escapeName(countArray).c_str());
+			fprintf(out, "\t\t%s(", escapeName(method->name).c_str());
 
 			for (vector<Parameter*>::iterator k = method->parameters.begin();
 				 k != method->parameters.end();
@@ -1118,43 +6696,45 @@ void PascalGenerator::generate()
 				Parameter* parameter = *k;
 
 				if (k != method->parameters.begin())
-					fprintf(out, "; ");
+					fprintf(out, ", ");
 
-				fprintf(out, "%s", convertParameter(*parameter).c_str());
+				if (k + 1 == method->parameters.end())
+					fprintf(out, "Length(%s)", escapeName(countArray).c_str());
+				else if (parameter->typeRef.isPointer)
+					fprintf(out, "@%s[0]", escapeName(parameter->name).c_str());
+				else
+					fprintf(out, "%s", escapeName(parameter->name).c_str());
 			}
 
-			fprintf(out, ")");
-
-			if (!isProcedure)
-				fprintf(out, ": %s", convertType(method->returnTypeRef).c_str());
-
-			fprintf(out, "; virtual; abstract;\n");
+			fprintf(out, ");\n");
+			fprintf(out, "end;\n\n");
 		}
-
-		fprintf(out, "\tend;\n\n");
 	}
 
-	insertFile(functionsFile);
-
-	fprintf(out, "implementation\n\n");
-
+	// Default batch implementations, to be overridden by vectorized ones.
 	for (vector<Interface*>::iterator i = parser->interfaces.begin();
 		 i != parser->interfaces.end();
 		 ++i)
 	{
 		Interface* interface = *i;
 
-		for (vector<Method*>::iterator j = interface->methods.begin();
-			 j != interface->methods.end();
-			 ++j)
+		deque<Method*> methods;
+
+		for (Interface* p = interface; p; p = p->super)
+			methods.insert(methods.begin(), p->methods.begin(), p->methods.end());
+
+		for (deque<Method*>::iterator j = methods.begin(); j != methods.end(); ++j)
 		{
 			Method* method = *j;
+			Method* scalarMethod = method->scalarMethod;
 
-			bool isProcedure = method->returnTypeRef.token.type == Token::TYPE_VOID &&
-				 !method->returnTypeRef.isPointer;
+			if (!scalarMethod)
+				continue;
 
-			fprintf(out, "%s %s.%s(",
-				(isProcedure ? "procedure" : "function"),
+			bool hasResults = scalarMethod->returnTypeRef.token.type != Token::TYPE_VOID ||
+				scalarMethod->returnTypeRef.isPointer;
+
+			fprintf(out, "procedure %sImpl.%s(",
 				escapeName(interface->name, true).c_str(),
 				escapeName(method->name).c_str());
 
@@ -1170,42 +6750,43 @@ void PascalGenerator::generate()
 				fprintf(out, "%s", convertParameter(*parameter).c_str());
 			}
 
-			fprintf(out, ")");
-
-			if (!isProcedure)
-				fprintf(out, ": %s", convertType(method->returnTypeRef).c_str());
-
-			fprintf(out, ";\n");
+			fprintf(out, ");\n");
+			fprintf(out, "var\n");
+			fprintf(out, "\tcloopIndex: Cardinal;\n");
 			fprintf(out, "begin\n");
-			fprintf(out, "\t");
-
-			//// TODO: checkVersion
-
-			if (!isProcedure)
-				fprintf(out, "Result := ");
-
-			fprintf(out, "%sVTable(vTable).%s(Self",
-				escapeName(interface->name).c_str(), escapeName(method->name).c_str());
+			fprintf(out, "\tcloopIndex := 0;\n\n");
+			fprintf(out, "\twhile (cloopIndex < count) do\n");
+			fprintf(out, "\tbegin\n");
+			fprintf(out, "\t\t%s%s(", (hasResults ? "results^ := " : ""),
+				escapeName(scalarMethod->name).c_str());
 
 			for (vector<Parameter*>::iterator k = method->parameters.begin();
-				 k != method->parameters.end();
+				 k != method->parameters.begin() + scalarMethod->parameters.size();
 				 ++k)
 			{
 				Parameter* parameter = *k;
-				fprintf(out, ", %s", escapeName(parameter->name).c_str());
+
+				if (k != method->parameters.begin())
+					fprintf(out, ", ");
+
+				fprintf(out, "%s%s", escapeName(parameter->name).c_str(),
+					(parameter->typeRef.isPointer ? "^" : ""));
 			}
 
 			fprintf(out, ");\n");
 
-			if (!method->parameters.empty() &&
-				parser->exceptionInterface &&
-				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name &&
-				!exceptionClass.empty())
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
 			{
-				fprintf(out, "\t%s.checkException(%s);\n", exceptionClass.c_str(),
-					escapeName(method->parameters.front()->name).c_str());
+				Parameter* parameter = *k;
+
+				if (parameter->typeRef.isPointer)
+					fprintf(out, "\t\tInc(%s);\n", escapeName(parameter->name).c_str());
 			}
 
+			fprintf(out, "\t\tInc(cloopIndex);\n");
+			fprintf(out, "\tend;\n");
 			fprintf(out, "end;\n\n");
 		}
 	}
@@ -1232,7 +6813,7 @@ void PascalGenerator::generate()
 				(isProcedure ? "procedure" : "function"),
 				escapeName(interface->name, true).c_str(),
 				escapeName(method->name).c_str(),
-				escapeName(interface->name, true).c_str());
+				(interface->compact ? "Pointer" : escapeName(interface->name, true).c_str()));
 
 			for (vector<Parameter*>::iterator k = method->parameters.begin();
 				 k != method->parameters.end();
@@ -1240,27 +6821,25 @@ void PascalGenerator::generate()
 			{
 				Parameter* parameter = *k;
 
-				fprintf(out, "; %s", convertParameter(*parameter).c_str());
+				fprintf(out, "; %s", convertAbiParameter(*parameter).c_str());
 			}
 
 			fprintf(out, ")");
 
 			if (!isProcedure)
-				fprintf(out, ": %s", convertType(method->returnTypeRef).c_str());
+				fprintf(out, ": %s", convertAbiType(method->returnTypeRef).c_str());
 
 			fprintf(out, "; cdecl;\n");
 			fprintf(out, "begin\n");
 
-			if (!exceptionClass.empty())
+			if (!exceptionClass.empty() && !method->noThrow)
 				fprintf(out, "\ttry\n\t");
 
 			fprintf(out, "\t");
 
-			if (!isProcedure)
-				fprintf(out, "Result := ");
-
-			fprintf(out, "%sImpl(this).%s(", escapeName(interface->name, true).c_str(),
-				escapeName(method->name).c_str());
+			string call = escapeName(interface->name, true) + "Impl(" +
+				(interface->compact ? "cloopCompactObject(this)" : "this") + ")." +
+				escapeName(method->name) + "(";
 
 			for (vector<Parameter*>::iterator k = method->parameters.begin();
 				 k != method->parameters.end();
@@ -1269,14 +6848,19 @@ void PascalGenerator::generate()
 				Parameter* parameter = *k;
 
 				if (k != method->parameters.begin())
-					fprintf(out, ", ");
+					call += ", ";
 
-				fprintf(out, "%s", escapeName(parameter->name).c_str());
+				call += convertFromAbi(parameter->typeRef, escapeName(parameter->name));
 			}
 
-			fprintf(out, ");\n");
+			call += ")";
+
+			if (!isProcedure)
+				fprintf(out, "Result := %s;\n", convertToAbi(method->returnTypeRef, call).c_str());
+			else
+				fprintf(out, "%s;\n", call.c_str());
 
-			if (!exceptionClass.empty())
+			if (!exceptionClass.empty() && !method->noThrow)
 			{
 				Parameter* exceptionParameter =
 					(!method->parameters.empty() &&
@@ -1301,7 +6885,13 @@ void PascalGenerator::generate()
 
 		fprintf(out, "constructor %sImpl.create;\n", escapeName(interface->name, true).c_str());
 		fprintf(out, "begin\n");
-		fprintf(out, "\tvTable := %sImpl_vTable;\n", escapeName(interface->name, true).c_str());
+		if (interface->compact)
+		{
+			fprintf(out, "\tvTable := %sVTable(cloopCompactPointer(Pointer(%sImpl_vTable)));\n",
+				escapeName(interface->name).c_str(), escapeName(interface->name, true).c_str());
+		}
+		else
+			fprintf(out, "\tvTable := %sImpl_vTable;\n", escapeName(interface->name, true).c_str());
 		fprintf(out, "end;\n\n");
 	}
 
@@ -1353,11 +6943,162 @@ void PascalGenerator::generate()
 	fprintf(out, "end.\n");
 }
 
+// Structs with a body, laid out as in C. Pascal has no alignment attribute for records, so an
+// aligned record overlaps its fields with a variant of the size of its alignment.
+void PascalGenerator::generateRecords()
+{
+	bool hasStructs = false;
+
+	for (vector<Struct*>::iterator i = parser->structs.begin(); i != parser->structs.end(); ++i)
+	{
+		if ((*i)->defined)
+			hasStructs = true;
+	}
+
+	if (!hasStructs)
+		return;
+
+	fprintf(out, "{$IFDEF FPC}\n{$PACKRECORDS C}\n{$ENDIF}\n\n");
+
+	for (vector<Struct*>::iterator i = parser->structs.begin(); i != parser->structs.end(); ++i)
+	{
+		Struct* ztruct = *i;
+
+		if (!ztruct->defined)
+			continue;
+
+		const char* alignmentType = NULL;
+
+		switch (ztruct->alignment)
+		{
+			case 0:
+				break;
+
+			case 1:
+				alignmentType = "Byte";
+				break;
+
+			case 2:
+				alignmentType = "Word";
+				break;
+
+			case 4:
+				alignmentType = "Cardinal";
+				break;
+
+			case 8:
+				alignmentType = "Int64";
+				break;
+
+			default:
+				throw runtime_error(string("Struct '") + ztruct->name +
+					"' cannot be aligned to more than 8 bytes in Pascal.");
+		}
+
+		fprintf(out, "\t%s = %srecord\n", escapeName(ztruct->name).c_str(),
+			(ztruct->packed ? "packed " : ""));
+
+		if (alignmentType)
+		{
+			fprintf(out, "\t\tcase Integer of\n");
+			fprintf(out, "\t\t\t0: (\n");
+		}
+
+		for (vector<Field*>::iterator j = ztruct->fields.begin(); j != ztruct->fields.end(); ++j)
+		{
+			Field* field = *j;
+
+			fprintf(out, "%s%s: %s%s\n", (alignmentType ? "\t\t\t\t" : "\t\t"),
+				escapeName(field->name).c_str(), convertType(field->typeRef).c_str(),
+				(alignmentType && j + 1 == ztruct->fields.end() ? "" : ";"));
+		}
+
+		if (alignmentType)
+		{
+			fprintf(out, "\t\t\t);\n");
+			fprintf(out, "\t\t\t1: (cloopAlignment: %s);\n", alignmentType);
+		}
+
+		fprintf(out, "\tend;\n\n");
+	}
+
+	fprintf(out, "{$IFDEF FPC}\n{$PACKRECORDS DEFAULT}\n{$ENDIF}\n\n");
+}
+
 string PascalGenerator::convertParameter(const Parameter& parameter)
 {
 	return escapeName(parameter.name) + ": " + convertType(parameter.typeRef);
 }
 
+// Parameters of the open array overload of a [batch] method or of a method with arrays, without
+// the counts.
+string PascalGenerator::convertArrayParameters(const Method& method)
+{
+	string ret;
+
+	for (vector<Parameter*>::const_iterator i = method.parameters.begin();
+		 i != method.parameters.end();
+		 ++i)
+	{
+		Parameter* parameter = *i;
+		TypeRef typeRef = parameter->typeRef;
+
+		if (method.scalarMethod ? i + 1 == method.parameters.end() : countedArray(&method, parameter) != NULL)
+			continue;
+
+		if (!ret.empty())
+			ret += "; ";
+
+		if (!(method.scalarMethod ? typeRef.isPointer : typeRef.isArray))
+		{
+			ret += convertParameter(*parameter);
+			continue;
+		}
+
+		typeRef.isPointer = false;
+		typeRef.isArray = false;
+
+		ret += string(parameter->direction == Parameter::DIRECTION_IN ? "const " :
+			parameter->direction == Parameter::DIRECTION_OUT ? "out " : "var ") + escapeName(parameter->name) +
+			": array of " + convertType(typeRef);
+	}
+
+	return ret;
+}
+
+string PascalGenerator::convertAbiParameter(const Parameter& parameter)
+{
+	return escapeName(parameter.name) + ": " + convertAbiType(parameter.typeRef);
+}
+
+string PascalGenerator::convertAbiType(const TypeRef& typeRef)
+{
+	return isCompact(typeRef) ? "Pointer" : convertType(typeRef);
+}
+
+string PascalGenerator::convertToAbi(const TypeRef& typeRef, const string& expr)
+{
+	return isCompact(typeRef) ? "cloopCompactPointer(Pointer(" + expr + "))" : expr;
+}
+
+string PascalGenerator::convertFromAbi(const TypeRef& typeRef, const string& expr)
+{
+	return isCompact(typeRef) ? convertType(typeRef) + "(cloopCompactObject(" + expr + "))" : expr;
+}
+
+bool PascalGenerator::isCompact(const TypeRef& typeRef)
+{
+	if (typeRef.type != BaseType::TYPE_INTERFACE || typeRef.token.type != Token::TYPE_IDENTIFIER ||
+		typeRef.isPointer)
+	{
+		return false;
+	}
+
+	map<string, BaseType*>::iterator it = parser->typesByName.find(typeRef.token.text);
+
+	return it != parser->typesByName.end() && static_cast<Interface*>(it->second)->compact;
+}
+
 string PascalGenerator::convertType(const TypeRef& typeRef)
 {
 	string name;
@@ -1384,6 +7125,14 @@ string PascalGenerator::convertType(const TypeRef& typeRef)
 			name = "PAnsiChar";
 			break;
 
+		case Token::TYPE_STRVIEW:
+			name = "CloopStrView";
+			break;
+
+		case Token::TYPE_BYTES:
+			name = "CloopBytes";
+			break;
+
 		case Token::TYPE_UCHAR:
 			name = "Byte";
 			break;
@@ -1425,6 +7174,8 @@ string PascalGenerator::escapeName(string name, bool interfaceName)
 
 	if (name == "file" ||
 		name == "function" ||
+		name == "in" ||
+		name == "out" ||
 		name == "procedure" ||
 		name == "set" ||
 		name == "to" ||
@@ -1462,6 +7213,19 @@ void PascalGenerator::insertFile(const string& filename)
 //--------------------------------------
 
 
+// Pointer accessor of the Java arrays of a [batch] method, copied around its callback.
+static string batchArrayAccessor(const string& type)
+{
+	if (type == "byte[]")
+		return "Byte";
+	else if (type == "int[]")
+		return "Int";
+	else if (type == "long[]")
+		return "Long";
+	else
+		return "";
+}
+
 JnaGenerator::JnaGenerator(const string& filename, const string& prefix, Parser* parser,
 		const string& className, const string& exceptionClass)
 	: FileGenerator(filename, prefix),
@@ -1478,20 +7242,201 @@ void JnaGenerator::generate()
 	string::size_type lastDot = className.rfind('.');
 	string::size_type classStart;
 
-	if (lastDot != string::npos)
-	{
-		fprintf(out, "package %s;\n", className.substr(0, lastDot).c_str());
-		fprintf(out, "\n");
+	if (lastDot != string::npos)
+	{
+		fprintf(out, "package %s;\n", className.substr(0, lastDot).c_str());
+		fprintf(out, "\n");
+		fprintf(out, "\n");
+
+		classStart = lastDot + 1;
+	}
+	else
+		classStart = 0;
+
+	fprintf(out, "public interface %s extends com.sun.jna.Library\n",
+		className.substr(classStart).c_str());
+	fprintf(out, "{\n");
+
+	fprintf(out, "\t// Length-carrying views, laid out as cloopStrView and cloopBytes of the C API. Made over\n");
+	fprintf(out, "\t// direct buffers, their contents are passed without copies.\n");
+	fprintf(out, "\tpublic static class CloopStrView extends com.sun.jna.Structure implements com.sun.jna.Structure.ByValue\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tpublic com.sun.jna.Pointer data;\n");
+	fprintf(out, "\t\tpublic long length;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tpublic CloopStrView()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tpublic CloopStrView(java.nio.ByteBuffer buffer)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tdata = com.sun.jna.Native.getDirectBufferPointer(buffer).share(buffer.position());\n");
+	fprintf(out, "\t\t\tlength = buffer.remaining();\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tpublic java.nio.ByteBuffer getByteBuffer()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn data == null ? null : data.getByteBuffer(0, length);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tpublic String getString()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn data == null ? null :\n");
+	fprintf(out, "\t\t\t\tnew String(data.getByteArray(0, (int) length), java.nio.charset.StandardCharsets.UTF_8);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t@Override\n");
+	fprintf(out, "\t\tprotected java.util.List<String> getFieldOrder()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn java.util.Arrays.asList(\"data\", \"length\");\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tpublic static class CloopBytes extends com.sun.jna.Structure implements com.sun.jna.Structure.ByValue\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tpublic com.sun.jna.Pointer data;\n");
+	fprintf(out, "\t\tpublic long length;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tpublic CloopBytes()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tpublic CloopBytes(java.nio.ByteBuffer buffer)\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\tdata = com.sun.jna.Native.getDirectBufferPointer(buffer).share(buffer.position());\n");
+	fprintf(out, "\t\t\tlength = buffer.remaining();\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tpublic java.nio.ByteBuffer getByteBuffer()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn data == null ? null : data.getByteBuffer(0, length);\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\t@Override\n");
+	fprintf(out, "\t\tprotected java.util.List<String> getFieldOrder()\n");
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\treturn java.util.Arrays.asList(\"data\", \"length\");\n");
+	fprintf(out, "\t\t}\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// Arrays are passed in buffers, from their position. Direct ones are read and written by native\n");
+	fprintf(out, "\t// code without copies; heap ones are copied through native memory, only in the directions the\n");
+	fprintf(out, "\t// array is passed.\n");
+	fprintf(out, "\tpublic static com.sun.jna.Pointer cloopArrayPointer(java.nio.Buffer buffer, int elementSize, boolean copyIn)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tif (buffer == null)\n");
+	fprintf(out, "\t\t\treturn null;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tif (buffer.isDirect())\n");
+	fprintf(out, "\t\t\treturn com.sun.jna.Native.getDirectBufferPointer(buffer).share((long) buffer.position() * elementSize);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tcom.sun.jna.Memory memory = new com.sun.jna.Memory(Math.max((long) buffer.remaining() * elementSize, 1));\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tif (copyIn)\n");
+	fprintf(out, "\t\t\tcloopArrayCopy(buffer, cloopArrayView(memory, buffer.remaining(), elementSize, false));\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\treturn memory;\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\tpublic static void cloopArrayCopyBack(com.sun.jna.Pointer pointer, java.nio.Buffer buffer, int elementSize)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tif (buffer != null && !buffer.isDirect())\n");
+	fprintf(out, "\t\t\tcloopArrayCopy(cloopArrayView(pointer, buffer.remaining(), elementSize, true), buffer);\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// Buffer over a native array, read-only for the arrays the callee only reads.\n");
+	fprintf(out, "\tpublic static java.nio.Buffer cloopArrayView(com.sun.jna.Pointer pointer, long count, int elementSize,\n");
+	fprintf(out, "\t\tboolean readOnly)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tif (pointer == null)\n");
+	fprintf(out, "\t\t\treturn null;\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tjava.nio.ByteBuffer bytes = pointer.getByteBuffer(0, count * elementSize);\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tif (readOnly)\n");
+	fprintf(out, "\t\t\tbytes = bytes.asReadOnlyBuffer();\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\tbytes.order(java.nio.ByteOrder.nativeOrder());\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t\treturn elementSize == 4 ? bytes.asIntBuffer() : elementSize == 8 ? bytes.asLongBuffer() : bytes;\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+	fprintf(out, "\t// Copies the remaining elements of a buffer to another, keeping their positions.\n");
+	fprintf(out, "\tpublic static void cloopArrayCopy(java.nio.Buffer source, java.nio.Buffer target)\n");
+	fprintf(out, "\t{\n");
+	fprintf(out, "\t\tif (target instanceof java.nio.IntBuffer)\n");
+	fprintf(out, "\t\t\t((java.nio.IntBuffer) target).duplicate().put(((java.nio.IntBuffer) source).duplicate());\n");
+	fprintf(out, "\t\telse if (target instanceof java.nio.LongBuffer)\n");
+	fprintf(out, "\t\t\t((java.nio.LongBuffer) target).duplicate().put(((java.nio.LongBuffer) source).duplicate());\n");
+	fprintf(out, "\t\telse\n");
+	fprintf(out, "\t\t\t((java.nio.ByteBuffer) target).duplicate().put(((java.nio.ByteBuffer) source).duplicate());\n");
+	fprintf(out, "\t}\n");
+	fprintf(out, "\n");
+
+	// Structs with a body. The alignment of a structure is the largest of its fields, so an
+	// aligned one raises the alignment of its first field.
+	for (vector<Struct*>::iterator i = parser->structs.begin(); i != parser->structs.end(); ++i)
+	{
+		Struct* ztruct = *i;
+
+		if (!ztruct->defined)
+			continue;
+
+		string name = escapeName(ztruct->name);
+
+		fprintf(out, "\tpublic static class %s extends com.sun.jna.Structure\n", name.c_str());
+		fprintf(out, "\t{\n");
+		fprintf(out, "\t\tpublic static class ByValue extends %s implements com.sun.jna.Structure.ByValue\n",
+			name.c_str());
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+
+		for (vector<Field*>::iterator j = ztruct->fields.begin(); j != ztruct->fields.end(); ++j)
+		{
+			Field* field = *j;
+			fprintf(out, "\t\tpublic %s %s;\n",
+				convertFieldType(field->typeRef).c_str(), escapeName(field->name).c_str());
+		}
+
+		fprintf(out, "\n");
+		fprintf(out, "\t\tpublic %s()\n", name.c_str());
+		fprintf(out, "\t\t{\n");
+
+		if (ztruct->packed)
+			fprintf(out, "\t\t\tsuper(ALIGN_NONE);\n");
+
+		fprintf(out, "\t\t}\n");
+		fprintf(out, "\n");
+		fprintf(out, "\t\t@Override\n");
+		fprintf(out, "\t\tprotected java.util.List<String> getFieldOrder()\n");
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\treturn java.util.Arrays.asList(");
+
+		for (vector<Field*>::iterator j = ztruct->fields.begin(); j != ztruct->fields.end(); ++j)
+		{
+			fprintf(out, "%s\"%s\"", (j == ztruct->fields.begin() ? "" : ", "),
+				escapeName((*j)->name).c_str());
+		}
+
+		fprintf(out, ");\n");
+		fprintf(out, "\t\t}\n");
+
+		if (ztruct->alignment)
+		{
+			fprintf(out, "\n");
+			fprintf(out, "\t\t@Override\n");
+			fprintf(out, "\t\tprotected int getNativeAlignment(Class<?> type, Object value, boolean isFirstElement)\n");
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\tint alignment = super.getNativeAlignment(type, value, isFirstElement);\n");
+			fprintf(out, "\t\t\treturn isFirstElement ? Math.max(alignment, %u) : alignment;\n",
+				ztruct->alignment);
+			fprintf(out, "\t\t}\n");
+		}
+
+		fprintf(out, "\t}\n");
 		fprintf(out, "\n");
-
-		classStart = lastDot + 1;
 	}
-	else
-		classStart = 0;
-
-	fprintf(out, "public interface %s extends com.sun.jna.Library\n",
-		className.substr(classStart).c_str());
-	fprintf(out, "{\n");
 
 	for (vector<Interface*>::iterator i = parser->interfaces.begin();
 		 i != parser->interfaces.end();
@@ -1516,6 +7461,9 @@ void JnaGenerator::generate()
 
 		//// TODO: version
 
+		if (interface->hasIid)
+			fprintf(out, "\t\tpublic static int IID = 0x%08X;\n\n", interface->iid);
+
 		for (vector<Constant*>::iterator j = interface->constants.begin();
 			 j != interface->constants.end();
 			 ++j)
@@ -1538,7 +7486,8 @@ void JnaGenerator::generate()
 		{
 			Method* method = *j;
 
-			fprintf(out, "\t\tpublic %s %s(",
+			fprintf(out, "\t\tpublic %s%s %s(",
+				(method->scalarMethod ? "default " : ""),
 				convertType(method->returnTypeRef, true).c_str(),
 				escapeName(method->name).c_str());
 
@@ -1559,14 +7508,48 @@ void JnaGenerator::generate()
 			bool mayThrow = !method->parameters.empty() &&
 				parser->exceptionInterface &&
 				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name &&
-				!exceptionClass.empty();
+				!exceptionClass.empty() &&
+				!method->noThrow;
 
 			fprintf(out, ")");
 
 			if (mayThrow)
 				fprintf(out, " throws %s", exceptionClass.c_str());
 
-			fprintf(out, ";\n");
+			Method* scalarMethod = method->scalarMethod;
+
+			if (!scalarMethod)
+			{
+				fprintf(out, ";\n");
+				continue;
+			}
+
+			// Default batch implementation, to be overridden by vectorized ones.
+
+			bool hasResults = scalarMethod->returnTypeRef.token.type != Token::TYPE_VOID ||
+				scalarMethod->returnTypeRef.isPointer;
+
+			fprintf(out, "\n");
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\tfor (int cloopIndex = 0; cloopIndex < count; ++cloopIndex)\n");
+			fprintf(out, "\t\t\t\t%s%s(", (hasResults ? "results[cloopIndex] = " : ""),
+				escapeName(scalarMethod->name).c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.begin() + scalarMethod->parameters.size();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				if (k != method->parameters.begin())
+					fprintf(out, ", ");
+
+				fprintf(out, "%s%s", escapeName(parameter->name).c_str(),
+					(parameter->typeRef.isPointer ? "[cloopIndex]" : ""));
+			}
+
+			fprintf(out, ");\n");
+			fprintf(out, "\t\t}\n");
 		}
 
 		fprintf(out, "\t}\n");
@@ -1621,7 +7604,7 @@ void JnaGenerator::generate()
 				Parameter* parameter = *k;
 
 				fprintf(out, ", %s %s",
-					convertType(parameter->typeRef, false).c_str(),
+					convertCallbackType(method, parameter->typeRef).c_str(),
 					escapeName(parameter->name).c_str());
 			}
 
@@ -1632,7 +7615,9 @@ void JnaGenerator::generate()
 
 		if (!interface->super)
 		{
-			fprintf(out, "\t\t\tpublic com.sun.jna.Pointer cloopDummy;\n");
+			if (!interface->compact)
+				fprintf(out, "\t\t\tpublic com.sun.jna.Pointer cloopDummy;\n");
+
 			fprintf(out, "\t\t\tpublic com.sun.jna.Pointer version;\n");
 			fprintf(out, "\n");
 		}
@@ -1674,7 +7659,7 @@ void JnaGenerator::generate()
 				Parameter* parameter = *k;
 
 				fprintf(out, ", %s %s",
-					convertType(parameter->typeRef, false).c_str(),
+					convertCallbackType(method, parameter->typeRef).c_str(),
 					escapeName(parameter->name).c_str());
 			}
 
@@ -1682,13 +7667,49 @@ void JnaGenerator::generate()
 
 			if (!method->parameters.empty() &&
 				parser->exceptionInterface &&
-				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name)
+				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name &&
+				!method->noThrow)
 			{
 				statusName = method->parameters.front()->name;
 			}
 
 			fprintf(out, ")\n");
 			fprintf(out, "\t\t\t\t\t{\n");
+
+			// Arrays of batch methods are copied from native memory, and the results back to it.
+			// Empty batches may come with null pointers.
+			string batchCount = method->scalarMethod ? escapeName(method->parameters.back()->name) : "";
+			vector<string> batchResults;
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+				string type = convertType(parameter->typeRef, false);
+				string accessor = batchArrayAccessor(type);
+				string name = escapeName(parameter->name);
+
+				if (!method->scalarMethod || accessor.empty())
+					continue;
+
+				if (parameter->typeRef.isConst)
+				{
+					fprintf(out, "\t\t\t\t\t\t%s %sArray = %s == null ? new %s[0] : %s.get%sArray(0, %s);\n",
+						type.c_str(), name.c_str(), name.c_str(), type.substr(0, type.length() - 2).c_str(),
+						name.c_str(), accessor.c_str(), batchCount.c_str());
+				}
+				else
+				{
+					fprintf(out, "\t\t\t\t\t\t%s %sArray = new %s[%s];\n",
+						type.c_str(), name.c_str(), type.substr(0, type.length() - 2).c_str(), batchCount.c_str());
+					batchResults.push_back(name);
+				}
+			}
+
+			if (!batchCount.empty())
+				fprintf(out, "\n");
+
 			fprintf(out, "\t\t\t\t\t\t");
 
 			if (!statusName.empty())
@@ -1711,15 +7732,45 @@ void JnaGenerator::generate()
 				 ++k)
 			{
 				Parameter* parameter = *k;
+				string name = escapeName(parameter->name);
 
 				if (k != method->parameters.begin())
 					fprintf(out, ", ");
 
-				fprintf(out, "%s", escapeName(parameter->name).c_str());
+				if (!parameter->typeRef.isArray)
+				{
+					bool copied = method->scalarMethod &&
+						!batchArrayAccessor(convertType(parameter->typeRef, false)).empty();
+
+					fprintf(out, "%s%s", name.c_str(), (copied ? "Array" : ""));
+					continue;
+				}
+
+				// Buffer over the native array, without copies.
+
+				const Parameter* count = findParameter(method, parameter->countName);
+				string length = escapeName(count->name);
+
+				if (count->typeRef.token.type == Token::TYPE_UINT)
+					length = "Integer.toUnsignedLong(" + length + ")";
+
+				fprintf(out, "(%s) cloopArrayView(%s, %s, %u, %s)",
+					convertType(parameter->typeRef, false).c_str(), name.c_str(), length.c_str(),
+					elementSize(parameter->typeRef),
+					(parameter->direction == Parameter::DIRECTION_IN ? "true" : "false"));
 			}
 
 			fprintf(out, ");\n");
 
+			for (vector<string>::iterator k = batchResults.begin(); k != batchResults.end(); ++k)
+			{
+				const char* indent = statusName.empty() ? "" : "\t";
+
+				fprintf(out, "\t\t\t\t\t\t%sif (%s != null)\n", indent, k->c_str());
+				fprintf(out, "\t\t\t\t\t\t\t%s%s.write(0, %sArray, 0, %s);\n",
+					indent, k->c_str(), k->c_str(), batchCount.c_str());
+			}
+
 			if (!statusName.empty())
 			{
 				fprintf(out, "\t\t\t\t\t\t}\n");
@@ -1781,7 +7832,7 @@ void JnaGenerator::generate()
 			fprintf(out, "\t\t\t\tfields.addAll(java.util.Arrays.asList(");
 
 			if (!interface->super)
-				fprintf(out, "\"cloopDummy\", \"version\"");
+				fprintf(out, "%s\"version\"", (interface->compact ? "" : "\"cloopDummy\", "));
 
 			bool first = interface->super != NULL;
 
@@ -1809,15 +7860,24 @@ void JnaGenerator::generate()
 		if (!interface->super)
 		{
 			fprintf(out, "\n");
-			fprintf(out, "\t\tpublic com.sun.jna.Pointer cloopDummy;\n");
+
+			if (!interface->compact)
+				fprintf(out, "\t\tpublic com.sun.jna.Pointer cloopDummy;\n");
+
 			fprintf(out, "\t\tpublic com.sun.jna.Pointer cloopVTable;\n");
+
+			if (interface->errorFlag)
+				fprintf(out, "\t\tpublic int cloopErrorFlag;\n");
+
 			fprintf(out, "\t\tprotected volatile VTable vTable;\n");
 			fprintf(out, "\n");
 			fprintf(out, "\t\t@Override\n");
 			fprintf(out, "\t\tprotected java.util.List<String> getFieldOrder()\n");
 			fprintf(out, "\t\t{\n");
 			fprintf(out, "\t\t\tjava.util.List<String> fields = new java.util.ArrayList<String>();\n");
-			fprintf(out, "\t\t\tfields.addAll(java.util.Arrays.asList(\"cloopDummy\", \"cloopVTable\"));\n");
+			fprintf(out, "\t\t\tfields.addAll(java.util.Arrays.asList(%s\"cloopVTable\"%s));\n",
+				(interface->compact ? "" : "\"cloopDummy\", "),
+				(interface->errorFlag ? ", \"cloopErrorFlag\"" : ""));
 			fprintf(out, "\t\t\treturn fields;\n");
 			fprintf(out, "\t\t}\n");
 			fprintf(out, "\n");
@@ -1839,6 +7899,30 @@ void JnaGenerator::generate()
 			fprintf(out, "\t\t\treturn (T) vTable;\n");
 			fprintf(out, "\t\t}\n");
 		}
+		else if (interface->errorFlag && !interface->super->errorFlag)
+		{
+			fprintf(out, "\n");
+			fprintf(out, "\t\tpublic int cloopErrorFlag;\n");
+			fprintf(out, "\n");
+			fprintf(out, "\t\t@Override\n");
+			fprintf(out, "\t\tprotected java.util.List<String> getFieldOrder()\n");
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\tjava.util.List<String> fields = super.getFieldOrder();\n");
+			fprintf(out, "\t\t\tfields.add(\"cloopErrorFlag\");\n");
+			fprintf(out, "\t\t\treturn fields;\n");
+			fprintf(out, "\t\t}\n");
+		}
+
+		// Java implementations must keep the error word in the native memory in sync.
+		if (interface->errorFlag && !(interface->super && interface->super->errorFlag))
+		{
+			fprintf(out, "\n");
+			fprintf(out, "\t\tpublic final void cloopSetErrorFlag(boolean error)\n");
+			fprintf(out, "\t\t{\n");
+			fprintf(out, "\t\t\tcloopErrorFlag = error ? 1 : 0;\n");
+			fprintf(out, "\t\t\twriteField(\"cloopErrorFlag\");\n");
+			fprintf(out, "\t\t}\n");
+		}
 
 		fprintf(out, "\n");
 
@@ -1894,7 +7978,8 @@ void JnaGenerator::generate()
 			bool mayThrow = !method->parameters.empty() &&
 				parser->exceptionInterface &&
 				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name &&
-				!exceptionClass.empty();
+				!exceptionClass.empty() &&
+				!method->noThrow;
 
 			fprintf(out, ")");
 
@@ -1905,6 +7990,35 @@ void JnaGenerator::generate()
 			fprintf(out, "\t\t{\n");
 			fprintf(out, "\t\t\tVTable vTable = getVTable();\n");
 
+			// Arrays not written by the callee aren't copied back, and the ones not read aren't
+			// copied in. Arrays of batch methods are passed as buffers of their first elements.
+			string batchCount = method->scalarMethod ? escapeName(method->parameters.back()->name) : "";
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+				string accessor = method->scalarMethod ?
+					batchArrayAccessor(convertType(parameter->typeRef, false)) : "";
+
+				if (parameter->typeRef.isArray)
+				{
+					fprintf(out, "\t\t\tcom.sun.jna.Pointer %sPointer = cloopArrayPointer(%s, %u, %s);\n",
+						parameter->name.c_str(), escapeName(parameter->name).c_str(),
+						elementSize(parameter->typeRef),
+						(parameter->direction == Parameter::DIRECTION_OUT ? "false" : "true"));
+				}
+				else if (!accessor.empty())
+				{
+					fprintf(out, "\t\t\tcom.sun.jna.Pointer %sPointer = "
+						"cloopArrayPointer(java.nio.%sBuffer.wrap(%s, 0, %s), %u, %s);\n",
+						parameter->name.c_str(), accessor.c_str(), escapeName(parameter->name).c_str(),
+						batchCount.c_str(), elementSize(parameter->typeRef),
+						(parameter->typeRef.isConst ? "true" : "false"));
+				}
+			}
+
 			fprintf(out, "\t\t\t");
 
 			if (method->returnTypeRef.token.type != Token::TYPE_VOID ||
@@ -1920,17 +8034,51 @@ void JnaGenerator::generate()
 				 ++k)
 			{
 				Parameter* parameter = *k;
-				fprintf(out, ", %s", escapeName(parameter->name).c_str());
+
+				if (parameter->typeRef.isArray ||
+					(method->scalarMethod && !batchArrayAccessor(convertType(parameter->typeRef, false)).empty()))
+				{
+					fprintf(out, ", %sPointer", parameter->name.c_str());
+				}
+				else
+					fprintf(out, ", %s", escapeName(parameter->name).c_str());
 			}
 
 			fprintf(out, ");");
 			fprintf(out, "\n");
 
-			if (!method->parameters.empty() &&
-				parser->exceptionInterface &&
-				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name &&
-				!exceptionClass.empty())
+			for (vector<Parameter*>::iterator k = method->parameters.begin();
+				 k != method->parameters.end();
+				 ++k)
+			{
+				Parameter* parameter = *k;
+
+				string accessor = method->scalarMethod ?
+					batchArrayAccessor(convertType(parameter->typeRef, false)) : "";
+
+				if (parameter->typeRef.isArray && parameter->direction != Parameter::DIRECTION_IN)
+				{
+					fprintf(out, "\t\t\tcloopArrayCopyBack(%sPointer, %s, %u);\n",
+						parameter->name.c_str(), escapeName(parameter->name).c_str(),
+						elementSize(parameter->typeRef));
+				}
+				else if (!accessor.empty() && !parameter->typeRef.isConst)
+				{
+					fprintf(out, "\t\t\tcloopArrayCopyBack(%sPointer, java.nio.%sBuffer.wrap(%s, 0, %s), %u);\n",
+						parameter->name.c_str(), accessor.c_str(), escapeName(parameter->name).c_str(),
+						batchCount.c_str(), elementSize(parameter->typeRef));
+				}
+			}
+
+			if (mayThrow)
 			{
+				// The status is read back by JNA after the call, so the error word is already here.
+				if (parser->exceptionInterface->errorFlag)
+				{
+					fprintf(out, "\t\t\tif (%s.cloopErrorFlag != 0)\n\t",
+						escapeName(method->parameters.front()->name).c_str());
+				}
+
 				fprintf(out, "\t\t\t%s.checkException(%s);\n", exceptionClass.c_str(),
 					escapeName(method->parameters.front()->name).c_str());
 			}
@@ -1942,6 +8090,75 @@ void JnaGenerator::generate()
 			}
 
 			fprintf(out, "\t\t}\n");
+
+			Method* scalarMethod = method->scalarMethod;
+
+			if (!scalarMethod)
+				continue;
+
+			// Array overload of the batch method, allocating the results.
+
+			bool hasResults = scalarMethod->returnTypeRef.token.type != Token::TYPE_VOID ||
+				scalarMethod->returnTypeRef.isPointer;
+			vector<Parameter*>::iterator argsEnd = method->parameters.begin() + scalarMethod->parameters.size();
+			string countArray;
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin(); k != argsEnd; ++k)
+			{
+				if ((*k)->typeRef.isPointer && countArray.empty())
+					countArray = escapeName((*k)->name);
+			}
+
+			if (countArray.empty())
+				countArray = "results";
+
+			fprintf(out, "\n");
+			fprintf(out, "\t\tpublic %s %s(",
+				(hasResults ? convertType(method->parameters[scalarMethod->parameters.size()]->typeRef, false).c_str() :
+					"void"),
+				escapeName(method->name).c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin(); k != argsEnd; ++k)
+			{
+				Parameter* parameter = *k;
+
+				if (k != method->parameters.begin())
+					fprintf(out, ", ");
+
+				fprintf(out, "%s %s",
+					convertType(parameter->typeRef, false).c_str(),
+					escapeName(parameter->name).c_str());
+			}
+
+			fprintf(out, ")");
+
+			if (mayThrow)
+				fprintf(out, " throws %s", exceptionClass.c_str());
+
+			fprintf(out, "\n");
+			fprintf(out, "\t\t{\n");
+
+			if (hasResults)
+			{
+				string resultsType = convertType(method->parameters[scalarMethod->parameters.size()]->typeRef, false);
+
+				fprintf(out, "\t\t\t%s results = new %s[%s.length];\n",
+					resultsType.c_str(),
+					resultsType.substr(0, resultsType.length() - 2).c_str(),
+					countArray.c_str());
+			}
+
+			fprintf(out, "\t\t\t%s(", escapeName(method->name).c_str());
+
+			for (vector<Parameter*>::iterator k = method->parameters.begin(); k != argsEnd; ++k)
+				fprintf(out, "%s, ", escapeName((*k)->name).c_str());
+
+			fprintf(out, "%s%s.length);\n", (hasResults ? "results, " : ""), countArray.c_str());
+
+			if (hasResults)
+				fprintf(out, "\t\t\treturn results;\n");
+
+			fprintf(out, "\t\t}\n");
 		}
 
 		fprintf(out, "\t}\n");
@@ -1979,6 +8196,14 @@ string JnaGenerator::convertType(const TypeRef& typeRef, bool forReturn)
 				name = "com.sun.jna.Pointer";
 			break;
 
+		case Token::TYPE_STRVIEW:
+			name = "CloopStrView";
+			break;
+
+		case Token::TYPE_BYTES:
+			name = "CloopBytes";
+			break;
+
 		case Token::TYPE_UCHAR:
 			name = "byte";
 			break;
@@ -1999,12 +8224,24 @@ string JnaGenerator::convertType(const TypeRef& typeRef, bool forReturn)
 			}
 
 			name += typeRef.token.text;
+
+			// JNA passes structures by reference unless marked as ByValue.
+			if (isStructure(typeRef))
+			{
+				if (!typeRef.isPointer)
+					return name + ".ByValue";
+				else if (!forReturn)
+					return name;
+			}
+
 			break;
 	}
 
 	if (typeRef.isPointer)
 	{
-		if (forReturn || name == "void")
+		if (typeRef.isArray && !forReturn)
+			return "java.nio." + string(name == "byte" ? "Byte" : name == "int" ? "Int" : "Long") + "Buffer";
+		else if (forReturn || name == "void")
 			return "com.sun.jna.Pointer";
 		else
 			name += "[]";
@@ -2013,11 +8250,59 @@ string JnaGenerator::convertType(const TypeRef& typeRef, bool forReturn)
 	return name;
 }
 
+// Callbacks get arrays as native pointers, as JNA doesn't convert arrays of unknown length.
+string JnaGenerator::convertCallbackType(const Method* method, const TypeRef& typeRef)
+{
+	if (typeRef.isArray || (method->scalarMethod && !batchArrayAccessor(convertType(typeRef, false)).empty()))
+		return "com.sun.jna.Pointer";
+
+	return convertType(typeRef, false);
+}
+
+unsigned JnaGenerator::elementSize(const TypeRef& typeRef)
+{
+	switch (typeRef.token.type)
+	{
+		case Token::TYPE_UCHAR:
+			return 1;
+
+		case Token::TYPE_INT:
+		case Token::TYPE_UINT:
+			return 4;
+
+		default:
+			return 8;
+	}
+}
+
+// Embedded structures are laid out in place and interfaces are referenced by plain pointers.
+string JnaGenerator::convertFieldType(const TypeRef& typeRef)
+{
+	if (typeRef.token.type == Token::TYPE_IDENTIFIER && !typeRef.isPointer)
+		return typeRef.type == BaseType::TYPE_INTERFACE ? "com.sun.jna.Pointer" : typeRef.token.text;
+
+	return convertType(typeRef, true);
+}
+
+// Structs with a body, generated as JNA structures.
+bool JnaGenerator::isStructure(const TypeRef& typeRef)
+{
+	if (typeRef.token.type != Token::TYPE_IDENTIFIER || typeRef.type != BaseType::TYPE_STRUCT)
+		return false;
+
+	map<string, BaseType*>::iterator it = parser->typesByName.find(typeRef.token.text);
+
+	return it != parser->typesByName.end() && static_cast<Struct*>(it->second)->defined;
+}
+
 string JnaGenerator::literalForError(const TypeRef& typeRef)
 {
 	if (typeRef.isPointer)
 		return "null";
 
+	if (isStructure(typeRef))
+		return "new " + convertType(typeRef, true) + "()";
+
 	switch (typeRef.token.type)
 	{
 		case Token::TYPE_BOOLEAN:
@@ -2032,6 +8317,10 @@ string JnaGenerator::literalForError(const TypeRef& typeRef)
 		case Token::TYPE_UCHAR:
 			return "(byte) 0";
 
+		case Token::TYPE_STRVIEW:
+		case Token::TYPE_BYTES:
+			return "new " + convertType(typeRef, true) + "()";
+
 		default:
 			return "null";
 	}
@@ -2075,6 +8364,18 @@ void JsonGenerator::generate()
 		if (interface->super)
 			fprintf(out, "\t\t\t\t\"extends\": \"%s\",\n", interface->super->name.c_str());
 
+		if (interface->compact)
+			fprintf(out, "\t\t\t\t\"compact\": true,\n");
+
+		if (interface->errorFlag && !(interface->super && interface->super->errorFlag))
+			fprintf(out, "\t\t\t\t\"errorFlag\": true,\n");
+
+		if (interface->refCounted && !(interface->super && interface->super->refCounted))
+			fprintf(out, "\t\t\t\t\"refcounted\": true,\n");
+
+		if (interface->hasIid)
+			fprintf(out, "\t\t\t\t\"iid\": %u,\n", interface->iid);
+
 		fprintf(out, "\t\t\t\t\"constants\":\n");
 		fprintf(out, "\t\t\t\t[\n");
 
@@ -2117,10 +8418,17 @@ void JsonGenerator::generate()
 
 			bool mayThrow = !method->parameters.empty() &&
 				parser->exceptionInterface &&
-				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name;
+				method->parameters.front()->typeRef.token.text == parser->exceptionInterface->name &&
+				!method->noThrow;
 
 			fprintf(out, "\t\t\t\t\t\t\"mayThrow\": %s,\n", (mayThrow ? "true" : "false"));
 
+			if (method->scalarMethod)
+			{
+				fprintf(out, "\t\t\t\t\t\t\"batchOf\": \"%s\",\n",
+					method->scalarMethod->name.c_str());
+			}
+
 			if (method->notImplementedExpr)
 			{
 				fprintf(out, "\t\t\t\t\t\t\"notImplementedExpr\": %s,\n",
@@ -2138,6 +8446,23 @@ void JsonGenerator::generate()
 
 				fprintf(out, "\t\t\t\t\t\t\t{\n");
 				fprintf(out, "\t\t\t\t\t\t\t\t\"name\": \"%s\",\n", parameter->name.c_str());
+
+				if (parameter->typeRef.isArray)
+					fprintf(out, "\t\t\t\t\t\t\t\t\"count\": \"%s\",\n", parameter->countName.c_str());
+
+				if (parameter->typeRef.isPointer || parameter->typeRef.token.type == Token::TYPE_STRING)
+				{
+					fprintf(out, "\t\t\t\t\t\t\t\t\"direction\": \"%s\",\n",
+						(parameter->direction == Parameter::DIRECTION_IN ? "in" :
+						 parameter->direction == Parameter::DIRECTION_OUT ? "out" : "inout"));
+				}
+
+				if (parameter->borrowed)
+					fprintf(out, "\t\t\t\t\t\t\t\t\"borrowed\": true,\n");
+
+				if (parameter->transfer)
+					fprintf(out, "\t\t\t\t\t\t\t\t\"transfer\": true,\n");
+
 				fprintf(out, "\t\t\t\t\t\t\t\t\"type\": %s\n",
 					convertType(parameter->typeRef).c_str());
 				fprintf(out, "\t\t\t\t\t\t\t}");
@@ -2167,6 +8492,59 @@ void JsonGenerator::generate()
 		fprintf(out, "\n");
 	}
 
+	fprintf(out, "\t\t],\n");
+
+	fprintf(out, "\t\t\"structs\":\n");
+	fprintf(out, "\t\t[\n");
+
+	bool first = true;
+
+	for (vector<Struct*>::iterator i = parser->structs.begin(); i != parser->structs.end(); ++i)
+	{
+		Struct* ztruct = *i;
+
+		if (!ztruct->defined)
+			continue;
+
+		if (!first)
+			fprintf(out, ",\n");
+
+		first = false;
+
+		fprintf(out, "\t\t\t{\n");
+		fprintf(out, "\t\t\t\t\"name\": \"%s\",\n", ztruct->name.c_str());
+
+		if (ztruct->packed)
+			fprintf(out, "\t\t\t\t\"packed\": true,\n");
+
+		if (ztruct->alignment)
+			fprintf(out, "\t\t\t\t\"alignment\": %u,\n", ztruct->alignment);
+
+		fprintf(out, "\t\t\t\t\"fields\":\n");
+		fprintf(out, "\t\t\t\t[\n");
+
+		for (vector<Field*>::iterator j = ztruct->fields.begin(); j != ztruct->fields.end(); ++j)
+		{
+			Field* field = *j;
+
+			fprintf(out, "\t\t\t\t\t{\n");
+			fprintf(out, "\t\t\t\t\t\t\"name\": \"%s\",\n", field->name.c_str());
+			fprintf(out, "\t\t\t\t\t\t\"type\": %s\n", convertType(field->typeRef).c_str());
+			fprintf(out, "\t\t\t\t\t}");
+
+			if (j + 1 != ztruct->fields.end())
+				fprintf(out, ",");
+
+			fprintf(out, "\n");
+		}
+
+		fprintf(out, "\t\t\t\t]\n");
+		fprintf(out, "\t\t\t}");
+	}
+
+	if (!first)
+		fprintf(out, "\n");
+
 	fprintf(out, "\t\t]\n");
 	fprintf(out, "\t}\n");
 	fprintf(out, "}\n");
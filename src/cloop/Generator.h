@@ -64,6 +64,8 @@ protected:
 
 protected:
 	std::string convertType(const TypeRef& typeRef);
+	void generateProbeMacro();
+	void generateStructs(Parser* parser);
 
 protected:
 	bool cPlusPlus;
@@ -74,15 +76,23 @@ class CppGenerator : public CBasedGenerator
 {
 public:
 	CppGenerator(const std::string& filename, const std::string& prefix, Parser* parser,
-		const std::string& headerGuard, const std::string& nameSpace);
+		const std::string& headerGuard, const std::string& nameSpace,
+		const std::string& probesProvider);
 
 public:
 	virtual void generate();
 
+private:
+	void generateActors();
+	void generateEpoch();
+	void generateRpc();
+	void generateRecorders();
+
 private:
 	Parser* parser;
 	std::string headerGuard;
 	std::string nameSpace;
+	std::string probesProvider;
 };
 
 
@@ -105,14 +115,18 @@ class CImplGenerator : public CBasedGenerator
 {
 public:
 	CImplGenerator(const std::string& filename, const std::string& prefix, Parser* parser,
-		const std::string& includeFilename);
+		const std::string& includeFilename, const std::string& probesProvider);
 
 public:
 	virtual void generate();
 
+private:
+	void generateExecutor();
+
 private:
 	Parser* parser;
 	std::string includeFilename;
+	std::string probesProvider;
 };
 
 
@@ -128,8 +142,15 @@ public:
 	virtual void generate();
 
 private:
+	void generateRecords();
 	std::string convertParameter(const Parameter& parameter);
+	std::string convertArrayParameters(const Method& method);
 	std::string convertType(const TypeRef& typeRef);
+	std::string convertAbiParameter(const Parameter& parameter);
+	std::string convertAbiType(const TypeRef& typeRef);
+	std::string convertToAbi(const TypeRef& typeRef, const std::string& expr);
+	std::string convertFromAbi(const TypeRef& typeRef, const std::string& expr);
+	bool isCompact(const TypeRef& typeRef);
 	std::string escapeName(std::string name, bool interfaceName = false);
 
 	void insertFile(const std::string& filename);
@@ -157,6 +178,10 @@ public:
 
 private:
 	std::string convertType(const TypeRef& typeRef, bool forReturn);
+	std::string convertFieldType(const TypeRef& typeRef);
+	std::string convertCallbackType(const Method* method, const TypeRef& typeRef);
+	static unsigned elementSize(const TypeRef& typeRef);
+	bool isStructure(const TypeRef& typeRef);
 	std::string literalForError(const TypeRef& typeRef);
 	std::string escapeName(const std::string& name);
 
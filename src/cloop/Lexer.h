@@ -41,22 +41,46 @@ struct Token
 		// literals
 		TYPE_BOOLEAN_LITERAL,
 		TYPE_INT_LITERAL,
-		// keywords
+		// keywords; the attributes and strview and bytes are contextual, lexed as identifiers and
+		// converted by the parser where they are expected
+		TYPE_ACTOR,
+		TYPE_ALIGN,
+		TYPE_ASYNC,
+		TYPE_BATCH,
+		TYPE_BORROWED,
+		TYPE_COMPACT,
 		TYPE_CONST,
+		TYPE_ERROR_FLAG,
 		TYPE_EXCEPTION,
+		TYPE_IID,
+		TYPE_IN,
+		TYPE_INOUT,
 		TYPE_INTERFACE,
 		TYPE_NOT_IMPLEMENTED,
+		TYPE_NOTHROW,
+		TYPE_OUT,
+		TYPE_PACKED,
+		TYPE_RECORDER,
+		TYPE_REFCOUNTED,
+		TYPE_REFLECTION,
+		TYPE_REPLAY,
+		TYPE_RPC,
+		TYPE_SHARED,
 		TYPE_STRUCT,
+		TYPE_TRACE,
+		TYPE_TRANSFER,
 		TYPE_TYPEDEF,
 		TYPE_VERSION,
 		TYPE_ON_ERROR,
 		// types
 		TYPE_VOID,
 		TYPE_BOOLEAN,
+		TYPE_BYTES,
 		TYPE_INT,
 		TYPE_INT64,
 		TYPE_INTPTR,
 		TYPE_STRING,
+		TYPE_STRVIEW,
 		TYPE_UCHAR,
 		TYPE_UINT,
 		TYPE_UINT64
@@ -39,6 +39,22 @@ using std::runtime_error;
 //--------------------------------------
 
 
+// Reads the switches following the positional parameters of the C and C++ outputs.
+static string parseProbesSwitch(int argc, const char* argv[], int start)
+{
+	string probesProvider;
+
+	for (int i = start; i < argc; i += 2)
+	{
+		if (string(argv[i]) != "--probes" || i + 1 >= argc)
+			throw runtime_error(string("Unknown switch ") + argv[i]);
+
+		probesProvider = argv[i + 1];
+	}
+
+	return probesProvider;
+}
+
 static void run(int argc, const char* argv[])
 {
 	if (argc < 4)
@@ -63,8 +79,10 @@ static void run(int argc, const char* argv[])
 		string headerGuard(argv[4]);
 		string className(argv[5]);
 		string prefix(argv[6]);
+		string probesProvider(parseProbesSwitch(argc, argv, 7));
 
-		generator.reset(new CppGenerator(outFilename, prefix, &parser, headerGuard, className));
+		generator.reset(new CppGenerator(outFilename, prefix, &parser, headerGuard, className,
+			probesProvider));
 	}
 	else if (outFormat == "c-header")
 	{
@@ -83,8 +101,10 @@ static void run(int argc, const char* argv[])
 
 		string includeFilename(argv[4]);
 		string prefix(argv[5]);
+		string probesProvider(parseProbesSwitch(argc, argv, 6));
 
-		generator.reset(new CImplGenerator(outFilename, prefix, &parser, includeFilename));
+		generator.reset(new CImplGenerator(outFilename, prefix, &parser, includeFilename,
+			probesProvider));
 	}
 	else if (outFormat == "pascal")
 	{
@@ -37,8 +37,12 @@ using std::vector;
 
 Parser::Parser(Lexer* lexer)
 	: exceptionInterface(NULL),
+	  reflection(false),
+	  replay(false),
+	  trace(false),
 	  lexer(lexer),
-	  interface(NULL)
+	  interface(NULL),
+	  compact(false)
 {
 }
 
@@ -49,36 +53,222 @@ void Parser::parse()
 	while (true)
 	{
 		bool exception = false;
+		bool compact = false;
+		bool errorFlag = false;
+		bool refCounted = false;
+		bool rpc = false;
+		bool actor = false;
+		bool shared = false;
+		bool recorder = false;
+		bool reflection = false;
+		bool replay = false;
+		bool trace = false;
+		bool hasIid = false;
+		bool packed = false;
+		bool hasAlign = false;
+		Token iidToken;
+		Token alignToken;
 		lexer->getToken(token);
 
 		if (token.type == Token::TYPE_EOF)
 			break;
-		else if (token.type == TOKEN('['))
+
+		while (token.type == TOKEN('['))
 		{
-			getToken(token, Token::TYPE_EXCEPTION);	// This is the only attribute we allow now.
-			exception = true;
+			getAttributeToken(token);
+
+			switch (token.type)
+			{
+				case Token::TYPE_EXCEPTION:
+					if (exception)
+						syntaxError(token);
+					exception = true;
+					break;
+
+				case Token::TYPE_COMPACT:
+					if (compact)
+						syntaxError(token);
+					compact = true;
+					break;
+
+				case Token::TYPE_ERROR_FLAG:
+					if (errorFlag)
+						syntaxError(token);
+					errorFlag = true;
+					break;
+
+				case Token::TYPE_REFCOUNTED:
+					if (refCounted)
+						syntaxError(token);
+					refCounted = true;
+					break;
+
+				case Token::TYPE_RPC:
+					if (rpc)
+						syntaxError(token);
+					rpc = true;
+					break;
+
+				case Token::TYPE_ACTOR:
+					if (actor)
+						syntaxError(token);
+					actor = true;
+					break;
+
+				case Token::TYPE_SHARED:
+					if (shared)
+						syntaxError(token);
+					shared = true;
+					break;
+
+				case Token::TYPE_RECORDER:
+					if (recorder)
+						syntaxError(token);
+					recorder = true;
+					break;
+
+				case Token::TYPE_REFLECTION:
+					if (reflection)
+						syntaxError(token);
+					reflection = true;
+					break;
+
+				case Token::TYPE_REPLAY:
+					if (replay)
+						syntaxError(token);
+					replay = true;
+					break;
+
+				case Token::TYPE_TRACE:
+					if (trace)
+						syntaxError(token);
+					trace = true;
+					break;
+
+				case Token::TYPE_IID:
+					if (hasIid)
+						syntaxError(token);
+					hasIid = true;
+					getToken(token, TOKEN('('));
+					iidToken = getToken(token, Token::TYPE_INT_LITERAL);
+					getToken(token, TOKEN(')'));
+					break;
+
+				case Token::TYPE_PACKED:
+					if (packed)
+						syntaxError(token);
+					packed = true;
+					break;
+
+				case Token::TYPE_ALIGN:
+					if (hasAlign)
+						syntaxError(token);
+					hasAlign = true;
+					getToken(token, TOKEN('('));
+					alignToken = getToken(token, Token::TYPE_INT_LITERAL);
+					getToken(token, TOKEN(')'));
+					break;
+
+				default:
+					syntaxError(token);
+					break;
+			}
+
 			getToken(token, TOKEN(']'));
+			lexer->getToken(token);
 		}
-		else
-			lexer->pushToken(token);
 
-		lexer->getToken(token);
+		// Attributes ended by a semicolon apply to the whole IDL.
+		if (token.type == TOKEN(';'))
+		{
+			if (exception || errorFlag || refCounted || rpc || actor || shared || recorder || hasIid ||
+				packed || hasAlign)
+			{
+				error(token, "Only attributes compact, reflection, replay and trace can be used in the "
+					"whole IDL.");
+			}
+			if (!compact && !reflection && !replay && !trace)
+				syntaxError(token);
+			if (compact && !interfaces.empty())
+				error(token, "Attribute compact of the whole IDL must precede its interfaces.");
+			if (compact)
+				this->compact = true;
+			if (reflection)
+				this->reflection = true;
+			if (replay)
+				this->replay = true;
+			if (trace)
+				this->trace = true;
+			continue;
+		}
+
+		if (reflection)
+			error(token, "Attribute reflection can only be used in the whole IDL.");
+		if (replay)
+			error(token, "Attribute replay can only be used in the whole IDL.");
+		if (trace)
+			error(token, "Attribute trace can only be used in the whole IDL.");
 
 		switch (token.type)
 		{
 			case Token::TYPE_INTERFACE:
-				parseInterface(exception);
+				if (errorFlag && !exception)
+					error(token, "Attribute errorFlag requires attribute exception.");
+				if (packed)
+					error(token, "Cannot use attribute packed in interface.");
+				if (hasAlign)
+					error(token, "Cannot use attribute align in interface.");
+				parseInterface(exception, compact || this->compact, errorFlag, refCounted, rpc, actor,
+					shared, recorder, (hasIid ? &iidToken : NULL));
 				break;
 
 			case Token::TYPE_STRUCT:
 				if (exception)
 					error(token, "Cannot use attribute exception in struct.");
-				parseStruct();
+				if (compact)
+					error(token, "Cannot use attribute compact in struct.");
+				if (errorFlag)
+					error(token, "Cannot use attribute errorFlag in struct.");
+				if (refCounted)
+					error(token, "Cannot use attribute refcounted in struct.");
+				if (rpc)
+					error(token, "Cannot use attribute rpc in struct.");
+				if (actor)
+					error(token, "Cannot use attribute actor in struct.");
+				if (shared)
+					error(token, "Cannot use attribute shared in struct.");
+				if (recorder)
+					error(token, "Cannot use attribute recorder in struct.");
+				if (hasIid)
+					error(token, "Cannot use attribute iid in struct.");
+				if (packed && hasAlign)
+					error(token, "Cannot use attributes packed and align together.");
+				parseStruct(packed, (hasAlign ? &alignToken : NULL));
 				break;
 
 			case Token::TYPE_TYPEDEF:
 				if (exception)
 					error(token, "Cannot use attribute exception in typedef.");
+				if (compact)
+					error(token, "Cannot use attribute compact in typedef.");
+				if (errorFlag)
+					error(token, "Cannot use attribute errorFlag in typedef.");
+				if (refCounted)
+					error(token, "Cannot use attribute refcounted in typedef.");
+				if (rpc)
+					error(token, "Cannot use attribute rpc in typedef.");
+				if (actor)
+					error(token, "Cannot use attribute actor in typedef.");
+				if (shared)
+					error(token, "Cannot use attribute shared in typedef.");
+				if (recorder)
+					error(token, "Cannot use attribute recorder in typedef.");
+				if (hasIid)
+					error(token, "Cannot use attribute iid in typedef.");
+				if (packed)
+					error(token, "Cannot use attribute packed in typedef.");
+				if (hasAlign)
+					error(token, "Cannot use attribute align in typedef.");
 				parseTypedef();
 				break;
 
@@ -88,6 +278,8 @@ void Parser::parse()
 		}
 	}
 
+	interfaces.insert(interfaces.end(), completionInterfaces.begin(), completionInterfaces.end());
+
 	// Check types.
 
 	for (vector<Interface*>::iterator i = interfaces.begin(); i != interfaces.end(); ++i)
@@ -108,12 +300,20 @@ void Parser::parse()
 			{
 				Parameter* parameter = *k;
 				checkType(parameter->typeRef);
+				checkOwnership(parameter);
+
+				if (interface->rpc)
+					checkRpc(interface, method, parameter);
 			}
+
+			if (interface->rpc)
+				checkRpc(interface, method, NULL);
 		}
 	}
 }
 
-void Parser::parseInterface(bool exception)
+void Parser::parseInterface(bool exception, bool compact, bool errorFlag, bool refCounted, bool rpc,
+	bool actor, bool shared, bool recorder, const Token* iidToken)
 {
 	interface = new Interface();
 	interfaces.push_back(interface);
@@ -124,6 +324,30 @@ void Parser::parseInterface(bool exception)
 	if (exception)
 		exceptionInterface = interface;
 
+	interface->compact = compact;
+	interface->errorFlag = errorFlag;
+	interface->refCounted = refCounted;
+	interface->rpc = rpc;
+	interface->actor = actor;
+	interface->shared = shared;
+	interface->recorder = recorder;
+
+	if (iidToken)
+	{
+		const char* p = iidToken->text.c_str();
+		interface->hasIid = true;
+		interface->iid = (unsigned) strtoul(p, NULL, (strlen(p) > 2 && tolower(p[1]) == 'x' ? 16 : 10));
+
+		for (vector<Interface*>::iterator i = interfaces.begin(); i != interfaces.end(); ++i)
+		{
+			if (*i != interface && (*i)->hasIid && (*i)->iid == interface->iid)
+			{
+				error(*iidToken, string("Interface '") + interface->name +
+					"' uses the iid of interface '" + (*i)->name + "'.");
+			}
+		}
+	}
+
 	if (lexer->getToken(token).type == TOKEN(':'))
 	{
 		string superName = getToken(token, Token::TYPE_IDENTIFIER).text;
@@ -134,6 +358,35 @@ void Parser::parseInterface(bool exception)
 
 		interface->super = static_cast<Interface*>(it->second);
 		interface->version = interface->super->version + 1;
+
+		// The layout is fixed by the root interface, so it's inherited by the whole hierarchy.
+		if (compact && !interface->super->compact)
+		{
+			error(token, string("Compact interface '") + interface->name +
+				"' cannot extend non-compact interface '" + superName + "'.");
+		}
+
+		interface->compact = interface->super->compact;
+
+		// The stubs make the calls of the whole hierarchy.
+		if (rpc && !interface->super->rpc)
+		{
+			error(token, string("Rpc interface '") + interface->name +
+				"' cannot extend non-rpc interface '" + superName + "'.");
+		}
+
+		// So do the recorders, derived from the recorder of the super interface.
+		if (recorder && !interface->super->recorder)
+		{
+			error(token, string("Recorder interface '") + interface->name +
+				"' cannot extend non-recorder interface '" + superName + "'.");
+		}
+
+		if (interface->super->errorFlag)
+			interface->errorFlag = true;
+
+		if (interface->super->refCounted)
+			interface->refCounted = true;
 	}
 	else
 		lexer->pushToken(token);
@@ -152,16 +405,83 @@ void Parser::parseInterface(bool exception)
 
 		parseItem();
 	}
+
+	// The generated implementations and smart pointers rely on these methods.
+	if (refCounted && !(interface->super && interface->super->refCounted))
+	{
+		bool hasAddRef = false;
+		bool hasRelease = false;
+
+		for (vector<Method*>::iterator i = interface->methods.begin(); i != interface->methods.end(); ++i)
+		{
+			Method* method = *i;
+
+			if (!method->parameters.empty() || method->returnTypeRef.isPointer)
+				continue;
+
+			if (method->name == "addRef" && method->returnTypeRef.token.type == Token::TYPE_VOID)
+				hasAddRef = true;
+			else if (method->name == "release" && method->returnTypeRef.token.type == Token::TYPE_INT)
+				hasRelease = true;
+		}
+
+		if (!hasAddRef || !hasRelease)
+		{
+			error(token, string("Refcounted interface '") + interface->name +
+				"' must declare methods 'void addRef()' and 'int release()'.");
+		}
+	}
 }
 
-void Parser::parseStruct()
+void Parser::parseStruct(bool packed, const Token* alignToken)
 {
 	Struct* ztruct = new Struct();
+	structs.push_back(ztruct);
 
 	ztruct->name = getToken(token, Token::TYPE_IDENTIFIER).text;
 	typesByName.insert(pair<string, BaseType*>(ztruct->name, ztruct));
 
-	getToken(token, TOKEN(';'));
+	// Opaque structs are only declared, to be defined outside of the generated code.
+	if (lexer->getToken(token).type == TOKEN(';'))
+	{
+		if (packed || alignToken)
+			error(token, string("Opaque struct '") + ztruct->name + "' cannot have a layout.");
+
+		return;
+	}
+	else if (token.type != TOKEN('{'))
+		syntaxError(token);
+
+	ztruct->defined = true;
+	ztruct->packed = packed;
+
+	if (alignToken)
+	{
+		const char* p = alignToken->text.c_str();
+		ztruct->alignment = (unsigned) strtoul(p, NULL, (strlen(p) > 2 && tolower(p[1]) == 'x' ? 16 : 10));
+
+		if (ztruct->alignment == 0 || ztruct->alignment > 64 ||
+			(ztruct->alignment & (ztruct->alignment - 1)) != 0)
+		{
+			error(*alignToken, "Alignment must be a power of two up to 64.");
+		}
+	}
+
+	while (lexer->getToken(token).type != TOKEN('}'))
+	{
+		lexer->pushToken(token);
+
+		Field* field = new Field();
+		field->typeRef = parseTypeRef();
+		field->name = getToken(token, Token::TYPE_IDENTIFIER).text;
+		getToken(token, TOKEN(';'));
+
+		checkField(ztruct, field);
+		ztruct->fields.push_back(field);
+	}
+
+	if (ztruct->fields.empty())
+		error(token, string("Struct '") + ztruct->name + "' must have fields.");
 }
 
 void Parser::parseTypedef()
@@ -178,10 +498,13 @@ void Parser::parseItem()
 {
 	Expr* notImplementedExpr = NULL;
 	std::string onError;
+	bool noThrow = false;
+	bool batch = false;
+	bool async = false;
 
 	while (lexer->getToken(token).type == TOKEN('['))
 	{
-		lexer->getToken(token);
+		getAttributeToken(token);
 		switch (token.type)
 		{
 			case Token::TYPE_NOT_IMPLEMENTED:
@@ -203,6 +526,27 @@ void Parser::parseItem()
 				getToken(token, TOKEN(']'));
 				break;
 
+			case Token::TYPE_NOTHROW:
+				if (noThrow)
+					syntaxError(token);
+				noThrow = true;
+				getToken(token, TOKEN(']'));
+				break;
+
+			case Token::TYPE_BATCH:
+				if (batch)
+					syntaxError(token);
+				batch = true;
+				getToken(token, TOKEN(']'));
+				break;
+
+			case Token::TYPE_ASYNC:
+				if (async)
+					syntaxError(token);
+				async = true;
+				getToken(token, TOKEN(']'));
+				break;
+
 			default:
 				syntaxError(token);
 				break;
@@ -210,10 +554,33 @@ void Parser::parseItem()
 	}
 	lexer->pushToken(token);
 
+	// '[batch] name;' adds the batch variant of a method declared in a previous version, in the
+	// current one, so the slots of the previous versions are kept.
+	if (batch)
+	{
+		Token nameToken;
+
+		if (lexer->getToken(nameToken).type == Token::TYPE_IDENTIFIER)
+		{
+			if (lexer->getToken(token).type == TOKEN(';'))
+			{
+				if (notImplementedExpr || onError.length() || noThrow || async)
+					error(nameToken, "Only attribute batch can be used in the redeclaration of a method.");
+
+				addBatchMethod(findBatchedMethod(nameToken));
+				return;
+			}
+
+			lexer->pushToken(token);
+		}
+
+		lexer->pushToken(nameToken);
+	}
+
 	TypeRef typeRef(parseTypeRef());
 	string name(getToken(token, Token::TYPE_IDENTIFIER).text);
 
-	if ((!(notImplementedExpr || onError.length())) && typeRef.isConst)
+	if ((!(notImplementedExpr || onError.length() || noThrow || batch || async)) && typeRef.isConst)
 	{
 		if (lexer->getToken(token).type == TOKEN('='))
 		{
@@ -225,8 +592,14 @@ void Parser::parseItem()
 			lexer->pushToken(token);
 	}
 
+	if (noThrow && onError.length())
+		error(token, "Cannot use attribute onError in nothrow method.");
+
+	if (batch && async)
+		error(token, "Cannot use attributes batch and async in the same method.");
+
 	getToken(token, TOKEN('('));
-	parseMethod(typeRef, name, notImplementedExpr, onError);
+	parseMethod(typeRef, name, notImplementedExpr, onError, noThrow, batch, async);
 }
 
 void Parser::parseConstant(const TypeRef& typeRef, const string& name)
@@ -241,7 +614,7 @@ void Parser::parseConstant(const TypeRef& typeRef, const string& name)
 	getToken(token, TOKEN(';'));
 }
 
-void Parser::parseMethod(const TypeRef& returnTypeRef, const string& name, Expr* notImplementedExpr, const string& onError)
+void Parser::parseMethod(const TypeRef& returnTypeRef, const string& name, Expr* notImplementedExpr, const string& onError, bool noThrow, bool batch, bool async)
 {
 	Method* method = new Method();
 	interface->methods.push_back(method);
@@ -251,6 +624,7 @@ void Parser::parseMethod(const TypeRef& returnTypeRef, const string& name, Expr*
 	method->version = interface->version;
 	method->notImplementedExpr = notImplementedExpr;
 	method->onErrorFunction = onError;
+	method->noThrow = noThrow;
 
 	if (lexer->getToken(token).type != TOKEN(')'))
 	{
@@ -261,9 +635,52 @@ void Parser::parseMethod(const TypeRef& returnTypeRef, const string& name, Expr*
 			Parameter* parameter = new Parameter();
 			method->parameters.push_back(parameter);
 
+			Token directionToken;
+			bool hasDirection = false;
+
+			while (lexer->getToken(token).type == TOKEN('['))
+			{
+				getAttributeToken(token);
+				switch (token.type)
+				{
+					case Token::TYPE_IN:
+					case Token::TYPE_OUT:
+					case Token::TYPE_INOUT:
+						if (hasDirection)
+							error(token, "Cannot use more than one of the attributes in, out and inout.");
+						hasDirection = true;
+						directionToken = token;
+						break;
+
+					case Token::TYPE_BORROWED:
+					case Token::TYPE_TRANSFER:
+						if (parameter->borrowed || parameter->transfer)
+							error(token, "Cannot use more than one of the attributes borrowed and transfer.");
+						if (token.type == Token::TYPE_BORROWED)
+							parameter->borrowed = true;
+						else
+							parameter->transfer = true;
+						break;
+
+					default:
+						syntaxError(token);
+						break;
+				}
+				getToken(token, TOKEN(']'));
+			}
+			lexer->pushToken(token);
+
 			parameter->typeRef = parseTypeRef();
+
+			if (lexer->getToken(token).type == TOKEN('['))
+				parseArray(parameter);
+			else
+				lexer->pushToken(token);
+
 			parameter->name = getToken(token, Token::TYPE_IDENTIFIER).text;
 
+			setDirection(parameter, (hasDirection ? &directionToken : NULL));
+
 			lexer->getToken(token);
 			lexer->pushToken(token);
 
@@ -274,6 +691,8 @@ void Parser::parseMethod(const TypeRef& returnTypeRef, const string& name, Expr*
 		}
 
 		getToken(token, TOKEN(')'));
+
+		checkArrays(method);
 	}
 
 	if (lexer->getToken(token).type == Token::TYPE_CONST)
@@ -282,6 +701,187 @@ void Parser::parseMethod(const TypeRef& returnTypeRef, const string& name, Expr*
 		lexer->pushToken(token);
 
 	getToken(token, TOKEN(';'));
+
+	if (batch)
+		addBatchMethod(method);
+
+	if (async)
+		addAsyncMethod(method);
+}
+
+Method* Parser::findBatchedMethod(const Token& nameToken)
+{
+	Method* found = NULL;
+
+	for (Interface* p = interface; p && !found; p = p->super)
+	{
+		for (vector<Method*>::iterator i = p->methods.begin(); i != p->methods.end(); ++i)
+		{
+			if ((*i)->name == nameToken.text && !(*i)->scalarMethod)
+			{
+				found = *i;
+				break;
+			}
+		}
+	}
+
+	if (!found)
+		error(nameToken, string("Method '") + nameToken.text + "' not found.");
+
+	for (Interface* p = interface; p; p = p->super)
+	{
+		for (vector<Method*>::iterator i = p->methods.begin(); i != p->methods.end(); ++i)
+		{
+			if ((*i)->scalarMethod == found)
+				error(nameToken, string("Method '") + nameToken.text + "' already has a batch variant.");
+		}
+	}
+
+	return found;
+}
+
+// Adds the slot following a [batch] method, or the next slot of the current version when an
+// earlier method is redeclared with [batch], taking its arguments as parallel arrays and
+// storing its results in the out array, e.g. sumBatch(status, const int* n1, const int* n2,
+// int* results, uint count).
+void Parser::addBatchMethod(Method* method)
+{
+	Method* batchMethod = new Method();
+	interface->methods.push_back(batchMethod);
+
+	batchMethod->name = method->name + "Batch";
+	batchMethod->returnTypeRef.token.type = Token::TYPE_VOID;
+	batchMethod->returnTypeRef.token.text = "void";
+	batchMethod->scalarMethod = method;
+	batchMethod->version = interface->version;
+	batchMethod->isConst = method->isConst;
+	batchMethod->noThrow = method->noThrow;
+
+	for (vector<Parameter*>::iterator i = method->parameters.begin(); i != method->parameters.end(); ++i)
+	{
+		Parameter* parameter = new Parameter(**i);
+		batchMethod->parameters.push_back(parameter);
+
+		if (i == method->parameters.begin() && exceptionInterface &&
+			parameter->typeRef.token.text == exceptionInterface->name)
+		{
+			continue;
+		}
+
+		if (parameter->typeRef.isPointer || parameter->typeRef.token.type == Token::TYPE_IDENTIFIER ||
+			parameter->typeRef.token.type == Token::TYPE_STRING ||
+			parameter->typeRef.token.type == Token::TYPE_STRVIEW ||
+			parameter->typeRef.token.type == Token::TYPE_BYTES)
+		{
+			error(parameter->typeRef.token, string("Parameter '") + parameter->name +
+				"' of batch method '" + method->name + "' must have a scalar type.");
+		}
+
+		parameter->typeRef.isConst = true;
+		parameter->typeRef.isPointer = true;
+	}
+
+	if (method->returnTypeRef.token.type != Token::TYPE_VOID || method->returnTypeRef.isPointer)
+	{
+		if (method->returnTypeRef.isPointer ||
+			method->returnTypeRef.token.type == Token::TYPE_IDENTIFIER ||
+			method->returnTypeRef.token.type == Token::TYPE_STRING ||
+			method->returnTypeRef.token.type == Token::TYPE_STRVIEW ||
+			method->returnTypeRef.token.type == Token::TYPE_BYTES)
+		{
+			error(method->returnTypeRef.token, string("Batch method '") + method->name +
+				"' must return a scalar type.");
+		}
+
+		Parameter* results = new Parameter();
+		batchMethod->parameters.push_back(results);
+
+		results->name = "results";
+		results->typeRef = method->returnTypeRef;
+		results->typeRef.isConst = false;
+		results->typeRef.isPointer = true;
+		results->direction = Parameter::DIRECTION_OUT;
+	}
+
+	if (batchMethod->parameters.empty() || !batchMethod->parameters.back()->typeRef.isPointer)
+	{
+		error(method->returnTypeRef.token, string("Batch method '") + method->name +
+			"' must have parameters or a result.");
+	}
+
+	Parameter* count = new Parameter();
+	batchMethod->parameters.push_back(count);
+
+	count->name = "count";
+	count->typeRef.token.type = Token::TYPE_UINT;
+	count->typeRef.token.text = "uint";
+}
+
+// Adds the slot following an [async] method, which takes a completion interface with the
+// method result, e.g. sumAsync(status, int n1, int n2, CalculatorSumCompletion completion).
+// Methods taking a status pass one to complete too, with the error of calls failing after they
+// returned; complete doesn't throw it, as it's the caller's to report.
+// The completion interfaces are added after the ones declared in the IDL, keeping their order.
+void Parser::addAsyncMethod(Method* method)
+{
+	string methodName = method->name;
+	methodName[0] = toupper(methodName[0]);
+
+	Interface* completion = new Interface();
+	completionInterfaces.push_back(completion);
+
+	completion->name = interface->name + methodName + "Completion";
+
+	if (!typesByName.insert(pair<string, BaseType*>(completion->name, completion)).second)
+	{
+		error(token, string("Completion interface '") + completion->name + "' of async method '" +
+			method->name + "' is already declared.");
+	}
+
+	Method* complete = new Method();
+	completion->methods.push_back(complete);
+
+	complete->name = "complete";
+	complete->returnTypeRef.token.type = Token::TYPE_VOID;
+	complete->returnTypeRef.token.text = "void";
+	complete->version = completion->version;
+	complete->noThrow = true;
+
+	if (exceptionInterface && !method->parameters.empty() &&
+		method->parameters.front()->typeRef.token.text == exceptionInterface->name)
+	{
+		complete->parameters.push_back(new Parameter(*method->parameters.front()));
+	}
+
+	if (method->returnTypeRef.token.type != Token::TYPE_VOID || method->returnTypeRef.isPointer)
+	{
+		Parameter* result = new Parameter();
+		complete->parameters.push_back(result);
+
+		result->name = "result";
+		result->typeRef = method->returnTypeRef;
+	}
+
+	Method* asyncMethod = new Method();
+	interface->methods.push_back(asyncMethod);
+
+	asyncMethod->name = method->name + "Async";
+	asyncMethod->returnTypeRef.token.type = Token::TYPE_VOID;
+	asyncMethod->returnTypeRef.token.text = "void";
+	asyncMethod->syncMethod = method;
+	asyncMethod->version = method->version;
+	asyncMethod->isConst = method->isConst;
+	asyncMethod->noThrow = method->noThrow;
+
+	for (vector<Parameter*>::iterator i = method->parameters.begin(); i != method->parameters.end(); ++i)
+		asyncMethod->parameters.push_back(new Parameter(**i));
+
+	Parameter* completionParameter = new Parameter();
+	asyncMethod->parameters.push_back(completionParameter);
+
+	completionParameter->name = "completion";
+	completionParameter->typeRef.token.type = Token::TYPE_IDENTIFIER;
+	completionParameter->typeRef.token.text = completion->name;
 }
 
 Expr* Parser::parseExpr()
@@ -373,6 +973,248 @@ void Parser::checkType(TypeRef& typeRef)
 	}
 }
 
+// Array parameters, e.g. 'const int[count] values', are passed as pointers to the elements and
+// their number is given by an integer parameter of the same method. Arrays of a call never
+// overlap, so implementations may vectorize over them.
+void Parser::parseArray(Parameter* parameter)
+{
+	TypeRef& typeRef = parameter->typeRef;
+	bool integer = false;
+
+	switch (typeRef.token.type)
+	{
+		case Token::TYPE_INT:
+		case Token::TYPE_INT64:
+		case Token::TYPE_UCHAR:
+		case Token::TYPE_UINT:
+		case Token::TYPE_UINT64:
+			integer = true;
+			break;
+
+		default:
+			break;
+	}
+
+	if (!integer || typeRef.isPointer)
+		error(typeRef.token, "Arrays must have int, uint, int64, uint64 or uchar elements.");
+
+	typeRef.isPointer = true;
+	typeRef.isArray = true;
+
+	parameter->countName = getToken(token, Token::TYPE_IDENTIFIER).text;
+	getToken(token, TOKEN(']'));
+}
+
+void Parser::checkArrays(Method* method)
+{
+	for (vector<Parameter*>::iterator i = method->parameters.begin(); i != method->parameters.end(); ++i)
+	{
+		Parameter* array = *i;
+
+		if (!array->typeRef.isArray)
+			continue;
+
+		Parameter* count = NULL;
+
+		for (vector<Parameter*>::iterator j = method->parameters.begin(); j != method->parameters.end(); ++j)
+		{
+			if ((*j)->name == array->countName)
+				count = *j;
+		}
+
+		switch (count && !count->typeRef.isPointer ? count->typeRef.token.type : Token::TYPE_VOID)
+		{
+			case Token::TYPE_INT:
+			case Token::TYPE_INT64:
+			case Token::TYPE_UINT:
+			case Token::TYPE_UINT64:
+				break;
+
+			default:
+				error(array->typeRef.token, string("Count '") + array->countName + "' of array '" +
+					array->name + "' must be an integer parameter of method '" + method->name + "'.");
+				break;
+		}
+	}
+}
+
+// Data passed by reference is read by the callee when const and read and written otherwise,
+// unless an attribute tells its direction.
+void Parser::setDirection(Parameter* parameter, const Token* directionToken)
+{
+	const TypeRef& typeRef = parameter->typeRef;
+	bool reference = typeRef.isPointer || typeRef.token.type == Token::TYPE_STRING;
+
+	parameter->direction = reference && !typeRef.isConst ?
+		Parameter::DIRECTION_INOUT : Parameter::DIRECTION_IN;
+
+	if (!directionToken)
+		return;
+
+	if (!reference)
+	{
+		error(*directionToken, string("Attribute ") + directionToken->text + " of parameter '" +
+			parameter->name + "' needs a pointer, an array or a string.");
+	}
+
+	if (directionToken->type != Token::TYPE_IN && typeRef.isConst)
+	{
+		error(*directionToken, string("Parameter '") + parameter->name + "' is const and cannot be " +
+			directionToken->text + ".");
+	}
+
+	switch (directionToken->type)
+	{
+		case Token::TYPE_OUT:
+			parameter->direction = Parameter::DIRECTION_OUT;
+			break;
+
+		case Token::TYPE_INOUT:
+			parameter->direction = Parameter::DIRECTION_INOUT;
+			break;
+
+		default:
+			parameter->direction = Parameter::DIRECTION_IN;
+			break;
+	}
+}
+
+// Interfaces are borrowed by the callee unless the caller's reference is transferred to it.
+// Data passed by reference may be marked borrowed too, when the callee uses it only during the
+// call and never keeps it.
+void Parser::checkOwnership(Parameter* parameter)
+{
+	const TypeRef& typeRef = parameter->typeRef;
+	bool object = typeRef.token.type == Token::TYPE_IDENTIFIER &&
+		typeRef.type == BaseType::TYPE_INTERFACE && !typeRef.isPointer;
+
+	if (parameter->transfer && !object)
+	{
+		error(typeRef.token, string("Attribute transfer of parameter '") + parameter->name +
+			"' needs an interface.");
+	}
+
+	if (parameter->borrowed && !object && !typeRef.isPointer && typeRef.token.type != Token::TYPE_STRING)
+	{
+		error(typeRef.token, string("Attribute borrowed of parameter '") + parameter->name +
+			"' needs an interface, a pointer, an array or a string.");
+	}
+}
+
+// Methods of rpc interfaces have their arguments copied to the other process, so these must have
+// a known size, and interfaces passed must have stubs too. Pointers are carried as arrays when
+// counted and as a single element when they point to a defined struct. The result is checked
+// when no parameter is given.
+void Parser::checkRpc(Interface* interface, Method* method, Parameter* parameter)
+{
+	const TypeRef& typeRef = parameter ? parameter->typeRef : method->returnTypeRef;
+	string name = interface->name + "::" + method->name;
+	string what = parameter ?
+		string("Parameter '") + parameter->name + "' of method '" + name + "'" :
+		string("Result of method '") + name + "'";
+	bool counted = parameter && (typeRef.isArray || (method->scalarMethod && typeRef.isPointer));
+
+	if (typeRef.token.type == Token::TYPE_IDENTIFIER && typeRef.type == BaseType::TYPE_INTERFACE &&
+		!typeRef.isPointer && !static_cast<Interface*>(typesByName[typeRef.token.text])->rpc)
+	{
+		error(typeRef.token, what + " needs interface '" + typeRef.token.text + "' to be rpc.");
+	}
+
+	if (!counted && (!isCarried(typeRef) || (!parameter && typeRef.isPointer)))
+		error(typeRef.token, what + " cannot be carried by rpc.");
+}
+
+bool Parser::isCarried(const TypeRef& typeRef)
+{
+	if (typeRef.token.type != Token::TYPE_IDENTIFIER)
+		return !typeRef.isPointer;
+
+	if (typeRef.type != BaseType::TYPE_STRUCT)
+		return typeRef.type == BaseType::TYPE_INTERFACE && !typeRef.isPointer;
+
+	return isPlain(static_cast<Struct*>(typesByName[typeRef.token.text]));
+}
+
+// Defined structs without pointers and strings, which may be copied to another process.
+bool Parser::isPlain(Struct* ztruct)
+{
+	if (!ztruct->defined)
+		return false;
+
+	for (vector<Field*>::iterator i = ztruct->fields.begin(); i != ztruct->fields.end(); ++i)
+	{
+		const TypeRef& typeRef = (*i)->typeRef;
+
+		if (typeRef.isPointer || typeRef.token.type == Token::TYPE_STRING)
+			return false;
+
+		if (typeRef.token.type == Token::TYPE_IDENTIFIER &&
+			(typeRef.type != BaseType::TYPE_STRUCT ||
+			 !isPlain(static_cast<Struct*>(typesByName[typeRef.token.text]))))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Fields have the same layout in all languages, so they can't have types of language-dependent
+// sizes, and embedded structs must be already defined.
+void Parser::checkField(Struct* ztruct, Field* field)
+{
+	TypeRef& typeRef = field->typeRef;
+	string what = string("Field '") + field->name + "' of struct '" + ztruct->name + "'";
+
+	for (vector<Field*>::iterator i = ztruct->fields.begin(); i != ztruct->fields.end(); ++i)
+	{
+		if ((*i)->name == field->name)
+			error(typeRef.token, what + " is already declared.");
+	}
+
+	if (typeRef.isPointer)
+	{
+		checkType(typeRef);
+		return;
+	}
+
+	if (typeRef.isConst && typeRef.token.type != Token::TYPE_STRING)
+		error(typeRef.token, what + " cannot be const.");
+
+	switch (typeRef.token.type)
+	{
+		case Token::TYPE_VOID:
+			error(typeRef.token, what + " cannot be void.");
+			break;
+
+		case Token::TYPE_BOOLEAN:
+			error(typeRef.token, what + " cannot be boolean, which has no fixed size. Use uchar.");
+			break;
+
+		case Token::TYPE_STRVIEW:
+		case Token::TYPE_BYTES:
+			error(typeRef.token, what + " cannot be a view, which is only valid during calls.");
+			break;
+
+		case Token::TYPE_IDENTIFIER:
+		{
+			checkType(typeRef);
+
+			BaseType* type = typesByName[typeRef.token.text];
+
+			if (type == ztruct)
+				error(typeRef.token, what + " cannot embed its own struct.");
+			else if (type->type == BaseType::TYPE_STRUCT && !static_cast<Struct*>(type)->defined)
+				error(typeRef.token, what + " cannot embed an opaque struct.");
+
+			break;
+		}
+
+		default:
+			break;
+	}
+}
+
 Token& Parser::getToken(Token& token, Token::Type expected, bool allowEof)
 {
 	lexer->getToken(token);
@@ -383,6 +1225,54 @@ Token& Parser::getToken(Token& token, Token::Type expected, bool allowEof)
 	return token;
 }
 
+// Attributes are only keywords inside brackets, so they may still name parameters and methods.
+Token& Parser::getAttributeToken(Token& token)
+{
+	static const struct
+	{
+		const char* text;
+		Token::Type type;
+	} attributes[] = {
+		{"actor", Token::TYPE_ACTOR},
+		{"align", Token::TYPE_ALIGN},
+		{"async", Token::TYPE_ASYNC},
+		{"batch", Token::TYPE_BATCH},
+		{"borrowed", Token::TYPE_BORROWED},
+		{"compact", Token::TYPE_COMPACT},
+		{"errorFlag", Token::TYPE_ERROR_FLAG},
+		{"iid", Token::TYPE_IID},
+		{"in", Token::TYPE_IN},
+		{"inout", Token::TYPE_INOUT},
+		{"nothrow", Token::TYPE_NOTHROW},
+		{"out", Token::TYPE_OUT},
+		{"packed", Token::TYPE_PACKED},
+		{"recorder", Token::TYPE_RECORDER},
+		{"refcounted", Token::TYPE_REFCOUNTED},
+		{"reflection", Token::TYPE_REFLECTION},
+		{"replay", Token::TYPE_REPLAY},
+		{"rpc", Token::TYPE_RPC},
+		{"shared", Token::TYPE_SHARED},
+		{"trace", Token::TYPE_TRACE},
+		{"transfer", Token::TYPE_TRANSFER}
+	};
+
+	lexer->getToken(token);
+
+	if (token.type == Token::TYPE_IDENTIFIER)
+	{
+		for (unsigned i = 0; i < sizeof(attributes) / sizeof(attributes[0]); ++i)
+		{
+			if (token.text == attributes[i].text)
+			{
+				token.type = attributes[i].type;
+				break;
+			}
+		}
+	}
+
+	return token;
+}
+
 TypeRef Parser::parseTypeRef()
 {
 	TypeRef typeRef;
@@ -394,14 +1284,24 @@ TypeRef Parser::parseTypeRef()
 		lexer->getToken(typeRef.token);
 	}
 
+	if (typeRef.token.type == Token::TYPE_IDENTIFIER)
+	{
+		if (typeRef.token.text == "strview")
+			typeRef.token.type = Token::TYPE_STRVIEW;
+		else if (typeRef.token.text == "bytes")
+			typeRef.token.type = Token::TYPE_BYTES;
+	}
+
 	switch (typeRef.token.type)
 	{
 		case Token::TYPE_VOID:
 		case Token::TYPE_BOOLEAN:
+		case Token::TYPE_BYTES:
 		case Token::TYPE_INT:
 		case Token::TYPE_INT64:
 		case Token::TYPE_INTPTR:
 		case Token::TYPE_STRING:
+		case Token::TYPE_STRVIEW:
 		case Token::TYPE_UCHAR:
 		case Token::TYPE_UINT:
 		case Token::TYPE_UINT64:
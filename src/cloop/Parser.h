@@ -63,6 +63,7 @@ public:
 	TypeRef()
 		: isConst(false),
 		  isPointer(false),
+		  isArray(false),
 		  type(BaseType::TYPE_INTERFACE)
 	{
 	}
@@ -70,12 +71,39 @@ public:
 	Token token;
 	bool isConst;
 	bool isPointer;
+	bool isArray;	// pointer to the elements counted by another parameter
 	BaseType::Type type;
 };
 
 
 class Parameter
 {
+public:
+	enum Direction
+	{
+		DIRECTION_IN,
+		DIRECTION_OUT,
+		DIRECTION_INOUT
+	};
+
+	Parameter()
+		: direction(DIRECTION_IN),
+		  borrowed(false),
+		  transfer(false)
+	{
+	}
+
+	std::string name;
+	TypeRef typeRef;
+	std::string countName;	// array: parameter with the number of elements
+	Direction direction;	// of the data pointed to: read, written or both by the callee
+	bool borrowed;	// used by the callee only during the call, never kept
+	bool transfer;	// interface: the caller's reference is handed to the callee
+};
+
+
+class Field
+{
 public:
 	std::string name;
 	TypeRef typeRef;
@@ -96,8 +124,11 @@ class Method
 public:
 	Method()
 		: notImplementedExpr(NULL),
+		  scalarMethod(NULL),
+		  syncMethod(NULL),
 		  version(0),
-		  isConst(false)
+		  isConst(false),
+		  noThrow(false)
 	{
 	}
 
@@ -105,8 +136,11 @@ public:
 	TypeRef returnTypeRef;
 	std::vector<Parameter*> parameters;
 	Expr* notImplementedExpr;
+	Method* scalarMethod;	// method applied to each element by a [batch] variant
+	Method* syncMethod;	// method started by an [async] variant
 	unsigned version;
 	bool isConst;
+	bool noThrow;	// never fails: no status clearing, checking or exception catching
 	std::string onErrorFunction;
 };
 
@@ -117,7 +151,16 @@ public:
 	Interface()
 		: BaseType(TYPE_INTERFACE),
 		  super(NULL),
-		  version(1)
+		  version(1),
+		  compact(false),
+		  errorFlag(false),
+		  refCounted(false),
+		  rpc(false),
+		  actor(false),
+		  shared(false),
+		  recorder(false),
+		  hasIid(false),
+		  iid(0)
 	{
 	}
 
@@ -126,6 +169,15 @@ public:
 	std::vector<Constant*> constants;
 	std::vector<Method*> methods;
 	unsigned version;
+	bool compact;	// layout without the cloopDummy slots
+	bool errorFlag;	// error state word after the vtable pointer
+	bool refCounted;	// lifetime managed by addRef/release
+	bool rpc;	// has RPC stubs, carrying the calls to another process
+	bool actor;	// has actor proxies, running the calls on the thread of a mailbox
+	bool shared;	// read by several threads, disposed by epoch-based reclamation
+	bool recorder;	// has recorders, filling command buffers executed in one call
+	bool hasIid;
+	unsigned iid;	// 32-bit id found by queryInterface
 };
 
 
@@ -133,9 +185,18 @@ class Struct : public BaseType
 {
 public:
 	Struct()
-		: BaseType(TYPE_STRUCT)
+		: BaseType(TYPE_STRUCT),
+		  defined(false),
+		  packed(false),
+		  alignment(0)
 	{
 	}
+
+public:
+	std::vector<Field*> fields;
+	bool defined;	// has a body, generated with its layout; opaque otherwise
+	bool packed;	// fields without padding
+	unsigned alignment;	// minimum alignment, 0 for the natural one
 };
 
 
@@ -155,12 +216,16 @@ public:
 	Parser(Lexer* lexer);
 
 	void parse();
-	void parseInterface(bool exception);
-	void parseStruct();
+	void parseInterface(bool exception, bool compact, bool errorFlag, bool refCounted, bool rpc,
+		bool actor, bool shared, bool recorder, const Token* iidToken);
+	void parseStruct(bool packed, const Token* alignToken);
 	void parseTypedef();
 	void parseItem();
 	void parseConstant(const TypeRef& typeRef, const std::string& name);
-	void parseMethod(const TypeRef& returnTypeRef, const std::string& name, Expr* notImplementedExpr, const std::string& onErrorFunction);
+	void parseMethod(const TypeRef& returnTypeRef, const std::string& name, Expr* notImplementedExpr, const std::string& onErrorFunction, bool noThrow, bool batch, bool async);
+	Method* findBatchedMethod(const Token& nameToken);
+	void addBatchMethod(Method* method);
+	void addAsyncMethod(Method* method);
 
 	Expr* parseExpr();
 	Expr* parseLogicalExpr();
@@ -169,8 +234,17 @@ public:
 
 private:
 	void checkType(TypeRef& typeRef);
+	void checkField(Struct* ztruct, Field* field);
+	void parseArray(Parameter* parameter);
+	void checkArrays(Method* method);
+	void setDirection(Parameter* parameter, const Token* directionToken);
+	void checkOwnership(Parameter* parameter);
+	void checkRpc(Interface* interface, Method* method, Parameter* parameter);
+	bool isCarried(const TypeRef& typeRef);
+	bool isPlain(Struct* ztruct);
 
 	Token& getToken(Token& token, Token::Type expected, bool allowEof = false);
+	Token& getAttributeToken(Token& token);
 
 	TypeRef parseTypeRef();
 
@@ -179,13 +253,19 @@ private:
 
 public:
 	std::vector<Interface*> interfaces;
+	std::vector<Struct*> structs;
 	std::map<std::string, BaseType*> typesByName;
 	Interface* exceptionInterface;
+	bool reflection;	// set for the whole IDL: reflection tables are generated
+	bool replay;	// set for the whole IDL: recording proxies and replayCalls are generated
+	bool trace;	// set for the whole IDL: the trace ring is generated
 
 private:
 	Lexer* lexer;
 	Token token;
 	Interface* interface;
+	bool compact;	// default of the interfaces, set for the whole IDL
+	std::vector<Interface*> completionInterfaces;	// added after the parsed ones
 };
 
 
@@ -0,0 +1,222 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by Adriano dos Santos Fernandes.
+ *
+ *  Copyright (c) 2014 Adriano dos Santos Fernandes <adrianosf at gmail.com>
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+// cloop-trace: decodes the rings dumped by TraceRing::dump, one per thread, into per-method
+// latency percentiles and the calls made from each method, naming them with the interfaces of
+// the IDL.
+
+#include "Lexer.h"
+#include "Parser.h"
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include <stdint.h>
+#include <stdio.h>
+
+using std::cerr;
+using std::deque;
+using std::endl;
+using std::exception;
+using std::make_pair;
+using std::map;
+using std::pair;
+using std::string;
+using std::runtime_error;
+using std::vector;
+
+
+//--------------------------------------
+
+
+// Same layout as the generated TraceRecord.
+struct TraceRecord
+{
+	uint64_t timestamp;
+	uint64_t duration;
+	uint16_t interfaceIndex;
+	uint16_t slot;
+	uint16_t depth;
+	uint16_t failed;
+};
+
+static const uint32_t TRACE_MAGIC = 0x504F4F4Cu;
+static const uint32_t TRACE_VERSION = 1;
+
+struct MethodStats
+{
+	MethodStats()
+		: errors(0)
+	{
+	}
+
+	vector<uint64_t> durations;
+	unsigned errors;
+};
+
+static bool compareStart(const TraceRecord& a, const TraceRecord& b)
+{
+	return a.timestamp < b.timestamp || (a.timestamp == b.timestamp && a.depth < b.depth);
+}
+
+static vector<TraceRecord> readRecords(const string& filename)
+{
+	FILE* in = fopen(filename.c_str(), "rb");
+
+	if (!in)
+		throw runtime_error("Cannot open " + filename + ".");
+
+	uint32_t header[4];
+	vector<TraceRecord> records;
+
+	if (fread(header, sizeof(header), 1, in) != 1 ||
+		header[0] != TRACE_MAGIC || header[1] != TRACE_VERSION || header[2] != sizeof(TraceRecord))
+	{
+		fclose(in);
+		throw runtime_error(filename + " is not a trace dumped by TraceRing.");
+	}
+
+	records.resize(header[3]);
+
+	if (!records.empty() && fread(&records[0], sizeof(TraceRecord), records.size(), in) != records.size())
+	{
+		fclose(in);
+		throw runtime_error(filename + " is truncated.");
+	}
+
+	fclose(in);
+
+	return records;
+}
+
+static string methodName(Parser* parser, const TraceRecord& record)
+{
+	if (record.interfaceIndex >= parser->interfaces.size())
+		throw runtime_error("Trace does not match the IDL.");
+
+	Interface* interface = parser->interfaces[record.interfaceIndex];
+	deque<Method*> methods;
+
+	for (Interface* p = interface; p; p = p->super)
+		methods.insert(methods.begin(), p->methods.begin(), p->methods.end());
+
+	if (record.slot >= methods.size())
+		throw runtime_error("Trace does not match the IDL.");
+
+	return interface->name + "::" + methods[record.slot]->name;
+}
+
+// Nearest-rank percentile of sorted durations.
+static uint64_t percentile(const vector<uint64_t>& durations, unsigned p)
+{
+	size_t rank = (durations.size() * p + 99) / 100;
+	return durations[rank ? rank - 1 : 0];
+}
+
+static void run(int argc, const char* argv[])
+{
+	if (argc < 3)
+		throw runtime_error("Invalid command line parameters.");
+
+	Lexer lexer(argv[1]);
+
+	Parser parser(&lexer);
+	parser.parse();
+
+	map<string, MethodStats> stats;
+	map<pair<string, string>, unsigned> calls;
+
+	for (int ring = 2; ring < argc; ++ring)
+	{
+		vector<TraceRecord> records = readRecords(argv[ring]);
+
+		// Records are written when calls return, so they are replayed in the order calls started
+		// to find the caller of each one. Each ring has the calls of a single thread.
+		std::sort(records.begin(), records.end(), compareStart);
+
+		vector<pair<unsigned, string> > stack;
+
+		for (vector<TraceRecord>::iterator i = records.begin(); i != records.end(); ++i)
+		{
+			string name = methodName(&parser, *i);
+			MethodStats& methodStats = stats[name];
+
+			methodStats.durations.push_back(i->duration);
+
+			if (i->failed)
+				++methodStats.errors;
+
+			while (!stack.empty() && stack.back().first >= i->depth)
+				stack.pop_back();
+
+			string caller = !stack.empty() && stack.back().first + 1 == i->depth ?
+				stack.back().second : "(root)";
+			++calls[make_pair(caller, name)];
+
+			stack.push_back(make_pair((unsigned) i->depth, name));
+		}
+	}
+
+	printf("%-40s %8s %8s %10s %10s %10s %10s\n",
+		"method", "calls", "errors", "p50 ns", "p90 ns", "p99 ns", "max ns");
+
+	for (map<string, MethodStats>::iterator i = stats.begin(); i != stats.end(); ++i)
+	{
+		vector<uint64_t>& durations = i->second.durations;
+		std::sort(durations.begin(), durations.end());
+
+		printf("%-40s %8u %8u %10llu %10llu %10llu %10llu\n",
+			i->first.c_str(),
+			(unsigned) durations.size(),
+			i->second.errors,
+			(unsigned long long) percentile(durations, 50),
+			(unsigned long long) percentile(durations, 90),
+			(unsigned long long) percentile(durations, 99),
+			(unsigned long long) durations.back());
+	}
+
+	printf("\n");
+	printf("%-40s %-40s %8s\n", "caller", "callee", "calls");
+
+	for (map<pair<string, string>, unsigned>::iterator i = calls.begin(); i != calls.end(); ++i)
+	{
+		printf("%-40s %-40s %8u\n",
+			i->first.first.c_str(), i->first.second.c_str(), i->second);
+	}
+}
+
+
+int main(int argc, const char* argv[])
+{
+	try
+	{
+		run(argc, argv);
+		return 0;
+	}
+	catch (exception& e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+}
@@ -20,6 +20,7 @@
  */
 
 #include "CalcCApi.h"
+#include <assert.h>
 #include <malloc.h>
 #include <stdio.h>
 
@@ -41,6 +42,7 @@ struct CALC_IStatusImpl
 {
 	void* cloopDummy;
 	struct CALC_IStatusVTable* vtable;
+	int cloopErrorFlag;
 	int code;
 };
 
@@ -57,6 +59,7 @@ static int CALC_IStatusImpl_getCode(const struct CALC_IStatus* self)
 static void CALC_IStatusImpl_setCode(struct CALC_IStatus* self, int code)
 {
 	((struct CALC_IStatusImpl*) self)->code = code;
+	((struct CALC_IStatusImpl*) self)->cloopErrorFlag = code != 0;
 }
 
 struct CALC_IStatus* CALC_IStatusImpl_create()
@@ -71,6 +74,7 @@ struct CALC_IStatus* CALC_IStatusImpl_create()
 
 	struct CALC_IStatusImpl* impl = malloc(sizeof(struct CALC_IStatusImpl));
 	impl->vtable = &vtable;
+	impl->cloopErrorFlag = 0;
 	impl->code = 0;
 
 	return (struct CALC_IStatus*) impl;
@@ -193,6 +197,15 @@ static int CALC_ICalculator2Impl_multiply(const struct CALC_ICalculator2* self,
 	return n1 * n2;
 }
 
+static void CALC_ICalculator2Impl_multiplyBatch(const struct CALC_ICalculator2* self,
+	struct CALC_IStatus* status, const int* n1, const int* n2, int* results, unsigned count)
+{
+	unsigned i;
+
+	for (i = 0; i < count; ++i)
+		results[i] = n1[i] * n2[i];
+}
+
 static void CALC_ICalculator2Impl_copyMemory(struct CALC_ICalculator2* self,
 	const struct CALC_ICalculator* calculator)
 {
@@ -216,7 +229,8 @@ struct CALC_ICalculator2* CALC_ICalculator2Impl_create()
 		CALC_ICalculator2Impl_sumAndStore,
 		CALC_ICalculator2Impl_multiply,
 		CALC_ICalculator2Impl_copyMemory,
-		CALC_ICalculator2Impl_copyMemory2
+		CALC_ICalculator2Impl_copyMemory2,
+		CALC_ICalculator2Impl_multiplyBatch
 	};
 
 	struct CALC_ICalculator2Impl* impl = malloc(sizeof(struct CALC_ICalculator2Impl));
@@ -329,6 +343,74 @@ struct CALC_IFactory* CALC_IFactoryImpl_create()
 }
 
 
+//--------------------------------------
+
+// CALC_ICounterImpl
+
+
+struct CALC_ICounterImpl
+{
+	struct CALC_ICounterVTable* vtable;
+	int value;
+};
+
+static void CALC_ICounterImpl_dispose(struct CALC_ICounter* self)
+{
+	free(self);
+}
+
+static int CALC_ICounterImpl_increment(struct CALC_ICounter* self)
+{
+	return ++((struct CALC_ICounterImpl*) self)->value;
+}
+
+static int CALC_ICounterImpl_getValue(const struct CALC_ICounter* self)
+{
+	return ((struct CALC_ICounterImpl*) self)->value;
+}
+
+static void CALC_ICounterImpl_add(struct CALC_ICounter* self, const struct CALC_ICounter* counter)
+{
+	((struct CALC_ICounterImpl*) self)->value += CALC_ICounter_getValue(counter);
+}
+
+struct CALC_ICounter* CALC_ICounterImpl_create()
+{
+	static struct CALC_ICounterVTable vtable = {
+		CALC_ICounter_VERSION,
+		CALC_ICounterImpl_dispose,
+		CALC_ICounterImpl_increment,
+		CALC_ICounterImpl_getValue,
+		CALC_ICounterImpl_add
+	};
+
+	struct CALC_ICounterImpl* impl = malloc(sizeof(struct CALC_ICounterImpl));
+	impl->vtable = &vtable;
+	impl->value = 0;
+
+	return (struct CALC_ICounter*) impl;
+}
+
+
+//--------------------------------------
+
+// Tap hooks
+
+
+// Counts the calls and skips sum and setMemory.
+static int tapPre(void* context, const void* self, unsigned interfaceIndex, unsigned slot)
+{
+	++*(int*) context;
+	return slot == 1 || slot == 3;
+}
+
+// Reports the skipped calls as errors.
+static void tapFail(void* context, void* status, unsigned interfaceIndex, unsigned slot)
+{
+	CALC_IStatus_setCode((struct CALC_IStatus*) status, CALC_IStatus_ERROR_1);
+}
+
+
 //--------------------------------------
 
 // Library entry point
@@ -349,7 +431,16 @@ static void test(struct CALC_IFactory* (*createFactory)())
 	struct CALC_IStatus* status = (struct CALC_IStatus*) CALC_IStatusImpl_create();
 	struct CALC_ICalculator* calculator;
 	struct CALC_ICalculator2* calculator2;
+	struct CALC_ICounter* counter;
+	struct CALC_ICounter* counter2;
 	int sum, code, address;
+	int n1[] = {2, 3, 4}, n2[] = {5, 6, 7}, results[3];
+	const struct cloopMethodInfo* multiply;
+	struct CALC_ICalculatorTap tap;
+	struct cloopTapHooks hooks = {tapPre, 0, tapFail, 0};
+	int tapCalls = 0;
+	uint64_t cells[12];
+	unsigned executed;
 
 	calculator = CALC_IFactory_createCalculator(factory, status);
 
@@ -384,6 +475,9 @@ static void test(struct CALC_IFactory* (*createFactory)())
 	CALC_ICalculator2_setMemory(calculator2, CALC_ICalculator2_multiply(calculator2, status, 2, 33));
 	printf("%d\n", CALC_ICalculator2_getMemory(calculator2));	// 66
 
+	CALC_ICalculator2_multiplyBatch(calculator2, status, n1, n2, results, 3);
+	printf("%d %d %d\n", results[0], results[1], results[2]);	// 10 18 28
+
 	CALC_ICalculator_dispose(calculator);
 
 	calculator = CALC_IFactory_createBrokenCalculator(factory, status);
@@ -401,11 +495,67 @@ static void test(struct CALC_IFactory* (*createFactory)())
 	else
 		printf("%d\n", sum);
 
+	hooks.context = &tapCalls;
+	CALC_ICalculatorTap_install(&tap, calculator, &hooks);
+	CALC_ICalculator_setMemory(calculator, 5);
+	sum = CALC_ICalculator_getMemory(calculator);
+	printf("%d %d\n", sum, tapCalls);	// 36 2
+	assert(sum == 36 && tapCalls == 2);
+	CALC_IStatus_setCode(status, 0);
+	sum = CALC_ICalculator_sum(calculator, status, 2, 3);
+	printf("%d %d\n", sum, CALC_IStatus_getCode(status));	// 0 1
+	assert(sum == 0 && CALC_IStatus_getCode(status) == CALC_IStatus_ERROR_1);
+	CALC_ICalculatorTap_remove(&tap, calculator);
+
+	// A newer object is tapped as the interface the tap forwards.
+	calculator2 = CALC_IFactory_createCalculator2(factory, status);
+	CALC_ICalculatorTap_install(&tap, (struct CALC_ICalculator*) calculator2, &hooks);
+	assert(tap.vtable.version == CALC_ICalculator_VERSION);
+	CALC_ICalculatorTap_remove(&tap, (struct CALC_ICalculator*) calculator2);
+	CALC_ICalculator2_dispose(calculator2);
+
+	// Commands executed in one call, up to the failing sum.
+	CALC_IStatus_setCode(status, 0);
+	cells[0] = CALC_ICalculator_sumAndStore_COMMAND;
+	cells[1] = (uintptr_t) calculator;
+	cells[2] = 1;
+	cells[3] = 2;
+	cells[4] = CALC_ICalculator_sum_COMMAND;
+	cells[5] = (uintptr_t) calculator;
+	cells[6] = 600;
+	cells[7] = 600;
+	cells[8] = 0;
+	cells[9] = CALC_ICalculator_getMemory_COMMAND;
+	cells[10] = (uintptr_t) calculator;
+	cells[11] = 0;
+	executed = CALC_ICommands_execute(status, cells, 12);
+	printf("%u %d %d\n", executed, CALC_ICalculator_getMemory(calculator),
+		CALC_IStatus_getCode(status));	// 1 4 1
+	assert(executed == 1 && CALC_ICalculator_getMemory(calculator) == 4 &&
+		CALC_IStatus_getCode(status) == CALC_IStatus_ERROR_1);
+
 	CALC_ICalculator_dispose(calculator);
 
 	CALC_IStatus_dispose(status);
 	CALC_IFactory_dispose(factory);
 
+	counter = CALC_ICounterImpl_create();
+	counter2 = CALC_ICounterImpl_create();
+
+	CALC_ICounter_increment(counter);
+	CALC_ICounter_increment(counter2);
+	CALC_ICounter_increment(counter2);
+	CALC_ICounter_add(counter, counter2);
+	printf("%d %d\n", CALC_ICounter_getValue(counter),
+		(int) sizeof(struct CALC_ICounter) == (int) sizeof(void*));	// 3 1
+
+	CALC_ICounter_dispose(counter2);
+	CALC_ICounter_dispose(counter);
+
+	multiply = &CALC_ICalculator2_cloopMethods[5];
+	printf("%s %u %s %d\n", multiply->name, multiply->parameterCount, multiply->parameters[1].type,
+		multiply->mayThrow);	// multiply 3 int 1
+
 	printf("\n");
 }
 
@@ -3,128 +3,1873 @@
 #include "CalcCApi.h"
 
 
+#ifndef CLOOP_PROBE
+#if defined(__GNUC__) && defined(__ELF__) && defined(__x86_64__)
+#define CLOOP_PROBE(provider, name, interfaceIndex, slot, self) \
+	__asm__ __volatile__ ( \
+		"990: nop\n" \
+		".pushsection .note.stapsdt, \"\", \"note\"\n" \
+		".balign 4\n" \
+		".4byte 992f-991f, 994f-993f, 3\n" \
+		"991: .asciz \"stapsdt\"\n" \
+		"992: .balign 4\n" \
+		"993: .8byte 990b\n" \
+		".8byte _.stapsdt.base\n" \
+		".8byte 0\n" \
+		".asciz \"" #provider "\"\n" \
+		".asciz \"" #name "\"\n" \
+		".asciz \"4@%0 4@%1 8@%2\"\n" \
+		"994: .balign 4\n" \
+		".popsection\n" \
+		".ifndef _.stapsdt.base\n" \
+		".pushsection .stapsdt.base, \"aG\", \"progbits\", .stapsdt.base, comdat\n" \
+		".weak _.stapsdt.base\n" \
+		".hidden _.stapsdt.base\n" \
+		"_.stapsdt.base: .space 1\n" \
+		".size _.stapsdt.base, 1\n" \
+		".popsection\n" \
+		".endif\n" \
+		: : "nor" ((unsigned) (interfaceIndex)), "nor" ((unsigned) (slot)), \
+			"nor" ((const void*) (self)))
+#else
+#define CLOOP_PROBE(provider, name, interfaceIndex, slot, self)
+#endif
+#endif
+
+
 CLOOP_EXTERN_C void CALC_IDisposable_dispose(struct CALC_IDisposable* self)
 {
+	CLOOP_PROBE(calc, enter, 0, 0, self);
 	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 0, 0, self);
+}
+
+static void CALC_IDisposableTap_dispose(struct CALC_IDisposable* self)
+{
+	const struct CALC_IDisposableTap* tap = (const struct CALC_IDisposableTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 0, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 0, 0);
+}
+
+CLOOP_EXTERN_C void CALC_IDisposableTap_install(struct CALC_IDisposableTap* tap, struct CALC_IDisposable* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_IDisposable_VERSION ? self->vtable->version : CALC_IDisposable_VERSION;
+	tap->vtable.dispose = CALC_IDisposableTap_dispose;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_IDisposableTap_remove(struct CALC_IDisposableTap* tap, struct CALC_IDisposable* self)
+{
+	self->vtable = tap->original;
 }
 
 CLOOP_EXTERN_C void CALC_IStatus_dispose(struct CALC_IStatus* self)
 {
+	CLOOP_PROBE(calc, enter, 0, 0, self);
 	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 0, 0, self);
 }
 
 CLOOP_EXTERN_C int CALC_IStatus_getCode(const struct CALC_IStatus* self)
 {
-	return self->vtable->getCode(self);
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 1, 1, self);
+	ret = self->vtable->getCode(self);
+	CLOOP_PROBE(calc, exit, 1, 1, self);
+	return ret;
 }
 
 CLOOP_EXTERN_C void CALC_IStatus_setCode(struct CALC_IStatus* self, int code)
 {
+	CLOOP_PROBE(calc, enter, 1, 2, self);
 	self->vtable->setCode(self, code);
+	CLOOP_PROBE(calc, exit, 1, 2, self);
+}
+
+static void CALC_IStatusTap_dispose(struct CALC_IStatus* self)
+{
+	const struct CALC_IStatusTap* tap = (const struct CALC_IStatusTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 0, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 0, 0);
+}
+
+static int CALC_IStatusTap_getCode(const struct CALC_IStatus* self)
+{
+	const struct CALC_IStatusTap* tap = (const struct CALC_IStatusTap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 1, 1))
+		ret = tap->original->getCode(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 1, 1);
+
+	return ret;
+}
+
+static void CALC_IStatusTap_setCode(struct CALC_IStatus* self, int code)
+{
+	const struct CALC_IStatusTap* tap = (const struct CALC_IStatusTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 1, 2))
+		tap->original->setCode(self, code);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 1, 2);
+}
+
+CLOOP_EXTERN_C void CALC_IStatusTap_install(struct CALC_IStatusTap* tap, struct CALC_IStatus* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_IStatus_VERSION ? self->vtable->version : CALC_IStatus_VERSION;
+	tap->vtable.dispose = CALC_IStatusTap_dispose;
+	tap->vtable.getCode = CALC_IStatusTap_getCode;
+	tap->vtable.setCode = CALC_IStatusTap_setCode;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_IStatusTap_remove(struct CALC_IStatusTap* tap, struct CALC_IStatus* self)
+{
+	self->vtable = tap->original;
 }
 
 CLOOP_EXTERN_C void CALC_IStatusFactory_dispose(struct CALC_IStatusFactory* self)
 {
+	CLOOP_PROBE(calc, enter, 0, 0, self);
 	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 0, 0, self);
 }
 
 CLOOP_EXTERN_C struct CALC_IStatus* CALC_IStatusFactory_createStatus(struct CALC_IStatusFactory* self)
 {
-	return self->vtable->createStatus(self);
+	struct CALC_IStatus* ret;
+
+	CLOOP_PROBE(calc, enter, 2, 1, self);
+	ret = self->vtable->createStatus(self);
+	CLOOP_PROBE(calc, exit, 2, 1, self);
+	return ret;
+}
+
+static void CALC_IStatusFactoryTap_dispose(struct CALC_IStatusFactory* self)
+{
+	const struct CALC_IStatusFactoryTap* tap = (const struct CALC_IStatusFactoryTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 0, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 0, 0);
+}
+
+static struct CALC_IStatus* CALC_IStatusFactoryTap_createStatus(struct CALC_IStatusFactory* self)
+{
+	const struct CALC_IStatusFactoryTap* tap = (const struct CALC_IStatusFactoryTap*) self->vtable;
+	struct CALC_IStatus* ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 2, 1))
+		ret = tap->original->createStatus(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 2, 1);
+
+	return ret;
+}
+
+CLOOP_EXTERN_C void CALC_IStatusFactoryTap_install(struct CALC_IStatusFactoryTap* tap, struct CALC_IStatusFactory* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_IStatusFactory_VERSION ? self->vtable->version : CALC_IStatusFactory_VERSION;
+	tap->vtable.dispose = CALC_IStatusFactoryTap_dispose;
+	tap->vtable.createStatus = CALC_IStatusFactoryTap_createStatus;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_IStatusFactoryTap_remove(struct CALC_IStatusFactoryTap* tap, struct CALC_IStatusFactory* self)
+{
+	self->vtable = tap->original;
 }
 
 CLOOP_EXTERN_C void CALC_IFactory_dispose(struct CALC_IFactory* self)
 {
+	CLOOP_PROBE(calc, enter, 0, 0, self);
 	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 0, 0, self);
 }
 
 CLOOP_EXTERN_C struct CALC_IStatus* CALC_IFactory_createStatus(struct CALC_IFactory* self)
 {
-	return self->vtable->createStatus(self);
+	struct CALC_IStatus* ret;
+
+	CLOOP_PROBE(calc, enter, 3, 1, self);
+	ret = self->vtable->createStatus(self);
+	CLOOP_PROBE(calc, exit, 3, 1, self);
+	return ret;
 }
 
 CLOOP_EXTERN_C struct CALC_ICalculator* CALC_IFactory_createCalculator(struct CALC_IFactory* self, struct CALC_IStatus* status)
 {
-	return self->vtable->createCalculator(self, status);
+	struct CALC_ICalculator* ret;
+
+	CLOOP_PROBE(calc, enter, 3, 2, self);
+	ret = self->vtable->createCalculator(self, status);
+	CLOOP_PROBE(calc, exit, 3, 2, self);
+	return ret;
 }
 
 CLOOP_EXTERN_C struct CALC_ICalculator2* CALC_IFactory_createCalculator2(struct CALC_IFactory* self, struct CALC_IStatus* status)
 {
-	return self->vtable->createCalculator2(self, status);
+	struct CALC_ICalculator2* ret;
+
+	CLOOP_PROBE(calc, enter, 3, 3, self);
+	ret = self->vtable->createCalculator2(self, status);
+	CLOOP_PROBE(calc, exit, 3, 3, self);
+	return ret;
 }
 
 CLOOP_EXTERN_C struct CALC_ICalculator* CALC_IFactory_createBrokenCalculator(struct CALC_IFactory* self, struct CALC_IStatus* status)
 {
-	return self->vtable->createBrokenCalculator(self, status);
+	struct CALC_ICalculator* ret;
+
+	CLOOP_PROBE(calc, enter, 3, 4, self);
+	ret = self->vtable->createBrokenCalculator(self, status);
+	CLOOP_PROBE(calc, exit, 3, 4, self);
+	return ret;
 }
 
 CLOOP_EXTERN_C void CALC_IFactory_setStatusFactory(struct CALC_IFactory* self, struct CALC_IStatusFactory* statusFactory)
 {
+	CLOOP_PROBE(calc, enter, 3, 5, self);
 	self->vtable->setStatusFactory(self, statusFactory);
+	CLOOP_PROBE(calc, exit, 3, 5, self);
+}
+
+static void CALC_IFactoryTap_dispose(struct CALC_IFactory* self)
+{
+	const struct CALC_IFactoryTap* tap = (const struct CALC_IFactoryTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 0, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 0, 0);
+}
+
+static struct CALC_IStatus* CALC_IFactoryTap_createStatus(struct CALC_IFactory* self)
+{
+	const struct CALC_IFactoryTap* tap = (const struct CALC_IFactoryTap*) self->vtable;
+	struct CALC_IStatus* ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 3, 1))
+		ret = tap->original->createStatus(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 3, 1);
+
+	return ret;
+}
+
+static struct CALC_ICalculator* CALC_IFactoryTap_createCalculator(struct CALC_IFactory* self, struct CALC_IStatus* status)
+{
+	const struct CALC_IFactoryTap* tap = (const struct CALC_IFactoryTap*) self->vtable;
+	struct CALC_ICalculator* ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 3, 2))
+		ret = tap->original->createCalculator(self, status);
+	else if (tap->hooks.fail)
+		tap->hooks.fail(tap->hooks.context, status, 3, 2);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 3, 2);
+
+	return ret;
+}
+
+static struct CALC_ICalculator2* CALC_IFactoryTap_createCalculator2(struct CALC_IFactory* self, struct CALC_IStatus* status)
+{
+	const struct CALC_IFactoryTap* tap = (const struct CALC_IFactoryTap*) self->vtable;
+	struct CALC_ICalculator2* ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 3, 3))
+		ret = tap->original->createCalculator2(self, status);
+	else if (tap->hooks.fail)
+		tap->hooks.fail(tap->hooks.context, status, 3, 3);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 3, 3);
+
+	return ret;
+}
+
+static struct CALC_ICalculator* CALC_IFactoryTap_createBrokenCalculator(struct CALC_IFactory* self, struct CALC_IStatus* status)
+{
+	const struct CALC_IFactoryTap* tap = (const struct CALC_IFactoryTap*) self->vtable;
+	struct CALC_ICalculator* ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 3, 4))
+		ret = tap->original->createBrokenCalculator(self, status);
+	else if (tap->hooks.fail)
+		tap->hooks.fail(tap->hooks.context, status, 3, 4);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 3, 4);
+
+	return ret;
+}
+
+static void CALC_IFactoryTap_setStatusFactory(struct CALC_IFactory* self, struct CALC_IStatusFactory* statusFactory)
+{
+	const struct CALC_IFactoryTap* tap = (const struct CALC_IFactoryTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 3, 5))
+		tap->original->setStatusFactory(self, statusFactory);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 3, 5);
+}
+
+CLOOP_EXTERN_C void CALC_IFactoryTap_install(struct CALC_IFactoryTap* tap, struct CALC_IFactory* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_IFactory_VERSION ? self->vtable->version : CALC_IFactory_VERSION;
+	tap->vtable.dispose = CALC_IFactoryTap_dispose;
+	tap->vtable.createStatus = CALC_IFactoryTap_createStatus;
+	tap->vtable.createCalculator = CALC_IFactoryTap_createCalculator;
+	tap->vtable.createCalculator2 = CALC_IFactoryTap_createCalculator2;
+	tap->vtable.createBrokenCalculator = CALC_IFactoryTap_createBrokenCalculator;
+	tap->vtable.setStatusFactory = CALC_IFactoryTap_setStatusFactory;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_IFactoryTap_remove(struct CALC_IFactoryTap* tap, struct CALC_IFactory* self)
+{
+	self->vtable = tap->original;
 }
 
 CLOOP_EXTERN_C void CALC_ICalculator_dispose(struct CALC_ICalculator* self)
 {
+	CLOOP_PROBE(calc, enter, 0, 0, self);
 	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 0, 0, self);
 }
 
 CLOOP_EXTERN_C int CALC_ICalculator_sum(const struct CALC_ICalculator* self, struct CALC_IStatus* status, int n1, int n2)
 {
-	return self->vtable->sum(self, status, n1, n2);
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 4, 1, self);
+	ret = self->vtable->sum(self, status, n1, n2);
+	CLOOP_PROBE(calc, exit, 4, 1, self);
+	return ret;
 }
 
 CLOOP_EXTERN_C int CALC_ICalculator_getMemory(const struct CALC_ICalculator* self)
 {
-	return self->vtable->getMemory(self);
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 4, 2, self);
+	ret = self->vtable->getMemory(self);
+	CLOOP_PROBE(calc, exit, 4, 2, self);
+	return ret;
 }
 
 CLOOP_EXTERN_C void CALC_ICalculator_setMemory(struct CALC_ICalculator* self, int n)
 {
+	CLOOP_PROBE(calc, enter, 4, 3, self);
 	self->vtable->setMemory(self, n);
+	CLOOP_PROBE(calc, exit, 4, 3, self);
 }
 
 CLOOP_EXTERN_C void CALC_ICalculator_sumAndStore(struct CALC_ICalculator* self, struct CALC_IStatus* status, int n1, int n2)
 {
+	CLOOP_PROBE(calc, enter, 4, 4, self);
 	self->vtable->sumAndStore(self, status, n1, n2);
+	CLOOP_PROBE(calc, exit, 4, 4, self);
+}
+
+static void CALC_ICalculatorTap_dispose(struct CALC_ICalculator* self)
+{
+	const struct CALC_ICalculatorTap* tap = (const struct CALC_ICalculatorTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 0, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 0, 0);
+}
+
+static int CALC_ICalculatorTap_sum(const struct CALC_ICalculator* self, struct CALC_IStatus* status, int n1, int n2)
+{
+	const struct CALC_ICalculatorTap* tap = (const struct CALC_ICalculatorTap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 4, 1))
+		ret = tap->original->sum(self, status, n1, n2);
+	else if (tap->hooks.fail)
+		tap->hooks.fail(tap->hooks.context, status, 4, 1);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 4, 1);
+
+	return ret;
+}
+
+static int CALC_ICalculatorTap_getMemory(const struct CALC_ICalculator* self)
+{
+	const struct CALC_ICalculatorTap* tap = (const struct CALC_ICalculatorTap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 4, 2))
+		ret = tap->original->getMemory(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 4, 2);
+
+	return ret;
+}
+
+static void CALC_ICalculatorTap_setMemory(struct CALC_ICalculator* self, int n)
+{
+	const struct CALC_ICalculatorTap* tap = (const struct CALC_ICalculatorTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 4, 3))
+		tap->original->setMemory(self, n);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 4, 3);
+}
+
+static void CALC_ICalculatorTap_sumAndStore(struct CALC_ICalculator* self, struct CALC_IStatus* status, int n1, int n2)
+{
+	const struct CALC_ICalculatorTap* tap = (const struct CALC_ICalculatorTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 4, 4))
+		tap->original->sumAndStore(self, status, n1, n2);
+	else if (tap->hooks.fail)
+		tap->hooks.fail(tap->hooks.context, status, 4, 4);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 4, 4);
+}
+
+CLOOP_EXTERN_C void CALC_ICalculatorTap_install(struct CALC_ICalculatorTap* tap, struct CALC_ICalculator* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_ICalculator_VERSION ? self->vtable->version : CALC_ICalculator_VERSION;
+	tap->vtable.dispose = CALC_ICalculatorTap_dispose;
+	tap->vtable.sum = CALC_ICalculatorTap_sum;
+	tap->vtable.getMemory = CALC_ICalculatorTap_getMemory;
+	tap->vtable.setMemory = CALC_ICalculatorTap_setMemory;
+	tap->vtable.sumAndStore = CALC_ICalculatorTap_sumAndStore;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_ICalculatorTap_remove(struct CALC_ICalculatorTap* tap, struct CALC_ICalculator* self)
+{
+	self->vtable = tap->original;
 }
 
 CLOOP_EXTERN_C void CALC_ICalculator2_dispose(struct CALC_ICalculator2* self)
 {
+	CLOOP_PROBE(calc, enter, 0, 0, self);
 	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 0, 0, self);
 }
 
 CLOOP_EXTERN_C int CALC_ICalculator2_sum(const struct CALC_ICalculator2* self, struct CALC_IStatus* status, int n1, int n2)
 {
-	return self->vtable->sum(self, status, n1, n2);
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 4, 1, self);
+	ret = self->vtable->sum(self, status, n1, n2);
+	CLOOP_PROBE(calc, exit, 4, 1, self);
+	return ret;
 }
 
 CLOOP_EXTERN_C int CALC_ICalculator2_getMemory(const struct CALC_ICalculator2* self)
 {
-	return self->vtable->getMemory(self);
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 4, 2, self);
+	ret = self->vtable->getMemory(self);
+	CLOOP_PROBE(calc, exit, 4, 2, self);
+	return ret;
 }
 
 CLOOP_EXTERN_C void CALC_ICalculator2_setMemory(struct CALC_ICalculator2* self, int n)
 {
+	CLOOP_PROBE(calc, enter, 4, 3, self);
 	self->vtable->setMemory(self, n);
+	CLOOP_PROBE(calc, exit, 4, 3, self);
 }
 
 CLOOP_EXTERN_C void CALC_ICalculator2_sumAndStore(struct CALC_ICalculator2* self, struct CALC_IStatus* status, int n1, int n2)
 {
+	CLOOP_PROBE(calc, enter, 4, 4, self);
 	self->vtable->sumAndStore(self, status, n1, n2);
+	CLOOP_PROBE(calc, exit, 4, 4, self);
 }
 
 CLOOP_EXTERN_C int CALC_ICalculator2_multiply(const struct CALC_ICalculator2* self, struct CALC_IStatus* status, int n1, int n2)
 {
-	return self->vtable->multiply(self, status, n1, n2);
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 5, 5, self);
+	ret = self->vtable->multiply(self, status, n1, n2);
+	CLOOP_PROBE(calc, exit, 5, 5, self);
+	return ret;
 }
 
 CLOOP_EXTERN_C void CALC_ICalculator2_copyMemory(struct CALC_ICalculator2* self, const struct CALC_ICalculator* calculator)
 {
+	CLOOP_PROBE(calc, enter, 5, 6, self);
 	self->vtable->copyMemory(self, calculator);
+	CLOOP_PROBE(calc, exit, 5, 6, self);
 }
 
 CLOOP_EXTERN_C void CALC_ICalculator2_copyMemory2(struct CALC_ICalculator2* self, const int* address)
 {
+	CLOOP_PROBE(calc, enter, 5, 7, self);
 	self->vtable->copyMemory2(self, address);
+	CLOOP_PROBE(calc, exit, 5, 7, self);
+}
+
+CLOOP_EXTERN_C void CALC_ICalculator2_multiplyBatch(const struct CALC_ICalculator2* self, struct CALC_IStatus* status, const int* n1, const int* n2, int* results, unsigned count)
+{
+	CLOOP_PROBE(calc, enter, 5, 8, self);
+	self->vtable->multiplyBatch(self, status, n1, n2, results, count);
+	CLOOP_PROBE(calc, exit, 5, 8, self);
+}
+
+static void CALC_ICalculator2Tap_dispose(struct CALC_ICalculator2* self)
+{
+	const struct CALC_ICalculator2Tap* tap = (const struct CALC_ICalculator2Tap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 0, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 0, 0);
+}
+
+static int CALC_ICalculator2Tap_sum(const struct CALC_ICalculator2* self, struct CALC_IStatus* status, int n1, int n2)
+{
+	const struct CALC_ICalculator2Tap* tap = (const struct CALC_ICalculator2Tap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 4, 1))
+		ret = tap->original->sum(self, status, n1, n2);
+	else if (tap->hooks.fail)
+		tap->hooks.fail(tap->hooks.context, status, 4, 1);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 4, 1);
+
+	return ret;
+}
+
+static int CALC_ICalculator2Tap_getMemory(const struct CALC_ICalculator2* self)
+{
+	const struct CALC_ICalculator2Tap* tap = (const struct CALC_ICalculator2Tap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 4, 2))
+		ret = tap->original->getMemory(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 4, 2);
+
+	return ret;
+}
+
+static void CALC_ICalculator2Tap_setMemory(struct CALC_ICalculator2* self, int n)
+{
+	const struct CALC_ICalculator2Tap* tap = (const struct CALC_ICalculator2Tap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 4, 3))
+		tap->original->setMemory(self, n);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 4, 3);
+}
+
+static void CALC_ICalculator2Tap_sumAndStore(struct CALC_ICalculator2* self, struct CALC_IStatus* status, int n1, int n2)
+{
+	const struct CALC_ICalculator2Tap* tap = (const struct CALC_ICalculator2Tap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 4, 4))
+		tap->original->sumAndStore(self, status, n1, n2);
+	else if (tap->hooks.fail)
+		tap->hooks.fail(tap->hooks.context, status, 4, 4);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 4, 4);
+}
+
+static int CALC_ICalculator2Tap_multiply(const struct CALC_ICalculator2* self, struct CALC_IStatus* status, int n1, int n2)
+{
+	const struct CALC_ICalculator2Tap* tap = (const struct CALC_ICalculator2Tap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 5, 5))
+		ret = tap->original->multiply(self, status, n1, n2);
+	else if (tap->hooks.fail)
+		tap->hooks.fail(tap->hooks.context, status, 5, 5);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 5, 5);
+
+	return ret;
+}
+
+static void CALC_ICalculator2Tap_copyMemory(struct CALC_ICalculator2* self, const struct CALC_ICalculator* calculator)
+{
+	const struct CALC_ICalculator2Tap* tap = (const struct CALC_ICalculator2Tap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 5, 6))
+		tap->original->copyMemory(self, calculator);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 5, 6);
+}
+
+static void CALC_ICalculator2Tap_copyMemory2(struct CALC_ICalculator2* self, const int* address)
+{
+	const struct CALC_ICalculator2Tap* tap = (const struct CALC_ICalculator2Tap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 5, 7))
+		tap->original->copyMemory2(self, address);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 5, 7);
+}
+
+static void CALC_ICalculator2Tap_multiplyBatch(const struct CALC_ICalculator2* self, struct CALC_IStatus* status, const int* n1, const int* n2, int* results, unsigned count)
+{
+	const struct CALC_ICalculator2Tap* tap = (const struct CALC_ICalculator2Tap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 5, 8))
+		tap->original->multiplyBatch(self, status, n1, n2, results, count);
+	else if (tap->hooks.fail)
+		tap->hooks.fail(tap->hooks.context, status, 5, 8);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 5, 8);
+}
+
+CLOOP_EXTERN_C void CALC_ICalculator2Tap_install(struct CALC_ICalculator2Tap* tap, struct CALC_ICalculator2* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_ICalculator2_VERSION ? self->vtable->version : CALC_ICalculator2_VERSION;
+	tap->vtable.dispose = CALC_ICalculator2Tap_dispose;
+	tap->vtable.sum = CALC_ICalculator2Tap_sum;
+	tap->vtable.getMemory = CALC_ICalculator2Tap_getMemory;
+	tap->vtable.setMemory = CALC_ICalculator2Tap_setMemory;
+	tap->vtable.sumAndStore = CALC_ICalculator2Tap_sumAndStore;
+	tap->vtable.multiply = CALC_ICalculator2Tap_multiply;
+	tap->vtable.copyMemory = CALC_ICalculator2Tap_copyMemory;
+	tap->vtable.copyMemory2 = CALC_ICalculator2Tap_copyMemory2;
+	tap->vtable.multiplyBatch = CALC_ICalculator2Tap_multiplyBatch;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_ICalculator2Tap_remove(struct CALC_ICalculator2Tap* tap, struct CALC_ICalculator2* self)
+{
+	self->vtable = tap->original;
+}
+
+CLOOP_EXTERN_C void CALC_ICounter_dispose(struct CALC_ICounter* self)
+{
+	CLOOP_PROBE(calc, enter, 6, 0, self);
+	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 6, 0, self);
+}
+
+CLOOP_EXTERN_C int CALC_ICounter_increment(struct CALC_ICounter* self)
+{
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 6, 1, self);
+	ret = self->vtable->increment(self);
+	CLOOP_PROBE(calc, exit, 6, 1, self);
+	return ret;
+}
+
+CLOOP_EXTERN_C int CALC_ICounter_getValue(const struct CALC_ICounter* self)
+{
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 6, 2, self);
+	ret = self->vtable->getValue(self);
+	CLOOP_PROBE(calc, exit, 6, 2, self);
+	return ret;
+}
+
+CLOOP_EXTERN_C void CALC_ICounter_add(struct CALC_ICounter* self, const struct CALC_ICounter* counter)
+{
+	CLOOP_PROBE(calc, enter, 6, 3, self);
+	self->vtable->add(self, counter);
+	CLOOP_PROBE(calc, exit, 6, 3, self);
+}
+
+static void CALC_ICounterTap_dispose(struct CALC_ICounter* self)
+{
+	const struct CALC_ICounterTap* tap = (const struct CALC_ICounterTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 6, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 6, 0);
+}
+
+static int CALC_ICounterTap_increment(struct CALC_ICounter* self)
+{
+	const struct CALC_ICounterTap* tap = (const struct CALC_ICounterTap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 6, 1))
+		ret = tap->original->increment(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 6, 1);
+
+	return ret;
+}
+
+static int CALC_ICounterTap_getValue(const struct CALC_ICounter* self)
+{
+	const struct CALC_ICounterTap* tap = (const struct CALC_ICounterTap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 6, 2))
+		ret = tap->original->getValue(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 6, 2);
+
+	return ret;
+}
+
+static void CALC_ICounterTap_add(struct CALC_ICounter* self, const struct CALC_ICounter* counter)
+{
+	const struct CALC_ICounterTap* tap = (const struct CALC_ICounterTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 6, 3))
+		tap->original->add(self, counter);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 6, 3);
+}
+
+CLOOP_EXTERN_C void CALC_ICounterTap_install(struct CALC_ICounterTap* tap, struct CALC_ICounter* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.version = self->vtable->version < CALC_ICounter_VERSION ? self->vtable->version : CALC_ICounter_VERSION;
+	tap->vtable.dispose = CALC_ICounterTap_dispose;
+	tap->vtable.increment = CALC_ICounterTap_increment;
+	tap->vtable.getValue = CALC_ICounterTap_getValue;
+	tap->vtable.add = CALC_ICounterTap_add;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_ICounterTap_remove(struct CALC_ICounterTap* tap, struct CALC_ICounter* self)
+{
+	self->vtable = tap->original;
+}
+
+CLOOP_EXTERN_C void CALC_IReferenceCounted_addRef(struct CALC_IReferenceCounted* self)
+{
+	CLOOP_PROBE(calc, enter, 7, 0, self);
+	self->vtable->addRef(self);
+	CLOOP_PROBE(calc, exit, 7, 0, self);
+}
+
+CLOOP_EXTERN_C int CALC_IReferenceCounted_release(struct CALC_IReferenceCounted* self)
+{
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 7, 1, self);
+	ret = self->vtable->release(self);
+	CLOOP_PROBE(calc, exit, 7, 1, self);
+	return ret;
+}
+
+static void CALC_IReferenceCountedTap_addRef(struct CALC_IReferenceCounted* self)
+{
+	const struct CALC_IReferenceCountedTap* tap = (const struct CALC_IReferenceCountedTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 7, 0))
+		tap->original->addRef(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 7, 0);
 }
 
+static int CALC_IReferenceCountedTap_release(struct CALC_IReferenceCounted* self)
+{
+	const struct CALC_IReferenceCountedTap* tap = (const struct CALC_IReferenceCountedTap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 7, 1))
+		ret = tap->original->release(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 7, 1);
+
+	return ret;
+}
+
+CLOOP_EXTERN_C void CALC_IReferenceCountedTap_install(struct CALC_IReferenceCountedTap* tap, struct CALC_IReferenceCounted* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_IReferenceCounted_VERSION ? self->vtable->version : CALC_IReferenceCounted_VERSION;
+	tap->vtable.addRef = CALC_IReferenceCountedTap_addRef;
+	tap->vtable.release = CALC_IReferenceCountedTap_release;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_IReferenceCountedTap_remove(struct CALC_IReferenceCountedTap* tap, struct CALC_IReferenceCounted* self)
+{
+	self->vtable = tap->original;
+}
+
+CLOOP_EXTERN_C void CALC_IAccumulator_addRef(struct CALC_IAccumulator* self)
+{
+	CLOOP_PROBE(calc, enter, 7, 0, self);
+	self->vtable->addRef(self);
+	CLOOP_PROBE(calc, exit, 7, 0, self);
+}
+
+CLOOP_EXTERN_C int CALC_IAccumulator_release(struct CALC_IAccumulator* self)
+{
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 7, 1, self);
+	ret = self->vtable->release(self);
+	CLOOP_PROBE(calc, exit, 7, 1, self);
+	return ret;
+}
+
+CLOOP_EXTERN_C void CALC_IAccumulator_add(struct CALC_IAccumulator* self, int n)
+{
+	CLOOP_PROBE(calc, enter, 8, 2, self);
+	self->vtable->add(self, n);
+	CLOOP_PROBE(calc, exit, 8, 2, self);
+}
+
+CLOOP_EXTERN_C int CALC_IAccumulator_getTotal(const struct CALC_IAccumulator* self)
+{
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 8, 3, self);
+	ret = self->vtable->getTotal(self);
+	CLOOP_PROBE(calc, exit, 8, 3, self);
+	return ret;
+}
+
+static void CALC_IAccumulatorTap_addRef(struct CALC_IAccumulator* self)
+{
+	const struct CALC_IAccumulatorTap* tap = (const struct CALC_IAccumulatorTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 7, 0))
+		tap->original->addRef(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 7, 0);
+}
+
+static int CALC_IAccumulatorTap_release(struct CALC_IAccumulator* self)
+{
+	const struct CALC_IAccumulatorTap* tap = (const struct CALC_IAccumulatorTap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 7, 1))
+		ret = tap->original->release(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 7, 1);
+
+	return ret;
+}
+
+static void CALC_IAccumulatorTap_add(struct CALC_IAccumulator* self, int n)
+{
+	const struct CALC_IAccumulatorTap* tap = (const struct CALC_IAccumulatorTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 8, 2))
+		tap->original->add(self, n);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 8, 2);
+}
+
+static int CALC_IAccumulatorTap_getTotal(const struct CALC_IAccumulator* self)
+{
+	const struct CALC_IAccumulatorTap* tap = (const struct CALC_IAccumulatorTap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 8, 3))
+		ret = tap->original->getTotal(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 8, 3);
+
+	return ret;
+}
+
+CLOOP_EXTERN_C void CALC_IAccumulatorTap_install(struct CALC_IAccumulatorTap* tap, struct CALC_IAccumulator* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_IAccumulator_VERSION ? self->vtable->version : CALC_IAccumulator_VERSION;
+	tap->vtable.addRef = CALC_IAccumulatorTap_addRef;
+	tap->vtable.release = CALC_IAccumulatorTap_release;
+	tap->vtable.add = CALC_IAccumulatorTap_add;
+	tap->vtable.getTotal = CALC_IAccumulatorTap_getTotal;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_IAccumulatorTap_remove(struct CALC_IAccumulatorTap* tap, struct CALC_IAccumulator* self)
+{
+	self->vtable = tap->original;
+}
+
+CLOOP_EXTERN_C void CALC_IQueryable_dispose(struct CALC_IQueryable* self)
+{
+	CLOOP_PROBE(calc, enter, 0, 0, self);
+	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 0, 0, self);
+}
+
+CLOOP_EXTERN_C struct CALC_IQueryable* CALC_IQueryable_queryInterface(struct CALC_IQueryable* self, unsigned id)
+{
+	struct CALC_IQueryable* ret;
+
+	CLOOP_PROBE(calc, enter, 9, 1, self);
+	ret = self->vtable->queryInterface(self, id);
+	CLOOP_PROBE(calc, exit, 9, 1, self);
+	return ret;
+}
+
+static void CALC_IQueryableTap_dispose(struct CALC_IQueryable* self)
+{
+	const struct CALC_IQueryableTap* tap = (const struct CALC_IQueryableTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 0, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 0, 0);
+}
+
+static struct CALC_IQueryable* CALC_IQueryableTap_queryInterface(struct CALC_IQueryable* self, unsigned id)
+{
+	const struct CALC_IQueryableTap* tap = (const struct CALC_IQueryableTap*) self->vtable;
+	struct CALC_IQueryable* ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 9, 1))
+		ret = tap->original->queryInterface(self, id);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 9, 1);
+
+	return ret;
+}
+
+CLOOP_EXTERN_C void CALC_IQueryableTap_install(struct CALC_IQueryableTap* tap, struct CALC_IQueryable* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_IQueryable_VERSION ? self->vtable->version : CALC_IQueryable_VERSION;
+	tap->vtable.dispose = CALC_IQueryableTap_dispose;
+	tap->vtable.queryInterface = CALC_IQueryableTap_queryInterface;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_IQueryableTap_remove(struct CALC_IQueryableTap* tap, struct CALC_IQueryable* self)
+{
+	self->vtable = tap->original;
+}
+
+CLOOP_EXTERN_C void CALC_IReader_dispose(struct CALC_IReader* self)
+{
+	CLOOP_PROBE(calc, enter, 0, 0, self);
+	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 0, 0, self);
+}
+
+CLOOP_EXTERN_C struct CALC_IQueryable* CALC_IReader_queryInterface(struct CALC_IReader* self, unsigned id)
+{
+	struct CALC_IQueryable* ret;
+
+	CLOOP_PROBE(calc, enter, 9, 1, self);
+	ret = self->vtable->queryInterface(self, id);
+	CLOOP_PROBE(calc, exit, 9, 1, self);
+	return ret;
+}
+
+CLOOP_EXTERN_C int CALC_IReader_read(struct CALC_IReader* self)
+{
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 10, 2, self);
+	ret = self->vtable->read(self);
+	CLOOP_PROBE(calc, exit, 10, 2, self);
+	return ret;
+}
+
+static void CALC_IReaderTap_dispose(struct CALC_IReader* self)
+{
+	const struct CALC_IReaderTap* tap = (const struct CALC_IReaderTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 0, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 0, 0);
+}
+
+static struct CALC_IQueryable* CALC_IReaderTap_queryInterface(struct CALC_IReader* self, unsigned id)
+{
+	const struct CALC_IReaderTap* tap = (const struct CALC_IReaderTap*) self->vtable;
+	struct CALC_IQueryable* ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 9, 1))
+		ret = tap->original->queryInterface(self, id);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 9, 1);
+
+	return ret;
+}
+
+static int CALC_IReaderTap_read(struct CALC_IReader* self)
+{
+	const struct CALC_IReaderTap* tap = (const struct CALC_IReaderTap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 10, 2))
+		ret = tap->original->read(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 10, 2);
+
+	return ret;
+}
+
+CLOOP_EXTERN_C void CALC_IReaderTap_install(struct CALC_IReaderTap* tap, struct CALC_IReader* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_IReader_VERSION ? self->vtable->version : CALC_IReader_VERSION;
+	tap->vtable.dispose = CALC_IReaderTap_dispose;
+	tap->vtable.queryInterface = CALC_IReaderTap_queryInterface;
+	tap->vtable.read = CALC_IReaderTap_read;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_IReaderTap_remove(struct CALC_IReaderTap* tap, struct CALC_IReader* self)
+{
+	self->vtable = tap->original;
+}
+
+CLOOP_EXTERN_C void CALC_IWriter_dispose(struct CALC_IWriter* self)
+{
+	CLOOP_PROBE(calc, enter, 0, 0, self);
+	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 0, 0, self);
+}
+
+CLOOP_EXTERN_C struct CALC_IQueryable* CALC_IWriter_queryInterface(struct CALC_IWriter* self, unsigned id)
+{
+	struct CALC_IQueryable* ret;
+
+	CLOOP_PROBE(calc, enter, 9, 1, self);
+	ret = self->vtable->queryInterface(self, id);
+	CLOOP_PROBE(calc, exit, 9, 1, self);
+	return ret;
+}
+
+CLOOP_EXTERN_C void CALC_IWriter_write(struct CALC_IWriter* self, int n)
+{
+	CLOOP_PROBE(calc, enter, 11, 2, self);
+	self->vtable->write(self, n);
+	CLOOP_PROBE(calc, exit, 11, 2, self);
+}
+
+static void CALC_IWriterTap_dispose(struct CALC_IWriter* self)
+{
+	const struct CALC_IWriterTap* tap = (const struct CALC_IWriterTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 0, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 0, 0);
+}
+
+static struct CALC_IQueryable* CALC_IWriterTap_queryInterface(struct CALC_IWriter* self, unsigned id)
+{
+	const struct CALC_IWriterTap* tap = (const struct CALC_IWriterTap*) self->vtable;
+	struct CALC_IQueryable* ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 9, 1))
+		ret = tap->original->queryInterface(self, id);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 9, 1);
+
+	return ret;
+}
+
+static void CALC_IWriterTap_write(struct CALC_IWriter* self, int n)
+{
+	const struct CALC_IWriterTap* tap = (const struct CALC_IWriterTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 11, 2))
+		tap->original->write(self, n);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 11, 2);
+}
+
+CLOOP_EXTERN_C void CALC_IWriterTap_install(struct CALC_IWriterTap* tap, struct CALC_IWriter* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_IWriter_VERSION ? self->vtable->version : CALC_IWriter_VERSION;
+	tap->vtable.dispose = CALC_IWriterTap_dispose;
+	tap->vtable.queryInterface = CALC_IWriterTap_queryInterface;
+	tap->vtable.write = CALC_IWriterTap_write;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_IWriterTap_remove(struct CALC_IWriterTap* tap, struct CALC_IWriter* self)
+{
+	self->vtable = tap->original;
+}
+
+CLOOP_EXTERN_C void CALC_IAsyncCalculator_dispose(struct CALC_IAsyncCalculator* self)
+{
+	CLOOP_PROBE(calc, enter, 0, 0, self);
+	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 0, 0, self);
+}
+
+CLOOP_EXTERN_C int CALC_IAsyncCalculator_sum(const struct CALC_IAsyncCalculator* self, struct CALC_IStatus* status, int n1, int n2)
+{
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 12, 1, self);
+	ret = self->vtable->sum(self, status, n1, n2);
+	CLOOP_PROBE(calc, exit, 12, 1, self);
+	return ret;
+}
+
+CLOOP_EXTERN_C void CALC_IAsyncCalculator_sumAsync(const struct CALC_IAsyncCalculator* self, struct CALC_IStatus* status, int n1, int n2, struct CALC_IAsyncCalculatorSumCompletion* completion)
+{
+	CLOOP_PROBE(calc, enter, 12, 2, self);
+	self->vtable->sumAsync(self, status, n1, n2, completion);
+	CLOOP_PROBE(calc, exit, 12, 2, self);
+}
+
+static void CALC_IAsyncCalculatorTap_dispose(struct CALC_IAsyncCalculator* self)
+{
+	const struct CALC_IAsyncCalculatorTap* tap = (const struct CALC_IAsyncCalculatorTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 0, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 0, 0);
+}
+
+static int CALC_IAsyncCalculatorTap_sum(const struct CALC_IAsyncCalculator* self, struct CALC_IStatus* status, int n1, int n2)
+{
+	const struct CALC_IAsyncCalculatorTap* tap = (const struct CALC_IAsyncCalculatorTap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 12, 1))
+		ret = tap->original->sum(self, status, n1, n2);
+	else if (tap->hooks.fail)
+		tap->hooks.fail(tap->hooks.context, status, 12, 1);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 12, 1);
+
+	return ret;
+}
+
+static void CALC_IAsyncCalculatorTap_sumAsync(const struct CALC_IAsyncCalculator* self, struct CALC_IStatus* status, int n1, int n2, struct CALC_IAsyncCalculatorSumCompletion* completion)
+{
+	const struct CALC_IAsyncCalculatorTap* tap = (const struct CALC_IAsyncCalculatorTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 12, 2))
+		tap->original->sumAsync(self, status, n1, n2, completion);
+	else if (tap->hooks.fail)
+		tap->hooks.fail(tap->hooks.context, status, 12, 2);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 12, 2);
+}
+
+CLOOP_EXTERN_C void CALC_IAsyncCalculatorTap_install(struct CALC_IAsyncCalculatorTap* tap, struct CALC_IAsyncCalculator* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_IAsyncCalculator_VERSION ? self->vtable->version : CALC_IAsyncCalculator_VERSION;
+	tap->vtable.dispose = CALC_IAsyncCalculatorTap_dispose;
+	tap->vtable.sum = CALC_IAsyncCalculatorTap_sum;
+	tap->vtable.sumAsync = CALC_IAsyncCalculatorTap_sumAsync;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_IAsyncCalculatorTap_remove(struct CALC_IAsyncCalculatorTap* tap, struct CALC_IAsyncCalculator* self)
+{
+	self->vtable = tap->original;
+}
+
+CLOOP_EXTERN_C void CALC_IScanner_dispose(struct CALC_IScanner* self)
+{
+	CLOOP_PROBE(calc, enter, 0, 0, self);
+	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 0, 0, self);
+}
+
+CLOOP_EXTERN_C unsigned CALC_IScanner_countChar(const struct CALC_IScanner* self, struct cloopStrView text, unsigned char c)
+{
+	unsigned ret;
+
+	CLOOP_PROBE(calc, enter, 13, 1, self);
+	ret = self->vtable->countChar(self, text, c);
+	CLOOP_PROBE(calc, exit, 13, 1, self);
+	return ret;
+}
+
+CLOOP_EXTERN_C struct cloopStrView CALC_IScanner_trim(const struct CALC_IScanner* self, struct CALC_IStatus* status, struct cloopStrView text)
+{
+	struct cloopStrView ret;
+
+	CLOOP_PROBE(calc, enter, 13, 2, self);
+	ret = self->vtable->trim(self, status, text);
+	CLOOP_PROBE(calc, exit, 13, 2, self);
+	return ret;
+}
+
+CLOOP_EXTERN_C unsigned CALC_IScanner_checksum(const struct CALC_IScanner* self, struct cloopBytes in)
+{
+	unsigned ret;
+
+	CLOOP_PROBE(calc, enter, 13, 3, self);
+	ret = self->vtable->checksum(self, in);
+	CLOOP_PROBE(calc, exit, 13, 3, self);
+	return ret;
+}
+
+static void CALC_IScannerTap_dispose(struct CALC_IScanner* self)
+{
+	const struct CALC_IScannerTap* tap = (const struct CALC_IScannerTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 0, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 0, 0);
+}
+
+static unsigned CALC_IScannerTap_countChar(const struct CALC_IScanner* self, struct cloopStrView text, unsigned char c)
+{
+	const struct CALC_IScannerTap* tap = (const struct CALC_IScannerTap*) self->vtable;
+	unsigned ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 13, 1))
+		ret = tap->original->countChar(self, text, c);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 13, 1);
+
+	return ret;
+}
+
+static struct cloopStrView CALC_IScannerTap_trim(const struct CALC_IScanner* self, struct CALC_IStatus* status, struct cloopStrView text)
+{
+	const struct CALC_IScannerTap* tap = (const struct CALC_IScannerTap*) self->vtable;
+	struct cloopStrView ret = {0};
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 13, 2))
+		ret = tap->original->trim(self, status, text);
+	else if (tap->hooks.fail)
+		tap->hooks.fail(tap->hooks.context, status, 13, 2);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 13, 2);
+
+	return ret;
+}
+
+static unsigned CALC_IScannerTap_checksum(const struct CALC_IScanner* self, struct cloopBytes in)
+{
+	const struct CALC_IScannerTap* tap = (const struct CALC_IScannerTap*) self->vtable;
+	unsigned ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 13, 3))
+		ret = tap->original->checksum(self, in);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 13, 3);
+
+	return ret;
+}
+
+CLOOP_EXTERN_C void CALC_IScannerTap_install(struct CALC_IScannerTap* tap, struct CALC_IScanner* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_IScanner_VERSION ? self->vtable->version : CALC_IScanner_VERSION;
+	tap->vtable.dispose = CALC_IScannerTap_dispose;
+	tap->vtable.countChar = CALC_IScannerTap_countChar;
+	tap->vtable.trim = CALC_IScannerTap_trim;
+	tap->vtable.checksum = CALC_IScannerTap_checksum;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_IScannerTap_remove(struct CALC_IScannerTap* tap, struct CALC_IScanner* self)
+{
+	self->vtable = tap->original;
+}
+
+CLOOP_EXTERN_C void CALC_IGeometry_dispose(struct CALC_IGeometry* self)
+{
+	CLOOP_PROBE(calc, enter, 0, 0, self);
+	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 0, 0, self);
+}
+
+CLOOP_EXTERN_C struct Rectangle CALC_IGeometry_move(const struct CALC_IGeometry* self, struct Rectangle rectangle, struct Point offset)
+{
+	struct Rectangle ret;
+
+	CLOOP_PROBE(calc, enter, 14, 1, self);
+	ret = self->vtable->move(self, rectangle, offset);
+	CLOOP_PROBE(calc, exit, 14, 1, self);
+	return ret;
+}
+
+CLOOP_EXTERN_C int CALC_IGeometry_area(const struct CALC_IGeometry* self, const struct Rectangle* rectangle)
+{
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 14, 2, self);
+	ret = self->vtable->area(self, rectangle);
+	CLOOP_PROBE(calc, exit, 14, 2, self);
+	return ret;
+}
+
+CLOOP_EXTERN_C unsigned CALC_IGeometry_payload(const struct CALC_IGeometry* self, struct Header header)
+{
+	unsigned ret;
+
+	CLOOP_PROBE(calc, enter, 14, 3, self);
+	ret = self->vtable->payload(self, header);
+	CLOOP_PROBE(calc, exit, 14, 3, self);
+	return ret;
+}
+
+static void CALC_IGeometryTap_dispose(struct CALC_IGeometry* self)
+{
+	const struct CALC_IGeometryTap* tap = (const struct CALC_IGeometryTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 0, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 0, 0);
+}
+
+static struct Rectangle CALC_IGeometryTap_move(const struct CALC_IGeometry* self, struct Rectangle rectangle, struct Point offset)
+{
+	const struct CALC_IGeometryTap* tap = (const struct CALC_IGeometryTap*) self->vtable;
+	struct Rectangle ret = {0};
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 14, 1))
+		ret = tap->original->move(self, rectangle, offset);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 14, 1);
+
+	return ret;
+}
+
+static int CALC_IGeometryTap_area(const struct CALC_IGeometry* self, const struct Rectangle* rectangle)
+{
+	const struct CALC_IGeometryTap* tap = (const struct CALC_IGeometryTap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 14, 2))
+		ret = tap->original->area(self, rectangle);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 14, 2);
+
+	return ret;
+}
+
+static unsigned CALC_IGeometryTap_payload(const struct CALC_IGeometry* self, struct Header header)
+{
+	const struct CALC_IGeometryTap* tap = (const struct CALC_IGeometryTap*) self->vtable;
+	unsigned ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 14, 3))
+		ret = tap->original->payload(self, header);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 14, 3);
+
+	return ret;
+}
+
+CLOOP_EXTERN_C void CALC_IGeometryTap_install(struct CALC_IGeometryTap* tap, struct CALC_IGeometry* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_IGeometry_VERSION ? self->vtable->version : CALC_IGeometry_VERSION;
+	tap->vtable.dispose = CALC_IGeometryTap_dispose;
+	tap->vtable.move = CALC_IGeometryTap_move;
+	tap->vtable.area = CALC_IGeometryTap_area;
+	tap->vtable.payload = CALC_IGeometryTap_payload;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_IGeometryTap_remove(struct CALC_IGeometryTap* tap, struct CALC_IGeometry* self)
+{
+	self->vtable = tap->original;
+}
+
+CLOOP_EXTERN_C void CALC_ISeries_dispose(struct CALC_ISeries* self)
+{
+	CLOOP_PROBE(calc, enter, 0, 0, self);
+	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 0, 0, self);
+}
+
+CLOOP_EXTERN_C int CALC_ISeries_total(const struct CALC_ISeries* self, const int* values, unsigned count)
+{
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 15, 1, self);
+	ret = self->vtable->total(self, values, count);
+	CLOOP_PROBE(calc, exit, 15, 1, self);
+	return ret;
+}
+
+CLOOP_EXTERN_C void CALC_ISeries_scale(const struct CALC_ISeries* self, const int* in, int* out, unsigned count, int factor)
+{
+	CLOOP_PROBE(calc, enter, 15, 2, self);
+	self->vtable->scale(self, in, out, count, factor);
+	CLOOP_PROBE(calc, exit, 15, 2, self);
+}
+
+CLOOP_EXTERN_C unsigned CALC_ISeries_histogram(const struct CALC_ISeries* self, const unsigned char* data, unsigned* counts, unsigned size, unsigned buckets)
+{
+	unsigned ret;
+
+	CLOOP_PROBE(calc, enter, 15, 3, self);
+	ret = self->vtable->histogram(self, data, counts, size, buckets);
+	CLOOP_PROBE(calc, exit, 15, 3, self);
+	return ret;
+}
+
+CLOOP_EXTERN_C int CALC_ISeries_clamp(const struct CALC_ISeries* self, int value, int limit)
+{
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 15, 4, self);
+	ret = self->vtable->clamp(self, value, limit);
+	CLOOP_PROBE(calc, exit, 15, 4, self);
+	return ret;
+}
+
+CLOOP_EXTERN_C void CALC_ISeries_clampBatch(const struct CALC_ISeries* self, const int* value, const int* limit, int* results, unsigned count)
+{
+	CLOOP_PROBE(calc, enter, 15, 5, self);
+	self->vtable->clampBatch(self, value, limit, results, count);
+	CLOOP_PROBE(calc, exit, 15, 5, self);
+}
+
+static void CALC_ISeriesTap_dispose(struct CALC_ISeries* self)
+{
+	const struct CALC_ISeriesTap* tap = (const struct CALC_ISeriesTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 0, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 0, 0);
+}
+
+static int CALC_ISeriesTap_total(const struct CALC_ISeries* self, const int* values, unsigned count)
+{
+	const struct CALC_ISeriesTap* tap = (const struct CALC_ISeriesTap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 15, 1))
+		ret = tap->original->total(self, values, count);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 15, 1);
+
+	return ret;
+}
+
+static void CALC_ISeriesTap_scale(const struct CALC_ISeries* self, const int* in, int* out, unsigned count, int factor)
+{
+	const struct CALC_ISeriesTap* tap = (const struct CALC_ISeriesTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 15, 2))
+		tap->original->scale(self, in, out, count, factor);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 15, 2);
+}
+
+static unsigned CALC_ISeriesTap_histogram(const struct CALC_ISeries* self, const unsigned char* data, unsigned* counts, unsigned size, unsigned buckets)
+{
+	const struct CALC_ISeriesTap* tap = (const struct CALC_ISeriesTap*) self->vtable;
+	unsigned ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 15, 3))
+		ret = tap->original->histogram(self, data, counts, size, buckets);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 15, 3);
+
+	return ret;
+}
+
+static int CALC_ISeriesTap_clamp(const struct CALC_ISeries* self, int value, int limit)
+{
+	const struct CALC_ISeriesTap* tap = (const struct CALC_ISeriesTap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 15, 4))
+		ret = tap->original->clamp(self, value, limit);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 15, 4);
+
+	return ret;
+}
+
+static void CALC_ISeriesTap_clampBatch(const struct CALC_ISeries* self, const int* value, const int* limit, int* results, unsigned count)
+{
+	const struct CALC_ISeriesTap* tap = (const struct CALC_ISeriesTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 15, 5))
+		tap->original->clampBatch(self, value, limit, results, count);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 15, 5);
+}
+
+CLOOP_EXTERN_C void CALC_ISeriesTap_install(struct CALC_ISeriesTap* tap, struct CALC_ISeries* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_ISeries_VERSION ? self->vtable->version : CALC_ISeries_VERSION;
+	tap->vtable.dispose = CALC_ISeriesTap_dispose;
+	tap->vtable.total = CALC_ISeriesTap_total;
+	tap->vtable.scale = CALC_ISeriesTap_scale;
+	tap->vtable.histogram = CALC_ISeriesTap_histogram;
+	tap->vtable.clamp = CALC_ISeriesTap_clamp;
+	tap->vtable.clampBatch = CALC_ISeriesTap_clampBatch;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_ISeriesTap_remove(struct CALC_ISeriesTap* tap, struct CALC_ISeries* self)
+{
+	self->vtable = tap->original;
+}
+
+CLOOP_EXTERN_C void CALC_IPool_dispose(struct CALC_IPool* self)
+{
+	CLOOP_PROBE(calc, enter, 0, 0, self);
+	self->vtable->dispose(self);
+	CLOOP_PROBE(calc, exit, 0, 0, self);
+}
+
+CLOOP_EXTERN_C void CALC_IPool_keep(struct CALC_IPool* self, struct CALC_IAccumulator* accumulator)
+{
+	CLOOP_PROBE(calc, enter, 16, 1, self);
+	self->vtable->keep(self, accumulator);
+	CLOOP_PROBE(calc, exit, 16, 1, self);
+}
+
+CLOOP_EXTERN_C void CALC_IPool_setName(struct CALC_IPool* self, const char* name)
+{
+	CLOOP_PROBE(calc, enter, 16, 2, self);
+	self->vtable->setName(self, name);
+	CLOOP_PROBE(calc, exit, 16, 2, self);
+}
+
+CLOOP_EXTERN_C int CALC_IPool_total(const struct CALC_IPool* self)
+{
+	int ret;
+
+	CLOOP_PROBE(calc, enter, 16, 3, self);
+	ret = self->vtable->total(self);
+	CLOOP_PROBE(calc, exit, 16, 3, self);
+	return ret;
+}
+
+static void CALC_IPoolTap_dispose(struct CALC_IPool* self)
+{
+	const struct CALC_IPoolTap* tap = (const struct CALC_IPoolTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 0, 0))
+		tap->original->dispose(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 0, 0);
+}
+
+static void CALC_IPoolTap_keep(struct CALC_IPool* self, struct CALC_IAccumulator* accumulator)
+{
+	const struct CALC_IPoolTap* tap = (const struct CALC_IPoolTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 16, 1))
+		tap->original->keep(self, accumulator);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 16, 1);
+}
+
+static void CALC_IPoolTap_setName(struct CALC_IPool* self, const char* name)
+{
+	const struct CALC_IPoolTap* tap = (const struct CALC_IPoolTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 16, 2))
+		tap->original->setName(self, name);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 16, 2);
+}
+
+static int CALC_IPoolTap_total(const struct CALC_IPool* self)
+{
+	const struct CALC_IPoolTap* tap = (const struct CALC_IPoolTap*) self->vtable;
+	int ret = 0;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 16, 3))
+		ret = tap->original->total(self);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 16, 3);
+
+	return ret;
+}
+
+CLOOP_EXTERN_C void CALC_IPoolTap_install(struct CALC_IPoolTap* tap, struct CALC_IPool* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_IPool_VERSION ? self->vtable->version : CALC_IPool_VERSION;
+	tap->vtable.dispose = CALC_IPoolTap_dispose;
+	tap->vtable.keep = CALC_IPoolTap_keep;
+	tap->vtable.setName = CALC_IPoolTap_setName;
+	tap->vtable.total = CALC_IPoolTap_total;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_IPoolTap_remove(struct CALC_IPoolTap* tap, struct CALC_IPool* self)
+{
+	self->vtable = tap->original;
+}
+
+CLOOP_EXTERN_C void CALC_IAsyncCalculatorSumCompletion_complete(struct CALC_IAsyncCalculatorSumCompletion* self, struct CALC_IStatus* status, int result)
+{
+	CLOOP_PROBE(calc, enter, 17, 0, self);
+	self->vtable->complete(self, status, result);
+	CLOOP_PROBE(calc, exit, 17, 0, self);
+}
+
+static void CALC_IAsyncCalculatorSumCompletionTap_complete(struct CALC_IAsyncCalculatorSumCompletion* self, struct CALC_IStatus* status, int result)
+{
+	const struct CALC_IAsyncCalculatorSumCompletionTap* tap = (const struct CALC_IAsyncCalculatorSumCompletionTap*) self->vtable;
+
+	if (!tap->hooks.pre || !tap->hooks.pre(tap->hooks.context, self, 17, 0))
+		tap->original->complete(self, status, result);
+	else if (tap->hooks.fail)
+		tap->hooks.fail(tap->hooks.context, status, 17, 0);
+
+	if (tap->hooks.post)
+		tap->hooks.post(tap->hooks.context, self, 17, 0);
+}
+
+CLOOP_EXTERN_C void CALC_IAsyncCalculatorSumCompletionTap_install(struct CALC_IAsyncCalculatorSumCompletionTap* tap, struct CALC_IAsyncCalculatorSumCompletion* self, const struct cloopTapHooks* hooks)
+{
+	tap->vtable.cloopDummy[0] = self->vtable->cloopDummy[0];
+	tap->vtable.version = self->vtable->version < CALC_IAsyncCalculatorSumCompletion_VERSION ? self->vtable->version : CALC_IAsyncCalculatorSumCompletion_VERSION;
+	tap->vtable.complete = CALC_IAsyncCalculatorSumCompletionTap_complete;
+	tap->original = self->vtable;
+	tap->hooks = *hooks;
+	self->vtable = &tap->vtable;
+}
+
+CLOOP_EXTERN_C void CALC_IAsyncCalculatorSumCompletionTap_remove(struct CALC_IAsyncCalculatorSumCompletionTap* tap, struct CALC_IAsyncCalculatorSumCompletion* self)
+{
+	self->vtable = tap->original;
+}
+
+CLOOP_EXTERN_C unsigned CALC_ICommands_execute(struct CALC_IStatus* status, uint64_t* cells, unsigned size)
+{
+	unsigned executed = 0;
+	unsigned position = 0;
+
+	for (; position < size; ++executed)
+	{
+		uint64_t* command = cells + position;
+
+		switch ((unsigned) (command[0] & 0xFFFFFFFF))
+		{
+			case (0u << 16) | 0u:	/* CALC_IDisposable_dispose */
+			{
+				struct CALC_IDisposable* object = (struct CALC_IDisposable*) (uintptr_t) command[1];
+
+				object->vtable->dispose(object);
+				break;
+			}
+
+			case (4u << 16) | 1u:	/* CALC_ICalculator_sum */
+			{
+				struct CALC_ICalculator* object = (struct CALC_ICalculator*) (uintptr_t) command[1];
+
+				command[4] = (uint64_t) object->vtable->sum(object, status, (int) command[2], (int) command[3]);
+
+				if (status->cloopErrorFlag)
+					return executed;
+				break;
+			}
+
+			case (4u << 16) | 2u:	/* CALC_ICalculator_getMemory */
+			{
+				struct CALC_ICalculator* object = (struct CALC_ICalculator*) (uintptr_t) command[1];
+
+				if (object->vtable->version < 3)
+					return executed;
+
+				command[2] = (uint64_t) object->vtable->getMemory(object);
+				break;
+			}
+
+			case (4u << 16) | 3u:	/* CALC_ICalculator_setMemory */
+			{
+				struct CALC_ICalculator* object = (struct CALC_ICalculator*) (uintptr_t) command[1];
+
+				if (object->vtable->version < 3)
+					return executed;
+
+				object->vtable->setMemory(object, (int) command[2]);
+				break;
+			}
+
+			case (4u << 16) | 4u:	/* CALC_ICalculator_sumAndStore */
+			{
+				struct CALC_ICalculator* object = (struct CALC_ICalculator*) (uintptr_t) command[1];
+
+				if (object->vtable->version < 4)
+					return executed;
+
+				object->vtable->sumAndStore(object, status, (int) command[2], (int) command[3]);
+
+				if (status->cloopErrorFlag)
+					return executed;
+				break;
+			}
+
+			case (5u << 16) | 5u:	/* CALC_ICalculator2_multiply */
+			{
+				struct CALC_ICalculator2* object = (struct CALC_ICalculator2*) (uintptr_t) command[1];
+
+				command[4] = (uint64_t) object->vtable->multiply(object, status, (int) command[2], (int) command[3]);
+
+				if (status->cloopErrorFlag)
+					return executed;
+				break;
+			}
+
+			case (5u << 16) | 6u:	/* CALC_ICalculator2_copyMemory */
+			{
+				struct CALC_ICalculator2* object = (struct CALC_ICalculator2*) (uintptr_t) command[1];
+
+				object->vtable->copyMemory(object, (const struct CALC_ICalculator*) (uintptr_t) command[2]);
+				break;
+			}
+
+			case (5u << 16) | 7u:	/* CALC_ICalculator2_copyMemory2 */
+			{
+				struct CALC_ICalculator2* object = (struct CALC_ICalculator2*) (uintptr_t) command[1];
+
+				if (object->vtable->version < 6)
+					return executed;
+
+				object->vtable->copyMemory2(object, (const int*) (uintptr_t) command[2]);
+				break;
+			}
+
+			case (5u << 16) | 8u:	/* CALC_ICalculator2_multiplyBatch */
+			{
+				struct CALC_ICalculator2* object = (struct CALC_ICalculator2*) (uintptr_t) command[1];
+
+				if (object->vtable->version < 7)
+					return executed;
+
+				object->vtable->multiplyBatch(object, status, (const int*) (uintptr_t) command[2], (const int*) (uintptr_t) command[3], (int*) (uintptr_t) command[4], (unsigned) command[5]);
+
+				if (status->cloopErrorFlag)
+					return executed;
+				break;
+			}
+
+			default:
+				return executed;
+		}
+
+		position += (unsigned) (command[0] >> 32);
+	}
+
+	return executed;
+}
@@ -13,6 +13,58 @@
 #endif
 #endif
 
+#ifndef CLOOP_REFLECTION_TYPES
+#define CLOOP_REFLECTION_TYPES
+
+struct cloopParameterInfo
+{
+	const char* name;
+	const char* type;
+};
+
+struct cloopMethodInfo
+{
+	const char* name;
+	unsigned slot;
+	unsigned version;
+	const char* returnType;
+	const struct cloopParameterInfo* parameters;
+	unsigned parameterCount;
+	int isConst;
+	int mayThrow;
+};
+
+#endif
+
+#ifndef CLOOP_TAP_TYPES
+#define CLOOP_TAP_TYPES
+
+struct cloopTapHooks
+{
+	int (*pre)(void* context, const void* self, unsigned interfaceIndex, unsigned slot);
+	void (*post)(void* context, const void* self, unsigned interfaceIndex, unsigned slot);
+	void (*fail)(void* context, void* status, unsigned interfaceIndex, unsigned slot);
+	void* context;
+};
+
+#endif
+
+#ifndef CLOOP_VIEW_TYPES
+#define CLOOP_VIEW_TYPES
+struct cloopStrView
+{
+	const char* data;
+	uint64_t length;
+};
+
+struct cloopBytes
+{
+	const unsigned char* data;
+	uint64_t length;
+};
+
+#endif
+
 
 struct CALC_IDisposable;
 struct CALC_IStatus;
@@ -20,6 +72,53 @@ struct CALC_IStatusFactory;
 struct CALC_IFactory;
 struct CALC_ICalculator;
 struct CALC_ICalculator2;
+struct CALC_ICounter;
+struct CALC_IReferenceCounted;
+struct CALC_IAccumulator;
+struct CALC_IQueryable;
+struct CALC_IReader;
+struct CALC_IWriter;
+struct CALC_IAsyncCalculator;
+struct CALC_IScanner;
+struct CALC_IGeometry;
+struct CALC_ISeries;
+struct CALC_IPool;
+struct CALC_IAsyncCalculatorSumCompletion;
+
+
+#ifndef CLOOP_ALIGN
+#if defined(_MSC_VER)
+#define CLOOP_ALIGN(n) __declspec(align(n))
+#else
+#define CLOOP_ALIGN(n) __attribute__((aligned(n)))
+#endif
+#endif
+
+struct Point
+{
+	int x;
+	int y;
+};
+
+struct CLOOP_ALIGN(8) Size
+{
+	unsigned width;
+	unsigned height;
+};
+
+#pragma pack(push, 1)
+struct Header
+{
+	unsigned char kind;
+	unsigned length;
+};
+#pragma pack(pop)
+
+struct Rectangle
+{
+	struct Point origin;
+	struct Size extent;
+};
 
 
 #define CALC_IDisposable_VERSION 1
@@ -41,6 +140,23 @@ struct CALC_IDisposable
 
 CLOOP_EXTERN_C void CALC_IDisposable_dispose(struct CALC_IDisposable* self);
 
+struct CALC_IDisposableTap
+{
+	struct CALC_IDisposableVTable vtable;
+	struct CALC_IDisposableVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_IDisposableTap_install(struct CALC_IDisposableTap* tap, struct CALC_IDisposable* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_IDisposableTap_remove(struct CALC_IDisposableTap* tap, struct CALC_IDisposable* self);
+
+#define CALC_IDisposable_METHOD_COUNT 1
+
+static const struct cloopMethodInfo CALC_IDisposable_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0}
+};
+
 #define CALC_IStatus_VERSION 3
 
 #define CALC_IStatus_ERROR_1 ((int) (1))
@@ -62,12 +178,37 @@ struct CALC_IStatus
 {
 	void* cloopDummy[1];
 	struct CALC_IStatusVTable* vtable;
+	int cloopErrorFlag;
 };
 
 CLOOP_EXTERN_C void CALC_IStatus_dispose(struct CALC_IStatus* self);
 CLOOP_EXTERN_C int CALC_IStatus_getCode(const struct CALC_IStatus* self);
 CLOOP_EXTERN_C void CALC_IStatus_setCode(struct CALC_IStatus* self, int code);
 
+struct CALC_IStatusTap
+{
+	struct CALC_IStatusVTable vtable;
+	struct CALC_IStatusVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_IStatusTap_install(struct CALC_IStatusTap* tap, struct CALC_IStatus* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_IStatusTap_remove(struct CALC_IStatusTap* tap, struct CALC_IStatus* self);
+
+static const struct cloopParameterInfo CALC_IStatus_cloopsetCodeParameters[] =
+{
+	{"code", "int"}
+};
+
+#define CALC_IStatus_METHOD_COUNT 3
+
+static const struct cloopMethodInfo CALC_IStatus_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0},
+	{"getCode", 1, 2, "int", 0, 0, 1, 0},
+	{"setCode", 2, 2, "void", CALC_IStatus_cloopsetCodeParameters, 1, 0, 0}
+};
+
 #define CALC_IStatusFactory_VERSION 2
 
 struct CALC_IStatusFactory;
@@ -89,6 +230,24 @@ struct CALC_IStatusFactory
 CLOOP_EXTERN_C void CALC_IStatusFactory_dispose(struct CALC_IStatusFactory* self);
 CLOOP_EXTERN_C struct CALC_IStatus* CALC_IStatusFactory_createStatus(struct CALC_IStatusFactory* self);
 
+struct CALC_IStatusFactoryTap
+{
+	struct CALC_IStatusFactoryVTable vtable;
+	struct CALC_IStatusFactoryVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_IStatusFactoryTap_install(struct CALC_IStatusFactoryTap* tap, struct CALC_IStatusFactory* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_IStatusFactoryTap_remove(struct CALC_IStatusFactoryTap* tap, struct CALC_IStatusFactory* self);
+
+#define CALC_IStatusFactory_METHOD_COUNT 2
+
+static const struct cloopMethodInfo CALC_IStatusFactory_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0},
+	{"createStatus", 1, 2, "struct CALC_IStatus*", 0, 0, 0, 0}
+};
+
 #define CALC_IFactory_VERSION 6
 
 struct CALC_IFactory;
@@ -118,6 +277,48 @@ CLOOP_EXTERN_C struct CALC_ICalculator2* CALC_IFactory_createCalculator2(struct
 CLOOP_EXTERN_C struct CALC_ICalculator* CALC_IFactory_createBrokenCalculator(struct CALC_IFactory* self, struct CALC_IStatus* status);
 CLOOP_EXTERN_C void CALC_IFactory_setStatusFactory(struct CALC_IFactory* self, struct CALC_IStatusFactory* statusFactory);
 
+struct CALC_IFactoryTap
+{
+	struct CALC_IFactoryVTable vtable;
+	struct CALC_IFactoryVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_IFactoryTap_install(struct CALC_IFactoryTap* tap, struct CALC_IFactory* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_IFactoryTap_remove(struct CALC_IFactoryTap* tap, struct CALC_IFactory* self);
+
+static const struct cloopParameterInfo CALC_IFactory_cloopcreateCalculatorParameters[] =
+{
+	{"status", "struct CALC_IStatus*"}
+};
+
+static const struct cloopParameterInfo CALC_IFactory_cloopcreateCalculator2Parameters[] =
+{
+	{"status", "struct CALC_IStatus*"}
+};
+
+static const struct cloopParameterInfo CALC_IFactory_cloopcreateBrokenCalculatorParameters[] =
+{
+	{"status", "struct CALC_IStatus*"}
+};
+
+static const struct cloopParameterInfo CALC_IFactory_cloopsetStatusFactoryParameters[] =
+{
+	{"statusFactory", "struct CALC_IStatusFactory*"}
+};
+
+#define CALC_IFactory_METHOD_COUNT 6
+
+static const struct cloopMethodInfo CALC_IFactory_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0},
+	{"createStatus", 1, 2, "struct CALC_IStatus*", 0, 0, 0, 0},
+	{"createCalculator", 2, 2, "struct CALC_ICalculator*", CALC_IFactory_cloopcreateCalculatorParameters, 1, 0, 1},
+	{"createCalculator2", 3, 2, "struct CALC_ICalculator2*", CALC_IFactory_cloopcreateCalculator2Parameters, 1, 0, 1},
+	{"createBrokenCalculator", 4, 2, "struct CALC_ICalculator*", CALC_IFactory_cloopcreateBrokenCalculatorParameters, 1, 0, 1},
+	{"setStatusFactory", 5, 2, "void", CALC_IFactory_cloopsetStatusFactoryParameters, 1, 0, 0}
+};
+
 #define CALC_ICalculator_VERSION 5
 
 struct CALC_ICalculator;
@@ -145,7 +346,47 @@ CLOOP_EXTERN_C int CALC_ICalculator_getMemory(const struct CALC_ICalculator* sel
 CLOOP_EXTERN_C void CALC_ICalculator_setMemory(struct CALC_ICalculator* self, int n);
 CLOOP_EXTERN_C void CALC_ICalculator_sumAndStore(struct CALC_ICalculator* self, struct CALC_IStatus* status, int n1, int n2);
 
-#define CALC_ICalculator2_VERSION 8
+struct CALC_ICalculatorTap
+{
+	struct CALC_ICalculatorVTable vtable;
+	struct CALC_ICalculatorVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_ICalculatorTap_install(struct CALC_ICalculatorTap* tap, struct CALC_ICalculator* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_ICalculatorTap_remove(struct CALC_ICalculatorTap* tap, struct CALC_ICalculator* self);
+
+static const struct cloopParameterInfo CALC_ICalculator_cloopsumParameters[] =
+{
+	{"status", "struct CALC_IStatus*"},
+	{"n1", "int"},
+	{"n2", "int"}
+};
+
+static const struct cloopParameterInfo CALC_ICalculator_cloopsetMemoryParameters[] =
+{
+	{"n", "int"}
+};
+
+static const struct cloopParameterInfo CALC_ICalculator_cloopsumAndStoreParameters[] =
+{
+	{"status", "struct CALC_IStatus*"},
+	{"n1", "int"},
+	{"n2", "int"}
+};
+
+#define CALC_ICalculator_METHOD_COUNT 5
+
+static const struct cloopMethodInfo CALC_ICalculator_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0},
+	{"sum", 1, 2, "int", CALC_ICalculator_cloopsumParameters, 3, 1, 1},
+	{"getMemory", 2, 3, "int", 0, 0, 1, 0},
+	{"setMemory", 3, 3, "void", CALC_ICalculator_cloopsetMemoryParameters, 1, 0, 0},
+	{"sumAndStore", 4, 4, "void", CALC_ICalculator_cloopsumAndStoreParameters, 3, 0, 1}
+};
+
+#define CALC_ICalculator2_VERSION 9
 
 struct CALC_ICalculator2;
 
@@ -161,6 +402,7 @@ struct CALC_ICalculator2VTable
 	int (*multiply)(const struct CALC_ICalculator2* self, struct CALC_IStatus* status, int n1, int n2);
 	void (*copyMemory)(struct CALC_ICalculator2* self, const struct CALC_ICalculator* calculator);
 	void (*copyMemory2)(struct CALC_ICalculator2* self, const int* address);
+	void (*multiplyBatch)(const struct CALC_ICalculator2* self, struct CALC_IStatus* status, const int* n1, const int* n2, int* results, unsigned count);
 };
 
 struct CALC_ICalculator2
@@ -177,6 +419,706 @@ CLOOP_EXTERN_C void CALC_ICalculator2_sumAndStore(struct CALC_ICalculator2* self
 CLOOP_EXTERN_C int CALC_ICalculator2_multiply(const struct CALC_ICalculator2* self, struct CALC_IStatus* status, int n1, int n2);
 CLOOP_EXTERN_C void CALC_ICalculator2_copyMemory(struct CALC_ICalculator2* self, const struct CALC_ICalculator* calculator);
 CLOOP_EXTERN_C void CALC_ICalculator2_copyMemory2(struct CALC_ICalculator2* self, const int* address);
+CLOOP_EXTERN_C void CALC_ICalculator2_multiplyBatch(const struct CALC_ICalculator2* self, struct CALC_IStatus* status, const int* n1, const int* n2, int* results, unsigned count);
+
+struct CALC_ICalculator2Tap
+{
+	struct CALC_ICalculator2VTable vtable;
+	struct CALC_ICalculator2VTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_ICalculator2Tap_install(struct CALC_ICalculator2Tap* tap, struct CALC_ICalculator2* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_ICalculator2Tap_remove(struct CALC_ICalculator2Tap* tap, struct CALC_ICalculator2* self);
+
+static const struct cloopParameterInfo CALC_ICalculator2_cloopmultiplyParameters[] =
+{
+	{"status", "struct CALC_IStatus*"},
+	{"n1", "int"},
+	{"n2", "int"}
+};
+
+static const struct cloopParameterInfo CALC_ICalculator2_cloopcopyMemoryParameters[] =
+{
+	{"calculator", "const struct CALC_ICalculator*"}
+};
+
+static const struct cloopParameterInfo CALC_ICalculator2_cloopcopyMemory2Parameters[] =
+{
+	{"address", "const int*"}
+};
+
+static const struct cloopParameterInfo CALC_ICalculator2_cloopmultiplyBatchParameters[] =
+{
+	{"status", "struct CALC_IStatus*"},
+	{"n1", "const int*"},
+	{"n2", "const int*"},
+	{"results", "int*"},
+	{"count", "unsigned"}
+};
+
+#define CALC_ICalculator2_METHOD_COUNT 9
+
+static const struct cloopMethodInfo CALC_ICalculator2_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0},
+	{"sum", 1, 2, "int", CALC_ICalculator_cloopsumParameters, 3, 1, 1},
+	{"getMemory", 2, 3, "int", 0, 0, 1, 0},
+	{"setMemory", 3, 3, "void", CALC_ICalculator_cloopsetMemoryParameters, 1, 0, 0},
+	{"sumAndStore", 4, 4, "void", CALC_ICalculator_cloopsumAndStoreParameters, 3, 0, 1},
+	{"multiply", 5, 5, "int", CALC_ICalculator2_cloopmultiplyParameters, 3, 1, 1},
+	{"copyMemory", 6, 5, "void", CALC_ICalculator2_cloopcopyMemoryParameters, 1, 0, 0},
+	{"copyMemory2", 7, 6, "void", CALC_ICalculator2_cloopcopyMemory2Parameters, 1, 0, 0},
+	{"multiplyBatch", 8, 7, "void", CALC_ICalculator2_cloopmultiplyBatchParameters, 5, 1, 1}
+};
+
+#define CALC_ICounter_VERSION 4
+
+struct CALC_ICounter;
+
+struct CALC_ICounterVTable
+{
+	uintptr_t version;
+	void (*dispose)(struct CALC_ICounter* self);
+	int (*increment)(struct CALC_ICounter* self);
+	int (*getValue)(const struct CALC_ICounter* self);
+	void (*add)(struct CALC_ICounter* self, const struct CALC_ICounter* counter);
+};
+
+struct CALC_ICounter
+{
+	struct CALC_ICounterVTable* vtable;
+};
+
+CLOOP_EXTERN_C void CALC_ICounter_dispose(struct CALC_ICounter* self);
+CLOOP_EXTERN_C int CALC_ICounter_increment(struct CALC_ICounter* self);
+CLOOP_EXTERN_C int CALC_ICounter_getValue(const struct CALC_ICounter* self);
+CLOOP_EXTERN_C void CALC_ICounter_add(struct CALC_ICounter* self, const struct CALC_ICounter* counter);
+
+struct CALC_ICounterTap
+{
+	struct CALC_ICounterVTable vtable;
+	struct CALC_ICounterVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_ICounterTap_install(struct CALC_ICounterTap* tap, struct CALC_ICounter* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_ICounterTap_remove(struct CALC_ICounterTap* tap, struct CALC_ICounter* self);
+
+static const struct cloopParameterInfo CALC_ICounter_cloopaddParameters[] =
+{
+	{"counter", "const struct CALC_ICounter*"}
+};
+
+#define CALC_ICounter_METHOD_COUNT 4
+
+static const struct cloopMethodInfo CALC_ICounter_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0},
+	{"increment", 1, 1, "int", 0, 0, 0, 0},
+	{"getValue", 2, 1, "int", 0, 0, 1, 0},
+	{"add", 3, 1, "void", CALC_ICounter_cloopaddParameters, 1, 0, 0}
+};
+
+#define CALC_IReferenceCounted_VERSION 2
+
+struct CALC_IReferenceCounted;
+
+struct CALC_IReferenceCountedVTable
+{
+	void* cloopDummy[1];
+	uintptr_t version;
+	void (*addRef)(struct CALC_IReferenceCounted* self);
+	int (*release)(struct CALC_IReferenceCounted* self);
+};
+
+struct CALC_IReferenceCounted
+{
+	void* cloopDummy[1];
+	struct CALC_IReferenceCountedVTable* vtable;
+};
+
+CLOOP_EXTERN_C void CALC_IReferenceCounted_addRef(struct CALC_IReferenceCounted* self);
+CLOOP_EXTERN_C int CALC_IReferenceCounted_release(struct CALC_IReferenceCounted* self);
+
+struct CALC_IReferenceCountedTap
+{
+	struct CALC_IReferenceCountedVTable vtable;
+	struct CALC_IReferenceCountedVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_IReferenceCountedTap_install(struct CALC_IReferenceCountedTap* tap, struct CALC_IReferenceCounted* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_IReferenceCountedTap_remove(struct CALC_IReferenceCountedTap* tap, struct CALC_IReferenceCounted* self);
+
+#define CALC_IReferenceCounted_METHOD_COUNT 2
+
+static const struct cloopMethodInfo CALC_IReferenceCounted_cloopMethods[] =
+{
+	{"addRef", 0, 1, "void", 0, 0, 0, 0},
+	{"release", 1, 1, "int", 0, 0, 0, 0}
+};
+
+#define CALC_IAccumulator_VERSION 4
+
+struct CALC_IAccumulator;
+
+struct CALC_IAccumulatorVTable
+{
+	void* cloopDummy[1];
+	uintptr_t version;
+	void (*addRef)(struct CALC_IAccumulator* self);
+	int (*release)(struct CALC_IAccumulator* self);
+	void (*add)(struct CALC_IAccumulator* self, int n);
+	int (*getTotal)(const struct CALC_IAccumulator* self);
+};
+
+struct CALC_IAccumulator
+{
+	void* cloopDummy[1];
+	struct CALC_IAccumulatorVTable* vtable;
+};
+
+CLOOP_EXTERN_C void CALC_IAccumulator_addRef(struct CALC_IAccumulator* self);
+CLOOP_EXTERN_C int CALC_IAccumulator_release(struct CALC_IAccumulator* self);
+CLOOP_EXTERN_C void CALC_IAccumulator_add(struct CALC_IAccumulator* self, int n);
+CLOOP_EXTERN_C int CALC_IAccumulator_getTotal(const struct CALC_IAccumulator* self);
+
+struct CALC_IAccumulatorTap
+{
+	struct CALC_IAccumulatorVTable vtable;
+	struct CALC_IAccumulatorVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_IAccumulatorTap_install(struct CALC_IAccumulatorTap* tap, struct CALC_IAccumulator* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_IAccumulatorTap_remove(struct CALC_IAccumulatorTap* tap, struct CALC_IAccumulator* self);
+
+static const struct cloopParameterInfo CALC_IAccumulator_cloopaddParameters[] =
+{
+	{"n", "int"}
+};
+
+#define CALC_IAccumulator_METHOD_COUNT 4
+
+static const struct cloopMethodInfo CALC_IAccumulator_cloopMethods[] =
+{
+	{"addRef", 0, 1, "void", 0, 0, 0, 0},
+	{"release", 1, 1, "int", 0, 0, 0, 0},
+	{"add", 2, 2, "void", CALC_IAccumulator_cloopaddParameters, 1, 0, 0},
+	{"getTotal", 3, 2, "int", 0, 0, 1, 0}
+};
+
+#define CALC_IQueryable_VERSION 2
+
+struct CALC_IQueryable;
+
+struct CALC_IQueryableVTable
+{
+	void* cloopDummy[1];
+	uintptr_t version;
+	void (*dispose)(struct CALC_IQueryable* self);
+	struct CALC_IQueryable* (*queryInterface)(struct CALC_IQueryable* self, unsigned id);
+};
+
+struct CALC_IQueryable
+{
+	void* cloopDummy[1];
+	struct CALC_IQueryableVTable* vtable;
+};
+
+CLOOP_EXTERN_C void CALC_IQueryable_dispose(struct CALC_IQueryable* self);
+CLOOP_EXTERN_C struct CALC_IQueryable* CALC_IQueryable_queryInterface(struct CALC_IQueryable* self, unsigned id);
+
+struct CALC_IQueryableTap
+{
+	struct CALC_IQueryableVTable vtable;
+	struct CALC_IQueryableVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_IQueryableTap_install(struct CALC_IQueryableTap* tap, struct CALC_IQueryable* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_IQueryableTap_remove(struct CALC_IQueryableTap* tap, struct CALC_IQueryable* self);
+
+static const struct cloopParameterInfo CALC_IQueryable_cloopqueryInterfaceParameters[] =
+{
+	{"id", "unsigned"}
+};
+
+#define CALC_IQueryable_METHOD_COUNT 2
+
+static const struct cloopMethodInfo CALC_IQueryable_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0},
+	{"queryInterface", 1, 2, "struct CALC_IQueryable*", CALC_IQueryable_cloopqueryInterfaceParameters, 1, 0, 0}
+};
+
+#define CALC_IReader_VERSION 3
+#define CALC_IReader_IID 0x52454144u
+
+struct CALC_IReader;
+
+struct CALC_IReaderVTable
+{
+	void* cloopDummy[1];
+	uintptr_t version;
+	void (*dispose)(struct CALC_IReader* self);
+	struct CALC_IQueryable* (*queryInterface)(struct CALC_IReader* self, unsigned id);
+	int (*read)(struct CALC_IReader* self);
+};
+
+struct CALC_IReader
+{
+	void* cloopDummy[1];
+	struct CALC_IReaderVTable* vtable;
+};
+
+CLOOP_EXTERN_C void CALC_IReader_dispose(struct CALC_IReader* self);
+CLOOP_EXTERN_C struct CALC_IQueryable* CALC_IReader_queryInterface(struct CALC_IReader* self, unsigned id);
+CLOOP_EXTERN_C int CALC_IReader_read(struct CALC_IReader* self);
+
+struct CALC_IReaderTap
+{
+	struct CALC_IReaderVTable vtable;
+	struct CALC_IReaderVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_IReaderTap_install(struct CALC_IReaderTap* tap, struct CALC_IReader* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_IReaderTap_remove(struct CALC_IReaderTap* tap, struct CALC_IReader* self);
+
+#define CALC_IReader_METHOD_COUNT 3
+
+static const struct cloopMethodInfo CALC_IReader_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0},
+	{"queryInterface", 1, 2, "struct CALC_IQueryable*", CALC_IQueryable_cloopqueryInterfaceParameters, 1, 0, 0},
+	{"read", 2, 3, "int", 0, 0, 0, 0}
+};
+
+#define CALC_IWriter_VERSION 3
+#define CALC_IWriter_IID 0x57524954u
+
+struct CALC_IWriter;
+
+struct CALC_IWriterVTable
+{
+	void* cloopDummy[1];
+	uintptr_t version;
+	void (*dispose)(struct CALC_IWriter* self);
+	struct CALC_IQueryable* (*queryInterface)(struct CALC_IWriter* self, unsigned id);
+	void (*write)(struct CALC_IWriter* self, int n);
+};
+
+struct CALC_IWriter
+{
+	void* cloopDummy[1];
+	struct CALC_IWriterVTable* vtable;
+};
+
+CLOOP_EXTERN_C void CALC_IWriter_dispose(struct CALC_IWriter* self);
+CLOOP_EXTERN_C struct CALC_IQueryable* CALC_IWriter_queryInterface(struct CALC_IWriter* self, unsigned id);
+CLOOP_EXTERN_C void CALC_IWriter_write(struct CALC_IWriter* self, int n);
+
+struct CALC_IWriterTap
+{
+	struct CALC_IWriterVTable vtable;
+	struct CALC_IWriterVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_IWriterTap_install(struct CALC_IWriterTap* tap, struct CALC_IWriter* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_IWriterTap_remove(struct CALC_IWriterTap* tap, struct CALC_IWriter* self);
+
+static const struct cloopParameterInfo CALC_IWriter_cloopwriteParameters[] =
+{
+	{"n", "int"}
+};
+
+#define CALC_IWriter_METHOD_COUNT 3
+
+static const struct cloopMethodInfo CALC_IWriter_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0},
+	{"queryInterface", 1, 2, "struct CALC_IQueryable*", CALC_IQueryable_cloopqueryInterfaceParameters, 1, 0, 0},
+	{"write", 2, 3, "void", CALC_IWriter_cloopwriteParameters, 1, 0, 0}
+};
+
+#define CALC_IAsyncCalculator_VERSION 3
+
+struct CALC_IAsyncCalculator;
+
+struct CALC_IAsyncCalculatorVTable
+{
+	void* cloopDummy[1];
+	uintptr_t version;
+	void (*dispose)(struct CALC_IAsyncCalculator* self);
+	int (*sum)(const struct CALC_IAsyncCalculator* self, struct CALC_IStatus* status, int n1, int n2);
+	void (*sumAsync)(const struct CALC_IAsyncCalculator* self, struct CALC_IStatus* status, int n1, int n2, struct CALC_IAsyncCalculatorSumCompletion* completion);
+};
+
+struct CALC_IAsyncCalculator
+{
+	void* cloopDummy[1];
+	struct CALC_IAsyncCalculatorVTable* vtable;
+};
+
+CLOOP_EXTERN_C void CALC_IAsyncCalculator_dispose(struct CALC_IAsyncCalculator* self);
+CLOOP_EXTERN_C int CALC_IAsyncCalculator_sum(const struct CALC_IAsyncCalculator* self, struct CALC_IStatus* status, int n1, int n2);
+CLOOP_EXTERN_C void CALC_IAsyncCalculator_sumAsync(const struct CALC_IAsyncCalculator* self, struct CALC_IStatus* status, int n1, int n2, struct CALC_IAsyncCalculatorSumCompletion* completion);
+
+struct CALC_IAsyncCalculatorTap
+{
+	struct CALC_IAsyncCalculatorVTable vtable;
+	struct CALC_IAsyncCalculatorVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_IAsyncCalculatorTap_install(struct CALC_IAsyncCalculatorTap* tap, struct CALC_IAsyncCalculator* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_IAsyncCalculatorTap_remove(struct CALC_IAsyncCalculatorTap* tap, struct CALC_IAsyncCalculator* self);
+
+static const struct cloopParameterInfo CALC_IAsyncCalculator_cloopsumParameters[] =
+{
+	{"status", "struct CALC_IStatus*"},
+	{"n1", "int"},
+	{"n2", "int"}
+};
+
+static const struct cloopParameterInfo CALC_IAsyncCalculator_cloopsumAsyncParameters[] =
+{
+	{"status", "struct CALC_IStatus*"},
+	{"n1", "int"},
+	{"n2", "int"},
+	{"completion", "struct CALC_IAsyncCalculatorSumCompletion*"}
+};
+
+#define CALC_IAsyncCalculator_METHOD_COUNT 3
+
+static const struct cloopMethodInfo CALC_IAsyncCalculator_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0},
+	{"sum", 1, 2, "int", CALC_IAsyncCalculator_cloopsumParameters, 3, 1, 1},
+	{"sumAsync", 2, 2, "void", CALC_IAsyncCalculator_cloopsumAsyncParameters, 4, 1, 1}
+};
+
+#define CALC_IScanner_VERSION 4
+
+struct CALC_IScanner;
+
+struct CALC_IScannerVTable
+{
+	void* cloopDummy[1];
+	uintptr_t version;
+	void (*dispose)(struct CALC_IScanner* self);
+	unsigned (*countChar)(const struct CALC_IScanner* self, struct cloopStrView text, unsigned char c);
+	struct cloopStrView (*trim)(const struct CALC_IScanner* self, struct CALC_IStatus* status, struct cloopStrView text);
+	unsigned (*checksum)(const struct CALC_IScanner* self, struct cloopBytes in);
+};
+
+struct CALC_IScanner
+{
+	void* cloopDummy[1];
+	struct CALC_IScannerVTable* vtable;
+};
+
+CLOOP_EXTERN_C void CALC_IScanner_dispose(struct CALC_IScanner* self);
+CLOOP_EXTERN_C unsigned CALC_IScanner_countChar(const struct CALC_IScanner* self, struct cloopStrView text, unsigned char c);
+CLOOP_EXTERN_C struct cloopStrView CALC_IScanner_trim(const struct CALC_IScanner* self, struct CALC_IStatus* status, struct cloopStrView text);
+CLOOP_EXTERN_C unsigned CALC_IScanner_checksum(const struct CALC_IScanner* self, struct cloopBytes in);
+
+struct CALC_IScannerTap
+{
+	struct CALC_IScannerVTable vtable;
+	struct CALC_IScannerVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_IScannerTap_install(struct CALC_IScannerTap* tap, struct CALC_IScanner* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_IScannerTap_remove(struct CALC_IScannerTap* tap, struct CALC_IScanner* self);
+
+static const struct cloopParameterInfo CALC_IScanner_cloopcountCharParameters[] =
+{
+	{"text", "struct cloopStrView"},
+	{"c", "unsigned char"}
+};
+
+static const struct cloopParameterInfo CALC_IScanner_clooptrimParameters[] =
+{
+	{"status", "struct CALC_IStatus*"},
+	{"text", "struct cloopStrView"}
+};
+
+static const struct cloopParameterInfo CALC_IScanner_cloopchecksumParameters[] =
+{
+	{"in", "struct cloopBytes"}
+};
+
+#define CALC_IScanner_METHOD_COUNT 4
+
+static const struct cloopMethodInfo CALC_IScanner_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0},
+	{"countChar", 1, 2, "unsigned", CALC_IScanner_cloopcountCharParameters, 2, 1, 0},
+	{"trim", 2, 2, "struct cloopStrView", CALC_IScanner_clooptrimParameters, 2, 1, 1},
+	{"checksum", 3, 2, "unsigned", CALC_IScanner_cloopchecksumParameters, 1, 1, 0}
+};
+
+#define CALC_IGeometry_VERSION 4
+
+struct CALC_IGeometry;
+
+struct CALC_IGeometryVTable
+{
+	void* cloopDummy[1];
+	uintptr_t version;
+	void (*dispose)(struct CALC_IGeometry* self);
+	struct Rectangle (*move)(const struct CALC_IGeometry* self, struct Rectangle rectangle, struct Point offset);
+	int (*area)(const struct CALC_IGeometry* self, const struct Rectangle* rectangle);
+	unsigned (*payload)(const struct CALC_IGeometry* self, struct Header header);
+};
+
+struct CALC_IGeometry
+{
+	void* cloopDummy[1];
+	struct CALC_IGeometryVTable* vtable;
+};
+
+CLOOP_EXTERN_C void CALC_IGeometry_dispose(struct CALC_IGeometry* self);
+CLOOP_EXTERN_C struct Rectangle CALC_IGeometry_move(const struct CALC_IGeometry* self, struct Rectangle rectangle, struct Point offset);
+CLOOP_EXTERN_C int CALC_IGeometry_area(const struct CALC_IGeometry* self, const struct Rectangle* rectangle);
+CLOOP_EXTERN_C unsigned CALC_IGeometry_payload(const struct CALC_IGeometry* self, struct Header header);
+
+struct CALC_IGeometryTap
+{
+	struct CALC_IGeometryVTable vtable;
+	struct CALC_IGeometryVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_IGeometryTap_install(struct CALC_IGeometryTap* tap, struct CALC_IGeometry* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_IGeometryTap_remove(struct CALC_IGeometryTap* tap, struct CALC_IGeometry* self);
+
+static const struct cloopParameterInfo CALC_IGeometry_cloopmoveParameters[] =
+{
+	{"rectangle", "struct Rectangle"},
+	{"offset", "struct Point"}
+};
+
+static const struct cloopParameterInfo CALC_IGeometry_cloopareaParameters[] =
+{
+	{"rectangle", "const struct Rectangle*"}
+};
+
+static const struct cloopParameterInfo CALC_IGeometry_clooppayloadParameters[] =
+{
+	{"header", "struct Header"}
+};
+
+#define CALC_IGeometry_METHOD_COUNT 4
+
+static const struct cloopMethodInfo CALC_IGeometry_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0},
+	{"move", 1, 2, "struct Rectangle", CALC_IGeometry_cloopmoveParameters, 2, 1, 0},
+	{"area", 2, 2, "int", CALC_IGeometry_cloopareaParameters, 1, 1, 0},
+	{"payload", 3, 2, "unsigned", CALC_IGeometry_clooppayloadParameters, 1, 1, 0}
+};
+
+#define CALC_ISeries_VERSION 6
+
+struct CALC_ISeries;
+
+struct CALC_ISeriesVTable
+{
+	void* cloopDummy[1];
+	uintptr_t version;
+	void (*dispose)(struct CALC_ISeries* self);
+	int (*total)(const struct CALC_ISeries* self, const int* values, unsigned count);
+	void (*scale)(const struct CALC_ISeries* self, const int* in, int* out, unsigned count, int factor);
+	unsigned (*histogram)(const struct CALC_ISeries* self, const unsigned char* data, unsigned* counts, unsigned size, unsigned buckets);
+	int (*clamp)(const struct CALC_ISeries* self, int value, int limit);
+	void (*clampBatch)(const struct CALC_ISeries* self, const int* value, const int* limit, int* results, unsigned count);
+};
+
+struct CALC_ISeries
+{
+	void* cloopDummy[1];
+	struct CALC_ISeriesVTable* vtable;
+};
+
+CLOOP_EXTERN_C void CALC_ISeries_dispose(struct CALC_ISeries* self);
+CLOOP_EXTERN_C int CALC_ISeries_total(const struct CALC_ISeries* self, const int* values, unsigned count);
+CLOOP_EXTERN_C void CALC_ISeries_scale(const struct CALC_ISeries* self, const int* in, int* out, unsigned count, int factor);
+CLOOP_EXTERN_C unsigned CALC_ISeries_histogram(const struct CALC_ISeries* self, const unsigned char* data, unsigned* counts, unsigned size, unsigned buckets);
+CLOOP_EXTERN_C int CALC_ISeries_clamp(const struct CALC_ISeries* self, int value, int limit);
+CLOOP_EXTERN_C void CALC_ISeries_clampBatch(const struct CALC_ISeries* self, const int* value, const int* limit, int* results, unsigned count);
+
+struct CALC_ISeriesTap
+{
+	struct CALC_ISeriesVTable vtable;
+	struct CALC_ISeriesVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_ISeriesTap_install(struct CALC_ISeriesTap* tap, struct CALC_ISeries* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_ISeriesTap_remove(struct CALC_ISeriesTap* tap, struct CALC_ISeries* self);
+
+static const struct cloopParameterInfo CALC_ISeries_clooptotalParameters[] =
+{
+	{"values", "const int*"},
+	{"count", "unsigned"}
+};
+
+static const struct cloopParameterInfo CALC_ISeries_cloopscaleParameters[] =
+{
+	{"in", "const int*"},
+	{"out", "int*"},
+	{"count", "unsigned"},
+	{"factor", "int"}
+};
+
+static const struct cloopParameterInfo CALC_ISeries_cloophistogramParameters[] =
+{
+	{"data", "const unsigned char*"},
+	{"counts", "unsigned*"},
+	{"size", "unsigned"},
+	{"buckets", "unsigned"}
+};
+
+static const struct cloopParameterInfo CALC_ISeries_cloopclampParameters[] =
+{
+	{"value", "int"},
+	{"limit", "int"}
+};
+
+static const struct cloopParameterInfo CALC_ISeries_cloopclampBatchParameters[] =
+{
+	{"value", "const int*"},
+	{"limit", "const int*"},
+	{"results", "int*"},
+	{"count", "unsigned"}
+};
+
+#define CALC_ISeries_METHOD_COUNT 6
+
+static const struct cloopMethodInfo CALC_ISeries_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0},
+	{"total", 1, 2, "int", CALC_ISeries_clooptotalParameters, 2, 1, 0},
+	{"scale", 2, 2, "void", CALC_ISeries_cloopscaleParameters, 4, 1, 0},
+	{"histogram", 3, 2, "unsigned", CALC_ISeries_cloophistogramParameters, 4, 1, 0},
+	{"clamp", 4, 2, "int", CALC_ISeries_cloopclampParameters, 2, 1, 0},
+	{"clampBatch", 5, 2, "void", CALC_ISeries_cloopclampBatchParameters, 4, 1, 0}
+};
+
+#define CALC_IPool_VERSION 4
+
+struct CALC_IPool;
+
+struct CALC_IPoolVTable
+{
+	void* cloopDummy[1];
+	uintptr_t version;
+	void (*dispose)(struct CALC_IPool* self);
+	void (*keep)(struct CALC_IPool* self, struct CALC_IAccumulator* accumulator);
+	void (*setName)(struct CALC_IPool* self, const char* name);
+	int (*total)(const struct CALC_IPool* self);
+};
+
+struct CALC_IPool
+{
+	void* cloopDummy[1];
+	struct CALC_IPoolVTable* vtable;
+};
+
+CLOOP_EXTERN_C void CALC_IPool_dispose(struct CALC_IPool* self);
+CLOOP_EXTERN_C void CALC_IPool_keep(struct CALC_IPool* self, struct CALC_IAccumulator* accumulator);
+CLOOP_EXTERN_C void CALC_IPool_setName(struct CALC_IPool* self, const char* name);
+CLOOP_EXTERN_C int CALC_IPool_total(const struct CALC_IPool* self);
+
+struct CALC_IPoolTap
+{
+	struct CALC_IPoolVTable vtable;
+	struct CALC_IPoolVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_IPoolTap_install(struct CALC_IPoolTap* tap, struct CALC_IPool* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_IPoolTap_remove(struct CALC_IPoolTap* tap, struct CALC_IPool* self);
+
+static const struct cloopParameterInfo CALC_IPool_cloopkeepParameters[] =
+{
+	{"accumulator", "struct CALC_IAccumulator*"}
+};
+
+static const struct cloopParameterInfo CALC_IPool_cloopsetNameParameters[] =
+{
+	{"name", "const char*"}
+};
+
+#define CALC_IPool_METHOD_COUNT 4
+
+static const struct cloopMethodInfo CALC_IPool_cloopMethods[] =
+{
+	{"dispose", 0, 1, "void", 0, 0, 0, 0},
+	{"keep", 1, 2, "void", CALC_IPool_cloopkeepParameters, 1, 0, 0},
+	{"setName", 2, 2, "void", CALC_IPool_cloopsetNameParameters, 1, 0, 0},
+	{"total", 3, 2, "int", 0, 0, 1, 0}
+};
+
+#define CALC_IAsyncCalculatorSumCompletion_VERSION 1
+
+struct CALC_IAsyncCalculatorSumCompletion;
+
+struct CALC_IAsyncCalculatorSumCompletionVTable
+{
+	void* cloopDummy[1];
+	uintptr_t version;
+	void (*complete)(struct CALC_IAsyncCalculatorSumCompletion* self, struct CALC_IStatus* status, int result);
+};
+
+struct CALC_IAsyncCalculatorSumCompletion
+{
+	void* cloopDummy[1];
+	struct CALC_IAsyncCalculatorSumCompletionVTable* vtable;
+};
+
+CLOOP_EXTERN_C void CALC_IAsyncCalculatorSumCompletion_complete(struct CALC_IAsyncCalculatorSumCompletion* self, struct CALC_IStatus* status, int result);
+
+struct CALC_IAsyncCalculatorSumCompletionTap
+{
+	struct CALC_IAsyncCalculatorSumCompletionVTable vtable;
+	struct CALC_IAsyncCalculatorSumCompletionVTable* original;
+	struct cloopTapHooks hooks;
+};
+
+CLOOP_EXTERN_C void CALC_IAsyncCalculatorSumCompletionTap_install(struct CALC_IAsyncCalculatorSumCompletionTap* tap, struct CALC_IAsyncCalculatorSumCompletion* self, const struct cloopTapHooks* hooks);
+CLOOP_EXTERN_C void CALC_IAsyncCalculatorSumCompletionTap_remove(struct CALC_IAsyncCalculatorSumCompletionTap* tap, struct CALC_IAsyncCalculatorSumCompletion* self);
+
+static const struct cloopParameterInfo CALC_IAsyncCalculatorSumCompletion_cloopcompleteParameters[] =
+{
+	{"status", "struct CALC_IStatus*"},
+	{"result", "int"}
+};
+
+#define CALC_IAsyncCalculatorSumCompletion_METHOD_COUNT 1
+
+static const struct cloopMethodInfo CALC_IAsyncCalculatorSumCompletion_cloopMethods[] =
+{
+	{"complete", 0, 1, "void", CALC_IAsyncCalculatorSumCompletion_cloopcompleteParameters, 2, 0, 0}
+};
+
+#define CALC_IDisposable_dispose_COMMAND (((uint64_t) 2 << 32) | (0u << 16) | 0u)
+#define CALC_ICalculator_sum_COMMAND (((uint64_t) 5 << 32) | (4u << 16) | 1u)
+#define CALC_ICalculator_getMemory_COMMAND (((uint64_t) 3 << 32) | (4u << 16) | 2u)
+#define CALC_ICalculator_setMemory_COMMAND (((uint64_t) 3 << 32) | (4u << 16) | 3u)
+#define CALC_ICalculator_sumAndStore_COMMAND (((uint64_t) 4 << 32) | (4u << 16) | 4u)
+#define CALC_ICalculator2_multiply_COMMAND (((uint64_t) 5 << 32) | (5u << 16) | 5u)
+#define CALC_ICalculator2_copyMemory_COMMAND (((uint64_t) 3 << 32) | (5u << 16) | 6u)
+#define CALC_ICalculator2_copyMemory2_COMMAND (((uint64_t) 3 << 32) | (5u << 16) | 7u)
+#define CALC_ICalculator2_multiplyBatch_COMMAND (((uint64_t) 6 << 32) | (5u << 16) | 8u)
+
+CLOOP_EXTERN_C unsigned CALC_ICommands_execute(struct CALC_IStatus* status, uint64_t* cells, unsigned size);
 
 
 #endif	// CALC_C_API_H
@@ -7,6 +7,94 @@
 #define CLOOP_CARG
 #endif
 
+#ifndef CLOOP_NO_EXCEPTIONS
+#if !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+#define CLOOP_NO_EXCEPTIONS
+#endif
+#endif
+
+#ifndef CLOOP_PROBE
+#if defined(__GNUC__) && defined(__ELF__) && defined(__x86_64__)
+#define CLOOP_PROBE(provider, name, interfaceIndex, slot, self) \
+	__asm__ __volatile__ ( \
+		"990: nop\n" \
+		".pushsection .note.stapsdt, \"\", \"note\"\n" \
+		".balign 4\n" \
+		".4byte 992f-991f, 994f-993f, 3\n" \
+		"991: .asciz \"stapsdt\"\n" \
+		"992: .balign 4\n" \
+		"993: .8byte 990b\n" \
+		".8byte _.stapsdt.base\n" \
+		".8byte 0\n" \
+		".asciz \"" #provider "\"\n" \
+		".asciz \"" #name "\"\n" \
+		".asciz \"4@%0 4@%1 8@%2\"\n" \
+		"994: .balign 4\n" \
+		".popsection\n" \
+		".ifndef _.stapsdt.base\n" \
+		".pushsection .stapsdt.base, \"aG\", \"progbits\", .stapsdt.base, comdat\n" \
+		".weak _.stapsdt.base\n" \
+		".hidden _.stapsdt.base\n" \
+		"_.stapsdt.base: .space 1\n" \
+		".size _.stapsdt.base, 1\n" \
+		".popsection\n" \
+		".endif\n" \
+		: : "nor" ((unsigned) (interfaceIndex)), "nor" ((unsigned) (slot)), \
+			"nor" ((const void*) (self)))
+#else
+#define CLOOP_PROBE(provider, name, interfaceIndex, slot, self)
+#endif
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <new>
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#include <atomic>
+#include <chrono>
+#include <string.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#endif
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#include <condition_variable>
+#include <thread>
+#endif
+
+#if __cplusplus >= 201103L && defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#include <coroutine>
+#include <exception>
+#define CLOOP_COROUTINES
+#endif
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#include <string_view>
+#define CLOOP_STRING_VIEW
+#endif
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#include <span>
+#include <stdlib.h>
+#define CLOOP_SPAN
+#endif
+
 
 namespace calc
 {
@@ -24,865 +112,9488 @@ namespace calc
 		}
 	};
 
-	// Forward interfaces declarations
-
-	class IDisposable;
-	class IStatus;
-	class IStatusFactory;
-	class IFactory;
-	class ICalculator;
-	class ICalculator2;
+	template <typename E>
+	class Unexpected
+	{
+	public:
+		explicit Unexpected(const E& error)
+			: error(error)
+		{
+		}
 
-	// Interfaces declarations
+	public:
+		E error;
+	};
 
-	class IDisposable
+	template <typename T, typename E>
+	class Expected
 	{
 	public:
-		struct VTable
+		Expected(const T& value)
+			: valid(true),
+			  val(value),
+			  err()
 		{
-			void* cloopDummy[1];
-			uintptr_t version;
-			void (CLOOP_CARG *dispose)(IDisposable* self) throw();
-		};
+		}
 
-		void* cloopDummy[1];
-		VTable* cloopVTable;
+		Expected(const Unexpected<E>& unexpected)
+			: valid(false),
+			  val(),
+			  err(unexpected.error)
+		{
+		}
 
-	protected:
-		IDisposable(DoNotInherit)
+		bool hasValue() const
 		{
+			return valid;
 		}
 
-		~IDisposable()
+		const T& value() const
 		{
+			return val;
 		}
 
-	public:
-		static const unsigned VERSION = 1;
+		T valueOr(const T& defaultValue) const
+		{
+			return valid ? val : defaultValue;
+		}
 
-		void dispose()
+		const E& error() const
 		{
-			static_cast<VTable*>(this->cloopVTable)->dispose(this);
+			return err;
 		}
+
+	private:
+		bool valid;
+		T val;
+		E err;
 	};
 
-	class IStatus : public IDisposable
+	template <typename E>
+	class Expected<void, E>
 	{
 	public:
-		struct VTable : public IDisposable::VTable
+		Expected()
+			: valid(true),
+			  err()
 		{
-			int (CLOOP_CARG *getCode)(const IStatus* self) throw();
-			void (CLOOP_CARG *setCode)(IStatus* self, int code) throw();
-		};
+		}
 
-	protected:
-		IStatus(DoNotInherit)
-			: IDisposable(DoNotInherit())
+		Expected(const Unexpected<E>& unexpected)
+			: valid(false),
+			  err(unexpected.error)
 		{
 		}
 
-		~IStatus()
+		bool hasValue() const
 		{
+			return valid;
 		}
 
-	public:
-		static const unsigned VERSION = 2;
+		const E& error() const
+		{
+			return err;
+		}
 
-		static const int ERROR_1 = 1;
-		static const int ERROR_2 = 0x2;
-		static const int ERROR_12 = IStatus::ERROR_1 | IStatus::ERROR_2;
+	private:
+		bool valid;
+		E err;
+	};
 
-		int getCode() const
+	struct NoTracePolicy
+	{
+		static void enter(unsigned /*interfaceIndex*/, unsigned /*slot*/)
 		{
-			int ret = static_cast<VTable*>(this->cloopVTable)->getCode(this);
-			return ret;
 		}
 
-		void setCode(int code)
+		static void failed(unsigned /*interfaceIndex*/, unsigned /*slot*/)
+		{
+		}
+
+		static void exit(unsigned /*interfaceIndex*/, unsigned /*slot*/)
 		{
-			static_cast<VTable*>(this->cloopVTable)->setCode(this, code);
 		}
 	};
 
-	class IStatusFactory : public IDisposable
+	template <typename Name>
+	struct TraceTraits
+	{
+		typedef NoTracePolicy Policy;
+	};
+
+	template <typename TracePolicy>
+	class TraceScope
 	{
 	public:
-		struct VTable : public IDisposable::VTable
+		TraceScope(unsigned interfaceIndex, unsigned slot)
+			: interfaceIndex(interfaceIndex),
+			  slot(slot)
 		{
-			IStatus* (CLOOP_CARG *createStatus)(IStatusFactory* self) throw();
-		};
+			TracePolicy::enter(interfaceIndex, slot);
+		}
 
-	protected:
-		IStatusFactory(DoNotInherit)
-			: IDisposable(DoNotInherit())
+		~TraceScope()
 		{
+			TracePolicy::exit(interfaceIndex, slot);
 		}
 
-		~IStatusFactory()
+		void failed()
 		{
+			TracePolicy::failed(interfaceIndex, slot);
 		}
 
-	public:
-		static const unsigned VERSION = 2;
+	private:
+		unsigned interfaceIndex;
+		unsigned slot;
+	};
 
-		IStatus* createStatus()
-		{
-			IStatus* ret = static_cast<VTable*>(this->cloopVTable)->createStatus(this);
-			return ret;
-		}
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+	struct TraceRecord
+	{
+		uint64_t timestamp;
+		uint64_t duration;
+		uint16_t interfaceIndex;
+		uint16_t slot;
+		uint16_t depth;
+
+		// 1 when the call failed, with an error in its status or an exception. Wrappers
+		// only see the error flag of the status, so its code is not recorded.
+		uint16_t failed;
 	};
 
-	class IFactory : public IDisposable
+	class TraceRing
 	{
 	public:
-		struct VTable : public IDisposable::VTable
-		{
-			IStatus* (CLOOP_CARG *createStatus)(IFactory* self) throw();
-			ICalculator* (CLOOP_CARG *createCalculator)(IFactory* self, IStatus* status) throw();
-			ICalculator2* (CLOOP_CARG *createCalculator2)(IFactory* self, IStatus* status) throw();
-			ICalculator* (CLOOP_CARG *createBrokenCalculator)(IFactory* self, IStatus* status) throw();
-			void (CLOOP_CARG *setStatusFactory)(IFactory* self, IStatusFactory* statusFactory) throw();
-		};
+		static const unsigned SIZE = 4096;
+		static const unsigned MAX_DEPTH = 64;
 
-	protected:
-		IFactory(DoNotInherit)
-			: IDisposable(DoNotInherit())
+		static TraceRing& current()
 		{
+			static thread_local TraceRing ring;
+			return ring;
 		}
 
-		~IFactory()
+		static uint64_t now()
 		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
 		}
 
-	public:
-		static const unsigned VERSION = 2;
+		void enter()
+		{
+			if (depth < MAX_DEPTH)
+			{
+				starts[depth] = now();
+				failures[depth] = 0;
+			}
 
-		IStatus* createStatus()
+			++depth;
+		}
+
+		void fail()
 		{
-			IStatus* ret = static_cast<VTable*>(this->cloopVTable)->createStatus(this);
-			return ret;
+			if (depth - 1 < MAX_DEPTH)
+				failures[depth - 1] = 1;
 		}
 
-		template <typename StatusType> ICalculator* createCalculator(StatusType* status)
+		void exit(unsigned interfaceIndex, unsigned slot)
 		{
-			StatusType::clearException(status);
-			ICalculator* ret = static_cast<VTable*>(this->cloopVTable)->createCalculator(this, status);
-			StatusType::checkException(status);
-			return ret;
+			if (--depth >= MAX_DEPTH)
+				return;
+
+			TraceRecord& record = records[count++ % SIZE];
+			record.timestamp = starts[depth];
+			record.duration = now() - starts[depth];
+			record.interfaceIndex = (uint16_t) interfaceIndex;
+			record.slot = (uint16_t) slot;
+			record.depth = (uint16_t) depth;
+			record.failed = failures[depth];
 		}
 
-		template <typename StatusType> ICalculator2* createCalculator2(StatusType* status)
+		// Number of records written, including the ones overwritten.
+		uint64_t size() const
 		{
-			StatusType::clearException(status);
-			ICalculator2* ret = static_cast<VTable*>(this->cloopVTable)->createCalculator2(this, status);
-			StatusType::checkException(status);
-			return ret;
+			return count;
 		}
 
-		template <typename StatusType> ICalculator* createBrokenCalculator(StatusType* status)
+		const TraceRecord& operator [](uint64_t n) const
 		{
-			StatusType::clearException(status);
-			ICalculator* ret = static_cast<VTable*>(this->cloopVTable)->createBrokenCalculator(this, status);
-			StatusType::checkException(status);
-			return ret;
+			return records[n % SIZE];
 		}
 
-		void setStatusFactory(IStatusFactory* statusFactory)
+		// Writes the ring of this thread only. The rings are not locked, so each thread
+		// dumps its own, to a file of its own, and cloop-trace decodes them together.
+		bool dump(const char* filename) const
 		{
-			static_cast<VTable*>(this->cloopVTable)->setStatusFactory(this, statusFactory);
+			FILE* file = fopen(filename, "wb");
+
+			if (!file)
+				return false;
+
+			uint64_t first = count > SIZE ? count - SIZE : 0;
+			uint32_t header[4] = {0x504F4F4Cu, 1, (uint32_t) sizeof(TraceRecord), (uint32_t) (count - first)};
+			bool ok = fwrite(header, sizeof(header), 1, file) == 1;
+
+			for (uint64_t n = first; ok && n < count; ++n)
+				ok = fwrite(&(*this)[n], sizeof(TraceRecord), 1, file) == 1;
+
+			return fclose(file) == 0 && ok;
 		}
+
+	private:
+		TraceRecord records[SIZE];
+		uint64_t count;
+		uint64_t starts[MAX_DEPTH];
+		uint16_t failures[MAX_DEPTH];
+		unsigned depth;
 	};
 
-	class ICalculator : public IDisposable
+	struct RingTracePolicy
 	{
-	public:
-		struct VTable : public IDisposable::VTable
+		static void enter(unsigned /*interfaceIndex*/, unsigned /*slot*/)
 		{
-			int (CLOOP_CARG *sum)(const ICalculator* self, IStatus* status, int n1, int n2) throw();
-			int (CLOOP_CARG *getMemory)(const ICalculator* self) throw();
-			void (CLOOP_CARG *setMemory)(ICalculator* self, int n) throw();
-			void (CLOOP_CARG *sumAndStore)(ICalculator* self, IStatus* status, int n1, int n2) throw();
-		};
+			TraceRing::current().enter();
+		}
 
-	protected:
-		ICalculator(DoNotInherit)
-			: IDisposable(DoNotInherit())
+		static void failed(unsigned /*interfaceIndex*/, unsigned /*slot*/)
 		{
+			TraceRing::current().fail();
 		}
 
-		~ICalculator()
+		static void exit(unsigned interfaceIndex, unsigned slot)
 		{
+			TraceRing::current().exit(interfaceIndex, slot);
 		}
+	};
+#endif
 
+	class ProbeScope
+	{
 	public:
-		static const unsigned VERSION = 4;
+		ProbeScope(unsigned interfaceIndex, unsigned slot, const void* self)
+			: interfaceIndex(interfaceIndex),
+			  slot(slot),
+			  self(self)
+		{
+			CLOOP_PROBE(calc, enter, interfaceIndex, slot, self);
+		}
 
-		template <typename StatusType> int sum(StatusType* status, int n1, int n2) const
+		~ProbeScope()
 		{
-			StatusType::clearException(status);
-			int ret = static_cast<VTable*>(this->cloopVTable)->sum(this, status, n1, n2);
-			StatusType::checkException(status);
-			return ret;
+			CLOOP_PROBE(calc, exit, interfaceIndex, slot, self);
 		}
 
-		int getMemory() const
+	private:
+		unsigned interfaceIndex;
+		unsigned slot;
+		const void* self;
+	};
+
+	template <typename T>
+	struct CommandCell
+	{
+		static uint64_t encode(T value)
 		{
-			if (cloopVTable->version < 3)
-			{
-				return IStatus::ERROR_1;
-			}
-			int ret = static_cast<VTable*>(this->cloopVTable)->getMemory(this);
-			return ret;
+			return (uint64_t) value;
 		}
 
-		void setMemory(int n)
+		static T decode(uint64_t cell)
 		{
-			if (cloopVTable->version < 3)
-			{
-				return;
-			}
-			static_cast<VTable*>(this->cloopVTable)->setMemory(this, n);
+			return (T) cell;
 		}
+	};
 
-		template <typename StatusType> void sumAndStore(StatusType* status, int n1, int n2)
+	template <typename T>
+	struct CommandCell<T*>
+	{
+		static uint64_t encode(T* value)
 		{
-			if (cloopVTable->version < 4)
-			{
-				StatusType::setVersionError(status, "ICalculator", cloopVTable->version, 4);
-				StatusType::checkException(status);
-				return;
-			}
-			StatusType::clearException(status);
-			static_cast<VTable*>(this->cloopVTable)->sumAndStore(this, status, n1, n2);
-			StatusType::checkException(status);
+			return (uint64_t) (uintptr_t) value;
+		}
+
+		static T* decode(uint64_t cell)
+		{
+			return (T*) (uintptr_t) cell;
 		}
 	};
 
-	class ICalculator2 : public ICalculator
+	class CommandBuffer
 	{
 	public:
-		struct VTable : public ICalculator::VTable
+		CommandBuffer()
+			: cells(0),
+			  count(0),
+			  capacity(0)
 		{
-			int (CLOOP_CARG *multiply)(const ICalculator2* self, IStatus* status, int n1, int n2) throw();
-			void (CLOOP_CARG *copyMemory)(ICalculator2* self, const ICalculator* calculator) throw();
-			void (CLOOP_CARG *copyMemory2)(ICalculator2* self, const int* address) throw();
-		};
+		}
 
-	protected:
-		ICalculator2(DoNotInherit)
-			: ICalculator(DoNotInherit())
+		~CommandBuffer()
 		{
+			delete[] cells;
 		}
 
-		~ICalculator2()
+	private:
+		CommandBuffer(const CommandBuffer&);
+		CommandBuffer& operator =(const CommandBuffer&);
+
+	public:
+		static uint64_t header(unsigned size, unsigned interfaceIndex, unsigned slot)
 		{
+			return ((uint64_t) size << 32) | ((uint64_t) interfaceIndex << 16) | slot;
 		}
 
-	public:
-		static const unsigned VERSION = 6;
+		uint64_t* append(unsigned size)
+		{
+			if (count + size > capacity)
+			{
+				unsigned newCapacity = capacity ? capacity * 2 : 64;
 
-		template <typename StatusType> int multiply(StatusType* status, int n1, int n2) const
+				while (newCapacity < count + size)
+					newCapacity *= 2;
+
+				uint64_t* newCells = new uint64_t[newCapacity];
+
+				for (unsigned i = 0; i < count; ++i)
+					newCells[i] = cells[i];
+
+				delete[] cells;
+				cells = newCells;
+				capacity = newCapacity;
+			}
+
+			uint64_t* command = cells + count;
+			count += size;
+			return command;
+		}
+
+		void clear()
 		{
-			StatusType::clearException(status);
-			int ret = static_cast<VTable*>(this->cloopVTable)->multiply(this, status, n1, n2);
-			StatusType::checkException(status);
-			return ret;
+			count = 0;
 		}
 
-		void copyMemory(const ICalculator* calculator)
+		uint64_t* data() const
 		{
-			static_cast<VTable*>(this->cloopVTable)->copyMemory(this, calculator);
+			return cells;
 		}
 
-		void copyMemory2(const int* address)
+		unsigned size() const
 		{
-			if (cloopVTable->version < 6)
-			{
-				return;
-			}
-			static_cast<VTable*>(this->cloopVTable)->copyMemory2(this, address);
+			return count;
 		}
-	};
 
-	// Interfaces implementations
+	private:
+		uint64_t* cells;
+		unsigned count;
+		unsigned capacity;
+	};
 
-	template <typename Name, typename StatusType, typename Base>
-	class IDisposableBaseImpl : public Base
+	struct DefaultAllocator
 	{
-	public:
-		typedef IDisposable Declaration;
+		static void* allocate(size_t size)
+		{
+			return ::operator new(size);
+		}
 
-		IDisposableBaseImpl(DoNotInherit = DoNotInherit())
+		static void* allocate(size_t size, const std::nothrow_t&)
 		{
-			static struct VTableImpl : Base::VTable
-			{
+			return ::operator new(size, std::nothrow);
+		}
+
+		static void deallocate(void* ptr, size_t /*size*/)
+		{
+			::operator delete(ptr);
+		}
+
+#ifdef __cpp_aligned_new
+		static void* allocate(size_t size, std::align_val_t alignment)
+		{
+			return ::operator new(size, alignment);
+		}
+
+		static void* allocate(size_t size, std::align_val_t alignment, const std::nothrow_t&)
+		{
+			return ::operator new(size, alignment, std::nothrow);
+		}
+
+		static void deallocate(void* ptr, size_t /*size*/, std::align_val_t alignment)
+		{
+			::operator delete(ptr, alignment);
+		}
+#endif
+	};
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+	struct AcquireReleaseRefCount
+	{
+		static const std::memory_order INCREMENT = std::memory_order_relaxed;
+		static const std::memory_order DECREMENT = std::memory_order_acq_rel;
+	};
+
+	struct RelaxedRefCount
+	{
+		static const std::memory_order INCREMENT = std::memory_order_relaxed;
+		static const std::memory_order DECREMENT = std::memory_order_relaxed;
+	};
+
+	template <typename Name>
+	struct RefCountTraits
+	{
+		typedef AcquireReleaseRefCount Order;
+	};
+
+	template <typename T>
+	class Ref
+	{
+	public:
+		Ref()
+			: ptr(0)
+		{
+		}
+
+		explicit Ref(T* ptr)
+			: ptr(ptr)
+		{
+		}
+
+		Ref(const Ref& other)
+			: ptr(other.ptr)
+		{
+			if (ptr)
+				ptr->addRef();
+		}
+
+		Ref(Ref&& other) noexcept
+			: ptr(other.ptr)
+		{
+			other.ptr = 0;
+		}
+
+		~Ref()
+		{
+			if (ptr)
+				ptr->release();
+		}
+
+		Ref& operator =(const Ref& other)
+		{
+			if (other.ptr)
+				other.ptr->addRef();
+			reset(other.ptr);
+			return *this;
+		}
+
+		Ref& operator =(Ref&& other) noexcept
+		{
+			if (this != &other)
+				reset(other.detach());
+			return *this;
+		}
+
+		T* operator ->() const
+		{
+			return ptr;
+		}
+
+		T* get() const
+		{
+			return ptr;
+		}
+
+		// Gives up the reference without releasing it.
+		T* detach()
+		{
+			T* ret = ptr;
+			ptr = 0;
+			return ret;
+		}
+
+		void reset(T* newPtr = 0)
+		{
+			T* oldPtr = ptr;
+			ptr = newPtr;
+
+			if (oldPtr)
+				oldPtr->release();
+		}
+
+	private:
+		T* ptr;
+	};
+#endif
+
+	template <typename StatusType>
+	struct StatusTraits;
+
+	// Length-carrying views, laid out as cloopStrView and cloopBytes of the C API, so text and data
+	// are passed without scanning for a terminator.
+	struct StrView
+	{
+		StrView()
+			: data(0),
+			  length(0)
+		{
+		}
+		StrView(const char* data, size_t length)
+			: data(data),
+			  length(length)
+		{
+		}
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+		StrView(const std::string& str)
+			: data(str.data()),
+			  length(str.length())
+		{
+		}
+#endif
+
+#ifdef CLOOP_STRING_VIEW
+		StrView(std::string_view view)
+			: data(view.data()),
+			  length(view.length())
+		{
+		}
+
+		operator std::string_view() const
+		{
+			return std::string_view(data, (size_t) length);
+		}
+#endif
+
+		const char* data;
+		uint64_t length;
+	};
+
+	struct Bytes
+	{
+		Bytes()
+			: data(0),
+			  length(0)
+		{
+		}
+
+		Bytes(const void* data, size_t length)
+			: data(static_cast<const unsigned char*>(data)),
+			  length(length)
+		{
+		}
+
+#ifdef CLOOP_SPAN
+		Bytes(std::span<const unsigned char> span)
+			: data(span.data()),
+			  length(span.size())
+		{
+		}
+
+		operator std::span<const unsigned char>() const
+		{
+			return std::span<const unsigned char>(data, (size_t) length);
+		}
+#endif
+
+		const unsigned char* data;
+		uint64_t length;
+	};
+
+	// Forward interfaces declarations
+
+	class IDisposable;
+	class IStatus;
+	class IStatusFactory;
+	class IFactory;
+	class ICalculator;
+	class ICalculator2;
+	class ICounter;
+	class IReferenceCounted;
+	class IAccumulator;
+	class IQueryable;
+	class IReader;
+	class IWriter;
+	class IAsyncCalculator;
+	class IScanner;
+	class IGeometry;
+	class ISeries;
+	class IPool;
+	class IAsyncCalculatorSumCompletion;
+
+#ifndef CLOOP_ALIGN
+#if defined(_MSC_VER)
+#define CLOOP_ALIGN(n) __declspec(align(n))
+#else
+#define CLOOP_ALIGN(n) __attribute__((aligned(n)))
+#endif
+#endif
+
+	struct Point
+	{
+		int x;
+		int y;
+	};
+
+	struct CLOOP_ALIGN(8) Size
+	{
+		unsigned width;
+		unsigned height;
+	};
+
+#pragma pack(push, 1)
+	struct Header
+	{
+		unsigned char kind;
+		unsigned length;
+	};
+#pragma pack(pop)
+
+	struct Rectangle
+	{
+		Point origin;
+		Size extent;
+	};
+
+#ifdef CLOOP_COROUTINES
+	template <typename StatusType> class IAsyncCalculatorSumAwaiter;
+#endif
+
+	// Interfaces declarations
+
+	class IDisposable
+	{
+	public:
+		struct VTable
+		{
+			void* cloopDummy[1];
+			uintptr_t version;
+			void (CLOOP_CARG *dispose)(IDisposable* self) throw();
+		};
+
+		void* cloopDummy[1];
+		VTable* cloopVTable;
+
+	protected:
+		IDisposable(DoNotInherit)
+		{
+		}
+
+		~IDisposable()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 1;
+
+		void dispose()
+		{
+			dispose<NoTracePolicy>();
+		}
+
+		template <typename TracePolicy> void dispose()
+		{
+			TraceScope<TracePolicy> cloopTrace(0, 0);
+
+			static_cast<VTable*>(this->cloopVTable)->dispose(this);
+		}
+	};
+
+	class IStatus : public IDisposable
+	{
+	public:
+		struct VTable : public IDisposable::VTable
+		{
+			int (CLOOP_CARG *getCode)(const IStatus* self) throw();
+			void (CLOOP_CARG *setCode)(IStatus* self, int code) throw();
+		};
+
+		int cloopErrorFlag;
+
+	protected:
+		IStatus(DoNotInherit)
+			: IDisposable(DoNotInherit()),
+			  cloopErrorFlag(0)
+		{
+		}
+
+		~IStatus()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 2;
+
+		static const int ERROR_1 = 1;
+		static const int ERROR_2 = 0x2;
+		static const int ERROR_12 = IStatus::ERROR_1 | IStatus::ERROR_2;
+
+		int getCode() const
+		{
+			return getCode<NoTracePolicy>();
+		}
+
+		template <typename TracePolicy> int getCode() const
+		{
+			TraceScope<TracePolicy> cloopTrace(1, 1);
+
+			int ret = static_cast<VTable*>(this->cloopVTable)->getCode(this);
+			return ret;
+		}
+
+		void setCode(int code)
+		{
+			setCode<NoTracePolicy>(code);
+		}
+
+		template <typename TracePolicy> void setCode(int code)
+		{
+			TraceScope<TracePolicy> cloopTrace(1, 2);
+
+			static_cast<VTable*>(this->cloopVTable)->setCode(this, code);
+		}
+	};
+
+	class IStatusFactory : public IDisposable
+	{
+	public:
+		struct VTable : public IDisposable::VTable
+		{
+			IStatus* (CLOOP_CARG *createStatus)(IStatusFactory* self) throw();
+		};
+
+	protected:
+		IStatusFactory(DoNotInherit)
+			: IDisposable(DoNotInherit())
+		{
+		}
+
+		~IStatusFactory()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 2;
+
+		IStatus* createStatus()
+		{
+			return createStatus<NoTracePolicy>();
+		}
+
+		template <typename TracePolicy> IStatus* createStatus()
+		{
+			TraceScope<TracePolicy> cloopTrace(2, 1);
+
+			IStatus* ret = static_cast<VTable*>(this->cloopVTable)->createStatus(this);
+			return ret;
+		}
+	};
+
+	class IFactory : public IDisposable
+	{
+	public:
+		struct VTable : public IDisposable::VTable
+		{
+			IStatus* (CLOOP_CARG *createStatus)(IFactory* self) throw();
+			ICalculator* (CLOOP_CARG *createCalculator)(IFactory* self, IStatus* status) throw();
+			ICalculator2* (CLOOP_CARG *createCalculator2)(IFactory* self, IStatus* status) throw();
+			ICalculator* (CLOOP_CARG *createBrokenCalculator)(IFactory* self, IStatus* status) throw();
+			void (CLOOP_CARG *setStatusFactory)(IFactory* self, IStatusFactory* statusFactory) throw();
+		};
+
+	protected:
+		IFactory(DoNotInherit)
+			: IDisposable(DoNotInherit())
+		{
+		}
+
+		~IFactory()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 2;
+
+		IStatus* createStatus()
+		{
+			return createStatus<NoTracePolicy>();
+		}
+
+		template <typename TracePolicy> IStatus* createStatus()
+		{
+			TraceScope<TracePolicy> cloopTrace(3, 1);
+
+			IStatus* ret = static_cast<VTable*>(this->cloopVTable)->createStatus(this);
+			return ret;
+		}
+
+		template <typename StatusType> ICalculator* createCalculator(StatusType* status)
+		{
+			return createCalculator<NoTracePolicy, StatusType>(status);
+		}
+
+		template <typename TracePolicy, typename StatusType> ICalculator* createCalculator(StatusType* status)
+		{
+			TraceScope<TracePolicy> cloopTrace(3, 2);
+
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			ICalculator* ret = static_cast<VTable*>(this->cloopVTable)->createCalculator(this, status);
+			if (status->cloopErrorFlag)
+			{
+				cloopTrace.failed();
+				StatusTraits<StatusType>::checkException(status);
+			}
+			return ret;
+		}
+
+		template <typename StatusType> Expected<ICalculator*, typename StatusType::Error> try_createCalculator(StatusType* status)
+		{
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			ICalculator* ret = static_cast<VTable*>(this->cloopVTable)->createCalculator(this, status);
+			if (StatusType::hasError(status))
+				return Unexpected<typename StatusType::Error>(StatusType::getError(status));
+			return ret;
+		}
+
+		template <typename StatusType> ICalculator2* createCalculator2(StatusType* status)
+		{
+			return createCalculator2<NoTracePolicy, StatusType>(status);
+		}
+
+		template <typename TracePolicy, typename StatusType> ICalculator2* createCalculator2(StatusType* status)
+		{
+			TraceScope<TracePolicy> cloopTrace(3, 3);
+
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			ICalculator2* ret = static_cast<VTable*>(this->cloopVTable)->createCalculator2(this, status);
+			if (status->cloopErrorFlag)
+			{
+				cloopTrace.failed();
+				StatusTraits<StatusType>::checkException(status);
+			}
+			return ret;
+		}
+
+		template <typename StatusType> Expected<ICalculator2*, typename StatusType::Error> try_createCalculator2(StatusType* status)
+		{
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			ICalculator2* ret = static_cast<VTable*>(this->cloopVTable)->createCalculator2(this, status);
+			if (StatusType::hasError(status))
+				return Unexpected<typename StatusType::Error>(StatusType::getError(status));
+			return ret;
+		}
+
+		template <typename StatusType> ICalculator* createBrokenCalculator(StatusType* status)
+		{
+			return createBrokenCalculator<NoTracePolicy, StatusType>(status);
+		}
+
+		template <typename TracePolicy, typename StatusType> ICalculator* createBrokenCalculator(StatusType* status)
+		{
+			TraceScope<TracePolicy> cloopTrace(3, 4);
+
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			ICalculator* ret = static_cast<VTable*>(this->cloopVTable)->createBrokenCalculator(this, status);
+			if (status->cloopErrorFlag)
+			{
+				cloopTrace.failed();
+				StatusTraits<StatusType>::checkException(status);
+			}
+			return ret;
+		}
+
+		template <typename StatusType> Expected<ICalculator*, typename StatusType::Error> try_createBrokenCalculator(StatusType* status)
+		{
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			ICalculator* ret = static_cast<VTable*>(this->cloopVTable)->createBrokenCalculator(this, status);
+			if (StatusType::hasError(status))
+				return Unexpected<typename StatusType::Error>(StatusType::getError(status));
+			return ret;
+		}
+
+		void setStatusFactory(IStatusFactory* statusFactory)
+		{
+			setStatusFactory<NoTracePolicy>(statusFactory);
+		}
+
+		template <typename TracePolicy> void setStatusFactory(IStatusFactory* statusFactory)
+		{
+			TraceScope<TracePolicy> cloopTrace(3, 5);
+
+			static_cast<VTable*>(this->cloopVTable)->setStatusFactory(this, statusFactory);
+		}
+	};
+
+	class ICalculator : public IDisposable
+	{
+	public:
+		struct VTable : public IDisposable::VTable
+		{
+			int (CLOOP_CARG *sum)(const ICalculator* self, IStatus* status, int n1, int n2) throw();
+			int (CLOOP_CARG *getMemory)(const ICalculator* self) throw();
+			void (CLOOP_CARG *setMemory)(ICalculator* self, int n) throw();
+			void (CLOOP_CARG *sumAndStore)(ICalculator* self, IStatus* status, int n1, int n2) throw();
+		};
+
+	protected:
+		ICalculator(DoNotInherit)
+			: IDisposable(DoNotInherit())
+		{
+		}
+
+		~ICalculator()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 4;
+
+		template <typename StatusType> int sum(StatusType* status, int n1, int n2) const
+		{
+			return sum<NoTracePolicy, StatusType>(status, n1, n2);
+		}
+
+		template <typename TracePolicy, typename StatusType> int sum(StatusType* status, int n1, int n2) const
+		{
+			TraceScope<TracePolicy> cloopTrace(4, 1);
+
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			int ret = static_cast<VTable*>(this->cloopVTable)->sum(this, status, n1, n2);
+			if (status->cloopErrorFlag)
+			{
+				cloopTrace.failed();
+				StatusTraits<StatusType>::checkException(status);
+			}
+			return ret;
+		}
+
+		template <typename StatusType> Expected<int, typename StatusType::Error> try_sum(StatusType* status, int n1, int n2) const
+		{
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			int ret = static_cast<VTable*>(this->cloopVTable)->sum(this, status, n1, n2);
+			if (StatusType::hasError(status))
+				return Unexpected<typename StatusType::Error>(StatusType::getError(status));
+			return ret;
+		}
+
+		int getMemory() const
+		{
+			return getMemory<NoTracePolicy>();
+		}
+
+		template <typename TracePolicy> int getMemory() const
+		{
+			TraceScope<TracePolicy> cloopTrace(4, 2);
+
+			if (cloopVTable->version < 3)
+			{
+				return IStatus::ERROR_1;
+			}
+			int ret = static_cast<VTable*>(this->cloopVTable)->getMemory(this);
+			return ret;
+		}
+
+		void setMemory(int n)
+		{
+			setMemory<NoTracePolicy>(n);
+		}
+
+		template <typename TracePolicy> void setMemory(int n)
+		{
+			TraceScope<TracePolicy> cloopTrace(4, 3);
+
+			if (cloopVTable->version < 3)
+			{
+				return;
+			}
+			static_cast<VTable*>(this->cloopVTable)->setMemory(this, n);
+		}
+
+		template <typename StatusType> void sumAndStore(StatusType* status, int n1, int n2)
+		{
+			sumAndStore<NoTracePolicy, StatusType>(status, n1, n2);
+		}
+
+		template <typename TracePolicy, typename StatusType> void sumAndStore(StatusType* status, int n1, int n2)
+		{
+			TraceScope<TracePolicy> cloopTrace(4, 4);
+
+			if (cloopVTable->version < 4)
+			{
+				StatusType::setVersionError(status, "ICalculator", cloopVTable->version, 4);
+				StatusType::checkException(status);
+				return;
+			}
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			static_cast<VTable*>(this->cloopVTable)->sumAndStore(this, status, n1, n2);
+			if (status->cloopErrorFlag)
+			{
+				cloopTrace.failed();
+				StatusTraits<StatusType>::checkException(status);
+			}
+		}
+
+		template <typename StatusType> Expected<void, typename StatusType::Error> try_sumAndStore(StatusType* status, int n1, int n2)
+		{
+			if (cloopVTable->version < 4)
+			{
+				StatusType::setVersionError(status, "ICalculator", cloopVTable->version, 4);
+				return Unexpected<typename StatusType::Error>(StatusType::getError(status));
+			}
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			static_cast<VTable*>(this->cloopVTable)->sumAndStore(this, status, n1, n2);
+			if (StatusType::hasError(status))
+				return Unexpected<typename StatusType::Error>(StatusType::getError(status));
+			return Expected<void, typename StatusType::Error>();
+		}
+	};
+
+	class ICalculator2 : public ICalculator
+	{
+	public:
+		struct VTable : public ICalculator::VTable
+		{
+			int (CLOOP_CARG *multiply)(const ICalculator2* self, IStatus* status, int n1, int n2) throw();
+			void (CLOOP_CARG *copyMemory)(ICalculator2* self, const ICalculator* calculator) throw();
+			void (CLOOP_CARG *copyMemory2)(ICalculator2* self, const int* address) throw();
+			void (CLOOP_CARG *multiplyBatch)(const ICalculator2* self, IStatus* status, const int* n1, const int* n2, int* results, unsigned count) throw();
+		};
+
+	protected:
+		ICalculator2(DoNotInherit)
+			: ICalculator(DoNotInherit())
+		{
+		}
+
+		~ICalculator2()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 7;
+
+		template <typename StatusType> int multiply(StatusType* status, int n1, int n2) const
+		{
+			return multiply<NoTracePolicy, StatusType>(status, n1, n2);
+		}
+
+		template <typename TracePolicy, typename StatusType> int multiply(StatusType* status, int n1, int n2) const
+		{
+			TraceScope<TracePolicy> cloopTrace(5, 5);
+
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			int ret = static_cast<VTable*>(this->cloopVTable)->multiply(this, status, n1, n2);
+			if (status->cloopErrorFlag)
+			{
+				cloopTrace.failed();
+				StatusTraits<StatusType>::checkException(status);
+			}
+			return ret;
+		}
+
+		template <typename StatusType> Expected<int, typename StatusType::Error> try_multiply(StatusType* status, int n1, int n2) const
+		{
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			int ret = static_cast<VTable*>(this->cloopVTable)->multiply(this, status, n1, n2);
+			if (StatusType::hasError(status))
+				return Unexpected<typename StatusType::Error>(StatusType::getError(status));
+			return ret;
+		}
+
+		void copyMemory(const ICalculator* calculator)
+		{
+			copyMemory<NoTracePolicy>(calculator);
+		}
+
+		template <typename TracePolicy> void copyMemory(const ICalculator* calculator)
+		{
+			TraceScope<TracePolicy> cloopTrace(5, 6);
+
+			static_cast<VTable*>(this->cloopVTable)->copyMemory(this, calculator);
+		}
+
+		void copyMemory2(const int* address)
+		{
+			copyMemory2<NoTracePolicy>(address);
+		}
+
+		template <typename TracePolicy> void copyMemory2(const int* address)
+		{
+			TraceScope<TracePolicy> cloopTrace(5, 7);
+
+			if (cloopVTable->version < 6)
+			{
+				return;
+			}
+			static_cast<VTable*>(this->cloopVTable)->copyMemory2(this, address);
+		}
+
+		template <typename StatusType> void multiplyBatch(StatusType* status, const int* n1, const int* n2, int* results, unsigned count) const
+		{
+			multiplyBatch<NoTracePolicy, StatusType>(status, n1, n2, results, count);
+		}
+
+		template <typename TracePolicy, typename StatusType> void multiplyBatch(StatusType* status, const int* n1, const int* n2, int* results, unsigned count) const
+		{
+			TraceScope<TracePolicy> cloopTrace(5, 8);
+
+			if (cloopVTable->version < 7)
+			{
+				StatusType::setVersionError(status, "ICalculator2", cloopVTable->version, 7);
+				StatusType::checkException(status);
+				return;
+			}
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			static_cast<VTable*>(this->cloopVTable)->multiplyBatch(this, status, n1, n2, results, count);
+			if (status->cloopErrorFlag)
+			{
+				cloopTrace.failed();
+				StatusTraits<StatusType>::checkException(status);
+			}
+		}
+
+#ifdef CLOOP_SPAN
+		template <typename StatusType> void multiplyBatch(StatusType* status, std::span<const int> n1, std::span<const int> n2, std::span<int> results) const
+		{
+			if (n2.size() != n1.size() ||
+				results.size() != n1.size())
+				abort();
+
+			multiplyBatch(status, n1.data(), n2.data(), results.data(), (unsigned) n1.size());
+		}
+#endif
+
+		template <typename StatusType> Expected<void, typename StatusType::Error> try_multiplyBatch(StatusType* status, const int* n1, const int* n2, int* results, unsigned count) const
+		{
+			if (cloopVTable->version < 7)
+			{
+				StatusType::setVersionError(status, "ICalculator2", cloopVTable->version, 7);
+				return Unexpected<typename StatusType::Error>(StatusType::getError(status));
+			}
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			static_cast<VTable*>(this->cloopVTable)->multiplyBatch(this, status, n1, n2, results, count);
+			if (StatusType::hasError(status))
+				return Unexpected<typename StatusType::Error>(StatusType::getError(status));
+			return Expected<void, typename StatusType::Error>();
+		}
+	};
+
+	class ICounter
+	{
+	public:
+		struct VTable
+		{
+			uintptr_t version;
+			void (CLOOP_CARG *dispose)(ICounter* self) throw();
+			int (CLOOP_CARG *increment)(ICounter* self) throw();
+			int (CLOOP_CARG *getValue)(const ICounter* self) throw();
+			void (CLOOP_CARG *add)(ICounter* self, const ICounter* counter) throw();
+		};
+
+		VTable* cloopVTable;
+
+	protected:
+		ICounter(DoNotInherit)
+		{
+		}
+
+		~ICounter()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 1;
+
+		void dispose()
+		{
+			dispose<NoTracePolicy>();
+		}
+
+		template <typename TracePolicy> void dispose()
+		{
+			TraceScope<TracePolicy> cloopTrace(6, 0);
+
+			static_cast<VTable*>(this->cloopVTable)->dispose(this);
+		}
+
+		int increment()
+		{
+			return increment<NoTracePolicy>();
+		}
+
+		template <typename TracePolicy> int increment()
+		{
+			TraceScope<TracePolicy> cloopTrace(6, 1);
+
+			int ret = static_cast<VTable*>(this->cloopVTable)->increment(this);
+			return ret;
+		}
+
+		int getValue() const
+		{
+			return getValue<NoTracePolicy>();
+		}
+
+		template <typename TracePolicy> int getValue() const
+		{
+			TraceScope<TracePolicy> cloopTrace(6, 2);
+
+			int ret = static_cast<VTable*>(this->cloopVTable)->getValue(this);
+			return ret;
+		}
+
+		void add(const ICounter* counter)
+		{
+			add<NoTracePolicy>(counter);
+		}
+
+		template <typename TracePolicy> void add(const ICounter* counter)
+		{
+			TraceScope<TracePolicy> cloopTrace(6, 3);
+
+			static_cast<VTable*>(this->cloopVTable)->add(this, counter);
+		}
+	};
+
+	class IReferenceCounted
+	{
+	public:
+		struct VTable
+		{
+			void* cloopDummy[1];
+			uintptr_t version;
+			void (CLOOP_CARG *addRef)(IReferenceCounted* self) throw();
+			int (CLOOP_CARG *release)(IReferenceCounted* self) throw();
+		};
+
+		void* cloopDummy[1];
+		VTable* cloopVTable;
+
+	protected:
+		IReferenceCounted(DoNotInherit)
+		{
+		}
+
+		~IReferenceCounted()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 1;
+
+		void addRef()
+		{
+			addRef<NoTracePolicy>();
+		}
+
+		template <typename TracePolicy> void addRef()
+		{
+			TraceScope<TracePolicy> cloopTrace(7, 0);
+
+			static_cast<VTable*>(this->cloopVTable)->addRef(this);
+		}
+
+		int release()
+		{
+			return release<NoTracePolicy>();
+		}
+
+		template <typename TracePolicy> int release()
+		{
+			TraceScope<TracePolicy> cloopTrace(7, 1);
+
+			int ret = static_cast<VTable*>(this->cloopVTable)->release(this);
+			return ret;
+		}
+	};
+
+	class IAccumulator : public IReferenceCounted
+	{
+	public:
+		struct VTable : public IReferenceCounted::VTable
+		{
+			void (CLOOP_CARG *add)(IAccumulator* self, int n) throw();
+			int (CLOOP_CARG *getTotal)(const IAccumulator* self) throw();
+		};
+
+	protected:
+		IAccumulator(DoNotInherit)
+			: IReferenceCounted(DoNotInherit())
+		{
+		}
+
+		~IAccumulator()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 2;
+
+		void add(int n)
+		{
+			add<NoTracePolicy>(n);
+		}
+
+		template <typename TracePolicy> void add(int n)
+		{
+			TraceScope<TracePolicy> cloopTrace(8, 2);
+
+			static_cast<VTable*>(this->cloopVTable)->add(this, n);
+		}
+
+		int getTotal() const
+		{
+			return getTotal<NoTracePolicy>();
+		}
+
+		template <typename TracePolicy> int getTotal() const
+		{
+			TraceScope<TracePolicy> cloopTrace(8, 3);
+
+			int ret = static_cast<VTable*>(this->cloopVTable)->getTotal(this);
+			return ret;
+		}
+	};
+
+	class IQueryable : public IDisposable
+	{
+	public:
+		struct VTable : public IDisposable::VTable
+		{
+			IQueryable* (CLOOP_CARG *queryInterface)(IQueryable* self, unsigned id) throw();
+		};
+
+	protected:
+		IQueryable(DoNotInherit)
+			: IDisposable(DoNotInherit())
+		{
+		}
+
+		~IQueryable()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 2;
+
+		IQueryable* queryInterface(unsigned id)
+		{
+			return queryInterface<NoTracePolicy>(id);
+		}
+
+		template <typename TracePolicy> IQueryable* queryInterface(unsigned id)
+		{
+			TraceScope<TracePolicy> cloopTrace(9, 1);
+
+			IQueryable* ret = static_cast<VTable*>(this->cloopVTable)->queryInterface(this, id);
+			return ret;
+		}
+	};
+
+	class IReader : public IQueryable
+	{
+	public:
+		struct VTable : public IQueryable::VTable
+		{
+			int (CLOOP_CARG *read)(IReader* self) throw();
+		};
+
+	protected:
+		IReader(DoNotInherit)
+			: IQueryable(DoNotInherit())
+		{
+		}
+
+		~IReader()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 3;
+		static const unsigned IID = 0x52454144u;
+
+		int read()
+		{
+			return read<NoTracePolicy>();
+		}
+
+		template <typename TracePolicy> int read()
+		{
+			TraceScope<TracePolicy> cloopTrace(10, 2);
+
+			int ret = static_cast<VTable*>(this->cloopVTable)->read(this);
+			return ret;
+		}
+	};
+
+	class IWriter : public IQueryable
+	{
+	public:
+		struct VTable : public IQueryable::VTable
+		{
+			void (CLOOP_CARG *write)(IWriter* self, int n) throw();
+		};
+
+	protected:
+		IWriter(DoNotInherit)
+			: IQueryable(DoNotInherit())
+		{
+		}
+
+		~IWriter()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 3;
+		static const unsigned IID = 0x57524954u;
+
+		void write(int n)
+		{
+			write<NoTracePolicy>(n);
+		}
+
+		template <typename TracePolicy> void write(int n)
+		{
+			TraceScope<TracePolicy> cloopTrace(11, 2);
+
+			static_cast<VTable*>(this->cloopVTable)->write(this, n);
+		}
+	};
+
+	class IAsyncCalculator : public IDisposable
+	{
+	public:
+		struct VTable : public IDisposable::VTable
+		{
+			int (CLOOP_CARG *sum)(const IAsyncCalculator* self, IStatus* status, int n1, int n2) throw();
+			void (CLOOP_CARG *sumAsync)(const IAsyncCalculator* self, IStatus* status, int n1, int n2, IAsyncCalculatorSumCompletion* completion) throw();
+		};
+
+	protected:
+		IAsyncCalculator(DoNotInherit)
+			: IDisposable(DoNotInherit())
+		{
+		}
+
+		~IAsyncCalculator()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 2;
+
+		template <typename StatusType> int sum(StatusType* status, int n1, int n2) const
+		{
+			return sum<NoTracePolicy, StatusType>(status, n1, n2);
+		}
+
+		template <typename TracePolicy, typename StatusType> int sum(StatusType* status, int n1, int n2) const
+		{
+			TraceScope<TracePolicy> cloopTrace(12, 1);
+
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			int ret = static_cast<VTable*>(this->cloopVTable)->sum(this, status, n1, n2);
+			if (status->cloopErrorFlag)
+			{
+				cloopTrace.failed();
+				StatusTraits<StatusType>::checkException(status);
+			}
+			return ret;
+		}
+
+		template <typename StatusType> Expected<int, typename StatusType::Error> try_sum(StatusType* status, int n1, int n2) const
+		{
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			int ret = static_cast<VTable*>(this->cloopVTable)->sum(this, status, n1, n2);
+			if (StatusType::hasError(status))
+				return Unexpected<typename StatusType::Error>(StatusType::getError(status));
+			return ret;
+		}
+
+		template <typename StatusType> void sumAsync(StatusType* status, int n1, int n2, IAsyncCalculatorSumCompletion* completion) const
+		{
+			sumAsync<NoTracePolicy, StatusType>(status, n1, n2, completion);
+		}
+
+		template <typename TracePolicy, typename StatusType> void sumAsync(StatusType* status, int n1, int n2, IAsyncCalculatorSumCompletion* completion) const
+		{
+			TraceScope<TracePolicy> cloopTrace(12, 2);
+
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			static_cast<VTable*>(this->cloopVTable)->sumAsync(this, status, n1, n2, completion);
+			if (status->cloopErrorFlag)
+			{
+				cloopTrace.failed();
+				StatusTraits<StatusType>::checkException(status);
+			}
+		}
+
+#ifdef CLOOP_COROUTINES
+		template <typename StatusType> IAsyncCalculatorSumAwaiter<StatusType> sumAsync(StatusType* status, int n1, int n2) const
+		{
+			return IAsyncCalculatorSumAwaiter<StatusType>(this, status, n1, n2);
+		}
+#endif
+
+		template <typename StatusType> Expected<void, typename StatusType::Error> try_sumAsync(StatusType* status, int n1, int n2, IAsyncCalculatorSumCompletion* completion) const
+		{
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			static_cast<VTable*>(this->cloopVTable)->sumAsync(this, status, n1, n2, completion);
+			if (StatusType::hasError(status))
+				return Unexpected<typename StatusType::Error>(StatusType::getError(status));
+			return Expected<void, typename StatusType::Error>();
+		}
+	};
+
+	class IScanner : public IDisposable
+	{
+	public:
+		struct VTable : public IDisposable::VTable
+		{
+			unsigned (CLOOP_CARG *countChar)(const IScanner* self, StrView text, unsigned char c) throw();
+			StrView (CLOOP_CARG *trim)(const IScanner* self, IStatus* status, StrView text) throw();
+			unsigned (CLOOP_CARG *checksum)(const IScanner* self, Bytes in) throw();
+		};
+
+	protected:
+		IScanner(DoNotInherit)
+			: IDisposable(DoNotInherit())
+		{
+		}
+
+		~IScanner()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 2;
+
+		unsigned countChar(StrView text, unsigned char c) const
+		{
+			return countChar<NoTracePolicy>(text, c);
+		}
+
+		template <typename TracePolicy> unsigned countChar(StrView text, unsigned char c) const
+		{
+			TraceScope<TracePolicy> cloopTrace(13, 1);
+
+			unsigned ret = static_cast<VTable*>(this->cloopVTable)->countChar(this, text, c);
+			return ret;
+		}
+
+		template <typename StatusType> StrView trim(StatusType* status, StrView text) const
+		{
+			return trim<NoTracePolicy, StatusType>(status, text);
+		}
+
+		template <typename TracePolicy, typename StatusType> StrView trim(StatusType* status, StrView text) const
+		{
+			TraceScope<TracePolicy> cloopTrace(13, 2);
+
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			StrView ret = static_cast<VTable*>(this->cloopVTable)->trim(this, status, text);
+			if (status->cloopErrorFlag)
+			{
+				cloopTrace.failed();
+				StatusTraits<StatusType>::checkException(status);
+			}
+			return ret;
+		}
+
+		template <typename StatusType> Expected<StrView, typename StatusType::Error> try_trim(StatusType* status, StrView text) const
+		{
+			if (status->cloopErrorFlag)
+				StatusTraits<StatusType>::clearException(status);
+			StrView ret = static_cast<VTable*>(this->cloopVTable)->trim(this, status, text);
+			if (StatusType::hasError(status))
+				return Unexpected<typename StatusType::Error>(StatusType::getError(status));
+			return ret;
+		}
+
+		unsigned checksum(Bytes in) const
+		{
+			return checksum<NoTracePolicy>(in);
+		}
+
+		template <typename TracePolicy> unsigned checksum(Bytes in) const
+		{
+			TraceScope<TracePolicy> cloopTrace(13, 3);
+
+			unsigned ret = static_cast<VTable*>(this->cloopVTable)->checksum(this, in);
+			return ret;
+		}
+	};
+
+	class IGeometry : public IDisposable
+	{
+	public:
+		struct VTable : public IDisposable::VTable
+		{
+			Rectangle (CLOOP_CARG *move)(const IGeometry* self, Rectangle rectangle, Point offset) throw();
+			int (CLOOP_CARG *area)(const IGeometry* self, const Rectangle* rectangle) throw();
+			unsigned (CLOOP_CARG *payload)(const IGeometry* self, Header header) throw();
+		};
+
+	protected:
+		IGeometry(DoNotInherit)
+			: IDisposable(DoNotInherit())
+		{
+		}
+
+		~IGeometry()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 2;
+
+		Rectangle move(Rectangle rectangle, Point offset) const
+		{
+			return move<NoTracePolicy>(rectangle, offset);
+		}
+
+		template <typename TracePolicy> Rectangle move(Rectangle rectangle, Point offset) const
+		{
+			TraceScope<TracePolicy> cloopTrace(14, 1);
+
+			Rectangle ret = static_cast<VTable*>(this->cloopVTable)->move(this, rectangle, offset);
+			return ret;
+		}
+
+		int area(const Rectangle* rectangle) const
+		{
+			return area<NoTracePolicy>(rectangle);
+		}
+
+		template <typename TracePolicy> int area(const Rectangle* rectangle) const
+		{
+			TraceScope<TracePolicy> cloopTrace(14, 2);
+
+			int ret = static_cast<VTable*>(this->cloopVTable)->area(this, rectangle);
+			return ret;
+		}
+
+		unsigned payload(Header header) const
+		{
+			return payload<NoTracePolicy>(header);
+		}
+
+		template <typename TracePolicy> unsigned payload(Header header) const
+		{
+			TraceScope<TracePolicy> cloopTrace(14, 3);
+
+			unsigned ret = static_cast<VTable*>(this->cloopVTable)->payload(this, header);
+			return ret;
+		}
+	};
+
+	class ISeries : public IDisposable
+	{
+	public:
+		struct VTable : public IDisposable::VTable
+		{
+			int (CLOOP_CARG *total)(const ISeries* self, const int* values, unsigned count) throw();
+			void (CLOOP_CARG *scale)(const ISeries* self, const int* in, int* out, unsigned count, int factor) throw();
+			unsigned (CLOOP_CARG *histogram)(const ISeries* self, const unsigned char* data, unsigned* counts, unsigned size, unsigned buckets) throw();
+			int (CLOOP_CARG *clamp)(const ISeries* self, int value, int limit) throw();
+			void (CLOOP_CARG *clampBatch)(const ISeries* self, const int* value, const int* limit, int* results, unsigned count) throw();
+		};
+
+	protected:
+		ISeries(DoNotInherit)
+			: IDisposable(DoNotInherit())
+		{
+		}
+
+		~ISeries()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 2;
+
+		int total(const int* values, unsigned count) const
+		{
+			return total<NoTracePolicy>(values, count);
+		}
+
+		template <typename TracePolicy> int total(const int* values, unsigned count) const
+		{
+			TraceScope<TracePolicy> cloopTrace(15, 1);
+
+			int ret = static_cast<VTable*>(this->cloopVTable)->total(this, values, count);
+			return ret;
+		}
+
+#ifdef CLOOP_SPAN
+		int total(std::span<const int> values) const
+		{
+			return total(values.data(), (unsigned) values.size());
+		}
+#endif
+
+		void scale(const int* in, int* out, unsigned count, int factor) const
+		{
+			scale<NoTracePolicy>(in, out, count, factor);
+		}
+
+		template <typename TracePolicy> void scale(const int* in, int* out, unsigned count, int factor) const
+		{
+			TraceScope<TracePolicy> cloopTrace(15, 2);
+
+			static_cast<VTable*>(this->cloopVTable)->scale(this, in, out, count, factor);
+		}
+
+#ifdef CLOOP_SPAN
+		void scale(std::span<const int> in, std::span<int> out, int factor) const
+		{
+			if (out.size() != in.size())
+				abort();
+
+			scale(in.data(), out.data(), (unsigned) in.size(), factor);
+		}
+#endif
+
+		unsigned histogram(const unsigned char* data, unsigned* counts, unsigned size, unsigned buckets) const
+		{
+			return histogram<NoTracePolicy>(data, counts, size, buckets);
+		}
+
+		template <typename TracePolicy> unsigned histogram(const unsigned char* data, unsigned* counts, unsigned size, unsigned buckets) const
+		{
+			TraceScope<TracePolicy> cloopTrace(15, 3);
+
+			unsigned ret = static_cast<VTable*>(this->cloopVTable)->histogram(this, data, counts, size, buckets);
+			return ret;
+		}
+
+#ifdef CLOOP_SPAN
+		unsigned histogram(std::span<const unsigned char> data, std::span<unsigned> counts) const
+		{
+			return histogram(data.data(), counts.data(), (unsigned) data.size(), (unsigned) counts.size());
+		}
+#endif
+
+		int clamp(int value, int limit) const
+		{
+			return clamp<NoTracePolicy>(value, limit);
+		}
+
+		template <typename TracePolicy> int clamp(int value, int limit) const
+		{
+			TraceScope<TracePolicy> cloopTrace(15, 4);
+
+			int ret = static_cast<VTable*>(this->cloopVTable)->clamp(this, value, limit);
+			return ret;
+		}
+
+		void clampBatch(const int* value, const int* limit, int* results, unsigned count) const
+		{
+			clampBatch<NoTracePolicy>(value, limit, results, count);
+		}
+
+		template <typename TracePolicy> void clampBatch(const int* value, const int* limit, int* results, unsigned count) const
+		{
+			TraceScope<TracePolicy> cloopTrace(15, 5);
+
+			static_cast<VTable*>(this->cloopVTable)->clampBatch(this, value, limit, results, count);
+		}
+
+#ifdef CLOOP_SPAN
+		void clampBatch(std::span<const int> value, std::span<const int> limit, std::span<int> results) const
+		{
+			if (limit.size() != value.size() ||
+				results.size() != value.size())
+				abort();
+
+			clampBatch(value.data(), limit.data(), results.data(), (unsigned) value.size());
+		}
+#endif
+	};
+
+	class IPool : public IDisposable
+	{
+	public:
+		struct VTable : public IDisposable::VTable
+		{
+			void (CLOOP_CARG *keep)(IPool* self, IAccumulator* accumulator) throw();
+			void (CLOOP_CARG *setName)(IPool* self, const char* name) throw();
+			int (CLOOP_CARG *total)(const IPool* self) throw();
+		};
+
+	protected:
+		IPool(DoNotInherit)
+			: IDisposable(DoNotInherit())
+		{
+		}
+
+		~IPool()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 2;
+
+		void keep(IAccumulator* accumulator)
+		{
+			keep<NoTracePolicy>(accumulator);
+		}
+
+		template <typename TracePolicy> void keep(IAccumulator* accumulator)
+		{
+			TraceScope<TracePolicy> cloopTrace(16, 1);
+
+			static_cast<VTable*>(this->cloopVTable)->keep(this, accumulator);
+		}
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+		void keep(Ref<IAccumulator>&& accumulator)
+		{
+			keep(accumulator.detach());
+		}
+#endif
+
+		void setName(const char* name)
+		{
+			setName<NoTracePolicy>(name);
+		}
+
+		template <typename TracePolicy> void setName(const char* name)
+		{
+			TraceScope<TracePolicy> cloopTrace(16, 2);
+
+			static_cast<VTable*>(this->cloopVTable)->setName(this, name);
+		}
+
+		int total() const
+		{
+			return total<NoTracePolicy>();
+		}
+
+		template <typename TracePolicy> int total() const
+		{
+			TraceScope<TracePolicy> cloopTrace(16, 3);
+
+			int ret = static_cast<VTable*>(this->cloopVTable)->total(this);
+			return ret;
+		}
+	};
+
+	class IAsyncCalculatorSumCompletion
+	{
+	public:
+		struct VTable
+		{
+			void* cloopDummy[1];
+			uintptr_t version;
+			void (CLOOP_CARG *complete)(IAsyncCalculatorSumCompletion* self, IStatus* status, int result) throw();
+		};
+
+		void* cloopDummy[1];
+		VTable* cloopVTable;
+
+	protected:
+		IAsyncCalculatorSumCompletion(DoNotInherit)
+		{
+		}
+
+		~IAsyncCalculatorSumCompletion()
+		{
+		}
+
+	public:
+		static const unsigned VERSION = 1;
+
+		template <typename StatusType> void complete(StatusType* status, int result)
+		{
+			complete<NoTracePolicy, StatusType>(status, result);
+		}
+
+		template <typename TracePolicy, typename StatusType> void complete(StatusType* status, int result)
+		{
+			TraceScope<TracePolicy> cloopTrace(17, 0);
+
+			static_cast<VTable*>(this->cloopVTable)->complete(this, status, result);
+		}
+	};
+
+	// Status protocols
+
+	template <typename StatusType>
+	class StatusHolder
+	{
+	public:
+		explicit StatusHolder(IStatus* status)
+			: status(status)
+		{
+		}
+
+		StatusType* get()
+		{
+			return &status;
+		}
+
+	private:
+		StatusType status;
+	};
+
+	template <typename StatusType>
+	struct StatusTraits
+	{
+		typedef StatusHolder<StatusType> Holder;
+
+		static void clearException(StatusType* status)
+		{
+			StatusType::clearException(status);
+		}
+
+		static void checkException(StatusType* status)
+		{
+			StatusType::checkException(status);
+		}
+	};
+
+	template <typename StatusType>
+	struct LightStatusTraits
+	{
+		typedef StatusHolder<StatusType> Holder;
+
+		static void clearException(StatusType* status)
+		{
+			if (StatusType::isDirty(status))
+				StatusType::clearException(status);
+		}
+
+		static void checkException(StatusType* status)
+		{
+			if (StatusType::isDirty(status))
+				StatusType::checkException(status);
+		}
+	};
+
+	template <typename T>
+	class CommandResult
+	{
+	public:
+		CommandResult(const CommandBuffer* buffer, unsigned cell)
+			: buffer(buffer),
+			  cell(cell)
+		{
+		}
+
+		T get() const
+		{
+			return CommandCell<T>::decode(buffer->data()[cell]);
+		}
+
+	private:
+		const CommandBuffer* buffer;
+		unsigned cell;
+	};
+
+	// Interfaces recorders
+
+	class IDisposableRecorder
+	{
+	public:
+		static const unsigned INTERFACE_INDEX = 0;
+
+		IDisposableRecorder(CommandBuffer* buffer, IDisposable* object)
+			: buffer(buffer),
+			  object(object)
+		{
+		}
+
+		void dispose()
+		{
+			uint64_t* command = buffer->append(2);
+			command[0] = CommandBuffer::header(2, 0, 0);
+			command[1] = CommandCell<void*>::encode(object);
+		}
+
+	protected:
+		CommandBuffer* buffer;
+		void* object;
+	};
+
+	class ICalculatorRecorder : public IDisposableRecorder
+	{
+	public:
+		static const unsigned INTERFACE_INDEX = 4;
+
+		ICalculatorRecorder(CommandBuffer* buffer, ICalculator* object)
+			: IDisposableRecorder(buffer, object)
+		{
+		}
+
+		CommandResult<int> sum(int n1, int n2)
+		{
+			uint64_t* command = buffer->append(5);
+			command[0] = CommandBuffer::header(5, 4, 1);
+			command[1] = CommandCell<void*>::encode(object);
+			command[2] = CommandCell<int>::encode(n1);
+			command[3] = CommandCell<int>::encode(n2);
+			command[4] = 0;
+			return CommandResult<int>(buffer, buffer->size() - 1);
+		}
+
+		CommandResult<int> getMemory()
+		{
+			uint64_t* command = buffer->append(3);
+			command[0] = CommandBuffer::header(3, 4, 2);
+			command[1] = CommandCell<void*>::encode(object);
+			command[2] = 0;
+			return CommandResult<int>(buffer, buffer->size() - 1);
+		}
+
+		void setMemory(int n)
+		{
+			uint64_t* command = buffer->append(3);
+			command[0] = CommandBuffer::header(3, 4, 3);
+			command[1] = CommandCell<void*>::encode(object);
+			command[2] = CommandCell<int>::encode(n);
+		}
+
+		void sumAndStore(int n1, int n2)
+		{
+			uint64_t* command = buffer->append(4);
+			command[0] = CommandBuffer::header(4, 4, 4);
+			command[1] = CommandCell<void*>::encode(object);
+			command[2] = CommandCell<int>::encode(n1);
+			command[3] = CommandCell<int>::encode(n2);
+		}
+	};
+
+	class ICalculator2Recorder : public ICalculatorRecorder
+	{
+	public:
+		static const unsigned INTERFACE_INDEX = 5;
+
+		ICalculator2Recorder(CommandBuffer* buffer, ICalculator2* object)
+			: ICalculatorRecorder(buffer, object)
+		{
+		}
+
+		CommandResult<int> multiply(int n1, int n2)
+		{
+			uint64_t* command = buffer->append(5);
+			command[0] = CommandBuffer::header(5, 5, 5);
+			command[1] = CommandCell<void*>::encode(object);
+			command[2] = CommandCell<int>::encode(n1);
+			command[3] = CommandCell<int>::encode(n2);
+			command[4] = 0;
+			return CommandResult<int>(buffer, buffer->size() - 1);
+		}
+
+		void copyMemory(const ICalculator* calculator)
+		{
+			uint64_t* command = buffer->append(3);
+			command[0] = CommandBuffer::header(3, 5, 6);
+			command[1] = CommandCell<void*>::encode(object);
+			command[2] = CommandCell<const ICalculator*>::encode(calculator);
+		}
+
+		void copyMemory2(const int* address)
+		{
+			uint64_t* command = buffer->append(3);
+			command[0] = CommandBuffer::header(3, 5, 7);
+			command[1] = CommandCell<void*>::encode(object);
+			command[2] = CommandCell<const int*>::encode(address);
+		}
+
+		void multiplyBatch(const int* n1, const int* n2, int* results, unsigned count)
+		{
+			uint64_t* command = buffer->append(6);
+			command[0] = CommandBuffer::header(6, 5, 8);
+			command[1] = CommandCell<void*>::encode(object);
+			command[2] = CommandCell<const int*>::encode(n1);
+			command[3] = CommandCell<const int*>::encode(n2);
+			command[4] = CommandCell<int*>::encode(results);
+			command[5] = CommandCell<unsigned>::encode(count);
+		}
+	};
+
+	template <typename StatusType>
+	unsigned executeCommands(StatusType* status, uint64_t* cells, unsigned size)
+	{
+		unsigned executed = 0;
+
+		for (unsigned position = 0; position < size; ++executed)
+		{
+			uint64_t* command = cells + position;
+
+			switch ((unsigned) (command[0] & 0xFFFFFFFF))
+			{
+				case (0u << 16) | 0u:	// IDisposable::dispose
+				{
+					IDisposable* object = CommandCell<IDisposable*>::decode(command[1]);
+
+					static_cast<IDisposable::VTable*>(object->cloopVTable)->dispose(object);
+					break;
+				}
+
+				case (4u << 16) | 1u:	// ICalculator::sum
+				{
+					ICalculator* object = CommandCell<ICalculator*>::decode(command[1]);
+
+					command[4] = CommandCell<int>::encode(static_cast<ICalculator::VTable*>(object->cloopVTable)->sum(object, status, CommandCell<int>::decode(command[2]), CommandCell<int>::decode(command[3])));
+
+					if (StatusType::hasError(status))
+						return executed;
+					break;
+				}
+
+				case (4u << 16) | 2u:	// ICalculator::getMemory
+				{
+					ICalculator* object = CommandCell<ICalculator*>::decode(command[1]);
+
+					if (object->cloopVTable->version < 3)
+						return executed;
+
+					command[2] = CommandCell<int>::encode(static_cast<ICalculator::VTable*>(object->cloopVTable)->getMemory(object));
+					break;
+				}
+
+				case (4u << 16) | 3u:	// ICalculator::setMemory
+				{
+					ICalculator* object = CommandCell<ICalculator*>::decode(command[1]);
+
+					if (object->cloopVTable->version < 3)
+						return executed;
+
+					static_cast<ICalculator::VTable*>(object->cloopVTable)->setMemory(object, CommandCell<int>::decode(command[2]));
+					break;
+				}
+
+				case (4u << 16) | 4u:	// ICalculator::sumAndStore
+				{
+					ICalculator* object = CommandCell<ICalculator*>::decode(command[1]);
+
+					if (object->cloopVTable->version < 4)
+						return executed;
+
+					static_cast<ICalculator::VTable*>(object->cloopVTable)->sumAndStore(object, status, CommandCell<int>::decode(command[2]), CommandCell<int>::decode(command[3]));
+
+					if (StatusType::hasError(status))
+						return executed;
+					break;
+				}
+
+				case (5u << 16) | 5u:	// ICalculator2::multiply
+				{
+					ICalculator2* object = CommandCell<ICalculator2*>::decode(command[1]);
+
+					command[4] = CommandCell<int>::encode(static_cast<ICalculator2::VTable*>(object->cloopVTable)->multiply(object, status, CommandCell<int>::decode(command[2]), CommandCell<int>::decode(command[3])));
+
+					if (StatusType::hasError(status))
+						return executed;
+					break;
+				}
+
+				case (5u << 16) | 6u:	// ICalculator2::copyMemory
+				{
+					ICalculator2* object = CommandCell<ICalculator2*>::decode(command[1]);
+
+					static_cast<ICalculator2::VTable*>(object->cloopVTable)->copyMemory(object, CommandCell<const ICalculator*>::decode(command[2]));
+					break;
+				}
+
+				case (5u << 16) | 7u:	// ICalculator2::copyMemory2
+				{
+					ICalculator2* object = CommandCell<ICalculator2*>::decode(command[1]);
+
+					if (object->cloopVTable->version < 6)
+						return executed;
+
+					static_cast<ICalculator2::VTable*>(object->cloopVTable)->copyMemory2(object, CommandCell<const int*>::decode(command[2]));
+					break;
+				}
+
+				case (5u << 16) | 8u:	// ICalculator2::multiplyBatch
+				{
+					ICalculator2* object = CommandCell<ICalculator2*>::decode(command[1]);
+
+					if (object->cloopVTable->version < 7)
+						return executed;
+
+					static_cast<ICalculator2::VTable*>(object->cloopVTable)->multiplyBatch(object, status, CommandCell<const int*>::decode(command[2]), CommandCell<const int*>::decode(command[3]), CommandCell<int*>::decode(command[4]), CommandCell<unsigned>::decode(command[5]));
+
+					if (StatusType::hasError(status))
+						return executed;
+					break;
+				}
+
+				default:
+					return executed;
+			}
+
+			position += (unsigned) (command[0] >> 32);
+		}
+
+		return executed;
+	}
+
+	// Reflection (C++11)
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+	struct ParameterInfo
+	{
+		const char* name;
+		const char* type;
+	};
+
+	struct MethodInfo
+	{
+		const char* name;
+		unsigned slot;
+		unsigned version;
+		const char* returnType;
+		const ParameterInfo* parameters;
+		unsigned parameterCount;
+		bool isConst;
+		bool mayThrow;
+	};
+
+	template <typename Interface, typename Dummy = void>
+	struct Reflection;
+
+	template <typename Dummy>
+	struct Reflection<IDisposable, Dummy>
+	{
+		static constexpr const char* NAME = "IDisposable";
+		static constexpr unsigned INDEX = 0;
+		static constexpr unsigned VERSION = 1;
+		static constexpr unsigned METHOD_COUNT = 1;
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<IDisposable, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<IDisposable, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<IStatus, Dummy>
+	{
+		static constexpr const char* NAME = "IStatus";
+		static constexpr unsigned INDEX = 1;
+		static constexpr unsigned VERSION = 2;
+		static constexpr unsigned METHOD_COUNT = 3;
+
+		static constexpr ParameterInfo cloopsetCodeParameters[] =
+		{
+			{"code", "int"}
+		};
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false},
+			{"getCode", 1, 2, "int", nullptr, 0, true, false},
+			{"setCode", 2, 2, "void", cloopsetCodeParameters, 1, false, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<IStatus, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IStatus, Dummy>::cloopsetCodeParameters[];
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<IStatus, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<IStatusFactory, Dummy>
+	{
+		static constexpr const char* NAME = "IStatusFactory";
+		static constexpr unsigned INDEX = 2;
+		static constexpr unsigned VERSION = 2;
+		static constexpr unsigned METHOD_COUNT = 2;
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false},
+			{"createStatus", 1, 2, "IStatus*", nullptr, 0, false, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<IStatusFactory, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<IStatusFactory, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<IFactory, Dummy>
+	{
+		static constexpr const char* NAME = "IFactory";
+		static constexpr unsigned INDEX = 3;
+		static constexpr unsigned VERSION = 2;
+		static constexpr unsigned METHOD_COUNT = 6;
+
+		static constexpr ParameterInfo cloopcreateCalculatorParameters[] =
+		{
+			{"status", "IStatus*"}
+		};
+
+		static constexpr ParameterInfo cloopcreateCalculator2Parameters[] =
+		{
+			{"status", "IStatus*"}
+		};
+
+		static constexpr ParameterInfo cloopcreateBrokenCalculatorParameters[] =
+		{
+			{"status", "IStatus*"}
+		};
+
+		static constexpr ParameterInfo cloopsetStatusFactoryParameters[] =
+		{
+			{"statusFactory", "IStatusFactory*"}
+		};
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false},
+			{"createStatus", 1, 2, "IStatus*", nullptr, 0, false, false},
+			{"createCalculator", 2, 2, "ICalculator*", cloopcreateCalculatorParameters, 1, false, true},
+			{"createCalculator2", 3, 2, "ICalculator2*", cloopcreateCalculator2Parameters, 1, false, true},
+			{"createBrokenCalculator", 4, 2, "ICalculator*", cloopcreateBrokenCalculatorParameters, 1, false, true},
+			{"setStatusFactory", 5, 2, "void", cloopsetStatusFactoryParameters, 1, false, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<IFactory, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IFactory, Dummy>::cloopcreateCalculatorParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IFactory, Dummy>::cloopcreateCalculator2Parameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IFactory, Dummy>::cloopcreateBrokenCalculatorParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IFactory, Dummy>::cloopsetStatusFactoryParameters[];
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<IFactory, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<ICalculator, Dummy>
+	{
+		static constexpr const char* NAME = "ICalculator";
+		static constexpr unsigned INDEX = 4;
+		static constexpr unsigned VERSION = 4;
+		static constexpr unsigned METHOD_COUNT = 5;
+
+		static constexpr ParameterInfo cloopsumParameters[] =
+		{
+			{"status", "IStatus*"},
+			{"n1", "int"},
+			{"n2", "int"}
+		};
+
+		static constexpr ParameterInfo cloopsetMemoryParameters[] =
+		{
+			{"n", "int"}
+		};
+
+		static constexpr ParameterInfo cloopsumAndStoreParameters[] =
+		{
+			{"status", "IStatus*"},
+			{"n1", "int"},
+			{"n2", "int"}
+		};
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false},
+			{"sum", 1, 2, "int", cloopsumParameters, 3, true, true},
+			{"getMemory", 2, 3, "int", nullptr, 0, true, false},
+			{"setMemory", 3, 3, "void", cloopsetMemoryParameters, 1, false, false},
+			{"sumAndStore", 4, 4, "void", cloopsumAndStoreParameters, 3, false, true}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<ICalculator, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<ICalculator, Dummy>::cloopsumParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<ICalculator, Dummy>::cloopsetMemoryParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<ICalculator, Dummy>::cloopsumAndStoreParameters[];
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<ICalculator, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<ICalculator2, Dummy>
+	{
+		static constexpr const char* NAME = "ICalculator2";
+		static constexpr unsigned INDEX = 5;
+		static constexpr unsigned VERSION = 7;
+		static constexpr unsigned METHOD_COUNT = 9;
+
+		static constexpr ParameterInfo cloopmultiplyParameters[] =
+		{
+			{"status", "IStatus*"},
+			{"n1", "int"},
+			{"n2", "int"}
+		};
+
+		static constexpr ParameterInfo cloopcopyMemoryParameters[] =
+		{
+			{"calculator", "const ICalculator*"}
+		};
+
+		static constexpr ParameterInfo cloopcopyMemory2Parameters[] =
+		{
+			{"address", "const int*"}
+		};
+
+		static constexpr ParameterInfo cloopmultiplyBatchParameters[] =
+		{
+			{"status", "IStatus*"},
+			{"n1", "const int*"},
+			{"n2", "const int*"},
+			{"results", "int*"},
+			{"count", "unsigned"}
+		};
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false},
+			{"sum", 1, 2, "int", Reflection<ICalculator, Dummy>::cloopsumParameters, 3, true, true},
+			{"getMemory", 2, 3, "int", nullptr, 0, true, false},
+			{"setMemory", 3, 3, "void", Reflection<ICalculator, Dummy>::cloopsetMemoryParameters, 1, false, false},
+			{"sumAndStore", 4, 4, "void", Reflection<ICalculator, Dummy>::cloopsumAndStoreParameters, 3, false, true},
+			{"multiply", 5, 5, "int", cloopmultiplyParameters, 3, true, true},
+			{"copyMemory", 6, 5, "void", cloopcopyMemoryParameters, 1, false, false},
+			{"copyMemory2", 7, 6, "void", cloopcopyMemory2Parameters, 1, false, false},
+			{"multiplyBatch", 8, 7, "void", cloopmultiplyBatchParameters, 5, true, true}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<ICalculator2, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<ICalculator2, Dummy>::cloopmultiplyParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<ICalculator2, Dummy>::cloopcopyMemoryParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<ICalculator2, Dummy>::cloopcopyMemory2Parameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<ICalculator2, Dummy>::cloopmultiplyBatchParameters[];
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<ICalculator2, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<ICounter, Dummy>
+	{
+		static constexpr const char* NAME = "ICounter";
+		static constexpr unsigned INDEX = 6;
+		static constexpr unsigned VERSION = 1;
+		static constexpr unsigned METHOD_COUNT = 4;
+
+		static constexpr ParameterInfo cloopaddParameters[] =
+		{
+			{"counter", "const ICounter*"}
+		};
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false},
+			{"increment", 1, 1, "int", nullptr, 0, false, false},
+			{"getValue", 2, 1, "int", nullptr, 0, true, false},
+			{"add", 3, 1, "void", cloopaddParameters, 1, false, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<ICounter, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<ICounter, Dummy>::cloopaddParameters[];
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<ICounter, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<IReferenceCounted, Dummy>
+	{
+		static constexpr const char* NAME = "IReferenceCounted";
+		static constexpr unsigned INDEX = 7;
+		static constexpr unsigned VERSION = 1;
+		static constexpr unsigned METHOD_COUNT = 2;
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"addRef", 0, 1, "void", nullptr, 0, false, false},
+			{"release", 1, 1, "int", nullptr, 0, false, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<IReferenceCounted, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<IReferenceCounted, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<IAccumulator, Dummy>
+	{
+		static constexpr const char* NAME = "IAccumulator";
+		static constexpr unsigned INDEX = 8;
+		static constexpr unsigned VERSION = 2;
+		static constexpr unsigned METHOD_COUNT = 4;
+
+		static constexpr ParameterInfo cloopaddParameters[] =
+		{
+			{"n", "int"}
+		};
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"addRef", 0, 1, "void", nullptr, 0, false, false},
+			{"release", 1, 1, "int", nullptr, 0, false, false},
+			{"add", 2, 2, "void", cloopaddParameters, 1, false, false},
+			{"getTotal", 3, 2, "int", nullptr, 0, true, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<IAccumulator, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IAccumulator, Dummy>::cloopaddParameters[];
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<IAccumulator, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<IQueryable, Dummy>
+	{
+		static constexpr const char* NAME = "IQueryable";
+		static constexpr unsigned INDEX = 9;
+		static constexpr unsigned VERSION = 2;
+		static constexpr unsigned METHOD_COUNT = 2;
+
+		static constexpr ParameterInfo cloopqueryInterfaceParameters[] =
+		{
+			{"id", "unsigned"}
+		};
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false},
+			{"queryInterface", 1, 2, "IQueryable*", cloopqueryInterfaceParameters, 1, false, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<IQueryable, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IQueryable, Dummy>::cloopqueryInterfaceParameters[];
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<IQueryable, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<IReader, Dummy>
+	{
+		static constexpr const char* NAME = "IReader";
+		static constexpr unsigned INDEX = 10;
+		static constexpr unsigned VERSION = 3;
+		static constexpr unsigned METHOD_COUNT = 3;
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false},
+			{"queryInterface", 1, 2, "IQueryable*", Reflection<IQueryable, Dummy>::cloopqueryInterfaceParameters, 1, false, false},
+			{"read", 2, 3, "int", nullptr, 0, false, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<IReader, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<IReader, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<IWriter, Dummy>
+	{
+		static constexpr const char* NAME = "IWriter";
+		static constexpr unsigned INDEX = 11;
+		static constexpr unsigned VERSION = 3;
+		static constexpr unsigned METHOD_COUNT = 3;
+
+		static constexpr ParameterInfo cloopwriteParameters[] =
+		{
+			{"n", "int"}
+		};
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false},
+			{"queryInterface", 1, 2, "IQueryable*", Reflection<IQueryable, Dummy>::cloopqueryInterfaceParameters, 1, false, false},
+			{"write", 2, 3, "void", cloopwriteParameters, 1, false, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<IWriter, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IWriter, Dummy>::cloopwriteParameters[];
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<IWriter, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<IAsyncCalculator, Dummy>
+	{
+		static constexpr const char* NAME = "IAsyncCalculator";
+		static constexpr unsigned INDEX = 12;
+		static constexpr unsigned VERSION = 2;
+		static constexpr unsigned METHOD_COUNT = 3;
+
+		static constexpr ParameterInfo cloopsumParameters[] =
+		{
+			{"status", "IStatus*"},
+			{"n1", "int"},
+			{"n2", "int"}
+		};
+
+		static constexpr ParameterInfo cloopsumAsyncParameters[] =
+		{
+			{"status", "IStatus*"},
+			{"n1", "int"},
+			{"n2", "int"},
+			{"completion", "IAsyncCalculatorSumCompletion*"}
+		};
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false},
+			{"sum", 1, 2, "int", cloopsumParameters, 3, true, true},
+			{"sumAsync", 2, 2, "void", cloopsumAsyncParameters, 4, true, true}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<IAsyncCalculator, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IAsyncCalculator, Dummy>::cloopsumParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IAsyncCalculator, Dummy>::cloopsumAsyncParameters[];
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<IAsyncCalculator, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<IScanner, Dummy>
+	{
+		static constexpr const char* NAME = "IScanner";
+		static constexpr unsigned INDEX = 13;
+		static constexpr unsigned VERSION = 2;
+		static constexpr unsigned METHOD_COUNT = 4;
+
+		static constexpr ParameterInfo cloopcountCharParameters[] =
+		{
+			{"text", "StrView"},
+			{"c", "unsigned char"}
+		};
+
+		static constexpr ParameterInfo clooptrimParameters[] =
+		{
+			{"status", "IStatus*"},
+			{"text", "StrView"}
+		};
+
+		static constexpr ParameterInfo cloopchecksumParameters[] =
+		{
+			{"in", "Bytes"}
+		};
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false},
+			{"countChar", 1, 2, "unsigned", cloopcountCharParameters, 2, true, false},
+			{"trim", 2, 2, "StrView", clooptrimParameters, 2, true, true},
+			{"checksum", 3, 2, "unsigned", cloopchecksumParameters, 1, true, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<IScanner, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IScanner, Dummy>::cloopcountCharParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IScanner, Dummy>::clooptrimParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IScanner, Dummy>::cloopchecksumParameters[];
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<IScanner, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<IGeometry, Dummy>
+	{
+		static constexpr const char* NAME = "IGeometry";
+		static constexpr unsigned INDEX = 14;
+		static constexpr unsigned VERSION = 2;
+		static constexpr unsigned METHOD_COUNT = 4;
+
+		static constexpr ParameterInfo cloopmoveParameters[] =
+		{
+			{"rectangle", "Rectangle"},
+			{"offset", "Point"}
+		};
+
+		static constexpr ParameterInfo cloopareaParameters[] =
+		{
+			{"rectangle", "const Rectangle*"}
+		};
+
+		static constexpr ParameterInfo clooppayloadParameters[] =
+		{
+			{"header", "Header"}
+		};
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false},
+			{"move", 1, 2, "Rectangle", cloopmoveParameters, 2, true, false},
+			{"area", 2, 2, "int", cloopareaParameters, 1, true, false},
+			{"payload", 3, 2, "unsigned", clooppayloadParameters, 1, true, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<IGeometry, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IGeometry, Dummy>::cloopmoveParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IGeometry, Dummy>::cloopareaParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IGeometry, Dummy>::clooppayloadParameters[];
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<IGeometry, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<ISeries, Dummy>
+	{
+		static constexpr const char* NAME = "ISeries";
+		static constexpr unsigned INDEX = 15;
+		static constexpr unsigned VERSION = 2;
+		static constexpr unsigned METHOD_COUNT = 6;
+
+		static constexpr ParameterInfo clooptotalParameters[] =
+		{
+			{"values", "const int*"},
+			{"count", "unsigned"}
+		};
+
+		static constexpr ParameterInfo cloopscaleParameters[] =
+		{
+			{"in", "const int*"},
+			{"out", "int*"},
+			{"count", "unsigned"},
+			{"factor", "int"}
+		};
+
+		static constexpr ParameterInfo cloophistogramParameters[] =
+		{
+			{"data", "const unsigned char*"},
+			{"counts", "unsigned*"},
+			{"size", "unsigned"},
+			{"buckets", "unsigned"}
+		};
+
+		static constexpr ParameterInfo cloopclampParameters[] =
+		{
+			{"value", "int"},
+			{"limit", "int"}
+		};
+
+		static constexpr ParameterInfo cloopclampBatchParameters[] =
+		{
+			{"value", "const int*"},
+			{"limit", "const int*"},
+			{"results", "int*"},
+			{"count", "unsigned"}
+		};
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false},
+			{"total", 1, 2, "int", clooptotalParameters, 2, true, false},
+			{"scale", 2, 2, "void", cloopscaleParameters, 4, true, false},
+			{"histogram", 3, 2, "unsigned", cloophistogramParameters, 4, true, false},
+			{"clamp", 4, 2, "int", cloopclampParameters, 2, true, false},
+			{"clampBatch", 5, 2, "void", cloopclampBatchParameters, 4, true, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<ISeries, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<ISeries, Dummy>::clooptotalParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<ISeries, Dummy>::cloopscaleParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<ISeries, Dummy>::cloophistogramParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<ISeries, Dummy>::cloopclampParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<ISeries, Dummy>::cloopclampBatchParameters[];
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<ISeries, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<IPool, Dummy>
+	{
+		static constexpr const char* NAME = "IPool";
+		static constexpr unsigned INDEX = 16;
+		static constexpr unsigned VERSION = 2;
+		static constexpr unsigned METHOD_COUNT = 4;
+
+		static constexpr ParameterInfo cloopkeepParameters[] =
+		{
+			{"accumulator", "IAccumulator*"}
+		};
+
+		static constexpr ParameterInfo cloopsetNameParameters[] =
+		{
+			{"name", "const char*"}
+		};
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"dispose", 0, 1, "void", nullptr, 0, false, false},
+			{"keep", 1, 2, "void", cloopkeepParameters, 1, false, false},
+			{"setName", 2, 2, "void", cloopsetNameParameters, 1, false, false},
+			{"total", 3, 2, "int", nullptr, 0, true, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<IPool, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IPool, Dummy>::cloopkeepParameters[];
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IPool, Dummy>::cloopsetNameParameters[];
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<IPool, Dummy>::METHODS[];
+
+	template <typename Dummy>
+	struct Reflection<IAsyncCalculatorSumCompletion, Dummy>
+	{
+		static constexpr const char* NAME = "IAsyncCalculatorSumCompletion";
+		static constexpr unsigned INDEX = 17;
+		static constexpr unsigned VERSION = 1;
+		static constexpr unsigned METHOD_COUNT = 1;
+
+		static constexpr ParameterInfo cloopcompleteParameters[] =
+		{
+			{"status", "IStatus*"},
+			{"result", "int"}
+		};
+
+		static constexpr MethodInfo METHODS[] =
+		{
+			{"complete", 0, 1, "void", cloopcompleteParameters, 2, false, false}
+		};
+	};
+
+	template <typename Dummy>
+	constexpr const char* Reflection<IAsyncCalculatorSumCompletion, Dummy>::NAME;
+
+	template <typename Dummy>
+	constexpr ParameterInfo Reflection<IAsyncCalculatorSumCompletion, Dummy>::cloopcompleteParameters[];
+
+	template <typename Dummy>
+	constexpr MethodInfo Reflection<IAsyncCalculatorSumCompletion, Dummy>::METHODS[];
+#endif
+
+	// Interfaces implementations
+
+	template <typename Name, typename StatusType, typename Base>
+	class IDisposableBaseImpl : public Base
+	{
+	public:
+		typedef IDisposable Declaration;
+
+		IDisposableBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &IDisposableBaseImpl::cloopdisposeDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(0, 0);
+			ProbeScope cloopProbe(0, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IDisposableBaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = Inherit<IDisposable>, typename Allocator = DefaultAllocator>
+	class IDisposableImpl : public IDisposableBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		IDisposableImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~IDisposableImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual void dispose() = 0;
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class IStatusBaseImpl : public Base
+	{
+	public:
+		typedef IStatus Declaration;
+
+		IStatusBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &IStatusBaseImpl::cloopdisposeDispatcher;
+					this->getCode = &IStatusBaseImpl::cloopgetCodeDispatcher;
+					this->setCode = &IStatusBaseImpl::cloopsetCodeDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static int CLOOP_CARG cloopgetCodeDispatcher(const IStatus* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(1, 1);
+			ProbeScope cloopProbe(1, 1, self);
+
+			return static_cast<const Name*>(static_cast<const IStatusBaseImpl*>(self))->Name::getCode();
+		}
+
+		static void CLOOP_CARG cloopsetCodeDispatcher(IStatus* self, int code) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(1, 2);
+			ProbeScope cloopProbe(1, 2, self);
+
+			static_cast<Name*>(static_cast<IStatusBaseImpl*>(self))->Name::setCode(code);
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(0, 0);
+			ProbeScope cloopProbe(0, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IStatusBaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = IDisposableImpl<Name, StatusType, Inherit<IStatus> > , typename Allocator = DefaultAllocator>
+	class IStatusImpl : public IStatusBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		IStatusImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~IStatusImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual int getCode() const = 0;
+		virtual void setCode(int code) = 0;
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class IStatusFactoryBaseImpl : public Base
+	{
+	public:
+		typedef IStatusFactory Declaration;
+
+		IStatusFactoryBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &IStatusFactoryBaseImpl::cloopdisposeDispatcher;
+					this->createStatus = &IStatusFactoryBaseImpl::cloopcreateStatusDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static IStatus* CLOOP_CARG cloopcreateStatusDispatcher(IStatusFactory* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(2, 1);
+			ProbeScope cloopProbe(2, 1, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<Name*>(static_cast<IStatusFactoryBaseImpl*>(self))->Name::createStatus();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<IStatus*>(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(0, 0);
+			ProbeScope cloopProbe(0, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IStatusFactoryBaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = IDisposableImpl<Name, StatusType, Inherit<IStatusFactory> > , typename Allocator = DefaultAllocator>
+	class IStatusFactoryImpl : public IStatusFactoryBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		IStatusFactoryImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~IStatusFactoryImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual IStatus* createStatus() = 0;
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class IFactoryBaseImpl : public Base
+	{
+	public:
+		typedef IFactory Declaration;
+
+		IFactoryBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &IFactoryBaseImpl::cloopdisposeDispatcher;
+					this->createStatus = &IFactoryBaseImpl::cloopcreateStatusDispatcher;
+					this->createCalculator = &IFactoryBaseImpl::cloopcreateCalculatorDispatcher;
+					this->createCalculator2 = &IFactoryBaseImpl::cloopcreateCalculator2Dispatcher;
+					this->createBrokenCalculator = &IFactoryBaseImpl::cloopcreateBrokenCalculatorDispatcher;
+					this->setStatusFactory = &IFactoryBaseImpl::cloopsetStatusFactoryDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static IStatus* CLOOP_CARG cloopcreateStatusDispatcher(IFactory* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(3, 1);
+			ProbeScope cloopProbe(3, 1, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<Name*>(static_cast<IFactoryBaseImpl*>(self))->Name::createStatus();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<IStatus*>(0);
+			}
+#endif
+		}
+
+		static ICalculator* CLOOP_CARG cloopcreateCalculatorDispatcher(IFactory* self, IStatus* status) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(3, 2);
+			ProbeScope cloopProbe(3, 2, self);
+
+			typename StatusTraits<StatusType>::Holder status2(status);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<Name*>(static_cast<IFactoryBaseImpl*>(self))->Name::createCalculator(status2.get());
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(status2.get());
+				return static_cast<ICalculator*>(0);
+			}
+#endif
+		}
+
+		static ICalculator2* CLOOP_CARG cloopcreateCalculator2Dispatcher(IFactory* self, IStatus* status) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(3, 3);
+			ProbeScope cloopProbe(3, 3, self);
+
+			typename StatusTraits<StatusType>::Holder status2(status);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<Name*>(static_cast<IFactoryBaseImpl*>(self))->Name::createCalculator2(status2.get());
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(status2.get());
+				return static_cast<ICalculator2*>(0);
+			}
+#endif
+		}
+
+		static ICalculator* CLOOP_CARG cloopcreateBrokenCalculatorDispatcher(IFactory* self, IStatus* status) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(3, 4);
+			ProbeScope cloopProbe(3, 4, self);
+
+			typename StatusTraits<StatusType>::Holder status2(status);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<Name*>(static_cast<IFactoryBaseImpl*>(self))->Name::createBrokenCalculator(status2.get());
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(status2.get());
+				return static_cast<ICalculator*>(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopsetStatusFactoryDispatcher(IFactory* self, IStatusFactory* statusFactory) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(3, 5);
+			ProbeScope cloopProbe(3, 5, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IFactoryBaseImpl*>(self))->Name::setStatusFactory(statusFactory);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(0, 0);
+			ProbeScope cloopProbe(0, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IFactoryBaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = IDisposableImpl<Name, StatusType, Inherit<IFactory> > , typename Allocator = DefaultAllocator>
+	class IFactoryImpl : public IFactoryBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		IFactoryImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~IFactoryImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual IStatus* createStatus() = 0;
+		virtual ICalculator* createCalculator(StatusType* status) = 0;
+		virtual ICalculator2* createCalculator2(StatusType* status) = 0;
+		virtual ICalculator* createBrokenCalculator(StatusType* status) = 0;
+		virtual void setStatusFactory(IStatusFactory* statusFactory) = 0;
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class ICalculatorBaseImpl : public Base
+	{
+	public:
+		typedef ICalculator Declaration;
+
+		ICalculatorBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &ICalculatorBaseImpl::cloopdisposeDispatcher;
+					this->sum = &ICalculatorBaseImpl::cloopsumDispatcher;
+					this->getMemory = &ICalculatorBaseImpl::cloopgetMemoryDispatcher;
+					this->setMemory = &ICalculatorBaseImpl::cloopsetMemoryDispatcher;
+					this->sumAndStore = &ICalculatorBaseImpl::cloopsumAndStoreDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static int CLOOP_CARG cloopsumDispatcher(const ICalculator* self, IStatus* status, int n1, int n2) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(4, 1);
+			ProbeScope cloopProbe(4, 1, self);
+
+			typename StatusTraits<StatusType>::Holder status2(status);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const ICalculatorBaseImpl*>(self))->Name::sum(status2.get(), n1, n2);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(status2.get());
+				return static_cast<int>(0);
+			}
+#endif
+		}
+
+		static int CLOOP_CARG cloopgetMemoryDispatcher(const ICalculator* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(4, 2);
+			ProbeScope cloopProbe(4, 2, self);
+
+			return static_cast<const Name*>(static_cast<const ICalculatorBaseImpl*>(self))->Name::getMemory();
+		}
+
+		static void CLOOP_CARG cloopsetMemoryDispatcher(ICalculator* self, int n) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(4, 3);
+			ProbeScope cloopProbe(4, 3, self);
+
+			static_cast<Name*>(static_cast<ICalculatorBaseImpl*>(self))->Name::setMemory(n);
+		}
+
+		static void CLOOP_CARG cloopsumAndStoreDispatcher(ICalculator* self, IStatus* status, int n1, int n2) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(4, 4);
+			ProbeScope cloopProbe(4, 4, self);
+
+			typename StatusTraits<StatusType>::Holder status2(status);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<ICalculatorBaseImpl*>(self))->Name::sumAndStore(status2.get(), n1, n2);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(status2.get());
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(0, 0);
+			ProbeScope cloopProbe(0, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<ICalculatorBaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = IDisposableImpl<Name, StatusType, Inherit<ICalculator> > , typename Allocator = DefaultAllocator>
+	class ICalculatorImpl : public ICalculatorBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		ICalculatorImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~ICalculatorImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual int sum(StatusType* status, int n1, int n2) const = 0;
+		virtual int getMemory() const = 0;
+		virtual void setMemory(int n) = 0;
+		virtual void sumAndStore(StatusType* status, int n1, int n2) = 0;
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class ICalculator2BaseImpl : public Base
+	{
+	public:
+		typedef ICalculator2 Declaration;
+
+		ICalculator2BaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &ICalculator2BaseImpl::cloopdisposeDispatcher;
+					this->sum = &ICalculator2BaseImpl::cloopsumDispatcher;
+					this->getMemory = &ICalculator2BaseImpl::cloopgetMemoryDispatcher;
+					this->setMemory = &ICalculator2BaseImpl::cloopsetMemoryDispatcher;
+					this->sumAndStore = &ICalculator2BaseImpl::cloopsumAndStoreDispatcher;
+					this->multiply = &ICalculator2BaseImpl::cloopmultiplyDispatcher;
+					this->copyMemory = &ICalculator2BaseImpl::cloopcopyMemoryDispatcher;
+					this->copyMemory2 = &ICalculator2BaseImpl::cloopcopyMemory2Dispatcher;
+					this->multiplyBatch = &ICalculator2BaseImpl::cloopmultiplyBatchDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static int CLOOP_CARG cloopmultiplyDispatcher(const ICalculator2* self, IStatus* status, int n1, int n2) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(5, 5);
+			ProbeScope cloopProbe(5, 5, self);
+
+			typename StatusTraits<StatusType>::Holder status2(status);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const ICalculator2BaseImpl*>(self))->Name::multiply(status2.get(), n1, n2);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(status2.get());
+				return static_cast<int>(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopcopyMemoryDispatcher(ICalculator2* self, const ICalculator* calculator) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(5, 6);
+			ProbeScope cloopProbe(5, 6, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<ICalculator2BaseImpl*>(self))->Name::copyMemory(calculator);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopcopyMemory2Dispatcher(ICalculator2* self, const int* address) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(5, 7);
+			ProbeScope cloopProbe(5, 7, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<ICalculator2BaseImpl*>(self))->Name::copyMemory2(address);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopmultiplyBatchDispatcher(const ICalculator2* self, IStatus* status, const int* n1, const int* n2, int* results, unsigned count) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(5, 8);
+			ProbeScope cloopProbe(5, 8, self);
+
+			typename StatusTraits<StatusType>::Holder status2(status);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<const Name*>(static_cast<const ICalculator2BaseImpl*>(self))->Name::multiplyBatch(status2.get(), n1, n2, results, count);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(status2.get());
+			}
+#endif
+		}
+
+		static int CLOOP_CARG cloopsumDispatcher(const ICalculator* self, IStatus* status, int n1, int n2) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(4, 1);
+			ProbeScope cloopProbe(4, 1, self);
+
+			typename StatusTraits<StatusType>::Holder status2(status);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const ICalculator2BaseImpl*>(self))->Name::sum(status2.get(), n1, n2);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(status2.get());
+				return static_cast<int>(0);
+			}
+#endif
+		}
+
+		static int CLOOP_CARG cloopgetMemoryDispatcher(const ICalculator* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(4, 2);
+			ProbeScope cloopProbe(4, 2, self);
+
+			return static_cast<const Name*>(static_cast<const ICalculator2BaseImpl*>(self))->Name::getMemory();
+		}
+
+		static void CLOOP_CARG cloopsetMemoryDispatcher(ICalculator* self, int n) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(4, 3);
+			ProbeScope cloopProbe(4, 3, self);
+
+			static_cast<Name*>(static_cast<ICalculator2BaseImpl*>(self))->Name::setMemory(n);
+		}
+
+		static void CLOOP_CARG cloopsumAndStoreDispatcher(ICalculator* self, IStatus* status, int n1, int n2) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(4, 4);
+			ProbeScope cloopProbe(4, 4, self);
+
+			typename StatusTraits<StatusType>::Holder status2(status);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<ICalculator2BaseImpl*>(self))->Name::sumAndStore(status2.get(), n1, n2);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(status2.get());
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(0, 0);
+			ProbeScope cloopProbe(0, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<ICalculator2BaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = ICalculatorImpl<Name, StatusType, Inherit<IDisposableImpl<Name, StatusType, Inherit<ICalculator2> > > > , typename Allocator = DefaultAllocator>
+	class ICalculator2Impl : public ICalculator2BaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		ICalculator2Impl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~ICalculator2Impl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual int multiply(StatusType* status, int n1, int n2) const = 0;
+		virtual void copyMemory(const ICalculator* calculator) = 0;
+		virtual void copyMemory2(const int* address) = 0;
+		virtual void multiplyBatch(StatusType* status, const int* n1, const int* n2, int* results, unsigned count) const
+		{
+			for (unsigned cloopIndex = 0; cloopIndex < count; ++cloopIndex)
+			{
+				results[cloopIndex] = multiply(status, n1[cloopIndex], n2[cloopIndex]);
+#ifdef CLOOP_NO_EXCEPTIONS
+				if (StatusType::hasError(status))
+					return;
+#endif
+			}
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class ICounterBaseImpl : public Base
+	{
+	public:
+		typedef ICounter Declaration;
+
+		ICounterBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &ICounterBaseImpl::cloopdisposeDispatcher;
+					this->increment = &ICounterBaseImpl::cloopincrementDispatcher;
+					this->getValue = &ICounterBaseImpl::cloopgetValueDispatcher;
+					this->add = &ICounterBaseImpl::cloopaddDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(ICounter* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(6, 0);
+			ProbeScope cloopProbe(6, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<ICounterBaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+
+		static int CLOOP_CARG cloopincrementDispatcher(ICounter* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(6, 1);
+			ProbeScope cloopProbe(6, 1, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<Name*>(static_cast<ICounterBaseImpl*>(self))->Name::increment();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<int>(0);
+			}
+#endif
+		}
+
+		static int CLOOP_CARG cloopgetValueDispatcher(const ICounter* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(6, 2);
+			ProbeScope cloopProbe(6, 2, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const ICounterBaseImpl*>(self))->Name::getValue();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<int>(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopaddDispatcher(ICounter* self, const ICounter* counter) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(6, 3);
+			ProbeScope cloopProbe(6, 3, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<ICounterBaseImpl*>(self))->Name::add(counter);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = Inherit<ICounter>, typename Allocator = DefaultAllocator>
+	class ICounterImpl : public ICounterBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		ICounterImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~ICounterImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual void dispose() = 0;
+		virtual int increment() = 0;
+		virtual int getValue() const = 0;
+		virtual void add(const ICounter* counter) = 0;
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class IReferenceCountedBaseImpl : public Base
+	{
+	public:
+		typedef IReferenceCounted Declaration;
+
+		IReferenceCountedBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->addRef = &IReferenceCountedBaseImpl::cloopaddRefDispatcher;
+					this->release = &IReferenceCountedBaseImpl::cloopreleaseDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static void CLOOP_CARG cloopaddRefDispatcher(IReferenceCounted* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(7, 0);
+			ProbeScope cloopProbe(7, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IReferenceCountedBaseImpl*>(self))->Name::addRef();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+
+		static int CLOOP_CARG cloopreleaseDispatcher(IReferenceCounted* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(7, 1);
+			ProbeScope cloopProbe(7, 1, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<Name*>(static_cast<IReferenceCountedBaseImpl*>(self))->Name::release();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<int>(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = Inherit<IReferenceCounted>, typename Allocator = DefaultAllocator>
+	class IReferenceCountedImpl : public IReferenceCountedBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		IReferenceCountedImpl(DoNotInherit = DoNotInherit())
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+			: cloopRefCount(1)
+#endif
+		{
+		}
+
+	public:
+		virtual ~IReferenceCountedImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+		virtual void addRef()
+		{
+			cloopRefCount.fetch_add(1, RefCountTraits<Name>::Order::INCREMENT);
+		}
+#else
+		virtual void addRef() = 0;
+#endif
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+		virtual int release()
+		{
+			int count = cloopRefCount.fetch_sub(1, RefCountTraits<Name>::Order::DECREMENT) - 1;
+
+			if (count == 0)
+				delete this;
+
+			return count;
+		}
+#else
+		virtual int release() = 0;
+#endif
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+	private:
+		std::atomic<int> cloopRefCount;
+#endif
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class IAccumulatorBaseImpl : public Base
+	{
+	public:
+		typedef IAccumulator Declaration;
+
+		IAccumulatorBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->addRef = &IAccumulatorBaseImpl::cloopaddRefDispatcher;
+					this->release = &IAccumulatorBaseImpl::cloopreleaseDispatcher;
+					this->add = &IAccumulatorBaseImpl::cloopaddDispatcher;
+					this->getTotal = &IAccumulatorBaseImpl::cloopgetTotalDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static void CLOOP_CARG cloopaddDispatcher(IAccumulator* self, int n) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(8, 2);
+			ProbeScope cloopProbe(8, 2, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IAccumulatorBaseImpl*>(self))->Name::add(n);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+
+		static int CLOOP_CARG cloopgetTotalDispatcher(const IAccumulator* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(8, 3);
+			ProbeScope cloopProbe(8, 3, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const IAccumulatorBaseImpl*>(self))->Name::getTotal();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<int>(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopaddRefDispatcher(IReferenceCounted* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(7, 0);
+			ProbeScope cloopProbe(7, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IAccumulatorBaseImpl*>(self))->Name::addRef();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+
+		static int CLOOP_CARG cloopreleaseDispatcher(IReferenceCounted* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(7, 1);
+			ProbeScope cloopProbe(7, 1, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<Name*>(static_cast<IAccumulatorBaseImpl*>(self))->Name::release();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<int>(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = IReferenceCountedImpl<Name, StatusType, Inherit<IAccumulator> > , typename Allocator = DefaultAllocator>
+	class IAccumulatorImpl : public IAccumulatorBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		IAccumulatorImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~IAccumulatorImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual void add(int n) = 0;
+		virtual int getTotal() const = 0;
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class IQueryableBaseImpl : public Base
+	{
+	public:
+		typedef IQueryable Declaration;
+
+		IQueryableBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &IQueryableBaseImpl::cloopdisposeDispatcher;
+					this->queryInterface = &IQueryableBaseImpl::cloopqueryInterfaceDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static IQueryable* CLOOP_CARG cloopqueryInterfaceDispatcher(IQueryable* self, unsigned id) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(9, 1);
+			ProbeScope cloopProbe(9, 1, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<Name*>(static_cast<IQueryableBaseImpl*>(self))->Name::queryInterface(id);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<IQueryable*>(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(0, 0);
+			ProbeScope cloopProbe(0, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IQueryableBaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = IDisposableImpl<Name, StatusType, Inherit<IQueryable> > , typename Allocator = DefaultAllocator>
+	class IQueryableImpl : public IQueryableBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		IQueryableImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~IQueryableImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual IQueryable* queryInterface(unsigned id) = 0;
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class IReaderBaseImpl : public Base
+	{
+	public:
+		typedef IReader Declaration;
+
+		IReaderBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &IReaderBaseImpl::cloopdisposeDispatcher;
+					this->queryInterface = &IReaderBaseImpl::cloopqueryInterfaceDispatcher;
+					this->read = &IReaderBaseImpl::cloopreadDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static int CLOOP_CARG cloopreadDispatcher(IReader* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(10, 2);
+			ProbeScope cloopProbe(10, 2, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<Name*>(static_cast<IReaderBaseImpl*>(self))->Name::read();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<int>(0);
+			}
+#endif
+		}
+
+		static IQueryable* CLOOP_CARG cloopqueryInterfaceDispatcher(IQueryable* self, unsigned id) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(9, 1);
+			ProbeScope cloopProbe(9, 1, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<Name*>(static_cast<IReaderBaseImpl*>(self))->Name::queryInterface(id);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<IQueryable*>(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(0, 0);
+			ProbeScope cloopProbe(0, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IReaderBaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = IQueryableImpl<Name, StatusType, Inherit<IDisposableImpl<Name, StatusType, Inherit<IReader> > > > , typename Allocator = DefaultAllocator>
+	class IReaderImpl : public IReaderBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		IReaderImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~IReaderImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual int read() = 0;
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class IWriterBaseImpl : public Base
+	{
+	public:
+		typedef IWriter Declaration;
+
+		IWriterBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &IWriterBaseImpl::cloopdisposeDispatcher;
+					this->queryInterface = &IWriterBaseImpl::cloopqueryInterfaceDispatcher;
+					this->write = &IWriterBaseImpl::cloopwriteDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static void CLOOP_CARG cloopwriteDispatcher(IWriter* self, int n) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(11, 2);
+			ProbeScope cloopProbe(11, 2, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IWriterBaseImpl*>(self))->Name::write(n);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+
+		static IQueryable* CLOOP_CARG cloopqueryInterfaceDispatcher(IQueryable* self, unsigned id) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(9, 1);
+			ProbeScope cloopProbe(9, 1, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<Name*>(static_cast<IWriterBaseImpl*>(self))->Name::queryInterface(id);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<IQueryable*>(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(0, 0);
+			ProbeScope cloopProbe(0, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IWriterBaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = IQueryableImpl<Name, StatusType, Inherit<IDisposableImpl<Name, StatusType, Inherit<IWriter> > > > , typename Allocator = DefaultAllocator>
+	class IWriterImpl : public IWriterBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		IWriterImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~IWriterImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual void write(int n) = 0;
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class IAsyncCalculatorBaseImpl : public Base
+	{
+	public:
+		typedef IAsyncCalculator Declaration;
+
+		IAsyncCalculatorBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &IAsyncCalculatorBaseImpl::cloopdisposeDispatcher;
+					this->sum = &IAsyncCalculatorBaseImpl::cloopsumDispatcher;
+					this->sumAsync = &IAsyncCalculatorBaseImpl::cloopsumAsyncDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static int CLOOP_CARG cloopsumDispatcher(const IAsyncCalculator* self, IStatus* status, int n1, int n2) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(12, 1);
+			ProbeScope cloopProbe(12, 1, self);
+
+			typename StatusTraits<StatusType>::Holder status2(status);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const IAsyncCalculatorBaseImpl*>(self))->Name::sum(status2.get(), n1, n2);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(status2.get());
+				return static_cast<int>(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopsumAsyncDispatcher(const IAsyncCalculator* self, IStatus* status, int n1, int n2, IAsyncCalculatorSumCompletion* completion) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(12, 2);
+			ProbeScope cloopProbe(12, 2, self);
+
+			typename StatusTraits<StatusType>::Holder status2(status);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<const Name*>(static_cast<const IAsyncCalculatorBaseImpl*>(self))->Name::sumAsync(status2.get(), n1, n2, completion);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(status2.get());
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(0, 0);
+			ProbeScope cloopProbe(0, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IAsyncCalculatorBaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = IDisposableImpl<Name, StatusType, Inherit<IAsyncCalculator> > , typename Allocator = DefaultAllocator>
+	class IAsyncCalculatorImpl : public IAsyncCalculatorBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		IAsyncCalculatorImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~IAsyncCalculatorImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual int sum(StatusType* status, int n1, int n2) const = 0;
+		virtual void sumAsync(StatusType* status, int n1, int n2, IAsyncCalculatorSumCompletion* completion) const
+		{
+			int result = sum(status, n1, n2);
+#ifdef CLOOP_NO_EXCEPTIONS
+			if (StatusType::hasError(status))
+				return;
+#endif
+			completion->complete(status, result);
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class IScannerBaseImpl : public Base
+	{
+	public:
+		typedef IScanner Declaration;
+
+		IScannerBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &IScannerBaseImpl::cloopdisposeDispatcher;
+					this->countChar = &IScannerBaseImpl::cloopcountCharDispatcher;
+					this->trim = &IScannerBaseImpl::clooptrimDispatcher;
+					this->checksum = &IScannerBaseImpl::cloopchecksumDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static unsigned CLOOP_CARG cloopcountCharDispatcher(const IScanner* self, StrView text, unsigned char c) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(13, 1);
+			ProbeScope cloopProbe(13, 1, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const IScannerBaseImpl*>(self))->Name::countChar(text, c);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<unsigned>(0);
+			}
+#endif
+		}
+
+		static StrView CLOOP_CARG clooptrimDispatcher(const IScanner* self, IStatus* status, StrView text) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(13, 2);
+			ProbeScope cloopProbe(13, 2, self);
+
+			typename StatusTraits<StatusType>::Holder status2(status);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const IScannerBaseImpl*>(self))->Name::trim(status2.get(), text);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(status2.get());
+				return StrView();
+			}
+#endif
+		}
+
+		static unsigned CLOOP_CARG cloopchecksumDispatcher(const IScanner* self, Bytes in) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(13, 3);
+			ProbeScope cloopProbe(13, 3, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const IScannerBaseImpl*>(self))->Name::checksum(in);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<unsigned>(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(0, 0);
+			ProbeScope cloopProbe(0, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IScannerBaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = IDisposableImpl<Name, StatusType, Inherit<IScanner> > , typename Allocator = DefaultAllocator>
+	class IScannerImpl : public IScannerBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		IScannerImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~IScannerImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual unsigned countChar(StrView text, unsigned char c) const = 0;
+		virtual StrView trim(StatusType* status, StrView text) const = 0;
+		virtual unsigned checksum(Bytes in) const = 0;
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class IGeometryBaseImpl : public Base
+	{
+	public:
+		typedef IGeometry Declaration;
+
+		IGeometryBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &IGeometryBaseImpl::cloopdisposeDispatcher;
+					this->move = &IGeometryBaseImpl::cloopmoveDispatcher;
+					this->area = &IGeometryBaseImpl::cloopareaDispatcher;
+					this->payload = &IGeometryBaseImpl::clooppayloadDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static Rectangle CLOOP_CARG cloopmoveDispatcher(const IGeometry* self, Rectangle rectangle, Point offset) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(14, 1);
+			ProbeScope cloopProbe(14, 1, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const IGeometryBaseImpl*>(self))->Name::move(rectangle, offset);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return Rectangle();
+			}
+#endif
+		}
+
+		static int CLOOP_CARG cloopareaDispatcher(const IGeometry* self, const Rectangle* rectangle) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(14, 2);
+			ProbeScope cloopProbe(14, 2, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const IGeometryBaseImpl*>(self))->Name::area(rectangle);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<int>(0);
+			}
+#endif
+		}
+
+		static unsigned CLOOP_CARG clooppayloadDispatcher(const IGeometry* self, Header header) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(14, 3);
+			ProbeScope cloopProbe(14, 3, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const IGeometryBaseImpl*>(self))->Name::payload(header);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<unsigned>(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(0, 0);
+			ProbeScope cloopProbe(0, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IGeometryBaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = IDisposableImpl<Name, StatusType, Inherit<IGeometry> > , typename Allocator = DefaultAllocator>
+	class IGeometryImpl : public IGeometryBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		IGeometryImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~IGeometryImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual Rectangle move(Rectangle rectangle, Point offset) const = 0;
+		virtual int area(const Rectangle* rectangle) const = 0;
+		virtual unsigned payload(Header header) const = 0;
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class ISeriesBaseImpl : public Base
+	{
+	public:
+		typedef ISeries Declaration;
+
+		ISeriesBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &ISeriesBaseImpl::cloopdisposeDispatcher;
+					this->total = &ISeriesBaseImpl::clooptotalDispatcher;
+					this->scale = &ISeriesBaseImpl::cloopscaleDispatcher;
+					this->histogram = &ISeriesBaseImpl::cloophistogramDispatcher;
+					this->clamp = &ISeriesBaseImpl::cloopclampDispatcher;
+					this->clampBatch = &ISeriesBaseImpl::cloopclampBatchDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static int CLOOP_CARG clooptotalDispatcher(const ISeries* self, const int* values, unsigned count) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(15, 1);
+			ProbeScope cloopProbe(15, 1, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const ISeriesBaseImpl*>(self))->Name::total(values, count);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<int>(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopscaleDispatcher(const ISeries* self, const int* in, int* out, unsigned count, int factor) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(15, 2);
+			ProbeScope cloopProbe(15, 2, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<const Name*>(static_cast<const ISeriesBaseImpl*>(self))->Name::scale(in, out, count, factor);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+
+		static unsigned CLOOP_CARG cloophistogramDispatcher(const ISeries* self, const unsigned char* data, unsigned* counts, unsigned size, unsigned buckets) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(15, 3);
+			ProbeScope cloopProbe(15, 3, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const ISeriesBaseImpl*>(self))->Name::histogram(data, counts, size, buckets);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<unsigned>(0);
+			}
+#endif
+		}
+
+		static int CLOOP_CARG cloopclampDispatcher(const ISeries* self, int value, int limit) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(15, 4);
+			ProbeScope cloopProbe(15, 4, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const ISeriesBaseImpl*>(self))->Name::clamp(value, limit);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<int>(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopclampBatchDispatcher(const ISeries* self, const int* value, const int* limit, int* results, unsigned count) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(15, 5);
+			ProbeScope cloopProbe(15, 5, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<const Name*>(static_cast<const ISeriesBaseImpl*>(self))->Name::clampBatch(value, limit, results, count);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(0, 0);
+			ProbeScope cloopProbe(0, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<ISeriesBaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = IDisposableImpl<Name, StatusType, Inherit<ISeries> > , typename Allocator = DefaultAllocator>
+	class ISeriesImpl : public ISeriesBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		ISeriesImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~ISeriesImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual int total(const int* values, unsigned count) const = 0;
+		virtual void scale(const int* in, int* out, unsigned count, int factor) const = 0;
+		virtual unsigned histogram(const unsigned char* data, unsigned* counts, unsigned size, unsigned buckets) const = 0;
+		virtual int clamp(int value, int limit) const = 0;
+		virtual void clampBatch(const int* value, const int* limit, int* results, unsigned count) const
+		{
+			for (unsigned cloopIndex = 0; cloopIndex < count; ++cloopIndex)
+			{
+				results[cloopIndex] = clamp(value[cloopIndex], limit[cloopIndex]);
+			}
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class IPoolBaseImpl : public Base
+	{
+	public:
+		typedef IPool Declaration;
+
+		IPoolBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->dispose = &IPoolBaseImpl::cloopdisposeDispatcher;
+					this->keep = &IPoolBaseImpl::cloopkeepDispatcher;
+					this->setName = &IPoolBaseImpl::cloopsetNameDispatcher;
+					this->total = &IPoolBaseImpl::clooptotalDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static void CLOOP_CARG cloopkeepDispatcher(IPool* self, IAccumulator* accumulator) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(16, 1);
+			ProbeScope cloopProbe(16, 1, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IPoolBaseImpl*>(self))->Name::keep(accumulator);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopsetNameDispatcher(IPool* self, const char* name) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(16, 2);
+			ProbeScope cloopProbe(16, 2, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IPoolBaseImpl*>(self))->Name::setName(name);
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+
+		static int CLOOP_CARG clooptotalDispatcher(const IPool* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(16, 3);
+			ProbeScope cloopProbe(16, 3, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				return static_cast<const Name*>(static_cast<const IPoolBaseImpl*>(self))->Name::total();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+				return static_cast<int>(0);
+			}
+#endif
+		}
+
+		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(0, 0);
+			ProbeScope cloopProbe(0, 0, self);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+			try
+			{
+#endif
+				static_cast<Name*>(static_cast<IPoolBaseImpl*>(self))->Name::dispose();
+#ifndef CLOOP_NO_EXCEPTIONS
+			}
+			catch (...)
+			{
+				cloopTrace.failed();
+				StatusType::catchException(0);
+			}
+#endif
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = IDisposableImpl<Name, StatusType, Inherit<IPool> > , typename Allocator = DefaultAllocator>
+	class IPoolImpl : public IPoolBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		IPoolImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~IPoolImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual void keep(IAccumulator* accumulator) = 0;
+		virtual void setName(const char* name) = 0;
+		virtual int total() const = 0;
+	};
+
+	template <typename Name, typename StatusType, typename Base>
+	class IAsyncCalculatorSumCompletionBaseImpl : public Base
+	{
+	public:
+		typedef IAsyncCalculatorSumCompletion Declaration;
+
+		IAsyncCalculatorSumCompletionBaseImpl(DoNotInherit = DoNotInherit())
+		{
+			static struct VTableImpl : Base::VTable
+			{
+				VTableImpl()
+				{
+					this->version = Base::VERSION;
+					this->complete = &IAsyncCalculatorSumCompletionBaseImpl::cloopcompleteDispatcher;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static void CLOOP_CARG cloopcompleteDispatcher(IAsyncCalculatorSumCompletion* self, IStatus* status, int result) throw()
+		{
+			TraceScope<typename TraceTraits<Name>::Policy> cloopTrace(17, 0);
+			ProbeScope cloopProbe(17, 0, self);
+
+			typename StatusTraits<StatusType>::Holder status2(status);
+
+			static_cast<Name*>(static_cast<IAsyncCalculatorSumCompletionBaseImpl*>(self))->Name::complete(status2.get(), result);
+		}
+	};
+
+	template <typename Name, typename StatusType, typename Base = Inherit<IAsyncCalculatorSumCompletion>, typename Allocator = DefaultAllocator>
+	class IAsyncCalculatorSumCompletionImpl : public IAsyncCalculatorSumCompletionBaseImpl<Name, StatusType, Base>
+	{
+	protected:
+		IAsyncCalculatorSumCompletionImpl(DoNotInherit = DoNotInherit())
+		{
+		}
+
+	public:
+		virtual ~IAsyncCalculatorSumCompletionImpl()
+		{
+		}
+
+		static void* operator new(size_t size)
+		{
+			return Allocator::allocate(size);
+		}
+
+		static void operator delete(void* ptr, size_t size)
+		{
+			Allocator::deallocate(ptr, size);
+		}
+
+		static void* operator new(size_t size, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, nothrow);
+		}
+
+		static void operator delete(void* ptr, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0);
+		}
+
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		static void operator delete(void*, void*)
+		{
+		}
+
+#ifdef __cpp_aligned_new
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return Allocator::allocate(size, alignment);
+		}
+
+		static void operator delete(void* ptr, size_t size, std::align_val_t alignment)
+		{
+			Allocator::deallocate(ptr, size, alignment);
+		}
+
+		static void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) throw()
+		{
+			return Allocator::allocate(size, alignment, nothrow);
+		}
+
+		static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) throw()
+		{
+			Allocator::deallocate(ptr, 0, alignment);
+		}
+#endif
+
+		virtual void complete(StatusType* status, int result) = 0;
+	};
+
+	// Multiple interfaces implementations (C++14)
+
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+	template <unsigned COUNT>
+	struct InterfaceHash
+	{
+		uint32_t factor;
+		uint32_t bits;
+		unsigned char indexes[256];
+
+		static constexpr uint32_t slot(uint32_t iid, uint32_t factor, uint32_t bits)
+		{
+			return (uint32_t) (iid * factor) >> (32 - bits);
+		}
+
+		static constexpr InterfaceHash build(const uint32_t (&iids)[COUNT])
+		{
+			InterfaceHash hash = {0, 0, {}};
+
+			for (uint32_t bits = 1; bits <= 8; ++bits)
+			{
+				if ((1u << bits) < COUNT * 2)
+					continue;
+
+				for (uint32_t attempt = 0; attempt < 1024; ++attempt)
+				{
+					uint32_t factor = 0x9E3779B1u + attempt * 2;
+					bool perfect = true;
+
+					for (uint32_t i = 0; i < (1u << bits); ++i)
+						hash.indexes[i] = COUNT;
+
+					for (unsigned i = 0; perfect && i < COUNT; ++i)
+					{
+						uint32_t n = slot(iids[i], factor, bits);
+
+						if (hash.indexes[n] == COUNT)
+							hash.indexes[n] = i;
+						else
+							perfect = false;
+					}
+
+					if (perfect)
+					{
+						hash.factor = factor;
+						hash.bits = bits;
+						return hash;
+					}
+				}
+			}
+
+			return hash;
+		}
+	};
+
+	template <typename Owner, typename... Interfaces>
+	class InterfaceTable
+	{
+	public:
+		static IQueryable* query(Owner* owner, uint32_t iid)
+		{
+			unsigned index = HASH.indexes[InterfaceHash<COUNT>::slot(iid, HASH.factor, HASH.bits)];
+			return index < COUNT && IIDS[index] == iid ? CASTS[index](owner) : 0;
+		}
+
+	private:
+		template <typename Interface>
+		static IQueryable* cast(Owner* owner)
+		{
+			return static_cast<Interface*>(owner);
+		}
+
+		static constexpr unsigned COUNT = sizeof...(Interfaces);
+		static_assert(COUNT < 128, "Too many interfaces.");
+
+		static constexpr uint32_t IIDS[COUNT] = {Interfaces::IID...};
+		static constexpr InterfaceHash<COUNT> HASH = InterfaceHash<COUNT>::build(IIDS);
+		static_assert(HASH.bits != 0, "no perfect hash found (duplicate iids?)");
+
+		static IQueryable* (* const CASTS[COUNT])(Owner*);
+	};
+
+	template <typename Owner, typename... Interfaces>
+	constexpr uint32_t InterfaceTable<Owner, Interfaces...>::IIDS[];
+
+	template <typename Owner, typename... Interfaces>
+	constexpr InterfaceHash<InterfaceTable<Owner, Interfaces...>::COUNT> InterfaceTable<Owner, Interfaces...>::HASH;
+
+	template <typename Owner, typename... Interfaces>
+	IQueryable* (* const InterfaceTable<Owner, Interfaces...>::CASTS[])(Owner*) =
+		{&InterfaceTable::template cast<Interfaces>...};
+
+	template <typename First, typename... Impls>
+	class MultiImpl : public First, public Impls...
+	{
+	public:
+		virtual IQueryable* queryInterface(unsigned id)
+		{
+			return InterfaceTable<MultiImpl, typename First::Declaration, typename Impls::Declaration...>::query(this, id);
+		}
+
+		using First::operator new;
+		using First::operator delete;
+	};
+#endif
+
+	// Command strings (C++11)
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+	inline void appendCommandString(std::vector<uint64_t>& command, const char* str)
+	{
+		if (!str)
+		{
+			command.push_back(~(uint64_t) 0);
+			return;
+		}
+
+		size_t length = strlen(str);
+		size_t position = command.size() + 1;
+
+		command.push_back(length);
+		command.resize(position + length / sizeof(uint64_t) + 1);
+		memcpy(&command[position], str, length);
+	}
+
+	// Reads the string at cell, which ends in the zeros filling its last cell.
+	inline const char* readCommandString(const uint64_t* command, unsigned& cell)
+	{
+		uint64_t length = command[cell++];
+
+		if (length == ~(uint64_t) 0)
+			return nullptr;
+
+		const char* str = (const char*) (command + cell);
+		cell += (unsigned) (length / sizeof(uint64_t) + 1);
+		return str;
+	}
+#endif
+
+	// Recording proxies (C++11)
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+	class CallLog
+	{
+	public:
+		uint64_t identify(const void* object)
+		{
+			if (!object)
+				return 0;
+
+			std::lock_guard<std::mutex> guard(mutex);
+			uint64_t& identity = identities[object];
+
+			if (!identity)
+				identity = identities.size();
+
+			return identity;
+		}
+
+		void write(const std::vector<uint64_t>& command)
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			uint64_t* cells = buffer.append((unsigned) command.size());
+
+			for (size_t i = 0; i < command.size(); ++i)
+				cells[i] = command[i];
+		}
+
+		// Number of calls written, which replayCalls returns when it replays all of them.
+		unsigned calls() const
+		{
+			unsigned n = 0;
+
+			for (unsigned position = 0; position < buffer.size(); ++n)
+				position += (unsigned) (buffer.data()[position] >> 32);
+
+			return n;
+		}
+
+		const CommandBuffer& commands() const
+		{
+			return buffer;
+		}
+
+		bool save(const char* filename) const
+		{
+			FILE* file = fopen(filename, "wb");
+
+			if (!file)
+				return false;
+
+			bool ok = fwrite(buffer.data(), sizeof(uint64_t), buffer.size(), file) == buffer.size();
+			return fclose(file) == 0 && ok;
+		}
+
+		bool load(const char* filename)
+		{
+			FILE* file = fopen(filename, "rb");
+
+			if (!file)
+				return false;
+
+			uint64_t cell;
+			buffer.clear();
+
+			while (fread(&cell, sizeof(cell), 1, file) == 1)
+				*buffer.append(1) = cell;
+
+			return fclose(file) == 0;
+		}
+
+	private:
+		std::mutex mutex;
+		CommandBuffer buffer;
+		std::unordered_map<const void*, uint64_t> identities;
+	};
+
+	class CallRecording
+	{
+	public:
+		CallRecording(CallLog* log, unsigned interfaceIndex, unsigned slot, const void* object)
+			: log(depth()++ == 0 ? log : nullptr)
+		{
+			if (this->log)
+			{
+				command.push_back(CommandBuffer::header(0, interfaceIndex, slot));
+				command.push_back(log->identify(object));
+			}
+		}
+
+		~CallRecording()
+		{
+			--depth();
+
+			if (log)
+			{
+				command[0] |= (uint64_t) command.size() << 32;
+				log->write(command);
+			}
+		}
+
+	private:
+		CallRecording(const CallRecording&);
+		CallRecording& operator =(const CallRecording&);
+
+	public:
+		void append(uint64_t cell)
+		{
+			if (log)
+				command.push_back(cell);
+		}
+
+		void appendObject(const void* object)
+		{
+			if (log)
+				command.push_back(log->identify(object));
+		}
+
+		void appendString(const char* str)
+		{
+			if (log)
+				appendCommandString(command, str);
+		}
+
+	private:
+		static unsigned& depth()
+		{
+			static thread_local unsigned depth;
+			return depth;
+		}
+
+	private:
+		CallLog* log;
+		std::vector<uint64_t> command;
+	};
+
+	template <typename StatusType>
+	class IDisposableRecordingProxy : public IDisposableImpl<IDisposableRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		IDisposableRecordingProxy(IDisposable* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 0, 0, target);
+
+			target->dispose();
+		}
+
+	private:
+		IDisposable* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class IStatusRecordingProxy : public IStatusImpl<IStatusRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		IStatusRecordingProxy(IStatus* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 0, 0, target);
+
+			target->dispose();
+		}
+
+		virtual int getCode() const
+		{
+			CallRecording recording(log, 1, 1, target);
+
+			int ret = target->getCode();
+			return ret;
+		}
+
+		virtual void setCode(int code)
+		{
+			CallRecording recording(log, 1, 2, target);
+			recording.append(CommandCell<int>::encode(code));
+
+			target->setCode(code);
+		}
+
+	private:
+		IStatus* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class IStatusFactoryRecordingProxy : public IStatusFactoryImpl<IStatusFactoryRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		IStatusFactoryRecordingProxy(IStatusFactory* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 0, 0, target);
+
+			target->dispose();
+		}
+
+		virtual IStatus* createStatus()
+		{
+			CallRecording recording(log, 2, 1, target);
+
+			IStatus* ret = target->createStatus();
+			recording.appendObject(ret);
+			return ret;
+		}
+
+	private:
+		IStatusFactory* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class IFactoryRecordingProxy : public IFactoryImpl<IFactoryRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		IFactoryRecordingProxy(IFactory* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 0, 0, target);
+
+			target->dispose();
+		}
+
+		virtual IStatus* createStatus()
+		{
+			CallRecording recording(log, 3, 1, target);
+
+			IStatus* ret = target->createStatus();
+			recording.appendObject(ret);
+			return ret;
+		}
+
+		virtual ICalculator* createCalculator(StatusType* status)
+		{
+			CallRecording recording(log, 3, 2, target);
+
+			ICalculator* ret = target->createCalculator(status);
+			recording.appendObject(ret);
+			return ret;
+		}
+
+		virtual ICalculator2* createCalculator2(StatusType* status)
+		{
+			CallRecording recording(log, 3, 3, target);
+
+			ICalculator2* ret = target->createCalculator2(status);
+			recording.appendObject(ret);
+			return ret;
+		}
+
+		virtual ICalculator* createBrokenCalculator(StatusType* status)
+		{
+			CallRecording recording(log, 3, 4, target);
+
+			ICalculator* ret = target->createBrokenCalculator(status);
+			recording.appendObject(ret);
+			return ret;
+		}
+
+		virtual void setStatusFactory(IStatusFactory* statusFactory)
+		{
+			CallRecording recording(log, 3, 5, target);
+			recording.appendObject(statusFactory);
+
+			target->setStatusFactory(statusFactory);
+		}
+
+	private:
+		IFactory* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class ICalculatorRecordingProxy : public ICalculatorImpl<ICalculatorRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		ICalculatorRecordingProxy(ICalculator* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 0, 0, target);
+
+			target->dispose();
+		}
+
+		virtual int sum(StatusType* status, int n1, int n2) const
+		{
+			CallRecording recording(log, 4, 1, target);
+			recording.append(CommandCell<int>::encode(n1));
+			recording.append(CommandCell<int>::encode(n2));
+
+			int ret = target->sum(status, n1, n2);
+			return ret;
+		}
+
+		virtual int getMemory() const
+		{
+			CallRecording recording(log, 4, 2, target);
+
+			int ret = target->getMemory();
+			return ret;
+		}
+
+		virtual void setMemory(int n)
+		{
+			CallRecording recording(log, 4, 3, target);
+			recording.append(CommandCell<int>::encode(n));
+
+			target->setMemory(n);
+		}
+
+		virtual void sumAndStore(StatusType* status, int n1, int n2)
+		{
+			CallRecording recording(log, 4, 4, target);
+			recording.append(CommandCell<int>::encode(n1));
+			recording.append(CommandCell<int>::encode(n2));
+
+			target->sumAndStore(status, n1, n2);
+		}
+
+	private:
+		ICalculator* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class ICalculator2RecordingProxy : public ICalculator2Impl<ICalculator2RecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		ICalculator2RecordingProxy(ICalculator2* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 0, 0, target);
+
+			target->dispose();
+		}
+
+		virtual int sum(StatusType* status, int n1, int n2) const
+		{
+			CallRecording recording(log, 4, 1, target);
+			recording.append(CommandCell<int>::encode(n1));
+			recording.append(CommandCell<int>::encode(n2));
+
+			int ret = target->sum(status, n1, n2);
+			return ret;
+		}
+
+		virtual int getMemory() const
+		{
+			CallRecording recording(log, 4, 2, target);
+
+			int ret = target->getMemory();
+			return ret;
+		}
+
+		virtual void setMemory(int n)
+		{
+			CallRecording recording(log, 4, 3, target);
+			recording.append(CommandCell<int>::encode(n));
+
+			target->setMemory(n);
+		}
+
+		virtual void sumAndStore(StatusType* status, int n1, int n2)
+		{
+			CallRecording recording(log, 4, 4, target);
+			recording.append(CommandCell<int>::encode(n1));
+			recording.append(CommandCell<int>::encode(n2));
+
+			target->sumAndStore(status, n1, n2);
+		}
+
+		virtual int multiply(StatusType* status, int n1, int n2) const
+		{
+			CallRecording recording(log, 5, 5, target);
+			recording.append(CommandCell<int>::encode(n1));
+			recording.append(CommandCell<int>::encode(n2));
+
+			int ret = target->multiply(status, n1, n2);
+			return ret;
+		}
+
+		virtual void copyMemory(const ICalculator* calculator)
+		{
+			CallRecording recording(log, 5, 6, target);
+			recording.appendObject(calculator);
+
+			target->copyMemory(calculator);
+		}
+
+		virtual void copyMemory2(const int* address)
+		{
+			// Arguments not recorded: the replay stops here.
+			CallRecording recording(log, 5, 7, target);
+
+			target->copyMemory2(address);
+		}
+
+		virtual void multiplyBatch(StatusType* status, const int* n1, const int* n2, int* results, unsigned count) const
+		{
+			// Arguments not recorded: the replay stops here.
+			CallRecording recording(log, 5, 8, target);
+
+			target->multiplyBatch(status, n1, n2, results, count);
+		}
+
+	private:
+		ICalculator2* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class ICounterRecordingProxy : public ICounterImpl<ICounterRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		ICounterRecordingProxy(ICounter* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 6, 0, target);
+
+			target->dispose();
+		}
+
+		virtual int increment()
+		{
+			CallRecording recording(log, 6, 1, target);
+
+			int ret = target->increment();
+			return ret;
+		}
+
+		virtual int getValue() const
+		{
+			CallRecording recording(log, 6, 2, target);
+
+			int ret = target->getValue();
+			return ret;
+		}
+
+		virtual void add(const ICounter* counter)
+		{
+			CallRecording recording(log, 6, 3, target);
+			recording.appendObject(counter);
+
+			target->add(counter);
+		}
+
+	private:
+		ICounter* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class IReferenceCountedRecordingProxy : public IReferenceCountedImpl<IReferenceCountedRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		IReferenceCountedRecordingProxy(IReferenceCounted* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void addRef()
+		{
+			CallRecording recording(log, 7, 0, target);
+
+			target->addRef();
+		}
+
+		virtual int release()
+		{
+			CallRecording recording(log, 7, 1, target);
+
+			int ret = target->release();
+			return ret;
+		}
+
+	private:
+		IReferenceCounted* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class IAccumulatorRecordingProxy : public IAccumulatorImpl<IAccumulatorRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		IAccumulatorRecordingProxy(IAccumulator* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void addRef()
+		{
+			CallRecording recording(log, 7, 0, target);
+
+			target->addRef();
+		}
+
+		virtual int release()
+		{
+			CallRecording recording(log, 7, 1, target);
+
+			int ret = target->release();
+			return ret;
+		}
+
+		virtual void add(int n)
+		{
+			CallRecording recording(log, 8, 2, target);
+			recording.append(CommandCell<int>::encode(n));
+
+			target->add(n);
+		}
+
+		virtual int getTotal() const
+		{
+			CallRecording recording(log, 8, 3, target);
+
+			int ret = target->getTotal();
+			return ret;
+		}
+
+	private:
+		IAccumulator* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class IQueryableRecordingProxy : public IQueryableImpl<IQueryableRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		IQueryableRecordingProxy(IQueryable* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 0, 0, target);
+
+			target->dispose();
+		}
+
+		virtual IQueryable* queryInterface(unsigned id)
+		{
+			CallRecording recording(log, 9, 1, target);
+			recording.append(CommandCell<unsigned>::encode(id));
+
+			IQueryable* ret = target->queryInterface(id);
+			recording.appendObject(ret);
+			return ret;
+		}
+
+	private:
+		IQueryable* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class IReaderRecordingProxy : public IReaderImpl<IReaderRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		IReaderRecordingProxy(IReader* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 0, 0, target);
+
+			target->dispose();
+		}
+
+		virtual IQueryable* queryInterface(unsigned id)
+		{
+			CallRecording recording(log, 9, 1, target);
+			recording.append(CommandCell<unsigned>::encode(id));
+
+			IQueryable* ret = target->queryInterface(id);
+			recording.appendObject(ret);
+			return ret;
+		}
+
+		virtual int read()
+		{
+			CallRecording recording(log, 10, 2, target);
+
+			int ret = target->read();
+			return ret;
+		}
+
+	private:
+		IReader* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class IWriterRecordingProxy : public IWriterImpl<IWriterRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		IWriterRecordingProxy(IWriter* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 0, 0, target);
+
+			target->dispose();
+		}
+
+		virtual IQueryable* queryInterface(unsigned id)
+		{
+			CallRecording recording(log, 9, 1, target);
+			recording.append(CommandCell<unsigned>::encode(id));
+
+			IQueryable* ret = target->queryInterface(id);
+			recording.appendObject(ret);
+			return ret;
+		}
+
+		virtual void write(int n)
+		{
+			CallRecording recording(log, 11, 2, target);
+			recording.append(CommandCell<int>::encode(n));
+
+			target->write(n);
+		}
+
+	private:
+		IWriter* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class IAsyncCalculatorRecordingProxy : public IAsyncCalculatorImpl<IAsyncCalculatorRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		IAsyncCalculatorRecordingProxy(IAsyncCalculator* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 0, 0, target);
+
+			target->dispose();
+		}
+
+		virtual int sum(StatusType* status, int n1, int n2) const
+		{
+			CallRecording recording(log, 12, 1, target);
+			recording.append(CommandCell<int>::encode(n1));
+			recording.append(CommandCell<int>::encode(n2));
+
+			int ret = target->sum(status, n1, n2);
+			return ret;
+		}
+
+		virtual void sumAsync(StatusType* status, int n1, int n2, IAsyncCalculatorSumCompletion* completion) const
+		{
+			CallRecording recording(log, 12, 2, target);
+			recording.append(CommandCell<int>::encode(n1));
+			recording.append(CommandCell<int>::encode(n2));
+			recording.appendObject(completion);
+
+			target->sumAsync(status, n1, n2, completion);
+		}
+
+	private:
+		IAsyncCalculator* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class IScannerRecordingProxy : public IScannerImpl<IScannerRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		IScannerRecordingProxy(IScanner* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 0, 0, target);
+
+			target->dispose();
+		}
+
+		virtual unsigned countChar(StrView text, unsigned char c) const
+		{
+			// Arguments not recorded: the replay stops here.
+			CallRecording recording(log, 13, 1, target);
+
+			unsigned ret = target->countChar(text, c);
+			return ret;
+		}
+
+		virtual StrView trim(StatusType* status, StrView text) const
+		{
+			// Arguments not recorded: the replay stops here.
+			CallRecording recording(log, 13, 2, target);
+
+			StrView ret = target->trim(status, text);
+			return ret;
+		}
+
+		virtual unsigned checksum(Bytes in) const
+		{
+			// Arguments not recorded: the replay stops here.
+			CallRecording recording(log, 13, 3, target);
+
+			unsigned ret = target->checksum(in);
+			return ret;
+		}
+
+	private:
+		IScanner* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class IGeometryRecordingProxy : public IGeometryImpl<IGeometryRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		IGeometryRecordingProxy(IGeometry* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 0, 0, target);
+
+			target->dispose();
+		}
+
+		virtual Rectangle move(Rectangle rectangle, Point offset) const
+		{
+			// Arguments not recorded: the replay stops here.
+			CallRecording recording(log, 14, 1, target);
+
+			Rectangle ret = target->move(rectangle, offset);
+			return ret;
+		}
+
+		virtual int area(const Rectangle* rectangle) const
+		{
+			// Arguments not recorded: the replay stops here.
+			CallRecording recording(log, 14, 2, target);
+
+			int ret = target->area(rectangle);
+			return ret;
+		}
+
+		virtual unsigned payload(Header header) const
+		{
+			// Arguments not recorded: the replay stops here.
+			CallRecording recording(log, 14, 3, target);
+
+			unsigned ret = target->payload(header);
+			return ret;
+		}
+
+	private:
+		IGeometry* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class ISeriesRecordingProxy : public ISeriesImpl<ISeriesRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		ISeriesRecordingProxy(ISeries* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 0, 0, target);
+
+			target->dispose();
+		}
+
+		virtual int total(const int* values, unsigned count) const
+		{
+			// Arguments not recorded: the replay stops here.
+			CallRecording recording(log, 15, 1, target);
+
+			int ret = target->total(values, count);
+			return ret;
+		}
+
+		virtual void scale(const int* in, int* out, unsigned count, int factor) const
+		{
+			// Arguments not recorded: the replay stops here.
+			CallRecording recording(log, 15, 2, target);
+
+			target->scale(in, out, count, factor);
+		}
+
+		virtual unsigned histogram(const unsigned char* data, unsigned* counts, unsigned size, unsigned buckets) const
+		{
+			// Arguments not recorded: the replay stops here.
+			CallRecording recording(log, 15, 3, target);
+
+			unsigned ret = target->histogram(data, counts, size, buckets);
+			return ret;
+		}
+
+		virtual int clamp(int value, int limit) const
+		{
+			CallRecording recording(log, 15, 4, target);
+			recording.append(CommandCell<int>::encode(value));
+			recording.append(CommandCell<int>::encode(limit));
+
+			int ret = target->clamp(value, limit);
+			return ret;
+		}
+
+		virtual void clampBatch(const int* value, const int* limit, int* results, unsigned count) const
+		{
+			// Arguments not recorded: the replay stops here.
+			CallRecording recording(log, 15, 5, target);
+
+			target->clampBatch(value, limit, results, count);
+		}
+
+	private:
+		ISeries* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class IPoolRecordingProxy : public IPoolImpl<IPoolRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		IPoolRecordingProxy(IPool* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void dispose()
+		{
+			CallRecording recording(log, 0, 0, target);
+
+			target->dispose();
+		}
+
+		virtual void keep(IAccumulator* accumulator)
+		{
+			CallRecording recording(log, 16, 1, target);
+			recording.appendObject(accumulator);
+
+			target->keep(accumulator);
+		}
+
+		virtual void setName(const char* name)
+		{
+			CallRecording recording(log, 16, 2, target);
+			recording.appendString(name);
+
+			target->setName(name);
+		}
+
+		virtual int total() const
+		{
+			CallRecording recording(log, 16, 3, target);
+
+			int ret = target->total();
+			return ret;
+		}
+
+	private:
+		IPool* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	class IAsyncCalculatorSumCompletionRecordingProxy : public IAsyncCalculatorSumCompletionImpl<IAsyncCalculatorSumCompletionRecordingProxy<StatusType>, StatusType>
+	{
+	public:
+		IAsyncCalculatorSumCompletionRecordingProxy(IAsyncCalculatorSumCompletion* target, CallLog* log)
+			: target(target),
+			  log(log)
+		{
+		}
+
+		virtual void complete(StatusType* status, int result)
+		{
+			CallRecording recording(log, 17, 0, target);
+			recording.append(CommandCell<int>::encode(result));
+
+			target->complete(status, result);
+		}
+
+	private:
+		IAsyncCalculatorSumCompletion* target;
+		CallLog* log;
+	};
+
+	template <typename StatusType>
+	unsigned replayCalls(StatusType* status, const CommandBuffer& commands, std::vector<void*>& objects)
+	{
+		unsigned replayed = 0;
+
+		for (unsigned position = 0; position < commands.size(); ++replayed)
+		{
+			const uint64_t* command = commands.data() + position;
+			unsigned size = (unsigned) (command[0] >> 32);
+			unsigned cell = 1;
+
+			auto nextObject = [&]() -> void* {
+				uint64_t identity = command[cell++];
+				return identity < objects.size() ? objects[identity] : nullptr;
+			};
+
+			auto bind = [&](void* returned) {
+				uint64_t identity = cell < size ? command[cell] : 0;
+
+				if (identity >= objects.size())
+					objects.resize(identity + 1);
+
+				if (identity)
+					objects[identity] = returned;
+			};
+
+			void* self = nextObject();
+
+			if (!self)
+				return replayed;
+
+			// Not used when no method returns objects.
+			(void) bind;
+
+			switch ((unsigned) (command[0] & 0xFFFFFFFF))
+			{
+				case (0u << 16) | 0u:	// IDisposable::dispose
+				{
+					static_cast<IDisposable*>(self)->dispose();
+					break;
+				}
+
+				case (1u << 16) | 1u:	// IStatus::getCode
+				{
+					static_cast<const IStatus*>(self)->getCode();
+					break;
+				}
+
+				case (1u << 16) | 2u:	// IStatus::setCode
+				{
+					int code = CommandCell<int>::decode(command[cell++]);
+					static_cast<IStatus*>(self)->setCode(code);
+					break;
+				}
+
+				case (2u << 16) | 1u:	// IStatusFactory::createStatus
+				{
+					bind(static_cast<IStatusFactory*>(self)->createStatus());
+					break;
+				}
+
+				case (3u << 16) | 1u:	// IFactory::createStatus
+				{
+					bind(static_cast<IFactory*>(self)->createStatus());
+					break;
+				}
+
+				case (3u << 16) | 2u:	// IFactory::createCalculator
+				{
+					bind(static_cast<IFactory*>(self)->createCalculator(status));
+					break;
+				}
+
+				case (3u << 16) | 3u:	// IFactory::createCalculator2
+				{
+					bind(static_cast<IFactory*>(self)->createCalculator2(status));
+					break;
+				}
+
+				case (3u << 16) | 4u:	// IFactory::createBrokenCalculator
+				{
+					bind(static_cast<IFactory*>(self)->createBrokenCalculator(status));
+					break;
+				}
+
+				case (3u << 16) | 5u:	// IFactory::setStatusFactory
+				{
+					IStatusFactory* statusFactory = static_cast<IStatusFactory*>(nextObject());
+					static_cast<IFactory*>(self)->setStatusFactory(statusFactory);
+					break;
+				}
+
+				case (4u << 16) | 1u:	// ICalculator::sum
+				{
+					int n1 = CommandCell<int>::decode(command[cell++]);
+					int n2 = CommandCell<int>::decode(command[cell++]);
+					static_cast<const ICalculator*>(self)->sum(status, n1, n2);
+					break;
+				}
+
+				case (4u << 16) | 2u:	// ICalculator::getMemory
+				{
+					static_cast<const ICalculator*>(self)->getMemory();
+					break;
+				}
+
+				case (4u << 16) | 3u:	// ICalculator::setMemory
+				{
+					int n = CommandCell<int>::decode(command[cell++]);
+					static_cast<ICalculator*>(self)->setMemory(n);
+					break;
+				}
+
+				case (4u << 16) | 4u:	// ICalculator::sumAndStore
+				{
+					int n1 = CommandCell<int>::decode(command[cell++]);
+					int n2 = CommandCell<int>::decode(command[cell++]);
+					static_cast<ICalculator*>(self)->sumAndStore(status, n1, n2);
+					break;
+				}
+
+				case (5u << 16) | 5u:	// ICalculator2::multiply
+				{
+					int n1 = CommandCell<int>::decode(command[cell++]);
+					int n2 = CommandCell<int>::decode(command[cell++]);
+					static_cast<const ICalculator2*>(self)->multiply(status, n1, n2);
+					break;
+				}
+
+				case (5u << 16) | 6u:	// ICalculator2::copyMemory
+				{
+					const ICalculator* calculator = static_cast<const ICalculator*>(nextObject());
+					static_cast<ICalculator2*>(self)->copyMemory(calculator);
+					break;
+				}
+
+				case (6u << 16) | 0u:	// ICounter::dispose
+				{
+					static_cast<ICounter*>(self)->dispose();
+					break;
+				}
+
+				case (6u << 16) | 1u:	// ICounter::increment
+				{
+					static_cast<ICounter*>(self)->increment();
+					break;
+				}
+
+				case (6u << 16) | 2u:	// ICounter::getValue
+				{
+					static_cast<const ICounter*>(self)->getValue();
+					break;
+				}
+
+				case (6u << 16) | 3u:	// ICounter::add
+				{
+					const ICounter* counter = static_cast<const ICounter*>(nextObject());
+					static_cast<ICounter*>(self)->add(counter);
+					break;
+				}
+
+				case (7u << 16) | 0u:	// IReferenceCounted::addRef
+				{
+					static_cast<IReferenceCounted*>(self)->addRef();
+					break;
+				}
+
+				case (7u << 16) | 1u:	// IReferenceCounted::release
+				{
+					static_cast<IReferenceCounted*>(self)->release();
+					break;
+				}
+
+				case (8u << 16) | 2u:	// IAccumulator::add
+				{
+					int n = CommandCell<int>::decode(command[cell++]);
+					static_cast<IAccumulator*>(self)->add(n);
+					break;
+				}
+
+				case (8u << 16) | 3u:	// IAccumulator::getTotal
+				{
+					static_cast<const IAccumulator*>(self)->getTotal();
+					break;
+				}
+
+				case (9u << 16) | 1u:	// IQueryable::queryInterface
+				{
+					unsigned id = CommandCell<unsigned>::decode(command[cell++]);
+					bind(static_cast<IQueryable*>(self)->queryInterface(id));
+					break;
+				}
+
+				case (10u << 16) | 2u:	// IReader::read
+				{
+					static_cast<IReader*>(self)->read();
+					break;
+				}
+
+				case (11u << 16) | 2u:	// IWriter::write
+				{
+					int n = CommandCell<int>::decode(command[cell++]);
+					static_cast<IWriter*>(self)->write(n);
+					break;
+				}
+
+				case (12u << 16) | 1u:	// IAsyncCalculator::sum
+				{
+					int n1 = CommandCell<int>::decode(command[cell++]);
+					int n2 = CommandCell<int>::decode(command[cell++]);
+					static_cast<const IAsyncCalculator*>(self)->sum(status, n1, n2);
+					break;
+				}
+
+				case (12u << 16) | 2u:	// IAsyncCalculator::sumAsync
+				{
+					int n1 = CommandCell<int>::decode(command[cell++]);
+					int n2 = CommandCell<int>::decode(command[cell++]);
+					IAsyncCalculatorSumCompletion* completion = static_cast<IAsyncCalculatorSumCompletion*>(nextObject());
+					static_cast<const IAsyncCalculator*>(self)->sumAsync(status, n1, n2, completion);
+					break;
+				}
+
+				case (15u << 16) | 4u:	// ISeries::clamp
+				{
+					int value = CommandCell<int>::decode(command[cell++]);
+					int limit = CommandCell<int>::decode(command[cell++]);
+					static_cast<const ISeries*>(self)->clamp(value, limit);
+					break;
+				}
+
+				case (16u << 16) | 1u:	// IPool::keep
+				{
+					IAccumulator* accumulator = static_cast<IAccumulator*>(nextObject());
+					static_cast<IPool*>(self)->keep(accumulator);
+					break;
+				}
+
+				case (16u << 16) | 2u:	// IPool::setName
+				{
+					const char* name = readCommandString(command, cell);
+					static_cast<IPool*>(self)->setName(name);
+					break;
+				}
+
+				case (16u << 16) | 3u:	// IPool::total
+				{
+					static_cast<const IPool*>(self)->total();
+					break;
+				}
+
+				case (17u << 16) | 0u:	// IAsyncCalculatorSumCompletion::complete
+				{
+					int result = CommandCell<int>::decode(command[cell++]);
+					static_cast<IAsyncCalculatorSumCompletion*>(self)->complete(status, result);
+					break;
+				}
+
+				default:
+					return replayed;
+			}
+
+			position += size;
+		}
+
+		return replayed;
+	}
+#endif
+
+	// Shared-memory RPC (C++11, Linux)
+
+#if __cplusplus >= 201103L && defined(__linux__)
+	// Single-producer single-consumer ring of commands. Commands larger than the ring are passed
+	// in pieces as the reader consumes them. Readers and writers spin briefly and then sleep on a
+	// futex of the position they wait for, waking up every WAIT_NS to check that the process at
+	// the other side is alive. They return false once it has exited.
+	class SharedRing
+	{
+	public:
+		static const uint32_t CAPACITY = 16384;
+		static const long WAIT_NS = 100000000;
+
+		bool write(const uint64_t* command, uint32_t size, const std::atomic<int32_t>& peer)
+		{
+			uint32_t position = tail.load(std::memory_order_relaxed);
+
+			for (uint32_t written = 0; written < size;)
+			{
+				uint32_t consumed;
+
+				while (position - (consumed = head.load()) == CAPACITY)
+				{
+					if (!wait(head, consumed, peer))
+						return false;
+				}
+
+				uint32_t count = CAPACITY - (position - consumed);
+
+				if (count > size - written)
+					count = size - written;
+
+				for (uint32_t i = 0; i < count; ++i)
+					cells[(position + i) & (CAPACITY - 1)] = command[written + i];
+
+				position += count;
+				written += count;
+
+				tail.store(position);
+				wake(tail);
+			}
+
+			return true;
+		}
+
+		bool read(std::vector<uint64_t>& command, const std::atomic<int32_t>& peer)
+		{
+			uint32_t position = head.load(std::memory_order_relaxed);
+			uint32_t produced;
+
+			while ((produced = tail.load()) == position)
+			{
+				if (!wait(tail, produced, peer))
+					return false;
+			}
+
+			uint32_t size = (uint32_t) (cells[position & (CAPACITY - 1)] >> 32);
+			command.resize(size);
+
+			for (uint32_t read = 0; read < size;)
+			{
+				while ((produced = tail.load()) == position)
+				{
+					if (!wait(tail, produced, peer))
+						return false;
+				}
+
+				uint32_t count = produced - position;
+
+				if (count > size - read)
+					count = size - read;
+
+				for (uint32_t i = 0; i < count; ++i)
+					command[read + i] = cells[(position + i) & (CAPACITY - 1)];
+
+				position += count;
+				read += count;
+
+				head.store(position);
+				wake(head);
+			}
+
+			return true;
+		}
+
+	private:
+		bool wait(std::atomic<uint32_t>& word, uint32_t value, const std::atomic<int32_t>& peer)
+		{
+			for (unsigned spin = 0; spin < 1000; ++spin)
+			{
+				if (word.load() != value)
+					return true;
+			}
+
+			waiters.fetch_add(1);
+
+			if (word.load() == value)
+			{
+				struct timespec timeout = {0, WAIT_NS};
+				syscall(SYS_futex, &word, FUTEX_WAIT, value, &timeout, nullptr, 0);
+			}
+
+			waiters.fetch_sub(1);
+
+			return word.load() != value || isAlive(peer.load());
+		}
+
+		// Processes that haven't opened the channel yet count as alive. Children are checked
+		// without reaping them, as they stay zombies until then.
+		static bool isAlive(int32_t pid)
+		{
+			if (pid == 0)
+				return true;
+
+			siginfo_t info;
+			info.si_pid = 0;
+
+			if (waitid(P_PID, (id_t) pid, &info, WEXITED | WNOHANG | WNOWAIT) == 0)
+				return info.si_pid == 0;
+
+			return kill(pid, 0) == 0 || errno != ESRCH;
+		}
+
+		void wake(std::atomic<uint32_t>& word)
+		{
+			if (waiters.load() != 0)
+				syscall(SYS_futex, &word, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+		}
+
+	private:
+		std::atomic<uint32_t> head;
+		std::atomic<uint32_t> tail;
+		std::atomic<uint32_t> waiters;
+		uint64_t cells[CAPACITY];
+	};
+
+	// Pair of rings in a POSIX shared memory object, created by one process and opened by the other.
+	struct SharedChannel
+	{
+		SharedRing rings[2];
+		std::atomic<int32_t> pids[2];	// of the server and the client, 0 until they open it
+
+		static SharedChannel* map(const char* name, bool create)
+		{
+			int fd = shm_open(name, O_RDWR | (create ? O_CREAT | O_TRUNC : 0), 0600);
+
+			if (fd < 0)
+				return nullptr;
+
+			void* memory = MAP_FAILED;
+
+			if (!create || ftruncate(fd, sizeof(SharedChannel)) == 0)
+				memory = mmap(nullptr, sizeof(SharedChannel), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+			::close(fd);
+
+			return memory == MAP_FAILED ? nullptr : static_cast<SharedChannel*>(memory);
+		}
+
+		static void unmap(SharedChannel* channel)
+		{
+			munmap(channel, sizeof(SharedChannel));
+		}
+
+		static void remove(const char* name)
+		{
+			shm_unlink(name);
+		}
+	};
+
+	// Data of a known length, written as its length (~0 for null) followed by its bytes.
+	inline void appendCommandData(std::vector<uint64_t>& command, const void* data, uint64_t length)
+	{
+		if (!data)
+		{
+			command.push_back(~(uint64_t) 0);
+			return;
+		}
+
+		size_t position = command.size() + 1;
+
+		command.push_back(length);
+		command.resize(position + (size_t) ((length + sizeof(uint64_t) - 1) / sizeof(uint64_t)));
+		memcpy(command.data() + position, data, (size_t) length);
+	}
+
+	// Returns the data at cell, left in the command, or null.
+	inline const void* readCommandData(const uint64_t* command, unsigned& cell, uint64_t& length)
+	{
+		length = command[cell++];
+
+		if (length == ~(uint64_t) 0)
+		{
+			length = 0;
+			return nullptr;
+		}
+
+		const void* data = command + cell;
+		cell += (unsigned) ((length + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+		return data;
+	}
+
+	template <typename View>
+	inline View readCommandView(const uint64_t* command, unsigned& cell)
+	{
+		uint64_t length;
+		const void* data = readCommandData(command, cell, length);
+
+		return View(static_cast<const char*>(data), (size_t) length);
+	}
+
+	// Structs are written as their bytes.
+	template <typename T>
+	inline void appendCommandValue(std::vector<uint64_t>& command, const T& value)
+	{
+		size_t position = command.size();
+
+		command.resize(position + (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+		memcpy(command.data() + position, &value, sizeof(T));
+	}
+
+	template <typename T>
+	inline T readCommandValue(const uint64_t* command, unsigned& cell)
+	{
+		T value;
+
+		memcpy(&value, command + cell, sizeof(T));
+		cell += (unsigned) ((sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+		return value;
+	}
+
+	// Copies the elements of an array received into a buffer the callee may write. Arrays the
+	// callee only writes are received as their length, without data.
+	template <typename T>
+	inline T* readCommandBuffer(const uint64_t* command, unsigned& cell, bool sent, std::vector<T>& buffer)
+	{
+		uint64_t length = command[cell++];
+
+		if (length == ~(uint64_t) 0)
+			return nullptr;
+
+		// An element more, so that empty arrays aren't null.
+		buffer.resize((size_t) (length / sizeof(T)) + 1);
+
+		if (sent)
+		{
+			memcpy(buffer.data(), command + cell, (size_t) length);
+			cell += (unsigned) ((length + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+		}
+
+		return buffer.data();
+	}
+
+	template <typename T>
+	inline void appendCommandBuffer(std::vector<uint64_t>& command, const T* data, const std::vector<T>& buffer)
+	{
+		appendCommandData(command, data, data ? (buffer.size() - 1) * sizeof(T) : 0);
+	}
+
+	class RpcEndpoint;
+
+	inline void* rpcCreateStub(RpcEndpoint* endpoint, unsigned interfaceIndex);
+	inline void rpcDestroyStub(void* stub, unsigned interfaceIndex);
+	inline void rpcDispatch(RpcEndpoint* endpoint, const uint64_t* request, std::vector<uint64_t>& response);
+
+	// One side of a channel, used by a single thread. Objects passed to the other side are
+	// exported with even handles, and handles received are imported as RPC stubs, which have the
+	// vtable layout of the interface and send the calls back with odd handles. While waiting for
+	// a response, the endpoint serves the calls made to its own objects, as to a status.
+	// Disposing a stub disposes the remote object, and frees the stubs of the object on one side
+	// and forgets its export on the other. Once the other process exits, calls return with empty
+	// responses, as after it closes the channel.
+	class RpcEndpoint
+	{
+	public:
+		// Handle of the first object exported by the other side. The next ones follow two apart.
+		static const uint64_t ROOT = 2;
+
+		RpcEndpoint(SharedChannel* channel, bool server)
+			: incoming(&channel->rings[server ? 0 : 1]),
+			  outgoing(&channel->rings[server ? 1 : 0]),
+			  peer(&channel->pids[server ? 1 : 0]),
+			  exports(1),
+			  closed(false)
+		{
+			channel->pids[server ? 0 : 1].store((int32_t) getpid());
+		}
+
+		~RpcEndpoint()
+		{
+			for (auto& i : imports)
+				rpcDestroyStub(i.second, (unsigned) (i.first & 0xFFFF));
+		}
+
+	private:
+		RpcEndpoint(const RpcEndpoint&);
+		RpcEndpoint& operator =(const RpcEndpoint&);
+
+	public:
+		uint64_t exportObject(const void* object)
+		{
+			if (!object)
+				return 0;
+
+			auto imported = importHandles.find(object);
+
+			if (imported != importHandles.end())
+				return (imported->second << 1) | 1;
+
+			uint64_t& handle = exportHandles[object];
+
+			if (!handle)
+			{
+				handle = exports.size();
+				exports.push_back(const_cast<void*>(object));
+			}
+
+			return handle << 1;
+		}
+
+		void* importObject(uint64_t handle, unsigned interfaceIndex)
+		{
+			if (handle & 1)
+				return (handle >> 1) < exports.size() ? exports[handle >> 1] : nullptr;
+
+			if (!handle)
+				return nullptr;
+
+			void*& stub = imports[((handle >> 1) << 16) | interfaceIndex];
+
+			if (!stub)
+			{
+				stub = rpcCreateStub(this, interfaceIndex);
+				importHandles[stub] = handle >> 1;
+			}
+
+			return stub;
+		}
+
+		// Forgets an object disposed by a call of the other side. Its handle isn't reused.
+		void dropExport(const void* object)
+		{
+			auto exported = exportHandles.find(object);
+
+			if (exported != exportHandles.end())
+			{
+				exports[exported->second] = nullptr;
+				exportHandles.erase(exported);
+			}
+		}
+
+		// Frees the stubs of a remote object disposed through one of them.
+		void dropImport(const void* stub)
+		{
+			auto imported = importHandles.find(stub);
+
+			if (imported == importHandles.end())
+				return;
+
+			uint64_t handle = imported->second;
+
+			for (auto i = imports.begin(); i != imports.end();)
+			{
+				if ((i->first >> 16) != handle)
+				{
+					++i;
+					continue;
+				}
+
+				importHandles.erase(i->second);
+				rpcDestroyStub(i->second, (unsigned) (i->first & 0xFFFF));
+				i = imports.erase(i);
+			}
+		}
+
+		template <typename Interface>
+		Interface* import(uint64_t handle)
+		{
+			return static_cast<Interface*>(importObject(handle, Reflection<Interface>::INDEX));
+		}
+
+		// Sends a call and waits for its response, serving the calls received meanwhile.
+		void call(std::vector<uint64_t>& request, std::vector<uint64_t>& response);
+
+		// Serves calls until the other side closes the channel or exits.
+		void serve();
+
+		void close()
+		{
+			uint64_t command = CommandBuffer::header(1, CONTROL, CLOSE);
+			outgoing->write(&command, 1, *peer);
+		}
+
+		// Strings and views returned by calls are kept until the next one, writable for the
+		// methods returning non-const strings.
+		char* keep(const void* data, uint64_t length)
+		{
+			if (!data)
+				return nullptr;
+
+			returned.assign(static_cast<const char*>(data), (size_t) length);
+			return &returned[0];
+		}
+
+	private:
+		static const unsigned CONTROL = 0xFFFF;
+		static const unsigned RESPONSE = 0;
+		static const unsigned CLOSE = 1;
+
+		void dispatch(const std::vector<uint64_t>& request);
+
+	private:
+		SharedRing* incoming;
+		SharedRing* outgoing;
+		const std::atomic<int32_t>* peer;
+		std::vector<void*> exports;
+		std::unordered_map<const void*, uint64_t> exportHandles;
+		std::unordered_map<uint64_t, void*> imports;
+		std::unordered_map<const void*, uint64_t> importHandles;
+		std::string returned;
+		bool closed;
+	};
+
+	// Request of a stub, and then its response, read in the order the dispatcher wrote it.
+	class RpcCall
+	{
+	public:
+		RpcCall(RpcEndpoint* endpoint, unsigned interfaceIndex, unsigned slot, const void* self)
+			: endpoint(endpoint),
+			  cell(1)
+		{
+			request.push_back(CommandBuffer::header(0, interfaceIndex, slot));
+			request.push_back(endpoint->exportObject(self));
+		}
+
+	private:
+		RpcCall(const RpcCall&);
+		RpcCall& operator =(const RpcCall&);
+
+	public:
+		void append(uint64_t cell)
+		{
+			request.push_back(cell);
+		}
+
+		void appendObject(const void* object)
+		{
+			request.push_back(endpoint->exportObject(object));
+		}
+
+		void appendString(const char* str)
+		{
+			appendCommandString(request, str);
+		}
+
+		void appendData(const void* data, uint64_t length)
+		{
+			appendCommandData(request, data, length);
+		}
+
+		// Array only written by the callee.
+		void appendLength(const void* data, uint64_t length)
+		{
+			request.push_back(data ? length : ~(uint64_t) 0);
+		}
+
+		template <typename T>
+		void appendValue(const T& value)
+		{
+			appendCommandValue(request, value);
+		}
+
+		void invoke()
+		{
+			endpoint->call(request, response);
+		}
+
+		uint64_t result()
+		{
+			return cell < response.size() ? response[cell++] : 0;
+		}
+
+		char* resultString()
+		{
+			if (cell >= response.size())
+				return nullptr;
+
+			const char* str = readCommandString(response.data(), cell);
+			return endpoint->keep(str, str ? strlen(str) : 0);
+		}
+
+		template <typename View>
+		View resultView()
+		{
+			uint64_t length = 0;
+			const void* data = cell < response.size() ? readCommandData(response.data(), cell, length) : nullptr;
+
+			return View(endpoint->keep(data, length), (size_t) length);
+		}
+
+		template <typename T>
+		T resultValue()
+		{
+			return cell < response.size() ? readCommandValue<T>(response.data(), cell) : T();
+		}
+
+		void* resultObject(unsigned interfaceIndex)
+		{
+			return endpoint->importObject(result(), interfaceIndex);
+		}
+
+		// Copies the elements written by the callee to the array of the caller.
+		void resultData(void* data)
+		{
+			uint64_t length = 0;
+			const void* returned = cell < response.size() ? readCommandData(response.data(), cell, length) : nullptr;
+
+			if (data && returned)
+				memcpy(data, returned, (size_t) length);
+		}
+
+	private:
+		RpcEndpoint* endpoint;
+		std::vector<uint64_t> request;
+		std::vector<uint64_t> response;
+		unsigned cell;
+	};
+
+	class IDisposableRpcStub : public IDisposable
+	{
+	public:
+		IDisposableRpcStub(RpcEndpoint* endpoint)
+			: IDisposable(DoNotInherit()),
+			  endpoint(endpoint)
+		{
+			static struct VTableImpl : VTable
+			{
 				VTableImpl()
 				{
-					this->version = Base::VERSION;
-					this->dispose = &Name::cloopdisposeDispatcher;
+					this->version = IDisposable::VERSION;
+					this->dispose = &IDisposableRpcStub::cloopdisposeStub;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static void CLOOP_CARG cloopdisposeStub(IDisposable* self) throw()
+		{
+			RpcCall call(static_cast<IDisposableRpcStub*>(self)->endpoint, 0, 0, self);
+
+			call.invoke();
+			static_cast<IDisposableRpcStub*>(self)->endpoint->dropImport(self);
+		}
+
+	private:
+		RpcEndpoint* endpoint;
+	};
+
+	class IStatusRpcStub : public IStatus
+	{
+	public:
+		IStatusRpcStub(RpcEndpoint* endpoint)
+			: IStatus(DoNotInherit()),
+			  endpoint(endpoint)
+		{
+			static struct VTableImpl : VTable
+			{
+				VTableImpl()
+				{
+					this->version = IStatus::VERSION;
+					this->dispose = &IStatusRpcStub::cloopdisposeStub;
+					this->getCode = &IStatusRpcStub::cloopgetCodeStub;
+					this->setCode = &IStatusRpcStub::cloopsetCodeStub;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static void CLOOP_CARG cloopdisposeStub(IDisposable* self) throw()
+		{
+			RpcCall call(static_cast<IStatusRpcStub*>(self)->endpoint, 0, 0, self);
+
+			call.invoke();
+			static_cast<IStatusRpcStub*>(self)->endpoint->dropImport(self);
+		}
+
+		static int CLOOP_CARG cloopgetCodeStub(const IStatus* self) throw()
+		{
+			RpcCall call(static_cast<const IStatusRpcStub*>(self)->endpoint, 1, 1, self);
+
+			call.invoke();
+			int ret = CommandCell<int>::decode(call.result());
+			const_cast<IStatus*>(self)->cloopErrorFlag = CommandCell<int>::decode(call.result());
+			return ret;
+		}
+
+		static void CLOOP_CARG cloopsetCodeStub(IStatus* self, int code) throw()
+		{
+			RpcCall call(static_cast<IStatusRpcStub*>(self)->endpoint, 1, 2, self);
+			call.append(CommandCell<int>::encode(code));
+
+			call.invoke();
+			const_cast<IStatus*>(self)->cloopErrorFlag = CommandCell<int>::decode(call.result());
+		}
+
+	private:
+		RpcEndpoint* endpoint;
+	};
+
+	class ICalculatorRpcStub : public ICalculator
+	{
+	public:
+		ICalculatorRpcStub(RpcEndpoint* endpoint)
+			: ICalculator(DoNotInherit()),
+			  endpoint(endpoint)
+		{
+			static struct VTableImpl : VTable
+			{
+				VTableImpl()
+				{
+					this->version = ICalculator::VERSION;
+					this->dispose = &ICalculatorRpcStub::cloopdisposeStub;
+					this->sum = &ICalculatorRpcStub::cloopsumStub;
+					this->getMemory = &ICalculatorRpcStub::cloopgetMemoryStub;
+					this->setMemory = &ICalculatorRpcStub::cloopsetMemoryStub;
+					this->sumAndStore = &ICalculatorRpcStub::cloopsumAndStoreStub;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static void CLOOP_CARG cloopdisposeStub(IDisposable* self) throw()
+		{
+			RpcCall call(static_cast<ICalculatorRpcStub*>(self)->endpoint, 0, 0, self);
+
+			call.invoke();
+			static_cast<ICalculatorRpcStub*>(self)->endpoint->dropImport(self);
+		}
+
+		static int CLOOP_CARG cloopsumStub(const ICalculator* self, IStatus* status, int n1, int n2) throw()
+		{
+			RpcCall call(static_cast<const ICalculatorRpcStub*>(self)->endpoint, 4, 1, self);
+			call.appendObject(status);
+			call.append(CommandCell<int>::encode(status ? status->cloopErrorFlag : 0));
+			call.append(CommandCell<int>::encode(n1));
+			call.append(CommandCell<int>::encode(n2));
+
+			call.invoke();
+			return CommandCell<int>::decode(call.result());
+		}
+
+		static int CLOOP_CARG cloopgetMemoryStub(const ICalculator* self) throw()
+		{
+			RpcCall call(static_cast<const ICalculatorRpcStub*>(self)->endpoint, 4, 2, self);
+
+			call.invoke();
+			return CommandCell<int>::decode(call.result());
+		}
+
+		static void CLOOP_CARG cloopsetMemoryStub(ICalculator* self, int n) throw()
+		{
+			RpcCall call(static_cast<ICalculatorRpcStub*>(self)->endpoint, 4, 3, self);
+			call.append(CommandCell<int>::encode(n));
+
+			call.invoke();
+		}
+
+		static void CLOOP_CARG cloopsumAndStoreStub(ICalculator* self, IStatus* status, int n1, int n2) throw()
+		{
+			RpcCall call(static_cast<ICalculatorRpcStub*>(self)->endpoint, 4, 4, self);
+			call.appendObject(status);
+			call.append(CommandCell<int>::encode(status ? status->cloopErrorFlag : 0));
+			call.append(CommandCell<int>::encode(n1));
+			call.append(CommandCell<int>::encode(n2));
+
+			call.invoke();
+		}
+
+	private:
+		RpcEndpoint* endpoint;
+	};
+
+	class IScannerRpcStub : public IScanner
+	{
+	public:
+		IScannerRpcStub(RpcEndpoint* endpoint)
+			: IScanner(DoNotInherit()),
+			  endpoint(endpoint)
+		{
+			static struct VTableImpl : VTable
+			{
+				VTableImpl()
+				{
+					this->version = IScanner::VERSION;
+					this->dispose = &IScannerRpcStub::cloopdisposeStub;
+					this->countChar = &IScannerRpcStub::cloopcountCharStub;
+					this->trim = &IScannerRpcStub::clooptrimStub;
+					this->checksum = &IScannerRpcStub::cloopchecksumStub;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static void CLOOP_CARG cloopdisposeStub(IDisposable* self) throw()
+		{
+			RpcCall call(static_cast<IScannerRpcStub*>(self)->endpoint, 0, 0, self);
+
+			call.invoke();
+			static_cast<IScannerRpcStub*>(self)->endpoint->dropImport(self);
+		}
+
+		static unsigned CLOOP_CARG cloopcountCharStub(const IScanner* self, StrView text, unsigned char c) throw()
+		{
+			RpcCall call(static_cast<const IScannerRpcStub*>(self)->endpoint, 13, 1, self);
+			call.appendData(text.data, text.length);
+			call.append(CommandCell<unsigned char>::encode(c));
+
+			call.invoke();
+			return CommandCell<unsigned>::decode(call.result());
+		}
+
+		static StrView CLOOP_CARG clooptrimStub(const IScanner* self, IStatus* status, StrView text) throw()
+		{
+			RpcCall call(static_cast<const IScannerRpcStub*>(self)->endpoint, 13, 2, self);
+			call.appendObject(status);
+			call.append(CommandCell<int>::encode(status ? status->cloopErrorFlag : 0));
+			call.appendData(text.data, text.length);
+
+			call.invoke();
+			return call.resultView<StrView>();
+		}
+
+		static unsigned CLOOP_CARG cloopchecksumStub(const IScanner* self, Bytes in) throw()
+		{
+			RpcCall call(static_cast<const IScannerRpcStub*>(self)->endpoint, 13, 3, self);
+			call.appendData(in.data, in.length);
+
+			call.invoke();
+			return CommandCell<unsigned>::decode(call.result());
+		}
+
+	private:
+		RpcEndpoint* endpoint;
+	};
+
+	class IGeometryRpcStub : public IGeometry
+	{
+	public:
+		IGeometryRpcStub(RpcEndpoint* endpoint)
+			: IGeometry(DoNotInherit()),
+			  endpoint(endpoint)
+		{
+			static struct VTableImpl : VTable
+			{
+				VTableImpl()
+				{
+					this->version = IGeometry::VERSION;
+					this->dispose = &IGeometryRpcStub::cloopdisposeStub;
+					this->move = &IGeometryRpcStub::cloopmoveStub;
+					this->area = &IGeometryRpcStub::cloopareaStub;
+					this->payload = &IGeometryRpcStub::clooppayloadStub;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+		}
+
+		static void CLOOP_CARG cloopdisposeStub(IDisposable* self) throw()
+		{
+			RpcCall call(static_cast<IGeometryRpcStub*>(self)->endpoint, 0, 0, self);
+
+			call.invoke();
+			static_cast<IGeometryRpcStub*>(self)->endpoint->dropImport(self);
+		}
+
+		static Rectangle CLOOP_CARG cloopmoveStub(const IGeometry* self, Rectangle rectangle, Point offset) throw()
+		{
+			RpcCall call(static_cast<const IGeometryRpcStub*>(self)->endpoint, 14, 1, self);
+			call.appendValue(rectangle);
+			call.appendValue(offset);
+
+			call.invoke();
+			return call.resultValue<Rectangle>();
+		}
+
+		static int CLOOP_CARG cloopareaStub(const IGeometry* self, const Rectangle* rectangle) throw()
+		{
+			RpcCall call(static_cast<const IGeometryRpcStub*>(self)->endpoint, 14, 2, self);
+			call.appendData(rectangle, 1 * sizeof(Rectangle));
+
+			call.invoke();
+			return CommandCell<int>::decode(call.result());
+		}
+
+		static unsigned CLOOP_CARG clooppayloadStub(const IGeometry* self, Header header) throw()
+		{
+			RpcCall call(static_cast<const IGeometryRpcStub*>(self)->endpoint, 14, 3, self);
+			call.appendValue(header);
+
+			call.invoke();
+			return CommandCell<unsigned>::decode(call.result());
+		}
+
+	private:
+		RpcEndpoint* endpoint;
+	};
+
+	class ISeriesRpcStub : public ISeries
+	{
+	public:
+		ISeriesRpcStub(RpcEndpoint* endpoint)
+			: ISeries(DoNotInherit()),
+			  endpoint(endpoint)
+		{
+			static struct VTableImpl : VTable
+			{
+				VTableImpl()
+				{
+					this->version = ISeries::VERSION;
+					this->dispose = &ISeriesRpcStub::cloopdisposeStub;
+					this->total = &ISeriesRpcStub::clooptotalStub;
+					this->scale = &ISeriesRpcStub::cloopscaleStub;
+					this->histogram = &ISeriesRpcStub::cloophistogramStub;
+					this->clamp = &ISeriesRpcStub::cloopclampStub;
+					this->clampBatch = &ISeriesRpcStub::cloopclampBatchStub;
 				}
 			} vTable;
 
-			this->cloopVTable = &vTable;
+			this->cloopVTable = &vTable;
+		}
+
+		static void CLOOP_CARG cloopdisposeStub(IDisposable* self) throw()
+		{
+			RpcCall call(static_cast<ISeriesRpcStub*>(self)->endpoint, 0, 0, self);
+
+			call.invoke();
+			static_cast<ISeriesRpcStub*>(self)->endpoint->dropImport(self);
+		}
+
+		static int CLOOP_CARG clooptotalStub(const ISeries* self, const int* values, unsigned count) throw()
+		{
+			RpcCall call(static_cast<const ISeriesRpcStub*>(self)->endpoint, 15, 1, self);
+			call.appendData(values, count * sizeof(int));
+			call.append(CommandCell<unsigned>::encode(count));
+
+			call.invoke();
+			return CommandCell<int>::decode(call.result());
+		}
+
+		static void CLOOP_CARG cloopscaleStub(const ISeries* self, const int* in, int* out, unsigned count, int factor) throw()
+		{
+			RpcCall call(static_cast<const ISeriesRpcStub*>(self)->endpoint, 15, 2, self);
+			call.appendData(in, count * sizeof(int));
+			call.appendLength(out, count * sizeof(int));
+			call.append(CommandCell<unsigned>::encode(count));
+			call.append(CommandCell<int>::encode(factor));
+
+			call.invoke();
+			call.resultData(out);
+		}
+
+		static unsigned CLOOP_CARG cloophistogramStub(const ISeries* self, const unsigned char* data, unsigned* counts, unsigned size, unsigned buckets) throw()
+		{
+			RpcCall call(static_cast<const ISeriesRpcStub*>(self)->endpoint, 15, 3, self);
+			call.appendData(data, size * sizeof(unsigned char));
+			call.appendData(counts, buckets * sizeof(unsigned));
+			call.append(CommandCell<unsigned>::encode(size));
+			call.append(CommandCell<unsigned>::encode(buckets));
+
+			call.invoke();
+			unsigned ret = CommandCell<unsigned>::decode(call.result());
+			call.resultData(counts);
+			return ret;
+		}
+
+		static int CLOOP_CARG cloopclampStub(const ISeries* self, int value, int limit) throw()
+		{
+			RpcCall call(static_cast<const ISeriesRpcStub*>(self)->endpoint, 15, 4, self);
+			call.append(CommandCell<int>::encode(value));
+			call.append(CommandCell<int>::encode(limit));
+
+			call.invoke();
+			return CommandCell<int>::decode(call.result());
+		}
+
+		static void CLOOP_CARG cloopclampBatchStub(const ISeries* self, const int* value, const int* limit, int* results, unsigned count) throw()
+		{
+			RpcCall call(static_cast<const ISeriesRpcStub*>(self)->endpoint, 15, 5, self);
+			call.appendData(value, count * sizeof(int));
+			call.appendData(limit, count * sizeof(int));
+			call.appendLength(results, count * sizeof(int));
+			call.append(CommandCell<unsigned>::encode(count));
+
+			call.invoke();
+			call.resultData(results);
+		}
+
+	private:
+		RpcEndpoint* endpoint;
+	};
+
+	inline void* rpcCreateStub(RpcEndpoint* endpoint, unsigned interfaceIndex)
+	{
+		switch (interfaceIndex)
+		{
+			case 0:
+				return static_cast<IDisposable*>(new IDisposableRpcStub(endpoint));
+
+			case 1:
+				return static_cast<IStatus*>(new IStatusRpcStub(endpoint));
+
+			case 4:
+				return static_cast<ICalculator*>(new ICalculatorRpcStub(endpoint));
+
+			case 13:
+				return static_cast<IScanner*>(new IScannerRpcStub(endpoint));
+
+			case 14:
+				return static_cast<IGeometry*>(new IGeometryRpcStub(endpoint));
+
+			case 15:
+				return static_cast<ISeries*>(new ISeriesRpcStub(endpoint));
+
+			default:
+				return nullptr;
+		}
+	}
+
+	inline void rpcDestroyStub(void* stub, unsigned interfaceIndex)
+	{
+		switch (interfaceIndex)
+		{
+			case 0:
+				delete static_cast<IDisposableRpcStub*>(static_cast<IDisposable*>(stub));
+				break;
+
+			case 1:
+				delete static_cast<IStatusRpcStub*>(static_cast<IStatus*>(stub));
+				break;
+
+			case 4:
+				delete static_cast<ICalculatorRpcStub*>(static_cast<ICalculator*>(stub));
+				break;
+
+			case 13:
+				delete static_cast<IScannerRpcStub*>(static_cast<IScanner*>(stub));
+				break;
+
+			case 14:
+				delete static_cast<IGeometryRpcStub*>(static_cast<IGeometry*>(stub));
+				break;
+
+			case 15:
+				delete static_cast<ISeriesRpcStub*>(static_cast<ISeries*>(stub));
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	inline void rpcDispatch(RpcEndpoint* endpoint, const uint64_t* request, std::vector<uint64_t>& response)
+	{
+		unsigned cell = 2;
+		void* self = endpoint->importObject(request[1], 0);
+
+		// Disposed objects get empty responses.
+		if (!self)
+			return;
+
+		switch ((unsigned) (request[0] & 0xFFFFFFFF))
+		{
+			case (0u << 16) | 0u:	// IDisposable::dispose
+			{
+				IDisposable* object = static_cast<IDisposable*>(self);
+				static_cast<IDisposable::VTable*>(object->cloopVTable)->dispose(object);
+				endpoint->dropExport(object);
+				break;
+			}
+
+			case (1u << 16) | 1u:	// IStatus::getCode
+			{
+				const IStatus* object = static_cast<const IStatus*>(self);
+				int ret = static_cast<IStatus::VTable*>(object->cloopVTable)->getCode(object);
+				response.push_back(CommandCell<int>::encode(ret));
+				response.push_back(CommandCell<int>::encode(object->cloopErrorFlag));
+				break;
+			}
+
+			case (1u << 16) | 2u:	// IStatus::setCode
+			{
+				IStatus* object = static_cast<IStatus*>(self);
+				int code = CommandCell<int>::decode(request[cell++]);
+				static_cast<IStatus::VTable*>(object->cloopVTable)->setCode(object, code);
+				response.push_back(CommandCell<int>::encode(object->cloopErrorFlag));
+				break;
+			}
+
+			case (4u << 16) | 1u:	// ICalculator::sum
+			{
+				const ICalculator* object = static_cast<const ICalculator*>(self);
+				IStatus* status = static_cast<IStatus*>(endpoint->importObject(request[cell++], 1));
+
+				if (status)
+					const_cast<IStatus*>(status)->cloopErrorFlag = CommandCell<int>::decode(request[cell]);
+
+				++cell;
+				int n1 = CommandCell<int>::decode(request[cell++]);
+				int n2 = CommandCell<int>::decode(request[cell++]);
+				int ret = static_cast<ICalculator::VTable*>(object->cloopVTable)->sum(object, status, n1, n2);
+				response.push_back(CommandCell<int>::encode(ret));
+				break;
+			}
+
+			case (4u << 16) | 2u:	// ICalculator::getMemory
+			{
+				const ICalculator* object = static_cast<const ICalculator*>(self);
+				int ret = static_cast<ICalculator::VTable*>(object->cloopVTable)->getMemory(object);
+				response.push_back(CommandCell<int>::encode(ret));
+				break;
+			}
+
+			case (4u << 16) | 3u:	// ICalculator::setMemory
+			{
+				ICalculator* object = static_cast<ICalculator*>(self);
+				int n = CommandCell<int>::decode(request[cell++]);
+				static_cast<ICalculator::VTable*>(object->cloopVTable)->setMemory(object, n);
+				break;
+			}
+
+			case (4u << 16) | 4u:	// ICalculator::sumAndStore
+			{
+				ICalculator* object = static_cast<ICalculator*>(self);
+				IStatus* status = static_cast<IStatus*>(endpoint->importObject(request[cell++], 1));
+
+				if (status)
+					const_cast<IStatus*>(status)->cloopErrorFlag = CommandCell<int>::decode(request[cell]);
+
+				++cell;
+				int n1 = CommandCell<int>::decode(request[cell++]);
+				int n2 = CommandCell<int>::decode(request[cell++]);
+				static_cast<ICalculator::VTable*>(object->cloopVTable)->sumAndStore(object, status, n1, n2);
+				break;
+			}
+
+			case (13u << 16) | 1u:	// IScanner::countChar
+			{
+				const IScanner* object = static_cast<const IScanner*>(self);
+				StrView text = readCommandView<StrView>(request, cell);
+				unsigned char c = CommandCell<unsigned char>::decode(request[cell++]);
+				unsigned ret = static_cast<IScanner::VTable*>(object->cloopVTable)->countChar(object, text, c);
+				response.push_back(CommandCell<unsigned>::encode(ret));
+				break;
+			}
+
+			case (13u << 16) | 2u:	// IScanner::trim
+			{
+				const IScanner* object = static_cast<const IScanner*>(self);
+				IStatus* status = static_cast<IStatus*>(endpoint->importObject(request[cell++], 1));
+
+				if (status)
+					const_cast<IStatus*>(status)->cloopErrorFlag = CommandCell<int>::decode(request[cell]);
+
+				++cell;
+				StrView text = readCommandView<StrView>(request, cell);
+				StrView ret = static_cast<IScanner::VTable*>(object->cloopVTable)->trim(object, status, text);
+				appendCommandData(response, ret.data, ret.length);
+				break;
+			}
+
+			case (13u << 16) | 3u:	// IScanner::checksum
+			{
+				const IScanner* object = static_cast<const IScanner*>(self);
+				Bytes in = readCommandView<Bytes>(request, cell);
+				unsigned ret = static_cast<IScanner::VTable*>(object->cloopVTable)->checksum(object, in);
+				response.push_back(CommandCell<unsigned>::encode(ret));
+				break;
+			}
+
+			case (14u << 16) | 1u:	// IGeometry::move
+			{
+				const IGeometry* object = static_cast<const IGeometry*>(self);
+				Rectangle rectangle = readCommandValue<Rectangle>(request, cell);
+				Point offset = readCommandValue<Point>(request, cell);
+				Rectangle ret = static_cast<IGeometry::VTable*>(object->cloopVTable)->move(object, rectangle, offset);
+				appendCommandValue(response, ret);
+				break;
+			}
+
+			case (14u << 16) | 2u:	// IGeometry::area
+			{
+				const IGeometry* object = static_cast<const IGeometry*>(self);
+				std::vector<Rectangle> clooprectangleBuffer;
+				const Rectangle* rectangle = readCommandBuffer(request, cell, true, clooprectangleBuffer);
+				int ret = static_cast<IGeometry::VTable*>(object->cloopVTable)->area(object, rectangle);
+				response.push_back(CommandCell<int>::encode(ret));
+				break;
+			}
+
+			case (14u << 16) | 3u:	// IGeometry::payload
+			{
+				const IGeometry* object = static_cast<const IGeometry*>(self);
+				Header header = readCommandValue<Header>(request, cell);
+				unsigned ret = static_cast<IGeometry::VTable*>(object->cloopVTable)->payload(object, header);
+				response.push_back(CommandCell<unsigned>::encode(ret));
+				break;
+			}
+
+			case (15u << 16) | 1u:	// ISeries::total
+			{
+				const ISeries* object = static_cast<const ISeries*>(self);
+				std::vector<int> cloopvaluesBuffer;
+				const int* values = readCommandBuffer(request, cell, true, cloopvaluesBuffer);
+				unsigned count = CommandCell<unsigned>::decode(request[cell++]);
+				int ret = static_cast<ISeries::VTable*>(object->cloopVTable)->total(object, values, count);
+				response.push_back(CommandCell<int>::encode(ret));
+				break;
+			}
+
+			case (15u << 16) | 2u:	// ISeries::scale
+			{
+				const ISeries* object = static_cast<const ISeries*>(self);
+				std::vector<int> cloopinBuffer;
+				const int* in = readCommandBuffer(request, cell, true, cloopinBuffer);
+				std::vector<int> cloopoutBuffer;
+				int* out = readCommandBuffer(request, cell, false, cloopoutBuffer);
+				unsigned count = CommandCell<unsigned>::decode(request[cell++]);
+				int factor = CommandCell<int>::decode(request[cell++]);
+				static_cast<ISeries::VTable*>(object->cloopVTable)->scale(object, in, out, count, factor);
+				appendCommandBuffer(response, out, cloopoutBuffer);
+				break;
+			}
+
+			case (15u << 16) | 3u:	// ISeries::histogram
+			{
+				const ISeries* object = static_cast<const ISeries*>(self);
+				std::vector<unsigned char> cloopdataBuffer;
+				const unsigned char* data = readCommandBuffer(request, cell, true, cloopdataBuffer);
+				std::vector<unsigned> cloopcountsBuffer;
+				unsigned* counts = readCommandBuffer(request, cell, true, cloopcountsBuffer);
+				unsigned size = CommandCell<unsigned>::decode(request[cell++]);
+				unsigned buckets = CommandCell<unsigned>::decode(request[cell++]);
+				unsigned ret = static_cast<ISeries::VTable*>(object->cloopVTable)->histogram(object, data, counts, size, buckets);
+				response.push_back(CommandCell<unsigned>::encode(ret));
+				appendCommandBuffer(response, counts, cloopcountsBuffer);
+				break;
+			}
+
+			case (15u << 16) | 4u:	// ISeries::clamp
+			{
+				const ISeries* object = static_cast<const ISeries*>(self);
+				int value = CommandCell<int>::decode(request[cell++]);
+				int limit = CommandCell<int>::decode(request[cell++]);
+				int ret = static_cast<ISeries::VTable*>(object->cloopVTable)->clamp(object, value, limit);
+				response.push_back(CommandCell<int>::encode(ret));
+				break;
+			}
+
+			case (15u << 16) | 5u:	// ISeries::clampBatch
+			{
+				const ISeries* object = static_cast<const ISeries*>(self);
+				std::vector<int> cloopvalueBuffer;
+				const int* value = readCommandBuffer(request, cell, true, cloopvalueBuffer);
+				std::vector<int> clooplimitBuffer;
+				const int* limit = readCommandBuffer(request, cell, true, clooplimitBuffer);
+				std::vector<int> cloopresultsBuffer;
+				int* results = readCommandBuffer(request, cell, false, cloopresultsBuffer);
+				unsigned count = CommandCell<unsigned>::decode(request[cell++]);
+				static_cast<ISeries::VTable*>(object->cloopVTable)->clampBatch(object, value, limit, results, count);
+				appendCommandBuffer(response, results, cloopresultsBuffer);
+				break;
+			}
+
+			default:
+				break;
 		}
+	}
 
-		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+	inline void RpcEndpoint::call(std::vector<uint64_t>& request, std::vector<uint64_t>& response)
+	{
+		response.clear();
+
+		if (closed)
+			return;
+
+		request[0] |= (uint64_t) request.size() << 32;
+
+		if (!outgoing->write(request.data(), (uint32_t) request.size(), *peer))
 		{
-			try
+			closed = true;
+			return;
+		}
+
+		while (true)
+		{
+			if (!incoming->read(response, *peer))
 			{
-				static_cast<Name*>(self)->Name::dispose();
+				response.clear();
+				closed = true;
+				return;
 			}
-			catch (...)
+
+			if (((response[0] >> 16) & 0xFFFF) != CONTROL)
+				dispatch(response);
+			else
 			{
-				StatusType::catchException(0);
+				closed = (response[0] & 0xFFFF) == CLOSE;
+				return;
 			}
 		}
+	}
+
+	inline void RpcEndpoint::serve()
+	{
+		std::vector<uint64_t> request;
+
+		while (!closed)
+		{
+			if (!incoming->read(request, *peer))
+				closed = true;
+			else if (((request[0] >> 16) & 0xFFFF) != CONTROL)
+				dispatch(request);
+			else
+				closed = (request[0] & 0xFFFF) == CLOSE;
+		}
+	}
+
+	inline void RpcEndpoint::dispatch(const std::vector<uint64_t>& request)
+	{
+		std::vector<uint64_t> response(1);
+
+		rpcDispatch(this, request.data(), response);
+
+		response[0] = CommandBuffer::header((unsigned) response.size(), CONTROL, RESPONSE);
+
+		if (!outgoing->write(response.data(), (uint32_t) response.size(), *peer))
+			closed = true;
+	}
+#endif
+
+	// Actor proxies (C++11)
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+	struct ActorMessage
+	{
+		std::atomic<ActorMessage*> next;
+		void (*execute)(ActorMessage* message);
 	};
 
-	template <typename Name, typename StatusType, typename Base = Inherit<IDisposable> >
-	class IDisposableImpl : public IDisposableBaseImpl<Name, StatusType, Base>
+	// Call made by a thread waiting for its result.
+	template <typename Function, typename Result>
+	class ActorCall : public ActorMessage
 	{
-	protected:
-		IDisposableImpl(DoNotInherit = DoNotInherit())
+	public:
+		ActorCall(Function& function)
+			: function(function),
+			  done(false)
+		{
+			this->execute = &ActorCall::run;
+		}
+
+		Result wait()
 		{
+			std::unique_lock<std::mutex> lock(mutex);
+			completion.wait(lock, [this] { return done; });
+			return result;
 		}
 
+	private:
+		static void run(ActorMessage* message)
+		{
+			ActorCall* call = static_cast<ActorCall*>(message);
+			call->result = call->function();
+
+			std::lock_guard<std::mutex> lock(call->mutex);
+			call->done = true;
+			call->completion.notify_one();
+		}
+
+	private:
+		Function& function;
+		Result result;
+		bool done;
+		std::mutex mutex;
+		std::condition_variable completion;
+	};
+
+	template <typename Function>
+	class ActorCall<Function, void> : public ActorMessage
+	{
 	public:
-		virtual ~IDisposableImpl()
+		ActorCall(Function& function)
+			: function(function),
+			  done(false)
 		{
+			this->execute = &ActorCall::run;
 		}
 
-		virtual void dispose() = 0;
+		void wait()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			completion.wait(lock, [this] { return done; });
+		}
+
+	private:
+		static void run(ActorMessage* message)
+		{
+			ActorCall* call = static_cast<ActorCall*>(message);
+			call->function();
+
+			std::lock_guard<std::mutex> lock(call->mutex);
+			call->done = true;
+			call->completion.notify_one();
+		}
+
+	private:
+		Function& function;
+		bool done;
+		std::mutex mutex;
+		std::condition_variable completion;
 	};
 
-	template <typename Name, typename StatusType, typename Base>
-	class IStatusBaseImpl : public Base
+	// Call posted without waiting, deleted after it runs.
+	template <typename Function>
+	class ActorPost : public ActorMessage
 	{
 	public:
-		typedef IStatus Declaration;
+		ActorPost(const Function& function)
+			: function(function)
+		{
+			this->execute = &ActorPost::run;
+		}
 
-		IStatusBaseImpl(DoNotInherit = DoNotInherit())
+	private:
+		static void run(ActorMessage* message)
 		{
-			static struct VTableImpl : Base::VTable
+			ActorPost* post = static_cast<ActorPost*>(message);
+			post->function();
+			delete post;
+		}
+
+	private:
+		Function function;
+	};
+
+	// Calls queued by any thread, in a lock-free MPSC queue, and run by the thread owning the
+	// objects. The owner only takes the mutex to sleep when the queue is empty.
+	class ActorMailbox
+	{
+	public:
+		ActorMailbox()
+			: head(&stub),
+			  tail(&stub),
+			  pending(0),
+			  stopped(false)
+		{
+			stub.next.store(nullptr);
+		}
+
+	private:
+		ActorMailbox(const ActorMailbox&);
+		ActorMailbox& operator =(const ActorMailbox&);
+
+	public:
+		// Runs the calls until stop is called.
+		void run()
+		{
+			Owner owner(this);
+
+			while (!stopped)
 			{
-				VTableImpl()
 				{
-					this->version = Base::VERSION;
-					this->dispose = &Name::cloopdisposeDispatcher;
-					this->getCode = &Name::cloopgetCodeDispatcher;
-					this->setCode = &Name::cloopsetCodeDispatcher;
+					std::unique_lock<std::mutex> lock(mutex);
+					wakeup.wait(lock, [this] { return pending.load() != 0; });
 				}
-			} vTable;
 
-			this->cloopVTable = &vTable;
+				runPending();
+			}
 		}
 
-		static int CLOOP_CARG cloopgetCodeDispatcher(const IStatus* self) throw()
+		// Runs the calls queued so far, for owners with their own loop.
+		unsigned drain()
 		{
-			try
+			Owner owner(this);
+			return runPending();
+		}
+
+		void stop()
+		{
+			post([this] { stopped = true; });
+		}
+
+		// Runs directly when called by the owner, as from the objects themselves.
+		template <typename Function>
+		auto call(Function function) -> decltype(function())
+		{
+			if (current() == this)
+				return function();
+
+			ActorCall<Function, decltype(function())> message(function);
+			push(&message);
+			return message.wait();
+		}
+
+		template <typename Function>
+		void post(const Function& function)
+		{
+			push(new ActorPost<Function>(function));
+		}
+
+	private:
+		class Owner
+		{
+		public:
+			Owner(ActorMailbox* mailbox)
+				: previous(current())
 			{
-				return static_cast<const Name*>(self)->Name::getCode();
+				current() = mailbox;
 			}
-			catch (...)
+
+			~Owner()
 			{
-				StatusType::catchException(0);
-				return static_cast<int>(0);
+				current() = previous;
+			}
+
+		private:
+			ActorMailbox* previous;
+		};
+
+		static ActorMailbox*& current()
+		{
+			static thread_local ActorMailbox* mailbox;
+			return mailbox;
+		}
+
+		void push(ActorMessage* message)
+		{
+			message->next.store(nullptr, std::memory_order_relaxed);
+			head.exchange(message)->next.store(message, std::memory_order_release);
+
+			if (pending.fetch_add(1) == 0)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				wakeup.notify_one();
 			}
 		}
 
-		static void CLOOP_CARG cloopsetCodeDispatcher(IStatus* self, int code) throw()
+		// Returns null when empty or when a push is not yet linked.
+		ActorMessage* pop()
 		{
-			try
+			ActorMessage* first = tail;
+			ActorMessage* next = first->next.load(std::memory_order_acquire);
+
+			if (first == &stub)
 			{
-				static_cast<Name*>(self)->Name::setCode(code);
+				if (!next)
+					return nullptr;
+
+				tail = first = next;
+				next = next->next.load(std::memory_order_acquire);
 			}
-			catch (...)
+
+			if (!next)
 			{
-				StatusType::catchException(0);
+				if (first != head.load())
+					return nullptr;
+
+				stub.next.store(nullptr, std::memory_order_relaxed);
+				head.exchange(&stub)->next.store(&stub, std::memory_order_release);
+				next = first->next.load(std::memory_order_acquire);
+
+				if (!next)
+					return nullptr;
 			}
+
+			tail = next;
+			return first;
 		}
 
-		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		unsigned runPending()
 		{
-			try
-			{
-				static_cast<Name*>(self)->Name::dispose();
-			}
-			catch (...)
+			unsigned count = pending.load();
+
+			for (unsigned i = 0; i < count; )
 			{
-				StatusType::catchException(0);
+				if (ActorMessage* message = pop())
+				{
+					pending.fetch_sub(1);
+					message->execute(message);
+					++i;
+				}
+				else
+					std::this_thread::yield();
 			}
+
+			return count;
 		}
+
+	private:
+		std::atomic<ActorMessage*> head;
+		ActorMessage* tail;
+		ActorMessage stub;
+		std::atomic<unsigned> pending;
+		bool stopped;
+		std::mutex mutex;
+		std::condition_variable wakeup;
 	};
 
-	template <typename Name, typename StatusType, typename Base = IDisposableImpl<Name, StatusType, Inherit<IStatus> > >
-	class IStatusImpl : public IStatusBaseImpl<Name, StatusType, Base>
+	class IStatusActorProxy : public IStatus
 	{
-	protected:
-		IStatusImpl(DoNotInherit = DoNotInherit())
+	public:
+		IStatusActorProxy(IStatus* target, ActorMailbox* mailbox)
+			: IStatus(DoNotInherit()),
+			  target(target),
+			  mailbox(mailbox)
+		{
+			static struct VTableImpl : VTable
+			{
+				VTableImpl()
+				{
+					this->version = IStatus::VERSION;
+					this->dispose = &IStatusActorProxy::cloopdisposeProxy;
+					this->getCode = &IStatusActorProxy::cloopgetCodeProxy;
+					this->setCode = &IStatusActorProxy::cloopsetCodeProxy;
+				}
+			} vTable;
+
+			this->cloopVTable = &vTable;
+			this->cloopErrorFlag = target->cloopErrorFlag;
+		}
+
+		static void CLOOP_CARG cloopdisposeProxy(IDisposable* self) throw()
 		{
+			IDisposable* target = static_cast<const IStatusActorProxy*>(self)->target;
+
+			static_cast<const IStatusActorProxy*>(self)->mailbox->post([=] {
+				static_cast<IDisposable::VTable*>(target->cloopVTable)->dispose(target);
+			});
+			delete static_cast<const IStatusActorProxy*>(self);
 		}
 
-	public:
-		virtual ~IStatusImpl()
+		static int CLOOP_CARG cloopgetCodeProxy(const IStatus* self) throw()
 		{
+			IStatus* target = static_cast<const IStatusActorProxy*>(self)->target;
+
+			int ret = static_cast<const IStatusActorProxy*>(self)->mailbox->call([&] {
+				return static_cast<IStatus::VTable*>(target->cloopVTable)->getCode(target);
+			});
+			const_cast<IStatus*>(self)->cloopErrorFlag = target->cloopErrorFlag;
+			return ret;
 		}
 
-		virtual int getCode() const = 0;
-		virtual void setCode(int code) = 0;
+		static void CLOOP_CARG cloopsetCodeProxy(IStatus* self, int code) throw()
+		{
+			IStatus* target = static_cast<const IStatusActorProxy*>(self)->target;
+
+			static_cast<const IStatusActorProxy*>(self)->mailbox->call([&] {
+				static_cast<IStatus::VTable*>(target->cloopVTable)->setCode(target, code);
+			});
+			const_cast<IStatus*>(self)->cloopErrorFlag = target->cloopErrorFlag;
+		}
+
+	private:
+		IStatus* target;
+		ActorMailbox* mailbox;
 	};
 
-	template <typename Name, typename StatusType, typename Base>
-	class IStatusFactoryBaseImpl : public Base
+	class ICalculatorActorProxy : public ICalculator
 	{
 	public:
-		typedef IStatusFactory Declaration;
-
-		IStatusFactoryBaseImpl(DoNotInherit = DoNotInherit())
+		ICalculatorActorProxy(ICalculator* target, ActorMailbox* mailbox)
+			: ICalculator(DoNotInherit()),
+			  target(target),
+			  mailbox(mailbox)
 		{
-			static struct VTableImpl : Base::VTable
+			static struct VTableImpl : VTable
 			{
 				VTableImpl()
 				{
-					this->version = Base::VERSION;
-					this->dispose = &Name::cloopdisposeDispatcher;
-					this->createStatus = &Name::cloopcreateStatusDispatcher;
+					this->version = ICalculator::VERSION;
+					this->dispose = &ICalculatorActorProxy::cloopdisposeProxy;
+					this->sum = &ICalculatorActorProxy::cloopsumProxy;
+					this->getMemory = &ICalculatorActorProxy::cloopgetMemoryProxy;
+					this->setMemory = &ICalculatorActorProxy::cloopsetMemoryProxy;
+					this->sumAndStore = &ICalculatorActorProxy::cloopsumAndStoreProxy;
 				}
 			} vTable;
 
 			this->cloopVTable = &vTable;
 		}
 
-		static IStatus* CLOOP_CARG cloopcreateStatusDispatcher(IStatusFactory* self) throw()
+		static void CLOOP_CARG cloopdisposeProxy(IDisposable* self) throw()
 		{
-			try
-			{
-				return static_cast<Name*>(self)->Name::createStatus();
-			}
-			catch (...)
-			{
-				StatusType::catchException(0);
-				return static_cast<IStatus*>(0);
-			}
+			IDisposable* target = static_cast<const ICalculatorActorProxy*>(self)->target;
+
+			static_cast<const ICalculatorActorProxy*>(self)->mailbox->post([=] {
+				static_cast<IDisposable::VTable*>(target->cloopVTable)->dispose(target);
+			});
+			delete static_cast<const ICalculatorActorProxy*>(self);
 		}
 
-		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		static int CLOOP_CARG cloopsumProxy(const ICalculator* self, IStatus* status, int n1, int n2) throw()
 		{
-			try
-			{
-				static_cast<Name*>(self)->Name::dispose();
-			}
-			catch (...)
-			{
-				StatusType::catchException(0);
-			}
+			ICalculator* target = static_cast<const ICalculatorActorProxy*>(self)->target;
+
+			return static_cast<const ICalculatorActorProxy*>(self)->mailbox->call([&] {
+				return static_cast<ICalculator::VTable*>(target->cloopVTable)->sum(target, status, n1, n2);
+			});
 		}
-	};
 
-	template <typename Name, typename StatusType, typename Base = IDisposableImpl<Name, StatusType, Inherit<IStatusFactory> > >
-	class IStatusFactoryImpl : public IStatusFactoryBaseImpl<Name, StatusType, Base>
-	{
-	protected:
-		IStatusFactoryImpl(DoNotInherit = DoNotInherit())
+		static int CLOOP_CARG cloopgetMemoryProxy(const ICalculator* self) throw()
 		{
+			ICalculator* target = static_cast<const ICalculatorActorProxy*>(self)->target;
+
+			return static_cast<const ICalculatorActorProxy*>(self)->mailbox->call([&] {
+				return static_cast<ICalculator::VTable*>(target->cloopVTable)->getMemory(target);
+			});
 		}
 
-	public:
-		virtual ~IStatusFactoryImpl()
+		static void CLOOP_CARG cloopsetMemoryProxy(ICalculator* self, int n) throw()
 		{
+			ICalculator* target = static_cast<const ICalculatorActorProxy*>(self)->target;
+
+			static_cast<const ICalculatorActorProxy*>(self)->mailbox->post([=] {
+				static_cast<ICalculator::VTable*>(target->cloopVTable)->setMemory(target, n);
+			});
 		}
 
-		virtual IStatus* createStatus() = 0;
+		static void CLOOP_CARG cloopsumAndStoreProxy(ICalculator* self, IStatus* status, int n1, int n2) throw()
+		{
+			ICalculator* target = static_cast<const ICalculatorActorProxy*>(self)->target;
+
+			static_cast<const ICalculatorActorProxy*>(self)->mailbox->call([&] {
+				static_cast<ICalculator::VTable*>(target->cloopVTable)->sumAndStore(target, status, n1, n2);
+			});
+		}
+
+	private:
+		ICalculator* target;
+		ActorMailbox* mailbox;
 	};
 
-	template <typename Name, typename StatusType, typename Base>
-	class IFactoryBaseImpl : public Base
+	class ICalculator2ActorProxy : public ICalculator2
 	{
 	public:
-		typedef IFactory Declaration;
-
-		IFactoryBaseImpl(DoNotInherit = DoNotInherit())
+		ICalculator2ActorProxy(ICalculator2* target, ActorMailbox* mailbox)
+			: ICalculator2(DoNotInherit()),
+			  target(target),
+			  mailbox(mailbox)
 		{
-			static struct VTableImpl : Base::VTable
+			static struct VTableImpl : VTable
 			{
 				VTableImpl()
 				{
-					this->version = Base::VERSION;
-					this->dispose = &Name::cloopdisposeDispatcher;
-					this->createStatus = &Name::cloopcreateStatusDispatcher;
-					this->createCalculator = &Name::cloopcreateCalculatorDispatcher;
-					this->createCalculator2 = &Name::cloopcreateCalculator2Dispatcher;
-					this->createBrokenCalculator = &Name::cloopcreateBrokenCalculatorDispatcher;
-					this->setStatusFactory = &Name::cloopsetStatusFactoryDispatcher;
+					this->version = ICalculator2::VERSION;
+					this->dispose = &ICalculator2ActorProxy::cloopdisposeProxy;
+					this->sum = &ICalculator2ActorProxy::cloopsumProxy;
+					this->getMemory = &ICalculator2ActorProxy::cloopgetMemoryProxy;
+					this->setMemory = &ICalculator2ActorProxy::cloopsetMemoryProxy;
+					this->sumAndStore = &ICalculator2ActorProxy::cloopsumAndStoreProxy;
+					this->multiply = &ICalculator2ActorProxy::cloopmultiplyProxy;
+					this->copyMemory = &ICalculator2ActorProxy::cloopcopyMemoryProxy;
+					this->copyMemory2 = &ICalculator2ActorProxy::cloopcopyMemory2Proxy;
+					this->multiplyBatch = &ICalculator2ActorProxy::cloopmultiplyBatchProxy;
 				}
 			} vTable;
 
 			this->cloopVTable = &vTable;
 		}
 
-		static IStatus* CLOOP_CARG cloopcreateStatusDispatcher(IFactory* self) throw()
+		static void CLOOP_CARG cloopdisposeProxy(IDisposable* self) throw()
 		{
-			try
-			{
-				return static_cast<Name*>(self)->Name::createStatus();
-			}
-			catch (...)
-			{
-				StatusType::catchException(0);
-				return static_cast<IStatus*>(0);
-			}
+			IDisposable* target = static_cast<const ICalculator2ActorProxy*>(self)->target;
+
+			static_cast<const ICalculator2ActorProxy*>(self)->mailbox->post([=] {
+				static_cast<IDisposable::VTable*>(target->cloopVTable)->dispose(target);
+			});
+			delete static_cast<const ICalculator2ActorProxy*>(self);
 		}
 
-		static ICalculator* CLOOP_CARG cloopcreateCalculatorDispatcher(IFactory* self, IStatus* status) throw()
+		static int CLOOP_CARG cloopsumProxy(const ICalculator* self, IStatus* status, int n1, int n2) throw()
 		{
-			StatusType status2(status);
+			ICalculator* target = static_cast<const ICalculator2ActorProxy*>(self)->target;
 
-			try
-			{
-				return static_cast<Name*>(self)->Name::createCalculator(&status2);
-			}
-			catch (...)
-			{
-				StatusType::catchException(&status2);
-				return static_cast<ICalculator*>(0);
-			}
+			return static_cast<const ICalculator2ActorProxy*>(self)->mailbox->call([&] {
+				return static_cast<ICalculator::VTable*>(target->cloopVTable)->sum(target, status, n1, n2);
+			});
 		}
 
-		static ICalculator2* CLOOP_CARG cloopcreateCalculator2Dispatcher(IFactory* self, IStatus* status) throw()
+		static int CLOOP_CARG cloopgetMemoryProxy(const ICalculator* self) throw()
 		{
-			StatusType status2(status);
+			ICalculator* target = static_cast<const ICalculator2ActorProxy*>(self)->target;
 
-			try
-			{
-				return static_cast<Name*>(self)->Name::createCalculator2(&status2);
-			}
-			catch (...)
-			{
-				StatusType::catchException(&status2);
-				return static_cast<ICalculator2*>(0);
-			}
+			return static_cast<const ICalculator2ActorProxy*>(self)->mailbox->call([&] {
+				return static_cast<ICalculator::VTable*>(target->cloopVTable)->getMemory(target);
+			});
+		}
+
+		static void CLOOP_CARG cloopsetMemoryProxy(ICalculator* self, int n) throw()
+		{
+			ICalculator* target = static_cast<const ICalculator2ActorProxy*>(self)->target;
+
+			static_cast<const ICalculator2ActorProxy*>(self)->mailbox->post([=] {
+				static_cast<ICalculator::VTable*>(target->cloopVTable)->setMemory(target, n);
+			});
 		}
 
-		static ICalculator* CLOOP_CARG cloopcreateBrokenCalculatorDispatcher(IFactory* self, IStatus* status) throw()
+		static void CLOOP_CARG cloopsumAndStoreProxy(ICalculator* self, IStatus* status, int n1, int n2) throw()
 		{
-			StatusType status2(status);
+			ICalculator* target = static_cast<const ICalculator2ActorProxy*>(self)->target;
 
-			try
-			{
-				return static_cast<Name*>(self)->Name::createBrokenCalculator(&status2);
-			}
-			catch (...)
-			{
-				StatusType::catchException(&status2);
-				return static_cast<ICalculator*>(0);
-			}
+			static_cast<const ICalculator2ActorProxy*>(self)->mailbox->call([&] {
+				static_cast<ICalculator::VTable*>(target->cloopVTable)->sumAndStore(target, status, n1, n2);
+			});
 		}
 
-		static void CLOOP_CARG cloopsetStatusFactoryDispatcher(IFactory* self, IStatusFactory* statusFactory) throw()
+		static int CLOOP_CARG cloopmultiplyProxy(const ICalculator2* self, IStatus* status, int n1, int n2) throw()
 		{
-			try
-			{
-				static_cast<Name*>(self)->Name::setStatusFactory(statusFactory);
-			}
-			catch (...)
-			{
-				StatusType::catchException(0);
-			}
+			ICalculator2* target = static_cast<const ICalculator2ActorProxy*>(self)->target;
+
+			return static_cast<const ICalculator2ActorProxy*>(self)->mailbox->call([&] {
+				return static_cast<ICalculator2::VTable*>(target->cloopVTable)->multiply(target, status, n1, n2);
+			});
 		}
 
-		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		static void CLOOP_CARG cloopcopyMemoryProxy(ICalculator2* self, const ICalculator* calculator) throw()
 		{
-			try
-			{
-				static_cast<Name*>(self)->Name::dispose();
-			}
-			catch (...)
-			{
-				StatusType::catchException(0);
-			}
+			ICalculator2* target = static_cast<const ICalculator2ActorProxy*>(self)->target;
+
+			static_cast<const ICalculator2ActorProxy*>(self)->mailbox->call([&] {
+				static_cast<ICalculator2::VTable*>(target->cloopVTable)->copyMemory(target, calculator);
+			});
 		}
-	};
 
-	template <typename Name, typename StatusType, typename Base = IDisposableImpl<Name, StatusType, Inherit<IFactory> > >
-	class IFactoryImpl : public IFactoryBaseImpl<Name, StatusType, Base>
-	{
-	protected:
-		IFactoryImpl(DoNotInherit = DoNotInherit())
+		static void CLOOP_CARG cloopcopyMemory2Proxy(ICalculator2* self, const int* address) throw()
 		{
+			ICalculator2* target = static_cast<const ICalculator2ActorProxy*>(self)->target;
+
+			static_cast<const ICalculator2ActorProxy*>(self)->mailbox->call([&] {
+				static_cast<ICalculator2::VTable*>(target->cloopVTable)->copyMemory2(target, address);
+			});
 		}
 
-	public:
-		virtual ~IFactoryImpl()
+		static void CLOOP_CARG cloopmultiplyBatchProxy(const ICalculator2* self, IStatus* status, const int* n1, const int* n2, int* results, unsigned count) throw()
 		{
+			ICalculator2* target = static_cast<const ICalculator2ActorProxy*>(self)->target;
+
+			static_cast<const ICalculator2ActorProxy*>(self)->mailbox->call([&] {
+				static_cast<ICalculator2::VTable*>(target->cloopVTable)->multiplyBatch(target, status, n1, n2, results, count);
+			});
 		}
 
-		virtual IStatus* createStatus() = 0;
-		virtual ICalculator* createCalculator(StatusType* status) = 0;
-		virtual ICalculator2* createCalculator2(StatusType* status) = 0;
-		virtual ICalculator* createBrokenCalculator(StatusType* status) = 0;
-		virtual void setStatusFactory(IStatusFactory* statusFactory) = 0;
+	private:
+		ICalculator2* target;
+		ActorMailbox* mailbox;
 	};
 
-	template <typename Name, typename StatusType, typename Base>
-	class ICalculatorBaseImpl : public Base
+	class ICounterActorProxy : public ICounter
 	{
 	public:
-		typedef ICalculator Declaration;
-
-		ICalculatorBaseImpl(DoNotInherit = DoNotInherit())
+		ICounterActorProxy(ICounter* target, ActorMailbox* mailbox)
+			: ICounter(DoNotInherit()),
+			  target(target),
+			  mailbox(mailbox)
 		{
-			static struct VTableImpl : Base::VTable
+			static struct VTableImpl : VTable
 			{
 				VTableImpl()
 				{
-					this->version = Base::VERSION;
-					this->dispose = &Name::cloopdisposeDispatcher;
-					this->sum = &Name::cloopsumDispatcher;
-					this->getMemory = &Name::cloopgetMemoryDispatcher;
-					this->setMemory = &Name::cloopsetMemoryDispatcher;
-					this->sumAndStore = &Name::cloopsumAndStoreDispatcher;
+					this->version = ICounter::VERSION;
+					this->dispose = &ICounterActorProxy::cloopdisposeProxy;
+					this->increment = &ICounterActorProxy::cloopincrementProxy;
+					this->getValue = &ICounterActorProxy::cloopgetValueProxy;
+					this->add = &ICounterActorProxy::cloopaddProxy;
 				}
 			} vTable;
 
 			this->cloopVTable = &vTable;
 		}
 
-		static int CLOOP_CARG cloopsumDispatcher(const ICalculator* self, IStatus* status, int n1, int n2) throw()
+		static void CLOOP_CARG cloopdisposeProxy(ICounter* self) throw()
 		{
-			StatusType status2(status);
+			ICounter* target = static_cast<const ICounterActorProxy*>(self)->target;
 
-			try
+			static_cast<const ICounterActorProxy*>(self)->mailbox->post([=] {
+				static_cast<ICounter::VTable*>(target->cloopVTable)->dispose(target);
+			});
+			delete static_cast<const ICounterActorProxy*>(self);
+		}
+
+		static int CLOOP_CARG cloopincrementProxy(ICounter* self) throw()
+		{
+			ICounter* target = static_cast<const ICounterActorProxy*>(self)->target;
+
+			return static_cast<const ICounterActorProxy*>(self)->mailbox->call([&] {
+				return static_cast<ICounter::VTable*>(target->cloopVTable)->increment(target);
+			});
+		}
+
+		static int CLOOP_CARG cloopgetValueProxy(const ICounter* self) throw()
+		{
+			ICounter* target = static_cast<const ICounterActorProxy*>(self)->target;
+
+			return static_cast<const ICounterActorProxy*>(self)->mailbox->call([&] {
+				return static_cast<ICounter::VTable*>(target->cloopVTable)->getValue(target);
+			});
+		}
+
+		static void CLOOP_CARG cloopaddProxy(ICounter* self, const ICounter* counter) throw()
+		{
+			ICounter* target = static_cast<const ICounterActorProxy*>(self)->target;
+
+			static_cast<const ICounterActorProxy*>(self)->mailbox->call([&] {
+				static_cast<ICounter::VTable*>(target->cloopVTable)->add(target, counter);
+			});
+		}
+
+	private:
+		ICounter* target;
+		ActorMailbox* mailbox;
+	};
+#endif
+
+	// Epoch-based disposal (C++11)
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+	// Reader sections of the process and the objects retired meanwhile. Readers only store the
+	// epoch they entered in a slot of their own; a retired object is disposed once every reader
+	// that could still reach it has left its section.
+	class EpochReclamation
+	{
+	public:
+		// Entered by readers, with nesting, before loading shared objects.
+		static void enter()
+		{
+			Reader* reader = current();
+
+			if (reader->depth++ == 0)
 			{
-				return static_cast<const Name*>(self)->Name::sum(&status2, n1, n2);
+				reader->epoch.store(global().epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
 			}
-			catch (...)
+		}
+
+		static void leave()
+		{
+			Reader* reader = current();
+
+			if (--reader->depth == 0)
+				reader->epoch.store(0, std::memory_order_release);
+		}
+
+		// Disposes an object no longer reachable by new readers after the current ones left.
+		template <typename T>
+		static void retire(T* object)
+		{
+			Global& state = global();
+			std::vector<Retired> disposable;
+
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
 			{
-				StatusType::catchException(&status2);
-				return static_cast<int>(0);
+				std::lock_guard<std::mutex> lock(state.mutex);
+				Retired retired = {object, &disposeObject<T>, state.epoch.load(std::memory_order_relaxed)};
+				state.retired.push_back(retired);
+
+				if (state.retired.size() >= state.collectAt)
+					take(state, disposable);
 			}
+
+			dispose(disposable);
 		}
 
-		static int CLOOP_CARG cloopgetMemoryDispatcher(const ICalculator* self) throw()
+		// Disposes the retired objects no reader can reach, returning how many are left.
+		static unsigned collect()
 		{
-			try
+			Global& state = global();
+			std::vector<Retired> disposable;
+			unsigned left;
+
 			{
-				return static_cast<const Name*>(self)->Name::getMemory();
+				std::lock_guard<std::mutex> lock(state.mutex);
+				left = take(state, disposable);
 			}
-			catch (...)
+
+			dispose(disposable);
+			return left;
+		}
+
+	private:
+		static const unsigned RETIRE_BATCH = 64;
+
+		struct Reader
+		{
+			std::atomic<uint64_t> epoch;	// entered, 0 outside of sections
+			std::atomic<bool> used;
+			Reader* next;
+			unsigned depth;
+		};
+
+		struct Retired
+		{
+			void* object;
+			void (*dispose)(void* object);
+			uint64_t epoch;
+		};
+
+		struct Global
+		{
+			Global()
+				: epoch(1),
+				  readers(nullptr),
+				  collectAt(RETIRE_BATCH)
 			{
-				StatusType::catchException(0);
-				return static_cast<int>(0);
 			}
-		}
 
-		static void CLOOP_CARG cloopsetMemoryDispatcher(ICalculator* self, int n) throw()
+			std::atomic<uint64_t> epoch;
+			std::atomic<Reader*> readers;	// never removed, reused by new threads
+			std::mutex mutex;
+			std::vector<Retired> retired;
+			size_t collectAt;
+		};
+
+		class Thread
 		{
-			try
+		public:
+			Thread()
+				: reader(acquire())
 			{
-				static_cast<Name*>(self)->Name::setMemory(n);
 			}
-			catch (...)
+
+			~Thread()
 			{
-				StatusType::catchException(0);
+				reader->used.store(false, std::memory_order_release);
 			}
+
+			Reader* reader;
+		};
+
+		static Global& global()
+		{
+			static Global state;
+			return state;
 		}
 
-		static void CLOOP_CARG cloopsumAndStoreDispatcher(ICalculator* self, IStatus* status, int n1, int n2) throw()
+		static Reader* current()
 		{
-			StatusType status2(status);
+			static thread_local Thread thread;
+			return thread.reader;
+		}
 
-			try
-			{
-				static_cast<Name*>(self)->Name::sumAndStore(&status2, n1, n2);
-			}
-			catch (...)
+		static Reader* acquire()
+		{
+			Global& state = global();
+
+			for (Reader* reader = state.readers.load(std::memory_order_acquire); reader; reader = reader->next)
 			{
-				StatusType::catchException(&status2);
+				bool used = false;
+
+				if (!reader->used.load(std::memory_order_relaxed) &&
+					reader->used.compare_exchange_strong(used, true, std::memory_order_acquire))
+				{
+					return reader;
+				}
 			}
+
+			Reader* reader = new Reader;
+			reader->epoch.store(0, std::memory_order_relaxed);
+			reader->used.store(true, std::memory_order_relaxed);
+			reader->depth = 0;
+			reader->next = state.readers.load(std::memory_order_relaxed);
+
+			while (!state.readers.compare_exchange_weak(reader->next, reader, std::memory_order_release))
+				;
+
+			return reader;
 		}
 
-		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
+		// Moves out the objects retired before the oldest epoch of the active readers and
+		// advances the epoch when all of them entered the current one.
+		static unsigned take(Global& state, std::vector<Retired>& disposable)
 		{
-			try
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			uint64_t epoch = state.epoch.load(std::memory_order_relaxed);
+			uint64_t oldest = epoch;
+
+			for (Reader* reader = state.readers.load(std::memory_order_acquire); reader; reader = reader->next)
 			{
-				static_cast<Name*>(self)->Name::dispose();
+				uint64_t readerEpoch = reader->epoch.load(std::memory_order_relaxed);
+
+				if (readerEpoch != 0 && readerEpoch < oldest)
+					oldest = readerEpoch;
 			}
-			catch (...)
+
+			if (oldest == epoch)
+				state.epoch.store(epoch + 1, std::memory_order_release);
+
+			size_t left = 0;
+
+			for (size_t i = 0; i < state.retired.size(); ++i)
 			{
-				StatusType::catchException(0);
+				if (state.retired[i].epoch < oldest)
+					disposable.push_back(state.retired[i]);
+				else
+					state.retired[left++] = state.retired[i];
 			}
+
+			state.retired.resize(left);
+			state.collectAt = left * 2 > RETIRE_BATCH ? left * 2 : RETIRE_BATCH;
+
+			return (unsigned) left;
+		}
+
+		// Called without the lock, as disposing may retire other objects.
+		static void dispose(const std::vector<Retired>& disposable)
+		{
+			for (size_t i = 0; i < disposable.size(); ++i)
+				disposable[i].dispose(disposable[i].object);
+		}
+
+		template <typename T>
+		static void disposeObject(void* object)
+		{
+			static_cast<T*>(object)->dispose();
 		}
 	};
 
-	template <typename Name, typename StatusType, typename Base = IDisposableImpl<Name, StatusType, Inherit<ICalculator> > >
-	class ICalculatorImpl : public ICalculatorBaseImpl<Name, StatusType, Base>
+	// Reader section of a scope.
+	class EpochGuard
 	{
-	protected:
-		ICalculatorImpl(DoNotInherit = DoNotInherit())
+	public:
+		EpochGuard()
 		{
+			EpochReclamation::enter();
 		}
 
-	public:
-		virtual ~ICalculatorImpl()
+		~EpochGuard()
 		{
+			EpochReclamation::leave();
 		}
 
-		virtual int sum(StatusType* status, int n1, int n2) const = 0;
-		virtual int getMemory() const = 0;
-		virtual void setMemory(int n) = 0;
-		virtual void sumAndStore(StatusType* status, int n1, int n2) = 0;
+		EpochGuard(const EpochGuard&) = delete;
+		EpochGuard& operator =(const EpochGuard&) = delete;
 	};
+#endif
 
-	template <typename Name, typename StatusType, typename Base>
-	class ICalculator2BaseImpl : public Base
+	// Awaitable async calls (C++20)
+
+#ifdef CLOOP_COROUTINES
+
+	template <typename StatusType>
+	class IAsyncCalculatorSumAwaiter : public IAsyncCalculatorSumCompletion
 	{
 	public:
-		typedef ICalculator2 Declaration;
-
-		ICalculator2BaseImpl(DoNotInherit = DoNotInherit())
+		IAsyncCalculatorSumAwaiter(const IAsyncCalculator* object, StatusType* status, int n1, int n2)
+			: IAsyncCalculatorSumCompletion(DoNotInherit()),
+			  object(object),
+			  status(status),
+			  n1(n1),
+			  n2(n2),
+			  state(STARTING),
+			  failure(false),
+			  result()
 		{
-			static struct VTableImpl : Base::VTable
+			static struct VTableImpl : VTable
 			{
 				VTableImpl()
 				{
-					this->version = Base::VERSION;
-					this->dispose = &Name::cloopdisposeDispatcher;
-					this->sum = &Name::cloopsumDispatcher;
-					this->getMemory = &Name::cloopgetMemoryDispatcher;
-					this->setMemory = &Name::cloopsetMemoryDispatcher;
-					this->sumAndStore = &Name::cloopsumAndStoreDispatcher;
-					this->multiply = &Name::cloopmultiplyDispatcher;
-					this->copyMemory = &Name::cloopcopyMemoryDispatcher;
-					this->copyMemory2 = &Name::cloopcopyMemory2Dispatcher;
+					this->version = IAsyncCalculatorSumCompletion::VERSION;
+					this->complete = &IAsyncCalculatorSumAwaiter::cloopcompleteDispatcher;
 				}
 			} vTable;
 
 			this->cloopVTable = &vTable;
 		}
 
-		static int CLOOP_CARG cloopmultiplyDispatcher(const ICalculator2* self, IStatus* status, int n1, int n2) throw()
-		{
-			StatusType status2(status);
-
-			try
-			{
-				return static_cast<const Name*>(self)->Name::multiply(&status2, n1, n2);
-			}
-			catch (...)
-			{
-				StatusType::catchException(&status2);
-				return static_cast<int>(0);
-			}
-		}
+		IAsyncCalculatorSumAwaiter(const IAsyncCalculatorSumAwaiter&) = delete;
+		IAsyncCalculatorSumAwaiter& operator =(const IAsyncCalculatorSumAwaiter&) = delete;
 
-		static void CLOOP_CARG cloopcopyMemoryDispatcher(ICalculator2* self, const ICalculator* calculator) throw()
+		bool await_ready() const
 		{
-			try
-			{
-				static_cast<Name*>(self)->Name::copyMemory(calculator);
-			}
-			catch (...)
-			{
-				StatusType::catchException(0);
-			}
+			return false;
 		}
 
-		static void CLOOP_CARG cloopcopyMemory2Dispatcher(ICalculator2* self, const int* address) throw()
+		bool await_suspend(std::coroutine_handle<> handle)
 		{
-			try
-			{
-				static_cast<Name*>(self)->Name::copyMemory2(address);
-			}
-			catch (...)
+			this->handle = handle;
+			object->sumAsync(status, n1, n2, this);
+			if (StatusType::hasError(status))
 			{
-				StatusType::catchException(0);
+				failure = true;
+				return false;
 			}
+
+			return state.exchange(SUSPENDED) != COMPLETED;
 		}
 
-		static int CLOOP_CARG cloopsumDispatcher(const ICalculator* self, IStatus* status, int n1, int n2) throw()
+		int await_resume()
 		{
-			StatusType status2(status);
+#ifndef CLOOP_NO_EXCEPTIONS
+			if (exception)
+				std::rethrow_exception(exception);
+#endif
 
-			try
-			{
-				return static_cast<const Name*>(self)->Name::sum(&status2, n1, n2);
-			}
-			catch (...)
-			{
-				StatusType::catchException(&status2);
-				return static_cast<int>(0);
-			}
+			return result;
 		}
 
-		static int CLOOP_CARG cloopgetMemoryDispatcher(const ICalculator* self) throw()
+		bool failed() const
 		{
-			try
-			{
-				return static_cast<const Name*>(self)->Name::getMemory();
-			}
-			catch (...)
-			{
-				StatusType::catchException(0);
-				return static_cast<int>(0);
-			}
+			return failure;
 		}
 
-		static void CLOOP_CARG cloopsetMemoryDispatcher(ICalculator* self, int n) throw()
+	private:
+		static void CLOOP_CARG cloopcompleteDispatcher(IAsyncCalculatorSumCompletion* self, IStatus* status, int result) throw()
 		{
-			try
-			{
-				static_cast<Name*>(self)->Name::setMemory(n);
-			}
-			catch (...)
-			{
-				StatusType::catchException(0);
-			}
-		}
+			IAsyncCalculatorSumAwaiter* awaiter = static_cast<IAsyncCalculatorSumAwaiter*>(self);
 
-		static void CLOOP_CARG cloopsumAndStoreDispatcher(ICalculator* self, IStatus* status, int n1, int n2) throw()
-		{
-			StatusType status2(status);
+			typename StatusTraits<StatusType>::Holder status2(status);
 
-			try
-			{
-				static_cast<Name*>(self)->Name::sumAndStore(&status2, n1, n2);
-			}
-			catch (...)
+			if (StatusType::hasError(status2.get()))
 			{
-				StatusType::catchException(&status2);
+				awaiter->failure = true;
+#ifndef CLOOP_NO_EXCEPTIONS
+				try
+				{
+					StatusType::checkException(status2.get());
+				}
+				catch (...)
+				{
+					awaiter->exception = std::current_exception();
+				}
+#endif
 			}
-		}
 
-		static void CLOOP_CARG cloopdisposeDispatcher(IDisposable* self) throw()
-		{
-			try
-			{
-				static_cast<Name*>(self)->Name::dispose();
-			}
-			catch (...)
-			{
-				StatusType::catchException(0);
-			}
-		}
-	};
+			awaiter->result = result;
 
-	template <typename Name, typename StatusType, typename Base = ICalculatorImpl<Name, StatusType, Inherit<IDisposableImpl<Name, StatusType, Inherit<ICalculator2> > > > >
-	class ICalculator2Impl : public ICalculator2BaseImpl<Name, StatusType, Base>
-	{
-	protected:
-		ICalculator2Impl(DoNotInherit = DoNotInherit())
-		{
+			if (awaiter->state.exchange(COMPLETED) == SUSPENDED)
+				awaiter->handle.resume();
 		}
 
-	public:
-		virtual ~ICalculator2Impl()
+	private:
+		enum State
 		{
-		}
+			STARTING,
+			SUSPENDED,
+			COMPLETED
+		};
 
-		virtual int multiply(StatusType* status, int n1, int n2) const = 0;
-		virtual void copyMemory(const ICalculator* calculator) = 0;
-		virtual void copyMemory2(const int* address) = 0;
+		const IAsyncCalculator* object;
+		StatusType* status;
+		int n1;
+		int n2;
+		std::coroutine_handle<> handle;
+		std::atomic<int> state;
+		bool failure;
+#ifndef CLOOP_NO_EXCEPTIONS
+		std::exception_ptr exception;
+#endif
+		int result;
 	};
+#endif
 };
 
 
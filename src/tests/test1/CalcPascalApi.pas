@@ -16,12 +16,34 @@ type
 	QWord = UInt64;
 {$ENDIF}
 
+	CloopStrView = record
+		data: PAnsiChar;
+		length: QWord;
+	end;
+
+	CloopBytes = record
+		data: PByte;
+		length: QWord;
+	end;
+
 	Disposable = class;
 	Status = class;
 	StatusFactory = class;
 	Factory = class;
 	Calculator = class;
 	Calculator2 = class;
+	Counter = class;
+	ReferenceCounted = class;
+	Accumulator = class;
+	Queryable = class;
+	Reader = class;
+	Writer = class;
+	AsyncCalculator = class;
+	Scanner = class;
+	Geometry = class;
+	Series = class;
+	Pool = class;
+	AsyncCalculatorSumCompletion = class;
 
 CalcException = class(Exception)
 public
@@ -36,7 +58,42 @@ private
 	code: Integer;
 end;
 
+	BytePtr = ^Byte;
+	CardinalPtr = ^Cardinal;
 	IntegerPtr = ^Integer;
+	RectanglePtr = ^Rectangle;
+
+{$IFDEF FPC}
+{$PACKRECORDS C}
+{$ENDIF}
+
+	Point = record
+		x: Integer;
+		y: Integer;
+	end;
+
+	Size = record
+		case Integer of
+			0: (
+				width: Cardinal;
+				height: Cardinal
+			);
+			1: (cloopAlignment: Int64);
+	end;
+
+	Header = packed record
+		kind: Byte;
+		length: Cardinal;
+	end;
+
+	Rectangle = record
+		origin: Point;
+		extent: Size;
+	end;
+
+{$IFDEF FPC}
+{$PACKRECORDS DEFAULT}
+{$ENDIF}
 
 	Disposable_disposePtr = procedure(this: Disposable); cdecl;
 	Status_getCodePtr = function(this: Status): Integer; cdecl;
@@ -54,6 +111,35 @@ end;
 	Calculator2_multiplyPtr = function(this: Calculator2; status: Status; n1: Integer; n2: Integer): Integer; cdecl;
 	Calculator2_copyMemoryPtr = procedure(this: Calculator2; calculator: Calculator); cdecl;
 	Calculator2_copyMemory2Ptr = procedure(this: Calculator2; address: IntegerPtr); cdecl;
+	Calculator2_multiplyBatchPtr = procedure(this: Calculator2; status: Status; n1: IntegerPtr; n2: IntegerPtr; results: IntegerPtr; count: Cardinal); cdecl;
+	Counter_disposePtr = procedure(this: Pointer); cdecl;
+	Counter_incrementPtr = function(this: Pointer): Integer; cdecl;
+	Counter_getValuePtr = function(this: Pointer): Integer; cdecl;
+	Counter_addPtr = procedure(this: Pointer; counter: Pointer); cdecl;
+	ReferenceCounted_addRefPtr = procedure(this: ReferenceCounted); cdecl;
+	ReferenceCounted_releasePtr = function(this: ReferenceCounted): Integer; cdecl;
+	Accumulator_addPtr = procedure(this: Accumulator; n: Integer); cdecl;
+	Accumulator_getTotalPtr = function(this: Accumulator): Integer; cdecl;
+	Queryable_queryInterfacePtr = function(this: Queryable; id: Cardinal): Queryable; cdecl;
+	Reader_readPtr = function(this: Reader): Integer; cdecl;
+	Writer_writePtr = procedure(this: Writer; n: Integer); cdecl;
+	AsyncCalculator_sumPtr = function(this: AsyncCalculator; status: Status; n1: Integer; n2: Integer): Integer; cdecl;
+	AsyncCalculator_sumAsyncPtr = procedure(this: AsyncCalculator; status: Status; n1: Integer; n2: Integer; completion: AsyncCalculatorSumCompletion); cdecl;
+	Scanner_countCharPtr = function(this: Scanner; text: CloopStrView; c: Byte): Cardinal; cdecl;
+	Scanner_trimPtr = function(this: Scanner; status: Status; text: CloopStrView): CloopStrView; cdecl;
+	Scanner_checksumPtr = function(this: Scanner; in_: CloopBytes): Cardinal; cdecl;
+	Geometry_movePtr = function(this: Geometry; rectangle: Rectangle; offset: Point): Rectangle; cdecl;
+	Geometry_areaPtr = function(this: Geometry; rectangle: RectanglePtr): Integer; cdecl;
+	Geometry_payloadPtr = function(this: Geometry; header: Header): Cardinal; cdecl;
+	Series_totalPtr = function(this: Series; values: IntegerPtr; count: Cardinal): Integer; cdecl;
+	Series_scalePtr = procedure(this: Series; in_: IntegerPtr; out_: IntegerPtr; count: Cardinal; factor: Integer); cdecl;
+	Series_histogramPtr = function(this: Series; data: BytePtr; counts: CardinalPtr; size: Cardinal; buckets: Cardinal): Cardinal; cdecl;
+	Series_clampPtr = function(this: Series; value: Integer; limit: Integer): Integer; cdecl;
+	Series_clampBatchPtr = procedure(this: Series; value: IntegerPtr; limit: IntegerPtr; results: IntegerPtr; count: Cardinal); cdecl;
+	Pool_keepPtr = procedure(this: Pool; accumulator: Accumulator); cdecl;
+	Pool_setNamePtr = procedure(this: Pool; name: PAnsiChar); cdecl;
+	Pool_totalPtr = function(this: Pool): Integer; cdecl;
+	AsyncCalculatorSumCompletion_completePtr = procedure(this: AsyncCalculatorSumCompletion; status: Status; result: Integer); cdecl;
 
 	DisposableVTable = class
 		version: NativeInt;
@@ -80,6 +166,8 @@ end;
 	end;
 
 	Status = class(Disposable)
+		cloopErrorFlag: Integer;
+
 		const VERSION = 3;
 		const ERROR_1 = Integer(1);
 		const ERROR_2 = Integer($2);
@@ -173,14 +261,17 @@ end;
 		multiply: Calculator2_multiplyPtr;
 		copyMemory: Calculator2_copyMemoryPtr;
 		copyMemory2: Calculator2_copyMemory2Ptr;
+		multiplyBatch: Calculator2_multiplyBatchPtr;
 	end;
 
 	Calculator2 = class(Calculator)
-		const VERSION = 8;
+		const VERSION = 9;
 
 		function multiply(status: Status; n1: Integer; n2: Integer): Integer;
 		procedure copyMemory(calculator: Calculator);
 		procedure copyMemory2(address: IntegerPtr);
+		procedure multiplyBatch(status: Status; n1: IntegerPtr; n2: IntegerPtr; results: IntegerPtr; count: Cardinal); overload;
+		procedure multiplyBatch(status: Status; const n1: array of Integer; const n2: array of Integer; out results: array of Integer); overload;
 	end;
 
 	Calculator2Impl = class(Calculator2)
@@ -194,10 +285,294 @@ end;
 		function multiply(status: Status; n1: Integer; n2: Integer): Integer; virtual; abstract;
 		procedure copyMemory(calculator: Calculator); virtual; abstract;
 		procedure copyMemory2(address: IntegerPtr); virtual; abstract;
+		procedure multiplyBatch(status: Status; n1: IntegerPtr; n2: IntegerPtr; results: IntegerPtr; count: Cardinal); virtual;
+	end;
+
+	CounterVTable = class
+		version: NativeInt;
+		dispose: Counter_disposePtr;
+		increment: Counter_incrementPtr;
+		getValue: Counter_getValuePtr;
+		add: Counter_addPtr;
+	end;
+
+	Counter = class
+		vTable: CounterVTable;
+
+		const VERSION = 4;
+
+		procedure dispose();
+		function increment(): Integer;
+		function getValue(): Integer;
+		procedure add(counter: Counter);
+	end;
+
+	CounterImpl = class(Counter)
+		constructor create;
+
+		procedure dispose(); virtual; abstract;
+		function increment(): Integer; virtual; abstract;
+		function getValue(): Integer; virtual; abstract;
+		procedure add(counter: Counter); virtual; abstract;
+	end;
+
+	ReferenceCountedVTable = class
+		version: NativeInt;
+		addRef: ReferenceCounted_addRefPtr;
+		release: ReferenceCounted_releasePtr;
+	end;
+
+	ReferenceCounted = class
+		vTable: ReferenceCountedVTable;
+
+		const VERSION = 2;
+
+		procedure addRef();
+		function release(): Integer;
+	end;
+
+	ReferenceCountedImpl = class(ReferenceCounted)
+		constructor create;
+
+		procedure addRef(); virtual; abstract;
+		function release(): Integer; virtual; abstract;
+	end;
+
+	AccumulatorVTable = class(ReferenceCountedVTable)
+		add: Accumulator_addPtr;
+		getTotal: Accumulator_getTotalPtr;
+	end;
+
+	Accumulator = class(ReferenceCounted)
+		const VERSION = 4;
+
+		procedure add(n: Integer);
+		function getTotal(): Integer;
+	end;
+
+	AccumulatorImpl = class(Accumulator)
+		constructor create;
+
+		procedure addRef(); virtual; abstract;
+		function release(): Integer; virtual; abstract;
+		procedure add(n: Integer); virtual; abstract;
+		function getTotal(): Integer; virtual; abstract;
+	end;
+
+	QueryableVTable = class(DisposableVTable)
+		queryInterface: Queryable_queryInterfacePtr;
+	end;
+
+	Queryable = class(Disposable)
+		const VERSION = 2;
+
+		function queryInterface(id: Cardinal): Queryable;
+	end;
+
+	QueryableImpl = class(Queryable)
+		constructor create;
+
+		procedure dispose(); virtual; abstract;
+		function queryInterface(id: Cardinal): Queryable; virtual; abstract;
+	end;
+
+	ReaderVTable = class(QueryableVTable)
+		read: Reader_readPtr;
+	end;
+
+	Reader = class(Queryable)
+		const VERSION = 3;
+		const IID = Cardinal($52454144);
+
+		function read(): Integer;
+	end;
+
+	ReaderImpl = class(Reader)
+		constructor create;
+
+		procedure dispose(); virtual; abstract;
+		function queryInterface(id: Cardinal): Queryable; virtual; abstract;
+		function read(): Integer; virtual; abstract;
+	end;
+
+	WriterVTable = class(QueryableVTable)
+		write: Writer_writePtr;
+	end;
+
+	Writer = class(Queryable)
+		const VERSION = 3;
+		const IID = Cardinal($57524954);
+
+		procedure write(n: Integer);
+	end;
+
+	WriterImpl = class(Writer)
+		constructor create;
+
+		procedure dispose(); virtual; abstract;
+		function queryInterface(id: Cardinal): Queryable; virtual; abstract;
+		procedure write(n: Integer); virtual; abstract;
+	end;
+
+	AsyncCalculatorVTable = class(DisposableVTable)
+		sum: AsyncCalculator_sumPtr;
+		sumAsync: AsyncCalculator_sumAsyncPtr;
+	end;
+
+	AsyncCalculator = class(Disposable)
+		const VERSION = 3;
+
+		function sum(status: Status; n1: Integer; n2: Integer): Integer;
+		procedure sumAsync(status: Status; n1: Integer; n2: Integer; completion: AsyncCalculatorSumCompletion);
+	end;
+
+	AsyncCalculatorImpl = class(AsyncCalculator)
+		constructor create;
+
+		procedure dispose(); virtual; abstract;
+		function sum(status: Status; n1: Integer; n2: Integer): Integer; virtual; abstract;
+		procedure sumAsync(status: Status; n1: Integer; n2: Integer; completion: AsyncCalculatorSumCompletion); virtual; abstract;
+	end;
+
+	ScannerVTable = class(DisposableVTable)
+		countChar: Scanner_countCharPtr;
+		trim: Scanner_trimPtr;
+		checksum: Scanner_checksumPtr;
+	end;
+
+	Scanner = class(Disposable)
+		const VERSION = 4;
+
+		function countChar(text: CloopStrView; c: Byte): Cardinal;
+		function trim(status: Status; text: CloopStrView): CloopStrView;
+		function checksum(in_: CloopBytes): Cardinal;
+	end;
+
+	ScannerImpl = class(Scanner)
+		constructor create;
+
+		procedure dispose(); virtual; abstract;
+		function countChar(text: CloopStrView; c: Byte): Cardinal; virtual; abstract;
+		function trim(status: Status; text: CloopStrView): CloopStrView; virtual; abstract;
+		function checksum(in_: CloopBytes): Cardinal; virtual; abstract;
+	end;
+
+	GeometryVTable = class(DisposableVTable)
+		move: Geometry_movePtr;
+		area: Geometry_areaPtr;
+		payload: Geometry_payloadPtr;
+	end;
+
+	Geometry = class(Disposable)
+		const VERSION = 4;
+
+		function move(rectangle: Rectangle; offset: Point): Rectangle;
+		function area(rectangle: RectanglePtr): Integer;
+		function payload(header: Header): Cardinal;
+	end;
+
+	GeometryImpl = class(Geometry)
+		constructor create;
+
+		procedure dispose(); virtual; abstract;
+		function move(rectangle: Rectangle; offset: Point): Rectangle; virtual; abstract;
+		function area(rectangle: RectanglePtr): Integer; virtual; abstract;
+		function payload(header: Header): Cardinal; virtual; abstract;
+	end;
+
+	SeriesVTable = class(DisposableVTable)
+		total: Series_totalPtr;
+		scale: Series_scalePtr;
+		histogram: Series_histogramPtr;
+		clamp: Series_clampPtr;
+		clampBatch: Series_clampBatchPtr;
+	end;
+
+	Series = class(Disposable)
+		const VERSION = 6;
+
+		function total(values: IntegerPtr; count: Cardinal): Integer; overload;
+		function total(const values: array of Integer): Integer; overload;
+		procedure scale(in_: IntegerPtr; out_: IntegerPtr; count: Cardinal; factor: Integer); overload;
+		procedure scale(const in_: array of Integer; out out_: array of Integer; factor: Integer); overload;
+		function histogram(data: BytePtr; counts: CardinalPtr; size: Cardinal; buckets: Cardinal): Cardinal; overload;
+		function histogram(const data: array of Byte; var counts: array of Cardinal): Cardinal; overload;
+		function clamp(value: Integer; limit: Integer): Integer;
+		procedure clampBatch(value: IntegerPtr; limit: IntegerPtr; results: IntegerPtr; count: Cardinal); overload;
+		procedure clampBatch(const value: array of Integer; const limit: array of Integer; out results: array of Integer); overload;
+	end;
+
+	SeriesImpl = class(Series)
+		constructor create;
+
+		procedure dispose(); virtual; abstract;
+		function total(values: IntegerPtr; count: Cardinal): Integer; virtual; abstract;
+		procedure scale(in_: IntegerPtr; out_: IntegerPtr; count: Cardinal; factor: Integer); virtual; abstract;
+		function histogram(data: BytePtr; counts: CardinalPtr; size: Cardinal; buckets: Cardinal): Cardinal; virtual; abstract;
+		function clamp(value: Integer; limit: Integer): Integer; virtual; abstract;
+		procedure clampBatch(value: IntegerPtr; limit: IntegerPtr; results: IntegerPtr; count: Cardinal); virtual;
+	end;
+
+	PoolVTable = class(DisposableVTable)
+		keep: Pool_keepPtr;
+		setName: Pool_setNamePtr;
+		total: Pool_totalPtr;
+	end;
+
+	Pool = class(Disposable)
+		const VERSION = 4;
+
+		procedure keep(accumulator: Accumulator);
+		procedure setName(name: PAnsiChar);
+		function total(): Integer;
+	end;
+
+	PoolImpl = class(Pool)
+		constructor create;
+
+		procedure dispose(); virtual; abstract;
+		procedure keep(accumulator: Accumulator); virtual; abstract;
+		procedure setName(name: PAnsiChar); virtual; abstract;
+		function total(): Integer; virtual; abstract;
+	end;
+
+	AsyncCalculatorSumCompletionVTable = class
+		version: NativeInt;
+		complete: AsyncCalculatorSumCompletion_completePtr;
+	end;
+
+	AsyncCalculatorSumCompletion = class
+		vTable: AsyncCalculatorSumCompletionVTable;
+
+		const VERSION = 1;
+
+		procedure complete(status: Status; result: Integer);
+	end;
+
+	AsyncCalculatorSumCompletionImpl = class(AsyncCalculatorSumCompletion)
+		constructor create;
+
+		procedure complete(status: Status; result: Integer); virtual; abstract;
 	end;
 
 implementation
 
+function cloopCompactObject(ptr: Pointer): Pointer;
+begin
+	if (ptr = nil) then
+		Result := nil
+	else
+		Result := Pointer(NativeInt(ptr) - SizeOf(Pointer));
+end;
+
+function cloopCompactPointer(obj: Pointer): Pointer;
+begin
+	if (obj = nil) then
+		Result := nil
+	else
+		Result := Pointer(NativeInt(obj) + SizeOf(Pointer));
+end;
+
 procedure Disposable.dispose();
 begin
 	DisposableVTable(vTable).dispose(Self);
@@ -226,19 +601,22 @@ end;
 function Factory.createCalculator(status: Status): Calculator;
 begin
 	Result := FactoryVTable(vTable).createCalculator(Self, status);
-	CalcException.checkException(status);
+	if (status.cloopErrorFlag <> 0) then
+		CalcException.checkException(status);
 end;
 
 function Factory.createCalculator2(status: Status): Calculator2;
 begin
 	Result := FactoryVTable(vTable).createCalculator2(Self, status);
-	CalcException.checkException(status);
+	if (status.cloopErrorFlag <> 0) then
+		CalcException.checkException(status);
 end;
 
 function Factory.createBrokenCalculator(status: Status): Calculator;
 begin
 	Result := FactoryVTable(vTable).createBrokenCalculator(Self, status);
-	CalcException.checkException(status);
+	if (status.cloopErrorFlag <> 0) then
+		CalcException.checkException(status);
 end;
 
 procedure Factory.setStatusFactory(statusFactory: StatusFactory);
@@ -249,7 +627,8 @@ end;
 function Calculator.sum(status: Status; n1: Integer; n2: Integer): Integer;
 begin
 	Result := CalculatorVTable(vTable).sum(Self, status, n1, n2);
-	CalcException.checkException(status);
+	if (status.cloopErrorFlag <> 0) then
+		CalcException.checkException(status);
 end;
 
 function Calculator.getMemory(): Integer;
@@ -265,13 +644,15 @@ end;
 procedure Calculator.sumAndStore(status: Status; n1: Integer; n2: Integer);
 begin
 	CalculatorVTable(vTable).sumAndStore(Self, status, n1, n2);
-	CalcException.checkException(status);
+	if (status.cloopErrorFlag <> 0) then
+		CalcException.checkException(status);
 end;
 
 function Calculator2.multiply(status: Status; n1: Integer; n2: Integer): Integer;
 begin
 	Result := Calculator2VTable(vTable).multiply(Self, status, n1, n2);
-	CalcException.checkException(status);
+	if (status.cloopErrorFlag <> 0) then
+		CalcException.checkException(status);
 end;
 
 procedure Calculator2.copyMemory(calculator: Calculator);
@@ -284,182 +665,388 @@ begin
 	Calculator2VTable(vTable).copyMemory2(Self, address);
 end;
 
-procedure DisposableImpl_disposeDispatcher(this: Disposable); cdecl;
+procedure Calculator2.multiplyBatch(status: Status; n1: IntegerPtr; n2: IntegerPtr; results: IntegerPtr; count: Cardinal);
 begin
-	try
-		DisposableImpl(this).dispose();
-	except
-		on e: Exception do CalcException.catchException(nil, e);
-	end
+	Calculator2VTable(vTable).multiplyBatch(Self, status, n1, n2, results, count);
+	if (status.cloopErrorFlag <> 0) then
+		CalcException.checkException(status);
 end;
 
-var
-	DisposableImpl_vTable: DisposableVTable;
+procedure Calculator2.multiplyBatch(status: Status; const n1: array of Integer; const n2: array of Integer; out results: array of Integer);
+begin
+	if (Length(n1) <> Length(results)) then
+		RunError(201);
+	if (Length(n2) <> Length(results)) then
+		RunError(201);
+	if (Length(results) > 0) then
+		multiplyBatch(status, @n1[0], @n2[0], @results[0], Length(results));
+end;
 
-constructor DisposableImpl.create;
+procedure Counter.dispose();
 begin
-	vTable := DisposableImpl_vTable;
+	CounterVTable(cloopCompactObject(Pointer(vTable))).dispose(cloopCompactPointer(Pointer(Self)));
 end;
 
-procedure StatusImpl_disposeDispatcher(this: Status); cdecl;
+function Counter.increment(): Integer;
 begin
-	try
-		StatusImpl(this).dispose();
-	except
-		on e: Exception do CalcException.catchException(nil, e);
-	end
+	Result := CounterVTable(cloopCompactObject(Pointer(vTable))).increment(cloopCompactPointer(Pointer(Self)));
 end;
 
-function StatusImpl_getCodeDispatcher(this: Status): Integer; cdecl;
+function Counter.getValue(): Integer;
 begin
-	try
-		Result := StatusImpl(this).getCode();
-	except
-		on e: Exception do CalcException.catchException(nil, e);
-	end
+	Result := CounterVTable(cloopCompactObject(Pointer(vTable))).getValue(cloopCompactPointer(Pointer(Self)));
 end;
 
-procedure StatusImpl_setCodeDispatcher(this: Status; code: Integer); cdecl;
+procedure Counter.add(counter: Counter);
 begin
-	try
-		StatusImpl(this).setCode(code);
-	except
-		on e: Exception do CalcException.catchException(nil, e);
-	end
+	CounterVTable(cloopCompactObject(Pointer(vTable))).add(cloopCompactPointer(Pointer(Self)), cloopCompactPointer(Pointer(counter)));
 end;
 
-var
-	StatusImpl_vTable: StatusVTable;
+procedure ReferenceCounted.addRef();
+begin
+	ReferenceCountedVTable(vTable).addRef(Self);
+end;
 
-constructor StatusImpl.create;
+function ReferenceCounted.release(): Integer;
 begin
-	vTable := StatusImpl_vTable;
+	Result := ReferenceCountedVTable(vTable).release(Self);
 end;
 
-procedure StatusFactoryImpl_disposeDispatcher(this: StatusFactory); cdecl;
+procedure Accumulator.add(n: Integer);
 begin
-	try
-		StatusFactoryImpl(this).dispose();
-	except
-		on e: Exception do CalcException.catchException(nil, e);
-	end
+	AccumulatorVTable(vTable).add(Self, n);
 end;
 
-function StatusFactoryImpl_createStatusDispatcher(this: StatusFactory): Status; cdecl;
+function Accumulator.getTotal(): Integer;
 begin
-	try
-		Result := StatusFactoryImpl(this).createStatus();
-	except
-		on e: Exception do CalcException.catchException(nil, e);
-	end
+	Result := AccumulatorVTable(vTable).getTotal(Self);
 end;
 
-var
-	StatusFactoryImpl_vTable: StatusFactoryVTable;
+function Queryable.queryInterface(id: Cardinal): Queryable;
+begin
+	Result := QueryableVTable(vTable).queryInterface(Self, id);
+end;
 
-constructor StatusFactoryImpl.create;
+function Reader.read(): Integer;
 begin
-	vTable := StatusFactoryImpl_vTable;
+	Result := ReaderVTable(vTable).read(Self);
 end;
 
-procedure FactoryImpl_disposeDispatcher(this: Factory); cdecl;
+procedure Writer.write(n: Integer);
 begin
-	try
-		FactoryImpl(this).dispose();
-	except
-		on e: Exception do CalcException.catchException(nil, e);
-	end
+	WriterVTable(vTable).write(Self, n);
 end;
 
-function FactoryImpl_createStatusDispatcher(this: Factory): Status; cdecl;
+function AsyncCalculator.sum(status: Status; n1: Integer; n2: Integer): Integer;
 begin
-	try
-		Result := FactoryImpl(this).createStatus();
-	except
-		on e: Exception do CalcException.catchException(nil, e);
-	end
+	Result := AsyncCalculatorVTable(vTable).sum(Self, status, n1, n2);
+	if (status.cloopErrorFlag <> 0) then
+		CalcException.checkException(status);
 end;
 
-function FactoryImpl_createCalculatorDispatcher(this: Factory; status: Status): Calculator; cdecl;
+procedure AsyncCalculator.sumAsync(status: Status; n1: Integer; n2: Integer; completion: AsyncCalculatorSumCompletion);
 begin
-	try
-		Result := FactoryImpl(this).createCalculator(status);
-	except
-		on e: Exception do CalcException.catchException(status, e);
-	end
+	AsyncCalculatorVTable(vTable).sumAsync(Self, status, n1, n2, completion);
+	if (status.cloopErrorFlag <> 0) then
+		CalcException.checkException(status);
 end;
 
-function FactoryImpl_createCalculator2Dispatcher(this: Factory; status: Status): Calculator2; cdecl;
+function Scanner.countChar(text: CloopStrView; c: Byte): Cardinal;
 begin
-	try
-		Result := FactoryImpl(this).createCalculator2(status);
-	except
-		on e: Exception do CalcException.catchException(status, e);
-	end
+	Result := ScannerVTable(vTable).countChar(Self, text, c);
 end;
 
-function FactoryImpl_createBrokenCalculatorDispatcher(this: Factory; status: Status): Calculator; cdecl;
+function Scanner.trim(status: Status; text: CloopStrView): CloopStrView;
 begin
-	try
-		Result := FactoryImpl(this).createBrokenCalculator(status);
-	except
-		on e: Exception do CalcException.catchException(status, e);
-	end
+	Result := ScannerVTable(vTable).trim(Self, status, text);
+	if (status.cloopErrorFlag <> 0) then
+		CalcException.checkException(status);
 end;
 
-procedure FactoryImpl_setStatusFactoryDispatcher(this: Factory; statusFactory: StatusFactory); cdecl;
+function Scanner.checksum(in_: CloopBytes): Cardinal;
 begin
-	try
-		FactoryImpl(this).setStatusFactory(statusFactory);
-	except
-		on e: Exception do CalcException.catchException(nil, e);
-	end
+	Result := ScannerVTable(vTable).checksum(Self, in_);
 end;
 
-var
-	FactoryImpl_vTable: FactoryVTable;
+function Geometry.move(rectangle: Rectangle; offset: Point): Rectangle;
+begin
+	Result := GeometryVTable(vTable).move(Self, rectangle, offset);
+end;
 
-constructor FactoryImpl.create;
+function Geometry.area(rectangle: RectanglePtr): Integer;
 begin
-	vTable := FactoryImpl_vTable;
+	Result := GeometryVTable(vTable).area(Self, rectangle);
 end;
 
-procedure CalculatorImpl_disposeDispatcher(this: Calculator); cdecl;
+function Geometry.payload(header: Header): Cardinal;
 begin
-	try
-		CalculatorImpl(this).dispose();
+	Result := GeometryVTable(vTable).payload(Self, header);
+end;
+
+function Series.total(values: IntegerPtr; count: Cardinal): Integer;
+begin
+	Result := SeriesVTable(vTable).total(Self, values, count);
+end;
+
+function Series.total(const values: array of Integer): Integer;
+begin
+	Result := total(@values, Length(values));
+end;
+
+procedure Series.scale(in_: IntegerPtr; out_: IntegerPtr; count: Cardinal; factor: Integer);
+begin
+	SeriesVTable(vTable).scale(Self, in_, out_, count, factor);
+end;
+
+procedure Series.scale(const in_: array of Integer; out out_: array of Integer; factor: Integer);
+begin
+	if (Length(out_) <> Length(in_)) then
+		RunError(201);
+	scale(@in_, @out_, Length(in_), factor);
+end;
+
+function Series.histogram(data: BytePtr; counts: CardinalPtr; size: Cardinal; buckets: Cardinal): Cardinal;
+begin
+	Result := SeriesVTable(vTable).histogram(Self, data, counts, size, buckets);
+end;
+
+function Series.histogram(const data: array of Byte; var counts: array of Cardinal): Cardinal;
+begin
+	Result := histogram(@data, @counts, Length(data), Length(counts));
+end;
+
+function Series.clamp(value: Integer; limit: Integer): Integer;
+begin
+	Result := SeriesVTable(vTable).clamp(Self, value, limit);
+end;
+
+procedure Series.clampBatch(value: IntegerPtr; limit: IntegerPtr; results: IntegerPtr; count: Cardinal);
+begin
+	SeriesVTable(vTable).clampBatch(Self, value, limit, results, count);
+end;
+
+procedure Series.clampBatch(const value: array of Integer; const limit: array of Integer; out results: array of Integer);
+begin
+	if (Length(value) <> Length(results)) then
+		RunError(201);
+	if (Length(limit) <> Length(results)) then
+		RunError(201);
+	if (Length(results) > 0) then
+		clampBatch(@value[0], @limit[0], @results[0], Length(results));
+end;
+
+procedure Pool.keep(accumulator: Accumulator);
+begin
+	PoolVTable(vTable).keep(Self, accumulator);
+end;
+
+procedure Pool.setName(name: PAnsiChar);
+begin
+	PoolVTable(vTable).setName(Self, name);
+end;
+
+function Pool.total(): Integer;
+begin
+	Result := PoolVTable(vTable).total(Self);
+end;
+
+procedure AsyncCalculatorSumCompletion.complete(status: Status; result: Integer);
+begin
+	AsyncCalculatorSumCompletionVTable(vTable).complete(Self, status, result);
+end;
+
+procedure Calculator2Impl.multiplyBatch(status: Status; n1: IntegerPtr; n2: IntegerPtr; results: IntegerPtr; count: Cardinal);
+var
+	cloopIndex: Cardinal;
+begin
+	cloopIndex := 0;
+
+	while (cloopIndex < count) do
+	begin
+		results^ := multiply(status, n1^, n2^);
+		Inc(n1);
+		Inc(n2);
+		Inc(results);
+		Inc(cloopIndex);
+	end;
+end;
+
+procedure SeriesImpl.clampBatch(value: IntegerPtr; limit: IntegerPtr; results: IntegerPtr; count: Cardinal);
+var
+	cloopIndex: Cardinal;
+begin
+	cloopIndex := 0;
+
+	while (cloopIndex < count) do
+	begin
+		results^ := clamp(value^, limit^);
+		Inc(value);
+		Inc(limit);
+		Inc(results);
+		Inc(cloopIndex);
+	end;
+end;
+
+procedure DisposableImpl_disposeDispatcher(this: Disposable); cdecl;
+begin
+	try
+		DisposableImpl(this).dispose();
 	except
 		on e: Exception do CalcException.catchException(nil, e);
 	end
 end;
 
-function CalculatorImpl_sumDispatcher(this: Calculator; status: Status; n1: Integer; n2: Integer): Integer; cdecl;
+var
+	DisposableImpl_vTable: DisposableVTable;
+
+constructor DisposableImpl.create;
+begin
+	vTable := DisposableImpl_vTable;
+end;
+
+procedure StatusImpl_disposeDispatcher(this: Status); cdecl;
 begin
 	try
-		Result := CalculatorImpl(this).sum(status, n1, n2);
+		StatusImpl(this).dispose();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function StatusImpl_getCodeDispatcher(this: Status): Integer; cdecl;
+begin
+	Result := StatusImpl(this).getCode();
+end;
+
+procedure StatusImpl_setCodeDispatcher(this: Status; code: Integer); cdecl;
+begin
+	StatusImpl(this).setCode(code);
+end;
+
+var
+	StatusImpl_vTable: StatusVTable;
+
+constructor StatusImpl.create;
+begin
+	vTable := StatusImpl_vTable;
+end;
+
+procedure StatusFactoryImpl_disposeDispatcher(this: StatusFactory); cdecl;
+begin
+	try
+		StatusFactoryImpl(this).dispose();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function StatusFactoryImpl_createStatusDispatcher(this: StatusFactory): Status; cdecl;
+begin
+	try
+		Result := StatusFactoryImpl(this).createStatus();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+var
+	StatusFactoryImpl_vTable: StatusFactoryVTable;
+
+constructor StatusFactoryImpl.create;
+begin
+	vTable := StatusFactoryImpl_vTable;
+end;
+
+procedure FactoryImpl_disposeDispatcher(this: Factory); cdecl;
+begin
+	try
+		FactoryImpl(this).dispose();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function FactoryImpl_createStatusDispatcher(this: Factory): Status; cdecl;
+begin
+	try
+		Result := FactoryImpl(this).createStatus();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function FactoryImpl_createCalculatorDispatcher(this: Factory; status: Status): Calculator; cdecl;
+begin
+	try
+		Result := FactoryImpl(this).createCalculator(status);
 	except
 		on e: Exception do CalcException.catchException(status, e);
 	end
 end;
 
-function CalculatorImpl_getMemoryDispatcher(this: Calculator): Integer; cdecl;
+function FactoryImpl_createCalculator2Dispatcher(this: Factory; status: Status): Calculator2; cdecl;
+begin
+	try
+		Result := FactoryImpl(this).createCalculator2(status);
+	except
+		on e: Exception do CalcException.catchException(status, e);
+	end
+end;
+
+function FactoryImpl_createBrokenCalculatorDispatcher(this: Factory; status: Status): Calculator; cdecl;
+begin
+	try
+		Result := FactoryImpl(this).createBrokenCalculator(status);
+	except
+		on e: Exception do CalcException.catchException(status, e);
+	end
+end;
+
+procedure FactoryImpl_setStatusFactoryDispatcher(this: Factory; statusFactory: StatusFactory); cdecl;
 begin
 	try
-		Result := CalculatorImpl(this).getMemory();
+		FactoryImpl(this).setStatusFactory(statusFactory);
 	except
 		on e: Exception do CalcException.catchException(nil, e);
 	end
 end;
 
-procedure CalculatorImpl_setMemoryDispatcher(this: Calculator; n: Integer); cdecl;
+var
+	FactoryImpl_vTable: FactoryVTable;
+
+constructor FactoryImpl.create;
+begin
+	vTable := FactoryImpl_vTable;
+end;
+
+procedure CalculatorImpl_disposeDispatcher(this: Calculator); cdecl;
 begin
 	try
-		CalculatorImpl(this).setMemory(n);
+		CalculatorImpl(this).dispose();
 	except
 		on e: Exception do CalcException.catchException(nil, e);
 	end
 end;
 
+function CalculatorImpl_sumDispatcher(this: Calculator; status: Status; n1: Integer; n2: Integer): Integer; cdecl;
+begin
+	try
+		Result := CalculatorImpl(this).sum(status, n1, n2);
+	except
+		on e: Exception do CalcException.catchException(status, e);
+	end
+end;
+
+function CalculatorImpl_getMemoryDispatcher(this: Calculator): Integer; cdecl;
+begin
+	Result := CalculatorImpl(this).getMemory();
+end;
+
+procedure CalculatorImpl_setMemoryDispatcher(this: Calculator; n: Integer); cdecl;
+begin
+	CalculatorImpl(this).setMemory(n);
+end;
+
 procedure CalculatorImpl_sumAndStoreDispatcher(this: Calculator; status: Status; n1: Integer; n2: Integer); cdecl;
 begin
 	try
@@ -497,20 +1084,12 @@ end;
 
 function Calculator2Impl_getMemoryDispatcher(this: Calculator2): Integer; cdecl;
 begin
-	try
-		Result := Calculator2Impl(this).getMemory();
-	except
-		on e: Exception do CalcException.catchException(nil, e);
-	end
+	Result := Calculator2Impl(this).getMemory();
 end;
 
 procedure Calculator2Impl_setMemoryDispatcher(this: Calculator2; n: Integer); cdecl;
 begin
-	try
-		Calculator2Impl(this).setMemory(n);
-	except
-		on e: Exception do CalcException.catchException(nil, e);
-	end
+	Calculator2Impl(this).setMemory(n);
 end;
 
 procedure Calculator2Impl_sumAndStoreDispatcher(this: Calculator2; status: Status; n1: Integer; n2: Integer); cdecl;
@@ -549,6 +1128,15 @@ begin
 	end
 end;
 
+procedure Calculator2Impl_multiplyBatchDispatcher(this: Calculator2; status: Status; n1: IntegerPtr; n2: IntegerPtr; results: IntegerPtr; count: Cardinal); cdecl;
+begin
+	try
+		Calculator2Impl(this).multiplyBatch(status, n1, n2, results, count);
+	except
+		on e: Exception do CalcException.catchException(status, e);
+	end
+end;
+
 var
 	Calculator2Impl_vTable: Calculator2VTable;
 
@@ -557,6 +1145,458 @@ begin
 	vTable := Calculator2Impl_vTable;
 end;
 
+procedure CounterImpl_disposeDispatcher(this: Pointer); cdecl;
+begin
+	try
+		CounterImpl(cloopCompactObject(this)).dispose();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function CounterImpl_incrementDispatcher(this: Pointer): Integer; cdecl;
+begin
+	try
+		Result := CounterImpl(cloopCompactObject(this)).increment();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function CounterImpl_getValueDispatcher(this: Pointer): Integer; cdecl;
+begin
+	try
+		Result := CounterImpl(cloopCompactObject(this)).getValue();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+procedure CounterImpl_addDispatcher(this: Pointer; counter: Pointer); cdecl;
+begin
+	try
+		CounterImpl(cloopCompactObject(this)).add(Counter(cloopCompactObject(counter)));
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+var
+	CounterImpl_vTable: CounterVTable;
+
+constructor CounterImpl.create;
+begin
+	vTable := CounterVTable(cloopCompactPointer(Pointer(CounterImpl_vTable)));
+end;
+
+procedure ReferenceCountedImpl_addRefDispatcher(this: ReferenceCounted); cdecl;
+begin
+	try
+		ReferenceCountedImpl(this).addRef();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function ReferenceCountedImpl_releaseDispatcher(this: ReferenceCounted): Integer; cdecl;
+begin
+	try
+		Result := ReferenceCountedImpl(this).release();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+var
+	ReferenceCountedImpl_vTable: ReferenceCountedVTable;
+
+constructor ReferenceCountedImpl.create;
+begin
+	vTable := ReferenceCountedImpl_vTable;
+end;
+
+procedure AccumulatorImpl_addRefDispatcher(this: Accumulator); cdecl;
+begin
+	try
+		AccumulatorImpl(this).addRef();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function AccumulatorImpl_releaseDispatcher(this: Accumulator): Integer; cdecl;
+begin
+	try
+		Result := AccumulatorImpl(this).release();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+procedure AccumulatorImpl_addDispatcher(this: Accumulator; n: Integer); cdecl;
+begin
+	try
+		AccumulatorImpl(this).add(n);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function AccumulatorImpl_getTotalDispatcher(this: Accumulator): Integer; cdecl;
+begin
+	try
+		Result := AccumulatorImpl(this).getTotal();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+var
+	AccumulatorImpl_vTable: AccumulatorVTable;
+
+constructor AccumulatorImpl.create;
+begin
+	vTable := AccumulatorImpl_vTable;
+end;
+
+procedure QueryableImpl_disposeDispatcher(this: Queryable); cdecl;
+begin
+	try
+		QueryableImpl(this).dispose();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function QueryableImpl_queryInterfaceDispatcher(this: Queryable; id: Cardinal): Queryable; cdecl;
+begin
+	try
+		Result := QueryableImpl(this).queryInterface(id);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+var
+	QueryableImpl_vTable: QueryableVTable;
+
+constructor QueryableImpl.create;
+begin
+	vTable := QueryableImpl_vTable;
+end;
+
+procedure ReaderImpl_disposeDispatcher(this: Reader); cdecl;
+begin
+	try
+		ReaderImpl(this).dispose();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function ReaderImpl_queryInterfaceDispatcher(this: Reader; id: Cardinal): Queryable; cdecl;
+begin
+	try
+		Result := ReaderImpl(this).queryInterface(id);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function ReaderImpl_readDispatcher(this: Reader): Integer; cdecl;
+begin
+	try
+		Result := ReaderImpl(this).read();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+var
+	ReaderImpl_vTable: ReaderVTable;
+
+constructor ReaderImpl.create;
+begin
+	vTable := ReaderImpl_vTable;
+end;
+
+procedure WriterImpl_disposeDispatcher(this: Writer); cdecl;
+begin
+	try
+		WriterImpl(this).dispose();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function WriterImpl_queryInterfaceDispatcher(this: Writer; id: Cardinal): Queryable; cdecl;
+begin
+	try
+		Result := WriterImpl(this).queryInterface(id);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+procedure WriterImpl_writeDispatcher(this: Writer; n: Integer); cdecl;
+begin
+	try
+		WriterImpl(this).write(n);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+var
+	WriterImpl_vTable: WriterVTable;
+
+constructor WriterImpl.create;
+begin
+	vTable := WriterImpl_vTable;
+end;
+
+procedure AsyncCalculatorImpl_disposeDispatcher(this: AsyncCalculator); cdecl;
+begin
+	try
+		AsyncCalculatorImpl(this).dispose();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function AsyncCalculatorImpl_sumDispatcher(this: AsyncCalculator; status: Status; n1: Integer; n2: Integer): Integer; cdecl;
+begin
+	try
+		Result := AsyncCalculatorImpl(this).sum(status, n1, n2);
+	except
+		on e: Exception do CalcException.catchException(status, e);
+	end
+end;
+
+procedure AsyncCalculatorImpl_sumAsyncDispatcher(this: AsyncCalculator; status: Status; n1: Integer; n2: Integer; completion: AsyncCalculatorSumCompletion); cdecl;
+begin
+	try
+		AsyncCalculatorImpl(this).sumAsync(status, n1, n2, completion);
+	except
+		on e: Exception do CalcException.catchException(status, e);
+	end
+end;
+
+var
+	AsyncCalculatorImpl_vTable: AsyncCalculatorVTable;
+
+constructor AsyncCalculatorImpl.create;
+begin
+	vTable := AsyncCalculatorImpl_vTable;
+end;
+
+procedure ScannerImpl_disposeDispatcher(this: Scanner); cdecl;
+begin
+	try
+		ScannerImpl(this).dispose();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function ScannerImpl_countCharDispatcher(this: Scanner; text: CloopStrView; c: Byte): Cardinal; cdecl;
+begin
+	try
+		Result := ScannerImpl(this).countChar(text, c);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function ScannerImpl_trimDispatcher(this: Scanner; status: Status; text: CloopStrView): CloopStrView; cdecl;
+begin
+	try
+		Result := ScannerImpl(this).trim(status, text);
+	except
+		on e: Exception do CalcException.catchException(status, e);
+	end
+end;
+
+function ScannerImpl_checksumDispatcher(this: Scanner; in_: CloopBytes): Cardinal; cdecl;
+begin
+	try
+		Result := ScannerImpl(this).checksum(in_);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+var
+	ScannerImpl_vTable: ScannerVTable;
+
+constructor ScannerImpl.create;
+begin
+	vTable := ScannerImpl_vTable;
+end;
+
+procedure GeometryImpl_disposeDispatcher(this: Geometry); cdecl;
+begin
+	try
+		GeometryImpl(this).dispose();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function GeometryImpl_moveDispatcher(this: Geometry; rectangle: Rectangle; offset: Point): Rectangle; cdecl;
+begin
+	try
+		Result := GeometryImpl(this).move(rectangle, offset);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function GeometryImpl_areaDispatcher(this: Geometry; rectangle: RectanglePtr): Integer; cdecl;
+begin
+	try
+		Result := GeometryImpl(this).area(rectangle);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function GeometryImpl_payloadDispatcher(this: Geometry; header: Header): Cardinal; cdecl;
+begin
+	try
+		Result := GeometryImpl(this).payload(header);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+var
+	GeometryImpl_vTable: GeometryVTable;
+
+constructor GeometryImpl.create;
+begin
+	vTable := GeometryImpl_vTable;
+end;
+
+procedure SeriesImpl_disposeDispatcher(this: Series); cdecl;
+begin
+	try
+		SeriesImpl(this).dispose();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function SeriesImpl_totalDispatcher(this: Series; values: IntegerPtr; count: Cardinal): Integer; cdecl;
+begin
+	try
+		Result := SeriesImpl(this).total(values, count);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+procedure SeriesImpl_scaleDispatcher(this: Series; in_: IntegerPtr; out_: IntegerPtr; count: Cardinal; factor: Integer); cdecl;
+begin
+	try
+		SeriesImpl(this).scale(in_, out_, count, factor);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function SeriesImpl_histogramDispatcher(this: Series; data: BytePtr; counts: CardinalPtr; size: Cardinal; buckets: Cardinal): Cardinal; cdecl;
+begin
+	try
+		Result := SeriesImpl(this).histogram(data, counts, size, buckets);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function SeriesImpl_clampDispatcher(this: Series; value: Integer; limit: Integer): Integer; cdecl;
+begin
+	try
+		Result := SeriesImpl(this).clamp(value, limit);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+procedure SeriesImpl_clampBatchDispatcher(this: Series; value: IntegerPtr; limit: IntegerPtr; results: IntegerPtr; count: Cardinal); cdecl;
+begin
+	try
+		SeriesImpl(this).clampBatch(value, limit, results, count);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+var
+	SeriesImpl_vTable: SeriesVTable;
+
+constructor SeriesImpl.create;
+begin
+	vTable := SeriesImpl_vTable;
+end;
+
+procedure PoolImpl_disposeDispatcher(this: Pool); cdecl;
+begin
+	try
+		PoolImpl(this).dispose();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+procedure PoolImpl_keepDispatcher(this: Pool; accumulator: Accumulator); cdecl;
+begin
+	try
+		PoolImpl(this).keep(accumulator);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+procedure PoolImpl_setNameDispatcher(this: Pool; name: PAnsiChar); cdecl;
+begin
+	try
+		PoolImpl(this).setName(name);
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+function PoolImpl_totalDispatcher(this: Pool): Integer; cdecl;
+begin
+	try
+		Result := PoolImpl(this).total();
+	except
+		on e: Exception do CalcException.catchException(nil, e);
+	end
+end;
+
+var
+	PoolImpl_vTable: PoolVTable;
+
+constructor PoolImpl.create;
+begin
+	vTable := PoolImpl_vTable;
+end;
+
+procedure AsyncCalculatorSumCompletionImpl_completeDispatcher(this: AsyncCalculatorSumCompletion; status: Status; result: Integer); cdecl;
+begin
+	AsyncCalculatorSumCompletionImpl(this).complete(status, result);
+end;
+
+var
+	AsyncCalculatorSumCompletionImpl_vTable: AsyncCalculatorSumCompletionVTable;
+
+constructor AsyncCalculatorSumCompletionImpl.create;
+begin
+	vTable := AsyncCalculatorSumCompletionImpl_vTable;
+end;
+
 constructor CalcException.create(code: Integer);
 begin
 	self.code := code;
@@ -618,7 +1658,7 @@ initialization
 	CalculatorImpl_vTable.sumAndStore := @CalculatorImpl_sumAndStoreDispatcher;
 
 	Calculator2Impl_vTable := Calculator2VTable.create;
-	Calculator2Impl_vTable.version := 8;
+	Calculator2Impl_vTable.version := 9;
 	Calculator2Impl_vTable.dispose := @Calculator2Impl_disposeDispatcher;
 	Calculator2Impl_vTable.sum := @Calculator2Impl_sumDispatcher;
 	Calculator2Impl_vTable.getMemory := @Calculator2Impl_getMemoryDispatcher;
@@ -627,6 +1667,83 @@ initialization
 	Calculator2Impl_vTable.multiply := @Calculator2Impl_multiplyDispatcher;
 	Calculator2Impl_vTable.copyMemory := @Calculator2Impl_copyMemoryDispatcher;
 	Calculator2Impl_vTable.copyMemory2 := @Calculator2Impl_copyMemory2Dispatcher;
+	Calculator2Impl_vTable.multiplyBatch := @Calculator2Impl_multiplyBatchDispatcher;
+
+	CounterImpl_vTable := CounterVTable.create;
+	CounterImpl_vTable.version := 4;
+	CounterImpl_vTable.dispose := @CounterImpl_disposeDispatcher;
+	CounterImpl_vTable.increment := @CounterImpl_incrementDispatcher;
+	CounterImpl_vTable.getValue := @CounterImpl_getValueDispatcher;
+	CounterImpl_vTable.add := @CounterImpl_addDispatcher;
+
+	ReferenceCountedImpl_vTable := ReferenceCountedVTable.create;
+	ReferenceCountedImpl_vTable.version := 2;
+	ReferenceCountedImpl_vTable.addRef := @ReferenceCountedImpl_addRefDispatcher;
+	ReferenceCountedImpl_vTable.release := @ReferenceCountedImpl_releaseDispatcher;
+
+	AccumulatorImpl_vTable := AccumulatorVTable.create;
+	AccumulatorImpl_vTable.version := 4;
+	AccumulatorImpl_vTable.addRef := @AccumulatorImpl_addRefDispatcher;
+	AccumulatorImpl_vTable.release := @AccumulatorImpl_releaseDispatcher;
+	AccumulatorImpl_vTable.add := @AccumulatorImpl_addDispatcher;
+	AccumulatorImpl_vTable.getTotal := @AccumulatorImpl_getTotalDispatcher;
+
+	QueryableImpl_vTable := QueryableVTable.create;
+	QueryableImpl_vTable.version := 2;
+	QueryableImpl_vTable.dispose := @QueryableImpl_disposeDispatcher;
+	QueryableImpl_vTable.queryInterface := @QueryableImpl_queryInterfaceDispatcher;
+
+	ReaderImpl_vTable := ReaderVTable.create;
+	ReaderImpl_vTable.version := 3;
+	ReaderImpl_vTable.dispose := @ReaderImpl_disposeDispatcher;
+	ReaderImpl_vTable.queryInterface := @ReaderImpl_queryInterfaceDispatcher;
+	ReaderImpl_vTable.read := @ReaderImpl_readDispatcher;
+
+	WriterImpl_vTable := WriterVTable.create;
+	WriterImpl_vTable.version := 3;
+	WriterImpl_vTable.dispose := @WriterImpl_disposeDispatcher;
+	WriterImpl_vTable.queryInterface := @WriterImpl_queryInterfaceDispatcher;
+	WriterImpl_vTable.write := @WriterImpl_writeDispatcher;
+
+	AsyncCalculatorImpl_vTable := AsyncCalculatorVTable.create;
+	AsyncCalculatorImpl_vTable.version := 3;
+	AsyncCalculatorImpl_vTable.dispose := @AsyncCalculatorImpl_disposeDispatcher;
+	AsyncCalculatorImpl_vTable.sum := @AsyncCalculatorImpl_sumDispatcher;
+	AsyncCalculatorImpl_vTable.sumAsync := @AsyncCalculatorImpl_sumAsyncDispatcher;
+
+	ScannerImpl_vTable := ScannerVTable.create;
+	ScannerImpl_vTable.version := 4;
+	ScannerImpl_vTable.dispose := @ScannerImpl_disposeDispatcher;
+	ScannerImpl_vTable.countChar := @ScannerImpl_countCharDispatcher;
+	ScannerImpl_vTable.trim := @ScannerImpl_trimDispatcher;
+	ScannerImpl_vTable.checksum := @ScannerImpl_checksumDispatcher;
+
+	GeometryImpl_vTable := GeometryVTable.create;
+	GeometryImpl_vTable.version := 4;
+	GeometryImpl_vTable.dispose := @GeometryImpl_disposeDispatcher;
+	GeometryImpl_vTable.move := @GeometryImpl_moveDispatcher;
+	GeometryImpl_vTable.area := @GeometryImpl_areaDispatcher;
+	GeometryImpl_vTable.payload := @GeometryImpl_payloadDispatcher;
+
+	SeriesImpl_vTable := SeriesVTable.create;
+	SeriesImpl_vTable.version := 6;
+	SeriesImpl_vTable.dispose := @SeriesImpl_disposeDispatcher;
+	SeriesImpl_vTable.total := @SeriesImpl_totalDispatcher;
+	SeriesImpl_vTable.scale := @SeriesImpl_scaleDispatcher;
+	SeriesImpl_vTable.histogram := @SeriesImpl_histogramDispatcher;
+	SeriesImpl_vTable.clamp := @SeriesImpl_clampDispatcher;
+	SeriesImpl_vTable.clampBatch := @SeriesImpl_clampBatchDispatcher;
+
+	PoolImpl_vTable := PoolVTable.create;
+	PoolImpl_vTable.version := 4;
+	PoolImpl_vTable.dispose := @PoolImpl_disposeDispatcher;
+	PoolImpl_vTable.keep := @PoolImpl_keepDispatcher;
+	PoolImpl_vTable.setName := @PoolImpl_setNameDispatcher;
+	PoolImpl_vTable.total := @PoolImpl_totalDispatcher;
+
+	AsyncCalculatorSumCompletionImpl_vTable := AsyncCalculatorSumCompletionVTable.create;
+	AsyncCalculatorSumCompletionImpl_vTable.version := 1;
+	AsyncCalculatorSumCompletionImpl_vTable.complete := @AsyncCalculatorSumCompletionImpl_completeDispatcher;
 
 finalization
 	DisposableImpl_vTable.destroy;
@@ -635,5 +1752,17 @@ finalization
 	FactoryImpl_vTable.destroy;
 	CalculatorImpl_vTable.destroy;
 	Calculator2Impl_vTable.destroy;
+	CounterImpl_vTable.destroy;
+	ReferenceCountedImpl_vTable.destroy;
+	AccumulatorImpl_vTable.destroy;
+	QueryableImpl_vTable.destroy;
+	ReaderImpl_vTable.destroy;
+	WriterImpl_vTable.destroy;
+	AsyncCalculatorImpl_vTable.destroy;
+	ScannerImpl_vTable.destroy;
+	GeometryImpl_vTable.destroy;
+	SeriesImpl_vTable.destroy;
+	PoolImpl_vTable.destroy;
+	AsyncCalculatorSumCompletionImpl_vTable.destroy;
 
 end.
@@ -0,0 +1,448 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by Adriano dos Santos Fernandes.
+ *
+ *  Copyright (c) 2014 Adriano dos Santos Fernandes <adrianosf at gmail.com>
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+// Measures the per-call cost of ICalculator::sum with the classic status protocol and
+// with LightStatusTraits, and the cost of creating and disposing status objects with the
+// default allocator and with a pool allocator.
+
+#include <stdint.h>
+#include "CalcCppApi.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+//--------------------------------------
+
+// CalcException
+
+
+class CalcException
+{
+public:
+	CalcException(int code)
+		: code(code)
+	{
+	}
+
+	CalcException(calc::IStatus* status)
+		: code(status->getCode())
+	{
+	}
+
+public:
+	int code;
+};
+
+
+//--------------------------------------
+
+// LocalStatus
+
+
+// Status owned by the caller, keeping its own code so it's known to be dirty without a call.
+class LocalStatus : public calc::IStatusImpl<LocalStatus, LocalStatus>
+{
+public:
+	LocalStatus()
+		: code(0)
+	{
+	}
+
+	virtual void dispose()
+	{
+	}
+
+	virtual int getCode() const
+	{
+		return code;
+	}
+
+	virtual void setCode(int code)
+	{
+		this->code = code;
+		this->cloopErrorFlag = code != 0;
+	}
+
+	static bool isDirty(LocalStatus* status)
+	{
+		return status->code != 0;
+	}
+
+	static void clearException(LocalStatus* status)
+	{
+		status->setCode(0);
+	}
+
+	static void checkException(LocalStatus* status)
+	{
+		if (status->code != 0)
+			throw CalcException(status->code);
+	}
+
+	static void catchException(LocalStatus* status)
+	{
+		abort();
+	}
+
+	static void setVersionError(LocalStatus* status, const char* /*interfaceName*/,
+		unsigned /*currentVersion*/, unsigned /*expectedVersion*/)
+	{
+		status->setCode(calc::IStatus::ERROR_1);
+	}
+
+private:
+	int code;
+};
+
+
+//--------------------------------------
+
+// ClassicStatus
+
+
+// Wrapper constructed by the dispatchers for every call, as in CppTest.
+class ClassicStatus : public calc::IStatusImpl<ClassicStatus, ClassicStatus>
+{
+public:
+	ClassicStatus(calc::IStatus* delegate)
+		: delegate(delegate),
+		  code(0)
+	{
+	}
+
+	virtual void dispose()
+	{
+	}
+
+	virtual int getCode() const
+	{
+		return code;
+	}
+
+	virtual void setCode(int code)
+	{
+		this->code = code;
+		this->cloopErrorFlag = code != 0;
+		delegate->setCode(code);
+	}
+
+	static void clearException(ClassicStatus* status)
+	{
+		if (status->code != 0)
+			status->setCode(0);
+	}
+
+	static void checkException(ClassicStatus* status)
+	{
+		if (status->code != 0)
+			throw CalcException(status);
+	}
+
+	static void catchException(ClassicStatus* status)
+	{
+		try
+		{
+			throw;
+		}
+		catch (const CalcException& e)
+		{
+			status->setCode(e.code);
+		}
+	}
+
+	static void setVersionError(ClassicStatus* status, const char* /*interfaceName*/,
+		unsigned /*currentVersion*/, unsigned /*expectedVersion*/)
+	{
+		status->setCode(calc::IStatus::ERROR_1);
+	}
+
+private:
+	calc::IStatus* delegate;
+	int code;
+};
+
+
+//--------------------------------------
+
+// LightStatus
+
+
+// View of the received status constructed by the dispatchers, reading its error word to know
+// when it's dirty.
+class LightStatus : public calc::IStatusImpl<LightStatus, LightStatus>
+{
+public:
+	explicit LightStatus(calc::IStatus* delegate)
+		: delegate(delegate)
+	{
+		this->cloopErrorFlag = delegate->cloopErrorFlag;
+	}
+
+	virtual void dispose()
+	{
+	}
+
+	virtual int getCode() const
+	{
+		return delegate->getCode();
+	}
+
+	virtual void setCode(int code)
+	{
+		delegate->setCode(code);
+		this->cloopErrorFlag = delegate->cloopErrorFlag;
+	}
+
+	static bool isDirty(LightStatus* status)
+	{
+		return status->delegate->cloopErrorFlag != 0;
+	}
+
+	static void clearException(LightStatus* status)
+	{
+		status->setCode(0);
+	}
+
+	static void checkException(LightStatus* status)
+	{
+		if (status->delegate->cloopErrorFlag)
+			throw CalcException(status);
+	}
+
+	static void catchException(LightStatus* status)
+	{
+		try
+		{
+			throw;
+		}
+		catch (const CalcException& e)
+		{
+			status->setCode(e.code);
+		}
+	}
+
+	static void setVersionError(LightStatus* status, const char* /*interfaceName*/,
+		unsigned /*currentVersion*/, unsigned /*expectedVersion*/)
+	{
+		status->setCode(calc::IStatus::ERROR_1);
+	}
+
+private:
+	calc::IStatus* delegate;
+};
+
+namespace calc
+{
+	template <>
+	struct StatusTraits<LocalStatus> : LightStatusTraits<LocalStatus>
+	{
+	};
+
+	template <>
+	struct StatusTraits<LightStatus> : LightStatusTraits<LightStatus>
+	{
+	};
+}
+
+
+//--------------------------------------
+
+// PoolAllocator
+
+
+// Free list of blocks of the single size allocated in this benchmark, confined to a thread.
+class PoolAllocator
+{
+public:
+	static void* allocate(size_t size)
+	{
+		if (FreeBlock* block = freeList)
+		{
+			freeList = block->next;
+			return block;
+		}
+
+		return ::operator new(size);
+	}
+
+	static void deallocate(void* ptr, size_t /*size*/)
+	{
+		FreeBlock* block = static_cast<FreeBlock*>(ptr);
+		block->next = freeList;
+		freeList = block;
+	}
+
+private:
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	static thread_local FreeBlock* freeList;
+};
+
+thread_local PoolAllocator::FreeBlock* PoolAllocator::freeList = NULL;
+
+
+//--------------------------------------
+
+// DisposableStatus
+
+
+// Status created and disposed by the caller, with its memory taken from Allocator.
+template <typename Allocator>
+class DisposableStatus : public calc::IStatusImpl<DisposableStatus<Allocator>, LocalStatus,
+	calc::IDisposableImpl<DisposableStatus<Allocator>, LocalStatus, calc::Inherit<calc::IStatus> >,
+	Allocator>
+{
+public:
+	DisposableStatus()
+		: code(0)
+	{
+	}
+
+	virtual void dispose()
+	{
+		delete this;
+	}
+
+	virtual int getCode() const
+	{
+		return code;
+	}
+
+	virtual void setCode(int code)
+	{
+		this->code = code;
+		this->cloopErrorFlag = code != 0;
+	}
+
+private:
+	int code;
+};
+
+
+//--------------------------------------
+
+// CalculatorImpl
+
+
+template <typename StatusType>
+class CalculatorImpl : public calc::ICalculatorImpl<CalculatorImpl<StatusType>, StatusType>
+{
+public:
+	CalculatorImpl()
+		: memory(0)
+	{
+	}
+
+	virtual void dispose()
+	{
+	}
+
+	virtual int sum(StatusType* status, int n1, int n2) const
+	{
+		if (n1 + n2 > 1000)
+			throw CalcException(calc::IStatus::ERROR_1);
+		else
+			return n1 + n2;
+	}
+
+	virtual int getMemory() const
+	{
+		return memory;
+	}
+
+	virtual void setMemory(int n)
+	{
+		memory = n;
+	}
+
+	virtual void sumAndStore(StatusType* status, int n1, int n2)
+	{
+		setMemory(sum(status, n1, n2));
+	}
+
+private:
+	int memory;
+};
+
+
+//--------------------------------------
+
+
+static const int ITERATIONS = 10000000;
+
+// Keeps the compiler from seeing the implementation behind the calculator.
+static calc::ICalculator* volatile classicCalculator = new CalculatorImpl<ClassicStatus>();
+static calc::ICalculator* volatile lightCalculator = new CalculatorImpl<LightStatus>();
+
+
+template <typename StatusType>
+static double run(StatusType* status, calc::ICalculator* calculator, int* result)
+{
+	clock_t start = clock();
+	int n = 0;
+
+	for (int i = 0; i < ITERATIONS; ++i)
+		n += calculator->sum(status, i & 0xFF, 1);
+
+	*result = n;
+
+	return double(clock() - start) / CLOCKS_PER_SEC * 1e9 / ITERATIONS;
+}
+
+template <typename StatusType>
+static double runDispose()
+{
+	clock_t start = clock();
+
+	for (int i = 0; i < ITERATIONS; ++i)
+	{
+		// Keeps the compiler from removing the allocation.
+		calc::IStatus* volatile status = new StatusType();
+		status->dispose();
+	}
+
+	return double(clock() - start) / CLOCKS_PER_SEC * 1e9 / ITERATIONS;
+}
+
+int main()
+{
+	LocalStatus localStatus;
+	ClassicStatus classicStatus(&localStatus);
+	int classicResult, lightResult;
+
+	double classic = run(&classicStatus, classicCalculator, &classicResult);
+	double light = run(&localStatus, lightCalculator, &lightResult);
+
+	printf("classic: %.2f ns/call\n", classic);
+	printf("light:   %.2f ns/call\n", light);
+
+	double defaultAllocator = runDispose<DisposableStatus<calc::DefaultAllocator> >();
+	double poolAllocator = runDispose<DisposableStatus<PoolAllocator> >();
+
+	printf("default allocator: %.2f ns/status\n", defaultAllocator);
+	printf("pool allocator:    %.2f ns/status\n", poolAllocator);
+
+	return classicResult == lightResult ? 0 : 1;
+}
@@ -23,12 +23,23 @@
 #include "CalcCppApi.h"
 #include <stdio.h>
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #ifdef WIN32
 #include <windows.h>
 #define DLL_EXPORT __declspec(dllexport)
 #else
 #include <dlfcn.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #define DLL_EXPORT
 #endif
 
@@ -63,11 +74,15 @@ public:
 
 class StatusWrapper : public calc::IStatusImpl<StatusWrapper, StatusWrapper>
 {
+public:
+	typedef int Error;
+
 public:
 	StatusWrapper(calc::IStatus* delegate)
 		: delegate(delegate),
-		  code(0)
+		  code(delegate->getCode())
 	{
+		this->cloopErrorFlag = code != 0;
 	}
 
 	virtual void dispose()
@@ -83,6 +98,7 @@ public:
 	virtual void setCode(int code)
 	{
 		this->code = code;
+		this->cloopErrorFlag = code != 0;
 		delegate->setCode(code);
 	}
 
@@ -94,12 +110,15 @@ public:
 
 	static void checkException(StatusWrapper* status)
 	{
+#ifndef CLOOP_NO_EXCEPTIONS
 		if (status->code != 0)
 			throw CalcException(status);
+#endif
 	}
 
 	static void catchException(StatusWrapper* status)
 	{
+#ifndef CLOOP_NO_EXCEPTIONS
 		try
 		{
 			throw;
@@ -113,6 +132,7 @@ public:
 		{
 			assert(false);
 		}
+#endif
 	}
 
 	static void setVersionError(StatusWrapper* status, const char* /*interfaceName*/,
@@ -121,12 +141,42 @@ public:
 		status->setCode(calc::IStatus::ERROR_1);
 	}
 
+	static bool hasError(StatusWrapper* status)
+	{
+		return status->code != 0;
+	}
+
+	static int getError(StatusWrapper* status)
+	{
+		return status->code;
+	}
+
 private:
 	calc::IStatus* delegate;
 	int code;
 };
 
 
+//--------------------------------------
+
+// QuietStatusWrapper
+
+
+// Reports errors only through its code, even when exceptions are enabled.
+class QuietStatusWrapper : public StatusWrapper
+{
+public:
+	QuietStatusWrapper(calc::IStatus* delegate)
+		: StatusWrapper(delegate)
+	{
+	}
+
+	static void checkException(QuietStatusWrapper* /*status*/)
+	{
+	}
+};
+
+
 //--------------------------------------
 
 // StatusImpl
@@ -153,6 +203,7 @@ public:
 	virtual void setCode(int code)
 	{
 		this->code = code;
+		this->cloopErrorFlag = code != 0;
 	}
 
 private:
@@ -181,7 +232,14 @@ public:
 	virtual int sum(StatusWrapper* status, int n1, int n2) const
 	{
 		if (n1 + n2 > 1000)
+		{
+#ifdef CLOOP_NO_EXCEPTIONS
+			status->setCode(calc::IStatus::ERROR_1);
+			return 0;
+#else
 			throw CalcException(calc::IStatus::ERROR_1);
+#endif
+		}
 		else
 			return n1 + n2;
 	}
@@ -198,7 +256,10 @@ public:
 
 	virtual void sumAndStore(StatusWrapper* status, int n1, int n2)
 	{
-		setMemory(sum(status, n1, n2));
+		int n = sum(status, n1, n2);
+
+		if (!StatusWrapper::hasError(status))
+			setMemory(n);
 	}
 
 private:
@@ -227,7 +288,14 @@ public:
 	virtual int sum(StatusWrapper* status, int n1, int n2) const
 	{
 		if (n1 + n2 > 1000)
+		{
+#ifdef CLOOP_NO_EXCEPTIONS
+			status->setCode(calc::IStatus::ERROR_1);
+			return 0;
+#else
 			throw CalcException(calc::IStatus::ERROR_1);
+#endif
+		}
 		else
 			return n1 + n2;
 	}
@@ -244,7 +312,10 @@ public:
 
 	virtual void sumAndStore(StatusWrapper* status, int n1, int n2)
 	{
-		setMemory(sum(status, n1, n2));
+		int n = sum(status, n1, n2);
+
+		if (!StatusWrapper::hasError(status))
+			setMemory(n);
 	}
 
 	virtual int multiply(StatusWrapper* status, int n1, int n2) const
@@ -283,6 +354,33 @@ public:
 };
 
 
+//--------------------------------------
+
+// TracedCalculatorImpl
+
+
+// Calculator whose dispatchers are traced to the ring, summing through its interface, so the
+// sums are recorded as calls made by sumAndStore.
+class TracedCalculatorImpl :
+	public calc::ICalculatorBaseImpl<TracedCalculatorImpl, StatusWrapper, CalculatorImpl>
+{
+public:
+	virtual void sumAndStore(StatusWrapper* status, int n1, int n2)
+	{
+		setMemory(static_cast<calc::ICalculator*>(this)->sum(status, n1, n2));
+	}
+};
+
+namespace calc
+{
+	template <>
+	struct TraceTraits<TracedCalculatorImpl>
+	{
+		typedef RingTracePolicy Policy;
+	};
+}
+
+
 //--------------------------------------
 
 // FactoryImpl
@@ -326,6 +424,501 @@ private:
 };
 
 
+//--------------------------------------
+
+// CounterImpl
+
+
+class CounterImpl : public calc::ICounterImpl<CounterImpl, StatusWrapper>
+{
+public:
+	CounterImpl()
+		: value(0)
+	{
+	}
+
+	virtual void dispose()
+	{
+		delete this;
+	}
+
+	virtual int increment()
+	{
+		return ++value;
+	}
+
+	virtual int getValue() const
+	{
+		return value;
+	}
+
+	virtual void add(const calc::ICounter* counter)
+	{
+		value += counter->getValue();
+	}
+
+private:
+	int value;
+};
+
+// Allocated by the aligned forms of the operator new of CounterImpl.
+class alignas(64) AlignedCounterImpl : public CounterImpl
+{
+};
+
+// Counts the calls traced with it.
+struct CallCounter
+{
+	static void enter(unsigned interfaceIndex, unsigned slot)
+	{
+		++entered;
+		lastInterfaceIndex = interfaceIndex;
+		lastSlot = slot;
+	}
+
+	static void failed(unsigned /*interfaceIndex*/, unsigned /*slot*/)
+	{
+	}
+
+	static void exit(unsigned /*interfaceIndex*/, unsigned /*slot*/)
+	{
+		++exited;
+	}
+
+	static int entered;
+	static int exited;
+	static unsigned lastInterfaceIndex;
+	static unsigned lastSlot;
+};
+
+int CallCounter::entered = 0;
+int CallCounter::exited = 0;
+unsigned CallCounter::lastInterfaceIndex = 0;
+unsigned CallCounter::lastSlot = 0;
+
+namespace calc
+{
+	template <>
+	struct TraceTraits<CounterImpl>
+	{
+		typedef CallCounter Policy;
+	};
+}
+
+
+//--------------------------------------
+
+// AccumulatorImpl
+
+
+// Reference counting comes from IReferenceCountedImpl.
+class AccumulatorImpl : public calc::IAccumulatorImpl<AccumulatorImpl, StatusWrapper>
+{
+public:
+	AccumulatorImpl()
+		: total(0)
+	{
+	}
+
+	virtual void add(int n)
+	{
+		total += n;
+	}
+
+	virtual int getTotal() const
+	{
+		return total;
+	}
+
+private:
+	int total;
+};
+
+// Only used by one thread at a time.
+namespace calc
+{
+	template <>
+	struct RefCountTraits<AccumulatorImpl>
+	{
+		typedef RelaxedRefCount Order;
+	};
+}
+
+
+//--------------------------------------
+
+// PoolImpl
+
+
+class PoolImpl : public calc::IPoolImpl<PoolImpl, StatusWrapper>
+{
+public:
+	virtual void dispose()
+	{
+		delete this;
+	}
+
+	virtual void keep(calc::IAccumulator* accumulator)
+	{
+		accumulators.push_back(calc::Ref<calc::IAccumulator>(accumulator));
+	}
+
+	virtual void setName(const char* name)
+	{
+		this->name = name;
+	}
+
+	virtual int total() const
+	{
+		int sum = 0;
+
+		for (size_t i = 0; i < accumulators.size(); ++i)
+			sum += accumulators[i]->getTotal();
+
+		return sum;
+	}
+
+private:
+	std::vector<calc::Ref<calc::IAccumulator> > accumulators;
+	std::string name;
+};
+
+
+//--------------------------------------
+
+// BufferImpl
+
+
+// Counts the blocks allocated for the implementations using it.
+struct CountingAllocator
+{
+	static void* allocate(size_t size)
+	{
+		++blocks;
+		return ::operator new(size);
+	}
+
+	static void* allocate(size_t size, const std::nothrow_t&)
+	{
+		void* ptr = ::operator new(size, std::nothrow);
+
+		if (ptr)
+			++blocks;
+
+		return ptr;
+	}
+
+	static void deallocate(void* ptr, size_t /*size*/)
+	{
+		--blocks;
+		::operator delete(ptr);
+	}
+
+	static void* allocate(size_t size, std::align_val_t alignment)
+	{
+		++blocks;
+		return ::operator new(size, alignment);
+	}
+
+	static void deallocate(void* ptr, size_t /*size*/, std::align_val_t alignment)
+	{
+		--blocks;
+		::operator delete(ptr, alignment);
+	}
+
+	static int blocks;
+};
+
+int CountingAllocator::blocks = 0;
+
+class BufferImpl : public calc::MultiImpl<
+	calc::IReaderImpl<BufferImpl, StatusWrapper,
+		calc::IQueryableImpl<BufferImpl, StatusWrapper,
+			calc::Inherit<calc::IDisposableImpl<BufferImpl, StatusWrapper, calc::Inherit<calc::IReader> > > >,
+		CountingAllocator>,
+	calc::IWriterImpl<BufferImpl, StatusWrapper> >
+{
+public:
+	BufferImpl()
+		: value(0)
+	{
+	}
+
+	virtual void dispose()
+	{
+		delete this;
+	}
+
+	virtual int read()
+	{
+		return value;
+	}
+
+	virtual void write(int n)
+	{
+		value = n;
+	}
+
+private:
+	int value;
+};
+
+// Allocated by the aligned forms of the operator new of BufferImpl.
+class alignas(64) AlignedBufferImpl : public BufferImpl
+{
+};
+
+#ifndef CLOOP_NO_EXCEPTIONS
+// Constructed after a nothrow new, freed by the nothrow delete.
+class ThrowingBufferImpl : public BufferImpl
+{
+public:
+	ThrowingBufferImpl()
+	{
+		throw 1;
+	}
+};
+#endif
+
+
+//--------------------------------------
+
+// AsyncCalculatorImpl
+
+
+class AsyncCalculatorImpl : public calc::IAsyncCalculatorImpl<AsyncCalculatorImpl, StatusWrapper>
+{
+public:
+	AsyncCalculatorImpl(bool later)
+		: later(later)
+	{
+	}
+
+	virtual void dispose()
+	{
+		if (worker.joinable())
+			worker.join();
+
+		delete this;
+	}
+
+	virtual int sum(StatusWrapper* status, int n1, int n2) const
+	{
+		if (n1 + n2 > 1000)
+		{
+#ifdef CLOOP_NO_EXCEPTIONS
+			status->setCode(calc::IStatus::ERROR_1);
+			return 0;
+#else
+			throw CalcException(calc::IStatus::ERROR_1);
+#endif
+		}
+		else
+			return n1 + n2;
+	}
+
+	// Completes from another thread when created to complete later.
+	virtual void sumAsync(StatusWrapper* status, int n1, int n2,
+		calc::IAsyncCalculatorSumCompletion* completion) const
+	{
+		if (!later)
+		{
+			calc::IAsyncCalculatorImpl<AsyncCalculatorImpl, StatusWrapper>::sumAsync(
+				status, n1, n2, completion);
+			return;
+		}
+
+		int result = sum(status, n1, n2);
+
+		if (StatusWrapper::hasError(status))
+			return;
+
+		// Calls made by the coroutine resumed from the worker run in it.
+		if (worker.get_id() == std::this_thread::get_id())
+			worker.detach();
+		else if (worker.joinable())
+			worker.join();
+
+		// Negative sums fail after the call returned, through the status of the completion.
+		worker = std::thread([completion, result] {
+			StatusImpl completionStatus;
+
+			if (result < 0)
+				completionStatus.setCode(calc::IStatus::ERROR_2);
+
+			completion->complete(&completionStatus, (result < 0 ? 0 : result));
+		});
+	}
+
+private:
+	bool later;
+	mutable std::thread worker;
+};
+
+
+//--------------------------------------
+
+// ScannerImpl
+
+
+class ScannerImpl : public calc::IScannerImpl<ScannerImpl, StatusWrapper>
+{
+public:
+	virtual void dispose()
+	{
+		delete this;
+	}
+
+	virtual unsigned countChar(calc::StrView text, unsigned char c) const
+	{
+		std::string_view view = text;
+		return (unsigned) std::count(view.begin(), view.end(), c);
+	}
+
+	virtual calc::StrView trim(StatusWrapper* status, calc::StrView text) const
+	{
+		std::string_view view = text;
+		size_t start = view.find_first_not_of(' ');
+
+		if (start == std::string_view::npos)
+			return calc::StrView();
+
+		return view.substr(start, view.find_last_not_of(' ') - start + 1);
+	}
+
+	virtual unsigned checksum(calc::Bytes data) const
+	{
+		unsigned sum = 0;
+
+		for (unsigned char byte : std::span<const unsigned char>(data))
+			sum += byte;
+
+		return sum;
+	}
+};
+
+
+//--------------------------------------
+
+// GeometryImpl
+
+
+class GeometryImpl : public calc::IGeometryImpl<GeometryImpl, StatusWrapper>
+{
+public:
+	virtual void dispose()
+	{
+		delete this;
+	}
+
+	virtual calc::Rectangle move(calc::Rectangle rectangle, calc::Point offset) const
+	{
+		rectangle.origin.x += offset.x;
+		rectangle.origin.y += offset.y;
+		return rectangle;
+	}
+
+	virtual int area(const calc::Rectangle* rectangle) const
+	{
+		return (int) (rectangle->extent.width * rectangle->extent.height);
+	}
+
+	virtual unsigned payload(calc::Header header) const
+	{
+		return header.kind == 1 ? header.length : 0;
+	}
+};
+
+
+//--------------------------------------
+
+// SeriesImpl
+
+
+class SeriesImpl : public calc::ISeriesImpl<SeriesImpl, StatusWrapper>
+{
+public:
+	virtual void dispose()
+	{
+		delete this;
+	}
+
+	virtual int total(const int* values, unsigned count) const
+	{
+		int sum = 0;
+
+		for (unsigned i = 0; i < count; ++i)
+			sum += values[i];
+
+		return sum;
+	}
+
+	virtual void scale(const int* values, int* results, unsigned count, int factor) const
+	{
+		for (unsigned i = 0; i < count; ++i)
+			results[i] = values[i] * factor;
+	}
+
+	virtual unsigned histogram(const unsigned char* data, unsigned* counts, unsigned size,
+		unsigned buckets) const
+	{
+		unsigned outside = 0;
+
+		for (unsigned i = 0; i < size; ++i)
+		{
+			if (data[i] < buckets)
+				++counts[data[i]];
+			else
+				++outside;
+		}
+
+		return outside;
+	}
+
+	virtual int clamp(int value, int limit) const
+	{
+		return value > limit ? limit : value;
+	}
+};
+
+
+//--------------------------------------
+
+// DetachedTask
+
+
+// Coroutine running by itself until it finishes.
+struct DetachedTask
+{
+	struct promise_type
+	{
+		DetachedTask get_return_object()
+		{
+			return DetachedTask();
+		}
+
+		std::suspend_never initial_suspend()
+		{
+			return std::suspend_never();
+		}
+
+		std::suspend_never final_suspend() noexcept
+		{
+			return std::suspend_never();
+		}
+
+		void return_void()
+		{
+		}
+
+		void unhandled_exception()
+		{
+			abort();
+		}
+	};
+};
+
+
 //--------------------------------------
 
 // Library entry point
@@ -340,6 +933,58 @@ extern "C" DLL_EXPORT calc::IFactory* createFactory()
 //--------------------------------------
 
 
+static DetachedTask sumAsync(calc::IAsyncCalculator* now, calc::IAsyncCalculator* later,
+	StatusWrapper* status, int* results, std::atomic<bool>* done)
+{
+#ifdef CLOOP_NO_EXCEPTIONS
+	co_await later->sumAsync(status, 1000, 1);
+	results[2] = StatusWrapper::hasError(status);
+#else
+	try
+	{
+		co_await later->sumAsync(status, 1000, 1);
+	}
+	catch (const CalcException&)
+	{
+		results[2] = 1;
+	}
+#endif
+
+	results[0] = co_await now->sumAsync(status, 2, 3);
+	results[1] = co_await later->sumAsync(status, 3, 4);
+
+#ifdef CLOOP_NO_EXCEPTIONS
+	auto negative = later->sumAsync(status, -5, 1);
+	co_await negative;
+	results[3] = negative.failed();
+#else
+	try
+	{
+		co_await later->sumAsync(status, -5, 1);
+	}
+	catch (const CalcException& e)
+	{
+		results[3] = e.code == calc::IStatus::ERROR_2;
+	}
+#endif
+
+	done->store(true);
+}
+
+// Resumed by the error itself, as the status doesn't throw it.
+static DetachedTask sumQuietly(calc::IAsyncCalculator* later, QuietStatusWrapper* status,
+	int* failed, std::atomic<bool>* done)
+{
+	co_await later->sumAsync(status, 1000, 1);
+	failed[0] = QuietStatusWrapper::hasError(status);
+
+	// Failures after the call returned are only known to the awaiter.
+	auto negative = later->sumAsync(status, -5, 1);
+	failed[1] = co_await negative;
+	failed[2] = negative.failed();
+	done->store(true);
+}
+
 static void test(calc::IFactory* (*createFactory)())
 {
 	calc::IFactory* factory = createFactory();
@@ -378,6 +1023,392 @@ static void test(calc::IFactory* (*createFactory)())
 	calculator2->setMemory(calculator2->multiply(&status, 2, 33));
 	printf("%d\n", calculator2->getMemory());	// 66
 
+	int n1[] = {2, 3, 4}, n2[] = {5, 6, 7}, results[3];
+	calculator2->multiplyBatch(&status, n1, n2, results, 3);
+	printf("%d %d %d\n", results[0], results[1], results[2]);	// 10 18 28
+	assert(results[0] == 10 && results[1] == 18 && results[2] == 28);
+
+	calc::CommandBuffer commands;
+	calc::ICalculator2Recorder recorder(&commands, calculator2);
+	recorder.sumAndStore(3, 4);
+	calc::CommandResult<int> memory = recorder.getMemory();
+	calc::CommandResult<int> product = recorder.multiply(6, 7);
+	recorder.sum(600, 600);
+	recorder.setMemory(1);
+	unsigned executed = calc::executeCommands(&status, commands.data(), commands.size());
+	printf("%u %d %d %d %d\n", executed, memory.get(), product.get(), status.getCode(),
+		calculator2->getMemory());	// 3 7 42 1 7
+	assert(executed == 3 && memory.get() == 7 && product.get() == 42 &&
+		status.getCode() == calc::IStatus::ERROR_1 && calculator2->getMemory() == 7);
+	status.setCode(0);
+
+	// Recorded through a proxy and replayed on a fresh calculator.
+	calc::CallLog log;
+	calc::ICalculatorRecordingProxy<StatusWrapper> proxy(calculator, &log);
+	proxy.sumAndStore(&status, 2, 3);
+	proxy.setMemory(proxy.getMemory() * 2);
+
+	calc::ICalculator* replayCalculator = factory->createCalculator(&status);
+	std::vector<void*> objects(2);
+	objects[log.identify(calculator)] = replayCalculator;
+	unsigned replayed = calc::replayCalls(&status, log.commands(), objects);
+	printf("%u %d\n", replayed, replayCalculator->getMemory());	// 3 10
+	assert(replayed == 3 && replayCalculator->getMemory() == 10 && replayed == log.calls());
+	replayCalculator->dispose();
+
+	// Stopped at the calls with arguments not recorded and at the objects not known.
+	calc::CallLog pointerLog;
+	calc::ICalculator2RecordingProxy<StatusWrapper> proxy2(calculator2, &pointerLog);
+	proxy2.setMemory(3);
+	proxy2.copyMemory2(&address);
+	proxy2.setMemory(10);
+
+	calc::ICalculator2* replayCalculator2 = factory->createCalculator2(&status);
+	std::vector<void*> objects2(2);
+	objects2[pointerLog.identify(calculator2)] = replayCalculator2;
+	replayed = calc::replayCalls(&status, pointerLog.commands(), objects2);
+	std::vector<void*> noObjects;
+	unsigned replayedUnknown = calc::replayCalls(&status, log.commands(), noObjects);
+	printf("%u %u %d %u\n", replayed, pointerLog.calls(), replayCalculator2->getMemory(),
+		replayedUnknown);	// 1 3 3 0
+	assert(replayed == 1 && pointerLog.calls() == 3 && replayCalculator2->getMemory() == 3);
+	assert(replayedUnknown == 0);
+	replayCalculator2->dispose();
+
+#ifdef __linux__
+	// Served by a child process through shared memory, with the error set on the status by a
+	// call back to this one.
+	char channelName[64];
+	sprintf(channelName, "/cloop-test1-%d", (int) getpid());
+	calc::SharedChannel* channel = calc::SharedChannel::map(channelName, true);
+
+	pid_t server = fork();
+
+	if (server == 0)
+	{
+		calc::RpcEndpoint endpoint(channel, true);
+		endpoint.exportObject(factory->createCalculator(&status));
+		endpoint.exportObject(static_cast<calc::ISeries*>(new SeriesImpl()));
+		endpoint.exportObject(static_cast<calc::IScanner*>(new ScannerImpl()));
+		endpoint.exportObject(static_cast<calc::IGeometry*>(new GeometryImpl()));
+		endpoint.exportObject(static_cast<calc::IStatus*>(new StatusImpl()));
+		endpoint.serve();
+		_exit(0);
+	}
+
+	{
+		calc::RpcEndpoint endpoint(channel, false);
+		calc::ICalculator* remoteCalculator = endpoint.import<calc::ICalculator>(calc::RpcEndpoint::ROOT);
+
+		remoteCalculator->sumAndStore(&status, 2, 3);
+		int remoteSum = remoteCalculator->sum(&status, remoteCalculator->getMemory(), 10);
+		calc::Expected<int, int> remoteResult = remoteCalculator->try_sum(&status, 600, 600);
+		printf("%d %d %d\n", remoteSum, (int) remoteResult.hasValue(), remoteResult.error());	// 15 0 1
+		assert(remoteSum == 15 && !remoteResult.hasValue() && remoteResult.error() == 1);
+
+		// Arrays are copied into the request unless out, and back to the caller unless in.
+		calc::ISeries* remoteSeries = endpoint.import<calc::ISeries>(calc::RpcEndpoint::ROOT + 2);
+		const int values[] = {1, 2, 3, 4};
+		const int limits[] = {2, 1, 5, 3};
+		int scaled[4] = {0, 0, 0, 0};
+		int clamped[4] = {0, 0, 0, 0};
+		const unsigned char samples[] = {0, 2, 2, 7};
+		unsigned counts[3] = {1, 0, 0};
+
+		remoteSeries->scale(std::span<const int>(values), std::span<int>(scaled), 3);
+		remoteSeries->clampBatch(values, limits, clamped, 4);
+		unsigned outside = remoteSeries->histogram(std::span<const unsigned char>(samples),
+			std::span<unsigned>(counts));
+
+		printf("%d %d %d %d %u\n", remoteSeries->total(std::span<const int>(values)), scaled[3],
+			clamped[1], clamped[3], outside);	// 10 12 1 3 1
+		printf("%u %u %u\n", counts[0], counts[1], counts[2]);	// 2 0 2
+		assert(remoteSeries->total(std::span<const int>(values)) == 10);
+		assert(scaled[0] == 3 && scaled[2] == 9 && scaled[3] == 12);
+		assert(clamped[0] == 1 && clamped[1] == 1 && clamped[2] == 3 && clamped[3] == 3);
+		assert(outside == 1 && counts[0] == 2 && counts[1] == 0 && counts[2] == 2);
+
+		remoteSeries->dispose();
+
+		// Imported again, the disposed object is no longer called.
+		calc::ISeries* disposedSeries = endpoint.import<calc::ISeries>(calc::RpcEndpoint::ROOT + 2);
+		int disposedTotal = disposedSeries->total(std::span<const int>(values));
+		printf("%d\n", disposedTotal);	// 0
+		assert(disposedTotal == 0);
+		disposedSeries->dispose();
+
+		// Views are copied with their lengths, and a view returned is kept by the endpoint.
+		calc::IScanner* remoteScanner = endpoint.import<calc::IScanner>(calc::RpcEndpoint::ROOT + 4);
+		std::string_view text = "  a,b  ";
+		std::string trimmed(remoteScanner->trim(&status, text));
+		const unsigned char data[] = {1, 2, 250};
+		unsigned commas = remoteScanner->countChar(text, ',');
+		unsigned checksum = remoteScanner->checksum(std::span<const unsigned char>(data));
+
+		printf("%s %u %u\n", trimmed.c_str(), commas, checksum);	// a,b 1 253
+		assert(trimmed == "a,b" && commas == 1 && checksum == 253);
+
+		remoteScanner->dispose();
+
+		// Structs are copied by value, and by pointer as a single element.
+		calc::IGeometry* remoteGeometry = endpoint.import<calc::IGeometry>(calc::RpcEndpoint::ROOT + 6);
+		calc::Rectangle rectangle = {{1, 2}, {3, 4}};
+		calc::Point offset = {10, 20};
+		calc::Header header = {1, 99};
+		calc::Rectangle shifted = remoteGeometry->move(rectangle, offset);
+		int area = remoteGeometry->area(&shifted);
+		unsigned payload = remoteGeometry->payload(header);
+
+		printf("%d %d %d %u\n", shifted.origin.x, shifted.extent.height, area, payload);	// 11 4 12 99
+		assert(shifted.origin.x == 11 && shifted.origin.y == 22 && shifted.extent.height == 4);
+		assert(area == 12 && payload == 99);
+
+		remoteGeometry->dispose();
+
+		// The error flag of a remote status comes back with the replies of its methods.
+		calc::IStatus* remoteStatus = endpoint.import<calc::IStatus>(calc::RpcEndpoint::ROOT + 8);
+		remoteStatus->setCode(2);
+		int remoteFlag = remoteStatus->cloopErrorFlag;
+		remoteStatus->setCode(0);
+
+		printf("%d %d\n", remoteFlag, remoteStatus->cloopErrorFlag);	// 1 0
+		assert(remoteFlag == 1 && remoteStatus->cloopErrorFlag == 0);
+
+		remoteStatus->dispose();
+
+		remoteCalculator->dispose();
+		endpoint.close();
+	}
+
+	waitpid(server, NULL, 0);
+	calc::SharedChannel::unmap(channel);
+	calc::SharedChannel::remove(channelName);
+
+	// Calls return empty results, instead of waiting forever, once the server is gone.
+	sprintf(channelName, "/cloop-test1-exited-%d", (int) getpid());
+	channel = calc::SharedChannel::map(channelName, true);
+	server = fork();
+
+	if (server == 0)
+	{
+		calc::RpcEndpoint endpoint(channel, true);
+		_exit(0);
+	}
+
+	{
+		calc::RpcEndpoint endpoint(channel, false);
+		calc::ICalculator* remoteCalculator = endpoint.import<calc::ICalculator>(calc::RpcEndpoint::ROOT);
+		int exitedSum = remoteCalculator->sum(&status, 2, 3);
+
+		printf("%d\n", exitedSum);	// 0
+		assert(exitedSum == 0);
+
+		remoteCalculator->dispose();
+	}
+
+	waitpid(server, NULL, 0);
+	calc::SharedChannel::unmap(channel);
+	calc::SharedChannel::remove(channelName);
+#endif
+
+	// Calls from several threads run one at a time on the thread owning the objects.
+	calc::ActorMailbox mailbox;
+	std::thread ownerThread([&mailbox] { mailbox.run(); });
+
+	// Proxies are deleted by their dispose.
+	calc::ICounterActorProxy* actorCounter = new calc::ICounterActorProxy(new CounterImpl(), &mailbox);
+	calc::ICalculatorActorProxy* actorCalculator =
+		new calc::ICalculatorActorProxy(factory->createCalculator(&status), &mailbox);
+	std::thread callers[4];
+
+	for (std::thread& caller : callers)
+	{
+		caller = std::thread([actorCounter] {
+			for (int i = 0; i < 1000; ++i)
+				actorCounter->increment();
+		});
+	}
+
+	for (std::thread& caller : callers)
+		caller.join();
+
+	actorCalculator->setMemory(7);
+	printf("%d %d\n", actorCounter->getValue(), actorCalculator->getMemory());	// 4000 7
+	assert(actorCounter->getValue() == 4000 && actorCalculator->getMemory() == 7);
+
+	// Borrowed objects are only used during the call, so copyMemory waits for the owner even when
+	// it's busy, and the source may be disposed as soon as the call returns.
+	calc::ICalculator2* rawCalculator2 = factory->createCalculator2(&status);
+	calc::ICalculator2ActorProxy* actorCalculator2 = new calc::ICalculator2ActorProxy(rawCalculator2, &mailbox);
+	calc::ICalculator* memorySource = factory->createCalculator(&status);
+
+	memorySource->setMemory(5);
+	mailbox.post([] { std::this_thread::sleep_for(std::chrono::milliseconds(20)); });
+	actorCalculator2->copyMemory(memorySource);
+	memorySource->dispose();
+
+	printf("%d\n", rawCalculator2->getMemory());	// 5
+	assert(rawCalculator2->getMemory() == 5);
+
+	actorCalculator2->dispose();
+
+	// Status methods wait for the owner too, and copy its error flag to the proxy.
+	calc::IStatusActorProxy* actorStatus = new calc::IStatusActorProxy(new StatusImpl(), &mailbox);
+	actorStatus->setCode(1);
+	int actorFlag = actorStatus->cloopErrorFlag;
+	actorStatus->setCode(0);
+
+	printf("%d %d\n", actorFlag, actorStatus->cloopErrorFlag);	// 1 0
+	assert(actorFlag == 1 && actorStatus->cloopErrorFlag == 0);
+
+	actorStatus->dispose();
+	actorCalculator->dispose();
+	actorCounter->dispose();
+	mailbox.stop();
+	ownerThread.join();
+
+	// Awaited sums, the second one resumed by the thread completing it.
+	calc::IAsyncCalculator* nowCalculator = new AsyncCalculatorImpl(false);
+	calc::IAsyncCalculator* laterCalculator = new AsyncCalculatorImpl(true);
+	int asyncResults[4] = {0, 0, 0, 0};
+	std::atomic<bool> asyncDone(false);
+
+	sumAsync(nowCalculator, laterCalculator, &status, asyncResults, &asyncDone);
+
+	while (!asyncDone.load())
+		std::this_thread::yield();
+
+	printf("%d %d %d %d\n", asyncResults[0], asyncResults[1], asyncResults[2], asyncResults[3]);	// 5 7 1 1
+	assert(asyncResults[0] == 5 && asyncResults[1] == 7 && asyncResults[2] == 1 && asyncResults[3] == 1);
+
+	StatusImpl quietStatusImpl;
+	QuietStatusWrapper quietStatus(&quietStatusImpl);
+	int quietFailed[3] = {0, -1, 0};
+	std::atomic<bool> quietDone(false);
+
+	sumQuietly(laterCalculator, &quietStatus, quietFailed, &quietDone);
+
+	while (!quietDone.load())
+		std::this_thread::yield();
+
+	printf("%d %d %d\n", quietFailed[0], quietFailed[1], quietFailed[2]);	// 1 0 1
+	assert(quietFailed[0] == 1 && quietFailed[1] == 0 && quietFailed[2] == 1);
+
+	laterCalculator->dispose();
+	nowCalculator->dispose();
+
+	// Calculators replaced while read by other threads, disposed after the readers left them.
+	std::atomic<calc::ICalculator*> sharedCalculator(factory->createCalculator(&status));
+	std::atomic<bool> stopReaders(false);
+	std::thread readers[2];
+
+	for (std::thread& reader : readers)
+	{
+		reader = std::thread([&sharedCalculator, &stopReaders] {
+			while (!stopReaders.load())
+			{
+				calc::EpochGuard guard;
+				sharedCalculator.load()->getMemory();
+			}
+		});
+	}
+
+	for (int i = 0; i < 1000; ++i)
+		calc::EpochReclamation::retire(sharedCalculator.exchange(factory->createCalculator(&status)));
+
+	stopReaders.store(true);
+
+	for (std::thread& reader : readers)
+		reader.join();
+
+	unsigned retained;
+
+	{
+		calc::EpochGuard guard;
+		calc::EpochReclamation::retire(sharedCalculator.exchange(nullptr));
+		retained = calc::EpochReclamation::collect();
+	}
+
+	unsigned left;
+
+	while ((left = calc::EpochReclamation::collect()) != 0)
+		;
+
+	printf("%d %u\n", retained != 0, left);	// 1 0
+	assert(retained != 0 && left == 0);
+
+	// Views of a text and of data, not terminated.
+	calc::IScanner* scanner = new ScannerImpl();
+	std::string_view text = "  1,2,3  ;4,5";
+	std::string_view trimmed = scanner->trim(&status, text.substr(0, 9));
+	const unsigned char data[] = {1, 2, 3, 250};
+	unsigned commas = scanner->countChar(text, ',');
+	unsigned checksum = scanner->checksum(std::span<const unsigned char>(data));
+
+	printf("%u %.*s %u\n", commas, (int) trimmed.length(), trimmed.data(), checksum);	// 3 1,2,3 256
+	assert(commas == 3 && trimmed == "1,2,3" && checksum == 256);
+
+	scanner->dispose();
+
+	// Structs laid out as declared, passed by value and by pointer.
+	calc::IGeometry* geometry = new GeometryImpl();
+	calc::Rectangle rectangle = {{1, 2}, {3, 4}};
+	calc::Point offset = {10, 20};
+	calc::Header header = {1, 99};
+	calc::Rectangle shifted = geometry->move(rectangle, offset);
+
+	printf("%u %u %u\n", (unsigned) sizeof(calc::Header), (unsigned) alignof(calc::Size),
+		(unsigned) sizeof(calc::Rectangle));	// 5 8 16
+	printf("%d %d %d %u\n", shifted.origin.x, shifted.origin.y, geometry->area(&shifted),
+		geometry->payload(header));	// 11 22 12 99
+	assert(sizeof(calc::Header) == 5 && alignof(calc::Size) == 8 && sizeof(calc::Rectangle) == 16);
+	assert(shifted.origin.x == 11 && shifted.origin.y == 22);
+	assert(geometry->area(&shifted) == 12 && geometry->payload(header) == 99);
+
+	geometry->dispose();
+
+	// Arrays and their counts, passed as spans.
+	calc::ISeries* series = new SeriesImpl();
+	const int values[] = {1, 2, 3, 4};
+	int scaled[4];
+	const unsigned char samples[] = {0, 2, 2, 7, 1, 2};
+	unsigned counts[3] = {0, 0, 0};
+
+	series->scale(std::span<const int>(values), std::span<int>(scaled), 3);
+	unsigned outside = series->histogram(std::span<const unsigned char>(samples), std::span<unsigned>(counts));
+
+	printf("%d %d %u\n", series->total(std::span<const int>(values)), scaled[3], outside);	// 10 12 1
+	printf("%u %u %u\n", counts[0], counts[1], counts[2]);	// 1 1 3
+	assert(series->total(std::span<const int>(values)) == 10 && scaled[3] == 12 && outside == 1);
+	assert(counts[0] == 1 && counts[1] == 1 && counts[2] == 3);
+
+	// Batches too. Arrays sharing a count must have the same size, or the call aborts.
+	const int limits[] = {2, 2, 2, 2};
+	int clamped[4];
+
+	series->clampBatch(std::span<const int>(values), std::span<const int>(limits), std::span<int>(clamped));
+
+	printf("%d %d\n", clamped[0], clamped[3]);	// 1 2
+	assert(clamped[0] == 1 && clamped[3] == 2);
+
+#ifdef __linux__
+	pid_t mismatched = fork();
+
+	if (mismatched == 0)
+	{
+		series->scale(std::span<const int>(values), std::span<int>(scaled, 2), 3);
+		_exit(0);
+	}
+
+	int mismatchedStatus = 0;
+	waitpid(mismatched, &mismatchedStatus, 0);
+
+	printf("%d\n", (int) (WIFSIGNALED(mismatchedStatus) && WTERMSIG(mismatchedStatus) == SIGABRT));	// 1
+	assert(WIFSIGNALED(mismatchedStatus) && WTERMSIG(mismatchedStatus) == SIGABRT);
+#endif
+
+	series->dispose();
+
 	calculator->dispose();
 
 	calculator = factory->createBrokenCalculator(&status);
@@ -385,21 +1416,168 @@ static void test(calc::IFactory* (*createFactory)())
 	calculator->sumAndStore(&status, 1, 22);
 	printf("%d\n", calculator->getMemory());	// 24
 
-	calculator->setMemory(calculator->sum(&status, 2, 33));
+	calculator->setMemory(calculator->sum<calc::RingTracePolicy>(&status, 2, 33));
 	printf("%d\n", calculator->getMemory());	// 36
+	assert(calculator->getMemory() == 36);
 
+#ifndef CLOOP_NO_EXCEPTIONS
 	try
 	{
-		printf("%d\n", calculator->sum(&status, 600, 600));
+		printf("%d\n", calculator->sum<calc::RingTracePolicy>(&status, 600, 600));
 	}
 	catch (const CalcException& e)
 	{
 		printf("exception %d\n", e.code);	// exception 1
 	}
 
+	const calc::TraceRing& ring = calc::TraceRing::current();
+	printf("%d %u %u %u %u\n", (int) ring.size(), ring[0].interfaceIndex, ring[0].slot,
+		ring[0].failed, ring[1].failed);	// 2 4 1 0 1
+	assert(ring.size() == 2 && ring[0].interfaceIndex == 4 && ring[0].slot == 1);
+	assert(ring[0].failed == 0 && ring[1].failed == 1);
+
+	calc::ICalculator* tracedCalculator = new TracedCalculatorImpl();
+	tracedCalculator->sumAndStore(&status, 1, 2);
+
+	try
+	{
+		tracedCalculator->sumAndStore(&status, 600, 600);
+	}
+	catch (const CalcException& e)
+	{
+		printf("exception %d\n", e.code);	// exception 1
+	}
+
+	tracedCalculator->dispose();
+
+	// The nested sum is written first, when it returns.
+	printf("%d %u %u %u %u\n", (int) ring.size(), ring[2].slot, ring[2].depth,
+		ring[3].slot, ring[3].depth);	// 7 1 1 4 0
+	assert(ring.size() == 7 && ring[2].slot == 1 && ring[2].depth == 1);
+	assert(ring[3].slot == 4 && ring[3].depth == 0 && ring[3].failed == 0);
+	assert(ring[4].failed == 1 && ring[5].failed == 1 && ring[6].interfaceIndex == 0);
+#endif
+
+	calc::Expected<int, int> result = calculator->try_sum(&status, 2, 33);
+	printf("%d %d\n", (int) result.hasValue(), result.value());	// 1 36
+	assert(result.hasValue() && result.value() == 36);
+
+	result = calculator->try_sum(&status, 600, 600);
+	printf("%d %d\n", (int) result.hasValue(), result.error());	// 0 1
+	assert(!result.hasValue() && result.error() == 1);
+
+	calc::Expected<void, int> voidResult = calculator->try_sumAndStore(&status, 600, 600);
+	printf("%d %d\n", (int) voidResult.hasValue(), voidResult.error());	// 0 1
+	assert(!voidResult.hasValue() && voidResult.error() == 1);
+
 	calculator->dispose();
 	factory->dispose();
 
+	calc::ICounter* counter = new CounterImpl();
+	calc::ICounter* counter2 = new (std::nothrow) CounterImpl();
+	assert(counter2);
+
+	counter->increment();
+	counter2->increment();
+	counter2->increment();
+	counter->add(counter2);
+	printf("%d %d\n", counter->getValue(), (int) sizeof(calc::ICounter) == (int) sizeof(void*));	// 3 1
+	assert(counter->getValue() == 3 && sizeof(calc::ICounter) == sizeof(void*));
+
+	counter2->dispose();
+	counter->dispose();
+
+	alignas(CounterImpl) unsigned char counterStorage[sizeof(CounterImpl)];
+	CounterImpl* placedCounter = new (counterStorage) CounterImpl();
+	assert((void*) placedCounter == counterStorage);
+	placedCounter->~CounterImpl();
+
+	AlignedCounterImpl* alignedCounter = new AlignedCounterImpl();
+	assert((uintptr_t) alignedCounter % 64 == 0);
+	alignedCounter->dispose();
+
+	calc::Ref<calc::IAccumulator> accumulator(new AccumulatorImpl());
+	accumulator->add(5);
+
+	calc::Ref<calc::IAccumulator> copy(accumulator);
+	calc::Ref<calc::IAccumulator> moved(std::move(copy));
+	moved->add(7);
+
+	accumulator->addRef();
+	int references = accumulator->release();
+	printf("%d %d %d\n", accumulator->getTotal(), (int) (copy.get() == 0), references);	// 12 1 2
+	assert(accumulator->getTotal() == 12 && copy.get() == 0 && references == 2);
+
+	// A reference moved into the object keeping it.
+	calc::IPool* pool = new PoolImpl();
+	pool->keep(std::move(moved));
+	printf("%d %d\n", pool->total(), (int) (moved.get() == 0));	// 12 1
+	assert(pool->total() == 12 && moved.get() == 0);
+	pool->dispose();
+
+	calc::IWriter* writer = new BufferImpl();
+	assert(CountingAllocator::blocks == 1);
+	writer->write(5);
+
+	calc::IReader* reader = static_cast<calc::IReader*>(writer->queryInterface(calc::IReader::IID));
+	printf("%d %d %d\n", reader->read(), (int) (reader->queryInterface(calc::IWriter::IID) == writer),
+		(int) (reader->queryInterface(0) == NULL));	// 5 1 1
+	assert(reader->read() == 5 && reader->queryInterface(calc::IWriter::IID) == writer);
+	assert(reader->queryInterface(0) == NULL);
+
+	reader->dispose();
+	assert(CountingAllocator::blocks == 0);
+
+	// The nothrow and aligned forms go to the allocator too.
+	BufferImpl* nothrowBuffer = new (std::nothrow) BufferImpl();
+	AlignedBufferImpl* alignedBuffer = new AlignedBufferImpl();
+	assert(nothrowBuffer && (uintptr_t) alignedBuffer % 64 == 0 && CountingAllocator::blocks == 2);
+	nothrowBuffer->dispose();
+	alignedBuffer->dispose();
+	assert(CountingAllocator::blocks == 0);
+
+#ifndef CLOOP_NO_EXCEPTIONS
+	try
+	{
+		new (std::nothrow) ThrowingBufferImpl();
+		assert(false);
+	}
+	catch (int)
+	{
+	}
+
+	assert(CountingAllocator::blocks == 0);
+#endif
+
+	// The batch variant of multiply is appended in its own version, after the existing slots.
+	calc::ICalculator2::VTable calculator2VTable;
+	const char* firstSlot = (const char*) &calculator2VTable.dispose;
+	assert(((const char*) &calculator2VTable.multiply - firstSlot) / sizeof(void*) == 5);
+	assert(((const char*) &calculator2VTable.copyMemory - firstSlot) / sizeof(void*) == 6);
+	assert(((const char*) &calculator2VTable.copyMemory2 - firstSlot) / sizeof(void*) == 7);
+	assert(((const char*) &calculator2VTable.multiplyBatch - firstSlot) / sizeof(void*) == 8);
+	assert(calc::ICalculator2::VERSION == 7);
+
+	typedef calc::Reflection<calc::ICalculator2> Calculator2Reflection;
+	static_assert(Calculator2Reflection::METHODS[5].slot == 5, "Wrong slot.");
+
+	const calc::MethodInfo& multiply = Calculator2Reflection::METHODS[5];
+	printf("%s %u %s %d\n", multiply.name, multiply.parameterCount, multiply.parameters[1].type,
+		(int) multiply.mayThrow);	// multiply 3 int 1
+	assert(strcmp(multiply.name, "multiply") == 0 && multiply.parameterCount == 3);
+	assert(strcmp(multiply.parameters[1].type, "int") == 0 && multiply.mayThrow);
+
+	// Traced by the wrapper and by the dispatcher, then by the dispatcher only.
+	CallCounter::entered = CallCounter::exited = 0;
+	calc::ICounter* tracedCounter = new CounterImpl();
+	tracedCounter->increment<CallCounter>();
+	tracedCounter->getValue();
+	printf("%d %d %u %u\n", CallCounter::entered, CallCounter::exited,
+		CallCounter::lastInterfaceIndex, CallCounter::lastSlot);	// 3 3 6 2
+	assert(CallCounter::entered == 3 && CallCounter::exited == 3);
+	assert(CallCounter::lastInterfaceIndex == 6 && CallCounter::lastSlot == 2);
+	tracedCounter->dispose();
+
 	printf("\n");
 }
 
@@ -430,6 +1608,13 @@ int main(int argc, char* argv[])
 	loadSymbol(library, "createFactory", createFactory);
 	test(createFactory);
 
+	// The ring of the traced calls, for cloop-trace.
+	if (argc > 2 && !calc::TraceRing::current().dump(argv[2]))
+	{
+		fprintf(stderr, "Cannot dump the trace to %s.\n", argv[2]);
+		return 1;
+	}
+
 #ifdef WIN32
 	FreeLibrary(library);
 #else
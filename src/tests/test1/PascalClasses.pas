@@ -70,6 +70,28 @@ type
 		function sum(status: Status; n1: Integer; n2: Integer): Integer; override;
 	end;
 
+	MyScannerImpl = class(ScannerImpl)
+		procedure dispose(); override;
+		function countChar(text: CloopStrView; c: Byte): Cardinal; override;
+		function trim(status: Status; text: CloopStrView): CloopStrView; override;
+		function checksum(in_: CloopBytes): Cardinal; override;
+	end;
+
+	MyGeometryImpl = class(GeometryImpl)
+		procedure dispose(); override;
+		function move(rectangle: Rectangle; offset: Point): Rectangle; override;
+		function area(rectangle: RectanglePtr): Integer; override;
+		function payload(header: Header): Cardinal; override;
+	end;
+
+	MySeriesImpl = class(SeriesImpl)
+		procedure dispose(); override;
+		function total(values: IntegerPtr; count: Cardinal): Integer; override;
+		procedure scale(in_: IntegerPtr; out_: IntegerPtr; count: Cardinal; factor: Integer); override;
+		function histogram(data: BytePtr; counts: CardinalPtr; size: Cardinal; buckets: Cardinal): Cardinal; override;
+		function clamp(value: Integer; limit: Integer): Integer; override;
+	end;
+
 	MyFactoryImpl = class(FactoryImpl)
 		procedure dispose(); override;
 		function createStatus(): Status; override;
@@ -108,6 +130,7 @@ end;
 procedure MyStatusImpl.setCode(n: Integer);
 begin
 	code := n;
+	cloopErrorFlag := Ord(n <> 0);
 end;
 
 
@@ -217,6 +240,164 @@ begin
 end;
 
 
+//--------------------------------------
+
+// MyScannerImpl
+
+
+procedure MyScannerImpl.dispose();
+begin
+	self.destroy();
+end;
+
+function MyScannerImpl.countChar(text: CloopStrView; c: Byte): Cardinal;
+var
+	i: Cardinal;
+begin
+	Result := 0;
+
+	for i := 1 to Cardinal(text.length) do
+	begin
+		if (Byte(text.data^) = c) then
+			Inc(Result);
+
+		Inc(text.data);
+	end;
+end;
+
+function MyScannerImpl.trim(status: Status; text: CloopStrView): CloopStrView;
+var
+	last: PAnsiChar;
+begin
+	Result := text;
+
+	while (Result.length > 0) and (Result.data^ = ' ') do
+	begin
+		Inc(Result.data);
+		Dec(Result.length);
+	end;
+
+	last := Result.data;
+	Inc(last, Integer(Result.length) - 1);
+
+	while (Result.length > 0) and (last^ = ' ') do
+	begin
+		Dec(last);
+		Dec(Result.length);
+	end;
+end;
+
+function MyScannerImpl.checksum(in_: CloopBytes): Cardinal;
+var
+	i: Cardinal;
+begin
+	Result := 0;
+
+	for i := 1 to Cardinal(in_.length) do
+	begin
+		Inc(Result, in_.data^);
+		Inc(in_.data);
+	end;
+end;
+
+
+//--------------------------------------
+
+// MyGeometryImpl
+
+
+procedure MyGeometryImpl.dispose();
+begin
+	self.destroy();
+end;
+
+function MyGeometryImpl.move(rectangle: Rectangle; offset: Point): Rectangle;
+begin
+	Result := rectangle;
+	Result.origin.x := rectangle.origin.x + offset.x;
+	Result.origin.y := rectangle.origin.y + offset.y;
+end;
+
+function MyGeometryImpl.area(rectangle: RectanglePtr): Integer;
+begin
+	Result := Integer(rectangle^.extent.width * rectangle^.extent.height);
+end;
+
+function MyGeometryImpl.payload(header: Header): Cardinal;
+begin
+	if (header.kind = 1) then
+		Result := header.length
+	else
+		Result := 0;
+end;
+
+
+//--------------------------------------
+
+// MySeriesImpl
+
+
+procedure MySeriesImpl.dispose();
+begin
+	self.destroy();
+end;
+
+function MySeriesImpl.total(values: IntegerPtr; count: Cardinal): Integer;
+var
+	i: Cardinal;
+begin
+	Result := 0;
+
+	for i := 1 to count do
+	begin
+		Result := Result + values^;
+		Inc(values);
+	end;
+end;
+
+procedure MySeriesImpl.scale(in_: IntegerPtr; out_: IntegerPtr; count: Cardinal; factor: Integer);
+var
+	i: Cardinal;
+begin
+	for i := 1 to count do
+	begin
+		out_^ := in_^ * factor;
+		Inc(in_);
+		Inc(out_);
+	end;
+end;
+
+function MySeriesImpl.histogram(data: BytePtr; counts: CardinalPtr; size: Cardinal; buckets: Cardinal): Cardinal;
+var
+	i: Cardinal;
+	bucket: CardinalPtr;
+begin
+	Result := 0;
+
+	for i := 1 to size do
+	begin
+		if (data^ < buckets) then
+		begin
+			bucket := counts;
+			Inc(bucket, data^);
+			Inc(bucket^);
+		end
+		else
+			Inc(Result);
+
+		Inc(data);
+	end;
+end;
+
+function MySeriesImpl.clamp(value: Integer; limit: Integer): Integer;
+begin
+	if (value > limit) then
+		Result := limit
+	else
+		Result := value;
+end;
+
+
 //--------------------------------------
 
 // MyFactoryImpl
@@ -0,0 +1,119 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by Adriano dos Santos Fernandes.
+ *
+ *  Copyright (c) 2014 Adriano dos Santos Fernandes <adrianosf at gmail.com>
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+// Compiled to assembly only. Each generated_* function must compile to the same instructions
+// as its baseline_* counterpart, which is written as the code generated without trace hooks.
+
+// The probes are checked with readelf, not here.
+#define CLOOP_PROBE(provider, name, interfaceIndex, slot, self)
+
+#include <stdint.h>
+#include "CalcCppApi.h"
+
+
+//--------------------------------------
+
+// CheckStatus
+
+
+class CheckStatus : public calc::IStatus
+{
+private:
+	CheckStatus();
+
+public:
+	static void clearException(CheckStatus* status)
+	{
+		status->setCode(0);
+	}
+
+	static void checkException(CheckStatus* status)
+	{
+		if (status->getCode() != 0)
+			throw status->getCode();
+	}
+
+	static void catchException(CheckStatus* status)
+	{
+	}
+
+	static void setVersionError(CheckStatus* status, const char* /*interfaceName*/,
+		unsigned /*currentVersion*/, unsigned /*expectedVersion*/)
+	{
+		status->setCode(calc::IStatus::ERROR_1);
+	}
+};
+
+
+//--------------------------------------
+
+// CounterImpl
+
+
+class CounterImpl : public calc::ICounterImpl<CounterImpl, CheckStatus>
+{
+public:
+	virtual void dispose();
+	virtual int increment();
+	virtual int getValue() const;
+	virtual void add(const calc::ICounter* counter);
+};
+
+
+//--------------------------------------
+
+
+extern "C" int baseline_sum(calc::ICalculator* calculator, CheckStatus* status)
+{
+	if (status->cloopErrorFlag)
+		calc::StatusTraits<CheckStatus>::clearException(status);
+	int ret = static_cast<calc::ICalculator::VTable*>(calculator->cloopVTable)->sum(
+		calculator, status, 1, 2);
+	if (status->cloopErrorFlag)
+		calc::StatusTraits<CheckStatus>::checkException(status);
+	return ret;
+}
+
+extern "C" int generated_sum(calc::ICalculator* calculator, CheckStatus* status)
+{
+	return calculator->sum(status, 1, 2);
+}
+
+extern "C" int baseline_getValue(const calc::ICounter* self) throw()
+{
+	try
+	{
+		return static_cast<const CounterImpl*>(
+			static_cast<const calc::ICounterBaseImpl<CounterImpl, CheckStatus,
+				calc::Inherit<calc::ICounter> >*>(self))->CounterImpl::getValue();
+	}
+	catch (...)
+	{
+		CheckStatus::catchException(0);
+		return static_cast<int>(0);
+	}
+}
+
+extern "C" int generated_getValue(const calc::ICounter* self) throw()
+{
+	return calc::ICounterBaseImpl<CounterImpl, CheckStatus,
+		calc::Inherit<calc::ICounter> >::cloopgetValueDispatcher(self);
+}
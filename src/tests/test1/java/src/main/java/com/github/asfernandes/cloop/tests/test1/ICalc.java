@@ -5,6 +5,209 @@ package com.github.asfernandes.cloop.tests.test1;
 
 public interface ICalc extends com.sun.jna.Library
 {
+	// Length-carrying views, laid out as cloopStrView and cloopBytes of the C API. Made over
+	// direct buffers, their contents are passed without copies.
+	public static class CloopStrView extends com.sun.jna.Structure implements com.sun.jna.Structure.ByValue
+	{
+		public com.sun.jna.Pointer data;
+		public long length;
+
+		public CloopStrView()
+		{
+		}
+
+		public CloopStrView(java.nio.ByteBuffer buffer)
+		{
+			data = com.sun.jna.Native.getDirectBufferPointer(buffer).share(buffer.position());
+			length = buffer.remaining();
+		}
+
+		public java.nio.ByteBuffer getByteBuffer()
+		{
+			return data == null ? null : data.getByteBuffer(0, length);
+		}
+
+		public String getString()
+		{
+			return data == null ? null :
+				new String(data.getByteArray(0, (int) length), java.nio.charset.StandardCharsets.UTF_8);
+		}
+
+		@Override
+		protected java.util.List<String> getFieldOrder()
+		{
+			return java.util.Arrays.asList("data", "length");
+		}
+	}
+
+	public static class CloopBytes extends com.sun.jna.Structure implements com.sun.jna.Structure.ByValue
+	{
+		public com.sun.jna.Pointer data;
+		public long length;
+
+		public CloopBytes()
+		{
+		}
+
+		public CloopBytes(java.nio.ByteBuffer buffer)
+		{
+			data = com.sun.jna.Native.getDirectBufferPointer(buffer).share(buffer.position());
+			length = buffer.remaining();
+		}
+
+		public java.nio.ByteBuffer getByteBuffer()
+		{
+			return data == null ? null : data.getByteBuffer(0, length);
+		}
+
+		@Override
+		protected java.util.List<String> getFieldOrder()
+		{
+			return java.util.Arrays.asList("data", "length");
+		}
+	}
+
+	// Arrays are passed in buffers, from their position. Direct ones are read and written by native
+	// code without copies; heap ones are copied through native memory, only in the directions the
+	// array is passed.
+	public static com.sun.jna.Pointer cloopArrayPointer(java.nio.Buffer buffer, int elementSize, boolean copyIn)
+	{
+		if (buffer == null)
+			return null;
+
+		if (buffer.isDirect())
+			return com.sun.jna.Native.getDirectBufferPointer(buffer).share((long) buffer.position() * elementSize);
+
+		com.sun.jna.Memory memory = new com.sun.jna.Memory(Math.max((long) buffer.remaining() * elementSize, 1));
+
+		if (copyIn)
+			cloopArrayCopy(buffer, cloopArrayView(memory, buffer.remaining(), elementSize, false));
+
+		return memory;
+	}
+
+	public static void cloopArrayCopyBack(com.sun.jna.Pointer pointer, java.nio.Buffer buffer, int elementSize)
+	{
+		if (buffer != null && !buffer.isDirect())
+			cloopArrayCopy(cloopArrayView(pointer, buffer.remaining(), elementSize, true), buffer);
+	}
+
+	// Buffer over a native array, read-only for the arrays the callee only reads.
+	public static java.nio.Buffer cloopArrayView(com.sun.jna.Pointer pointer, long count, int elementSize,
+		boolean readOnly)
+	{
+		if (pointer == null)
+			return null;
+
+		java.nio.ByteBuffer bytes = pointer.getByteBuffer(0, count * elementSize);
+
+		if (readOnly)
+			bytes = bytes.asReadOnlyBuffer();
+
+		bytes.order(java.nio.ByteOrder.nativeOrder());
+
+		return elementSize == 4 ? bytes.asIntBuffer() : elementSize == 8 ? bytes.asLongBuffer() : bytes;
+	}
+
+	// Copies the remaining elements of a buffer to another, keeping their positions.
+	public static void cloopArrayCopy(java.nio.Buffer source, java.nio.Buffer target)
+	{
+		if (target instanceof java.nio.IntBuffer)
+			((java.nio.IntBuffer) target).duplicate().put(((java.nio.IntBuffer) source).duplicate());
+		else if (target instanceof java.nio.LongBuffer)
+			((java.nio.LongBuffer) target).duplicate().put(((java.nio.LongBuffer) source).duplicate());
+		else
+			((java.nio.ByteBuffer) target).duplicate().put(((java.nio.ByteBuffer) source).duplicate());
+	}
+
+	public static class Point extends com.sun.jna.Structure
+	{
+		public static class ByValue extends Point implements com.sun.jna.Structure.ByValue
+		{
+		}
+
+		public int x;
+		public int y;
+
+		public Point()
+		{
+		}
+
+		@Override
+		protected java.util.List<String> getFieldOrder()
+		{
+			return java.util.Arrays.asList("x", "y");
+		}
+	}
+
+	public static class Size extends com.sun.jna.Structure
+	{
+		public static class ByValue extends Size implements com.sun.jna.Structure.ByValue
+		{
+		}
+
+		public int width;
+		public int height;
+
+		public Size()
+		{
+		}
+
+		@Override
+		protected java.util.List<String> getFieldOrder()
+		{
+			return java.util.Arrays.asList("width", "height");
+		}
+
+		@Override
+		protected int getNativeAlignment(Class<?> type, Object value, boolean isFirstElement)
+		{
+			int alignment = super.getNativeAlignment(type, value, isFirstElement);
+			return isFirstElement ? Math.max(alignment, 8) : alignment;
+		}
+	}
+
+	public static class Header extends com.sun.jna.Structure
+	{
+		public static class ByValue extends Header implements com.sun.jna.Structure.ByValue
+		{
+		}
+
+		public byte kind;
+		public int length;
+
+		public Header()
+		{
+			super(ALIGN_NONE);
+		}
+
+		@Override
+		protected java.util.List<String> getFieldOrder()
+		{
+			return java.util.Arrays.asList("kind", "length");
+		}
+	}
+
+	public static class Rectangle extends com.sun.jna.Structure
+	{
+		public static class ByValue extends Rectangle implements com.sun.jna.Structure.ByValue
+		{
+		}
+
+		public Point origin;
+		public Size extent;
+
+		public Rectangle()
+		{
+		}
+
+		@Override
+		protected java.util.List<String> getFieldOrder()
+		{
+			return java.util.Arrays.asList("origin", "extent");
+		}
+	}
+
 	public static interface IDisposableIntf
 	{
 		public void dispose();
@@ -47,6 +250,95 @@ public interface ICalc extends com.sun.jna.Library
 		public int multiply(IStatus status, int n1, int n2) throws CalcException;
 		public void copyMemory(ICalculator calculator);
 		public void copyMemory2(int[] address);
+		public default void multiplyBatch(IStatus status, int[] n1, int[] n2, int[] results, int count) throws CalcException
+		{
+			for (int cloopIndex = 0; cloopIndex < count; ++cloopIndex)
+				results[cloopIndex] = multiply(status, n1[cloopIndex], n2[cloopIndex]);
+		}
+	}
+
+	public static interface ICounterIntf
+	{
+		public void dispose();
+		public int increment();
+		public int getValue();
+		public void add(ICounter counter);
+	}
+
+	public static interface IReferenceCountedIntf
+	{
+		public void addRef();
+		public int release();
+	}
+
+	public static interface IAccumulatorIntf extends IReferenceCountedIntf
+	{
+		public void add(int n);
+		public int getTotal();
+	}
+
+	public static interface IQueryableIntf extends IDisposableIntf
+	{
+		public IQueryable queryInterface(int id);
+	}
+
+	public static interface IReaderIntf extends IQueryableIntf
+	{
+		public static int IID = 0x52454144;
+
+		public int read();
+	}
+
+	public static interface IWriterIntf extends IQueryableIntf
+	{
+		public static int IID = 0x57524954;
+
+		public void write(int n);
+	}
+
+	public static interface IAsyncCalculatorIntf extends IDisposableIntf
+	{
+		public int sum(IStatus status, int n1, int n2) throws CalcException;
+		public void sumAsync(IStatus status, int n1, int n2, IAsyncCalculatorSumCompletion completion) throws CalcException;
+	}
+
+	public static interface IScannerIntf extends IDisposableIntf
+	{
+		public int countChar(CloopStrView text, byte c);
+		public CloopStrView trim(IStatus status, CloopStrView text) throws CalcException;
+		public int checksum(CloopBytes in);
+	}
+
+	public static interface IGeometryIntf extends IDisposableIntf
+	{
+		public Rectangle.ByValue move(Rectangle.ByValue rectangle, Point.ByValue offset);
+		public int area(Rectangle rectangle);
+		public int payload(Header.ByValue header);
+	}
+
+	public static interface ISeriesIntf extends IDisposableIntf
+	{
+		public int total(java.nio.IntBuffer values, int count);
+		public void scale(java.nio.IntBuffer in, java.nio.IntBuffer out, int count, int factor);
+		public int histogram(java.nio.ByteBuffer data, java.nio.IntBuffer counts, int size, int buckets);
+		public int clamp(int value, int limit);
+		public default void clampBatch(int[] value, int[] limit, int[] results, int count)
+		{
+			for (int cloopIndex = 0; cloopIndex < count; ++cloopIndex)
+				results[cloopIndex] = clamp(value[cloopIndex], limit[cloopIndex]);
+		}
+	}
+
+	public static interface IPoolIntf extends IDisposableIntf
+	{
+		public void keep(IAccumulator accumulator);
+		public void setName(String name);
+		public int total();
+	}
+
+	public static interface IAsyncCalculatorSumCompletionIntf
+	{
+		public void complete(IStatus status, int result);
 	}
 
 	public static class IDisposable extends com.sun.jna.Structure implements IDisposableIntf
@@ -202,6 +494,22 @@ public interface ICalc extends com.sun.jna.Library
 			}
 		}
 
+		public int cloopErrorFlag;
+
+		@Override
+		protected java.util.List<String> getFieldOrder()
+		{
+			java.util.List<String> fields = super.getFieldOrder();
+			fields.add("cloopErrorFlag");
+			return fields;
+		}
+
+		public final void cloopSetErrorFlag(boolean error)
+		{
+			cloopErrorFlag = error ? 1 : 0;
+			writeField("cloopErrorFlag");
+		}
+
 		public IStatus()
 		{
 		}
@@ -453,7 +761,8 @@ public interface ICalc extends com.sun.jna.Library
 		{
 			VTable vTable = getVTable();
 			ICalculator result = vTable.createCalculator.invoke(this, status);
-			CalcException.checkException(status);
+			if (status.cloopErrorFlag != 0)
+				CalcException.checkException(status);
 			return result;
 		}
 
@@ -461,7 +770,8 @@ public interface ICalc extends com.sun.jna.Library
 		{
 			VTable vTable = getVTable();
 			ICalculator2 result = vTable.createCalculator2.invoke(this, status);
-			CalcException.checkException(status);
+			if (status.cloopErrorFlag != 0)
+				CalcException.checkException(status);
 			return result;
 		}
 
@@ -469,7 +779,8 @@ public interface ICalc extends com.sun.jna.Library
 		{
 			VTable vTable = getVTable();
 			ICalculator result = vTable.createBrokenCalculator.invoke(this, status);
-			CalcException.checkException(status);
+			if (status.cloopErrorFlag != 0)
+				CalcException.checkException(status);
 			return result;
 		}
 
@@ -601,7 +912,8 @@ public interface ICalc extends com.sun.jna.Library
 		{
 			VTable vTable = getVTable();
 			int result = vTable.sum.invoke(this, status, n1, n2);
-			CalcException.checkException(status);
+			if (status.cloopErrorFlag != 0)
+				CalcException.checkException(status);
 			return result;
 		}
 
@@ -622,7 +934,8 @@ public interface ICalc extends com.sun.jna.Library
 		{
 			VTable vTable = getVTable();
 			vTable.sumAndStore.invoke(this, status, n1, n2);
-			CalcException.checkException(status);
+			if (status.cloopErrorFlag != 0)
+				CalcException.checkException(status);
 		}
 	}
 
@@ -645,6 +958,11 @@ public interface ICalc extends com.sun.jna.Library
 				public void invoke(ICalculator2 self, int[] address);
 			}
 
+			public static interface Callback_multiplyBatch extends com.sun.jna.Callback
+			{
+				public void invoke(ICalculator2 self, IStatus status, com.sun.jna.Pointer n1, com.sun.jna.Pointer n2, com.sun.jna.Pointer results, int count);
+			}
+
 			public VTable(com.sun.jna.Pointer pointer)
 			{
 				super(pointer);
@@ -685,6 +1003,27 @@ public interface ICalc extends com.sun.jna.Library
 						obj.copyMemory2(address);
 					}
 				};
+
+				multiplyBatch = new Callback_multiplyBatch() {
+					@Override
+					public void invoke(ICalculator2 self, IStatus status, com.sun.jna.Pointer n1, com.sun.jna.Pointer n2, com.sun.jna.Pointer results, int count)
+					{
+						int[] n1Array = n1 == null ? new int[0] : n1.getIntArray(0, count);
+						int[] n2Array = n2 == null ? new int[0] : n2.getIntArray(0, count);
+						int[] resultsArray = new int[count];
+
+						try
+						{
+							obj.multiplyBatch(status, n1Array, n2Array, resultsArray, count);
+							if (results != null)
+								results.write(0, resultsArray, 0, count);
+						}
+						catch (Throwable t)
+						{
+							CalcException.catchException(status, t);
+						}
+					}
+				};
 			}
 
 			public VTable()
@@ -694,12 +1033,13 @@ public interface ICalc extends com.sun.jna.Library
 			public Callback_multiply multiply;
 			public Callback_copyMemory copyMemory;
 			public Callback_copyMemory2 copyMemory2;
+			public Callback_multiplyBatch multiplyBatch;
 
 			@Override
 			protected java.util.List<String> getFieldOrder()
 			{
 				java.util.List<String> fields = super.getFieldOrder();
-				fields.addAll(java.util.Arrays.asList("multiply", "copyMemory", "copyMemory2"));
+				fields.addAll(java.util.Arrays.asList("multiply", "copyMemory", "copyMemory2", "multiplyBatch"));
 				return fields;
 			}
 		}
@@ -726,7 +1066,8 @@ public interface ICalc extends com.sun.jna.Library
 		{
 			VTable vTable = getVTable();
 			int result = vTable.multiply.invoke(this, status, n1, n2);
-			CalcException.checkException(status);
+			if (status.cloopErrorFlag != 0)
+				CalcException.checkException(status);
 			return result;
 		}
 
@@ -741,5 +1082,1306 @@ public interface ICalc extends com.sun.jna.Library
 			VTable vTable = getVTable();
 			vTable.copyMemory2.invoke(this, address);
 		}
+
+		public void multiplyBatch(IStatus status, int[] n1, int[] n2, int[] results, int count) throws CalcException
+		{
+			VTable vTable = getVTable();
+			com.sun.jna.Pointer n1Pointer = cloopArrayPointer(java.nio.IntBuffer.wrap(n1, 0, count), 4, true);
+			com.sun.jna.Pointer n2Pointer = cloopArrayPointer(java.nio.IntBuffer.wrap(n2, 0, count), 4, true);
+			com.sun.jna.Pointer resultsPointer = cloopArrayPointer(java.nio.IntBuffer.wrap(results, 0, count), 4, false);
+			vTable.multiplyBatch.invoke(this, status, n1Pointer, n2Pointer, resultsPointer, count);
+			cloopArrayCopyBack(resultsPointer, java.nio.IntBuffer.wrap(results, 0, count), 4);
+			if (status.cloopErrorFlag != 0)
+				CalcException.checkException(status);
+		}
+
+		public int[] multiplyBatch(IStatus status, int[] n1, int[] n2) throws CalcException
+		{
+			int[] results = new int[n1.length];
+			multiplyBatch(status, n1, n2, results, n1.length);
+			return results;
+		}
+	}
+
+	public static class ICounter extends com.sun.jna.Structure implements ICounterIntf
+	{
+		public static class VTable extends com.sun.jna.Structure implements com.sun.jna.Structure.ByReference
+		{
+			public static interface Callback_dispose extends com.sun.jna.Callback
+			{
+				public void invoke(ICounter self);
+			}
+
+			public static interface Callback_increment extends com.sun.jna.Callback
+			{
+				public int invoke(ICounter self);
+			}
+
+			public static interface Callback_getValue extends com.sun.jna.Callback
+			{
+				public int invoke(ICounter self);
+			}
+
+			public static interface Callback_add extends com.sun.jna.Callback
+			{
+				public void invoke(ICounter self, ICounter counter);
+			}
+
+			public com.sun.jna.Pointer version;
+
+			public VTable(com.sun.jna.Pointer pointer)
+			{
+				super(pointer);
+			}
+
+			public VTable(ICounterIntf obj)
+			{
+				dispose = new Callback_dispose() {
+					@Override
+					public void invoke(ICounter self)
+					{
+						obj.dispose();
+					}
+				};
+
+				increment = new Callback_increment() {
+					@Override
+					public int invoke(ICounter self)
+					{
+						return obj.increment();
+					}
+				};
+
+				getValue = new Callback_getValue() {
+					@Override
+					public int invoke(ICounter self)
+					{
+						return obj.getValue();
+					}
+				};
+
+				add = new Callback_add() {
+					@Override
+					public void invoke(ICounter self, ICounter counter)
+					{
+						obj.add(counter);
+					}
+				};
+			}
+
+			public VTable()
+			{
+			}
+
+			public Callback_dispose dispose;
+			public Callback_increment increment;
+			public Callback_getValue getValue;
+			public Callback_add add;
+
+			@Override
+			protected java.util.List<String> getFieldOrder()
+			{
+				java.util.List<String> fields = new java.util.ArrayList<String>();
+				fields.addAll(java.util.Arrays.asList("version", "dispose", "increment", "getValue", "add"));
+				return fields;
+			}
+		}
+
+		public com.sun.jna.Pointer cloopVTable;
+		protected volatile VTable vTable;
+
+		@Override
+		protected java.util.List<String> getFieldOrder()
+		{
+			java.util.List<String> fields = new java.util.ArrayList<String>();
+			fields.addAll(java.util.Arrays.asList("cloopVTable"));
+			return fields;
+		}
+
+		@SuppressWarnings("unchecked")
+		public final <T extends VTable> T getVTable()
+		{
+			if (vTable == null)
+			{
+				synchronized (cloopVTable)
+				{
+					if (vTable == null)
+					{
+						vTable = createVTable();
+						vTable.read();
+					}
+				}
+			}
+
+			return (T) vTable;
+		}
+
+		public ICounter()
+		{
+		}
+
+		public ICounter(ICounterIntf obj)
+		{
+			vTable = new VTable(obj);
+			vTable.write();
+			cloopVTable = vTable.getPointer();
+			write();
+		}
+
+		protected VTable createVTable()
+		{
+			return new VTable(cloopVTable);
+		}
+
+		public void dispose()
+		{
+			VTable vTable = getVTable();
+			vTable.dispose.invoke(this);
+		}
+
+		public int increment()
+		{
+			VTable vTable = getVTable();
+			int result = vTable.increment.invoke(this);
+			return result;
+		}
+
+		public int getValue()
+		{
+			VTable vTable = getVTable();
+			int result = vTable.getValue.invoke(this);
+			return result;
+		}
+
+		public void add(ICounter counter)
+		{
+			VTable vTable = getVTable();
+			vTable.add.invoke(this, counter);
+		}
+	}
+
+	public static class IReferenceCounted extends com.sun.jna.Structure implements IReferenceCountedIntf
+	{
+		public static class VTable extends com.sun.jna.Structure implements com.sun.jna.Structure.ByReference
+		{
+			public static interface Callback_addRef extends com.sun.jna.Callback
+			{
+				public void invoke(IReferenceCounted self);
+			}
+
+			public static interface Callback_release extends com.sun.jna.Callback
+			{
+				public int invoke(IReferenceCounted self);
+			}
+
+			public com.sun.jna.Pointer cloopDummy;
+			public com.sun.jna.Pointer version;
+
+			public VTable(com.sun.jna.Pointer pointer)
+			{
+				super(pointer);
+			}
+
+			public VTable(IReferenceCountedIntf obj)
+			{
+				addRef = new Callback_addRef() {
+					@Override
+					public void invoke(IReferenceCounted self)
+					{
+						obj.addRef();
+					}
+				};
+
+				release = new Callback_release() {
+					@Override
+					public int invoke(IReferenceCounted self)
+					{
+						return obj.release();
+					}
+				};
+			}
+
+			public VTable()
+			{
+			}
+
+			public Callback_addRef addRef;
+			public Callback_release release;
+
+			@Override
+			protected java.util.List<String> getFieldOrder()
+			{
+				java.util.List<String> fields = new java.util.ArrayList<String>();
+				fields.addAll(java.util.Arrays.asList("cloopDummy", "version", "addRef", "release"));
+				return fields;
+			}
+		}
+
+		public com.sun.jna.Pointer cloopDummy;
+		public com.sun.jna.Pointer cloopVTable;
+		protected volatile VTable vTable;
+
+		@Override
+		protected java.util.List<String> getFieldOrder()
+		{
+			java.util.List<String> fields = new java.util.ArrayList<String>();
+			fields.addAll(java.util.Arrays.asList("cloopDummy", "cloopVTable"));
+			return fields;
+		}
+
+		@SuppressWarnings("unchecked")
+		public final <T extends VTable> T getVTable()
+		{
+			if (vTable == null)
+			{
+				synchronized (cloopVTable)
+				{
+					if (vTable == null)
+					{
+						vTable = createVTable();
+						vTable.read();
+					}
+				}
+			}
+
+			return (T) vTable;
+		}
+
+		public IReferenceCounted()
+		{
+		}
+
+		public IReferenceCounted(IReferenceCountedIntf obj)
+		{
+			vTable = new VTable(obj);
+			vTable.write();
+			cloopVTable = vTable.getPointer();
+			write();
+		}
+
+		protected VTable createVTable()
+		{
+			return new VTable(cloopVTable);
+		}
+
+		public void addRef()
+		{
+			VTable vTable = getVTable();
+			vTable.addRef.invoke(this);
+		}
+
+		public int release()
+		{
+			VTable vTable = getVTable();
+			int result = vTable.release.invoke(this);
+			return result;
+		}
+	}
+
+	public static class IAccumulator extends IReferenceCounted implements IAccumulatorIntf
+	{
+		public static class VTable extends IReferenceCounted.VTable
+		{
+			public static interface Callback_add extends com.sun.jna.Callback
+			{
+				public void invoke(IAccumulator self, int n);
+			}
+
+			public static interface Callback_getTotal extends com.sun.jna.Callback
+			{
+				public int invoke(IAccumulator self);
+			}
+
+			public VTable(com.sun.jna.Pointer pointer)
+			{
+				super(pointer);
+			}
+
+			public VTable(IAccumulatorIntf obj)
+			{
+				super(obj);
+
+				add = new Callback_add() {
+					@Override
+					public void invoke(IAccumulator self, int n)
+					{
+						obj.add(n);
+					}
+				};
+
+				getTotal = new Callback_getTotal() {
+					@Override
+					public int invoke(IAccumulator self)
+					{
+						return obj.getTotal();
+					}
+				};
+			}
+
+			public VTable()
+			{
+			}
+
+			public Callback_add add;
+			public Callback_getTotal getTotal;
+
+			@Override
+			protected java.util.List<String> getFieldOrder()
+			{
+				java.util.List<String> fields = super.getFieldOrder();
+				fields.addAll(java.util.Arrays.asList("add", "getTotal"));
+				return fields;
+			}
+		}
+
+		public IAccumulator()
+		{
+		}
+
+		public IAccumulator(IAccumulatorIntf obj)
+		{
+			vTable = new VTable(obj);
+			vTable.write();
+			cloopVTable = vTable.getPointer();
+			write();
+		}
+
+		@Override
+		protected VTable createVTable()
+		{
+			return new VTable(cloopVTable);
+		}
+
+		public void add(int n)
+		{
+			VTable vTable = getVTable();
+			vTable.add.invoke(this, n);
+		}
+
+		public int getTotal()
+		{
+			VTable vTable = getVTable();
+			int result = vTable.getTotal.invoke(this);
+			return result;
+		}
+	}
+
+	public static class IQueryable extends IDisposable implements IQueryableIntf
+	{
+		public static class VTable extends IDisposable.VTable
+		{
+			public static interface Callback_queryInterface extends com.sun.jna.Callback
+			{
+				public IQueryable invoke(IQueryable self, int id);
+			}
+
+			public VTable(com.sun.jna.Pointer pointer)
+			{
+				super(pointer);
+			}
+
+			public VTable(IQueryableIntf obj)
+			{
+				super(obj);
+
+				queryInterface = new Callback_queryInterface() {
+					@Override
+					public IQueryable invoke(IQueryable self, int id)
+					{
+						return obj.queryInterface(id);
+					}
+				};
+			}
+
+			public VTable()
+			{
+			}
+
+			public Callback_queryInterface queryInterface;
+
+			@Override
+			protected java.util.List<String> getFieldOrder()
+			{
+				java.util.List<String> fields = super.getFieldOrder();
+				fields.addAll(java.util.Arrays.asList("queryInterface"));
+				return fields;
+			}
+		}
+
+		public IQueryable()
+		{
+		}
+
+		public IQueryable(IQueryableIntf obj)
+		{
+			vTable = new VTable(obj);
+			vTable.write();
+			cloopVTable = vTable.getPointer();
+			write();
+		}
+
+		@Override
+		protected VTable createVTable()
+		{
+			return new VTable(cloopVTable);
+		}
+
+		public IQueryable queryInterface(int id)
+		{
+			VTable vTable = getVTable();
+			IQueryable result = vTable.queryInterface.invoke(this, id);
+			return result;
+		}
+	}
+
+	public static class IReader extends IQueryable implements IReaderIntf
+	{
+		public static class VTable extends IQueryable.VTable
+		{
+			public static interface Callback_read extends com.sun.jna.Callback
+			{
+				public int invoke(IReader self);
+			}
+
+			public VTable(com.sun.jna.Pointer pointer)
+			{
+				super(pointer);
+			}
+
+			public VTable(IReaderIntf obj)
+			{
+				super(obj);
+
+				read = new Callback_read() {
+					@Override
+					public int invoke(IReader self)
+					{
+						return obj.read();
+					}
+				};
+			}
+
+			public VTable()
+			{
+			}
+
+			public Callback_read read;
+
+			@Override
+			protected java.util.List<String> getFieldOrder()
+			{
+				java.util.List<String> fields = super.getFieldOrder();
+				fields.addAll(java.util.Arrays.asList("read"));
+				return fields;
+			}
+		}
+
+		public IReader()
+		{
+		}
+
+		public IReader(IReaderIntf obj)
+		{
+			vTable = new VTable(obj);
+			vTable.write();
+			cloopVTable = vTable.getPointer();
+			write();
+		}
+
+		@Override
+		protected VTable createVTable()
+		{
+			return new VTable(cloopVTable);
+		}
+
+		public int read()
+		{
+			VTable vTable = getVTable();
+			int result = vTable.read.invoke(this);
+			return result;
+		}
+	}
+
+	public static class IWriter extends IQueryable implements IWriterIntf
+	{
+		public static class VTable extends IQueryable.VTable
+		{
+			public static interface Callback_write extends com.sun.jna.Callback
+			{
+				public void invoke(IWriter self, int n);
+			}
+
+			public VTable(com.sun.jna.Pointer pointer)
+			{
+				super(pointer);
+			}
+
+			public VTable(IWriterIntf obj)
+			{
+				super(obj);
+
+				write = new Callback_write() {
+					@Override
+					public void invoke(IWriter self, int n)
+					{
+						obj.write(n);
+					}
+				};
+			}
+
+			public VTable()
+			{
+			}
+
+			public Callback_write write;
+
+			@Override
+			protected java.util.List<String> getFieldOrder()
+			{
+				java.util.List<String> fields = super.getFieldOrder();
+				fields.addAll(java.util.Arrays.asList("write"));
+				return fields;
+			}
+		}
+
+		public IWriter()
+		{
+		}
+
+		public IWriter(IWriterIntf obj)
+		{
+			vTable = new VTable(obj);
+			vTable.write();
+			cloopVTable = vTable.getPointer();
+			write();
+		}
+
+		@Override
+		protected VTable createVTable()
+		{
+			return new VTable(cloopVTable);
+		}
+
+		public void write(int n)
+		{
+			VTable vTable = getVTable();
+			vTable.write.invoke(this, n);
+		}
+	}
+
+	public static class IAsyncCalculator extends IDisposable implements IAsyncCalculatorIntf
+	{
+		public static class VTable extends IDisposable.VTable
+		{
+			public static interface Callback_sum extends com.sun.jna.Callback
+			{
+				public int invoke(IAsyncCalculator self, IStatus status, int n1, int n2);
+			}
+
+			public static interface Callback_sumAsync extends com.sun.jna.Callback
+			{
+				public void invoke(IAsyncCalculator self, IStatus status, int n1, int n2, IAsyncCalculatorSumCompletion completion);
+			}
+
+			public VTable(com.sun.jna.Pointer pointer)
+			{
+				super(pointer);
+			}
+
+			public VTable(IAsyncCalculatorIntf obj)
+			{
+				super(obj);
+
+				sum = new Callback_sum() {
+					@Override
+					public int invoke(IAsyncCalculator self, IStatus status, int n1, int n2)
+					{
+						try
+						{
+							return obj.sum(status, n1, n2);
+						}
+						catch (Throwable t)
+						{
+							CalcException.catchException(status, t);
+							return 0;
+						}
+					}
+				};
+
+				sumAsync = new Callback_sumAsync() {
+					@Override
+					public void invoke(IAsyncCalculator self, IStatus status, int n1, int n2, IAsyncCalculatorSumCompletion completion)
+					{
+						try
+						{
+							obj.sumAsync(status, n1, n2, completion);
+						}
+						catch (Throwable t)
+						{
+							CalcException.catchException(status, t);
+						}
+					}
+				};
+			}
+
+			public VTable()
+			{
+			}
+
+			public Callback_sum sum;
+			public Callback_sumAsync sumAsync;
+
+			@Override
+			protected java.util.List<String> getFieldOrder()
+			{
+				java.util.List<String> fields = super.getFieldOrder();
+				fields.addAll(java.util.Arrays.asList("sum", "sumAsync"));
+				return fields;
+			}
+		}
+
+		public IAsyncCalculator()
+		{
+		}
+
+		public IAsyncCalculator(IAsyncCalculatorIntf obj)
+		{
+			vTable = new VTable(obj);
+			vTable.write();
+			cloopVTable = vTable.getPointer();
+			write();
+		}
+
+		@Override
+		protected VTable createVTable()
+		{
+			return new VTable(cloopVTable);
+		}
+
+		public int sum(IStatus status, int n1, int n2) throws CalcException
+		{
+			VTable vTable = getVTable();
+			int result = vTable.sum.invoke(this, status, n1, n2);
+			if (status.cloopErrorFlag != 0)
+				CalcException.checkException(status);
+			return result;
+		}
+
+		public void sumAsync(IStatus status, int n1, int n2, IAsyncCalculatorSumCompletion completion) throws CalcException
+		{
+			VTable vTable = getVTable();
+			vTable.sumAsync.invoke(this, status, n1, n2, completion);
+			if (status.cloopErrorFlag != 0)
+				CalcException.checkException(status);
+		}
+	}
+
+	public static class IScanner extends IDisposable implements IScannerIntf
+	{
+		public static class VTable extends IDisposable.VTable
+		{
+			public static interface Callback_countChar extends com.sun.jna.Callback
+			{
+				public int invoke(IScanner self, CloopStrView text, byte c);
+			}
+
+			public static interface Callback_trim extends com.sun.jna.Callback
+			{
+				public CloopStrView invoke(IScanner self, IStatus status, CloopStrView text);
+			}
+
+			public static interface Callback_checksum extends com.sun.jna.Callback
+			{
+				public int invoke(IScanner self, CloopBytes in);
+			}
+
+			public VTable(com.sun.jna.Pointer pointer)
+			{
+				super(pointer);
+			}
+
+			public VTable(IScannerIntf obj)
+			{
+				super(obj);
+
+				countChar = new Callback_countChar() {
+					@Override
+					public int invoke(IScanner self, CloopStrView text, byte c)
+					{
+						return obj.countChar(text, c);
+					}
+				};
+
+				trim = new Callback_trim() {
+					@Override
+					public CloopStrView invoke(IScanner self, IStatus status, CloopStrView text)
+					{
+						try
+						{
+							return obj.trim(status, text);
+						}
+						catch (Throwable t)
+						{
+							CalcException.catchException(status, t);
+							return new CloopStrView();
+						}
+					}
+				};
+
+				checksum = new Callback_checksum() {
+					@Override
+					public int invoke(IScanner self, CloopBytes in)
+					{
+						return obj.checksum(in);
+					}
+				};
+			}
+
+			public VTable()
+			{
+			}
+
+			public Callback_countChar countChar;
+			public Callback_trim trim;
+			public Callback_checksum checksum;
+
+			@Override
+			protected java.util.List<String> getFieldOrder()
+			{
+				java.util.List<String> fields = super.getFieldOrder();
+				fields.addAll(java.util.Arrays.asList("countChar", "trim", "checksum"));
+				return fields;
+			}
+		}
+
+		public IScanner()
+		{
+		}
+
+		public IScanner(IScannerIntf obj)
+		{
+			vTable = new VTable(obj);
+			vTable.write();
+			cloopVTable = vTable.getPointer();
+			write();
+		}
+
+		@Override
+		protected VTable createVTable()
+		{
+			return new VTable(cloopVTable);
+		}
+
+		public int countChar(CloopStrView text, byte c)
+		{
+			VTable vTable = getVTable();
+			int result = vTable.countChar.invoke(this, text, c);
+			return result;
+		}
+
+		public CloopStrView trim(IStatus status, CloopStrView text) throws CalcException
+		{
+			VTable vTable = getVTable();
+			CloopStrView result = vTable.trim.invoke(this, status, text);
+			if (status.cloopErrorFlag != 0)
+				CalcException.checkException(status);
+			return result;
+		}
+
+		public int checksum(CloopBytes in)
+		{
+			VTable vTable = getVTable();
+			int result = vTable.checksum.invoke(this, in);
+			return result;
+		}
+	}
+
+	public static class IGeometry extends IDisposable implements IGeometryIntf
+	{
+		public static class VTable extends IDisposable.VTable
+		{
+			public static interface Callback_move extends com.sun.jna.Callback
+			{
+				public Rectangle.ByValue invoke(IGeometry self, Rectangle.ByValue rectangle, Point.ByValue offset);
+			}
+
+			public static interface Callback_area extends com.sun.jna.Callback
+			{
+				public int invoke(IGeometry self, Rectangle rectangle);
+			}
+
+			public static interface Callback_payload extends com.sun.jna.Callback
+			{
+				public int invoke(IGeometry self, Header.ByValue header);
+			}
+
+			public VTable(com.sun.jna.Pointer pointer)
+			{
+				super(pointer);
+			}
+
+			public VTable(IGeometryIntf obj)
+			{
+				super(obj);
+
+				move = new Callback_move() {
+					@Override
+					public Rectangle.ByValue invoke(IGeometry self, Rectangle.ByValue rectangle, Point.ByValue offset)
+					{
+						return obj.move(rectangle, offset);
+					}
+				};
+
+				area = new Callback_area() {
+					@Override
+					public int invoke(IGeometry self, Rectangle rectangle)
+					{
+						return obj.area(rectangle);
+					}
+				};
+
+				payload = new Callback_payload() {
+					@Override
+					public int invoke(IGeometry self, Header.ByValue header)
+					{
+						return obj.payload(header);
+					}
+				};
+			}
+
+			public VTable()
+			{
+			}
+
+			public Callback_move move;
+			public Callback_area area;
+			public Callback_payload payload;
+
+			@Override
+			protected java.util.List<String> getFieldOrder()
+			{
+				java.util.List<String> fields = super.getFieldOrder();
+				fields.addAll(java.util.Arrays.asList("move", "area", "payload"));
+				return fields;
+			}
+		}
+
+		public IGeometry()
+		{
+		}
+
+		public IGeometry(IGeometryIntf obj)
+		{
+			vTable = new VTable(obj);
+			vTable.write();
+			cloopVTable = vTable.getPointer();
+			write();
+		}
+
+		@Override
+		protected VTable createVTable()
+		{
+			return new VTable(cloopVTable);
+		}
+
+		public Rectangle.ByValue move(Rectangle.ByValue rectangle, Point.ByValue offset)
+		{
+			VTable vTable = getVTable();
+			Rectangle.ByValue result = vTable.move.invoke(this, rectangle, offset);
+			return result;
+		}
+
+		public int area(Rectangle rectangle)
+		{
+			VTable vTable = getVTable();
+			int result = vTable.area.invoke(this, rectangle);
+			return result;
+		}
+
+		public int payload(Header.ByValue header)
+		{
+			VTable vTable = getVTable();
+			int result = vTable.payload.invoke(this, header);
+			return result;
+		}
+	}
+
+	public static class ISeries extends IDisposable implements ISeriesIntf
+	{
+		public static class VTable extends IDisposable.VTable
+		{
+			public static interface Callback_total extends com.sun.jna.Callback
+			{
+				public int invoke(ISeries self, com.sun.jna.Pointer values, int count);
+			}
+
+			public static interface Callback_scale extends com.sun.jna.Callback
+			{
+				public void invoke(ISeries self, com.sun.jna.Pointer in, com.sun.jna.Pointer out, int count, int factor);
+			}
+
+			public static interface Callback_histogram extends com.sun.jna.Callback
+			{
+				public int invoke(ISeries self, com.sun.jna.Pointer data, com.sun.jna.Pointer counts, int size, int buckets);
+			}
+
+			public static interface Callback_clamp extends com.sun.jna.Callback
+			{
+				public int invoke(ISeries self, int value, int limit);
+			}
+
+			public static interface Callback_clampBatch extends com.sun.jna.Callback
+			{
+				public void invoke(ISeries self, com.sun.jna.Pointer value, com.sun.jna.Pointer limit, com.sun.jna.Pointer results, int count);
+			}
+
+			public VTable(com.sun.jna.Pointer pointer)
+			{
+				super(pointer);
+			}
+
+			public VTable(ISeriesIntf obj)
+			{
+				super(obj);
+
+				total = new Callback_total() {
+					@Override
+					public int invoke(ISeries self, com.sun.jna.Pointer values, int count)
+					{
+						return obj.total((java.nio.IntBuffer) cloopArrayView(values, Integer.toUnsignedLong(count), 4, true), count);
+					}
+				};
+
+				scale = new Callback_scale() {
+					@Override
+					public void invoke(ISeries self, com.sun.jna.Pointer in, com.sun.jna.Pointer out, int count, int factor)
+					{
+						obj.scale((java.nio.IntBuffer) cloopArrayView(in, Integer.toUnsignedLong(count), 4, true), (java.nio.IntBuffer) cloopArrayView(out, Integer.toUnsignedLong(count), 4, false), count, factor);
+					}
+				};
+
+				histogram = new Callback_histogram() {
+					@Override
+					public int invoke(ISeries self, com.sun.jna.Pointer data, com.sun.jna.Pointer counts, int size, int buckets)
+					{
+						return obj.histogram((java.nio.ByteBuffer) cloopArrayView(data, Integer.toUnsignedLong(size), 1, true), (java.nio.IntBuffer) cloopArrayView(counts, Integer.toUnsignedLong(buckets), 4, false), size, buckets);
+					}
+				};
+
+				clamp = new Callback_clamp() {
+					@Override
+					public int invoke(ISeries self, int value, int limit)
+					{
+						return obj.clamp(value, limit);
+					}
+				};
+
+				clampBatch = new Callback_clampBatch() {
+					@Override
+					public void invoke(ISeries self, com.sun.jna.Pointer value, com.sun.jna.Pointer limit, com.sun.jna.Pointer results, int count)
+					{
+						int[] valueArray = value == null ? new int[0] : value.getIntArray(0, count);
+						int[] limitArray = limit == null ? new int[0] : limit.getIntArray(0, count);
+						int[] resultsArray = new int[count];
+
+						obj.clampBatch(valueArray, limitArray, resultsArray, count);
+						if (results != null)
+							results.write(0, resultsArray, 0, count);
+					}
+				};
+			}
+
+			public VTable()
+			{
+			}
+
+			public Callback_total total;
+			public Callback_scale scale;
+			public Callback_histogram histogram;
+			public Callback_clamp clamp;
+			public Callback_clampBatch clampBatch;
+
+			@Override
+			protected java.util.List<String> getFieldOrder()
+			{
+				java.util.List<String> fields = super.getFieldOrder();
+				fields.addAll(java.util.Arrays.asList("total", "scale", "histogram", "clamp", "clampBatch"));
+				return fields;
+			}
+		}
+
+		public ISeries()
+		{
+		}
+
+		public ISeries(ISeriesIntf obj)
+		{
+			vTable = new VTable(obj);
+			vTable.write();
+			cloopVTable = vTable.getPointer();
+			write();
+		}
+
+		@Override
+		protected VTable createVTable()
+		{
+			return new VTable(cloopVTable);
+		}
+
+		public int total(java.nio.IntBuffer values, int count)
+		{
+			VTable vTable = getVTable();
+			com.sun.jna.Pointer valuesPointer = cloopArrayPointer(values, 4, true);
+			int result = vTable.total.invoke(this, valuesPointer, count);
+			return result;
+		}
+
+		public void scale(java.nio.IntBuffer in, java.nio.IntBuffer out, int count, int factor)
+		{
+			VTable vTable = getVTable();
+			com.sun.jna.Pointer inPointer = cloopArrayPointer(in, 4, true);
+			com.sun.jna.Pointer outPointer = cloopArrayPointer(out, 4, false);
+			vTable.scale.invoke(this, inPointer, outPointer, count, factor);
+			cloopArrayCopyBack(outPointer, out, 4);
+		}
+
+		public int histogram(java.nio.ByteBuffer data, java.nio.IntBuffer counts, int size, int buckets)
+		{
+			VTable vTable = getVTable();
+			com.sun.jna.Pointer dataPointer = cloopArrayPointer(data, 1, true);
+			com.sun.jna.Pointer countsPointer = cloopArrayPointer(counts, 4, true);
+			int result = vTable.histogram.invoke(this, dataPointer, countsPointer, size, buckets);
+			cloopArrayCopyBack(countsPointer, counts, 4);
+			return result;
+		}
+
+		public int clamp(int value, int limit)
+		{
+			VTable vTable = getVTable();
+			int result = vTable.clamp.invoke(this, value, limit);
+			return result;
+		}
+
+		public void clampBatch(int[] value, int[] limit, int[] results, int count)
+		{
+			VTable vTable = getVTable();
+			com.sun.jna.Pointer valuePointer = cloopArrayPointer(java.nio.IntBuffer.wrap(value, 0, count), 4, true);
+			com.sun.jna.Pointer limitPointer = cloopArrayPointer(java.nio.IntBuffer.wrap(limit, 0, count), 4, true);
+			com.sun.jna.Pointer resultsPointer = cloopArrayPointer(java.nio.IntBuffer.wrap(results, 0, count), 4, false);
+			vTable.clampBatch.invoke(this, valuePointer, limitPointer, resultsPointer, count);
+			cloopArrayCopyBack(resultsPointer, java.nio.IntBuffer.wrap(results, 0, count), 4);
+		}
+
+		public int[] clampBatch(int[] value, int[] limit)
+		{
+			int[] results = new int[value.length];
+			clampBatch(value, limit, results, value.length);
+			return results;
+		}
+	}
+
+	public static class IPool extends IDisposable implements IPoolIntf
+	{
+		public static class VTable extends IDisposable.VTable
+		{
+			public static interface Callback_keep extends com.sun.jna.Callback
+			{
+				public void invoke(IPool self, IAccumulator accumulator);
+			}
+
+			public static interface Callback_setName extends com.sun.jna.Callback
+			{
+				public void invoke(IPool self, String name);
+			}
+
+			public static interface Callback_total extends com.sun.jna.Callback
+			{
+				public int invoke(IPool self);
+			}
+
+			public VTable(com.sun.jna.Pointer pointer)
+			{
+				super(pointer);
+			}
+
+			public VTable(IPoolIntf obj)
+			{
+				super(obj);
+
+				keep = new Callback_keep() {
+					@Override
+					public void invoke(IPool self, IAccumulator accumulator)
+					{
+						obj.keep(accumulator);
+					}
+				};
+
+				setName = new Callback_setName() {
+					@Override
+					public void invoke(IPool self, String name)
+					{
+						obj.setName(name);
+					}
+				};
+
+				total = new Callback_total() {
+					@Override
+					public int invoke(IPool self)
+					{
+						return obj.total();
+					}
+				};
+			}
+
+			public VTable()
+			{
+			}
+
+			public Callback_keep keep;
+			public Callback_setName setName;
+			public Callback_total total;
+
+			@Override
+			protected java.util.List<String> getFieldOrder()
+			{
+				java.util.List<String> fields = super.getFieldOrder();
+				fields.addAll(java.util.Arrays.asList("keep", "setName", "total"));
+				return fields;
+			}
+		}
+
+		public IPool()
+		{
+		}
+
+		public IPool(IPoolIntf obj)
+		{
+			vTable = new VTable(obj);
+			vTable.write();
+			cloopVTable = vTable.getPointer();
+			write();
+		}
+
+		@Override
+		protected VTable createVTable()
+		{
+			return new VTable(cloopVTable);
+		}
+
+		public void keep(IAccumulator accumulator)
+		{
+			VTable vTable = getVTable();
+			vTable.keep.invoke(this, accumulator);
+		}
+
+		public void setName(String name)
+		{
+			VTable vTable = getVTable();
+			vTable.setName.invoke(this, name);
+		}
+
+		public int total()
+		{
+			VTable vTable = getVTable();
+			int result = vTable.total.invoke(this);
+			return result;
+		}
+	}
+
+	public static class IAsyncCalculatorSumCompletion extends com.sun.jna.Structure implements IAsyncCalculatorSumCompletionIntf
+	{
+		public static class VTable extends com.sun.jna.Structure implements com.sun.jna.Structure.ByReference
+		{
+			public static interface Callback_complete extends com.sun.jna.Callback
+			{
+				public void invoke(IAsyncCalculatorSumCompletion self, IStatus status, int result);
+			}
+
+			public com.sun.jna.Pointer cloopDummy;
+			public com.sun.jna.Pointer version;
+
+			public VTable(com.sun.jna.Pointer pointer)
+			{
+				super(pointer);
+			}
+
+			public VTable(IAsyncCalculatorSumCompletionIntf obj)
+			{
+				complete = new Callback_complete() {
+					@Override
+					public void invoke(IAsyncCalculatorSumCompletion self, IStatus status, int result)
+					{
+						obj.complete(status, result);
+					}
+				};
+			}
+
+			public VTable()
+			{
+			}
+
+			public Callback_complete complete;
+
+			@Override
+			protected java.util.List<String> getFieldOrder()
+			{
+				java.util.List<String> fields = new java.util.ArrayList<String>();
+				fields.addAll(java.util.Arrays.asList("cloopDummy", "version", "complete"));
+				return fields;
+			}
+		}
+
+		public com.sun.jna.Pointer cloopDummy;
+		public com.sun.jna.Pointer cloopVTable;
+		protected volatile VTable vTable;
+
+		@Override
+		protected java.util.List<String> getFieldOrder()
+		{
+			java.util.List<String> fields = new java.util.ArrayList<String>();
+			fields.addAll(java.util.Arrays.asList("cloopDummy", "cloopVTable"));
+			return fields;
+		}
+
+		@SuppressWarnings("unchecked")
+		public final <T extends VTable> T getVTable()
+		{
+			if (vTable == null)
+			{
+				synchronized (cloopVTable)
+				{
+					if (vTable == null)
+					{
+						vTable = createVTable();
+						vTable.read();
+					}
+				}
+			}
+
+			return (T) vTable;
+		}
+
+		public IAsyncCalculatorSumCompletion()
+		{
+		}
+
+		public IAsyncCalculatorSumCompletion(IAsyncCalculatorSumCompletionIntf obj)
+		{
+			vTable = new VTable(obj);
+			vTable.write();
+			cloopVTable = vTable.getPointer();
+			write();
+		}
+
+		protected VTable createVTable()
+		{
+			return new VTable(cloopVTable);
+		}
+
+		public void complete(IStatus status, int result)
+		{
+			VTable vTable = getVTable();
+			vTable.complete.invoke(this, status, result);
+		}
 	}
 }
@@ -95,6 +95,15 @@ public class CalcTest
 		class MyStatusIntf implements IStatusIntf
 		{
 			private int code = -2;
+			private IStatus status;
+
+			public IStatus getStatus()
+			{
+				if (status == null)
+					status = new IStatus(this);
+
+				return status;
+			}
 
 			@Override
 			public void dispose()
@@ -111,10 +120,11 @@ public class CalcTest
 			public void setCode(int code)
 			{
 				this.code = code;
+				getStatus().cloopSetErrorFlag(code != 0);
 			}
 		}
 
-		status = new IStatus(new MyStatusIntf());
+		status = new MyStatusIntf().getStatus();
 
 		Assert.assertEquals(-2, (code = status.getCode()));
 
@@ -138,7 +148,7 @@ public class CalcTest
 			@Override
 			public IStatus createStatus()
 			{
-				return new IStatus(new MyStatusIntf());
+				return new MyStatusIntf().getStatus();
 			}
 		}));
 
@@ -148,4 +158,224 @@ public class CalcTest
 		calculator.dispose();
 		factory.dispose();
 	}
+
+	@Test
+	public void testBatch() throws CalcException
+	{
+		Calc calc = (Calc) Native.loadLibrary("test1-cpp.so", Calc.class);
+		IFactory factory = calc.createFactory();
+		IStatus status = factory.createStatus();
+
+		ICalculator2 calculator2 = factory.createCalculator2(status);
+
+		int[] results = new int[3];
+		calculator2.multiplyBatch(status, new int[] {2, 3, 4}, new int[] {5, 6, 7}, results, 3);
+		Assert.assertArrayEquals(new int[] {10, 18, 28}, results);
+
+		Assert.assertArrayEquals(new int[] {4, 9},
+			calculator2.multiplyBatch(status, new int[] {2, 3}, new int[] {2, 3}));
+
+		calculator2.dispose();
+		factory.dispose();
+	}
+
+	@Test
+	public void testViews() throws CalcException
+	{
+		Calc calc = (Calc) Native.loadLibrary("test1-cpp.so", Calc.class);
+		IFactory factory = calc.createFactory();
+		IStatus status = factory.createStatus();
+
+		IScanner scanner = new IScanner(new IScannerIntf() {
+			@Override
+			public void dispose()
+			{
+			}
+
+			@Override
+			public int countChar(CloopStrView text, byte c)
+			{
+				java.nio.ByteBuffer buffer = text.getByteBuffer();
+				int count = 0;
+
+				while (buffer.hasRemaining())
+				{
+					if (buffer.get() == c)
+						++count;
+				}
+
+				return count;
+			}
+
+			@Override
+			public CloopStrView trim(IStatus status, CloopStrView text)
+			{
+				java.nio.ByteBuffer buffer = text.getByteBuffer();
+				int start = 0;
+				int end = buffer.limit();
+
+				while (start < end && buffer.get(start) == ' ')
+					++start;
+
+				while (end > start && buffer.get(end - 1) == ' ')
+					--end;
+
+				CloopStrView result = new CloopStrView();
+				result.data = text.data.share(start);
+				result.length = end - start;
+				return result;
+			}
+
+			@Override
+			public int checksum(CloopBytes in)
+			{
+				java.nio.ByteBuffer buffer = in.getByteBuffer();
+				int sum = 0;
+
+				while (buffer.hasRemaining())
+					sum += buffer.get() & 0xFF;
+
+				return sum;
+			}
+		});
+
+		java.nio.ByteBuffer text = java.nio.ByteBuffer.allocateDirect(7);
+		text.put("  a,b  ".getBytes(java.nio.charset.StandardCharsets.UTF_8)).flip();
+
+		java.nio.ByteBuffer data = java.nio.ByteBuffer.allocateDirect(3);
+		data.put(new byte[] {1, 2, (byte) 250}).flip();
+
+		Assert.assertEquals("a,b", scanner.trim(status, new CloopStrView(text)).getString());
+		Assert.assertEquals(1, scanner.countChar(new CloopStrView(text), (byte) ','));
+		Assert.assertEquals(253, scanner.checksum(new CloopBytes(data)));
+
+		factory.dispose();
+	}
+
+	@Test
+	public void testStructs()
+	{
+		IGeometry geometry = new IGeometry(new IGeometryIntf() {
+			@Override
+			public void dispose()
+			{
+			}
+
+			@Override
+			public Rectangle.ByValue move(Rectangle.ByValue rectangle, Point.ByValue offset)
+			{
+				Rectangle.ByValue result = new Rectangle.ByValue();
+				result.origin.x = rectangle.origin.x + offset.x;
+				result.origin.y = rectangle.origin.y + offset.y;
+				result.extent.width = rectangle.extent.width;
+				result.extent.height = rectangle.extent.height;
+				return result;
+			}
+
+			@Override
+			public int area(Rectangle rectangle)
+			{
+				return rectangle.extent.width * rectangle.extent.height;
+			}
+
+			@Override
+			public int payload(Header.ByValue header)
+			{
+				return header.kind == 1 ? header.length : 0;
+			}
+		});
+
+		Rectangle.ByValue rectangle = new Rectangle.ByValue();
+		rectangle.origin.x = 1;
+		rectangle.origin.y = 2;
+		rectangle.extent.width = 3;
+		rectangle.extent.height = 4;
+
+		Point.ByValue offset = new Point.ByValue();
+		offset.x = 10;
+		offset.y = 20;
+
+		Rectangle.ByValue shifted = geometry.move(rectangle, offset);
+		Assert.assertEquals(11, shifted.origin.x);
+		Assert.assertEquals(22, shifted.origin.y);
+		Assert.assertEquals(4, shifted.extent.height);
+
+		Rectangle byReference = new Rectangle();
+		byReference.extent.width = shifted.extent.width;
+		byReference.extent.height = shifted.extent.height;
+		Assert.assertEquals(12, geometry.area(byReference));
+
+		Header.ByValue header = new Header.ByValue();
+		header.kind = 1;
+		header.length = 99;
+		Assert.assertEquals(99, geometry.payload(header));
+	}
+
+	@Test
+	public void testArrays()
+	{
+		ISeries series = new ISeries(new ISeriesIntf() {
+			@Override
+			public void dispose()
+			{
+			}
+
+			@Override
+			public int total(java.nio.IntBuffer values, int count)
+			{
+				int sum = 0;
+
+				for (int i = 0; i < count; ++i)
+					sum += values.get(i);
+
+				return sum;
+			}
+
+			@Override
+			public void scale(java.nio.IntBuffer in, java.nio.IntBuffer out, int count, int factor)
+			{
+				for (int i = 0; i < count; ++i)
+					out.put(i, in.get(i) * factor);
+			}
+
+			@Override
+			public int histogram(java.nio.ByteBuffer data, java.nio.IntBuffer counts, int size, int buckets)
+			{
+				int outside = 0;
+
+				for (int i = 0; i < size; ++i)
+				{
+					int value = data.get(i) & 0xFF;
+
+					if (value < buckets)
+						counts.put(value, counts.get(value) + 1);
+					else
+						++outside;
+				}
+
+				return outside;
+			}
+
+			@Override
+			public int clamp(int value, int limit)
+			{
+				return Math.min(value, limit);
+			}
+		});
+
+		java.nio.IntBuffer values = java.nio.IntBuffer.wrap(new int[] {1, 2, 3, 4});
+		Assert.assertEquals(10, series.total(values, 4));
+
+		int[] scaled = new int[4];
+		series.scale(values, java.nio.IntBuffer.wrap(scaled), 4, 3);
+		Assert.assertArrayEquals(new int[] {3, 6, 9, 12}, scaled);
+
+		int[] counts = new int[] {1, 0, 0};
+		Assert.assertEquals(1, series.histogram(java.nio.ByteBuffer.wrap(new byte[] {0, 2, 2, 7}),
+			java.nio.IntBuffer.wrap(counts), 4, 3));
+		Assert.assertArrayEquals(new int[] {2, 0, 2}, counts);
+
+		Assert.assertArrayEquals(new int[] {1, 1, 3, 3},
+			series.clampBatch(new int[] {1, 2, 3, 4}, new int[] {2, 1, 5, 3}));
+	}
 }